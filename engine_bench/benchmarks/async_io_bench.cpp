@@ -0,0 +1,118 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "async_io/async_io.hpp"
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    constexpr size_t asset_size(1 << 20);
+    constexpr size_t asset_count(64);
+
+    // a "level" of 64 assets of 1 MiB each
+    struct level_fixture
+    {
+        std::vector<std::string> assets;
+
+        level_fixture()
+        {
+            const std::vector<unsigned char> data(asset_size, 0x5A);
+            for (size_t i = 0; i < asset_count; ++i)
+            {
+                assets.push_back((std::filesystem::temp_directory_path() /
+                    ("engine_bench_asset_" + std::to_string(i) + ".bin")).string());
+                FILE* out(std::fopen(assets.back().c_str(), "wb"));
+                std::fwrite(data.data(), 1, data.size(), out);
+                std::fclose(out);
+            }
+        }
+
+        ~level_fixture()
+        {
+            for (const auto& asset : assets)
+                std::filesystem::remove(asset);
+        }
+    };
+
+    const level_fixture& fixture()
+    {
+        static const level_fixture instance;
+        return instance;
+    }
+
+    el::async_io_options options_for(int64_t backend)
+    {
+        el::async_io_options options;
+        options.backend = backend == 0 ? el::io_backend::io_uring : el::io_backend::pread;
+        return options;
+    }
+}
+
+// streams the whole level, arg 0 is io_uring and arg 1 the pread fallback
+static void async_io_stream_level(benchmark::State& state)
+{
+    const level_fixture& level(fixture());
+    std::unique_ptr<el::async_io> io;
+    try
+    {
+        io = std::make_unique<el::async_io>(el::thread_pool::global(), options_for(state.range(0)));
+    }
+    catch (const std::runtime_error& error)
+    {
+        state.SkipWithError(error.what());
+        return;
+    }
+
+    std::atomic<size_t> bytes(0);
+    for (auto _ : state)
+    {
+        for (const auto& asset : level.assets)
+            io->read(asset, el::io_priority::normal, [&](el::io_result result) { bytes += result.data.size(); });
+        io->wait_idle();
+    }
+    state.SetBytesProcessed(int64_t(bytes.load()));
+}
+
+/*
+ * The cost the frame thread pays: the longest read() call while the whole level streams
+ * with its callbacks running on the pool. It has to stay far below the 1 ms hitch budget.
+ */
+static void async_io_frame_thread_stall(benchmark::State& state)
+{
+    using clock = std::chrono::steady_clock;
+    const level_fixture& level(fixture());
+    el::async_io io;
+    double worst(0), total(0);
+    size_t calls(0);
+    for (auto _ : state)
+    {
+        for (size_t round = 0; round < 4; ++round)
+            for (const auto& asset : level.assets)
+            {
+                const clock::time_point start(clock::now());
+                io.read(asset, el::io_priority(round), [](el::io_result result)
+                {
+                    benchmark::DoNotOptimize(result.data.data());
+                });
+                const double elapsed(std::chrono::duration<double, std::micro>(clock::now() - start).count());
+                worst = std::max(worst, elapsed);
+                total += elapsed;
+                ++calls;
+            }
+        io.wait_idle();
+    }
+    state.counters["worst_us"] = worst;
+    state.counters["mean_us"] = total / double(calls);
+    state.counters["backend"] = double(io.backend());
+}
+
+BENCHMARK(async_io_stream_level)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(async_io_frame_thread_stall)->Unit(benchmark::kMillisecond)->UseRealTime();
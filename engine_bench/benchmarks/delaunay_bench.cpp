@@ -0,0 +1,57 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "convex_hull/convex_hull.hpp"
+#include "delaunay/delaunay.hpp"
+#include "benchmark/benchmark.h"
+
+#include <random>
+
+namespace
+{
+    template <size_t N>
+    std::vector<std::array<double, N>> uniform_points(size_t count)
+    {
+        std::mt19937 random(11);
+        std::uniform_real_distribution<double> coordinate(0, 1);
+        std::vector<std::array<double, N>> points(count);
+        for (auto& p : points)
+            for (double& c : p)
+                c = coordinate(random);
+        return points;
+    }
+}
+
+// arg: points uniform in a cube, cut into chunks whose hulls are computed in parallel
+static void convex_hull_cube(benchmark::State& state)
+{
+    const auto points(uniform_points<3>(size_t(state.range(0))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(el::convex_hull(points).size());
+    state.counters["points/s"] = benchmark::Counter(double(points.size()),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(convex_hull_cube)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// arg: points uniform in a square, triangulated in parallel runs and merged
+static void delaunay_plane(benchmark::State& state)
+{
+    const auto points(uniform_points<2>(size_t(state.range(0))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(el::delaunay_triangulation(points).size());
+    state.counters["points/s"] = benchmark::Counter(double(points.size()),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(delaunay_plane)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// arg: points uniform in a cube, inserted one by one
+static void delaunay_space(benchmark::State& state)
+{
+    const auto points(uniform_points<3>(size_t(state.range(0))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(el::delaunay_tetrahedralization(points).size());
+    state.counters["points/s"] = benchmark::Counter(double(points.size()),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(delaunay_space)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
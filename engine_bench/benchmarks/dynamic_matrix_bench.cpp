@@ -0,0 +1,77 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "dynamic_matrix/dynamic_matrix.hpp"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+    el::dynamic_matrix<float> random_matrix(size_t size, unsigned seed)
+    {
+        el::dynamic_matrix<float> result(size, size);
+        for (size_t i = 0; i < size; ++i)
+            for (size_t j = 0; j < size; ++j)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                result(i, j) = float(seed >> 8) / float(1u << 24) - 0.5f;
+            }
+        return result;
+    }
+
+    void report_gflops(benchmark::State& state, size_t size)
+    {
+        const double flops(2.0 * double(size) * double(size) * double(size));
+        state.counters["GFLOP"] = benchmark::Counter(flops / 1e9, benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
+// textbook triple loop over the same storage, the baseline for the blocked kernel
+static void naive_gemm(benchmark::State& state)
+{
+    const size_t size(state.range(0));
+    auto a(random_matrix(size, 1)), b(random_matrix(size, 2));
+    el::dynamic_matrix<float> c(size, size);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < size; ++i)
+            for (size_t j = 0; j < size; ++j)
+            {
+                float sum(0);
+                for (size_t k = 0; k < size; ++k)
+                    sum += a.row_data(i)[k] * b.row_data(k)[j];
+                c.row_data(i)[j] = sum;
+            }
+        benchmark::DoNotOptimize(c.row_data(0));
+    }
+    report_gflops(state, size);
+}
+BENCHMARK(naive_gemm)->Arg(64)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+
+static void blocked_gemm_single_thread(benchmark::State& state)
+{
+    const size_t size(state.range(0));
+    auto a(random_matrix(size, 1)), b(random_matrix(size, 2));
+    el::dynamic_matrix<float> c;
+    for (auto _ : state)
+    {
+        el::gemm(a, b, c, el::thread_pool::serial());
+        benchmark::DoNotOptimize(c.row_data(0));
+    }
+    report_gflops(state, size);
+}
+BENCHMARK(blocked_gemm_single_thread)->Arg(64)->Arg(256)->Arg(512)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void blocked_gemm_all_threads(benchmark::State& state)
+{
+    const size_t size(state.range(0));
+    auto a(random_matrix(size, 1)), b(random_matrix(size, 2));
+    el::dynamic_matrix<float> c;
+    for (auto _ : state)
+    {
+        el::gemm(a, b, c);
+        benchmark::DoNotOptimize(c.row_data(0));
+    }
+    report_gflops(state, size);
+}
+BENCHMARK(blocked_gemm_all_threads)->Arg(256)->Arg(512)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,61 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "input_system/input_system.hpp"
+#include "benchmark/benchmark.h"
+
+#include <thread>
+
+// arg: events per tick, a mix of keys, mouse motion and gamepad axes folded into one snapshot
+static void input_tick(benchmark::State& state)
+{
+    const auto events(uint32_t(state.range(0)));
+    el::input_system input(events);
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < events; ++i)
+            switch (i % 4)
+            {
+            case 0:
+                input.push({el::input_event_type::key_down, i % 512, 0, 0});
+                break;
+            case 1:
+                input.push({el::input_event_type::key_up, (i + 64) % 512, 0, 0});
+                break;
+            case 2:
+                input.push({el::input_event_type::mouse_motion, 0, float(i), float(i)});
+                break;
+            default:
+                input.push({el::input_event_type::gamepad_axis, i % 6, 0.5f, 0});
+            }
+        benchmark::DoNotOptimize(input.tick(1.0f / 60).event_count);
+    }
+    state.counters["events/s"] = benchmark::Counter(double(events), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(input_tick)->Arg(16)->Arg(1024);
+
+// events pushed by one thread and drained by another through the ring
+static void input_ring_transfer(benchmark::State& state)
+{
+    constexpr int count = 1 << 16;
+    for (auto _ : state)
+    {
+        el::ring_buffer<el::input_event> ring(1024);
+        std::thread producer([&]
+        {
+            for (int i = 0; i < count; ++i)
+                while (!ring.try_push({el::input_event_type::mouse_motion, 0, float(i), 0}))
+                    std::this_thread::yield();
+        });
+        el::input_event event;
+        for (int received = 0; received < count;)
+            if (ring.try_pop(event))
+                ++received;
+            else
+                std::this_thread::yield();
+        producer.join();
+    }
+    state.counters["events/s"] = benchmark::Counter(double(count), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(input_ring_transfer)->Unit(benchmark::kMillisecond)->UseRealTime();
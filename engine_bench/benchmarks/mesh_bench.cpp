@@ -0,0 +1,110 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh/mesh.hpp"
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // side x side quads of a wavy height field with shuffled triangles, 512^2 quads = 524288 triangles
+    constexpr size_t grid_side = 512;
+
+    el::mesh height_field(size_t side, el::vertex_layout layout)
+    {
+        el::mesh result(layout);
+        result.reserve((side + 1) * (side + 1), 2 * side * side);
+        for (size_t y = 0; y <= side; ++y)
+            for (size_t x = 0; x <= side; ++x)
+                result.add_vertex(el::point<float, 3>({float(x), float(y), std::sin(0.1f * x) * std::cos(0.1f * y)}),
+                                  el::direction<float, 3>(),
+                                  el::point<float, 2>({float(x) / side, float(y) / side}));
+
+        std::vector<uint32_t> indices;
+        std::vector<size_t> quads(side * side);
+        for (size_t i = 0; i < quads.size(); ++i)
+            quads[i] = i;
+        std::shuffle(quads.begin(), quads.end(), std::mt19937(1));
+        for (size_t quad : quads)
+        {
+            const uint32_t i(uint32_t(quad / side * (side + 1) + quad % side)), row(uint32_t(side + 1));
+            indices.insert(indices.end(), {i, i + 1, i + row + 1, i, i + row + 1, i + row});
+        }
+        result.set_indices(std::move(indices));
+        return result;
+    }
+
+    el::vertex_layout layout_of(const benchmark::State& state)
+    {
+        return state.range(1) == 0 ? el::vertex_layout::interleaved : el::vertex_layout::separate;
+    }
+}
+
+static void mesh_generate_normals(benchmark::State& state)
+{
+    el::mesh m(height_field(grid_side, layout_of(state)));
+    el::thread_pool pool(state.range(0));
+    for (auto _ : state)
+    {
+        m.generate_normals(pool);
+        benchmark::ClobberMemory();
+    }
+    state.counters["triangles"] = benchmark::Counter(double(m.triangle_count()),
+                                                     benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void mesh_generate_tangents(benchmark::State& state)
+{
+    el::mesh m(height_field(grid_side, layout_of(state)));
+    el::thread_pool pool(state.range(0));
+    m.generate_normals(pool);
+    for (auto _ : state)
+    {
+        m.generate_tangents(pool);
+        benchmark::ClobberMemory();
+    }
+    state.counters["triangles"] = benchmark::Counter(double(m.triangle_count()),
+                                                     benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void mesh_transform(benchmark::State& state)
+{
+    el::mesh m(height_field(grid_side, layout_of(state)));
+    el::thread_pool pool(state.range(0));
+    m.generate_normals(pool);
+    // small rotation around z, so repeated application stays bounded
+    const float c(std::cos(0.01f)), s(std::sin(0.01f));
+    el::matrix<float, 4, 4> rotation(el::array<el::array<float, 4>, 4>({{{c, -s, 0, 0}, {s, c, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}}));
+    for (auto _ : state)
+    {
+        m.transform(rotation, pool);
+        benchmark::ClobberMemory();
+    }
+    state.counters["vertices"] = benchmark::Counter(double(m.vertex_count()),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void mesh_optimize_vertex_cache(benchmark::State& state)
+{
+    const el::mesh source(height_field(grid_side / 4, el::vertex_layout::interleaved));
+    float ratio(0.0f);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        el::mesh m(source);
+        state.ResumeTiming();
+        m.optimize_vertex_cache();
+        ratio = el::average_cache_miss_ratio(m.indices(), m.vertex_count());
+    }
+    state.counters["acmr_before"] = el::average_cache_miss_ratio(source.indices(), source.vertex_count());
+    state.counters["acmr_after"] = ratio;
+}
+
+BENCHMARK(mesh_generate_normals)->ArgsProduct({{1, 4}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(mesh_generate_tangents)->ArgsProduct({{1, 4}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(mesh_transform)->ArgsProduct({{1, 4}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(mesh_optimize_vertex_cache)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_loader/mesh_loader.hpp"
+#include "mapped_file/mapped_file.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+
+namespace
+{
+    /*
+     * Point clouds of ENGINE_BENCH_POINT_CLOUD_MB megabytes as OBJ text and binary PLY,
+     * 64 by default. Set it to 1024 for the 1 GB ingestion target.
+     */
+    size_t point_cloud_bytes()
+    {
+        const char* value(std::getenv("ENGINE_BENCH_POINT_CLOUD_MB"));
+        const size_t megabytes(value != nullptr ? std::strtoull(value, nullptr, 10) : 64);
+        return std::max<size_t>(1, megabytes) << 20;
+    }
+
+    struct point_cloud_fixture
+    {
+        std::string obj;
+        std::string ply;
+
+        point_cloud_fixture()
+            : obj((std::filesystem::temp_directory_path() / "engine_bench_cloud.obj").string()),
+              ply((std::filesystem::temp_directory_path() / "engine_bench_cloud.ply").string())
+        {
+            std::mt19937 random(3);
+            std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+
+            const size_t bytes(point_cloud_bytes());
+            FILE* out(std::fopen(obj.c_str(), "w"));
+            for (size_t written = 0; written < bytes;)
+                written += size_t(std::fprintf(out, "v %.6f %.6f %.6f\n", coordinate(random), coordinate(random),
+                                               coordinate(random)));
+            std::fclose(out);
+
+            const size_t points(bytes / (3 * sizeof(float)));
+            out = std::fopen(ply.c_str(), "wb");
+            std::fprintf(out, "ply\nformat binary_little_endian 1.0\nelement vertex %zu\n"
+                         "property float x\nproperty float y\nproperty float z\nend_header\n", points);
+            std::vector<float> buffer;
+            for (size_t first = 0; first < points; first += 65536)
+            {
+                buffer.clear();
+                for (size_t i = first; i < std::min(points, first + 65536); ++i)
+                    buffer.insert(buffer.end(), {coordinate(random), coordinate(random), coordinate(random)});
+                std::fwrite(buffer.data(), sizeof(float), buffer.size(), out);
+            }
+            std::fclose(out);
+        }
+
+        ~point_cloud_fixture()
+        {
+            std::filesystem::remove(obj);
+            std::filesystem::remove(ply);
+        }
+    };
+
+    const point_cloud_fixture& fixture()
+    {
+        static const point_cloud_fixture instance;
+        return instance;
+    }
+
+    void stream(benchmark::State& state, const std::string& path)
+    {
+        el::thread_pool pool(state.range(0));
+        size_t points(0);
+        for (auto _ : state)
+        {
+            points = 0;
+            el::stream_points(path, [&](const el::point<float, 3>* data, size_t count)
+            {
+                benchmark::DoNotOptimize(data);
+                points += count;
+            }, pool);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(std::filesystem::file_size(path)));
+        state.counters["points"] = benchmark::Counter(double(points), benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
+static void loader_stream_obj(benchmark::State& state)
+{
+    stream(state, fixture().obj);
+}
+
+static void loader_stream_binary_ply(benchmark::State& state)
+{
+    stream(state, fixture().ply);
+}
+
+// touching every page of the mapped OBJ once, the bandwidth the parser is measured against
+static void loader_read_baseline(benchmark::State& state)
+{
+    const std::string& path(fixture().obj);
+    for (auto _ : state)
+    {
+        el::mapped_file file(path);
+        file.advise(el::access_pattern::sequential);
+        size_t sum(0);
+        for (size_t i = 0; i < file.size(); i += 64)
+            sum += file.data()[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(std::filesystem::file_size(path)));
+}
+
+BENCHMARK(loader_stream_obj)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(loader_stream_binary_ply)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(loader_read_baseline)->Unit(benchmark::kMillisecond)->UseRealTime();
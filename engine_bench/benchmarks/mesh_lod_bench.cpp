@@ -0,0 +1,76 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_lod/mesh_lod.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+
+namespace
+{
+    // wavy height field of side x side quads, 256^2 quads = 131072 triangles
+    constexpr size_t field_side = 256;
+
+    el::mesh height_field(size_t side)
+    {
+        el::mesh result(el::vertex_layout::interleaved);
+        result.reserve((side + 1) * (side + 1), 2 * side * side);
+        for (size_t y = 0; y <= side; ++y)
+            for (size_t x = 0; x <= side; ++x)
+                result.add_vertex(el::point<float, 3>({float(x), float(y), 4 * std::sin(0.05f * x) * std::cos(0.05f * y)}),
+                                  el::direction<float, 3>(), el::point<float, 2>({float(x) / side, float(y) / side}));
+        for (size_t y = 0; y < side; ++y)
+            for (size_t x = 0; x < side; ++x)
+            {
+                const uint32_t i(uint32_t(y * (side + 1) + x)), row(uint32_t(side + 1));
+                result.add_triangle(i, i + 1, i + row + 1);
+                result.add_triangle(i, i + row + 1, i + row);
+            }
+        return result;
+    }
+}
+
+// arg: threads, simplifying the field to a quarter of its triangles
+static void mesh_lod_simplify(benchmark::State& state)
+{
+    const el::mesh source(height_field(field_side));
+    el::thread_pool pool(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(el::simplify_mesh(source, source.triangle_count() / 4, {}, pool).error);
+    state.counters["triangles/s"] = benchmark::Counter(double(source.triangle_count()),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(mesh_lod_simplify)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// arg: threads, building the default four level chain
+static void mesh_lod_chain(benchmark::State& state)
+{
+    const el::mesh source(height_field(field_side));
+    el::thread_pool pool(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(el::lod_chain(source, {}, pool).size());
+}
+BENCHMARK(mesh_lod_chain)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// choosing a level for ten thousand instances at increasing distance
+static void mesh_lod_select(benchmark::State& state)
+{
+    const el::lod_chain chain(height_field(64));
+    el::matrix<float, 4, 4> view_projection;
+    view_projection(0, 0) = 1;
+    view_projection(1, 1) = 1;
+    view_projection(3, 2) = -1;
+    for (auto _ : state)
+    {
+        size_t sum(0);
+        for (int i = 0; i < 10000; ++i)
+        {
+            view_projection(3, 3) = 100.0f + float(i);
+            sum += chain.select(view_projection, 1080);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["selections/s"] = benchmark::Counter(10000, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(mesh_lod_select);
@@ -0,0 +1,98 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "navmesh/navmesh.hpp"
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    // side x side unit quads of gently rolling terrain with a hole in every 16 x 16 block
+    el::mesh terrain(size_t side)
+    {
+        el::mesh result(el::vertex_layout::interleaved);
+        for (size_t z = 0; z <= side; ++z)
+            for (size_t x = 0; x <= side; ++x)
+                result.add_vertex(el::point<float, 3>({float(x), float((x * 7 + z * 3) % 5) * 0.1f, float(z)}),
+                                  el::direction<float, 3>(), el::point<float, 2>());
+        for (size_t z = 0; z < side; ++z)
+            for (size_t x = 0; x < side; ++x)
+            {
+                if (x % 16 >= 4 && x % 16 < 12 && z % 16 >= 6 && z % 16 < 10)
+                    continue;
+                const uint32_t i(uint32_t(z * (side + 1) + x)), row(uint32_t(side + 1));
+                result.add_triangle(i, i + row, i + 1);
+                result.add_triangle(i + 1, i + row, i + row + 1);
+            }
+        return result;
+    }
+
+    // agents with goals up to range cells away, both ends in the walkable part of a cell
+    std::vector<el::path_request> requests(size_t count, size_t side, float range)
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> position(0.5f, float(side) - 0.5f), offset(-range, range);
+        std::vector<el::path_request> result(count);
+        for (auto& request : result)
+        {
+            const float x(position(random)), z(position(random));
+            const float goal_x(std::clamp(x + offset(random), 0.5f, float(side) - 0.5f));
+            const float goal_z(std::clamp(z + offset(random), 0.5f, float(side) - 0.5f));
+            request = {el::point<float, 3>({x, 1.0f, z}), el::point<float, 3>({goal_x, 1.0f, goal_z})};
+        }
+        return result;
+    }
+}
+
+// arg: goal range in cells; one frame answers 10k requests on a 512 x 512 terrain with a warm cache
+static void navmesh_find_paths(benchmark::State& state)
+{
+    constexpr size_t side = 512, count = 10000;
+    const el::navmesh mesh(terrain(side));
+    el::path_planner planner(mesh);
+    const auto batch(requests(count, side, float(state.range(0))));
+    std::vector<el::path_result> results;
+    planner.find_paths(batch, results);
+    for (auto _ : state)
+    {
+        planner.find_paths(batch, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["paths/s"] = benchmark::Counter(double(count), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(navmesh_find_paths)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// arg: goal range in cells; the same frame with the region chain cache emptied before it
+static void navmesh_find_paths_cold(benchmark::State& state)
+{
+    constexpr size_t side = 512, count = 10000;
+    const el::navmesh mesh(terrain(side));
+    el::path_planner planner(mesh);
+    const auto batch(requests(count, side, float(state.range(0))));
+    std::vector<el::path_result> results;
+    for (auto _ : state)
+    {
+        planner.clear_cache();
+        planner.find_paths(batch, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["paths/s"] = benchmark::Counter(double(count), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(navmesh_find_paths_cold)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// building the navmesh of the 512 x 512 terrain
+static void navmesh_build(benchmark::State& state)
+{
+    const auto level(terrain(512));
+    for (auto _ : state)
+    {
+        el::navmesh mesh(level);
+        benchmark::DoNotOptimize(mesh.region_count());
+    }
+    state.counters["triangles/s"] = benchmark::Counter(double(level.triangle_count()),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(navmesh_build)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,105 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "occlusion_buffer/occlusion_buffer.hpp"
+#include "benchmark/benchmark.h"
+
+#include <random>
+
+namespace
+{
+    // a city block of 32 x 32 buildings seen from street level, 12 triangles each
+    constexpr int blocks = 32;
+
+    el::mesh building(float x, float z, float height)
+    {
+        el::mesh result;
+        for (int corner = 0; corner < 8; ++corner)
+            result.add_vertex(el::point<float, 3>({x + (corner & 1 ? 6.0f : 0.0f), corner & 2 ? height : 0.0f,
+                                                   z + (corner & 4 ? 6.0f : 0.0f)}),
+                              el::direction<float, 3>(), el::point<float, 2>());
+        const uint32_t faces[6][4]{{0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3}};
+        for (const auto& face : faces)
+        {
+            result.add_triangle(face[0], face[1], face[2]);
+            result.add_triangle(face[0], face[2], face[3]);
+        }
+        return result;
+    }
+
+    std::vector<el::mesh> city()
+    {
+        std::vector<el::mesh> result;
+        std::mt19937 random(3);
+        std::uniform_real_distribution<float> height(5, 40);
+        for (int i = 0; i < blocks; ++i)
+            for (int j = 0; j < blocks; ++j)
+                result.push_back(building(10.0f * i - 160, -10.0f * j - 4, height(random)));
+        return result;
+    }
+
+    el::matrix<float, 4, 4> street_camera()
+    {
+        // perspective from (0, 2, 0) down -z, OpenGL style, 2:1 viewport
+        const float near(0.1f), far(1000.0f);
+        el::matrix<float, 4, 4> result;
+        result(0, 0) = 0.5f;
+        result(1, 1) = 1;
+        result(1, 3) = -2;
+        result(2, 2) = -(far + near) / (far - near);
+        result(2, 3) = -2 * far * near / (far - near);
+        result(3, 2) = -1;
+        return result;
+    }
+}
+
+// arg: threads, clearing, adding every building and rendering the 256 x 128 buffer
+static void occlusion_render(benchmark::State& state)
+{
+    const std::vector<el::mesh> buildings(city());
+    const el::matrix<float, 4, 4> camera(street_camera());
+    el::occlusion_buffer buffer(256, 128);
+    el::thread_pool pool(state.range(0));
+    for (auto _ : state)
+    {
+        buffer.clear();
+        for (const el::mesh& b : buildings)
+            buffer.add_occluder(b, camera);
+        buffer.render(pool);
+        benchmark::DoNotOptimize(buffer.depth(0, 0));
+    }
+    state.counters["triangles/s"] = benchmark::Counter(double(buildings.size() * 12),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(occlusion_render)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// testing ten thousand small boxes scattered between the buildings
+static void occlusion_test_boxes(benchmark::State& state)
+{
+    const el::matrix<float, 4, 4> camera(street_camera());
+    el::occlusion_buffer buffer(256, 128);
+    for (const el::mesh& b : city())
+        buffer.add_occluder(b, camera);
+    buffer.render();
+
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> x(-160, 160), z(-320, -4);
+    std::vector<std::pair<el::point<float, 3>, el::point<float, 3>>> boxes;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float bx(x(random)), bz(z(random));
+        boxes.emplace_back(el::point<float, 3>({bx, 0.0f, bz}), el::point<float, 3>({bx + 1, 2.0f, bz + 1}));
+    }
+    size_t hidden(0);
+    for (auto _ : state)
+    {
+        hidden = 0;
+        for (const auto& box : boxes)
+            hidden += buffer.occluded(box.first, box.second, camera) ? 1 : 0;
+        benchmark::DoNotOptimize(hidden);
+    }
+    state.counters["boxes/s"] = benchmark::Counter(double(boxes.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["hidden"] = double(hidden);
+}
+BENCHMARK(occlusion_test_boxes);
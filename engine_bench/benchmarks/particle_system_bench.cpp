@@ -0,0 +1,61 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "particle_system/particle_system.hpp"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+    constexpr size_t particle_count(10'000'000);
+
+    // a full pool with long lifetimes, except every 64th particle expiring each frame
+    el::particle_system& full_pool()
+    {
+        static el::particle_system particles = []
+        {
+            el::particle_forces forces;
+            forces.drag = 0.1f;
+            forces.attractors.push_back({el::point<float, 3>(std::array<float, 3>{0, 10, 0}), 5});
+            el::particle_system pool(particle_count, forces, 1);
+            for (size_t i = 0; i < particle_count; ++i)
+                pool.emit(el::point<float, 3>(std::array<float, 3>{float(i % 1000) * 0.01f, 0, float(i / 1000) * 0.01f}),
+                          el::direction<float, 3>(std::array<float, 3>{0, 5, 0}), i % 64 == 0 ? 0.0f : 1e9f);
+            return pool;
+        }();
+        return particles;
+    }
+}
+
+// arg: worker threads; one 60 Hz frame of 10M particles with gravity, drag and an attractor
+static void particle_update(benchmark::State& state)
+{
+    el::particle_system& particles(full_pool());
+    el::thread_pool pool(size_t(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        // refill what expired, so every frame compacts the same amount
+        while (particles.emit(el::point<float, 3>(), el::direction<float, 3>(std::array<float, 3>{0, 5, 0}), 0.0f))
+        {
+        }
+        state.ResumeTiming();
+        particles.update(1.0f / 60, pool);
+    }
+    state.counters["particles/s"] = benchmark::Counter(double(particle_count), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(particle_update)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void particle_project(benchmark::State& state)
+{
+    const el::particle_system& particles(full_pool());
+    el::matrix<float, 4, 4> view;
+    for (size_t i = 0; i < 4; ++i)
+        view(i, i) = 0.1f;
+    view(3, 3) = 1;
+    std::vector<std::array<float, 2>> screen;
+    for (auto _ : state)
+        particles.project(view, 1920, 1080, screen);
+    state.counters["particles/s"] = benchmark::Counter(double(particles.size()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(particle_project)->Unit(benchmark::kMillisecond)->UseRealTime();
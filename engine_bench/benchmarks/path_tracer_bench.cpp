@@ -0,0 +1,66 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "path_tracer/path_tracer.hpp"
+#include "benchmark/benchmark.h"
+
+#include <optional>
+
+namespace
+{
+    constexpr size_t image_side(96);
+
+    // a closed box of tessellated walls with a light on the ceiling, so most paths bounce several times
+    el::path_tracing_scene box_scene()
+    {
+        el::path_tracing_scene scene;
+        const uint32_t white(scene.add_material({{0.75f, 0.75f, 0.75f}, {0, 0, 0}}));
+        const uint32_t light(scene.add_material({{0, 0, 0}, {10, 10, 10}}));
+
+        el::mesh walls;
+        constexpr size_t cells(16);
+        for (size_t axis = 0; axis < 3; ++axis)
+            for (float side : {-1.0f, 1.0f})
+                for (size_t i = 0; i < cells; ++i)
+                    for (size_t j = 0; j < cells; ++j)
+                    {
+                        auto corner = [&](size_t u, size_t v)
+                        {
+                            std::array<float, 3> position{};
+                            position[axis] = side;
+                            position[(axis + 1) % 3] = -1.0f + 2.0f * float(u) / cells;
+                            position[(axis + 2) % 3] = -1.0f + 2.0f * float(v) / cells;
+                            return walls.add_vertex(el::point<float, 3>(position));
+                        };
+                        const uint32_t a(corner(i, j)), b(corner(i + 1, j)), c(corner(i + 1, j + 1)), d(corner(i, j + 1));
+                        walls.add_triangle(a, b, c);
+                        walls.add_triangle(a, c, d);
+                    }
+        walls.generate_normals();
+        scene.add_mesh(walls, white);
+        scene.add_sphere(el::point<float, 3>({0, 0.9f, 0}), 0.2f, light);
+        scene.add_sphere(el::point<float, 3>({0.3f, -0.6f, 0.2f}), 0.4f, white);
+        scene.build();
+        return scene;
+    }
+}
+
+// arg: rendering threads, the caller included; samples/s counts pixel samples, one per pixel and pass
+static void path_tracer_pass(benchmark::State& state)
+{
+    const el::path_tracing_scene scene(box_scene());
+    el::path_tracer_settings settings;
+    settings.width = image_side;
+    settings.height = image_side;
+    el::path_tracer tracer(scene, {el::point<float, 3>({0, 0, -0.95f}), el::point<float, 3>(), {0, 1, 0}, 70},
+                           settings);
+    const size_t threads(state.range(0));
+    std::optional<el::thread_pool> helpers;
+    el::thread_pool& pool(threads == 1 ? el::thread_pool::serial() : helpers.emplace(threads - 1));
+    for (auto _ : state)
+        tracer.render_pass(pool);
+    state.counters["samples/s"] = benchmark::Counter(double(image_side * image_side),
+                                                     benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(path_tracer_pass)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,55 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "predicates/predicates.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // arg 0: random points, decided by the floating-point filter; arg 1: points next to the
+    // line y = x, which fall through to exact arithmetic
+    std::vector<std::array<double, 2>> test_points(bool degenerate)
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<double> coordinate(0, 1);
+        std::uniform_int_distribution<int> offset(0, 15);
+        std::vector<std::array<double, 2>> points(4096);
+        for (auto& p : points)
+            if (degenerate)
+                p = {0.5 + offset(random) * std::ldexp(1.0, -53), 0.5 + offset(random) * std::ldexp(1.0, -53)};
+            else
+                p = {coordinate(random), coordinate(random)};
+        return points;
+    }
+}
+
+// arg: 0 for random points, 1 for nearly collinear ones
+static void predicates_orient2d(benchmark::State& state)
+{
+    const auto points(test_points(state.range(0) != 0));
+    const std::array<double, 2> b{12, 12}, c{24, 24};
+    for (auto _ : state)
+        for (const auto& a : points)
+            benchmark::DoNotOptimize(el::orient2d(a, b, c));
+    state.counters["tests/s"] = benchmark::Counter(double(points.size()),
+                                                   benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(predicates_orient2d)->Arg(0)->Arg(1);
+
+// arg: 0 for random points, 1 for points a few ulps from the circle
+static void predicates_incircle(benchmark::State& state)
+{
+    const auto points(test_points(state.range(0) != 0));
+    const std::array<double, 2> a{5, 0}, b{0, 5}, c{-5, 0};
+    for (auto _ : state)
+        for (const auto& p : points)
+            benchmark::DoNotOptimize(el::incircle(a, b, c, {p[0] + 2.5, p[1] + 3.5}));
+    state.counters["tests/s"] = benchmark::Counter(double(points.size()),
+                                                   benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(predicates_incircle)->Arg(0)->Arg(1);
@@ -0,0 +1,143 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "ray/ray_packet.hpp"
+#include "benchmark/benchmark.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr size_t ray_count(1 << 16);
+    constexpr size_t primitive_count(16);
+
+    // random rays shot from in front of a cluster of primitives, kept both as AoS and SoA
+    struct ray_fixture
+    {
+        std::vector<el::ray<float, 3>> rays;
+        std::array<std::vector<float>, 3> origin;
+        std::array<std::vector<float>, 3> direction;
+        std::vector<el::point<float, 3>> vertices;
+        std::vector<el::point<float, 3>> centers;
+
+        ray_fixture()
+        {
+            std::mt19937 random(5);
+            std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+            for (size_t i = 0; i < ray_count; ++i)
+            {
+                const std::array<float, 3> from{coordinate(random), coordinate(random), -4.0f};
+                const std::array<float, 3> towards{coordinate(random) - from[0], coordinate(random) - from[1], 4.0f};
+                rays.emplace_back(el::point<float, 3>(from), towards);
+                for (size_t axis = 0; axis < 3; ++axis)
+                {
+                    origin[axis].push_back(from[axis]);
+                    direction[axis].push_back(towards[axis]);
+                }
+            }
+            for (size_t i = 0; i < 3 * primitive_count; ++i)
+                vertices.emplace_back(std::array<float, 3>{coordinate(random), coordinate(random), coordinate(random)});
+            for (size_t i = 0; i < primitive_count; ++i)
+                centers.emplace_back(std::array<float, 3>{coordinate(random), coordinate(random), coordinate(random)});
+        }
+    };
+
+    const ray_fixture& fixture()
+    {
+        static const ray_fixture instance;
+        return instance;
+    }
+
+    // Mrays/s counts ray-primitive tests, every ray is tested against every primitive
+    void report_mrays(benchmark::State& state)
+    {
+        state.counters["Mrays/s"] = benchmark::Counter(double(ray_count * primitive_count) / 1e6,
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    float closest_scalar(const el::ray<float, 3>& r, size_t kind)
+    {
+        const ray_fixture& data(fixture());
+        float closest(std::numeric_limits<float>::infinity());
+        for (size_t i = 0; i < primitive_count; ++i)
+        {
+            std::optional<float> hit;
+            switch (kind)
+            {
+            case 0:
+                if (const auto triangle = el::intersect_triangle(r, data.vertices[3 * i], data.vertices[3 * i + 1],
+                                                                 data.vertices[3 * i + 2], closest))
+                    hit = triangle->distance;
+                break;
+            case 1:
+                hit = el::intersect_box(r, data.vertices[2 * i], data.vertices[2 * i] + el::point<float, 3>({0.3f, 0.3f, 0.3f}),
+                                        closest);
+                break;
+            case 2:
+                hit = el::intersect_sphere(r, data.centers[i], 0.1f, closest);
+                break;
+            default:
+                hit = el::intersect_plane(r, data.centers[i], {0.1f, 0.2f, 1}, closest);
+            }
+            if (hit)
+                closest = *hit;
+        }
+        return closest;
+    }
+
+    template <size_t W>
+    el::float_pack<W> closest_packet(const el::ray_packet<W>& rays, size_t kind)
+    {
+        const ray_fixture& data(fixture());
+        el::float_pack<W> closest(std::numeric_limits<float>::infinity());
+        for (size_t i = 0; i < primitive_count; ++i)
+            switch (kind)
+            {
+            case 0:
+                closest = min(closest, el::intersect_triangle(rays, data.vertices[3 * i], data.vertices[3 * i + 1],
+                                                              data.vertices[3 * i + 2], closest));
+                break;
+            case 1:
+                closest = min(closest, el::intersect_box(rays, data.vertices[2 * i],
+                                                         data.vertices[2 * i] + el::point<float, 3>({0.3f, 0.3f, 0.3f}),
+                                                         closest));
+                break;
+            case 2:
+                closest = min(closest, el::intersect_sphere(rays, data.centers[i], 0.1f, closest));
+                break;
+            default:
+                closest = min(closest, el::intersect_plane(rays, data.centers[i], {0.1f, 0.2f, 1}, closest));
+            }
+        return closest;
+    }
+}
+
+// arg: 0 triangles, 1 boxes, 2 spheres, 3 planes
+static void ray_scalar(benchmark::State& state)
+{
+    const ray_fixture& data(fixture());
+    for (auto _ : state)
+        for (const auto& r : data.rays)
+            benchmark::DoNotOptimize(closest_scalar(r, size_t(state.range(0))));
+    report_mrays(state);
+}
+BENCHMARK(ray_scalar)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+template <size_t W>
+static void ray_packet_soa(benchmark::State& state)
+{
+    const ray_fixture& data(fixture());
+    for (auto _ : state)
+        for (size_t first = 0; first < ray_count; first += W)
+        {
+            const auto packet(el::ray_packet<W>::load(
+                {&data.origin[0][first], &data.origin[1][first], &data.origin[2][first]},
+                {&data.direction[0][first], &data.direction[1][first], &data.direction[2][first]}));
+            benchmark::DoNotOptimize(closest_packet(packet, size_t(state.range(0))));
+        }
+    report_mrays(state);
+}
+BENCHMARK_TEMPLATE(ray_packet_soa, 4)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(ray_packet_soa, 8)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
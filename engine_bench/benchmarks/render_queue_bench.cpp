@@ -0,0 +1,104 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "render_queue/render_queue.hpp"
+#include "thread_pool/thread_pool.hpp"
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    constexpr size_t command_count(100'000);
+
+    struct draw
+    {
+        float transform[12];
+        uint32_t mesh;
+        uint32_t instance;
+    };
+
+    // busy work standing in for simulating or submitting one frame
+    void spin(std::chrono::microseconds duration)
+    {
+        const auto end(std::chrono::steady_clock::now() + duration);
+        while (std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+}
+
+// arg: recording threads; 100k draws over 64 pipelines and 256 textures, recorded and sorted
+static void render_record_and_sort(benchmark::State& state)
+{
+    el::thread_pool pool(size_t(state.range(0)));
+    el::render_frame frame(pool.size());
+    const size_t grain((command_count + pool.size() - 1) / pool.size());
+    size_t changes(0);
+    for (auto _ : state)
+    {
+        frame.clear();
+        pool.parallel_for(0, command_count, grain, [&](size_t first, size_t last)
+        {
+            el::command_buffer& buffer(frame.buffer(first / grain));
+            for (size_t i = first; i < last; ++i)
+            {
+                const uint32_t hash(uint32_t(i * 2654435761u));
+                buffer.record(el::make_render_key(1, uint16_t(hash % 64), uint16_t(hash >> 8 & 255),
+                                                  el::quantize_depth(float(hash >> 16) / 65536.0f)),
+                              0, draw{{}, hash % 64, uint32_t(i)});
+            }
+        });
+        frame.sort();
+        changes = frame.state_changes();
+    }
+    state.counters["commands/s"] = benchmark::Counter(double(command_count), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["state changes"] = double(changes);
+}
+BENCHMARK(render_record_and_sort)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// arg: 0 simulates and renders on one thread, 1 overlaps them through the queue; 2 ms each per frame
+static void render_frame_latency(benchmark::State& state)
+{
+    constexpr std::chrono::microseconds work(2000);
+    constexpr int frames = 50;
+    for (auto _ : state)
+    {
+        el::render_queue queue;
+        if (state.range(0) == 0)
+            for (int n = 0; n < frames; ++n)
+            {
+                el::render_frame* frame(queue.begin_recording());
+                spin(work);
+                frame->buffer(0).record(0, 0, n);
+                queue.submit();
+                queue.acquire();
+                spin(work);
+                queue.release();
+            }
+        else
+        {
+            std::thread simulation([&]
+            {
+                for (int n = 0; n < frames; ++n)
+                {
+                    el::render_frame* frame(queue.begin_recording());
+                    spin(work);
+                    frame->buffer(0).record(0, 0, n);
+                    queue.submit();
+                }
+                queue.close();
+            });
+            while (queue.acquire() != nullptr)
+            {
+                spin(work);
+                queue.release();
+            }
+            simulation.join();
+        }
+    }
+    state.counters["frames/s"] = benchmark::Counter(double(frames), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(render_frame_latency)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
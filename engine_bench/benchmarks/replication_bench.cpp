@@ -0,0 +1,80 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "replication/replication.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+
+namespace
+{
+    el::replicated_state walker(size_t index, float time)
+    {
+        const float angle(time + float(index));
+        el::replicated_state state;
+        state.position = el::point<float, 3>(std::array<float, 3>{
+            float(index % 64) * 16 + 6 * std::cos(angle), 0, float(index / 64) * 16 + 6 * std::sin(angle)});
+        state.orientation = {std::cos(angle / 2), 0, std::sin(angle / 2), 0};
+        return state;
+    }
+}
+
+// arg: entities, a quarter moving; one client, every packet delivered and acknowledged
+static void replication_tick(benchmark::State& state)
+{
+    const auto entities(size_t(state.range(0)));
+    el::replication_server server;
+    el::replication_client client;
+    server.add_client();
+    for (size_t i = 0; i < entities; ++i)
+        server.add(walker(i, 0));
+    std::vector<unsigned char> packet, ack;
+    float time(0);
+    // warm up until every entity was delivered once
+    for (int tick = 0; tick < 200; ++tick)
+    {
+        server.advance();
+        server.write_packet(0, packet);
+        client.receive(packet.data(), packet.size());
+        client.write_ack(ack);
+        server.receive_ack(0, ack.data(), ack.size());
+    }
+    size_t bytes(0), written(0);
+    for (auto _ : state)
+    {
+        time += 1.0f / 60;
+        for (size_t i = 0; i < entities / 4; ++i)
+            server.set(uint32_t(i), walker(i, time));
+        server.advance();
+        written += server.write_packet(0, packet);
+        bytes += packet.size();
+        client.receive(packet.data(), packet.size());
+        client.write_ack(ack);
+        server.receive_ack(0, ack.data(), ack.size());
+    }
+    state.counters["bytes/tick"] = benchmark::Counter(double(bytes), benchmark::Counter::kAvgIterations);
+    state.counters["entities/tick"] = benchmark::Counter(double(written), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(replication_tick)->Arg(100)->Arg(1000)->Arg(10000);
+
+// arg: bits per value of a packed stream written and read back
+static void bit_stream_roundtrip(benchmark::State& state)
+{
+    const auto bits(unsigned(state.range(0)));
+    constexpr size_t count = 10000;
+    std::vector<unsigned char> buffer;
+    for (auto _ : state)
+    {
+        el::bit_writer out(buffer);
+        for (uint32_t i = 0; i < count; ++i)
+            out.write_bits(i * 2654435761u, bits);
+        el::bit_reader in(buffer.data(), buffer.size());
+        uint32_t sum(0);
+        for (size_t i = 0; i < count; ++i)
+            sum += in.read_bits(bits);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["values/s"] = benchmark::Counter(double(count), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(bit_stream_roundtrip)->Arg(5)->Arg(20);
@@ -0,0 +1,101 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "rigid_body/rigid_body.hpp"
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // balls dropped in layers into a walled box, so they pile up about ten deep
+    el::rigid_body_world ball_pile(size_t count)
+    {
+        el::rigid_body_world world;
+        const size_t side(size_t(std::ceil(std::sqrt(double(count) / 10))));
+        const float half(0.5f * float(side));
+        world.add_plane(el::point<float, 3>(), {0, 1, 0});
+        world.add_plane(el::point<float, 3>(std::array<float, 3>{-half, 0, 0}), {1, 0, 0});
+        world.add_plane(el::point<float, 3>(std::array<float, 3>{half, 0, 0}), {-1, 0, 0});
+        world.add_plane(el::point<float, 3>(std::array<float, 3>{0, 0, -half}), {0, 0, 1});
+        world.add_plane(el::point<float, 3>(std::array<float, 3>{0, 0, half}), {0, 0, -1});
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t layer(i / (side * side)), row(i / side % side), column(i % side);
+            // alternate layers are shifted so the balls do not balance on top of each other
+            const float shift(layer % 2 == 0 ? 0.0f : 0.05f);
+            world.add_body(el::solid_sphere(
+                el::point<float, 3>(std::array<float, 3>{-half + 0.5f + float(column) + shift, 0.5f + 1.05f * float(layer),
+                                                         -half + 0.5f + float(row) + shift}),
+                0.45f, 1));
+        }
+        return world;
+    }
+
+    // columns of eight balls on a floor, two meters apart, so every column is an island of its own
+    el::rigid_body_world ball_stacks(size_t count)
+    {
+        constexpr size_t height(8);
+        el::rigid_body_world world;
+        const size_t stacks((count + height - 1) / height);
+        const size_t side(size_t(std::ceil(std::sqrt(double(stacks)))));
+        world.add_plane(el::point<float, 3>(), {0, 1, 0});
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t stack(i / height), level(i % height);
+            world.add_body(el::solid_sphere(
+                el::point<float, 3>(std::array<float, 3>{2.0f * float(stack % side), 0.45f + 0.9f * float(level),
+                                                         2.0f * float(stack / side)}),
+                0.45f, 1));
+        }
+        return world;
+    }
+
+    void report(benchmark::State& state, const el::rigid_body_world& world)
+    {
+        state.counters["contacts"] = double(world.contact_count());
+        state.counters["islands"] = double(world.island_count());
+        state.counters["contacts/island"] =
+            double(world.contact_count()) / double(std::max<size_t>(world.island_count(), 1));
+        state.counters["bodies/s"] =
+            benchmark::Counter(double(state.range(0)), benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
+// arg: bodies; one 60 Hz step of a settled pile, real time needs under 16.7 ms
+static void rigid_body_pile_step(benchmark::State& state)
+{
+    el::rigid_body_world world(ball_pile(size_t(state.range(0))));
+    for (int i = 0; i < 120; ++i)
+        world.step(1.0f / 60);
+    for (auto _ : state)
+        world.step(1.0f / 60);
+    report(state, world);
+}
+BENCHMARK(rigid_body_pile_step)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// arg: bodies; many small islands, the case the parallel island solve is built for
+static void rigid_body_stacks_step(benchmark::State& state)
+{
+    el::rigid_body_world world(ball_stacks(size_t(state.range(0))));
+    for (int i = 0; i < 120; ++i)
+        world.step(1.0f / 60);
+    for (auto _ : state)
+        world.step(1.0f / 60);
+    report(state, world);
+}
+BENCHMARK(rigid_body_stacks_step)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// integration alone: free falling bodies without contacts
+static void rigid_body_free_fall(benchmark::State& state)
+{
+    el::rigid_body_world world;
+    for (size_t i = 0; i < size_t(state.range(0)); ++i)
+        world.add_body(el::solid_sphere(el::point<float, 3>(std::array<float, 3>{4.0f * float(i), 0, 0}), 0.5f, 1));
+    for (auto _ : state)
+        world.step(1.0f / 60);
+    state.counters["bodies/s"] = benchmark::Counter(double(state.range(0)), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(rigid_body_free_fall)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,91 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "fixed/fixed.hpp"
+#include "half/half.hpp"
+#include "direction/direction.hpp"
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    constexpr size_t cloud_size = 1 << 20;
+
+    template <class T>
+    std::vector<el::point<T, 3>> make_cloud()
+    {
+        std::vector<el::point<T, 3>> cloud(cloud_size);
+        for (size_t i = 0; i < cloud_size; ++i)
+            cloud[i] = el::point<T, 3>({T(int(i % 97) - 48), T(int(i % 89) - 44), T(int(i % 83) - 41)});
+        return cloud;
+    }
+
+    template <class T>
+    void report(benchmark::State& state)
+    {
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(cloud_size));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(cloud_size * sizeof(el::point<T, 3>)));
+        state.counters["bytes_per_point"] = double(sizeof(el::point<T, 3>));
+        state.counters["cloud_MiB"] = double(cloud_size * sizeof(el::point<T, 3>)) / double(1 << 20);
+    }
+}
+
+// scale and translate every point in place, the bulk transform of a point cloud
+template <class T>
+static void cloud_transform(benchmark::State& state)
+{
+    auto cloud(make_cloud<T>());
+    const el::point<T, 3> offset({T(1), T(-2), T(3)});
+    const T scale(T(1) / T(2));
+    for (auto _ : state)
+    {
+        for (auto& p : cloud)
+        {
+            p *= scale;
+            p += offset;
+        }
+        benchmark::DoNotOptimize(cloud.data());
+        benchmark::ClobberMemory();
+    }
+    report<T>(state);
+}
+BENCHMARK(cloud_transform<float>);
+BENCHMARK(cloud_transform<el::fixed16_16>);
+BENCHMARK(cloud_transform<el::half>);
+
+// length of every point, exercises the sqrt path of direction
+template <class T>
+static void cloud_lengths(benchmark::State& state)
+{
+    auto cloud(make_cloud<T>());
+    for (auto _ : state)
+    {
+        T sum(0);
+        for (const auto& p : cloud)
+            sum += el::direction<T, 3>(p).length() / T(64);
+        benchmark::DoNotOptimize(sum);
+    }
+    report<T>(state);
+}
+BENCHMARK(cloud_lengths<float>);
+BENCHMARK(cloud_lengths<el::fixed16_16>);
+BENCHMARK(cloud_lengths<el::half>);
+
+// half as storage only: widen to float, work, narrow back
+static void half_bulk_convert(benchmark::State& state)
+{
+    std::vector<el::half> packed(cloud_size * 3);
+    std::vector<float> wide(cloud_size * 3);
+    for (size_t i = 0; i < wide.size(); ++i)
+        wide[i] = float(i % 1000) * 0.01f;
+    for (auto _ : state)
+    {
+        el::convert(wide.data(), packed.data(), wide.size());
+        el::convert(packed.data(), wide.data(), packed.size());
+        benchmark::DoNotOptimize(wide.data());
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(wide.size()) * 2);
+}
+BENCHMARK(half_bulk_convert);
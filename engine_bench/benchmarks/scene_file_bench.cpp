@@ -0,0 +1,100 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_loader/mesh_loader.hpp"
+#include "scene_file/scene_file.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace
+{
+    // 724^2 quads = 1048352 triangles, about 42 MB as a scene file
+    constexpr size_t grid_side = 724;
+
+    struct scene_fixture
+    {
+        std::string obj;
+        std::string scene;
+        size_t scene_bytes;
+
+        scene_fixture()
+            : obj((std::filesystem::temp_directory_path() / "engine_bench_grid.obj").string()),
+              scene((std::filesystem::temp_directory_path() / "engine_bench_grid.l3ds").string())
+        {
+            FILE* out(std::fopen(obj.c_str(), "w"));
+            for (size_t y = 0; y <= grid_side; ++y)
+                for (size_t x = 0; x <= grid_side; ++x)
+                    std::fprintf(out, "v %zu %zu 0\nvt %g %g\n", x, y, double(x) / grid_side, double(y) / grid_side);
+            for (size_t y = 0; y < grid_side; ++y)
+                for (size_t x = 0; x < grid_side; ++x)
+                {
+                    const size_t i(y * (grid_side + 1) + x + 1), row(grid_side + 1);
+                    std::fprintf(out, "f %zu/%zu %zu/%zu %zu/%zu\nf %zu/%zu %zu/%zu %zu/%zu\n",
+                                 i, i, i + 1, i + 1, i + row + 1, i + row + 1, i, i, i + row + 1, i + row + 1, i + row,
+                                 i + row);
+                }
+            std::fclose(out);
+            el::write_scene(scene, {el::load_obj(obj)});
+            scene_bytes = std::filesystem::file_size(scene);
+        }
+
+        ~scene_fixture()
+        {
+            std::filesystem::remove(obj);
+            std::filesystem::remove(scene);
+        }
+    };
+
+    const scene_fixture& fixture()
+    {
+        static const scene_fixture instance;
+        return instance;
+    }
+}
+
+static void scene_load_obj(benchmark::State& state)
+{
+    const auto& files(fixture());
+    for (auto _ : state)
+    {
+        el::mesh m(el::load_obj(files.obj));
+        benchmark::DoNotOptimize(m.indices().data());
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(std::filesystem::file_size(files.obj)));
+}
+
+// open, verify and touch every vertex once, the cost of getting usable geometry
+static void scene_map(benchmark::State& state)
+{
+    const auto& files(fixture());
+    const auto verification(static_cast<el::scene_verification>(state.range(0)));
+    for (auto _ : state)
+    {
+        el::scene_file file(files.scene, verification);
+        const el::mesh_view view(file.get_mesh(0));
+        float sum(0.0f);
+        for (const auto& position : view.positions())
+            sum += position.coordinate(0);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(files.scene_bytes));
+}
+
+// open only, what startup pays before any geometry is used
+static void scene_open(benchmark::State& state)
+{
+    const auto& files(fixture());
+    for (auto _ : state)
+    {
+        el::scene_file file(files.scene);
+        benchmark::DoNotOptimize(file.mesh_count());
+    }
+}
+
+BENCHMARK(scene_load_obj)->Unit(benchmark::kMillisecond);
+BENCHMARK(scene_map)->Arg(int(el::scene_verification::lazy))->Arg(int(el::scene_verification::none))
+                    ->Unit(benchmark::kMillisecond);
+BENCHMARK(scene_open)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,98 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "skeletal_animation/skeletal_animation.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+
+namespace
+{
+    // a 64 joint rig of eight chains of eight, a 2 second clip at 30 Hz and 2048 vertices with four influences
+    constexpr size_t joint_count = 64;
+    constexpr size_t vertex_count = 2048;
+
+    el::matrix<float, 4, 4> identity_matrix()
+    {
+        el::matrix<float, 4, 4> result;
+        for (size_t i = 0; i < 4; ++i)
+            result(i, i) = 1;
+        return result;
+    }
+
+    el::skeleton rig()
+    {
+        std::vector<int32_t> parents(joint_count);
+        for (size_t j = 0; j < joint_count; ++j)
+            parents[j] = j == 0 ? -1 : j % 8 == 1 ? 0 : int32_t(j - 1);
+        return el::skeleton(parents, std::vector<el::matrix<float, 4, 4>>(joint_count, identity_matrix()));
+    }
+
+    el::animation_clip clip()
+    {
+        std::vector<std::vector<el::joint_transform>> frames(61, std::vector<el::joint_transform>(joint_count));
+        for (size_t f = 0; f < frames.size(); ++f)
+            for (size_t j = 1; j < joint_count; ++j)
+            {
+                const float angle(0.3f * std::sin(float(f) / 10 + float(j)));
+                frames[f][j].translation = {0, 0.2f, 0};
+                frames[f][j].rotation = {std::cos(angle / 2), std::sin(angle / 2), 0, 0};
+            }
+        return el::animation_clip(frames, 30);
+    }
+
+    std::vector<el::skin_vertex> vertices()
+    {
+        std::vector<el::skin_vertex> result(vertex_count);
+        for (size_t v = 0; v < vertex_count; ++v)
+        {
+            const auto j(uint16_t(v % (joint_count - 3)));
+            result[v] = {{float(v % 13), float(v % 7), float(v % 5)}, {0, 1, 0},
+                         {j, uint16_t(j + 1), uint16_t(j + 2), uint16_t(j + 3)}, {0.4f, 0.3f, 0.2f, 0.1f}};
+        }
+        return result;
+    }
+}
+
+// arg: characters, threads; one 60 Hz frame of sampling, palettes and skinning for a crowd
+static void skeletal_animation_crowd(benchmark::State& state)
+{
+    const el::skeleton skeleton(rig());
+    const el::animation_clip animation(clip());
+    const std::vector<el::skin_vertex> bind(vertices());
+    std::vector<float> times(size_t(state.range(0)));
+    el::thread_pool pool(state.range(1));
+    std::vector<el::matrix<float, 4, 4>> palettes;
+    std::vector<el::skinned_vertex> skinned;
+    float now(0);
+    for (auto _ : state)
+    {
+        for (size_t c = 0; c < times.size(); ++c)
+            times[c] = std::fmod(now + 0.013f * float(c), animation.duration());
+        el::animate_crowd(skeleton, animation, bind, times, palettes, skinned, pool);
+        benchmark::DoNotOptimize(skinned.data());
+        now += 1.0f / 60;
+    }
+    state.counters["vertices/s"] = benchmark::Counter(double(times.size() * vertex_count),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(skeletal_animation_crowd)->Args({1000, 1})->Args({1000, 4})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// sampling 1000 poses at once, track by track
+static void skeletal_animation_sample(benchmark::State& state)
+{
+    const el::animation_clip animation(clip());
+    std::vector<float> times(1000);
+    for (size_t c = 0; c < times.size(); ++c)
+        times[c] = std::fmod(0.013f * float(c), animation.duration());
+    std::vector<el::joint_transform> poses(times.size() * joint_count);
+    for (auto _ : state)
+    {
+        animation.sample(times.data(), times.size(), poses.data());
+        benchmark::DoNotOptimize(poses.data());
+    }
+    state.counters["poses/s"] = benchmark::Counter(double(times.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes"] = double(animation.compressed_size());
+}
+BENCHMARK(skeletal_animation_sample)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,113 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "solvers/solvers.hpp"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+    // 5-point Poisson stencil on a side x side grid, 317^2 = 100489 unknowns
+    constexpr size_t grid_side = 317;
+
+    el::csr_matrix<float> poisson_2d(size_t side)
+    {
+        std::vector<el::sparse_entry<float>> entries;
+        for (size_t y = 0; y < side; ++y)
+            for (size_t x = 0; x < side; ++x)
+            {
+                const size_t i(y * side + x);
+                entries.push_back({i, i, 4.0f});
+                if (x > 0)
+                    entries.push_back({i, i - 1, -1.0f});
+                if (x + 1 < side)
+                    entries.push_back({i, i + 1, -1.0f});
+                if (y > 0)
+                    entries.push_back({i, i - side, -1.0f});
+                if (y + 1 < side)
+                    entries.push_back({i, i + side, -1.0f});
+            }
+        return el::csr_matrix<float>(side * side, side * side, entries);
+    }
+
+    // cloth-like chain of 3D particles, 33334 blocks = 100002 unknowns
+    el::bsr_matrix<float, 3> particle_chain(size_t particles)
+    {
+        el::matrix<float, 3, 3> stiffness(el::array<el::array<float, 3>, 3>({{{4, 0.5f, 0}, {0.5f, 4, 0.5f}, {0, 0.5f, 4}}}));
+        el::matrix<float, 3, 3> spring(el::array<el::array<float, 3>, 3>({{{-1, 0, 0}, {0, -1, 0}, {0, 0, -1}}}));
+        std::vector<el::sparse_entry<el::matrix<float, 3, 3>>> entries;
+        for (size_t i = 0; i < particles; ++i)
+        {
+            entries.push_back({i, i, stiffness});
+            if (i > 0)
+                entries.push_back({i, i - 1, spring});
+            if (i + 1 < particles)
+                entries.push_back({i, i + 1, spring});
+        }
+        return el::bsr_matrix<float, 3>(particles, particles, entries);
+    }
+}
+
+static void csr_spmv(benchmark::State& state)
+{
+    static const auto a(poisson_2d(grid_side));
+    el::thread_pool pool(state.range(0));
+    std::vector<float> x(a.columns(), 1.0f), y;
+    for (auto _ : state)
+    {
+        a.multiply(x, y, pool);
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.counters["GFLOP"] = benchmark::Counter(2.0 * double(a.non_zeros()) / 1e9,
+                                                 benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(csr_spmv)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+static void bsr_spmv(benchmark::State& state)
+{
+    static const auto a(particle_chain(33334));
+    el::thread_pool pool(state.range(0));
+    std::vector<el::point<float, 3>> x(a.block_columns(), el::point<float, 3>({1, 1, 1})), y;
+    for (auto _ : state)
+    {
+        a.multiply(x, y, pool);
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.counters["GFLOP"] = benchmark::Counter(18.0 * double(a.non_zero_blocks()) / 1e9,
+                                                 benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(bsr_spmv)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+static void poisson_conjugate_gradient(benchmark::State& state)
+{
+    static const auto a(poisson_2d(grid_side));
+    el::thread_pool pool(state.range(0));
+    std::vector<float> b(a.rows(), 1.0f), x;
+    el::solver_result result{};
+    for (auto _ : state)
+    {
+        x.assign(a.rows(), 0.0f);
+        result = el::conjugate_gradient(a, b, x, 1000, 1e-4f, pool);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["iterations"] = double(result.iterations);
+    state.counters["residual"] = result.residual;
+}
+BENCHMARK(poisson_conjugate_gradient)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void chain_gauss_seidel(benchmark::State& state)
+{
+    static const auto a(particle_chain(33334));
+    el::thread_pool pool(state.range(0));
+    std::vector<el::point<float, 3>> b(a.block_rows(), el::point<float, 3>({1, 0, -1})), x;
+    el::solver_result result{};
+    for (auto _ : state)
+    {
+        x.assign(a.block_rows(), el::point<float, 3>());
+        result = el::gauss_seidel(a, b, x, 50, 1e-5f, pool);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["iterations"] = double(result.iterations);
+    state.counters["residual"] = result.residual;
+}
+BENCHMARK(chain_gauss_seidel)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
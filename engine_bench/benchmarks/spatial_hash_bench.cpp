@@ -0,0 +1,90 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "spatial_hash/spatial_hash.hpp"
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // particles in a cube sized for about one particle per cell of side 1
+    std::vector<el::point<float, 3>> particles(size_t count)
+    {
+        std::mt19937 random(9);
+        const float extent(0.5f * std::cbrt(float(count)));
+        std::uniform_real_distribution<float> coordinate(-extent, extent);
+        std::vector<el::point<float, 3>> points;
+        points.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            points.emplace_back(std::array<float, 3>{coordinate(random), coordinate(random), coordinate(random)});
+        return points;
+    }
+}
+
+// one broadphase frame: rebuild the grid, then list every pair closer than the cell size
+static void spatial_hash_frame(benchmark::State& state)
+{
+    const std::vector<el::point<float, 3>> points(particles(size_t(state.range(0))));
+    el::spatial_hash grid(1.0f);
+    size_t pairs(0);
+    for (auto _ : state)
+    {
+        grid.build(points);
+        pairs = grid.find_pairs(1.0f).size();
+        benchmark::DoNotOptimize(pairs);
+    }
+    state.counters["pairs"] = double(pairs);
+    state.counters["particles/s"] = benchmark::Counter(double(state.range(0)), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(spatial_hash_frame)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void spatial_hash_build(benchmark::State& state)
+{
+    const std::vector<el::point<float, 3>> points(particles(size_t(state.range(0))));
+    el::spatial_hash grid(1.0f);
+    for (auto _ : state)
+        grid.build(points);
+    state.counters["particles/s"] = benchmark::Counter(double(state.range(0)), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(spatial_hash_build)->Arg(1 << 20)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// the O(n²) test every pair approach the grid replaces
+static void brute_force_pairs(benchmark::State& state)
+{
+    const std::vector<el::point<float, 3>> points(particles(size_t(state.range(0))));
+    for (auto _ : state)
+    {
+        size_t pairs(0);
+        for (size_t i = 0; i < points.size(); ++i)
+            for (size_t j = i + 1; j < points.size(); ++j)
+            {
+                float sum(0);
+                for (size_t axis = 0; axis < 3; ++axis)
+                {
+                    const float difference(points[i].coordinate(axis) - points[j].coordinate(axis));
+                    sum += difference * difference;
+                }
+                pairs += sum <= 1.0f;
+            }
+        benchmark::DoNotOptimize(pairs);
+    }
+    state.counters["particles/s"] = benchmark::Counter(double(state.range(0)), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(brute_force_pairs)->Arg(1 << 12)->Unit(benchmark::kMillisecond);
+
+// arg: k
+static void spatial_hash_nearest(benchmark::State& state)
+{
+    const std::vector<el::point<float, 3>> points(particles(1 << 20));
+    const std::vector<el::point<float, 3>> queries(particles(1024));
+    el::spatial_hash grid(1.0f);
+    grid.build(points);
+    for (auto _ : state)
+        for (const auto& query : queries)
+            benchmark::DoNotOptimize(grid.query_nearest(query, size_t(state.range(0))));
+    state.counters["queries/s"] = benchmark::Counter(double(queries.size()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(spatial_hash_nearest)->Arg(1)->Arg(16)->Unit(benchmark::kMillisecond);
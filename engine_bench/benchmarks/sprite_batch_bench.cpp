@@ -0,0 +1,127 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "sprite_batch/sprite_batch.hpp"
+#include "benchmark/benchmark.h"
+
+#include <SDL3/SDL.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr size_t sprite_count(100'000);
+    constexpr uint32_t texture_count(16);
+    constexpr int screen_width(1280);
+    constexpr int screen_height(720);
+
+    // small rotated sprites scattered over the screen, textures in random order
+    struct sprite_fixture
+    {
+        std::vector<el::point<float, 2>> positions;
+        std::vector<float> rotations;
+        std::vector<uint32_t> textures;
+
+        sprite_fixture()
+        {
+            std::mt19937 random(11);
+            std::uniform_real_distribution<float> x(0, float(screen_width)), y(0, float(screen_height)), angle(0, 6.28f);
+            for (size_t i = 0; i < sprite_count; ++i)
+            {
+                positions.emplace_back(std::array<float, 2>{x(random), y(random)});
+                rotations.push_back(angle(random));
+                textures.push_back(uint32_t(random() % texture_count));
+            }
+        }
+    };
+
+    const sprite_fixture& fixture()
+    {
+        static const sprite_fixture instance;
+        return instance;
+    }
+
+    void fill(el::sprite_batch& batch)
+    {
+        const sprite_fixture& data(fixture());
+        for (size_t i = 0; i < sprite_count; ++i)
+            batch.draw(data.textures[i], data.positions[i], {4, 4}, data.rotations[i]);
+    }
+
+    // software renderer drawing into a surface, with 8x8 white textures
+    struct software_target
+    {
+        SDL_Surface* surface;
+        SDL_Renderer* renderer;
+        std::vector<SDL_Texture*> textures;
+
+        software_target()
+            : surface(SDL_CreateSurface(screen_width, screen_height, SDL_PIXELFORMAT_RGBA32)),
+              renderer(SDL_CreateSoftwareRenderer(surface))
+        {
+            const std::vector<Uint8> white(8 * 8 * 4, 255);
+            for (uint32_t i = 0; i < texture_count; ++i)
+            {
+                textures.push_back(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 8, 8));
+                SDL_UpdateTexture(textures.back(), nullptr, white.data(), 8 * 4);
+            }
+        }
+
+        ~software_target()
+        {
+            for (SDL_Texture* texture : textures)
+                SDL_DestroyTexture(texture);
+            SDL_DestroyRenderer(renderer);
+            SDL_DestroySurface(surface);
+        }
+    };
+}
+
+// 100k sprites transformed, sorted by texture and gathered into one vertex array
+static void sprite_build(benchmark::State& state)
+{
+    el::sprite_batch batch;
+    for (auto _ : state)
+    {
+        batch.clear();
+        fill(batch);
+        batch.build();
+        benchmark::DoNotOptimize(batch.vertices().data());
+    }
+    state.counters["sprites/s"] = benchmark::Counter(double(sprite_count), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["batches"] = double(batch.batches().size());
+}
+BENCHMARK(sprite_build)->Unit(benchmark::kMillisecond);
+
+// arg: 0 one SDL_RenderGeometry call per sprite, 1 batched; both on the software renderer
+static void sprite_submit(benchmark::State& state)
+{
+    software_target target;
+    el::sprite_batch batch;
+    fill(batch);
+    batch.build();
+    const std::vector<el::sprite_vertex>& vertices(batch.vertices());
+    const int quad[6]{0, 1, 2, 2, 3, 0};
+    size_t calls(0);
+    for (auto _ : state)
+    {
+        SDL_RenderClear(target.renderer);
+        if (state.range(0) == 0)
+        {
+            for (const el::sprite_batch_range& range : batch.batches())
+                for (size_t q = 0; q < range.quad_count; ++q)
+                    SDL_RenderGeometry(target.renderer, target.textures[range.texture],
+                                       reinterpret_cast<const SDL_Vertex*>(vertices.data() + range.first_vertex + 4 * q),
+                                       4, quad, 6);
+            calls = sprite_count;
+        }
+        else
+            calls = batch.submit(target.renderer, target.textures);
+        SDL_FlushRenderer(target.renderer);
+    }
+    state.counters["sprites/s"] = benchmark::Counter(double(sprite_count), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["calls"] = double(calls);
+}
+BENCHMARK(sprite_submit)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
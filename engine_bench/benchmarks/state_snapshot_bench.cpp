@@ -0,0 +1,79 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "state_snapshot/state_snapshot.hpp"
+#include "particle_system/particle_system.hpp"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+    el::particle_system full_system(size_t count)
+    {
+        el::particle_system particles(count);
+        for (size_t i = 0; i < count; ++i)
+            particles.emit(el::point<float, 3>(std::array<float, 3>{float(i % 100), float(i / 100 % 100), 0}),
+                           el::direction<float, 3>(std::array<float, 3>{0, 1, 0}), 1000);
+        return particles;
+    }
+}
+
+// arg: particles, each 32 bytes of state
+static void state_snapshot_save(benchmark::State& state)
+{
+    const el::particle_system particles(full_system(size_t(state.range(0))));
+    std::vector<unsigned char> buffer;
+    for (auto _ : state)
+    {
+        el::snapshot_writer out(buffer);
+        particles.save(out);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.counters["bytes"] = double(buffer.size());
+    state.counters["entities/s"] = benchmark::Counter(double(state.range(0)),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(state_snapshot_save)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// arg: particles, restored into a system of the same capacity
+static void state_snapshot_load(benchmark::State& state)
+{
+    el::particle_system particles(full_system(size_t(state.range(0))));
+    std::vector<unsigned char> buffer;
+    el::snapshot_writer out(buffer);
+    particles.save(out);
+    for (auto _ : state)
+    {
+        el::snapshot_reader in(buffer);
+        particles.load(in);
+        benchmark::DoNotOptimize(particles.positions(0));
+    }
+    state.counters["entities/s"] = benchmark::Counter(double(state.range(0)),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(state_snapshot_load)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// arg: particles; one tick apart the positions and ages move but velocities and lifetimes do not
+static void state_snapshot_delta(benchmark::State& state)
+{
+    el::particle_forces forces;
+    forces.gravity = el::direction<float, 3>();
+    el::particle_system particles(full_system(size_t(state.range(0))));
+    particles.set_forces(forces);
+    std::vector<unsigned char> previous, current, delta, decoded;
+    el::snapshot_writer before(previous);
+    particles.save(before);
+    particles.update(1.0f / 60);
+    el::snapshot_writer after(current);
+    particles.save(after);
+    for (auto _ : state)
+    {
+        el::delta_encode(previous, current, delta);
+        el::delta_decode(previous, delta, decoded);
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.counters["ratio"] = double(delta.size()) / double(current.size());
+    state.counters["entities/s"] = benchmark::Counter(double(state.range(0)),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(state_snapshot_delta)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,210 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "fountain.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    el::particle_emitter default_emitter()
+    {
+        el::particle_emitter fountain;
+        fountain.position_spread = 0.2f;
+        fountain.velocity = el::direction<float, 3>(std::array<float, 3>{0, 11, 0});
+        fountain.velocity_spread = 3;
+        fountain.rate = 40000;
+        fountain.lifetime = 3;
+        fountain.lifetime_spread = 1;
+        return fountain;
+    }
+
+    /* Reads the next value of a command, failing with its line number. */
+    template <class T>
+    T next(std::istringstream &words, size_t line)
+    {
+        T value;
+        if (!(words >> value))
+            throw std::runtime_error("line " + std::to_string(line) + ": missing or invalid value");
+        return value;
+    }
+}
+
+fountain_scene default_fountain_scene()
+{
+    fountain_scene scene;
+    scene.emitters.push_back(default_emitter());
+    return scene;
+}
+
+fountain_scene load_fountain_scene(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot open scene script: " + path);
+    fountain_scene scene;
+    std::string text;
+    for (size_t line = 1; std::getline(file, text); ++line)
+    {
+        std::istringstream words(text.substr(0, text.find('#')));
+        std::string command;
+        if (!(words >> command))
+            continue;
+        if (command == "capacity")
+            scene.capacity = next<size_t>(words, line);
+        else if (command == "emitter")
+        {
+            el::particle_emitter emitter;
+            std::array<float, 3> position{}, velocity{};
+            for (float &coordinate : position)
+                coordinate = next<float>(words, line);
+            emitter.position = el::point<float, 3>(position);
+            emitter.position_spread = next<float>(words, line);
+            for (float &coordinate : velocity)
+                coordinate = next<float>(words, line);
+            emitter.velocity = el::direction<float, 3>(velocity);
+            emitter.velocity_spread = next<float>(words, line);
+            emitter.rate = next<float>(words, line);
+            emitter.lifetime = next<float>(words, line);
+            emitter.lifetime_spread = next<float>(words, line);
+            scene.emitters.push_back(emitter);
+        }
+        else if (command == "drag")
+            scene.drag = next<float>(words, line);
+        else if (command == "sparks")
+            scene.sparks = next<size_t>(words, line);
+        else if (command == "viewport")
+        {
+            scene.width = next<int>(words, line);
+            scene.height = next<int>(words, line);
+            if (scene.width <= 0 || scene.height <= 0)
+                throw std::runtime_error("line " + std::to_string(line) + ": empty viewport");
+        }
+        else if (command == "dt")
+        {
+            scene.dt = next<float>(words, line);
+            if (!(scene.dt > 0))
+                throw std::runtime_error("line " + std::to_string(line) + ": dt must be positive");
+        }
+        else if (command == "at")
+        {
+            const size_t tick = next<size_t>(words, line);
+            const std::string action = next<std::string>(words, line);
+            if (action == "attract")
+            {
+                const float x = next<float>(words, line), y = next<float>(words, line);
+                scene.inputs.push_back({tick, {el::input_event_type::mouse_motion, 0, x, y}});
+                scene.inputs.push_back({tick, {el::input_event_type::mouse_button_down, 0, x, y}});
+            }
+            else if (action == "release")
+                scene.inputs.push_back({tick, {el::input_event_type::mouse_button_up, 0, 0, 0}});
+            else
+                throw std::runtime_error("line " + std::to_string(line) + ": unknown action " + action);
+        }
+        else
+            throw std::runtime_error("line " + std::to_string(line) + ": unknown command " + command);
+    }
+    if (scene.emitters.empty())
+        scene.emitters.push_back(default_emitter());
+    std::stable_sort(scene.inputs.begin(), scene.inputs.end(),
+                     [](const scripted_input &a, const scripted_input &b) { return a.tick < b.tick; });
+    return scene;
+}
+
+fountain::fountain(const fountain_scene &scene)
+    : particles(scene.capacity), sparks(scene.sparks), drag(scene.drag)
+{
+    for (const el::particle_emitter &emitter : scene.emitters)
+        particles.add_emitter(emitter);
+    emitters = scene.emitters.size();
+}
+
+void reconfigure_fountain(fountain &state, const fountain_scene &scene)
+{
+    for (size_t i = 0; i < std::max(state.emitters, scene.emitters.size()); ++i)
+    {
+        if (i >= state.emitters)
+            state.particles.add_emitter(scene.emitters[i]);
+        else if (i < scene.emitters.size())
+            state.particles.get_emitter(i) = scene.emitters[i];
+        else
+            state.particles.get_emitter(i).rate = 0;
+    }
+    state.emitters = std::max(state.emitters, scene.emitters.size());
+    state.sparks = scene.sparks;
+    state.drag = scene.drag;
+}
+
+void record_fountain_frame(fountain &state, const el::input_snapshot &controls, int width, int height,
+                           el::render_frame &frame, el::thread_pool &pool)
+{
+    const float dt = controls.dt;
+    state.now += dt;
+    /* choose the color for the frame we will draw. The sine wave trick makes it fade between colors smoothly. */
+    const double now = state.now;
+    clear_command clear;
+    clear.red = (float) (0.1 + 0.1 * SDL_sin(now));
+    clear.green = (float) (0.1 + 0.1 * SDL_sin(now + SDL_PI_D * 2 / 3));
+    clear.blue = (float) (0.1 + 0.1 * SDL_sin(now + SDL_PI_D * 4 / 3));
+    frame.buffer(0).record(el::make_render_key(0, draw_clear, 0, 0), draw_clear, clear);
+
+    /* the view shows x in [-10, 10] and y in [-2, 13] */
+    el::matrix<float, 4, 4> view;
+    view(0, 0) = 0.1f * (float)height / (float)width * 4.0f / 3.0f;
+    view(1, 1) = 2.0f / 15.0f;
+    view(1, 3) = -11.0f / 15.0f;
+    view(2, 2) = 0.01f;
+    view(3, 3) = 1;
+
+    /* holding the left mouse button pulls the particles towards the cursor */
+    el::particle_forces forces;
+    forces.drag = state.drag;
+    if (controls.mouse_button_down(0))
+    {
+        const float x = (controls.mouse_x / (float)width * 2.0f - 1.0f) / view(0, 0);
+        const float y = (1.0f - controls.mouse_y / (float)height * 2.0f - view(1, 3)) / view(1, 1);
+        forces.attractors.push_back({el::point<float, 3>(std::array<float, 3>{x, y, 0}), 60.0f});
+    }
+    state.particles.set_forces(forces);
+    state.particles.update(dt, pool);
+
+    std::vector<std::array<float, 2>> &pixels = state.pixels;
+    std::vector<SDL_FPoint> &points = state.points;
+    state.particles.project(view, (float)width, (float)height, pixels, pool);
+    points.resize(pixels.size());
+
+    /* every buffer of the frame records the points of one slice, in parallel */
+    const size_t slices = frame.buffer_count();
+    const size_t grain = SDL_max((pixels.size() + slices - 1) / slices, (size_t)1);
+    pool.parallel_for(0, pixels.size(), grain, [&](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            points[i].x = pixels[i][0];
+            points[i].y = pixels[i][1];
+        }
+        el::command_buffer &buffer = frame.buffer(first / grain);
+        points_command command = {0.7f, 0.85f, 1.0f, buffer.append(points.data() + first, last - first), last - first};
+        buffer.record(el::make_render_key(1, draw_points, 0, 0), draw_points, command);
+    });
+
+    /* frame N and N + 2 share a slot of the queue, so batch N & 1 is free again by now */
+    el::sprite_batch &sprites = state.sprite_batches[state.frame_number++ & 1];
+    sprites.clear();
+    for (size_t i = 0; i < state.sparks; ++i)
+    {
+        const float angle = (float)(now * (0.5 + 0.001 * (double)i)) + (float)i * 2.39996f;
+        const float radius = 60.0f + 0.1f * (float)i;
+        const el::point<float, 2> position(std::array<float, 2>{
+            (float)width * 0.5f + radius * SDL_cosf(angle), (float)height * 0.55f + 0.4f * radius * SDL_sinf(angle)});
+        const float warmth = (float)i / (float)state.sparks;
+        sprites.draw(0, position, {12, 12}, angle, {0.5f, 0.5f}, {0, 0, 1, 1}, {1.0f, 0.9f - 0.5f * warmth, 0.4f, 0.8f});
+    }
+    sprites.build();
+    sprites_command sparks = {&sprites};
+    frame.buffer(0).record(el::make_render_key(2, draw_sprites, 0, 0), draw_sprites, sparks);
+}
@@ -0,0 +1,93 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef FOUNTAIN_HPP
+#define FOUNTAIN_HPP
+
+#include "input_system/input_system.hpp"
+#include "particle_system/particle_system.hpp"
+#include "render_queue/render_queue.hpp"
+#include "sprite_batch/sprite_batch.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <string>
+#include <vector>
+
+/*
+ * The particle fountain and the sparks circling it, shared by engine_game and engine_headless.
+ * record_fountain_frame() steps the simulation by one input snapshot and records the draw
+ * commands of the frame; engine_game executes them with SDL, engine_headless only walks them.
+ *
+ * Scene scripts configure the fountain and script its input, one command per line, # starts
+ * a comment:
+ *
+ *     capacity N                       most particles alive at once
+ *     emitter X Y Z SPREAD VX VY VZ VSPREAD RATE LIFETIME LIFETIME_SPREAD
+ *     drag D                           velocity lost per second, as a fraction
+ *     sparks N                         sprites circling the fountain
+ *     viewport W H                     output size the frames are recorded for
+ *     dt SECONDS                       simulated time per tick
+ *     at TICK attract X Y              from that tick on, pull the particles towards pixel (X, Y)
+ *     at TICK release                  stop pulling
+ *
+ * A script without emitters gets the fountain of engine_game.
+ */
+
+/* Command types and payloads recorded for the renderer. */
+enum draw_command_type { draw_clear, draw_points, draw_sprites };
+struct clear_command { float red, green, blue; };
+struct points_command { float red, green, blue; size_t points; size_t count; };
+struct sprites_command { el::sprite_batch *batch; };
+
+/* An input event a scene script queues before a tick. */
+struct scripted_input
+{
+    size_t tick;
+    el::input_event event;
+};
+
+/* Everything a scene script sets. */
+struct fountain_scene
+{
+    size_t capacity = 200000;
+    std::vector<el::particle_emitter> emitters;
+    float drag = 0.2f;
+    size_t sparks = 2000;
+    int width = 640;
+    int height = 480;
+    float dt = 1.0f / 60;
+    std::vector<scripted_input> inputs;  /* sorted by tick */
+};
+
+/* The scene engine_game shows. */
+fountain_scene default_fountain_scene();
+
+/* Reads a scene script; throws std::runtime_error naming the line of the first error. */
+fountain_scene load_fountain_scene(const std::string &path);
+
+/* Simulation state of the fountain, owned by the thread that records the frames. */
+struct fountain
+{
+    el::particle_system particles;
+    el::sprite_batch sprite_batches[2];  /* one per frame in flight, the render queue holds two */
+    size_t sparks;
+    float drag;
+    size_t emitters = 0;  /* emitters added to particles, the ones a reload removed have rate 0 */
+    size_t frame_number = 0;
+    double now = 0;
+    std::vector<std::array<float, 2>> pixels;
+    std::vector<SDL_FPoint> points;
+
+    explicit fountain(const fountain_scene &scene);
+};
+
+/* Takes the emitters, drag and sparks of a reloaded script; the capacity and the live particles stay. */
+void reconfigure_fountain(fountain &state, const fountain_scene &scene);
+
+/* Steps the fountain by one input snapshot and records the frame for a width x height output. */
+void record_fountain_frame(fountain &state, const el::input_snapshot &controls, int width, int height,
+                           el::render_frame &frame, el::thread_pool &pool);
+
+#endif //FOUNTAIN_HPP
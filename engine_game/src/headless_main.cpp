@@ -0,0 +1,189 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+/*
+ * Runs the engine_game simulation without a window or video subsystem, for load tests and
+ * profiling on machines without a display:
+ *
+ *     engine_headless [--scene script.txt] [--ticks N] [--threads N] [--stats stats.csv] [--replay-input file]
+ *
+ * A simulation thread records every tick into the render queue as engine_game does, and the
+ * main thread takes the frames and walks their commands without drawing. Ticks advance by the
+ * fixed dt of the scene, or by the recorded frame times of a replay. --stats writes one CSV row
+ * per tick; a summary is printed at the end.
+ */
+
+#include "fountain.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    struct options
+    {
+        std::string scene;
+        size_t ticks = 600;
+        size_t threads = 0;
+        std::string stats;
+        std::string replay;
+    };
+
+    bool parse(int argc, char *argv[], options &result)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--scene") == 0 && has_value)
+                result.scene = argv[++i];
+            else if (std::strcmp(argv[i], "--ticks") == 0 && has_value)
+                result.ticks = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+                result.threads = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--stats") == 0 && has_value)
+                result.stats = argv[++i];
+            else if (std::strcmp(argv[i], "--replay-input") == 0 && has_value)
+                result.replay = argv[++i];
+            else
+                return false;
+        }
+        return result.ticks > 0;
+    }
+
+    struct tick_stats
+    {
+        double simulate_ms = 0;  /* time recording the frame on the simulation thread */
+        size_t particles = 0;
+        size_t commands = 0;  /* commands the consumer walked */
+        size_t sprite_vertices = 0;
+    };
+
+    double percentile(std::vector<double> values, double fraction)
+    {
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size() - 1, (size_t)(fraction * (double)values.size()))];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    options settings;
+    if (!parse(argc, argv, settings))
+    {
+        std::fprintf(stderr, "usage: %s [--scene script.txt] [--ticks N] [--threads N] [--stats stats.csv] "
+                     "[--replay-input file]\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        const fountain_scene script = settings.scene.empty() ? default_fountain_scene()
+                                                             : load_fountain_scene(settings.scene);
+        std::unique_ptr<el::input_replay> replay;
+        if (!settings.replay.empty())
+            replay = std::make_unique<el::input_replay>(settings.replay);
+        el::thread_pool pool(settings.threads);
+        el::render_queue frame_queue(pool.size());
+        fountain state(script);
+        el::input_system input;
+        std::vector<tick_stats> stats(settings.ticks);
+
+        std::exception_ptr failure;
+        size_t simulated = 0;
+        const auto start = std::chrono::steady_clock::now();
+        std::thread simulation([&]
+        {
+            try
+            {
+                size_t next_input = 0;
+                el::render_frame *frame;
+                while (simulated < settings.ticks && (frame = frame_queue.begin_recording()) != nullptr)
+                {
+                    const el::input_snapshot *controls;
+                    if (replay)
+                    {
+                        controls = replay->next();
+                        if (controls == nullptr)
+                            break;
+                    }
+                    else
+                    {
+                        for (; next_input < script.inputs.size() && script.inputs[next_input].tick <= simulated; ++next_input)
+                            input.push(script.inputs[next_input].event);
+                        controls = &input.tick(script.dt);
+                    }
+                    const auto begin = std::chrono::steady_clock::now();
+                    record_fountain_frame(state, *controls, script.width, script.height, *frame, pool);
+                    tick_stats &tick = stats[simulated];
+                    tick.simulate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+                    tick.particles = state.particles.size();
+                    tick.sprite_vertices = state.sprite_batches[(state.frame_number - 1) & 1].vertices().size();
+                    ++simulated;
+                    frame_queue.submit();
+                }
+            }
+            catch (...)
+            {
+                failure = std::current_exception();
+            }
+            frame_queue.close();
+        });
+
+        /* the render side: frames come out in submission order, so the n-th frame is tick n */
+        size_t consumed = 0;
+        const el::render_frame *frame;
+        while ((frame = frame_queue.acquire()) != nullptr)
+        {
+            size_t commands = 0;
+            frame->execute([&](const el::command_buffer &, const el::render_command &) { ++commands; });
+            stats[consumed++].commands = commands;
+            frame_queue.release();
+        }
+        simulation.join();
+        if (failure)
+            std::rethrow_exception(failure);
+        const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+        stats.resize(simulated);
+        if (stats.empty())
+            throw std::runtime_error("The replay holds no ticks");
+
+        if (!settings.stats.empty())
+        {
+            std::ofstream csv(settings.stats);
+            if (!csv)
+                throw std::runtime_error("Cannot write the stats file: " + settings.stats);
+            csv << "tick,simulate_ms,particles,commands,sprite_vertices\n";
+            for (size_t i = 0; i < stats.size(); ++i)
+                csv << i << ',' << stats[i].simulate_ms << ',' << stats[i].particles << ',' << stats[i].commands << ','
+                    << stats[i].sprite_vertices << '\n';
+        }
+
+        std::vector<double> times(stats.size());
+        double total = 0;
+        size_t particles = 0;
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            times[i] = stats[i].simulate_ms;
+            total += times[i];
+            particles = std::max(particles, stats[i].particles);
+        }
+        std::printf("%zu ticks in %.2f s (%.1f ticks/s) on %zu threads, up to %zu particles\n", stats.size(),
+                    elapsed.count(), (double)stats.size() / elapsed.count(), pool.size(), particles);
+        std::printf("simulate ms per tick: mean %.3f, p50 %.3f, p99 %.3f, max %.3f\n", total / (double)stats.size(),
+                    percentile(times, 0.5), percentile(times, 0.99), percentile(times, 1.0));
+    }
+    catch (const std::exception &error)
+    {
+        std::fprintf(stderr, "error: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -1,34 +1,148 @@
-/* clear.c ... */
-
 /*
- * This example code creates an SDL window and renderer, and then clears the
- * window to a different color every frame, so you'll effectively get a window
- * that's smoothly fading between colors.
+ * engine_game: a particle fountain with circling sparks in an SDL window.
+ *
+ *     engine_game [--scene script.txt] [--record-input file | --replay-input file]
+ *     engine_game --path-trace image.pfm [--spp N] [--size WxH] [--seed N] [--threads N]
  *
- * This code is public domain. Feel free to use it for any purpose!
+ * A simulation thread steps the fountain one frame ahead and records its draw commands into
+ * the render queue, and the main thread renders the last finished frame. The simulation is
+ * shared with engine_headless, which runs it without a window. --scene watches a scene script
+ * and applies its edits between two frames; --path-trace renders a reference image and exits.
  */
 
 #include "engine_lib.hpp"
+#include "fountain.hpp"
+#include "hot_reload/hot_reload.hpp"
+#include "input_system/input_system.hpp"
+#include "path_trace_mode.hpp"
+#include "render_queue/render_queue.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 /* We will use this renderer to draw into this window every frame. */
 static SDL_Window *window = NULL;
 static SDL_Renderer *renderer = NULL;
 
+/* A particle fountain with circling sparks, simulated on its own thread one frame ahead of the renderer. */
+static fountain *scene = NULL;
+static el::render_queue *frame_queue = NULL;
+static std::thread simulation_thread;
+static std::atomic<int> output_width(640);
+static std::atomic<int> output_height(480);
+
+/* Events go from SDL_AppEvent to the simulation through the input ring; the snapshots can be recorded or replayed. */
+static el::input_system *input = NULL;
+static el::input_recorder *input_recording = NULL;
+static el::input_replay *input_playback = NULL;
+
+/* With --scene, the script is watched and its edits reach the fountain between two frames. */
+static el::hot_reloader *reloader = NULL;
+static el::hot_asset<fountain_scene> *scene_script = NULL;
+
+/* The spark texture the sprite batches refer to as texture 0. */
+static std::vector<SDL_Texture *> sprite_textures;
+
+/* Simulates frame N + 1 and records its draw commands while the main thread renders frame N. */
+static void simulate(void)
+{
+    el::thread_pool &pool = el::thread_pool::global();
+    Uint64 last_ticks = SDL_GetTicks();
+    el::render_frame *frame;
+    while ((frame = frame_queue->begin_recording()) != NULL) {
+        /* one input snapshot per frame, live or replayed; a replay also replays the frame times */
+        const Uint64 ticks = SDL_GetTicks();
+        const el::input_snapshot *controls;
+        if (input_playback != NULL) {
+            controls = input_playback->next();
+            if (controls == NULL) {
+                frame_queue->close();  /* the replay is over */
+                break;
+            }
+        } else {
+            /* advance by the frame time, capped so a stall does not explode the fountain */
+            controls = &input->tick(SDL_min((float)(ticks - last_ticks) / 1000.0f, 0.05f));
+        }
+        if (input_recording != NULL) {
+            input_recording->write(*controls);
+        }
+        last_ticks = ticks;
+        /* the frame boundary: nothing reads the scene until record_fountain_frame() */
+        if (reloader != NULL) {
+            for (const std::string &error : reloader->take_errors()) {
+                SDL_Log("Scene reload failed: %s", error.c_str());
+            }
+            if (reloader->apply() > 0) {
+                reconfigure_fountain(*scene, scene_script->get());
+            }
+        }
+        record_fountain_frame(*scene, *controls, output_width.load(), output_height.load(), *frame, pool);
+        frame_queue->submit();
+    }
+}
+
 /* This function runs once at startup. */
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
 {
-    SDL_SetAppMetadata("Example Renderer Clear", "1.0", "com.example.renderer-clear");
+    /* headless reference render, no window needed */
+    if (is_path_trace_mode(argc, argv)) {
+        return run_path_trace_mode(argc, argv) == 0 ? SDL_APP_SUCCESS : SDL_APP_FAILURE;
+    }
+
+    SDL_SetAppMetadata("linux3d engine_game", "1.0", "com.linux3d.engine-game");
 
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
         return SDL_APP_FAILURE;
     }
 
-    if (!SDL_CreateWindowAndRenderer("examples/renderer/clear", 640, 480, 0, &window, &renderer)) {
+    if (!SDL_CreateWindowAndRenderer("engine_game", 640, 480, 0, &window, &renderer)) {
         SDL_Log("Couldn't create window/renderer: %s", SDL_GetError());
         return SDL_APP_FAILURE;
     }
 
+    input = new el::input_system();
+    for (int i = 1; i + 1 < argc; ++i) {
+        try {
+            if (std::strcmp(argv[i], "--record-input") == 0) {
+                input_recording = new el::input_recorder(argv[++i]);
+            } else if (std::strcmp(argv[i], "--replay-input") == 0) {
+                input_playback = new el::input_replay(argv[++i]);
+            } else if (std::strcmp(argv[i], "--scene") == 0) {
+                reloader = new el::hot_reloader();
+                scene_script = new el::hot_asset<fountain_scene>(reloader->watch<fountain_scene>(argv[++i], load_fountain_scene));
+            }
+        } catch (const std::exception &error) {
+            SDL_Log("%s", error.what());
+            return SDL_APP_FAILURE;
+        }
+    }
+
+    scene = new fountain(scene_script != NULL ? scene_script->get() : default_fountain_scene());
+    /* a soft round spark, white so the sprite color tints it */
+    std::vector<Uint8> spark(16 * 16 * 4);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const float dx = ((float)x - 7.5f) / 8.0f, dy = ((float)y - 7.5f) / 8.0f;
+            const float alpha = SDL_max(0.0f, 1.0f - SDL_sqrtf(dx * dx + dy * dy));
+            Uint8 *pixel = &spark[(y * 16 + x) * 4];
+            pixel[0] = pixel[1] = pixel[2] = 255;
+            pixel[3] = (Uint8)(alpha * alpha * 255.0f);
+        }
+    }
+    SDL_Texture *spark_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 16, 16);
+    if (spark_texture == NULL || !SDL_UpdateTexture(spark_texture, NULL, spark.data(), 16 * 4)) {
+        SDL_Log("Couldn't create the spark texture: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+    SDL_SetTextureBlendMode(spark_texture, SDL_BLENDMODE_BLEND);
+    sprite_textures.push_back(spark_texture);
+
+    frame_queue = new el::render_queue(el::thread_pool::global().size());
+    simulation_thread = std::thread(simulate);
+
     return SDL_APP_CONTINUE;  /* carry on with the program! */
 }
 
@@ -38,21 +152,42 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event)
     if (event->type == SDL_EVENT_QUIT) {
         return SDL_APP_SUCCESS;  /* end the program, reporting success to the OS. */
     }
+    /* the simulation folds the queued events into its next input snapshot */
+    el::input_event queued;
+    if (input != NULL && el::translate_sdl_event(*event, queued)) {
+        input->push(queued);
+    }
     return SDL_APP_CONTINUE;  /* carry on with the program! */
 }
 
 /* This function runs once per frame, and is the heart of the program. */
 SDL_AppResult SDL_AppIterate(void *appstate)
 {
-    const double now = ((double)SDL_GetTicks()) / 1000.0;  /* convert from milliseconds to seconds. */
-    /* choose the color for the frame we will draw. The sine wave trick makes it fade between colors smoothly. */
-    const float red = (float) (0.5 + 0.5 * SDL_sin(now));
-    const float green = (float) (0.5 + 0.5 * SDL_sin(now + SDL_PI_D * 2 / 3));
-    const float blue = (float) (0.5 + 0.5 * SDL_sin(now + SDL_PI_D * 4 / 3));
-    SDL_SetRenderDrawColorFloat(renderer, red, green, blue, SDL_ALPHA_OPAQUE_FLOAT);  /* new color, full alpha. */
+    int width = 0, height = 0;
+    if (SDL_GetCurrentRenderOutputSize(renderer, &width, &height) && width > 0 && height > 0) {
+        output_width = width;
+        output_height = height;
+    }
 
-    /* clear the window to the draw color. */
-    SDL_RenderClear(renderer);
+    /* execute the oldest recorded frame; the simulation thread is already recording the next one */
+    const el::render_frame *frame = frame_queue->acquire();
+    if (frame == NULL) {
+        return SDL_APP_SUCCESS;  /* only a finished replay closes the queue */
+    }
+    frame->execute([](const el::command_buffer &buffer, const el::render_command &command) {
+        if (command.type == draw_clear) {
+            const clear_command &clear = buffer.payload<clear_command>(command);
+            SDL_SetRenderDrawColorFloat(renderer, clear.red, clear.green, clear.blue, SDL_ALPHA_OPAQUE_FLOAT);  /* new color, full alpha. */
+            SDL_RenderClear(renderer);  /* clear the window to the draw color. */
+        } else if (command.type == draw_points) {
+            const points_command &points = buffer.payload<points_command>(command);
+            SDL_SetRenderDrawColorFloat(renderer, points.red, points.green, points.blue, SDL_ALPHA_OPAQUE_FLOAT);
+            SDL_RenderPoints(renderer, buffer.data<SDL_FPoint>(points.points), (int)points.count);
+        } else if (command.type == draw_sprites) {
+            buffer.payload<sprites_command>(command).batch->submit(renderer, sprite_textures);
+        }
+    });
+    frame_queue->release();
 
     /* put the newly-cleared rendering on the screen. */
     SDL_RenderPresent(renderer);
@@ -64,5 +199,25 @@ SDL_AppResult SDL_AppIterate(void *appstate)
 void SDL_AppQuit(void *appstate, SDL_AppResult result)
 {
     /* SDL will clean up the window/renderer for us. */
+    if (frame_queue != NULL) {
+        frame_queue->close();
+        if (simulation_thread.joinable()) {
+            simulation_thread.join();
+        }
+        delete frame_queue;
+        frame_queue = NULL;
+    }
+    delete scene;
+    scene = NULL;
+    delete scene_script;
+    scene_script = NULL;
+    delete reloader;
+    reloader = NULL;
+    delete input_recording;
+    input_recording = NULL;
+    delete input_playback;
+    input_playback = NULL;
+    delete input;
+    input = NULL;
 }
 
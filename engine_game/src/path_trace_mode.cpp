@@ -0,0 +1,137 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "path_trace_mode.hpp"
+
+#include "image_file/image_file.hpp"
+#include "path_tracer/path_tracer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <string>
+
+namespace
+{
+    struct options
+    {
+        std::string output;
+        size_t samples = 64;
+        el::path_tracer_settings settings;
+        size_t threads = 0;
+    };
+
+    bool parse(int argc, char *argv[], options &result)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const bool has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--path-trace") == 0 && has_value)
+                result.output = argv[++i];
+            else if (std::strcmp(argv[i], "--spp") == 0 && has_value)
+                result.samples = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+                result.settings.seed = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+                result.threads = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--size") == 0 && has_value)
+            {
+                if (std::sscanf(argv[++i], "%zux%zu", &result.settings.width, &result.settings.height) != 2)
+                    return false;
+            }
+            else
+                return false;
+        }
+        return !result.output.empty() && result.samples > 0;
+    }
+
+    void add_quad(el::mesh &target, const std::array<float, 3> &a, const std::array<float, 3> &b,
+                  const std::array<float, 3> &c, const std::array<float, 3> &d)
+    {
+        const uint32_t first = target.add_vertex(el::point<float, 3>(a));
+        target.add_vertex(el::point<float, 3>(b));
+        target.add_vertex(el::point<float, 3>(c));
+        target.add_vertex(el::point<float, 3>(d));
+        target.add_triangle(first, first + 1, first + 2);
+        target.add_triangle(first, first + 2, first + 3);
+    }
+
+    /* A Cornell-like box: white floor, ceiling and back wall, red wall on the left, green on the right, ceiling light. */
+    el::path_tracing_scene box_scene()
+    {
+        el::path_tracing_scene scene;
+        const uint32_t white = scene.add_material({{0.73f, 0.73f, 0.73f}, {0, 0, 0}});
+        const uint32_t red = scene.add_material({{0.65f, 0.05f, 0.05f}, {0, 0, 0}});
+        const uint32_t green = scene.add_material({{0.12f, 0.45f, 0.15f}, {0, 0, 0}});
+        const uint32_t light = scene.add_material({{0, 0, 0}, {15, 15, 15}});
+
+        el::mesh walls, red_wall, green_wall, lamp;
+        add_quad(walls, {-1, -1, -1}, {1, -1, -1}, {1, -1, 1}, {-1, -1, 1});
+        add_quad(walls, {-1, 1, -1}, {-1, 1, 1}, {1, 1, 1}, {1, 1, -1});
+        add_quad(walls, {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1});
+        add_quad(green_wall, {-1, -1, -1}, {-1, -1, 1}, {-1, 1, 1}, {-1, 1, -1});
+        add_quad(red_wall, {1, -1, -1}, {1, 1, -1}, {1, 1, 1}, {1, -1, 1});
+        add_quad(lamp, {-0.25f, 0.99f, -0.25f}, {-0.25f, 0.99f, 0.25f}, {0.25f, 0.99f, 0.25f}, {0.25f, 0.99f, -0.25f});
+        for (el::mesh *part : {&walls, &red_wall, &green_wall, &lamp})
+            part->generate_normals();
+        scene.add_mesh(walls, white);
+        scene.add_mesh(red_wall, red);
+        scene.add_mesh(green_wall, green);
+        scene.add_mesh(lamp, light);
+        scene.add_sphere(el::point<float, 3>({-0.4f, -0.6f, 0.3f}), 0.4f, white);
+        scene.add_sphere(el::point<float, 3>({0.45f, -0.7f, -0.3f}), 0.3f, white);
+        scene.build();
+        return scene;
+    }
+}
+
+bool is_path_trace_mode(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--path-trace") == 0)
+            return true;
+    return false;
+}
+
+int run_path_trace_mode(int argc, char *argv[])
+{
+    options settings;
+    if (!parse(argc, argv, settings))
+    {
+        std::fprintf(stderr, "usage: %s --path-trace <output.png|output.pfm> [--spp N] [--size WxH] [--seed S] "
+                     "[--threads N]\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        const el::path_tracing_scene scene = box_scene();
+        const el::camera view{el::point<float, 3>({0, 0, -3.9f}), el::point<float, 3>(), {0, 1, 0}, 40};
+        el::path_tracer tracer(scene, view, settings.settings);
+        // --threads counts the calling thread, which takes part in every pass
+        const size_t helper_count = settings.threads == 0 ? 0 : settings.threads - 1;
+        std::optional<el::thread_pool> helpers;
+        el::thread_pool &pool = settings.threads == 1 ? el::thread_pool::serial() : helpers.emplace(helper_count);
+        for (size_t pass = 0; pass < settings.samples; ++pass)
+            tracer.render_pass(pool);
+
+        const std::vector<float> image = tracer.image();
+        const el::path_tracer_settings &size = tracer.settings();
+        const std::string &output = settings.output;
+        if (output.size() >= 4 && output.compare(output.size() - 4, 4, ".pfm") == 0)
+            el::write_pfm(output, size.width, size.height, image);
+        else
+            el::write_png(output, size.width, size.height, el::linear_to_srgb8(image));
+        std::printf("wrote %s: %zux%zu, %zu spp, %.0f samples/s on %zu threads\n", output.c_str(), size.width,
+                    size.height, tracer.samples(), tracer.samples_per_second(), pool.size() + 1);
+    }
+    catch (const std::exception &error)
+    {
+        std::fprintf(stderr, "error: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef PATH_TRACE_MODE_HPP
+#define PATH_TRACE_MODE_HPP
+
+/*
+ * Headless reference render of the built-in test scene:
+ *
+ *     engine_game --path-trace <output.png|output.pfm> [--spp N] [--size WxH] [--seed S] [--threads N]
+ *
+ * Linear radiance is written for .pfm outputs, tone mapped sRGB otherwise.
+ */
+
+/* Returns whether the command line asks for the path tracing mode. */
+bool is_path_trace_mode(int argc, char *argv[]);
+
+/* Renders the scene and writes the image; returns 0 on success like main(). */
+int run_path_trace_mode(int argc, char *argv[]);
+
+#endif //PATH_TRACE_MODE_HPP
@@ -0,0 +1,385 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "skeletal_animation.hpp"
+#include "../../containers/aligned_allocator/aligned_allocator.hpp"
+#include "../../math/simd/float_pack.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // characters sampled together by animate_crowd()
+        constexpr size_t crowd_group = 8;
+
+        array<float, 4> normalized(array<float, 4> rotation)
+        {
+            float squared(0);
+            for (const float component : rotation)
+                squared += component * component;
+            const float inverse(squared > 0 ? 1 / sqrt(squared) : 0);
+            for (float& component : rotation)
+                component *= inverse;
+            return rotation;
+        }
+
+        template <size_t N>
+        array<float, N> lerp(const array<float, N>& a, const array<float, N>& b, float t)
+        {
+            array<float, N> result{};
+            for (size_t c(0); c < N; ++c)
+                result[c] = a[c] + t * (b[c] - a[c]);
+            // rotations: normalized linear interpolation
+            if constexpr (N == 4)
+                return normalized(result);
+            else
+                return result;
+        }
+
+        // angle between rotations, or the largest component difference of other tracks
+        template <size_t N>
+        float track_error(const array<float, N>& a, const array<float, N>& b)
+        {
+            float result(0);
+            if constexpr (N == 4)
+            {
+                float cosine(0);
+                for (size_t c(0); c < 4; ++c)
+                    cosine += a[c] * b[c];
+                result = 2 * acos(min(1.0f, fabs(cosine)));
+            }
+            else
+                for (size_t c(0); c < N; ++c)
+                    result = max(result, fabs(a[c] - b[c]));
+            return result;
+        }
+
+        // scale, then rotation, then translation, as rows of a matrix acting on column vectors
+        joint_table to_table(const joint_transform& transform)
+        {
+            const float w(transform.rotation[0]), x(transform.rotation[1]), y(transform.rotation[2]),
+                        z(transform.rotation[3]);
+            const float rotation[3][3]{{1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y)},
+                                       {2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)},
+                                       {2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)}};
+            joint_table result{};
+            for (size_t r(0); r < 3; ++r)
+            {
+                for (size_t c(0); c < 3; ++c)
+                    result[r][c] = rotation[r][c] * transform.scale[c];
+                result[r][3] = transform.translation[r];
+            }
+            result[3][3] = 1;
+            return result;
+        }
+
+        joint_table multiply(const joint_table& a, const joint_table& b)
+        {
+            joint_table result{};
+            for (size_t r(0); r < 4; ++r)
+                for (size_t k(0); k < 4; ++k)
+                    for (size_t c(0); c < 4; ++c)
+                        result[r][c] += a[r][k] * b[k][c];
+            return result;
+        }
+
+        // fills an existing matrix, so the output arrays are written without temporaries
+        void store(const joint_table& table, matrix<float, 4, 4>& destination)
+        {
+            for (size_t r(0); r < 4; ++r)
+                for (size_t c(0); c < 4; ++c)
+                    destination(r, c) = table[r][c];
+        }
+    }
+
+    matrix<float, 4, 4> to_matrix(const joint_transform& transform)
+    {
+        return matrix<float, 4, 4>(to_table(transform));
+    }
+
+    skeleton::skeleton(vector<int32_t> parents, vector<matrix<float, 4, 4>> inverse_bind)
+        : parents_(move(parents)), inverse_bind_(inverse_bind.size())
+    {
+        if (parents_.size() != inverse_bind.size())
+            throw invalid_argument("Every joint needs an inverse bind matrix");
+        for (size_t joint(0); joint < parents_.size(); ++joint)
+        {
+            if (parents_[joint] < -1 || parents_[joint] >= int32_t(joint))
+                throw invalid_argument("Joint " + to_string(joint) + " does not follow its parent");
+            for (size_t r(0); r < 4; ++r)
+                for (size_t c(0); c < 4; ++c)
+                    inverse_bind_[joint][r][c] = inverse_bind[joint](r, c);
+        }
+    }
+
+    void skeleton::compose(const joint_transform* local, vector<joint_table>& model) const
+    {
+        model.resize(parents_.size());
+        for (size_t joint(0); joint < parents_.size(); ++joint)
+            model[joint] = parents_[joint] < 0 ? to_table(local[joint])
+                                               : multiply(model[parents_[joint]], to_table(local[joint]));
+    }
+
+    void skeleton::local_to_model(const joint_transform* local, matrix<float, 4, 4>* model) const
+    {
+        vector<joint_table> tables;
+        compose(local, tables);
+        for (size_t joint(0); joint < parents_.size(); ++joint)
+            store(tables[joint], model[joint]);
+    }
+
+    void skeleton::skinning_palette(const joint_transform* local, matrix<float, 4, 4>* palette) const
+    {
+        vector<joint_table> tables;
+        compose(local, tables);
+        for (size_t joint(0); joint < parents_.size(); ++joint)
+            store(multiply(tables[joint], inverse_bind_[joint]), palette[joint]);
+    }
+
+    size_t skeleton::joint_count() const
+    {
+        return parents_.size();
+    }
+
+    int32_t skeleton::parent(size_t joint) const
+    {
+        return parents_.at(joint);
+    }
+
+    template <size_t N>
+    void animation_clip::add_track(const vector<array<float, N>>& values, float tolerance)
+    {
+        track result{uint32_t(times_.size()), 0, uint32_t(values_.size()), {}, {}};
+        array<float, N> high(values[0]);
+        for (size_t c(0); c < N; ++c)
+            result.minimum[c] = values[0][c];
+        for (const array<float, N>& value : values)
+            for (size_t c(0); c < N; ++c)
+            {
+                result.minimum[c] = min(result.minimum[c], value[c]);
+                high[c] = max(high[c], value[c]);
+            }
+        for (size_t c(0); c < N; ++c)
+            result.step[c] = (high[c] - result.minimum[c]) / 65535;
+
+        // keys are judged after quantization, so the tolerance bounds the stored error
+        vector<array<uint16_t, N>> quantized(values.size());
+        vector<array<float, N>> decoded(values.size());
+        for (size_t frame(0); frame < values.size(); ++frame)
+            for (size_t c(0); c < N; ++c)
+            {
+                const float steps(result.step[c] > 0 ? (values[frame][c] - result.minimum[c]) / result.step[c] : 0);
+                quantized[frame][c] = uint16_t(min(65535.0f, max(0.0f, round(steps))));
+                decoded[frame][c] = result.minimum[c] + result.step[c] * quantized[frame][c];
+            }
+        if constexpr (N == 4)
+            for (array<float, N>& rotation : decoded)
+                rotation = normalized(rotation);
+
+        const auto keep([&](size_t frame)
+        {
+            times_.push_back(uint16_t(frame));
+            values_.insert(values_.end(), quantized[frame].begin(), quantized[frame].end());
+            ++result.key_count;
+        });
+        keep(0);
+        bool constant(true);
+        for (size_t frame(1); constant && frame < values.size(); ++frame)
+            constant = track_error(decoded[0], values[frame]) <= tolerance;
+        if (!constant)
+        {
+            // extend every segment while interpolating its ends reproduces the frames inside it
+            size_t start(0);
+            for (size_t end(start + 2); end < values.size(); ++end)
+            {
+                bool fits(true);
+                for (size_t frame(start + 1); fits && frame < end; ++frame)
+                    fits = track_error(lerp(decoded[start], decoded[end], float(frame - start) / float(end - start)),
+                                       values[frame]) <= tolerance;
+                if (!fits)
+                {
+                    start = end - 1;
+                    keep(start);
+                }
+            }
+            keep(values.size() - 1);
+        }
+        tracks_.push_back(result);
+    }
+
+    template <size_t N>
+    array<float, N> animation_clip::sample_track(const track& source, float frame) const
+    {
+        const uint16_t* times(times_.data() + source.first_key);
+        const uint16_t* values(values_.data() + source.first_value);
+        const auto decode([&](size_t key)
+        {
+            array<float, N> result{};
+            for (size_t c(0); c < N; ++c)
+                result[c] = source.minimum[c] + source.step[c] * values[key * N + c];
+            return result;
+        });
+        if (source.key_count == 1)
+            return lerp(decode(0), decode(0), 0.0f);
+        const auto next(size_t(upper_bound(times, times + source.key_count, frame,
+                                           [](float f, uint16_t time) { return f < float(time); }) - times));
+        const size_t key(min(next == 0 ? 0 : next - 1, size_t(source.key_count - 2)));
+        const float t((frame - float(times[key])) / float(times[key + 1] - times[key]));
+        return lerp(decode(key), decode(key + 1), min(1.0f, max(0.0f, t)));
+    }
+
+    animation_clip::animation_clip(const vector<vector<joint_transform>>& frames, float frame_rate,
+                                   const clip_compression& compression)
+        : joint_count_(frames.empty() ? 0 : frames[0].size()), frame_count_(frames.size()), frame_rate_(frame_rate)
+    {
+        if (frames.empty() || joint_count_ == 0)
+            throw invalid_argument("A clip needs at least one frame and one joint");
+        if (frames.size() > 65536)
+            throw invalid_argument("A clip holds at most 65536 frames");
+        if (!(frame_rate > 0))
+            throw invalid_argument("The frame rate must be positive");
+        for (const vector<joint_transform>& pose : frames)
+            if (pose.size() != joint_count_)
+                throw invalid_argument("Every frame needs a transformation per joint");
+
+        vector<array<float, 3>> translations(frames.size()), scales(frames.size());
+        vector<array<float, 4>> rotations(frames.size());
+        for (size_t joint(0); joint < joint_count_; ++joint)
+        {
+            for (size_t frame(0); frame < frames.size(); ++frame)
+            {
+                translations[frame] = frames[frame][joint].translation;
+                scales[frame] = frames[frame][joint].scale;
+                rotations[frame] = normalized(frames[frame][joint].rotation);
+                // q and -q are the same rotation; neighbours in one hemisphere interpolate the short way
+                if (frame > 0)
+                {
+                    float cosine(0);
+                    for (size_t c(0); c < 4; ++c)
+                        cosine += rotations[frame][c] * rotations[frame - 1][c];
+                    if (cosine < 0)
+                        for (float& component : rotations[frame])
+                            component = -component;
+                }
+            }
+            add_track(translations, compression.translation_error);
+            add_track(rotations, compression.rotation_error);
+            add_track(scales, compression.scale_error);
+        }
+    }
+
+    void animation_clip::sample(float time, joint_transform* pose) const
+    {
+        sample(&time, 1, pose);
+    }
+
+    void animation_clip::sample(const float* times, size_t count, joint_transform* poses) const
+    {
+        const float last(float(frame_count_ - 1));
+        for (size_t joint(0); joint < joint_count_; ++joint)
+        {
+            const track* tracks(tracks_.data() + 3 * joint);
+            for (size_t i(0); i < count; ++i)
+                poses[i * joint_count_ + joint].translation =
+                    sample_track<3>(tracks[0], min(last, max(0.0f, times[i] * frame_rate_)));
+            for (size_t i(0); i < count; ++i)
+                poses[i * joint_count_ + joint].rotation =
+                    sample_track<4>(tracks[1], min(last, max(0.0f, times[i] * frame_rate_)));
+            for (size_t i(0); i < count; ++i)
+                poses[i * joint_count_ + joint].scale =
+                    sample_track<3>(tracks[2], min(last, max(0.0f, times[i] * frame_rate_)));
+        }
+    }
+
+    size_t animation_clip::joint_count() const
+    {
+        return joint_count_;
+    }
+
+    float animation_clip::duration() const
+    {
+        return float(frame_count_ - 1) / frame_rate_;
+    }
+
+    size_t animation_clip::key_count() const
+    {
+        return times_.size();
+    }
+
+    size_t animation_clip::compressed_size() const
+    {
+        return tracks_.size() * sizeof(track) + times_.size() * sizeof(uint16_t) + values_.size() * sizeof(uint16_t);
+    }
+
+    void skin_vertices(const skin_vertex* source, size_t count, const matrix<float, 4, 4>* palette,
+                       size_t joint_count, skinned_vertex* target)
+    {
+        using pack = float_pack<4>;
+        // the palette transposed, so every matrix column loads into one pack
+        aligned_vector<float> columns(joint_count * 16);
+        for (size_t joint(0); joint < joint_count; ++joint)
+            for (size_t c(0); c < 4; ++c)
+                for (size_t r(0); r < 4; ++r)
+                    columns[joint * 16 + c * 4 + r] = palette[joint](r, c);
+
+        alignas(16) float position[4], normal[4];
+        for (size_t v(0); v < count; ++v)
+        {
+            const skin_vertex& vertex(source[v]);
+            array<pack, 4> blended;
+            for (size_t k(0); k < 4; ++k)
+            {
+                if (vertex.joints[k] >= joint_count)
+                    throw out_of_range("Skinned vertex refers to joint " + to_string(vertex.joints[k]));
+                const float* matrix_columns(columns.data() + vertex.joints[k] * 16);
+                const pack weight(vertex.weights[k]);
+                for (size_t c(0); c < 4; ++c)
+                    blended[c] = mul_add(weight, pack::load(matrix_columns + 4 * c), blended[c]);
+            }
+            // the last row of every column is 0 but for the translation, so lane 3 of the normal is 0
+            mul_add(blended[0], pack(vertex.position[0]),
+                    mul_add(blended[1], pack(vertex.position[1]),
+                            mul_add(blended[2], pack(vertex.position[2]), blended[3]))).store(position);
+            const pack n(mul_add(blended[0], pack(vertex.normal[0]),
+                                 mul_add(blended[1], pack(vertex.normal[1]), blended[2] * pack(vertex.normal[2]))));
+            const float squared((n * n).horizontal_sum());
+            (squared > 0 ? n * pack(1 / std::sqrt(squared)) : n).store(normal);
+            memcpy(target[v].position.data(), position, sizeof(target[v].position));
+            memcpy(target[v].normal.data(), normal, sizeof(target[v].normal));
+        }
+    }
+
+    void animate_crowd(const skeleton& rig, const animation_clip& clip, const vector<skin_vertex>& bind_vertices,
+                       const vector<float>& times, vector<matrix<float, 4, 4>>& palettes,
+                       vector<skinned_vertex>& vertices, thread_pool& pool)
+    {
+        const size_t joints(rig.joint_count());
+        if (clip.joint_count() != joints)
+            throw invalid_argument("The clip animates a different skeleton");
+        // checked once here rather than failing inside a worker
+        for (const skin_vertex& vertex : bind_vertices)
+            for (const uint16_t joint : vertex.joints)
+                if (joint >= joints)
+                    throw out_of_range("Skinned vertex refers to joint " + to_string(joint));
+
+        palettes.resize(times.size() * joints);
+        vertices.resize(times.size() * bind_vertices.size());
+        pool.parallel_for(0, times.size(), crowd_group, [&](size_t first, size_t last)
+        {
+            vector<joint_transform> poses((last - first) * joints);
+            clip.sample(times.data() + first, last - first, poses.data());
+            for (size_t character(first); character < last; ++character)
+            {
+                matrix<float, 4, 4>* palette(palettes.data() + character * joints);
+                rig.skinning_palette(poses.data() + (character - first) * joints, palette);
+                skin_vertices(bind_vertices.data(), bind_vertices.size(), palette, joints,
+                              vertices.data() + character * bind_vertices.size());
+            }
+        });
+    }
+} // engine_lib
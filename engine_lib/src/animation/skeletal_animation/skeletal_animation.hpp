@@ -0,0 +1,226 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef SKELETAL_ANIMATION_HPP
+#define SKELETAL_ANIMATION_HPP
+#include "../../includes.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Transformation of a joint relative to its parent: scale, then rotation, then translation.
+     */
+    struct joint_transform
+    {
+        array<float, 3> translation{0, 0, 0}; /// Translation.
+        array<float, 4> rotation{1, 0, 0, 0}; /// Unit quaternion (w, x, y, z).
+        array<float, 3> scale{1, 1, 1}; /// Scale per axis.
+    };
+
+    /**
+     * @brief Converts a joint transformation to a matrix acting on column vectors.
+     *
+     * @param transform The transformation.
+     * @return The matrix, translation in the last column.
+     */
+    matrix<float, 4, 4> to_matrix(const joint_transform& transform);
+
+    /**
+     * @brief Elements of a joint matrix by row, for the composition loops.
+     */
+    using joint_table = array<array<float, 4>, 4>;
+
+    /**
+     * @class skeleton
+     * @brief Joint hierarchy with the inverse bind matrices of skinning.
+     *
+     * Joints are stored parents first, so model space poses are computed in one forward pass.
+     */
+    class skeleton
+    {
+        vector<int32_t> parents_; /// Parent of every joint, -1 for roots.
+        vector<joint_table> inverse_bind_; /// Model to joint space in the bind pose.
+
+        void compose(const joint_transform* local, vector<joint_table>& model) const;
+
+    public:
+        /**
+         * @brief Creates a skeleton.
+         *
+         * @param parents Parent of every joint, -1 for roots; a parent must precede its children.
+         * @param inverse_bind Inverse of the model space matrix of every joint in the bind pose.
+         * @throws invalid_argument If the sizes differ or a parent does not precede its child.
+         */
+        skeleton(vector<int32_t> parents, vector<matrix<float, 4, 4>> inverse_bind);
+
+        /**
+         * @brief Computes the model space matrices of a pose.
+         *
+         * @param local Transformation of every joint relative to its parent.
+         * @param model Receives the model space matrix of every joint.
+         */
+        void local_to_model(const joint_transform* local, matrix<float, 4, 4>* model) const;
+
+        /**
+         * @brief Computes the skinning palette of a pose, model space matrices times inverse bind matrices.
+         *
+         * @param local Transformation of every joint relative to its parent.
+         * @param palette Receives the skinning matrix of every joint.
+         */
+        void skinning_palette(const joint_transform* local, matrix<float, 4, 4>* palette) const;
+
+        [[nodiscard]] size_t joint_count() const;
+        [[nodiscard]] int32_t parent(size_t joint) const;
+    };
+
+    /**
+     * @brief Tolerances of the clip compression.
+     */
+    struct clip_compression
+    {
+        float translation_error = 1e-3f; /// Largest translation error, in model units.
+        float rotation_error = 1e-3f; /// Largest rotation error, in radians.
+        float scale_error = 1e-3f; /// Largest scale error.
+    };
+
+    /**
+     * @class animation_clip
+     * @brief Compressed keyframe tracks of every joint of a skeleton.
+     *
+     * A clip is built from poses sampled at a fixed rate. Every joint gets a translation, a
+     * rotation and a scale track; keys that linear interpolation of their neighbours reproduces
+     * within the tolerances are dropped, so constant tracks shrink to one key. Key times are
+     * stored as 16-bit frame numbers and components as 16-bit fractions of their track's range.
+     * Rotations are kept in one hemisphere and interpolated linearly, then normalized.
+     */
+    class animation_clip
+    {
+        struct track
+        {
+            uint32_t first_key; /// First entry of the track in times_.
+            uint32_t key_count; /// Number of keys.
+            uint32_t first_value; /// First entry of the track in values_.
+            array<float, 4> minimum; /// Smallest value of every component.
+            array<float, 4> step; /// Value of one quantization step of every component.
+        };
+
+        vector<track> tracks_; /// Translation, rotation and scale track of every joint.
+        vector<uint16_t> times_; /// Frame number of every key.
+        vector<uint16_t> values_; /// Quantized components of every key.
+        size_t joint_count_; /// Number of joints.
+        size_t frame_count_; /// Number of source frames.
+        float frame_rate_; /// Source frames per second.
+
+        template <size_t N>
+        void add_track(const vector<array<float, N>>& values, float tolerance);
+
+        template <size_t N>
+        array<float, N> sample_track(const track& source, float frame) const;
+
+    public:
+        /**
+         * @brief Compresses uniformly sampled poses.
+         *
+         * @param frames Local pose of every joint for every frame, all of the same size.
+         * @param frame_rate Frames per second.
+         * @param compression Tolerances.
+         * @throws invalid_argument If there are no frames or joints, more than 65536 frames,
+         * poses of different sizes or a frame rate that is not positive.
+         */
+        animation_clip(const vector<vector<joint_transform>>& frames, float frame_rate,
+                       const clip_compression& compression = {});
+
+        /**
+         * @brief Samples the pose at a time, clamped to the clip.
+         *
+         * @param time Time in seconds.
+         * @param pose Receives the local transformation of every joint.
+         */
+        void sample(float time, joint_transform* pose) const;
+
+        /**
+         * @brief Samples the poses of several characters at once, track by track.
+         *
+         * Every track is decoded for all times before the next one, which keeps its keys in cache.
+         *
+         * @param times Time of every character in seconds, clamped to the clip.
+         * @param count Number of characters.
+         * @param poses Receives joint_count() local transformations per character.
+         */
+        void sample(const float* times, size_t count, joint_transform* poses) const;
+
+        [[nodiscard]] size_t joint_count() const;
+        [[nodiscard]] float duration() const;
+        [[nodiscard]] size_t key_count() const;
+        [[nodiscard]] size_t compressed_size() const;
+    };
+
+    /**
+     * @brief Vertex of a skinned mesh in the bind pose.
+     */
+    struct skin_vertex
+    {
+        array<float, 3> position{}; /// Position.
+        array<float, 3> normal{}; /// Normal.
+        array<uint16_t, 4> joints{}; /// Influencing joints.
+        array<float, 4> weights{}; /// Weight of every influence, summing to one.
+    };
+
+    /**
+     * @brief Vertex of a skinned mesh in an animated pose.
+     */
+    struct skinned_vertex
+    {
+        array<float, 3> position; /// Position.
+        array<float, 3> normal; /// Unit normal.
+    };
+
+    /**
+     * @brief Transforms vertices by linear blend skinning.
+     *
+     * The four palette matrices of a vertex are blended column by column in float_pack<4>
+     * registers and applied to the position and normal. Normals are transformed by the blended
+     * matrix and renormalized, which is exact for rotations and uniform scales.
+     *
+     * @param source Vertices in the bind pose.
+     * @param count Number of vertices.
+     * @param palette Skinning matrix of every joint.
+     * @param joint_count Size of the palette.
+     * @param target Receives the skinned vertices.
+     * @throws out_of_range If a vertex refers to a joint outside the palette.
+     */
+    void skin_vertices(const skin_vertex* source, size_t count, const matrix<float, 4, 4>* palette,
+                       size_t joint_count, skinned_vertex* target);
+
+    /**
+     * @brief Animates a crowd sharing a skeleton, a clip and a mesh.
+     *
+     * Every character samples the clip at its own time, computes its palette and skins its own
+     * copy of the mesh. Characters are processed in parallel, in groups sampled together.
+     *
+     * @param rig The skeleton.
+     * @param clip Clip with the skeleton's joints.
+     * @param bind_vertices Vertices in the bind pose.
+     * @param times Clip time of every character.
+     * @param palettes Receives joint_count() skinning matrices per character.
+     * @param vertices Receives bind_vertices.size() skinned vertices per character.
+     * @param pool Pool animating the characters.
+     * @throws invalid_argument If the clip and the skeleton have different joint counts.
+     * @throws out_of_range If a vertex refers to a joint outside the skeleton.
+     */
+    void animate_crowd(const skeleton& rig, const animation_clip& clip, const vector<skin_vertex>& bind_vertices,
+                       const vector<float>& times, vector<matrix<float, 4, 4>>& palettes,
+                       vector<skinned_vertex>& vertices, thread_pool& pool = thread_pool::global());
+} // engine_lib
+
+#endif //SKELETAL_ANIMATION_HPP
@@ -0,0 +1,82 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef ALIGNED_ALLOCATOR_HPP
+#define ALIGNED_ALLOCATOR_HPP
+
+#include "../../includes.hpp"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Default alignment used for SIMD friendly buffers, one cache line.
+     */
+    constexpr size_t cache_line_size = 64;
+
+    /**
+     * @class aligned_allocator
+     * @brief Standard allocator returning storage aligned to the given boundary.
+     *
+     * @tparam T The type of the allocated elements.
+     * @tparam Alignment Alignment in bytes, a power of two.
+     */
+    template <class T, size_t Alignment = cache_line_size>
+    class aligned_allocator
+    {
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment is weaker than the element alignment");
+
+    public:
+        using value_type = T;
+
+        template <class U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template <class U>
+        aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+        {
+        }
+
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), align_val_t(Alignment)));
+        }
+
+        void deallocate(T* pointer, size_t) noexcept
+        {
+            ::operator delete(pointer, align_val_t(Alignment));
+        }
+
+        template <class U>
+        bool operator==(const aligned_allocator<U, Alignment>&) const noexcept
+        {
+            return true;
+        }
+
+        template <class U>
+        bool operator!=(const aligned_allocator<U, Alignment>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    /**
+     * @brief A vector whose data() is aligned to a cache line.
+     */
+    template <class T>
+    using aligned_vector = vector<T, aligned_allocator<T>>;
+} // engine_lib
+
+#endif //ALIGNED_ALLOCATOR_HPP
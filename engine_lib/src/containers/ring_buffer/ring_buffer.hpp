@@ -0,0 +1,79 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+#include "../../includes.hpp"
+#include "../aligned_allocator/aligned_allocator.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class ring_buffer
+     * @brief Bounded lock-free queue for one producer thread and one consumer thread.
+     *
+     * The producer only writes the tail and the consumer only writes the head, each on its own
+     * cache line, so neither side ever waits for the other; a full buffer rejects the element.
+     *
+     * @tparam T Trivially copyable element type.
+     */
+    template <class T>
+    class ring_buffer
+    {
+        static_assert(is_trivially_copyable_v<T>, "ring_buffer elements must be trivially copyable");
+
+        vector<T> slots_; /// Storage, a power of two long.
+        size_t mask_; /// slots_.size() - 1.
+        alignas(cache_line_size) atomic<size_t> head_; /// Next element to pop, written by the consumer.
+        alignas(cache_line_size) atomic<size_t> tail_; /// Next slot to fill, written by the producer.
+
+    public:
+        /**
+         * @brief Creates an empty buffer.
+         *
+         * @param capacity Largest number of queued elements, rounded up to a power of two.
+         * @throws invalid_argument If capacity is zero.
+         */
+        explicit ring_buffer(size_t capacity);
+
+        ring_buffer(const ring_buffer& other) = delete;
+        ring_buffer& operator=(const ring_buffer& other) = delete;
+
+        /**
+         * @brief Appends an element. Producer thread only.
+         *
+         * @param value The element.
+         * @return False if the buffer is full.
+         */
+        bool try_push(const T& value);
+
+        /**
+         * @brief Removes the oldest element. Consumer thread only.
+         *
+         * @param value Receives the element.
+         * @return False if the buffer is empty.
+         */
+        bool try_pop(T& value);
+
+        /**
+         * @brief Returns the number of queued elements; exact only while the other side is idle.
+         *
+         * @return Number of queued elements.
+         */
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] size_t capacity() const;
+    };
+} // engine_lib
+
+#endif //RING_BUFFER_HPP
+#include "ring_buffer.inl"
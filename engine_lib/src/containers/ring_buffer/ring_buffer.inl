@@ -0,0 +1,56 @@
+#ifndef RING_BUFFER_INL
+#define RING_BUFFER_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    ring_buffer<T>::ring_buffer(size_t capacity) : head_(0), tail_(0)
+    {
+        if (capacity == 0)
+            throw invalid_argument("A ring buffer needs room for at least one element");
+        size_t size(1);
+        while (size < capacity)
+            size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    template <class T>
+    bool ring_buffer<T>::try_push(const T& value)
+    {
+        // the indices grow without wrapping, so full and empty are told apart without a spare slot
+        const size_t tail(tail_.load(memory_order_relaxed));
+        if (tail - head_.load(memory_order_acquire) == slots_.size())
+            return false;
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, memory_order_release);
+        return true;
+    }
+
+    template <class T>
+    bool ring_buffer<T>::try_pop(T& value)
+    {
+        const size_t head(head_.load(memory_order_relaxed));
+        if (head == tail_.load(memory_order_acquire))
+            return false;
+        value = slots_[head & mask_];
+        head_.store(head + 1, memory_order_release);
+        return true;
+    }
+
+    template <class T>
+    size_t ring_buffer<T>::size() const
+    {
+        return tail_.load(memory_order_acquire) - head_.load(memory_order_acquire);
+    }
+
+    template <class T>
+    size_t ring_buffer<T>::capacity() const
+    {
+        return slots_.size();
+    }
+} // engine_lib
+
+#endif //RING_BUFFER_INL
@@ -0,0 +1,145 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef STRIDED_VIEW_HPP
+#define STRIDED_VIEW_HPP
+
+#include "../../includes.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class strided_view
+     * @brief Non-owning view of count elements placed stride bytes apart.
+     *
+     * The same view type covers a tightly packed array (stride == sizeof(T)) and one
+     * member of an array of interleaved records (stride == sizeof(record)), so code
+     * written against the view works on both layouts without copying.
+     *
+     * @tparam T The element type, const-qualified for read-only views.
+     */
+    template <class T>
+    class strided_view
+    {
+        using byte_type = conditional_t<is_const_v<T>, const unsigned char, unsigned char>;
+
+        byte_type* first_; /// Address of element 0.
+        size_t stride_; /// Distance in bytes between two elements.
+        size_t count_; /// Number of elements.
+
+    public:
+        class iterator
+        {
+            byte_type* position_;
+            size_t stride_;
+
+        public:
+            using iterator_category = random_access_iterator_tag;
+            using value_type = remove_const_t<T>;
+            using difference_type = ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator(byte_type* position, size_t stride);
+            T& operator*() const;
+            T* operator->() const;
+            T& operator[](difference_type offset) const;
+            iterator& operator++();
+            iterator operator++(int);
+            iterator& operator--();
+            iterator& operator+=(difference_type offset);
+            iterator operator+(difference_type offset) const;
+            iterator operator-(difference_type offset) const;
+            difference_type operator-(const iterator& other) const;
+            bool operator==(const iterator& other) const;
+            bool operator!=(const iterator& other) const;
+            bool operator<(const iterator& other) const;
+        };
+
+        /**
+         * @brief Default constructor. Creates an empty view.
+         */
+        strided_view();
+
+        /**
+         * @brief Creates a view from its raw parts.
+         *
+         * @param first Address of element 0.
+         * @param stride Distance in bytes between two elements.
+         * @param count Number of elements.
+         */
+        strided_view(T* first, size_t stride, size_t count);
+
+        /**
+         * @brief Views a tightly packed vector.
+         *
+         * @param data The viewed vector.
+         */
+        template <class Allocator>
+        strided_view(vector<remove_const_t<T>, Allocator>& data);
+
+        /**
+         * @brief Views a tightly packed vector read-only.
+         *
+         * @param data The viewed vector.
+         */
+        template <class Allocator, class U = T, class = enable_if_t<is_const_v<U>>>
+        strided_view(const vector<remove_const_t<T>, Allocator>& data);
+
+        /**
+         * @brief Views one member of every record of an interleaved array.
+         *
+         * @param records Address of the first record.
+         * @param count Number of records.
+         * @param member The viewed member.
+         * @return The view of the member.
+         */
+        template <class Record>
+        static strided_view of_member(Record* records, size_t count, remove_const_t<T> remove_const_t<Record>::*member);
+
+        /**
+         * @brief Converts a writable view to a read-only one.
+         */
+        operator strided_view<const T>() const;
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t stride() const;
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Checks if the elements are tightly packed, so data() addresses a plain array.
+         *
+         * @return True if the stride equals sizeof(T).
+         */
+        [[nodiscard]] bool contiguous() const;
+
+        /**
+         * @brief Returns the address of element 0.
+         *
+         * @return Pointer to the first element.
+         */
+        T* data() const;
+
+        /**
+         * @brief Accesses an element without range checks.
+         *
+         * @param index Element index.
+         * @return Reference to the element.
+         */
+        T& operator[](size_t index) const;
+
+        iterator begin() const;
+        iterator end() const;
+    };
+} // engine_lib
+
+#endif //STRIDED_VIEW_HPP
+#include "strided_view.inl"
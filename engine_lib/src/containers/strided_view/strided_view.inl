@@ -0,0 +1,196 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+#ifndef STRIDED_VIEW_INL
+#define STRIDED_VIEW_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    strided_view<T>::iterator::iterator(byte_type* position, size_t stride)
+        : position_(position),
+          stride_(stride)
+    {
+    }
+
+    template <class T>
+    T& strided_view<T>::iterator::operator*() const
+    {
+        return *reinterpret_cast<T*>(position_);
+    }
+
+    template <class T>
+    T* strided_view<T>::iterator::operator->() const
+    {
+        return reinterpret_cast<T*>(position_);
+    }
+
+    template <class T>
+    T& strided_view<T>::iterator::operator[](difference_type offset) const
+    {
+        return *(*this + offset);
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator& strided_view<T>::iterator::operator++()
+    {
+        position_ += stride_;
+        return *this;
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator strided_view<T>::iterator::operator++(int)
+    {
+        iterator result(*this);
+        position_ += stride_;
+        return result;
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator& strided_view<T>::iterator::operator--()
+    {
+        position_ -= stride_;
+        return *this;
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator& strided_view<T>::iterator::operator+=(difference_type offset)
+    {
+        position_ += offset * difference_type(stride_);
+        return *this;
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator strided_view<T>::iterator::operator+(difference_type offset) const
+    {
+        return iterator(position_ + offset * difference_type(stride_), stride_);
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator strided_view<T>::iterator::operator-(difference_type offset) const
+    {
+        return iterator(position_ - offset * difference_type(stride_), stride_);
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator::difference_type
+    strided_view<T>::iterator::operator-(const iterator& other) const
+    {
+        return (position_ - other.position_) / difference_type(stride_);
+    }
+
+    template <class T>
+    bool strided_view<T>::iterator::operator==(const iterator& other) const
+    {
+        return position_ == other.position_;
+    }
+
+    template <class T>
+    bool strided_view<T>::iterator::operator!=(const iterator& other) const
+    {
+        return position_ != other.position_;
+    }
+
+    template <class T>
+    bool strided_view<T>::iterator::operator<(const iterator& other) const
+    {
+        return position_ < other.position_;
+    }
+
+    template <class T>
+    strided_view<T>::strided_view()
+        : first_(nullptr),
+          stride_(sizeof(T)),
+          count_(0)
+    {
+    }
+
+    template <class T>
+    strided_view<T>::strided_view(T* first, size_t stride, size_t count)
+        : first_(reinterpret_cast<byte_type*>(first)),
+          stride_(stride),
+          count_(count)
+    {
+    }
+
+    template <class T>
+    template <class Allocator>
+    strided_view<T>::strided_view(vector<remove_const_t<T>, Allocator>& data)
+        : strided_view(data.data(), sizeof(T), data.size())
+    {
+    }
+
+    template <class T>
+    template <class Allocator, class U, class>
+    strided_view<T>::strided_view(const vector<remove_const_t<T>, Allocator>& data)
+        : strided_view(data.data(), sizeof(T), data.size())
+    {
+    }
+
+    template <class T>
+    template <class Record>
+    strided_view<T> strided_view<T>::of_member(Record* records, size_t count,
+                                               remove_const_t<T> remove_const_t<Record>::*member)
+    {
+        if (count == 0)
+            return strided_view(nullptr, sizeof(Record), 0);
+        return strided_view(&(records->*member), sizeof(Record), count);
+    }
+
+    template <class T>
+    strided_view<T>::operator strided_view<const T>() const
+    {
+        return strided_view<const T>(data(), stride_, count_);
+    }
+
+    template <class T>
+    size_t strided_view<T>::size() const
+    {
+        return count_;
+    }
+
+    template <class T>
+    size_t strided_view<T>::stride() const
+    {
+        return stride_;
+    }
+
+    template <class T>
+    bool strided_view<T>::empty() const
+    {
+        return count_ == 0;
+    }
+
+    template <class T>
+    bool strided_view<T>::contiguous() const
+    {
+        return stride_ == sizeof(T);
+    }
+
+    template <class T>
+    T* strided_view<T>::data() const
+    {
+        return reinterpret_cast<T*>(first_);
+    }
+
+    template <class T>
+    T& strided_view<T>::operator[](size_t index) const
+    {
+        return *reinterpret_cast<T*>(first_ + index * stride_);
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator strided_view<T>::begin() const
+    {
+        return iterator(first_, stride_);
+    }
+
+    template <class T>
+    typename strided_view<T>::iterator strided_view<T>::end() const
+    {
+        return iterator(first_ + count_ * stride_, stride_);
+    }
+} // engine_lib
+#endif
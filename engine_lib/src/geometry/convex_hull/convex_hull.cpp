@@ -0,0 +1,274 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "convex_hull.hpp"
+#include "../../math/predicates/predicates.hpp"
+#include "../../math/vector3/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // clouds are cut into chunks of at least this many points before the final hull
+        constexpr size_t chunk_points(1 << 15);
+        constexpr size_t max_chunks(64);
+        constexpr uint32_t no_face(UINT32_MAX);
+
+        struct hull_face
+        {
+            array<uint32_t, 3> vertices; // counterclockwise seen from outside
+            array<uint32_t, 3> neighbors; // face across the edge from vertex i to vertex i + 1
+            array<double, 3> normal; // unnormalized, only ranks the points above the face
+            vector<uint32_t> outside; // points strictly above the face and no earlier one
+            bool alive;
+        };
+
+        class quickhull
+        {
+            const vector<array<double, 3>>& points_;
+            vector<hull_face> faces_;
+            vector<uint32_t> pending_;
+            vector<uint32_t> visited_;
+            vector<bool> visible_;
+            vector<uint32_t> visible_faces_;
+            vector<pair<uint32_t, size_t>> horizon_;
+            vector<uint32_t> face_from_; // new face starting at every horizon vertex
+            uint32_t stamp_;
+
+            [[nodiscard]] bool above(const hull_face& face, uint32_t point) const
+            {
+                return orient3d(points_[face.vertices[0]], points_[face.vertices[1]], points_[face.vertices[2]],
+                                points_[point]) < 0;
+            }
+
+            uint32_t add_face(uint32_t a, uint32_t b, uint32_t c)
+            {
+                hull_face face;
+                face.vertices = {a, b, c};
+                face.neighbors = {no_face, no_face, no_face};
+                face.normal = cross(subtract(points_[b], points_[a]), subtract(points_[c], points_[a]));
+                face.alive = true;
+                faces_.push_back(move(face));
+                visited_.push_back(0);
+                visible_.push_back(false);
+                return uint32_t(faces_.size() - 1);
+            }
+
+            // first face among [first, faces_.size()) the point lies strictly above
+            void assign(uint32_t point, size_t first)
+            {
+                for (size_t f(first); f < faces_.size(); ++f)
+                    if (above(faces_[f], point))
+                    {
+                        faces_[f].outside.push_back(point);
+                        return;
+                    }
+            }
+
+            void add_point(uint32_t start)
+            {
+                hull_face& seed(faces_[start]);
+                uint32_t eye(seed.outside[0]);
+                double farthest(dot(seed.normal, points_[eye]));
+                for (const uint32_t point : seed.outside)
+                    if (const double height(dot(seed.normal, points_[point])); height > farthest)
+                    {
+                        farthest = height;
+                        eye = point;
+                    }
+
+                // the faces the eye lies strictly above form a disk bounded by the horizon
+                ++stamp_;
+                visible_faces_.assign(1, start);
+                visited_[start] = stamp_;
+                visible_[start] = true;
+                horizon_.clear();
+                for (size_t k(0); k < visible_faces_.size(); ++k)
+                {
+                    const uint32_t f(visible_faces_[k]);
+                    for (size_t i(0); i < 3; ++i)
+                    {
+                        const uint32_t n(faces_[f].neighbors[i]);
+                        if (visited_[n] != stamp_)
+                        {
+                            visited_[n] = stamp_;
+                            visible_[n] = above(faces_[n], eye);
+                            if (visible_[n])
+                                visible_faces_.push_back(n);
+                        }
+                        if (!visible_[n])
+                            horizon_.emplace_back(f, i);
+                    }
+                }
+
+                const auto first_new(uint32_t(faces_.size()));
+                for (const auto& [f, i] : horizon_)
+                {
+                    const uint32_t a(faces_[f].vertices[i]), b(faces_[f].vertices[(i + 1) % 3]);
+                    const uint32_t n(faces_[f].neighbors[i]);
+                    const uint32_t created(add_face(a, b, eye));
+                    faces_[created].neighbors[0] = n;
+                    for (size_t j(0); j < 3; ++j)
+                        if (faces_[n].vertices[j] == b)
+                            faces_[n].neighbors[j] = created;
+                    face_from_[a] = created;
+                }
+                for (uint32_t f(first_new); f < faces_.size(); ++f)
+                {
+                    const uint32_t next(face_from_[faces_[f].vertices[1]]);
+                    faces_[f].neighbors[1] = next;
+                    faces_[next].neighbors[2] = f;
+                }
+
+                for (const uint32_t f : visible_faces_)
+                {
+                    faces_[f].alive = false;
+                    vector<uint32_t> orphans(move(faces_[f].outside));
+                    for (const uint32_t point : orphans)
+                        if (point != eye)
+                            assign(point, first_new);
+                }
+                for (uint32_t f(first_new); f < faces_.size(); ++f)
+                    if (!faces_[f].outside.empty())
+                        pending_.push_back(f);
+            }
+
+        public:
+            explicit quickhull(const vector<array<double, 3>>& points)
+                : points_(points), face_from_(points.size()), stamp_(0)
+            {
+            }
+
+            // false if the candidates do not span a volume
+            bool build(const vector<uint32_t>& candidates)
+            {
+                if (candidates.size() < 4)
+                    return false;
+                // extreme corner, the point farthest from it, from their line, from their plane
+                uint32_t a(candidates[0]);
+                for (const uint32_t point : candidates)
+                    if (points_[point] < points_[a])
+                        a = point;
+                uint32_t b(a);
+                double best(0);
+                for (const uint32_t point : candidates)
+                {
+                    const auto offset(subtract(points_[point], points_[a]));
+                    if (const double length(dot(offset, offset)); length > best)
+                    {
+                        best = length;
+                        b = point;
+                    }
+                }
+                uint32_t c(a);
+                best = 0;
+                for (const uint32_t point : candidates)
+                {
+                    const auto& p(points_[point]);
+                    const double xy(orient2d({points_[a][0], points_[a][1]}, {points_[b][0], points_[b][1]}, {p[0], p[1]}));
+                    const double yz(orient2d({points_[a][1], points_[a][2]}, {points_[b][1], points_[b][2]}, {p[1], p[2]}));
+                    const double zx(orient2d({points_[a][2], points_[a][0]}, {points_[b][2], points_[b][0]}, {p[2], p[0]}));
+                    if (const double area(xy * xy + yz * yz + zx * zx); area > best)
+                    {
+                        best = area;
+                        c = point;
+                    }
+                }
+                uint32_t d(a);
+                best = 0;
+                for (const uint32_t point : candidates)
+                    if (const double volume(fabs(orient3d(points_[a], points_[b], points_[c], points_[point])));
+                        volume > best)
+                    {
+                        best = volume;
+                        d = point;
+                    }
+                if (best == 0)
+                    return false;
+                if (orient3d(points_[a], points_[b], points_[c], points_[d]) < 0)
+                    swap(b, c);
+
+                // with d below abc every face keeps the opposite corner below it
+                add_face(a, b, c);
+                add_face(a, d, b);
+                add_face(b, d, c);
+                add_face(c, d, a);
+                faces_[0].neighbors = {1, 2, 3};
+                faces_[1].neighbors = {3, 2, 0};
+                faces_[2].neighbors = {1, 3, 0};
+                faces_[3].neighbors = {2, 1, 0};
+                for (const uint32_t point : candidates)
+                    if (point != a && point != b && point != c && point != d)
+                        assign(point, 0);
+                for (uint32_t f(0); f < 4; ++f)
+                    if (!faces_[f].outside.empty())
+                        pending_.push_back(f);
+
+                while (!pending_.empty())
+                {
+                    const uint32_t f(pending_.back());
+                    pending_.pop_back();
+                    if (faces_[f].alive && !faces_[f].outside.empty())
+                        add_point(f);
+                }
+                return true;
+            }
+
+            [[nodiscard]] vector<array<uint32_t, 3>> triangles() const
+            {
+                vector<array<uint32_t, 3>> result;
+                for (const hull_face& face : faces_)
+                    if (face.alive)
+                        result.push_back(face.vertices);
+                return result;
+            }
+        };
+    }
+
+    vector<array<uint32_t, 3>> convex_hull(const vector<array<double, 3>>& points, thread_pool& pool)
+    {
+        if (points.size() > UINT32_MAX)
+            throw invalid_argument("Convex hull input exceeds 32-bit indices");
+        const size_t chunks(clamp<size_t>(points.size() / chunk_points, 1, max_chunks));
+
+        // the hull of the union of the chunk hulls is the hull of the cloud
+        vector<vector<uint32_t>> corners(chunks);
+        pool.parallel_for(0, chunks, 1, [&](size_t first, size_t last)
+        {
+            for (size_t chunk(first); chunk < last; ++chunk)
+            {
+                const size_t begin(chunk * points.size() / chunks), end((chunk + 1) * points.size() / chunks);
+                vector<uint32_t> candidates(end - begin);
+                for (size_t i(begin); i < end; ++i)
+                    candidates[i - begin] = uint32_t(i);
+                if (chunks == 1)
+                {
+                    corners[chunk] = move(candidates);
+                    continue;
+                }
+                quickhull hull(points);
+                if (!hull.build(candidates))
+                {
+                    corners[chunk] = move(candidates);
+                    continue;
+                }
+                for (const auto& triangle : hull.triangles())
+                    corners[chunk].insert(corners[chunk].end(), triangle.begin(), triangle.end());
+                sort(corners[chunk].begin(), corners[chunk].end());
+                corners[chunk].erase(unique(corners[chunk].begin(), corners[chunk].end()), corners[chunk].end());
+            }
+        });
+
+        vector<uint32_t> candidates;
+        for (const auto& chunk : corners)
+            candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+        quickhull hull(points);
+        if (!hull.build(candidates))
+            throw invalid_argument("Convex hull points do not span a volume");
+        return hull.triangles();
+    }
+} // engine_lib
@@ -0,0 +1,52 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef CONVEX_HULL_HPP
+#define CONVEX_HULL_HPP
+#include "../../includes.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Computes the convex hull of a point cloud with quickhull.
+     *
+     * Large clouds are cut into chunks whose hulls are computed in parallel; only the hull
+     * vertices of the chunks enter the final hull, which for clouds filling a volume is a
+     * small fraction of the points. Every side-of-plane decision uses the exact orient3d
+     * predicate, so nearly coplanar input cannot produce a non-convex or open hull; points
+     * on the hull surface that are not corners are left out. Coplanar corners may split one
+     * flat facet into several triangles. The result does not depend on the thread count.
+     *
+     * @param points The cloud.
+     * @param pool Pool computing the chunk hulls.
+     * @return Triangles of the hull as indices into points, counterclockwise seen from outside.
+     * @throws invalid_argument If the points do not span a volume.
+     */
+    vector<array<uint32_t, 3>> convex_hull(const vector<array<double, 3>>& points,
+                                           thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Computes the convex hull of a point cloud with quickhull.
+     *
+     * @param points The cloud, converted to double.
+     * @param pool Pool computing the chunk hulls.
+     * @return Triangles of the hull as indices into points, counterclockwise seen from outside.
+     * @throws invalid_argument If the points do not span a volume.
+     */
+    template <class T>
+    vector<array<uint32_t, 3>> convex_hull(const vector<point<T, 3>>& points,
+                                           thread_pool& pool = thread_pool::global());
+} // engine_lib
+
+#endif //CONVEX_HULL_HPP
+#include "convex_hull.inl"
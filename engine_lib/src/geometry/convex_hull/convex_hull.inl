@@ -0,0 +1,19 @@
+#ifndef CONVEX_HULL_INL
+#define CONVEX_HULL_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    vector<array<uint32_t, 3>> convex_hull(const vector<point<T, 3>>& points, thread_pool& pool)
+    {
+        vector<array<double, 3>> converted(points.size());
+        for (size_t i(0); i < points.size(); ++i)
+            for (size_t k(0); k < 3; ++k)
+                converted[i][k] = double(points[i].coordinate(k));
+        return convex_hull(converted, pool);
+    }
+} // engine_lib
+
+#endif //CONVEX_HULL_INL
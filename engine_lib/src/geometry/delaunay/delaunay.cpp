@@ -0,0 +1,689 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "delaunay.hpp"
+#include "../../math/predicates/predicates.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <utility>
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr uint32_t no_vertex(UINT32_MAX);
+        // runs are at least this long before they are triangulated on their own
+        constexpr size_t run_points(1 << 12);
+        constexpr size_t max_runs(64);
+        // points of the first insertion round, inserted in Morton order without shuffling
+        constexpr size_t brio_first_round(64);
+
+        // one of the four directed edges of a quad-edge; the primal ones have an origin
+        struct half_edge
+        {
+            half_edge* next; // next edge counterclockwise around the origin
+            half_edge* rot; // dual edge rotated a quarter turn counterclockwise
+            uint32_t origin;
+            bool visited;
+        };
+
+        struct quad_edge
+        {
+            array<half_edge, 4> edges;
+        };
+
+        half_edge* sym(half_edge* e)
+        {
+            return e->rot->rot;
+        }
+
+        half_edge* onext(half_edge* e)
+        {
+            return e->next;
+        }
+
+        half_edge* oprev(half_edge* e)
+        {
+            return e->rot->next->rot;
+        }
+
+        half_edge* lnext(half_edge* e)
+        {
+            return e->rot->rot->rot->next->rot;
+        }
+
+        half_edge* rprev(half_edge* e)
+        {
+            return sym(e)->next;
+        }
+
+        uint32_t destination(half_edge* e)
+        {
+            return sym(e)->origin;
+        }
+
+        void splice(half_edge* a, half_edge* b)
+        {
+            half_edge* alpha(a->next->rot);
+            half_edge* beta(b->next->rot);
+            swap(a->next, b->next);
+            swap(alpha->next, beta->next);
+        }
+
+        // quad-edges of one run; a merge allocates from the arena of its left run, so
+        // concurrent merges never share one
+        class edge_arena
+        {
+            deque<quad_edge> quads_;
+
+        public:
+            half_edge* make_edge(uint32_t origin, uint32_t destination)
+            {
+                auto& edges(quads_.emplace_back().edges);
+                for (size_t i(0); i < 4; ++i)
+                {
+                    edges[i].rot = &edges[(i + 1) % 4];
+                    edges[i].origin = no_vertex;
+                    edges[i].visited = false;
+                }
+                edges[0].next = &edges[0];
+                edges[2].next = &edges[2];
+                edges[1].next = &edges[3];
+                edges[3].next = &edges[1];
+                edges[0].origin = origin;
+                edges[2].origin = destination;
+                return &edges[0];
+            }
+
+            // an edge from the destination of a to the origin of b, closing the left face of a
+            half_edge* connect(half_edge* a, half_edge* b)
+            {
+                half_edge* e(make_edge(destination(a), b->origin));
+                splice(e, lnext(a));
+                splice(sym(e), b);
+                return e;
+            }
+
+            deque<quad_edge>& quads()
+            {
+                return quads_;
+            }
+        };
+
+        void delete_edge(half_edge* e)
+        {
+            splice(e, oprev(e));
+            splice(sym(e), oprev(sym(e)));
+            sym(e)->origin = no_vertex;
+            e->origin = no_vertex;
+        }
+
+        // the counterclockwise convex hull edge out of the leftmost vertex and the clockwise one
+        // out of the rightmost
+        using hull_edges = pair<half_edge*, half_edge*>;
+
+        class plane_triangulator
+        {
+            const vector<array<double, 2>>& points_;
+
+            [[nodiscard]] bool ccw(uint32_t a, uint32_t b, uint32_t c) const
+            {
+                return orient2d(points_[a], points_[b], points_[c]) > 0;
+            }
+
+            [[nodiscard]] bool right_of(uint32_t x, half_edge* e) const
+            {
+                return ccw(x, destination(e), e->origin);
+            }
+
+            [[nodiscard]] bool left_of(uint32_t x, half_edge* e) const
+            {
+                return ccw(x, e->origin, destination(e));
+            }
+
+            [[nodiscard]] bool in_circle(uint32_t a, uint32_t b, uint32_t c, uint32_t d) const
+            {
+                return incircle(points_[a], points_[b], points_[c], points_[d]) > 0;
+            }
+
+        public:
+            explicit plane_triangulator(const vector<array<double, 2>>& points) : points_(points)
+            {
+            }
+
+            hull_edges merge(hull_edges left, hull_edges right, edge_arena& arena) const
+            {
+                auto [ldo, ldi] = left;
+                auto [rdi, rdo] = right;
+                // lower common tangent of the two hulls
+                while (true)
+                    if (left_of(rdi->origin, ldi))
+                        ldi = lnext(ldi);
+                    else if (right_of(ldi->origin, rdi))
+                        rdi = rprev(rdi);
+                    else
+                        break;
+
+                half_edge* base(arena.connect(sym(rdi), ldi));
+                if (ldi->origin == ldo->origin)
+                    ldo = sym(base);
+                if (rdi->origin == rdo->origin)
+                    rdo = base;
+                // climb up, deleting the edges whose circumcircles the rising base edge pierces
+                while (true)
+                {
+                    half_edge* left_candidate(onext(sym(base)));
+                    const auto valid([&](half_edge* e) { return right_of(destination(e), base); });
+                    if (valid(left_candidate))
+                        while (in_circle(destination(base), base->origin, destination(left_candidate),
+                                         destination(onext(left_candidate))))
+                        {
+                            half_edge* next(onext(left_candidate));
+                            delete_edge(left_candidate);
+                            left_candidate = next;
+                        }
+                    half_edge* right_candidate(oprev(base));
+                    if (valid(right_candidate))
+                        while (in_circle(destination(base), base->origin, destination(right_candidate),
+                                         destination(oprev(right_candidate))))
+                        {
+                            half_edge* next(oprev(right_candidate));
+                            delete_edge(right_candidate);
+                            right_candidate = next;
+                        }
+                    const bool left_valid(valid(left_candidate)), right_valid(valid(right_candidate));
+                    if (!left_valid && !right_valid)
+                        break;
+                    if (!left_valid || (right_valid && in_circle(destination(left_candidate), left_candidate->origin,
+                                                                 right_candidate->origin,
+                                                                 destination(right_candidate))))
+                        base = arena.connect(right_candidate, sym(base));
+                    else
+                        base = arena.connect(sym(base), sym(left_candidate));
+                }
+                return {ldo, rdo};
+            }
+
+            // triangulates two or more distinct points, returning the hull edges at the ends of
+            // the axis; the halves are cut across the other axis, so the cells stay square
+            // instead of thin strips whose merges test nearly degenerate circles (Dwyer)
+            hull_edges triangulate(uint32_t* first, uint32_t* last, size_t axis, edge_arena& arena) const
+            {
+                const auto before([&](uint32_t a, uint32_t b) { return precedes(a, b, axis); });
+                const size_t count(size_t(last - first));
+                if (count == 2)
+                {
+                    sort(first, last, before);
+                    half_edge* a(arena.make_edge(first[0], first[1]));
+                    return {a, sym(a)};
+                }
+                if (count == 3)
+                {
+                    sort(first, last, before);
+                    half_edge* a(arena.make_edge(first[0], first[1]));
+                    half_edge* b(arena.make_edge(first[1], first[2]));
+                    splice(sym(a), b);
+                    if (ccw(first[0], first[1], first[2]))
+                    {
+                        arena.connect(b, a);
+                        return {a, sym(b)};
+                    }
+                    if (ccw(first[0], first[2], first[1]))
+                    {
+                        half_edge* c(arena.connect(b, a));
+                        return {sym(c), c};
+                    }
+                    return {a, sym(b)};
+                }
+                uint32_t* middle(first + count / 2);
+                nth_element(first, middle, last, before);
+                const hull_edges left(triangulate(first, middle, 1 - axis, arena));
+                const hull_edges right(triangulate(middle, last, 1 - axis, arena));
+                return merge(hull_ends(left, axis), hull_ends(right, axis), arena);
+            }
+
+            // the order along an axis, y then x for the x axis and -x then y for the y axis, is a
+            // rotation of the plane by a quarter turn, which the predicates do not notice
+            [[nodiscard]] bool precedes(uint32_t a, uint32_t b, size_t axis) const
+            {
+                const auto& p(points_[a]);
+                const auto& q(points_[b]);
+                if (axis == 0)
+                    return p[0] < q[0] || (p[0] == q[0] && p[1] < q[1]);
+                return p[1] < q[1] || (p[1] == q[1] && p[0] > q[0]);
+            }
+
+            // the hull edges at the ends of the other axis, found by walking the hull clockwise
+            [[nodiscard]] hull_edges hull_ends(hull_edges ends, size_t axis) const
+            {
+                half_edge* start(sym(ends.first));
+                half_edge* lowest(start);
+                half_edge* highest(start);
+                half_edge* e(start);
+                do
+                {
+                    if (precedes(destination(e), destination(lowest), axis))
+                        lowest = e;
+                    if (precedes(highest->origin, e->origin, axis))
+                        highest = e;
+                    e = lnext(e);
+                }
+                while (e != start);
+                return {sym(lowest), highest};
+            }
+
+            [[nodiscard]] vector<array<uint32_t, 3>> triangles(vector<edge_arena>& arenas) const
+            {
+                vector<array<uint32_t, 3>> result;
+                for (auto& arena : arenas)
+                    for (auto& quad : arena.quads())
+                        for (const size_t k : {0, 2})
+                        {
+                            half_edge* a(&quad.edges[k]);
+                            if (a->origin == no_vertex || a->visited)
+                                continue;
+                            half_edge* b(lnext(a));
+                            half_edge* c(lnext(b));
+                            a->visited = true;
+                            if (lnext(c) != a)
+                                continue;
+                            b->visited = true;
+                            c->visited = true;
+                            if (ccw(a->origin, b->origin, c->origin))
+                                result.push_back({a->origin, b->origin, c->origin});
+                        }
+                return result;
+            }
+        };
+
+        // interleaves the low 21 bits of three coordinates
+        uint64_t spread(uint64_t x)
+        {
+            x &= 0x1fffff;
+            x = (x | x << 32) & 0x1f00000000ffffull;
+            x = (x | x << 16) & 0x1f0000ff0000ffull;
+            x = (x | x << 8) & 0x100f00f00f00f00full;
+            x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+            x = (x | x << 2) & 0x1249249249249249ull;
+            return x;
+        }
+
+        constexpr uint32_t infinite(UINT32_MAX);
+        constexpr uint32_t no_cell(UINT32_MAX);
+
+        // four vertices, possibly one of them the vertex at infinity, with a positive orientation;
+        // neighbor i lies across the face opposite vertex i
+        struct tetrahedron
+        {
+            array<uint32_t, 4> vertices;
+            array<uint32_t, 4> neighbors;
+        };
+
+        // a face of the cavity: its cell, the slot of the cell opposite it and the slot of the
+        // cell outside the cavity pointing back
+        struct cavity_face
+        {
+            uint32_t cell;
+            uint32_t slot;
+            size_t back;
+        };
+
+        // a face through the inserted point, not yet paired with its neighbor
+        struct open_face
+        {
+            uint64_t edge;
+            uint32_t cell;
+            uint32_t slot;
+        };
+
+        class space_triangulator
+        {
+            const vector<array<double, 3>>& points_;
+            vector<tetrahedron> cells_;
+            vector<uint32_t> free_cells_;
+            vector<uint32_t> tested_;
+            vector<bool> conflict_;
+            vector<uint32_t> cavity_;
+            vector<cavity_face> boundary_;
+            vector<tetrahedron> replacements_;
+            vector<uint32_t> created_;
+            vector<open_face> open_faces_;
+            vector<uint32_t> open_stamps_;
+            uint32_t link_stamp_;
+            uint32_t stamp_;
+            uint32_t hint_;
+
+            // orient3d of a cell with one vertex replaced by a finite point
+            [[nodiscard]] double orientation(const tetrahedron& cell, size_t replaced, uint32_t point) const
+            {
+                array<const array<double, 3>*, 4> corners;
+                for (size_t i(0); i < 4; ++i)
+                    corners[i] = &points_[i == replaced ? point : cell.vertices[i]];
+                return orient3d(*corners[0], *corners[1], *corners[2], *corners[3]);
+            }
+
+            [[nodiscard]] size_t infinite_slot(const tetrahedron& cell) const
+            {
+                for (size_t i(0); i < 4; ++i)
+                    if (cell.vertices[i] == infinite)
+                        return i;
+                return 4;
+            }
+
+            // whether the circumsphere of a cell strictly contains the point; for a cell at
+            // infinity its open half-space beyond the hull face, and the disk of the face
+            [[nodiscard]] bool in_conflict(uint32_t c, uint32_t point) const
+            {
+                const tetrahedron& cell(cells_[c]);
+                const size_t slot(infinite_slot(cell));
+                if (slot == 4)
+                    return insphere(points_[cell.vertices[0]], points_[cell.vertices[1]], points_[cell.vertices[2]],
+                                    points_[cell.vertices[3]], points_[point]) > 0;
+                const double side(orientation(cell, slot, point));
+                if (side != 0)
+                    return side > 0;
+                return in_conflict(cell.neighbors[slot], point);
+            }
+
+            uint32_t allocate(const tetrahedron& cell)
+            {
+                if (!free_cells_.empty())
+                {
+                    const uint32_t c(free_cells_.back());
+                    free_cells_.pop_back();
+                    cells_[c] = cell;
+                    return c;
+                }
+                cells_.push_back(cell);
+                tested_.push_back(0);
+                conflict_.push_back(false);
+                return uint32_t(cells_.size() - 1);
+            }
+
+            // pairs up the faces through the apex of the cells just created, each named by its
+            // two other vertices, in a small open-addressed table cleared by a stamp
+            void link(uint32_t apex)
+            {
+                size_t size(16);
+                while (size < 8 * created_.size())
+                    size *= 2;
+                if (open_faces_.size() < size)
+                {
+                    open_faces_.resize(size);
+                    open_stamps_.assign(size, 0);
+                    link_stamp_ = 0;
+                }
+                ++link_stamp_;
+                const size_t mask(size - 1);
+                for (const uint32_t c : created_)
+                    for (size_t j(0); j < 4; ++j)
+                    {
+                        if (cells_[c].vertices[j] == apex)
+                            continue;
+                        array<uint32_t, 2> edge{};
+                        for (size_t i(0), k(0); i < 4; ++i)
+                            if (i != j && cells_[c].vertices[i] != apex)
+                                edge[k++] = cells_[c].vertices[i];
+                        const uint64_t key(uint64_t(min(edge[0], edge[1])) << 32 | max(edge[0], edge[1]));
+                        size_t slot(size_t(key * 0x9e3779b97f4a7c15ull >> 40) & mask);
+                        while (open_stamps_[slot] == link_stamp_ && open_faces_[slot].edge != key)
+                            slot = (slot + 1) & mask;
+                        if (open_stamps_[slot] == link_stamp_)
+                        {
+                            const open_face& other(open_faces_[slot]);
+                            cells_[c].neighbors[j] = other.cell;
+                            cells_[other.cell].neighbors[other.slot] = c;
+                        }
+                        else
+                        {
+                            open_stamps_[slot] = link_stamp_;
+                            open_faces_[slot] = {key, c, uint32_t(j)};
+                        }
+                    }
+            }
+
+            // walks from the hint to a cell in conflict with the point
+            [[nodiscard]] uint32_t locate(uint32_t point) const
+            {
+                uint32_t c(hint_);
+                for (uint32_t step(0);; ++step)
+                {
+                    const tetrahedron& cell(cells_[c]);
+                    const size_t slot(infinite_slot(cell));
+                    if (slot != 4)
+                    {
+                        if (orientation(cell, slot, point) > 0)
+                            return c;
+                        c = cell.neighbors[slot];
+                        continue;
+                    }
+                    // visiting the faces from a varying start keeps the walk from cycling
+                    size_t beyond(4);
+                    for (size_t k(0); k < 4 && beyond == 4; ++k)
+                        if (const size_t i((k + step) % 4); orientation(cell, i, point) < 0)
+                            beyond = i;
+                    if (beyond == 4)
+                        return c;
+                    c = cell.neighbors[beyond];
+                }
+            }
+
+            void insert(uint32_t point)
+            {
+                const uint32_t start(locate(point));
+                ++stamp_;
+                cavity_.assign(1, start);
+                tested_[start] = stamp_;
+                conflict_[start] = true;
+                boundary_.clear();
+                for (size_t k(0); k < cavity_.size(); ++k)
+                    for (size_t i(0); i < 4; ++i)
+                    {
+                        const uint32_t n(cells_[cavity_[k]].neighbors[i]);
+                        if (tested_[n] != stamp_)
+                        {
+                            tested_[n] = stamp_;
+                            conflict_[n] = in_conflict(n, point);
+                            if (conflict_[n])
+                                cavity_.push_back(n);
+                        }
+                        if (!conflict_[n])
+                        {
+                            size_t back(0);
+                            while (cells_[n].neighbors[back] != cavity_[k])
+                                ++back;
+                            boundary_.push_back({cavity_[k], uint32_t(i), back});
+                        }
+                    }
+
+                // every cavity face is seen from the point, so replacing the cell vertex opposite
+                // it by the point keeps the orientation
+                replacements_.clear();
+                for (const auto& face : boundary_)
+                {
+                    tetrahedron cell(cells_[face.cell]);
+                    cell.vertices[face.slot] = point;
+                    const uint32_t outside(cell.neighbors[face.slot]);
+                    cell.neighbors = {no_cell, no_cell, no_cell, no_cell};
+                    cell.neighbors[face.slot] = outside;
+                    replacements_.push_back(cell);
+                }
+                free_cells_.insert(free_cells_.end(), cavity_.begin(), cavity_.end());
+                created_.clear();
+                for (size_t k(0); k < boundary_.size(); ++k)
+                {
+                    const uint32_t c(allocate(replacements_[k]));
+                    cells_[cells_[c].neighbors[boundary_[k].slot]].neighbors[boundary_[k].back] = c;
+                    created_.push_back(c);
+                }
+                link(point);
+                hint_ = created_[0];
+            }
+
+        public:
+            explicit space_triangulator(const vector<array<double, 3>>& points)
+                : points_(points), link_stamp_(0), stamp_(0), hint_(0)
+            {
+            }
+
+            // false if the points do not span a volume
+            bool build(const vector<uint32_t>& order)
+            {
+                // the first four points of the order spanning a volume form the first cell
+                array<uint32_t, 4> first{};
+                size_t found(0);
+                for (const uint32_t point : order)
+                {
+                    const auto& p(points_[point]);
+                    if (found == 1 && p == points_[first[0]])
+                        continue;
+                    if (found == 2)
+                    {
+                        const auto& a(points_[first[0]]);
+                        const auto& b(points_[first[1]]);
+                        if (orient2d({a[0], a[1]}, {b[0], b[1]}, {p[0], p[1]}) == 0
+                            && orient2d({a[1], a[2]}, {b[1], b[2]}, {p[1], p[2]}) == 0
+                            && orient2d({a[2], a[0]}, {b[2], b[0]}, {p[2], p[0]}) == 0)
+                            continue;
+                    }
+                    if (found == 3 && orient3d(points_[first[0]], points_[first[1]], points_[first[2]], p) == 0)
+                        continue;
+                    first[found++] = point;
+                    if (found == 4)
+                        break;
+                }
+                if (found < 4)
+                    return false;
+                if (orient3d(points_[first[0]], points_[first[1]], points_[first[2]], points_[first[3]]) < 0)
+                    swap(first[0], first[1]);
+
+                // the cells at infinity put the vertex at infinity where the first cell has the
+                // opposite corner and swap two others, so they face away from it
+                created_.clear();
+                const uint32_t finite(allocate({first, {no_cell, no_cell, no_cell, no_cell}}));
+                for (size_t i(0); i < 4; ++i)
+                {
+                    tetrahedron cell{first, {no_cell, no_cell, no_cell, no_cell}};
+                    cell.vertices[i] = infinite;
+                    swap(cell.vertices[(i + 1) % 4], cell.vertices[(i + 2) % 4]);
+                    cell.neighbors[i] = finite;
+                    const uint32_t c(allocate(cell));
+                    cells_[finite].neighbors[i] = c;
+                    created_.push_back(c);
+                }
+                link(infinite);
+                hint_ = finite;
+
+                for (const uint32_t point : order)
+                    if (point != first[0] && point != first[1] && point != first[2] && point != first[3])
+                        insert(point);
+                return true;
+            }
+
+            [[nodiscard]] vector<array<uint32_t, 4>> tetrahedra() const
+            {
+                vector<bool> unused(cells_.size(), false);
+                for (const uint32_t c : free_cells_)
+                    unused[c] = true;
+                vector<array<uint32_t, 4>> result;
+                for (size_t c(0); c < cells_.size(); ++c)
+                    if (!unused[c] && infinite_slot(cells_[c]) == 4)
+                        result.push_back(cells_[c].vertices);
+                return result;
+            }
+        };
+
+        // sorted point indices with repeated points removed, keeping the first of each
+        template <size_t N>
+        vector<uint32_t> distinct_points(const vector<array<double, N>>& points)
+        {
+            if (points.size() > UINT32_MAX)
+                throw invalid_argument("Delaunay input exceeds 32-bit indices");
+            vector<uint32_t> order(points.size());
+            for (size_t i(0); i < order.size(); ++i)
+                order[i] = uint32_t(i);
+            stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return points[a] < points[b]; });
+            order.erase(unique(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+            {
+                return points[a] == points[b];
+            }), order.end());
+            return order;
+        }
+    }
+
+    vector<array<uint32_t, 3>> delaunay_triangulation(const vector<array<double, 2>>& points, thread_pool& pool)
+    {
+        vector<uint32_t> order(distinct_points(points));
+        if (order.size() < 3)
+            return {};
+        size_t runs(1);
+        while (runs * 2 <= max_runs && order.size() / (runs * 2) >= run_points)
+            runs *= 2;
+
+        const plane_triangulator triangulator(points);
+        vector<edge_arena> arenas(runs);
+        vector<hull_edges> hulls(runs);
+        const auto run_start([&](size_t run) { return order.data() + run * order.size() / runs; });
+        pool.parallel_for(0, runs, 1, [&](size_t first, size_t last)
+        {
+            for (size_t run(first); run < last; ++run)
+                hulls[run] = triangulator.triangulate(run_start(run), run_start(run + 1), 0, arenas[run]);
+        });
+        for (size_t width(1); width < runs; width *= 2)
+            pool.parallel_for(0, runs / (2 * width), 1, [&](size_t first, size_t last)
+            {
+                for (size_t pair(first); pair < last; ++pair)
+                {
+                    const size_t left(2 * pair * width);
+                    hulls[left] = triangulator.merge(hulls[left], hulls[left + width], arenas[left]);
+                }
+            });
+        return triangulator.triangles(arenas);
+    }
+
+    vector<array<uint32_t, 4>> delaunay_tetrahedralization(const vector<array<double, 3>>& points, thread_pool& pool)
+    {
+        vector<uint32_t> order(distinct_points(points));
+        if (order.size() < 4)
+            return {};
+
+        // biased randomized insertion order: shuffled rounds doubling in size, each sorted by
+        // quantized Morton codes, so consecutive insertions stay close and the walks short
+        // while every round still spreads over the whole hull
+        array<double, 3> lower(points[order[0]]), upper(points[order[0]]);
+        for (const uint32_t point : order)
+            for (size_t k(0); k < 3; ++k)
+            {
+                lower[k] = min(lower[k], points[point][k]);
+                upper[k] = max(upper[k], points[point][k]);
+            }
+        vector<pair<uint64_t, uint32_t>> keys(order.size());
+        pool.parallel_for(0, order.size(), 0, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; ++i)
+            {
+                uint64_t code(0);
+                for (size_t k(0); k < 3; ++k)
+                {
+                    const double extent(upper[k] - lower[k]);
+                    const double scaled(extent > 0 ? (points[order[i]][k] - lower[k]) / extent : 0);
+                    code |= spread(uint64_t(scaled * 0x1fffff)) << k;
+                }
+                keys[i] = {code, order[i]};
+            }
+        });
+        shuffle(keys.begin(), keys.end(), mt19937(1));
+        for (size_t end(keys.size()); end != 0; end = end > brio_first_round ? end / 2 : 0)
+            sort(keys.begin() + (end > brio_first_round ? end / 2 : 0), keys.begin() + end);
+        for (size_t i(0); i < keys.size(); ++i)
+            order[i] = keys[i].second;
+
+        space_triangulator triangulator(points);
+        if (!triangulator.build(order))
+            return {};
+        return triangulator.tetrahedra();
+    }
+} // engine_lib
@@ -0,0 +1,84 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef DELAUNAY_HPP
+#define DELAUNAY_HPP
+#include "../../includes.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Computes the Delaunay triangulation of points in the plane.
+     *
+     * Guibas and Stolfi's divide and conquer over a quad-edge structure: the points are
+     * sorted, cut into runs triangulated in parallel, and the runs are merged pairwise,
+     * the merges of one level in parallel. Within a run the cuts alternate between the
+     * axes. The exact orient2d and incircle predicates decide every step, so the
+     * triangulation is valid for any input; cocircular points are triangulated in an
+     * unspecified but deterministic way. Repeated points are triangulated once, by their
+     * first index. The result does not depend on the thread count.
+     *
+     * @param points The points.
+     * @param pool Pool triangulating and merging the runs.
+     * @return Counterclockwise triangles as indices into points, empty if the points are collinear.
+     * @throws invalid_argument If there are more points than 32-bit indices can address.
+     */
+    vector<array<uint32_t, 3>> delaunay_triangulation(const vector<array<double, 2>>& points,
+                                                      thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Computes the Delaunay triangulation of points in the plane.
+     *
+     * @param points The points, converted to double.
+     * @param pool Pool triangulating and merging the runs.
+     * @return Counterclockwise triangles as indices into points, empty if the points are collinear.
+     * @throws invalid_argument If there are more points than 32-bit indices can address.
+     */
+    template <class T>
+    vector<array<uint32_t, 3>> delaunay_triangulation(const vector<point<T, 2>>& points,
+                                                      thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Computes the Delaunay tetrahedralization of points in space.
+     *
+     * Bowyer-Watson insertion in shuffled rounds of doubling size, each round along a Morton
+     * curve and each point located by walking from the previous one. The hull is closed by
+     * tetrahedra sharing a vertex at infinity, so points outside the current hull need no
+     * bounding box. The exact orient3d and insphere predicates decide every step; cospherical
+     * points are tetrahedralized in an unspecified but deterministic way. Repeated points are
+     * inserted once, by their first index. Only the ordering runs in parallel, the insertion
+     * is sequential.
+     *
+     * @param points The points.
+     * @param pool Pool computing the insertion order.
+     * @return Tetrahedra as indices into points, each with a positive orient3d, empty if the points are coplanar.
+     * @throws invalid_argument If there are more points than 32-bit indices can address.
+     */
+    vector<array<uint32_t, 4>> delaunay_tetrahedralization(const vector<array<double, 3>>& points,
+                                                           thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Computes the Delaunay tetrahedralization of points in space.
+     *
+     * @param points The points, converted to double.
+     * @param pool Pool computing the insertion order.
+     * @return Tetrahedra as indices into points, each with a positive orient3d, empty if the points are coplanar.
+     * @throws invalid_argument If there are more points than 32-bit indices can address.
+     */
+    template <class T>
+    vector<array<uint32_t, 4>> delaunay_tetrahedralization(const vector<point<T, 3>>& points,
+                                                           thread_pool& pool = thread_pool::global());
+} // engine_lib
+
+#endif //DELAUNAY_HPP
+#include "delaunay.inl"
@@ -0,0 +1,28 @@
+#ifndef DELAUNAY_INL
+#define DELAUNAY_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    vector<array<uint32_t, 3>> delaunay_triangulation(const vector<point<T, 2>>& points, thread_pool& pool)
+    {
+        vector<array<double, 2>> converted(points.size());
+        for (size_t i(0); i < points.size(); ++i)
+            converted[i] = {double(points[i].coordinate(0)), double(points[i].coordinate(1))};
+        return delaunay_triangulation(converted, pool);
+    }
+
+    template <class T>
+    vector<array<uint32_t, 4>> delaunay_tetrahedralization(const vector<point<T, 3>>& points, thread_pool& pool)
+    {
+        vector<array<double, 3>> converted(points.size());
+        for (size_t i(0); i < points.size(); ++i)
+            for (size_t k(0); k < 3; ++k)
+                converted[i][k] = double(points[i].coordinate(k));
+        return delaunay_tetrahedralization(converted, pool);
+    }
+} // engine_lib
+
+#endif //DELAUNAY_INL
@@ -0,0 +1,503 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh.hpp"
+#include "../../math/vector3/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // triangles handed to one task by the per-face and per-vertex passes
+        constexpr size_t mesh_grain = 4096;
+
+        using vec3 = array<float, 3>;
+
+        /*
+         * Triangles around every vertex as CSR: the triangles of vertex v are
+         * triangles[offsets[v]] .. triangles[offsets[v + 1]], in ascending order.
+         */
+        struct vertex_triangles
+        {
+            vector<uint32_t> offsets;
+            vector<uint32_t> triangles;
+        };
+
+        vertex_triangles gather_triangles(const vector<uint32_t>& indices, size_t vertex_count)
+        {
+            vertex_triangles result;
+            result.offsets.assign(vertex_count + 1, 0);
+            for (uint32_t index : indices)
+                ++result.offsets[index + 1];
+            for (size_t v(0); v < vertex_count; ++v)
+                result.offsets[v + 1] += result.offsets[v];
+
+            result.triangles.resize(indices.size());
+            vector<uint32_t> cursor(result.offsets.begin(), result.offsets.end() - 1);
+            for (size_t i(0); i < indices.size(); ++i)
+                result.triangles[cursor[indices[i]]++] = uint32_t(i / 3);
+            return result;
+        }
+
+        // Forsyth's vertex score, see optimize_vertex_cache()
+        float vertex_score(int cache_position, uint32_t remaining, size_t cache_size)
+        {
+            if (remaining == 0)
+                return -1.0f;
+            float score(0.0f);
+            if (cache_position >= 0)
+            {
+                if (cache_position < 3)
+                    score = 0.75f;
+                else
+                    score = pow(1.0f - float(cache_position - 3) / float(cache_size - 3), 1.5f);
+            }
+            return score + 2.0f / sqrt(float(remaining));
+        }
+    }
+
+    mesh::mesh(vertex_layout layout)
+        : layout_(layout)
+    {
+    }
+
+    mesh::mesh(vector<vertex> vertices, vector<uint32_t> indices)
+        : layout_(vertex_layout::interleaved),
+          vertices_(move(vertices))
+    {
+        set_indices(move(indices));
+    }
+
+    vertex_layout mesh::layout() const
+    {
+        return layout_;
+    }
+
+    size_t mesh::vertex_count() const
+    {
+        return layout_ == vertex_layout::interleaved ? vertices_.size() : positions_.size();
+    }
+
+    size_t mesh::triangle_count() const
+    {
+        return indices_.size() / 3;
+    }
+
+    void mesh::reserve(size_t vertices, size_t triangles)
+    {
+        if (layout_ == vertex_layout::interleaved)
+            vertices_.reserve(vertices);
+        else
+        {
+            positions_.reserve(vertices);
+            normals_.reserve(vertices);
+            uvs_.reserve(vertices);
+        }
+        indices_.reserve(triangles * 3);
+    }
+
+    uint32_t mesh::add_vertex(const point<float, 3>& position, const direction<float, 3>& normal,
+                              const point<float, 2>& uv)
+    {
+        const uint32_t index(static_cast<uint32_t>(vertex_count()));
+        const point<float, 3> stored_normal(normal.get_coordinates());
+        if (layout_ == vertex_layout::interleaved)
+            vertices_.push_back({position, stored_normal, uv});
+        else
+        {
+            positions_.push_back(position);
+            normals_.push_back(stored_normal);
+            uvs_.push_back(uv);
+        }
+        if (!tangents_.empty())
+            tangents_.emplace_back();
+        return index;
+    }
+
+    void mesh::add_triangle(uint32_t a, uint32_t b, uint32_t c)
+    {
+        const size_t count(vertex_count());
+        if (a >= count || b >= count || c >= count)
+            throw out_of_range("Vertex index out of range");
+        indices_.insert(indices_.end(), {a, b, c});
+    }
+
+    vertex mesh::get_vertex(size_t index) const
+    {
+        if (index >= vertex_count())
+            throw out_of_range("Vertex index out of range");
+        if (layout_ == vertex_layout::interleaved)
+            return vertices_[index];
+        return {positions_[index], normals_[index], uvs_[index]};
+    }
+
+    const vector<uint32_t>& mesh::indices() const
+    {
+        return indices_;
+    }
+
+    void mesh::set_indices(vector<uint32_t> indices)
+    {
+        if (indices.size() % 3 != 0)
+            throw invalid_argument("Index count must be a multiple of three");
+        const size_t count(vertex_count());
+        for (uint32_t index : indices)
+            if (index >= count)
+                throw out_of_range("Vertex index out of range");
+        indices_ = move(indices);
+    }
+
+    const vector<vertex>& mesh::vertices() const
+    {
+        return vertices_;
+    }
+
+    strided_view<point<float, 3>> mesh::positions()
+    {
+        if (layout_ == vertex_layout::interleaved)
+            return strided_view<point<float, 3>>::of_member(vertices_.data(), vertices_.size(), &vertex::position);
+        return positions_;
+    }
+
+    strided_view<const point<float, 3>> mesh::positions() const
+    {
+        return const_cast<mesh*>(this)->positions();
+    }
+
+    strided_view<point<float, 3>> mesh::normals()
+    {
+        if (layout_ == vertex_layout::interleaved)
+            return strided_view<point<float, 3>>::of_member(vertices_.data(), vertices_.size(), &vertex::normal);
+        return normals_;
+    }
+
+    strided_view<const point<float, 3>> mesh::normals() const
+    {
+        return const_cast<mesh*>(this)->normals();
+    }
+
+    strided_view<point<float, 2>> mesh::uvs()
+    {
+        if (layout_ == vertex_layout::interleaved)
+            return strided_view<point<float, 2>>::of_member(vertices_.data(), vertices_.size(), &vertex::uv);
+        return uvs_;
+    }
+
+    strided_view<const point<float, 2>> mesh::uvs() const
+    {
+        return const_cast<mesh*>(this)->uvs();
+    }
+
+    const vector<point<float, 4>>& mesh::tangents() const
+    {
+        return tangents_;
+    }
+
+    void mesh::convert_layout(vertex_layout layout)
+    {
+        if (layout == layout_)
+            return;
+        if (layout == vertex_layout::separate)
+        {
+            positions_.resize(vertices_.size());
+            normals_.resize(vertices_.size());
+            uvs_.resize(vertices_.size());
+            for (size_t i(0); i < vertices_.size(); ++i)
+            {
+                positions_[i] = vertices_[i].position;
+                normals_[i] = vertices_[i].normal;
+                uvs_[i] = vertices_[i].uv;
+            }
+            vector<vertex>().swap(vertices_);
+        }
+        else
+        {
+            vertices_.resize(positions_.size());
+            for (size_t i(0); i < positions_.size(); ++i)
+                vertices_[i] = {positions_[i], normals_[i], uvs_[i]};
+            vector<point<float, 3>>().swap(positions_);
+            vector<point<float, 3>>().swap(normals_);
+            vector<point<float, 2>>().swap(uvs_);
+        }
+        layout_ = layout;
+    }
+
+    void mesh::generate_normals(thread_pool& pool)
+    {
+        const size_t triangles(triangle_count());
+        const auto positions(this->positions());
+        auto normals(this->normals());
+
+        // the unnormalized cross product weighs every face by twice its area
+        vector<vec3> face_normals(triangles);
+        pool.parallel_for(0, triangles, mesh_grain, [&](size_t first, size_t last)
+        {
+            for (size_t t(first); t < last; ++t)
+            {
+                const vec3 a(positions[indices_[3 * t]].get_coordinates());
+                const vec3 b(positions[indices_[3 * t + 1]].get_coordinates());
+                const vec3 c(positions[indices_[3 * t + 2]].get_coordinates());
+                face_normals[t] = cross(subtract(b, a), subtract(c, a));
+            }
+        });
+
+        const vertex_triangles adjacency(gather_triangles(indices_, normals.size()));
+        pool.parallel_for(0, normals.size(), mesh_grain, [&](size_t first, size_t last)
+        {
+            for (size_t v(first); v < last; ++v)
+            {
+                vec3 sum({0.0f, 0.0f, 0.0f});
+                for (uint32_t k(adjacency.offsets[v]); k < adjacency.offsets[v + 1]; ++k)
+                {
+                    const vec3& face(face_normals[adjacency.triangles[k]]);
+                    for (size_t i(0); i < 3; ++i)
+                        sum[i] += face[i];
+                }
+                normals[v] = point<float, 3>(normalized(sum));
+            }
+        });
+    }
+
+    void mesh::generate_tangents(thread_pool& pool)
+    {
+        const size_t triangles(triangle_count());
+        const auto positions(this->positions());
+        const auto normals(this->normals());
+        const auto uvs(this->uvs());
+
+        // texture space s and t axes of every face, scaled by the face area
+        vector<array<vec3, 2>> face_axes(triangles);
+        pool.parallel_for(0, triangles, mesh_grain, [&](size_t first, size_t last)
+        {
+            for (size_t t(first); t < last; ++t)
+            {
+                const uint32_t* corner(&indices_[3 * t]);
+                const vec3 p0(positions[corner[0]].get_coordinates());
+                const vec3 e1(subtract(positions[corner[1]].get_coordinates(), p0));
+                const vec3 e2(subtract(positions[corner[2]].get_coordinates(), p0));
+                const array<float, 2> uv0(uvs[corner[0]].get_coordinates());
+                const array<float, 2> uv1(uvs[corner[1]].get_coordinates());
+                const array<float, 2> uv2(uvs[corner[2]].get_coordinates());
+                const float s1(uv1[0] - uv0[0]), t1(uv1[1] - uv0[1]);
+                const float s2(uv2[0] - uv0[0]), t2(uv2[1] - uv0[1]);
+
+                const float determinant(s1 * t2 - s2 * t1);
+                array<vec3, 2>& axes(face_axes[t]);
+                if (determinant == 0.0f)
+                {
+                    axes = {};
+                    continue;
+                }
+                const float r(1.0f / determinant);
+                for (size_t i(0); i < 3; ++i)
+                {
+                    axes[0][i] = (e1[i] * t2 - e2[i] * t1) * r;
+                    axes[1][i] = (e2[i] * s1 - e1[i] * s2) * r;
+                }
+            }
+        });
+
+        const vertex_triangles adjacency(gather_triangles(indices_, normals.size()));
+        tangents_.resize(normals.size());
+        pool.parallel_for(0, normals.size(), mesh_grain, [&](size_t first, size_t last)
+        {
+            for (size_t v(first); v < last; ++v)
+            {
+                vec3 s({0.0f, 0.0f, 0.0f}), t({0.0f, 0.0f, 0.0f});
+                for (uint32_t k(adjacency.offsets[v]); k < adjacency.offsets[v + 1]; ++k)
+                {
+                    const array<vec3, 2>& axes(face_axes[adjacency.triangles[k]]);
+                    for (size_t i(0); i < 3; ++i)
+                    {
+                        s[i] += axes[0][i];
+                        t[i] += axes[1][i];
+                    }
+                }
+
+                // Gram-Schmidt against the normal, handedness from the accumulated t axis
+                const vec3 n(normals[v].get_coordinates());
+                const float projection(dot(n, s));
+                const vec3 tangent(normalized(vec3{s[0] - n[0] * projection, s[1] - n[1] * projection,
+                                               s[2] - n[2] * projection}));
+                const float handedness(dot(cross(n, tangent), t) < 0.0f ? -1.0f : 1.0f);
+                tangents_[v] = point<float, 4>({tangent[0], tangent[1], tangent[2], handedness});
+            }
+        });
+    }
+
+    void mesh::optimize_vertex_cache(size_t cache_size)
+    {
+        if (cache_size < 4)
+            throw invalid_argument("Cache size must be at least 4");
+        const size_t triangles(triangle_count());
+        const size_t vertices(vertex_count());
+        if (triangles == 0)
+            return;
+
+        vertex_triangles adjacency(gather_triangles(indices_, vertices));
+        // the not yet emitted triangles of vertex v are the first remaining[v] entries of its range
+        vector<uint32_t> remaining(vertices);
+        for (size_t v(0); v < vertices; ++v)
+            remaining[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+
+        vector<int> cache_position(vertices, -1);
+        vector<float> score(vertices);
+        for (size_t v(0); v < vertices; ++v)
+            score[v] = vertex_score(-1, remaining[v], cache_size);
+
+        vector<float> triangle_score(triangles);
+        for (size_t t(0); t < triangles; ++t)
+            triangle_score[t] = score[indices_[3 * t]] + score[indices_[3 * t + 1]] + score[indices_[3 * t + 2]];
+
+        vector<bool> emitted(triangles, false);
+        vector<uint32_t> result;
+        result.reserve(indices_.size());
+
+        // three extra slots hold the vertices pushed out of the cache by the last triangle
+        vector<uint32_t> cache, next_cache;
+        cache.reserve(cache_size + 3);
+        next_cache.reserve(cache_size + 3);
+
+        size_t best(0), scan(0);
+        for (size_t t(1); t < triangles; ++t)
+            if (triangle_score[t] > triangle_score[best])
+                best = t;
+
+        while (true)
+        {
+            emitted[best] = true;
+            const uint32_t* corner(&indices_[3 * best]);
+            result.insert(result.end(), corner, corner + 3);
+
+            next_cache.assign(corner, corner + 3);
+            for (size_t c(0); c < 3; ++c)
+            {
+                // drop the triangle from the live part of the vertex's range
+                const uint32_t v(corner[c]);
+                uint32_t* first(&adjacency.triangles[adjacency.offsets[v]]);
+                uint32_t* position(find(first, first + remaining[v], uint32_t(best)));
+                swap(*position, first[--remaining[v]]);
+            }
+            for (uint32_t v : cache)
+                if (v != corner[0] && v != corner[1] && v != corner[2])
+                    next_cache.push_back(v);
+            if (next_cache.size() > cache_size + 3)
+                next_cache.resize(cache_size + 3);
+            swap(cache, next_cache);
+
+            // rescore the vertices that entered, moved in or left the cache, then their live triangles
+            for (uint32_t v : next_cache)
+                cache_position[v] = -1;
+            for (size_t i(0); i < cache.size(); ++i)
+                cache_position[cache[i]] = i < cache_size ? int(i) : -1;
+            for (const vector<uint32_t>* touched : {&cache, &next_cache})
+                for (uint32_t v : *touched)
+                    score[v] = vertex_score(cache_position[v], remaining[v], cache_size);
+            for (const vector<uint32_t>* touched : {&cache, &next_cache})
+                for (uint32_t v : *touched)
+                    for (uint32_t k(0); k < remaining[v]; ++k)
+                    {
+                        const uint32_t t(adjacency.triangles[adjacency.offsets[v] + k]);
+                        const uint32_t* other(&indices_[3 * t]);
+                        triangle_score[t] = score[other[0]] + score[other[1]] + score[other[2]];
+                    }
+
+            float best_score(-1.0f);
+            best = triangles;
+            for (uint32_t v : cache)
+                for (uint32_t k(0); k < remaining[v]; ++k)
+                {
+                    const uint32_t t(adjacency.triangles[adjacency.offsets[v] + k]);
+                    if (triangle_score[t] > best_score)
+                    {
+                        best_score = triangle_score[t];
+                        best = t;
+                    }
+                }
+
+            if (best == triangles)
+            {
+                // nothing left around the cache, continue with the next unused triangle
+                while (scan < triangles && emitted[scan])
+                    ++scan;
+                if (scan == triangles)
+                    break;
+                best = scan;
+            }
+        }
+        indices_ = move(result);
+    }
+
+    void mesh::transform(const matrix<float, 4, 4>& transformation, thread_pool& pool)
+    {
+        const matrix<float, 4, 4>& m(transformation);
+
+        // cofactors of the upper 3x3 part, the inverse transpose scaled by the determinant
+        array<array<float, 3>, 3> normal_matrix;
+        for (size_t r(0); r < 3; ++r)
+            for (size_t c(0); c < 3; ++c)
+            {
+                const size_t r1((r + 1) % 3), r2((r + 2) % 3);
+                const size_t c1((c + 1) % 3), c2((c + 2) % 3);
+                normal_matrix[r][c] = m(r1, c1) * m(r2, c2) - m(r1, c2) * m(r2, c1);
+            }
+        const float determinant(m(0, 0) * normal_matrix[0][0] + m(0, 1) * normal_matrix[0][1] +
+                                m(0, 2) * normal_matrix[0][2]);
+        // a mirroring transform flips the cross product, so the bitangent sign flips with it
+        const float handedness(determinant < 0.0f ? -1.0f : 1.0f);
+        if (determinant < 0.0f)
+            for (auto& row : normal_matrix)
+                for (float& value : row)
+                    value = -value;
+
+        auto positions(this->positions());
+        auto normals(this->normals());
+        pool.parallel_for(0, positions.size(), mesh_grain, [&](size_t first, size_t last)
+        {
+            for (size_t v(first); v < last; ++v)
+            {
+                const vec3 p(positions[v].get_coordinates());
+                array<float, 4> q;
+                for (size_t r(0); r < 4; ++r)
+                    q[r] = m(r, 0) * p[0] + m(r, 1) * p[1] + m(r, 2) * p[2] + m(r, 3);
+                if (q[3] != 0.0f && q[3] != 1.0f)
+                    for (size_t r(0); r < 3; ++r)
+                        q[r] /= q[3];
+                positions[v] = point<float, 3>({q[0], q[1], q[2]});
+
+                const vec3 n(normals[v].get_coordinates());
+                vec3 transformed;
+                for (size_t r(0); r < 3; ++r)
+                    transformed[r] = dot(normal_matrix[r], n);
+                normals[v] = point<float, 3>(normalized(transformed));
+
+                if (!tangents_.empty())
+                {
+                    const array<float, 4> t(tangents_[v].get_coordinates());
+                    vec3 tangent;
+                    for (size_t r(0); r < 3; ++r)
+                        tangent[r] = m(r, 0) * t[0] + m(r, 1) * t[1] + m(r, 2) * t[2];
+                    tangent = normalized(tangent);
+                    tangents_[v] = point<float, 4>({tangent[0], tangent[1], tangent[2], t[3] * handedness});
+                }
+            }
+        });
+    }
+
+    float average_cache_miss_ratio(const vector<uint32_t>& indices, size_t vertex_count, size_t cache_size)
+    {
+        if (indices.size() < 3 || cache_size == 0)
+            return 0.0f;
+        // loaded[v] numbers the miss that brought v in, it stays cached for cache_size more misses
+        vector<size_t> loaded(vertex_count, 0);
+        size_t misses(0);
+        for (uint32_t index : indices)
+            if (loaded[index] == 0 || misses - loaded[index] >= cache_size)
+                loaded[index] = ++misses;
+        return float(misses) / float(indices.size() / 3);
+    }
+} // engine_lib
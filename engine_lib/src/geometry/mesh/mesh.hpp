@@ -0,0 +1,251 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef MESH_HPP
+#define MESH_HPP
+#include "../../includes.hpp"
+#include "../../containers/strided_view/strided_view.hpp"
+#include "../../math/direction/direction.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief One vertex of an interleaved vertex buffer.
+     */
+    struct vertex
+    {
+        point<float, 3> position; //!< Position in model space.
+        point<float, 3> normal; //!< Unit normal, zero until assigned or generated.
+        point<float, 2> uv; //!< Texture coordinates.
+    };
+
+    static_assert(is_trivially_copyable_v<vertex>, "vertex buffers are copied and mapped as raw memory");
+    static_assert(sizeof(vertex) == 8 * sizeof(float), "vertex records hold eight tightly packed floats");
+
+    /**
+     * @brief Memory layout of the vertex attributes of a mesh.
+     */
+    enum class vertex_layout
+    {
+        interleaved, //!< One array of vertex records (array of structures).
+        separate //!< One array per attribute (structure of arrays).
+    };
+
+    /**
+     * @class mesh
+     * @brief Indexed triangle mesh with positions, normals and texture coordinates.
+     *
+     * The attributes are stored either interleaved or as separate arrays. The accessors
+     * return strided views, so algorithms run on both layouts without copying, and
+     * convert_layout() switches between them when a consumer needs a specific one.
+     * Tangents are derived data and always live in their own array.
+     *
+     * @throws out_of_range If a triangle references a vertex that does not exist.
+     */
+    class mesh
+    {
+        vertex_layout layout_; /// Layout of the vertex attributes.
+        vector<vertex> vertices_; /// Attributes in the interleaved layout.
+        vector<point<float, 3>> positions_; /// Positions in the separate layout.
+        vector<point<float, 3>> normals_; /// Normals in the separate layout.
+        vector<point<float, 2>> uvs_; /// Texture coordinates in the separate layout.
+        vector<point<float, 4>> tangents_; /// Tangents with the bitangent sign in w, empty until generated.
+        vector<uint32_t> indices_; /// Three vertex indices per triangle.
+
+    public:
+        /**
+         * @brief Creates an empty mesh.
+         *
+         * @param layout Layout of the vertex attributes.
+         */
+        explicit mesh(vertex_layout layout = vertex_layout::interleaved);
+
+        /**
+         * @brief Creates an interleaved mesh from existing buffers.
+         *
+         * @param vertices The vertex records.
+         * @param indices Three indices per triangle.
+         * @throws invalid_argument If the index count is not a multiple of three.
+         * @throws out_of_range If an index is not below the number of vertices.
+         */
+        mesh(vector<vertex> vertices, vector<uint32_t> indices);
+
+        /**
+         * @brief Returns the layout of the vertex attributes.
+         *
+         * @return The current layout.
+         */
+        [[nodiscard]] vertex_layout layout() const;
+
+        /**
+         * @brief Returns the number of vertices.
+         *
+         * @return Number of vertices.
+         */
+        [[nodiscard]] size_t vertex_count() const;
+
+        /**
+         * @brief Returns the number of triangles.
+         *
+         * @return Number of triangles.
+         */
+        [[nodiscard]] size_t triangle_count() const;
+
+        /**
+         * @brief Reserves storage for the given number of vertices and triangles.
+         *
+         * @param vertices Expected number of vertices.
+         * @param triangles Expected number of triangles.
+         */
+        void reserve(size_t vertices, size_t triangles);
+
+        /**
+         * @brief Appends a vertex.
+         *
+         * @param position Vertex position.
+         * @param normal Vertex normal, only its coordinates are stored.
+         * @param uv Texture coordinates.
+         * @return Index of the new vertex.
+         */
+        uint32_t add_vertex(const point<float, 3>& position,
+                            const direction<float, 3>& normal = direction<float, 3>(),
+                            const point<float, 2>& uv = point<float, 2>());
+
+        /**
+         * @brief Appends a triangle with counter-clockwise winding.
+         *
+         * @param a First vertex index.
+         * @param b Second vertex index.
+         * @param c Third vertex index.
+         * @throws out_of_range If an index is not below vertex_count().
+         */
+        void add_triangle(uint32_t a, uint32_t b, uint32_t c);
+
+        /**
+         * @brief Returns a copy of all attributes of one vertex.
+         *
+         * @param index Vertex index.
+         * @return The vertex.
+         * @throws out_of_range If the index is not below vertex_count().
+         */
+        [[nodiscard]] vertex get_vertex(size_t index) const;
+
+        /**
+         * @brief Returns the index buffer, three indices per triangle.
+         *
+         * @return The index buffer.
+         */
+        [[nodiscard]] const vector<uint32_t>& indices() const;
+
+        /**
+         * @brief Replaces the index buffer.
+         *
+         * @param indices Three indices per triangle.
+         * @throws invalid_argument If the size is not a multiple of three.
+         * @throws out_of_range If an index is not below vertex_count().
+         */
+        void set_indices(vector<uint32_t> indices);
+
+        /**
+         * @brief Returns the interleaved vertex records.
+         *
+         * @return The records, empty in the separate layout.
+         */
+        [[nodiscard]] const vector<vertex>& vertices() const;
+
+        strided_view<point<float, 3>> positions();
+        [[nodiscard]] strided_view<const point<float, 3>> positions() const;
+        strided_view<point<float, 3>> normals();
+        [[nodiscard]] strided_view<const point<float, 3>> normals() const;
+        strided_view<point<float, 2>> uvs();
+        [[nodiscard]] strided_view<const point<float, 2>> uvs() const;
+
+        /**
+         * @brief Returns the tangents, empty until generate_tangents() is called.
+         *
+         * The xyz part is the unit tangent, w is +1 or -1 and gives the bitangent as
+         * w * cross(normal, tangent).
+         *
+         * @return One tangent per vertex.
+         */
+        [[nodiscard]] const vector<point<float, 4>>& tangents() const;
+
+        /**
+         * @brief Rearranges the vertex attributes into the given layout.
+         *
+         * @param layout The new layout. Nothing happens if it is the current one.
+         */
+        void convert_layout(vertex_layout layout);
+
+        /**
+         * @brief Replaces the normals by area weighted averages of the adjacent face normals.
+         *
+         * Face normals are computed in parallel, then every vertex sums its faces in index
+         * order, so the result does not depend on the number of threads. Vertices without
+         * a non-degenerate face get a zero normal.
+         *
+         * @param pool Pool executing the passes.
+         */
+        void generate_normals(thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Computes per-vertex tangents from positions, normals and texture coordinates.
+         *
+         * Uses Lengyel's method: the per-face texture space axes are accumulated per vertex,
+         * orthogonalized against the normal and the handedness is stored in w.
+         *
+         * @param pool Pool executing the passes.
+         */
+        void generate_tangents(thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Reorders the triangles for the post-transform vertex cache.
+         *
+         * Implements Forsyth's linear-speed greedy optimization: vertices are scored by their
+         * position in a simulated LRU cache and by the number of triangles still using them,
+         * and the best scoring triangle around the cache is emitted next. Vertex order and
+         * triangle winding are preserved.
+         *
+         * @param cache_size Size of the simulated cache, at least 4.
+         * @throws invalid_argument If the cache size is below 4.
+         */
+        void optimize_vertex_cache(size_t cache_size = 32);
+
+        /**
+         * @brief Transforms positions, normals and tangents in place.
+         *
+         * Positions are multiplied as column vectors with w = 1 and divided by the resulting w
+         * when it is neither 0 nor 1. Normals are multiplied by the inverse transpose of the
+         * upper 3x3 part and renormalized, tangents by the upper 3x3 part.
+         *
+         * @param transformation Transformation matrix, translation in the last column.
+         * @param pool Pool executing the transform.
+         */
+        void transform(const matrix<float, 4, 4>& transformation, thread_pool& pool = thread_pool::global());
+    };
+
+    /**
+     * @brief Computes the average cache miss ratio of an index buffer.
+     *
+     * Simulates a FIFO post-transform cache and returns the number of vertex
+     * transformations per triangle, between 0.5 for ideal grids and 3.
+     *
+     * @param indices Three indices per triangle.
+     * @param vertex_count Number of vertices referenced by the indices.
+     * @param cache_size Size of the simulated cache.
+     * @return Cache misses per triangle, 0 for an empty buffer.
+     */
+    float average_cache_miss_ratio(const vector<uint32_t>& indices, size_t vertex_count, size_t cache_size = 32);
+} // engine_lib
+
+#endif //MESH_HPP
@@ -0,0 +1,538 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_lod.hpp"
+#include "../../math/quadric/quadric.hpp"
+#include "../../math/vector3/vector3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+
+namespace engine_lib
+{
+    namespace
+    {
+        using vec3 = array<double, 3>;
+
+        point<double, 3> to_point(const vec3& v)
+        {
+            return point<double, 3>(v);
+        }
+
+        // spreads the low 10 bits of a value to every third bit
+        uint32_t spread_bits(uint32_t value)
+        {
+            value &= 0x3FF;
+            value = (value | value << 16) & 0x030000FF;
+            value = (value | value << 8) & 0x0300F00F;
+            value = (value | value << 4) & 0x030C30C3;
+            value = (value | value << 2) & 0x09249249;
+            return value;
+        }
+
+        struct collapse
+        {
+            double cost; /// Error of the collapse.
+            uint32_t keep; /// Vertex that stays.
+            uint32_t remove; /// Vertex merged into it.
+            uint32_t keep_stamp; /// Versions of both vertices when the collapse was evaluated.
+            uint32_t remove_stamp;
+            vec3 target; /// Position of the merged vertex.
+
+            bool operator>(const collapse& other) const
+            {
+                if (cost != other.cost)
+                    return cost > other.cost;
+                return keep != other.keep ? keep > other.keep : remove > other.remove;
+            }
+        };
+
+        /*
+         * Simplifies the triangles of one cluster. Locked vertices never move or disappear; the
+         * others belong to this cluster only, so their positions are written back directly.
+         */
+        class cluster_simplifier
+        {
+            const lod_settings& settings_;
+            vector<uint32_t> globals_; /// Global index of every local vertex, sorted.
+            vector<vec3> positions_;
+            vector<quadric<double>> quadrics_;
+            vector<double> areas_; /// Face area behind every quadric, to turn costs into distances.
+            vector<bool> locked_;
+            vector<bool> removed_;
+            vector<uint32_t> stamps_;
+            vector<array<uint32_t, 3>> triangles_;
+            vector<bool> alive_;
+            vector<vector<uint32_t>> vertex_triangles_;
+            priority_queue<collapse, vector<collapse>, greater<collapse>> heap_;
+            size_t alive_count_;
+
+            uint32_t local(uint32_t global) const
+            {
+                return uint32_t(lower_bound(globals_.begin(), globals_.end(), global) - globals_.begin());
+            }
+
+            void neighbors(uint32_t vertex, vector<uint32_t>& result) const
+            {
+                result.clear();
+                for (const uint32_t t : vertex_triangles_[vertex])
+                    if (alive_[t])
+                        for (const uint32_t other : triangles_[t])
+                            if (other != vertex)
+                                result.push_back(other);
+                sort(result.begin(), result.end());
+                result.erase(unique(result.begin(), result.end()), result.end());
+            }
+
+            void evaluate(uint32_t a, uint32_t b)
+            {
+                if (locked_[a] && locked_[b])
+                    return;
+                // the locked vertex, or the smaller index for determinism, stays
+                uint32_t keep(min(a, b)), remove(max(a, b));
+                if (locked_[remove])
+                    swap(keep, remove);
+                const quadric<double> sum(quadrics_[keep] + quadrics_[remove]);
+                vec3 target(positions_[keep]);
+                if (!locked_[keep])
+                {
+                    // the optimum, unless it lies far outside the edge; otherwise the best endpoint or midpoint
+                    point<double, 3> optimum;
+                    const vec3 edge(subtract(positions_[remove], positions_[keep]));
+                    const double length(sqrt(dot(edge, edge)));
+                    bool near(sum.minimum(optimum));
+                    for (size_t axis(0); near && axis < 3; ++axis)
+                    {
+                        const double low(min(positions_[keep][axis], positions_[remove][axis]) - length);
+                        const double high(max(positions_[keep][axis], positions_[remove][axis]) + length);
+                        near = optimum.get_coordinates()[axis] >= low && optimum.get_coordinates()[axis] <= high;
+                    }
+                    if (near)
+                        target = optimum.get_coordinates();
+                    else
+                    {
+                        const vec3 middle{(positions_[keep][0] + positions_[remove][0]) / 2,
+                                          (positions_[keep][1] + positions_[remove][1]) / 2,
+                                          (positions_[keep][2] + positions_[remove][2]) / 2};
+                        double best(numeric_limits<double>::max());
+                        for (const vec3& candidate : {positions_[keep], positions_[remove], middle})
+                        {
+                            const double error(sum.error(to_point(candidate)));
+                            if (error < best)
+                            {
+                                best = error;
+                                target = candidate;
+                            }
+                        }
+                    }
+                }
+                const double area(max(areas_[keep] + areas_[remove], 1e-30));
+                const double cost(max(0.0, sum.error(to_point(target))) / area);
+                heap_.push({cost, keep, remove, stamps_[keep], stamps_[remove], target});
+            }
+
+            // refuses collapses that pinch the surface or flip or degenerate a face
+            bool allowed(const collapse& step, vector<uint32_t>& keep_ring, vector<uint32_t>& remove_ring) const
+            {
+                neighbors(step.keep, keep_ring);
+                neighbors(step.remove, remove_ring);
+                size_t shared_faces(0);
+                for (const uint32_t t : vertex_triangles_[step.remove])
+                    if (alive_[t] && find(triangles_[t].begin(), triangles_[t].end(), step.keep) != triangles_[t].end())
+                        ++shared_faces;
+                size_t common(0);
+                for (const uint32_t v : keep_ring)
+                    common += binary_search(remove_ring.begin(), remove_ring.end(), v) ? 1 : 0;
+                if (common != shared_faces)
+                    return false;
+
+                for (const uint32_t moved : {step.keep, step.remove})
+                    for (const uint32_t t : vertex_triangles_[moved])
+                    {
+                        const array<uint32_t, 3>& face(triangles_[t]);
+                        if (!alive_[t] || (find(face.begin(), face.end(), step.keep) != face.end() &&
+                                           find(face.begin(), face.end(), step.remove) != face.end()))
+                            continue;
+                        array<vec3, 3> corners{positions_[face[0]], positions_[face[1]], positions_[face[2]]};
+                        const vec3 before(cross(subtract(corners[1], corners[0]), subtract(corners[2], corners[0])));
+                        for (size_t k(0); k < 3; ++k)
+                            if (face[k] == moved)
+                                corners[k] = step.target;
+                        const vec3 after(cross(subtract(corners[1], corners[0]), subtract(corners[2], corners[0])));
+                        const double lengths(sqrt(dot(before, before) * dot(after, after)));
+                        if (lengths <= 0 || dot(before, after) < settings_.min_normal_dot * lengths)
+                            return false;
+                    }
+                return true;
+            }
+
+        public:
+            cluster_simplifier(const lod_settings& settings, const vector<uint32_t>& cluster,
+                               const vector<uint32_t>& indices, const vector<vec3>& positions,
+                               const vector<bool>& locked)
+                : settings_(settings), alive_count_(cluster.size())
+            {
+                for (const uint32_t t : cluster)
+                    for (size_t k(0); k < 3; ++k)
+                        globals_.push_back(indices[3 * t + k]);
+                sort(globals_.begin(), globals_.end());
+                globals_.erase(unique(globals_.begin(), globals_.end()), globals_.end());
+
+                const size_t count(globals_.size());
+                positions_.resize(count);
+                quadrics_.resize(count);
+                areas_.assign(count, 0);
+                locked_.resize(count);
+                removed_.assign(count, false);
+                stamps_.assign(count, 0);
+                vertex_triangles_.resize(count);
+                for (size_t v(0); v < count; ++v)
+                {
+                    positions_[v] = positions[globals_[v]];
+                    locked_[v] = locked[globals_[v]];
+                }
+                triangles_.reserve(cluster.size());
+                alive_.assign(cluster.size(), true);
+                for (const uint32_t t : cluster)
+                {
+                    const array<uint32_t, 3> face{local(indices[3 * t]), local(indices[3 * t + 1]),
+                                                  local(indices[3 * t + 2])};
+                    for (const uint32_t v : face)
+                        vertex_triangles_[v].push_back(uint32_t(triangles_.size()));
+                    triangles_.push_back(face);
+                }
+
+                // area weighted face planes
+                vector<array<uint32_t, 3>> edges;
+                for (size_t t(0); t < triangles_.size(); ++t)
+                {
+                    const array<uint32_t, 3>& face(triangles_[t]);
+                    const vec3 normal(cross(subtract(positions_[face[1]], positions_[face[0]]),
+                                            subtract(positions_[face[2]], positions_[face[0]])));
+                    const double length(sqrt(dot(normal, normal)));
+                    if (length > 0)
+                    {
+                        const vec3 unit{normal[0] / length, normal[1] / length, normal[2] / length};
+                        const double area(length / 2);
+                        const quadric<double> plane(quadric<double>::from_plane(
+                            unit[0], unit[1], unit[2], -dot(unit, positions_[face[0]]), area));
+                        for (const uint32_t v : face)
+                        {
+                            quadrics_[v] += plane;
+                            areas_[v] += area;
+                        }
+                    }
+                    for (size_t k(0); k < 3; ++k)
+                    {
+                        const uint32_t a(face[k]), b(face[(k + 1) % 3]);
+                        edges.push_back({min(a, b), max(a, b), uint32_t(t)});
+                    }
+                }
+
+                // edges of a single face are open borders or seams; a plane through them, perpendicular
+                // to the face, keeps them from sliding. Edges shared with other clusters have both ends locked.
+                sort(edges.begin(), edges.end());
+                size_t unique_edges(0);
+                for (size_t first(0), last(0); first < edges.size(); first = last)
+                {
+                    last = first;
+                    while (last < edges.size() && edges[last][0] == edges[first][0] && edges[last][1] == edges[first][1])
+                        ++last;
+                    const uint32_t a(edges[first][0]), b(edges[first][1]);
+                    if (last - first == 1 && !(locked_[a] && locked_[b]))
+                    {
+                        const array<uint32_t, 3>& face(triangles_[edges[first][2]]);
+                        const vec3 edge(subtract(positions_[b], positions_[a]));
+                        const vec3 normal(cross(subtract(positions_[face[1]], positions_[face[0]]),
+                                                subtract(positions_[face[2]], positions_[face[0]])));
+                        vec3 side(cross(edge, normal));
+                        const double length(sqrt(dot(side, side)));
+                        if (length > 0)
+                        {
+                            for (double& component : side)
+                                component /= length;
+                            const double weight(settings_.border_weight * dot(edge, edge));
+                            const quadric<double> plane(quadric<double>::from_plane(
+                                side[0], side[1], side[2], -dot(side, positions_[a]), weight));
+                            quadrics_[a] += plane;
+                            quadrics_[b] += plane;
+                        }
+                    }
+                    edges[unique_edges++] = edges[first];
+                }
+                // costs need the complete quadrics, so they come after every border plane
+                for (size_t e(0); e < unique_edges; ++e)
+                    evaluate(edges[e][0], edges[e][1]);
+            }
+
+            /* Collapses edges until target triangles are left; returns the largest cost taken. */
+            double run(size_t target)
+            {
+                double largest(0);
+                vector<uint32_t> keep_ring, remove_ring;
+                while (alive_count_ > target && !heap_.empty())
+                {
+                    const collapse step(heap_.top());
+                    heap_.pop();
+                    if (removed_[step.keep] || removed_[step.remove] || stamps_[step.keep] != step.keep_stamp ||
+                        stamps_[step.remove] != step.remove_stamp)
+                        continue;
+                    if (!allowed(step, keep_ring, remove_ring))
+                        continue;
+
+                    largest = max(largest, step.cost);
+                    positions_[step.keep] = step.target;
+                    quadrics_[step.keep] += quadrics_[step.remove];
+                    areas_[step.keep] += areas_[step.remove];
+                    removed_[step.remove] = true;
+                    ++stamps_[step.keep];
+                    for (const uint32_t t : vertex_triangles_[step.remove])
+                    {
+                        if (!alive_[t])
+                            continue;
+                        array<uint32_t, 3>& face(triangles_[t]);
+                        if (find(face.begin(), face.end(), step.keep) != face.end())
+                        {
+                            alive_[t] = false;
+                            --alive_count_;
+                            continue;
+                        }
+                        replace(face.begin(), face.end(), step.remove, step.keep);
+                        vertex_triangles_[step.keep].push_back(t);
+                    }
+                    // the ring of the kept vertex changed, so does the cost of every edge around it
+                    neighbors(step.keep, keep_ring);
+                    for (const uint32_t v : keep_ring)
+                        evaluate(step.keep, v);
+                }
+                return largest;
+            }
+
+            /* Appends the surviving triangles in their original order and writes the moved vertices back. */
+            void write(vector<uint32_t>& indices, vector<vec3>& positions) const
+            {
+                for (size_t t(0); t < triangles_.size(); ++t)
+                    if (alive_[t])
+                        for (const uint32_t v : triangles_[t])
+                            indices.push_back(globals_[v]);
+                for (size_t v(0); v < globals_.size(); ++v)
+                    if (!locked_[v] && !removed_[v])
+                        positions[globals_[v]] = positions_[v];
+            }
+        };
+
+        // triangles sorted along a Morton curve of their centroids, cut into runs of at most cluster_size
+        vector<vector<uint32_t>> make_clusters(const vector<uint32_t>& indices, const vector<vec3>& positions,
+                                               size_t cluster_size)
+        {
+            const size_t triangles(indices.size() / 3);
+            vec3 low{numeric_limits<double>::max(), numeric_limits<double>::max(), numeric_limits<double>::max()};
+            vec3 high{-low[0], -low[1], -low[2]};
+            for (const uint32_t v : indices)
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    low[axis] = min(low[axis], positions[v][axis]);
+                    high[axis] = max(high[axis], positions[v][axis]);
+                }
+            vector<pair<uint32_t, uint32_t>> keys(triangles);
+            for (size_t t(0); t < triangles; ++t)
+            {
+                uint32_t code(0);
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    const double centroid((positions[indices[3 * t]][axis] + positions[indices[3 * t + 1]][axis] +
+                                           positions[indices[3 * t + 2]][axis]) / 3);
+                    const double extent(high[axis] - low[axis]);
+                    const double unit(extent > 0 ? (centroid - low[axis]) / extent : 0);
+                    code |= spread_bits(uint32_t(min(unit * 1023.0, 1023.0))) << axis;
+                }
+                keys[t] = {code, uint32_t(t)};
+            }
+            sort(keys.begin(), keys.end());
+            // evenly sized, so no small remainder cluster made mostly of locked border
+            const size_t count((triangles + cluster_size - 1) / cluster_size);
+            vector<vector<uint32_t>> clusters(count);
+            for (size_t i(0); i < triangles; ++i)
+                clusters[i * count / triangles].push_back(keys[i].second);
+            return clusters;
+        }
+    }
+
+    lod_level simplify_mesh(const mesh& source, size_t target_triangles, const lod_settings& settings, thread_pool& pool)
+    {
+        if (settings.cluster_triangles == 0)
+            throw invalid_argument("Clusters need at least one triangle");
+        const size_t vertex_count(source.vertex_count());
+        vector<vec3> positions(vertex_count);
+        const strided_view<const point<float, 3>> source_positions(source.positions());
+        for (size_t v(0); v < vertex_count; ++v)
+            for (size_t axis(0); axis < 3; ++axis)
+                positions[v][axis] = source_positions[v].get_coordinates()[axis];
+        vector<uint32_t> indices(source.indices());
+
+        double largest(0);
+        size_t cluster_size(settings.cluster_triangles);
+        while (indices.size() / 3 > target_triangles)
+        {
+            const size_t before(indices.size() / 3);
+            const vector<vector<uint32_t>> clusters(make_clusters(indices, positions, cluster_size));
+
+            // vertices of several clusters stay where they are during this pass
+            vector<int64_t> owner(vertex_count, -1);
+            for (size_t c(0); c < clusters.size(); ++c)
+                for (const uint32_t t : clusters[c])
+                    for (size_t k(0); k < 3; ++k)
+                    {
+                        int64_t& first(owner[indices[3 * t + k]]);
+                        first = first == -1 || first == int64_t(c) ? int64_t(c) : -2;
+                    }
+            vector<bool> locked(vertex_count);
+            for (size_t v(0); v < vertex_count; ++v)
+                locked[v] = owner[v] == -2;
+
+            // every cluster keeps the same share of its triangles, but at least half of them: the locked
+            // cluster borders move between passes, and pushing a cluster far below its border forces costly collapses
+            const double keep(max(double(target_triangles) / double(before), clusters.size() > 1 ? 0.5 : 0.0));
+            vector<vector<uint32_t>> results(clusters.size());
+            vector<double> costs(clusters.size(), 0);
+            pool.parallel_for(0, clusters.size(), 1, [&](size_t first, size_t last)
+            {
+                for (size_t c(first); c < last; ++c)
+                {
+                    cluster_simplifier simplifier(settings, clusters[c], indices, positions, locked);
+                    costs[c] = simplifier.run(size_t(ceil(double(clusters[c].size()) * keep)));
+                    simplifier.write(results[c], positions);
+                }
+            });
+
+            indices.clear();
+            for (size_t c(0); c < clusters.size(); ++c)
+            {
+                indices.insert(indices.end(), results[c].begin(), results[c].end());
+                largest = max(largest, costs[c]);
+            }
+            // one cluster over everything has no locked vertices left to free
+            if (indices.size() / 3 == before && clusters.size() == 1)
+                break;
+            cluster_size *= 2;
+        }
+
+        // only referenced vertices are kept, in their original order
+        vector<uint32_t> remap(vertex_count, UINT32_MAX);
+        for (const uint32_t v : indices)
+            remap[v] = 0;
+        vector<vertex> vertices;
+        for (size_t v(0); v < vertex_count; ++v)
+            if (remap[v] == 0)
+            {
+                remap[v] = uint32_t(vertices.size());
+                vertex record(source.get_vertex(v));
+                record.position = point<float, 3>(array<float, 3>{float(positions[v][0]), float(positions[v][1]),
+                                                                  float(positions[v][2])});
+                vertices.push_back(record);
+            }
+        for (uint32_t& v : indices)
+            v = remap[v];
+
+        lod_level result{mesh(move(vertices), move(indices)), float(sqrt(largest))};
+        result.geometry.convert_layout(source.layout());
+        return result;
+    }
+
+    lod_chain::lod_chain(const mesh& source, const lod_settings& settings, thread_pool& pool)
+        : radius_(0)
+    {
+        for (size_t i(0); i < settings.ratios.size(); ++i)
+            if (!(settings.ratios[i] > 0 && settings.ratios[i] < 1) || (i > 0 && settings.ratios[i] >= settings.ratios[i - 1]))
+                throw invalid_argument("LOD ratios must decrease within (0, 1)");
+
+        // bounding sphere around the center of the bounding box
+        const strided_view<const point<float, 3>> positions(source.positions());
+        array<float, 3> low{}, high{};
+        for (size_t v(0); v < source.vertex_count(); ++v)
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                const float coordinate(positions[v].get_coordinates()[axis]);
+                low[axis] = v == 0 ? coordinate : min(low[axis], coordinate);
+                high[axis] = v == 0 ? coordinate : max(high[axis], coordinate);
+            }
+        array<float, 3> center{};
+        for (size_t axis(0); axis < 3; ++axis)
+            center[axis] = (low[axis] + high[axis]) / 2;
+        center_ = point<float, 3>(center);
+        for (size_t v(0); v < source.vertex_count(); ++v)
+        {
+            float squared(0);
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                const float d(positions[v].get_coordinates()[axis] - center[axis]);
+                squared += d * d;
+            }
+            radius_ = max(radius_, sqrt(squared));
+        }
+
+        levels_.push_back({source, 0});
+        for (const float ratio : settings.ratios)
+        {
+            const auto target(max<size_t>(1, size_t(double(ratio) * double(source.triangle_count()))));
+            lod_level next(simplify_mesh(levels_.back().geometry, target, settings, pool));
+            if (next.geometry.triangle_count() >= levels_.back().geometry.triangle_count())
+                break;
+            next.error = max(next.error, levels_.back().error);
+            levels_.push_back(move(next));
+        }
+    }
+
+    float lod_chain::projected_error(size_t level, const matrix<float, 4, 4>& model_view_projection,
+                                     float viewport_height) const
+    {
+        const float error(levels_.at(level).error);
+        const array<float, 3>& center(center_.get_coordinates());
+        float w(model_view_projection(3, 3)), w_scale(0), y_scale(0);
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            w += model_view_projection(3, axis) * center[axis];
+            w_scale += model_view_projection(3, axis) * model_view_projection(3, axis);
+            y_scale += model_view_projection(1, axis) * model_view_projection(1, axis);
+        }
+        // clip w grows with depth; the nearest point of the sphere sees the error largest
+        const float nearest(w - radius_ * sqrt(w_scale));
+        if (nearest <= 0)
+            return numeric_limits<float>::infinity();
+        return error * sqrt(y_scale) / nearest * viewport_height / 2;
+    }
+
+    size_t lod_chain::select(const matrix<float, 4, 4>& model_view_projection, float viewport_height,
+                             float pixel_error) const
+    {
+        for (size_t level(levels_.size() - 1); level > 0; --level)
+            if (projected_error(level, model_view_projection, viewport_height) <= pixel_error)
+                return level;
+        return 0;
+    }
+
+    const lod_level& lod_chain::level(size_t index) const
+    {
+        return levels_.at(index);
+    }
+
+    size_t lod_chain::size() const
+    {
+        return levels_.size();
+    }
+
+    const point<float, 3>& lod_chain::center() const
+    {
+        return center_;
+    }
+
+    float lod_chain::radius() const
+    {
+        return radius_;
+    }
+} // engine_lib
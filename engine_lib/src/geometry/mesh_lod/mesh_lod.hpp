@@ -0,0 +1,129 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef MESH_LOD_HPP
+#define MESH_LOD_HPP
+#include "../../includes.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+#include "../mesh/mesh.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Settings of the mesh simplifier.
+     */
+    struct lod_settings
+    {
+        vector<float> ratios{0.5f, 0.25f, 0.125f, 0.0625f}; /// Triangles of every level after the source, as a decreasing fraction of the source.
+        size_t cluster_triangles = 4096; /// Triangles per cluster simplified in parallel.
+        float border_weight = 10; /// Weight of the planes keeping open borders and seams in place.
+        float min_normal_dot = 0.2f; /// Smallest cosine between a face normal before and after a collapse.
+    };
+
+    /**
+     * @brief One level of detail.
+     */
+    struct lod_level
+    {
+        mesh geometry; /// The simplified mesh.
+        float error = 0; /// Estimated distance to the source surface, in model units.
+    };
+
+    /**
+     * @brief Simplifies a mesh by quadric error metric edge collapses.
+     *
+     * The triangles are sorted along a Morton curve of their centroids and cut into clusters
+     * that are simplified in parallel, each with the vertices it shares with other clusters
+     * locked. Passes with clusters twice as large follow until the target is reached or
+     * nothing collapses any more, so the locked borders move between passes. Every vertex
+     * carries the quadric of its faces, weighted by area, plus constraint planes along open
+     * borders; the cheapest edge collapses first, into the point minimizing the summed
+     * quadric. Collapses that flip a face or pinch the surface are refused. The kept vertex
+     * keeps its normal and texture coordinates. The result does not depend on the thread count.
+     *
+     * @param source The mesh.
+     * @param target_triangles Triangle count to reach if the surface allows it.
+     * @param settings Settings; ratios are ignored.
+     * @param pool Pool simplifying the clusters.
+     * @return The simplified mesh and its error, the root mean square distance of the worst collapse.
+     * @throws invalid_argument If the cluster size is zero.
+     */
+    lod_level simplify_mesh(const mesh& source, size_t target_triangles, const lod_settings& settings = {},
+                            thread_pool& pool = thread_pool::global());
+
+    /**
+     * @class lod_chain
+     * @brief A mesh and its simplified levels, chosen at runtime by projected screen-space error.
+     */
+    class lod_chain
+    {
+        vector<lod_level> levels_; /// Levels from the source to the coarsest.
+        point<float, 3> center_; /// Center of the bounding sphere.
+        float radius_; /// Radius of the bounding sphere.
+
+    public:
+        /**
+         * @brief Builds the chain, each level simplified from the one before.
+         *
+         * Levels that cannot remove any triangle are left out, so the chain may be shorter
+         * than the ratio list. The errors never decrease along the chain.
+         *
+         * @param source The full detail mesh, level 0.
+         * @param settings Settings.
+         * @param pool Pool simplifying the clusters.
+         * @throws invalid_argument If the ratios are not decreasing within (0, 1).
+         */
+        explicit lod_chain(const mesh& source, const lod_settings& settings = {},
+                           thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Projects the error of a level to pixels at the nearest point of the bounding sphere.
+         *
+         * The pixels per model unit come from the y row of the matrix and the clip w of the
+         * nearest point, which covers perspective and orthographic projections.
+         *
+         * @param level The level.
+         * @param model_view_projection Model to clip space transformation.
+         * @param viewport_height Height of the viewport in pixels.
+         * @return The error in pixels, infinite if the camera is inside the bounding sphere.
+         * @throws out_of_range If the level does not exist.
+         */
+        [[nodiscard]] float projected_error(size_t level, const matrix<float, 4, 4>& model_view_projection,
+                                            float viewport_height) const;
+
+        /**
+         * @brief Picks the coarsest level whose projected error stays below a pixel threshold.
+         *
+         * @param model_view_projection Model to clip space transformation.
+         * @param viewport_height Height of the viewport in pixels.
+         * @param pixel_error Largest acceptable error in pixels.
+         * @return Index of the level.
+         */
+        [[nodiscard]] size_t select(const matrix<float, 4, 4>& model_view_projection, float viewport_height,
+                                    float pixel_error = 1) const;
+
+        /**
+         * @brief Returns a level.
+         *
+         * @param index Index of the level, 0 for the source.
+         * @return The level.
+         * @throws out_of_range If the level does not exist.
+         */
+        [[nodiscard]] const lod_level& level(size_t index) const;
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] const point<float, 3>& center() const;
+        [[nodiscard]] float radius() const;
+    };
+} // engine_lib
+
+#endif //MESH_LOD_HPP
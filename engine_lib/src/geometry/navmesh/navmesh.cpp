@@ -0,0 +1,691 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "navmesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr float pi(3.14159265358979f);
+        constexpr uint32_t no_node(UINT32_MAX);
+        // key of a fresh chain slot holding nothing to cache
+        constexpr uint64_t no_chain(UINT64_MAX);
+        // points this far outside a triangle in the xz plane, relative to its size, still lie on it
+        constexpr float locate_tolerance(1e-4f);
+
+        array<float, 3> operator-(const array<float, 3>& a, const array<float, 3>& b)
+        {
+            return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+        }
+
+        float distance(const array<float, 3>& a, const array<float, 3>& b)
+        {
+            const auto d(a - b);
+            return sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        }
+
+        // twice the signed area of abc in the xz plane, positive if c lies right of the ray from a to b
+        float area_xz(const array<float, 3>& a, const array<float, 3>& b, const array<float, 3>& c)
+        {
+            return (c[0] - a[0]) * (b[2] - a[2]) - (b[0] - a[0]) * (c[2] - a[2]);
+        }
+
+        array<float, 3> coordinates(const point<float, 3>& p)
+        {
+            return p.get_coordinates();
+        }
+
+        // binary heap of (estimate, node) pairs; every node records its heap index for decrease-key
+        template <class N>
+        void sift_up(vector<pair<float, uint32_t>>& heap, vector<N>& nodes, size_t i)
+        {
+            const auto entry(heap[i]);
+            while (i > 0)
+            {
+                const size_t parent((i - 1) / 2);
+                if (heap[parent].first <= entry.first)
+                    break;
+                heap[i] = heap[parent];
+                nodes[heap[i].second].heap_position = uint32_t(i);
+                i = parent;
+            }
+            heap[i] = entry;
+            nodes[entry.second].heap_position = uint32_t(i);
+        }
+
+        template <class N>
+        void sift_down(vector<pair<float, uint32_t>>& heap, vector<N>& nodes, size_t i)
+        {
+            const auto entry(heap[i]);
+            while (true)
+            {
+                size_t child(2 * i + 1);
+                if (child >= heap.size())
+                    break;
+                if (child + 1 < heap.size() && heap[child + 1].first < heap[child].first)
+                    ++child;
+                if (entry.first <= heap[child].first)
+                    break;
+                heap[i] = heap[child];
+                nodes[heap[i].second].heap_position = uint32_t(i);
+                i = child;
+            }
+            heap[i] = entry;
+            nodes[entry.second].heap_position = uint32_t(i);
+        }
+
+        template <class N>
+        uint32_t pop(vector<pair<float, uint32_t>>& heap, vector<N>& nodes)
+        {
+            const uint32_t top(heap[0].second);
+            heap[0] = heap.back();
+            heap.pop_back();
+            if (!heap.empty())
+                sift_down(heap, nodes, 0);
+            nodes[top].heap_position = no_node;
+            return top;
+        }
+    }
+
+    navmesh::navmesh(const mesh& level, const navmesh_settings& settings)
+        : grid_origin_{0, 0}, grid_cell_(1), grid_size_{1, 1}
+    {
+        if (!(settings.max_slope >= 0 && settings.max_slope < 90) || !(settings.weld_distance > 0)
+            || settings.region_triangles == 0)
+            throw invalid_argument("Navmesh settings out of range");
+
+        // weld by sorting the vertices by their quantized position
+        const strided_view<const point<float, 3>> positions(level.positions());
+        const size_t count(level.vertex_count());
+        vector<array<int64_t, 3>> cells(count);
+        vector<uint32_t> order(count);
+        for (size_t v(0); v < count; ++v)
+        {
+            const auto p(positions[v].get_coordinates());
+            for (size_t axis(0); axis < 3; ++axis)
+                cells[v][axis] = int64_t(floor(double(p[axis]) / settings.weld_distance));
+            order[v] = uint32_t(v);
+        }
+        stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return cells[a] < cells[b]; });
+        vector<uint32_t> welded(count);
+        for (size_t i(0); i < count; ++i)
+        {
+            if (i == 0 || cells[order[i]] != cells[order[i - 1]])
+                vertices_.push_back(positions[order[i]].get_coordinates());
+            welded[order[i]] = uint32_t(vertices_.size() - 1);
+        }
+
+        const float min_up(cos(settings.max_slope * pi / 180));
+        const vector<uint32_t>& indices(level.indices());
+        for (size_t t(0); t + 2 < indices.size(); t += 3)
+        {
+            const array<uint32_t, 3> corners{welded[indices[t]], welded[indices[t + 1]], welded[indices[t + 2]]};
+            if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0])
+                continue;
+            const auto u(vertices_[corners[1]] - vertices_[corners[0]]);
+            const auto v(vertices_[corners[2]] - vertices_[corners[0]]);
+            const array<float, 3> normal{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+            const float length(sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]));
+            if (length > 0 && normal[1] >= min_up * length)
+                triangles_.push_back(corners);
+        }
+        if (triangles_.empty())
+            throw invalid_argument("Level has no walkable triangles");
+        if (triangles_.size() >= no_triangle)
+            throw invalid_argument("Navmesh exceeds 32-bit triangle indices");
+
+        centers_.resize(triangles_.size());
+        for (size_t t(0); t < triangles_.size(); ++t)
+            for (size_t axis(0); axis < 3; ++axis)
+                centers_[t][axis] = (vertices_[triangles_[t][0]][axis] + vertices_[triangles_[t][1]][axis]
+                                     + vertices_[triangles_[t][2]][axis]) / 3;
+
+        // edges shared by exactly two triangles connect them
+        vector<pair<uint64_t, uint32_t>> edges;
+        edges.reserve(3 * triangles_.size());
+        for (size_t t(0); t < triangles_.size(); ++t)
+            for (size_t i(0); i < 3; ++i)
+            {
+                const uint32_t a(triangles_[t][i]), b(triangles_[t][(i + 1) % 3]);
+                edges.emplace_back(uint64_t(min(a, b)) << 32 | max(a, b), uint32_t(3 * t + i));
+            }
+        sort(edges.begin(), edges.end());
+        neighbors_.assign(triangles_.size(), {no_triangle, no_triangle, no_triangle});
+        for (size_t i(0); i < edges.size();)
+        {
+            size_t j(i + 1);
+            while (j < edges.size() && edges[j].first == edges[i].first)
+                ++j;
+            if (j - i == 2)
+            {
+                const uint32_t a(edges[i].second), b(edges[i + 1].second);
+                neighbors_[a / 3][a % 3] = b / 3;
+                neighbors_[b / 3][b % 3] = a / 3;
+            }
+            i = j;
+        }
+
+        // regions grow breadth first, so each is connected and roughly round
+        regions_.assign(triangles_.size(), no_node);
+        vector<uint32_t> queue, grown;
+        grown.reserve(triangles_.size());
+        for (size_t seed(0); seed < triangles_.size(); ++seed)
+        {
+            if (regions_[seed] != no_node)
+                continue;
+            const auto region(uint32_t(region_centers_.size()));
+            array<float, 3> sum{0, 0, 0};
+            queue.assign(1, uint32_t(seed));
+            regions_[seed] = region;
+            for (size_t k(0); k < queue.size() && k < settings.region_triangles; ++k)
+            {
+                const uint32_t t(queue[k]);
+                for (size_t axis(0); axis < 3; ++axis)
+                    sum[axis] += centers_[t][axis];
+                for (const uint32_t n : neighbors_[t])
+                    if (n != no_triangle && regions_[n] == no_node && queue.size() < settings.region_triangles)
+                    {
+                        regions_[n] = region;
+                        queue.push_back(n);
+                    }
+            }
+            const auto size(float(queue.size()));
+            region_centers_.push_back({sum[0] / size, sum[1] / size, sum[2] / size});
+            grown.insert(grown.end(), queue.begin(), queue.end());
+        }
+
+        // triangles are renumbered region by region, so a search stays within a few cache lines
+        vector<uint32_t> rank(triangles_.size());
+        for (size_t i(0); i < grown.size(); ++i)
+            rank[grown[i]] = uint32_t(i);
+        const auto permute([&](auto& values)
+        {
+            auto sorted(values);
+            for (size_t i(0); i < grown.size(); ++i)
+                sorted[i] = values[grown[i]];
+            values.swap(sorted);
+        });
+        permute(triangles_);
+        permute(centers_);
+        permute(regions_);
+        permute(neighbors_);
+        for (auto& across : neighbors_)
+            for (uint32_t& n : across)
+                if (n != no_triangle)
+                    n = rank[n];
+        // and vertices by their first use, dropping the ones no walkable triangle uses
+        vector<uint32_t> vertex_rank(vertices_.size(), no_node);
+        vector<array<float, 3>> used;
+        for (auto& corners : triangles_)
+            for (uint32_t& v : corners)
+            {
+                if (vertex_rank[v] == no_node)
+                {
+                    vertex_rank[v] = uint32_t(used.size());
+                    used.push_back(vertices_[v]);
+                }
+                v = vertex_rank[v];
+            }
+        vertices_.swap(used);
+        vector<pair<uint32_t, uint32_t>> links;
+        for (size_t t(0); t < triangles_.size(); ++t)
+            for (const uint32_t n : neighbors_[t])
+                if (n != no_triangle && regions_[n] != regions_[t])
+                    links.emplace_back(regions_[t], regions_[n]);
+        sort(links.begin(), links.end());
+        links.erase(unique(links.begin(), links.end()), links.end());
+        region_link_start_.assign(region_centers_.size() + 1, 0);
+        for (const auto& link : links)
+            ++region_link_start_[link.first + 1];
+        for (size_t r(0); r < region_centers_.size(); ++r)
+            region_link_start_[r + 1] += region_link_start_[r];
+        for (const auto& link : links)
+            region_links_.push_back(link.second);
+
+        // locator grid with about two triangles per cell
+        array<float, 2> upper{-numeric_limits<float>::max(), -numeric_limits<float>::max()};
+        grid_origin_ = {numeric_limits<float>::max(), numeric_limits<float>::max()};
+        for (const auto& corners : triangles_)
+            for (const uint32_t v : corners)
+                for (size_t axis(0); axis < 2; ++axis)
+                {
+                    grid_origin_[axis] = min(grid_origin_[axis], vertices_[v][2 * axis]);
+                    upper[axis] = max(upper[axis], vertices_[v][2 * axis]);
+                }
+        const float area(max((upper[0] - grid_origin_[0]) * (upper[1] - grid_origin_[1]), 1e-12f));
+        grid_cell_ = max(sqrt(2 * area / float(triangles_.size())), 1e-6f);
+        for (size_t axis(0); axis < 2; ++axis)
+            grid_size_[axis] = min<size_t>(size_t((upper[axis] - grid_origin_[axis]) / grid_cell_) + 1, 1 << 12);
+        grid_cell_ = max((upper[0] - grid_origin_[0]) / float(grid_size_[0]),
+                         (upper[1] - grid_origin_[1]) / float(grid_size_[1])) * (1 + 1e-5f) + 1e-6f;
+
+        const auto cell_range([&](size_t t)
+        {
+            array<size_t, 4> range{grid_size_[0], grid_size_[1], 0, 0};
+            for (const uint32_t v : triangles_[t])
+                for (size_t axis(0); axis < 2; ++axis)
+                {
+                    const auto cell(min(size_t((vertices_[v][2 * axis] - grid_origin_[axis]) / grid_cell_),
+                                        grid_size_[axis] - 1));
+                    range[axis] = min(range[axis], cell);
+                    range[axis + 2] = max(range[axis + 2], cell);
+                }
+            return range;
+        });
+        grid_start_.assign(grid_size_[0] * grid_size_[1] + 1, 0);
+        for (size_t t(0); t < triangles_.size(); ++t)
+        {
+            const auto range(cell_range(t));
+            for (size_t z(range[1]); z <= range[3]; ++z)
+                for (size_t x(range[0]); x <= range[2]; ++x)
+                    ++grid_start_[z * grid_size_[0] + x + 1];
+        }
+        for (size_t c(0); c + 1 < grid_start_.size(); ++c)
+            grid_start_[c + 1] += grid_start_[c];
+        grid_triangles_.resize(grid_start_.back());
+        vector<uint32_t> fill(grid_start_.begin(), grid_start_.end() - 1);
+        for (size_t t(0); t < triangles_.size(); ++t)
+        {
+            const auto range(cell_range(t));
+            for (size_t z(range[1]); z <= range[3]; ++z)
+                for (size_t x(range[0]); x <= range[2]; ++x)
+                    grid_triangles_[fill[z * grid_size_[0] + x]++] = uint32_t(t);
+        }
+    }
+
+    uint32_t navmesh::locate(const point<float, 3>& position) const
+    {
+        const auto p(position.get_coordinates());
+        const float x((p[0] - grid_origin_[0]) / grid_cell_), z((p[2] - grid_origin_[1]) / grid_cell_);
+        if (!(x >= 0 && z >= 0 && x < float(grid_size_[0]) && z < float(grid_size_[1])))
+            return no_triangle;
+        const size_t cell(size_t(z) * grid_size_[0] + size_t(x));
+        uint32_t best(no_triangle);
+        float best_gap(numeric_limits<float>::max());
+        for (uint32_t k(grid_start_[cell]); k < grid_start_[cell + 1]; ++k)
+        {
+            const uint32_t t(grid_triangles_[k]);
+            const auto& a(vertices_[triangles_[t][0]]);
+            const auto& b(vertices_[triangles_[t][1]]);
+            const auto& c(vertices_[triangles_[t][2]]);
+            const float whole(area_xz(a, b, c));
+            const float wa(area_xz(b, c, p) / whole), wb(area_xz(c, a, p) / whole), wc(area_xz(a, b, p) / whole);
+            if (wa < -locate_tolerance || wb < -locate_tolerance || wc < -locate_tolerance)
+                continue;
+            const float gap(fabs(wa * a[1] + wb * b[1] + wc * c[1] - p[1]));
+            if (gap < best_gap)
+            {
+                best_gap = gap;
+                best = t;
+            }
+        }
+        return best;
+    }
+
+    size_t navmesh::triangle_count() const
+    {
+        return triangles_.size();
+    }
+
+    size_t navmesh::region_count() const
+    {
+        return region_centers_.size();
+    }
+
+    const array<uint32_t, 3>& navmesh::triangle(size_t index) const
+    {
+        return triangles_.at(index);
+    }
+
+    const array<uint32_t, 3>& navmesh::neighbors(size_t index) const
+    {
+        return neighbors_.at(index);
+    }
+
+    const array<float, 3>& navmesh::vertex(size_t index) const
+    {
+        return vertices_.at(index);
+    }
+
+    const array<float, 3>& navmesh::center(size_t index) const
+    {
+        return centers_.at(index);
+    }
+
+    uint32_t navmesh::region(size_t triangle) const
+    {
+        return regions_.at(triangle);
+    }
+
+    const array<float, 3>& navmesh::region_center(size_t region) const
+    {
+        return region_centers_.at(region);
+    }
+
+    pair<const uint32_t*, const uint32_t*> navmesh::region_links(size_t region) const
+    {
+        if (region >= region_centers_.size())
+            throw out_of_range("Region index out of range");
+        return {region_links_.data() + region_link_start_[region], region_links_.data() + region_link_start_[region + 1]};
+    }
+
+    path_planner::path_planner(const navmesh& mesh, size_t cache_capacity)
+        : mesh_(mesh), contexts_(1), cache_capacity_(cache_capacity), cache_hits_(0), cache_misses_(0)
+    {
+        prepare(contexts_[0], max(mesh_.triangle_count(), mesh_.region_count()));
+    }
+
+    void path_planner::prepare(search_context& context, size_t nodes) const
+    {
+        if (context.nodes.size() >= nodes)
+            return;
+        context.heap.reserve(nodes);
+        context.nodes.assign(nodes, {0, no_node, 0, no_node});
+        context.allowed.assign(mesh_.region_count(), 0);
+        context.corridor.reserve(nodes);
+        context.portals.reserve(nodes);
+        context.stamp = 0;
+    }
+
+    void path_planner::next_stamp(search_context& context)
+    {
+        // once the stamps wrap around, old stamps would match new searches
+        if (++context.stamp == 0)
+        {
+            for (auto& node : context.nodes)
+                node.reached = 0;
+            fill(context.allowed.begin(), context.allowed.end(), 0);
+            context.stamp = 1;
+        }
+    }
+
+    bool path_planner::search(search_context& context, uint32_t start, uint32_t goal, const array<float, 3>& from,
+                              const array<float, 3>& to, bool regions) const
+    {
+        // regions are entered at their centers, triangles at the midpoint of the edge crossed
+        // from their parent; the allowed regions were stamped by the caller with this stamp
+        const uint32_t stamp(context.stamp);
+        vector<search_node>& nodes(context.nodes);
+        context.heap.clear();
+        nodes[start] = {0, no_node, stamp, 0};
+        context.heap.emplace_back(distance(from, to), start);
+
+        const auto relax([&](uint32_t node, uint32_t next, const array<float, 3>& at, const array<float, 3>& entry)
+        {
+            search_node& state(nodes[next]);
+            const bool open(state.reached == stamp);
+            // closed nodes left the heap and are not reopened
+            if (open && state.heap_position == no_node)
+                return;
+            const float remaining(distance(entry, to));
+            // the goal is ordered by the whole length, so the first one popped is the best
+            const float cost(nodes[node].cost + distance(at, entry) + (next == goal ? remaining : 0));
+            const float key(cost + (next == goal ? 0 : remaining));
+            if (open)
+            {
+                if (cost >= state.cost)
+                    return;
+                // a new parent enters through another edge, so the estimate may move either way
+                auto& slot(context.heap[state.heap_position]);
+                const bool dropped(key < slot.first);
+                slot.first = key;
+                state.cost = cost;
+                state.parent = node;
+                if (dropped)
+                    sift_up(context.heap, nodes, state.heap_position);
+                else
+                    sift_down(context.heap, nodes, state.heap_position);
+                return;
+            }
+            state = {cost, node, stamp, uint32_t(context.heap.size())};
+            context.heap.emplace_back(key, next);
+            sift_up(context.heap, nodes, context.heap.size() - 1);
+        });
+
+        while (!context.heap.empty())
+        {
+            const uint32_t node(pop(context.heap, nodes));
+            if (node == goal)
+            {
+                context.corridor.clear();
+                for (uint32_t n(goal); n != no_node; n = nodes[n].parent)
+                    context.corridor.push_back(n);
+                return true;
+            }
+            if (regions)
+            {
+                const auto [first, last] = mesh_.region_links(node);
+                const array<float, 3>& at(node == start ? from : mesh_.region_center(node));
+                for (const uint32_t* next(first); next != last; ++next)
+                    relax(node, *next, at, mesh_.region_center(*next));
+                continue;
+            }
+            const auto& corners(mesh_.triangle(node));
+            const auto& across(mesh_.neighbors(node));
+            array<array<float, 3>, 3> midpoints;
+            for (size_t i(0); i < 3; ++i)
+            {
+                const auto& a(mesh_.vertex(corners[i]));
+                const auto& b(mesh_.vertex(corners[(i + 1) % 3]));
+                midpoints[i] = {(a[0] + b[0]) / 2, (a[1] + b[1]) / 2, (a[2] + b[2]) / 2};
+            }
+            // the entry point is the midpoint of the edge shared with the parent
+            array<float, 3> at(from);
+            for (size_t i(0); i < 3; ++i)
+                if (node != start && across[i] == nodes[node].parent)
+                    at = midpoints[i];
+            for (size_t i(0); i < 3; ++i)
+                if (across[i] != navmesh::no_triangle && across[i] != nodes[node].parent
+                    && context.allowed[mesh_.region(across[i])] == stamp)
+                    relax(node, across[i], at, midpoints[i]);
+        }
+        return false;
+    }
+
+    void path_planner::pull_string(search_context& context, const array<float, 3>& from, const array<float, 3>& to,
+                                   vector<point<float, 3>>& waypoints) const
+    {
+        // portals between consecutive corridor triangles, left and right as seen from the first
+        context.portals.clear();
+        context.portals.push_back({from, from});
+        for (size_t k(context.corridor.size() - 1); k > 0; --k)
+        {
+            const uint32_t t(context.corridor[k]), next(context.corridor[k - 1]);
+            const auto& corners(mesh_.triangle(t));
+            const auto& across(mesh_.neighbors(t));
+            size_t i(0);
+            while (across[i] != next)
+                ++i;
+            const auto& a(mesh_.vertex(corners[i]));
+            const auto& b(mesh_.vertex(corners[(i + 1) % 3]));
+            if (area_xz(mesh_.center(t), a, b) > 0)
+                context.portals.push_back({a, b});
+            else
+                context.portals.push_back({b, a});
+        }
+        context.portals.push_back({to, to});
+
+        // simple stupid funnel: narrow the funnel portal by portal, and when a side crosses
+        // the other, the crossed corner becomes a waypoint and the funnel restarts from it
+        waypoints.clear();
+        waypoints.emplace_back(from);
+        array<float, 3> apex(from), left(from), right(from);
+        size_t apex_index(0), left_index(0), right_index(0);
+        for (size_t i(1); i < context.portals.size(); ++i)
+        {
+            const auto& [next_left, next_right] = context.portals[i];
+            if (area_xz(apex, right, next_right) <= 0)
+            {
+                if (apex == right || area_xz(apex, left, next_right) > 0)
+                {
+                    right = next_right;
+                    right_index = i;
+                }
+                else
+                {
+                    if (coordinates(waypoints.back()) != left)
+                        waypoints.emplace_back(left);
+                    apex = left;
+                    apex_index = left_index;
+                    left = right = apex;
+                    left_index = right_index = apex_index;
+                    i = apex_index;
+                    continue;
+                }
+            }
+            if (area_xz(apex, left, next_left) >= 0)
+            {
+                if (apex == left || area_xz(apex, right, next_left) < 0)
+                {
+                    left = next_left;
+                    left_index = i;
+                }
+                else
+                {
+                    if (coordinates(waypoints.back()) != right)
+                        waypoints.emplace_back(right);
+                    apex = right;
+                    apex_index = right_index;
+                    left = right = apex;
+                    left_index = right_index = apex_index;
+                    i = apex_index;
+                    continue;
+                }
+            }
+        }
+        if (coordinates(waypoints.back()) != to || waypoints.size() == 1)
+            waypoints.emplace_back(to);
+    }
+
+    bool path_planner::plan(search_context& context, const path_request& request, path_result& result,
+                            pair<uint64_t, vector<uint32_t>>& fresh_chain, bool& cache_hit) const
+    {
+        result.waypoints.clear();
+        result.found = false;
+        cache_hit = false;
+        fresh_chain.first = no_chain;
+        fresh_chain.second.clear();
+        const uint32_t start(mesh_.locate(request.start)), goal(mesh_.locate(request.goal));
+        if (start == navmesh::no_triangle || goal == navmesh::no_triangle)
+            return false;
+        const auto from(coordinates(request.start)), to(coordinates(request.goal));
+        const uint32_t start_region(mesh_.region(start)), goal_region(mesh_.region(goal));
+
+        // the region chain from the goal back to the start, empty if the regions are not connected
+        const vector<uint32_t>* chain;
+        const uint64_t key(uint64_t(start_region) << 32 | goal_region);
+        if (const auto cached(region_paths_.find(key)); cached != region_paths_.end())
+        {
+            chain = &cached->second;
+            cache_hit = true;
+        }
+        else
+        {
+            next_stamp(context);
+            if (search(context, start_region, goal_region, mesh_.region_center(start_region),
+                       mesh_.region_center(goal_region), true))
+                fresh_chain.second.assign(context.corridor.begin(), context.corridor.end());
+            fresh_chain.first = key;
+            chain = &fresh_chain.second;
+        }
+        if (chain->empty())
+            return false;
+
+        next_stamp(context);
+        for (const uint32_t region : *chain)
+            context.allowed[region] = context.stamp;
+        if (!search(context, start, goal, from, to, false))
+            return false;
+        pull_string(context, from, to, result.waypoints);
+        result.found = true;
+        return true;
+    }
+
+    void path_planner::remember(pair<uint64_t, vector<uint32_t>>& fresh_chain)
+    {
+        if (fresh_chain.first == no_chain || region_paths_.count(fresh_chain.first) != 0)
+            return;
+        if (region_paths_.size() >= cache_capacity_)
+            region_paths_.clear();
+        // the slot keeps a buffer of its own, so the chain is copied rather than moved
+        region_paths_.emplace(fresh_chain.first, fresh_chain.second);
+    }
+
+    bool path_planner::find_path(const path_request& request, path_result& result)
+    {
+        if (fresh_paths_.empty())
+            fresh_paths_.resize(1);
+        bool hit;
+        plan(contexts_[0], request, result, fresh_paths_[0], hit);
+        if (hit)
+            ++cache_hits_;
+        else if (fresh_paths_[0].first != no_chain)
+            ++cache_misses_;
+        remember(fresh_paths_[0]);
+        return result.found;
+    }
+
+    void path_planner::find_paths(const vector<path_request>& requests, vector<path_result>& results,
+                                  thread_pool& pool)
+    {
+        results.resize(requests.size());
+        if (requests.empty())
+            return;
+        if (fresh_paths_.size() < requests.size())
+            fresh_paths_.resize(requests.size());
+        hits_.assign(requests.size(), 0);
+        // one chunk and context per thread, the caller included
+        const size_t chunks(min(requests.size(), pool.size() + 1));
+        const size_t grain((requests.size() + chunks - 1) / chunks);
+        const size_t nodes(max(mesh_.triangle_count(), mesh_.region_count()));
+        if (contexts_.size() < chunks)
+            contexts_.resize(chunks);
+        for (size_t c(0); c < chunks; ++c)
+            prepare(contexts_[c], nodes);
+
+        pool.parallel_for(0, requests.size(), grain, [&](size_t first, size_t last)
+        {
+            search_context& context(contexts_[first / grain]);
+            for (size_t i(first); i < last; ++i)
+            {
+                bool hit;
+                plan(context, requests[i], results[i], fresh_paths_[i], hit);
+                hits_[i] = hit;
+            }
+        });
+        for (size_t i(0); i < requests.size(); ++i)
+        {
+            if (hits_[i])
+                ++cache_hits_;
+            else if (fresh_paths_[i].first != no_chain)
+                ++cache_misses_;
+            remember(fresh_paths_[i]);
+        }
+    }
+
+    void path_planner::clear_cache()
+    {
+        region_paths_.clear();
+    }
+
+    size_t path_planner::cache_size() const
+    {
+        return region_paths_.size();
+    }
+
+    size_t path_planner::cache_hits() const
+    {
+        return cache_hits_;
+    }
+
+    size_t path_planner::cache_misses() const
+    {
+        return cache_misses_;
+    }
+} // engine_lib
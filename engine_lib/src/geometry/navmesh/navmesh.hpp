@@ -0,0 +1,207 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef NAVMESH_HPP
+#define NAVMESH_HPP
+#include "../../includes.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+#include "../mesh/mesh.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Settings of the navigation mesh builder.
+     */
+    struct navmesh_settings
+    {
+        float max_slope = 45; /// Steepest walkable slope in degrees; y is up.
+        float weld_distance = 1e-3f; /// Vertices in the same cell of a grid with this spacing are merged.
+        size_t region_triangles = 64; /// Triangles per region of the high-level graph.
+    };
+
+    /**
+     * @class navmesh
+     * @brief Walkable triangles of a level, connected across shared edges and grouped into regions.
+     *
+     * Regions are connected clusters of triangles grown breadth first; the graph of adjacent
+     * regions is the coarse level of the hierarchical search done by path_planner. A grid over
+     * the xz plane finds the triangle under a point.
+     */
+    class navmesh
+    {
+        vector<array<float, 3>> vertices_; /// Welded vertex positions.
+        vector<array<uint32_t, 3>> triangles_; /// Walkable triangles.
+        vector<array<uint32_t, 3>> neighbors_; /// Triangle across the edge from vertex i to vertex i + 1, or no_triangle.
+        vector<array<float, 3>> centers_; /// Centroid of every triangle.
+        vector<uint32_t> regions_; /// Region of every triangle.
+        vector<array<float, 3>> region_centers_; /// Mean centroid of the triangles of every region.
+        vector<uint32_t> region_link_start_; /// First adjacent region of every region in region_links_, plus the total.
+        vector<uint32_t> region_links_; /// Adjacent regions, grouped by region.
+        array<float, 2> grid_origin_; /// Lowest x and z of the walkable triangles.
+        float grid_cell_; /// Side of a locator grid cell.
+        array<size_t, 2> grid_size_; /// Locator cells along x and z.
+        vector<uint32_t> grid_start_; /// First triangle of every cell in grid_triangles_, plus the total.
+        vector<uint32_t> grid_triangles_; /// Triangles overlapping every cell, grouped by cell.
+
+    public:
+        static constexpr uint32_t no_triangle = UINT32_MAX;
+
+        /**
+         * @brief Builds the navigation mesh of a level.
+         *
+         * @param level Level geometry; triangles facing up within the slope limit are walkable.
+         * @param settings Settings.
+         * @throws invalid_argument If a setting is out of range or nothing is walkable.
+         */
+        explicit navmesh(const mesh& level, const navmesh_settings& settings = {});
+
+        /**
+         * @brief Finds the walkable triangle under or above a point.
+         *
+         * @param position The point.
+         * @return The triangle containing the point in the xz plane with the nearest height, or no_triangle.
+         */
+        [[nodiscard]] uint32_t locate(const point<float, 3>& position) const;
+
+        [[nodiscard]] size_t triangle_count() const;
+        [[nodiscard]] size_t region_count() const;
+        [[nodiscard]] const array<uint32_t, 3>& triangle(size_t index) const;
+        [[nodiscard]] const array<uint32_t, 3>& neighbors(size_t index) const;
+        [[nodiscard]] const array<float, 3>& vertex(size_t index) const;
+        [[nodiscard]] const array<float, 3>& center(size_t index) const;
+        [[nodiscard]] uint32_t region(size_t triangle) const;
+        [[nodiscard]] const array<float, 3>& region_center(size_t region) const;
+
+        /**
+         * @brief Returns the regions adjacent to a region.
+         *
+         * @param region The region.
+         * @return Pointers to the first and one past the last adjacent region.
+         */
+        [[nodiscard]] pair<const uint32_t*, const uint32_t*> region_links(size_t region) const;
+    };
+
+    /**
+     * @brief A path request: where an agent stands and where it wants to go.
+     */
+    struct path_request
+    {
+        point<float, 3> start;
+        point<float, 3> goal;
+    };
+
+    /**
+     * @brief A found path; the waypoints keep their capacity between requests.
+     */
+    struct path_result
+    {
+        vector<point<float, 3>> waypoints; /// Corners of the shortest path through the corridor, from start to goal.
+        bool found = false; /// False if an end is off the mesh or the ends are not connected.
+    };
+
+    /**
+     * @class path_planner
+     * @brief Answers path requests on a navmesh, many at once across worker threads.
+     *
+     * A request first finds the chain of regions to cross with A* on the region graph, then
+     * runs A* over the triangles of those regions only and pulls a string through the
+     * portals of the triangle corridor. Region chains are cached by their end regions, so
+     * agents heading between the same areas skip the coarse search. The triangle search
+     * limited to the chain is not always the shortest path over the whole mesh.
+     *
+     * Every worker owns a search context with a binary heap over triangle indices and
+     * stamped per-triangle state, allocated once, so a warm planner does not allocate.
+     */
+    class path_planner
+    {
+        struct search_node
+        {
+            float cost; /// Length of the best known path from the start.
+            uint32_t parent; /// Node the best known path comes from.
+            uint32_t reached; /// Stamp of the search that last reached the node.
+            uint32_t heap_position; /// Index in the heap while the node is open.
+        };
+
+        struct search_context
+        {
+            vector<pair<float, uint32_t>> heap; /// Open nodes with their estimated path length, a binary heap.
+            vector<search_node> nodes; /// State of every node, valid where reached is the current stamp.
+            vector<uint32_t> allowed; /// Stamp of the search allowed into every region.
+            vector<uint32_t> corridor; /// Nodes from the goal back to the start.
+            vector<array<array<float, 3>, 2>> portals; /// Left and right end of every portal.
+            uint32_t stamp = 0; /// Stamp of the current search.
+        };
+
+        const navmesh& mesh_; /// The searched mesh.
+        vector<search_context> contexts_; /// One per batch chunk.
+        unordered_map<uint64_t, vector<uint32_t>> region_paths_; /// Region chains by start and goal region.
+        size_t cache_capacity_; /// Region chains kept before the cache is cleared.
+        vector<pair<uint64_t, vector<uint32_t>>> fresh_paths_; /// Chains found during a batch, cached after it.
+        vector<uint8_t> hits_; /// Requests of the batch answered from the cache.
+        size_t cache_hits_; /// Requests that reused a cached chain.
+        size_t cache_misses_; /// Requests that searched the region graph.
+
+        void prepare(search_context& context, size_t nodes) const;
+        static void next_stamp(search_context& context);
+        bool search(search_context& context, uint32_t start, uint32_t goal, const array<float, 3>& from,
+                    const array<float, 3>& to, bool regions) const;
+        void pull_string(search_context& context, const array<float, 3>& from, const array<float, 3>& to,
+                         vector<point<float, 3>>& waypoints) const;
+        bool plan(search_context& context, const path_request& request, path_result& result,
+                  pair<uint64_t, vector<uint32_t>>& fresh_chain, bool& cache_hit) const;
+        void remember(pair<uint64_t, vector<uint32_t>>& fresh_chain);
+
+    public:
+        /**
+         * @brief Creates a planner for a mesh.
+         *
+         * @param mesh The mesh, must outlive the planner.
+         * @param cache_capacity Region chains kept; the cache is cleared when it fills.
+         */
+        explicit path_planner(const navmesh& mesh, size_t cache_capacity = 1 << 14);
+
+        /**
+         * @brief Finds one path on the calling thread.
+         *
+         * @param request Start and goal.
+         * @param result Receives the path.
+         * @return True if a path was found.
+         */
+        bool find_path(const path_request& request, path_result& result);
+
+        /**
+         * @brief Finds the paths of a batch of requests in parallel.
+         *
+         * The cache is only read during the batch; chains found by the batch are added after
+         * it, so the results do not depend on the thread count.
+         *
+         * @param requests The requests.
+         * @param results Receives one result per request, resized to match.
+         * @param pool Pool answering the requests.
+         */
+        void find_paths(const vector<path_request>& requests, vector<path_result>& results,
+                        thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Drops every cached region chain.
+         */
+        void clear_cache();
+
+        [[nodiscard]] size_t cache_size() const;
+        [[nodiscard]] size_t cache_hits() const;
+        [[nodiscard]] size_t cache_misses() const;
+    };
+} // engine_lib
+
+#endif //NAVMESH_HPP
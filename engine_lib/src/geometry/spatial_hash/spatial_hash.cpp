@@ -0,0 +1,327 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "spatial_hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr size_t chunk_size(4096);
+
+        float distance_squared(const point<float, 3>& a, const point<float, 3>& b)
+        {
+            float sum(0);
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                const float difference(a.coordinate(axis) - b.coordinate(axis));
+                sum += difference * difference;
+            }
+            return sum;
+        }
+
+        size_t round_up_to_power_of_two(size_t value)
+        {
+            size_t result(1);
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+    }
+
+    spatial_hash::spatial_hash(float cell_size, size_t bucket_count)
+        : cell_size_(cell_size),
+          inverse_cell_size_(1 / cell_size),
+          fixed_bucket_count_(bucket_count == 0 ? 0 : round_up_to_power_of_two(bucket_count)),
+          bucket_bits_{0, 0, 0},
+          bucket_start_(max<size_t>(fixed_bucket_count_, 1) + 1, 0),
+          lower_cell_{0, 0, 0},
+          upper_cell_{-1, -1, -1}
+    {
+        if (!(cell_size > 0) || !isfinite(inverse_cell_size_))
+            throw invalid_argument("Cell size must be positive");
+    }
+
+    array<int32_t, 3> spatial_hash::cell_of(const point<float, 3>& position) const
+    {
+        return {int32_t(floor(position.coordinate(0) * inverse_cell_size_)),
+                int32_t(floor(position.coordinate(1) * inverse_cell_size_)),
+                int32_t(floor(position.coordinate(2) * inverse_cell_size_))};
+    }
+
+    uint32_t spatial_hash::bucket_of(const array<int32_t, 3>& cell) const
+    {
+        // the low bits of every coordinate, x fastest, so cells one step apart are one row apart
+        return (uint32_t(cell[0]) & ((1u << bucket_bits_[0]) - 1)) |
+               ((uint32_t(cell[1]) & ((1u << bucket_bits_[1]) - 1)) << bucket_bits_[0]) |
+               ((uint32_t(cell[2]) & ((1u << bucket_bits_[2]) - 1)) << (bucket_bits_[0] + bucket_bits_[1]));
+    }
+
+    template <class F>
+    void spatial_hash::for_each_in_cell(const array<int32_t, 3>& cell, F&& visit) const
+    {
+        const uint32_t bucket(bucket_of(cell));
+        for (uint32_t sorted(bucket_start_[bucket]); sorted < bucket_start_[bucket + 1]; ++sorted)
+            if (cells_[sorted] == cell)
+                visit(sorted);
+    }
+
+    void spatial_hash::build(const vector<point<float, 3>>& positions, thread_pool& pool)
+    {
+        const size_t count(positions.size());
+        if (count >= numeric_limits<uint32_t>::max())
+            throw invalid_argument("Too many points for 32-bit indices");
+
+        const size_t buckets(fixed_bucket_count_ != 0 ? fixed_bucket_count_ : round_up_to_power_of_two(2 * count));
+        bucket_start_.assign(buckets + 1, 0);
+        buckets_.resize(count);
+        unsorted_cells_.resize(count);
+        indices_.resize(count);
+        positions_.resize(count);
+        cells_.resize(count);
+
+        // cells and their bounds in parallel, every chunk keeps its own bounds
+        const size_t chunks((count + chunk_size - 1) / chunk_size);
+        vector<array<int32_t, 6>> bounds(chunks);
+        pool.parallel_for(0, count, chunk_size, [&](size_t first, size_t last)
+        {
+            array<int32_t, 6> chunk_bounds{numeric_limits<int32_t>::max(), numeric_limits<int32_t>::max(),
+                                           numeric_limits<int32_t>::max(), numeric_limits<int32_t>::min(),
+                                           numeric_limits<int32_t>::min(), numeric_limits<int32_t>::min()};
+            for (size_t i(first); i < last; ++i)
+            {
+                const array<int32_t, 3> cell(cell_of(positions[i]));
+                unsorted_cells_[i] = cell;
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    chunk_bounds[axis] = min(chunk_bounds[axis], cell[axis]);
+                    chunk_bounds[axis + 3] = max(chunk_bounds[axis + 3], cell[axis]);
+                }
+            }
+            bounds[first / chunk_size] = chunk_bounds;
+        });
+
+        lower_cell_ = {0, 0, 0};
+        upper_cell_ = {-1, -1, -1};
+        for (size_t chunk(0); chunk < chunks; ++chunk)
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                lower_cell_[axis] = chunk == 0 ? bounds[chunk][axis] : min(lower_cell_[axis], bounds[chunk][axis]);
+                upper_cell_[axis] = chunk == 0 ? bounds[chunk][axis + 3] : max(upper_cell_[axis], bounds[chunk][axis + 3]);
+            }
+
+        // give every bucket bit to the axis whose extent is least covered, so flat or long
+        // point sets wrap around as little as a cube would
+        uint32_t bits(0);
+        while ((size_t(1) << bits) < buckets)
+            ++bits;
+        bucket_bits_ = {0, 0, 0};
+        for (uint32_t bit(0); bit < bits; ++bit)
+        {
+            size_t widest(0);
+            double widest_ratio(0);
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                const double extent(double(upper_cell_[axis]) - double(lower_cell_[axis]) + 1);
+                const double ratio(extent / double(uint64_t(1) << bucket_bits_[axis]));
+                if (ratio > widest_ratio)
+                {
+                    widest = axis;
+                    widest_ratio = ratio;
+                }
+            }
+            ++bucket_bits_[widest_ratio > 1 ? widest : bit % 3];
+        }
+
+        pool.parallel_for(0, count, chunk_size, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; ++i)
+                buckets_[i] = bucket_of(unsorted_cells_[i]);
+        });
+
+        // counting sort: bucket_start_[b] ends up one past bucket b, then the scatter walks it back
+        for (size_t i(0); i < count; ++i)
+            ++bucket_start_[buckets_[i]];
+        for (size_t b(1); b <= buckets; ++b)
+            bucket_start_[b] += bucket_start_[b - 1];
+        for (size_t i(count); i-- > 0;)
+        {
+            const uint32_t sorted(--bucket_start_[buckets_[i]]);
+            indices_[sorted] = uint32_t(i);
+            positions_[sorted] = positions[i];
+            cells_[sorted] = unsorted_cells_[i];
+        }
+    }
+
+    float spatial_hash::cell_size() const
+    {
+        return cell_size_;
+    }
+
+    size_t spatial_hash::size() const
+    {
+        return positions_.size();
+    }
+
+    size_t spatial_hash::bucket_count() const
+    {
+        return bucket_start_.size() - 1;
+    }
+
+    vector<pair<uint32_t, uint32_t>> spatial_hash::find_pairs(float radius, thread_pool& pool) const
+    {
+        if (radius > cell_size_)
+            throw invalid_argument("Pair radius exceeds the cell size");
+
+        // every chunk of buckets fills its own list, joined in chunk order
+        // half of the neighborhood as rows of three cells along x (the cell at +x is handled apart)
+        constexpr array<array<int32_t, 2>, 4> forward_rows{{{1, 0}, {-1, 1}, {0, 1}, {1, 1}}};
+        const float radius_squared(radius * radius);
+        const size_t buckets(bucket_count());
+        vector<vector<pair<uint32_t, uint32_t>>> chunk_pairs((buckets + chunk_size - 1) / chunk_size);
+        pool.parallel_for(0, buckets, chunk_size, [&](size_t first, size_t last)
+        {
+            vector<pair<uint32_t, uint32_t>>& found(chunk_pairs[first / chunk_size]);
+            auto test = [&](uint32_t a, uint32_t b)
+            {
+                if (distance_squared(positions_[a], positions_[b]) <= radius_squared)
+                    found.emplace_back(min(indices_[a], indices_[b]), max(indices_[a], indices_[b]));
+            };
+
+            for (size_t bucket(first); bucket < last; ++bucket)
+                for (uint32_t sorted(bucket_start_[bucket]); sorted < bucket_start_[bucket + 1]; ++sorted)
+                {
+                    // pairs inside the cell, and with half of the neighbor cells so every pair is seen once
+                    const array<int32_t, 3>& cell(cells_[sorted]);
+                    for (uint32_t other(sorted + 1); other < bucket_start_[bucket + 1]; ++other)
+                        if (cells_[other] == cell)
+                            test(sorted, other);
+                    for_each_in_cell({cell[0] + 1, cell[1], cell[2]}, [&](uint32_t other) { test(sorted, other); });
+                    for (const array<int32_t, 2>& row : forward_rows)
+                    {
+                        const array<int32_t, 3> middle{cell[0], cell[1] + row[0], cell[2] + row[1]};
+                        const uint32_t left(bucket_of({middle[0] - 1, middle[1], middle[2]}));
+                        const uint32_t right(bucket_of({middle[0] + 1, middle[1], middle[2]}));
+                        if (right == left + 2)
+                        {
+                            // the three buckets are adjacent, so the row is one contiguous range
+                            for (uint32_t other(bucket_start_[left]); other < bucket_start_[right + 1]; ++other)
+                                if (cells_[other][1] == middle[1] && cells_[other][2] == middle[2] &&
+                                    abs(cells_[other][0] - middle[0]) <= 1)
+                                    test(sorted, other);
+                        }
+                        else
+                            for (int32_t dx(-1); dx <= 1; ++dx)
+                                for_each_in_cell({middle[0] + dx, middle[1], middle[2]},
+                                                 [&](uint32_t other) { test(sorted, other); });
+                    }
+                }
+        });
+
+        size_t total(0);
+        for (const auto& found : chunk_pairs)
+            total += found.size();
+        vector<pair<uint32_t, uint32_t>> result;
+        result.reserve(total);
+        for (const auto& found : chunk_pairs)
+            result.insert(result.end(), found.begin(), found.end());
+        return result;
+    }
+
+    vector<uint32_t> spatial_hash::query_radius(const point<float, 3>& center, float radius) const
+    {
+        vector<uint32_t> result;
+        if (positions_.empty() || !(radius >= 0))
+            return result;
+
+        array<int32_t, 3> lower, upper;
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            lower[axis] = max(lower_cell_[axis],
+                              int32_t(max(floor((center.coordinate(axis) - radius) * inverse_cell_size_), -2e9f)));
+            upper[axis] = min(upper_cell_[axis],
+                              int32_t(min(floor((center.coordinate(axis) + radius) * inverse_cell_size_), 2e9f)));
+        }
+
+        const float radius_squared(radius * radius);
+        for (int32_t x(lower[0]); x <= upper[0]; ++x)
+            for (int32_t y(lower[1]); y <= upper[1]; ++y)
+                for (int32_t z(lower[2]); z <= upper[2]; ++z)
+                    for_each_in_cell({x, y, z}, [&](uint32_t sorted)
+                    {
+                        if (distance_squared(center, positions_[sorted]) <= radius_squared)
+                            result.push_back(indices_[sorted]);
+                    });
+        return result;
+    }
+
+    vector<uint32_t> spatial_hash::query_nearest(const point<float, 3>& center, size_t k) const
+    {
+        k = min(k, positions_.size());
+        vector<uint32_t> result;
+        if (k == 0)
+            return result;
+
+        // max-heap of the best candidates so far
+        vector<pair<float, uint32_t>> best;
+        best.reserve(k + 1);
+        auto consider = [&](uint32_t sorted)
+        {
+            const pair<float, uint32_t> candidate(distance_squared(center, positions_[sorted]), indices_[sorted]);
+            if (best.size() == k && !(candidate < best.front()))
+                return;
+            best.push_back(candidate);
+            push_heap(best.begin(), best.end());
+            if (best.size() > k)
+            {
+                pop_heap(best.begin(), best.end());
+                best.pop_back();
+            }
+        };
+
+        // shell r holds the cells at Chebyshev distance r; points outside it are at least r cells away
+        const array<int32_t, 3> cell(cell_of(center));
+        int64_t last_shell(0);
+        for (size_t axis(0); axis < 3; ++axis)
+            last_shell = max({last_shell, int64_t(cell[axis]) - lower_cell_[axis], int64_t(upper_cell_[axis]) - cell[axis]});
+
+        for (int64_t shell(0); shell <= last_shell; ++shell)
+        {
+            const int64_t x_first(max<int64_t>(cell[0] - shell, lower_cell_[0]));
+            const int64_t x_last(min<int64_t>(cell[0] + shell, upper_cell_[0]));
+            const int64_t y_first(max<int64_t>(cell[1] - shell, lower_cell_[1]));
+            const int64_t y_last(min<int64_t>(cell[1] + shell, upper_cell_[1]));
+            for (int64_t x(x_first); x <= x_last; ++x)
+                for (int64_t y(y_first); y <= y_last; ++y)
+                {
+                    if (abs(x - cell[0]) == shell || abs(y - cell[1]) == shell)
+                    {
+                        const int64_t z_first(max<int64_t>(cell[2] - shell, lower_cell_[2]));
+                        const int64_t z_last(min<int64_t>(cell[2] + shell, upper_cell_[2]));
+                        for (int64_t z(z_first); z <= z_last; ++z)
+                            for_each_in_cell({int32_t(x), int32_t(y), int32_t(z)}, consider);
+                    }
+                    else
+                        for (int64_t z : {cell[2] - shell, cell[2] + shell})
+                            if (z >= lower_cell_[2] && z <= upper_cell_[2])
+                                for_each_in_cell({int32_t(x), int32_t(y), int32_t(z)}, consider);
+                }
+
+            const float reach(float(shell) * cell_size_);
+            if (best.size() == k && best.front().first <= reach * reach)
+                break;
+        }
+
+        sort_heap(best.begin(), best.end());
+        result.reserve(k);
+        for (const auto& [distance, index] : best)
+            result.push_back(index);
+        return result;
+    }
+} // engine_lib
@@ -0,0 +1,110 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef SPATIAL_HASH_HPP
+#define SPATIAL_HASH_HPP
+#include "../../includes.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class spatial_hash
+     * @brief Uniform grid over 3D points, hashed into a fixed number of buckets.
+     *
+     * The hash wraps the infinite grid around a periodic block of buckets, so neighboring
+     * cells land in neighboring buckets and scans over cell neighborhoods stream through
+     * memory. The block is shaped after the bounds of the points on every build().
+     *
+     * build() sorts the points by bucket with a counting sort, so the points of one cell
+     * are contiguous and the per-frame rebuild costs two linear passes. Distant cells may
+     * share a bucket; every query filters by the actual cell, so collisions only cost time.
+     *
+     * Queries return the indices of the points in the vector passed to build().
+     */
+    class spatial_hash
+    {
+        float cell_size_; /// Side of a grid cell.
+        float inverse_cell_size_; /// 1 / cell_size_.
+        size_t fixed_bucket_count_; /// Bucket count chosen at construction, zero to size by the points.
+        array<uint32_t, 3> bucket_bits_; /// Bits of the bucket index taken from each cell coordinate.
+        vector<uint32_t> bucket_start_; /// First sorted point of every bucket, plus the total at the end.
+        vector<uint32_t> indices_; /// Original index of every sorted point.
+        vector<point<float, 3>> positions_; /// Positions in bucket order.
+        vector<array<int32_t, 3>> cells_; /// Cell of every sorted point.
+        vector<uint32_t> buckets_; /// Bucket of every original point, kept to avoid reallocation.
+        vector<array<int32_t, 3>> unsorted_cells_; /// Cell of every original point, kept likewise.
+        array<int32_t, 3> lower_cell_; /// Smallest cell coordinates holding a point.
+        array<int32_t, 3> upper_cell_; /// Largest cell coordinates holding a point.
+
+        [[nodiscard]] array<int32_t, 3> cell_of(const point<float, 3>& position) const;
+        [[nodiscard]] uint32_t bucket_of(const array<int32_t, 3>& cell) const;
+
+        template <class F>
+        void for_each_in_cell(const array<int32_t, 3>& cell, F&& visit) const;
+
+    public:
+        /**
+         * @brief Creates an empty grid.
+         *
+         * @param cell_size Side of a grid cell, ideally the typical query radius.
+         * @param bucket_count Number of hash buckets, rounded up to a power of two. Zero picks
+         *                     twice the point count on every build().
+         * @throws invalid_argument If cell_size is not positive.
+         */
+        explicit spatial_hash(float cell_size, size_t bucket_count = 0);
+
+        /**
+         * @brief Replaces the contents with the given points.
+         *
+         * @param positions The points.
+         * @param pool Pool hashing the points.
+         * @throws invalid_argument If there are more points than 32-bit indices can address.
+         */
+        void build(const vector<point<float, 3>>& positions, thread_pool& pool = thread_pool::global());
+
+        [[nodiscard]] float cell_size() const;
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t bucket_count() const;
+
+        /**
+         * @brief Finds every pair of points within a distance, cell by cell in parallel.
+         *
+         * @param radius Pair distance, at most the cell size.
+         * @param pool Pool scanning the cells.
+         * @return Pairs (i, j) with i < j, in the same order for any thread count.
+         * @throws invalid_argument If radius exceeds the cell size.
+         */
+        [[nodiscard]] vector<pair<uint32_t, uint32_t>> find_pairs(float radius,
+                                                                  thread_pool& pool = thread_pool::global()) const;
+
+        /**
+         * @brief Finds the points within a distance of a position.
+         *
+         * @param center The position.
+         * @param radius The distance, any size.
+         * @return Indices of the points, in no particular order.
+         */
+        [[nodiscard]] vector<uint32_t> query_radius(const point<float, 3>& center, float radius) const;
+
+        /**
+         * @brief Finds the nearest points to a position, searching shells of cells outward.
+         *
+         * @param center The position.
+         * @param k Number of points wanted.
+         * @return Indices of min(k, size()) points, nearest first.
+         */
+        [[nodiscard]] vector<uint32_t> query_nearest(const point<float, 3>& center, size_t k) const;
+    };
+} // engine_lib
+
+#endif //SPATIAL_HASH_HPP
@@ -0,0 +1,261 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "input_system.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine_lib
+{
+    static_assert(sizeof(input_snapshot) == 272, "input_snapshot must not contain padding");
+
+    namespace
+    {
+        bool test_bit(const array<uint64_t, input_format::key_count / 64>& bits, uint32_t index)
+        {
+            return index < input_format::key_count && (bits[index / 64] >> (index % 64) & 1) != 0;
+        }
+
+        // sets or clears a held bit and records the transition; repeated downs are no transition
+        template <class T>
+        void update_bit(T& down, T& pressed, T& released, uint32_t index, bool is_down)
+        {
+            const T bit(T(T(1) << index));
+            if (is_down && (down & bit) == 0)
+                pressed = T(pressed | bit);
+            if (!is_down && (down & bit) != 0)
+                released = T(released | bit);
+            down = T(is_down ? down | bit : down & ~bit);
+        }
+
+        void move_mouse(input_snapshot& state, float x, float y)
+        {
+            state.mouse_dx += x - state.mouse_x;
+            state.mouse_dy += y - state.mouse_y;
+            state.mouse_x = x;
+            state.mouse_y = y;
+        }
+    }
+
+    bool input_snapshot::key_down(uint32_t scancode) const
+    {
+        return test_bit(keys_down, scancode);
+    }
+
+    bool input_snapshot::key_pressed(uint32_t scancode) const
+    {
+        return test_bit(keys_pressed, scancode);
+    }
+
+    bool input_snapshot::key_released(uint32_t scancode) const
+    {
+        return test_bit(keys_released, scancode);
+    }
+
+    bool input_snapshot::mouse_button_down(uint32_t button) const
+    {
+        return button < input_format::mouse_button_count && (mouse_down >> button & 1) != 0;
+    }
+
+    bool input_snapshot::mouse_button_pressed(uint32_t button) const
+    {
+        return button < input_format::mouse_button_count && (mouse_pressed >> button & 1) != 0;
+    }
+
+    bool input_snapshot::gamepad_button_down(uint32_t button) const
+    {
+        return button < input_format::gamepad_button_count && (gamepad_down >> button & 1) != 0;
+    }
+
+    bool input_snapshot::gamepad_button_pressed(uint32_t button) const
+    {
+        return button < input_format::gamepad_button_count && (gamepad_pressed >> button & 1) != 0;
+    }
+
+    input_system::input_system(size_t capacity) : events_(capacity), state_(), dropped_(0)
+    {
+    }
+
+    bool input_system::push(const input_event& event)
+    {
+        if (events_.try_push(event))
+            return true;
+        dropped_.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    const input_snapshot& input_system::tick(float dt)
+    {
+        // held state carries over, transitions and deltas start empty
+        ++state_.tick;
+        state_.dt = dt;
+        state_.keys_pressed.fill(0);
+        state_.keys_released.fill(0);
+        state_.mouse_dx = state_.mouse_dy = 0;
+        state_.wheel_x = state_.wheel_y = 0;
+        state_.gamepad_pressed = state_.gamepad_released = 0;
+        state_.mouse_pressed = state_.mouse_released = 0;
+        state_.quit = 0;
+        state_.event_count = 0;
+
+        input_event event;
+        while (events_.try_pop(event))
+        {
+            ++state_.event_count;
+            switch (event.type)
+            {
+            case input_event_type::key_down:
+            case input_event_type::key_up:
+                if (event.code < input_format::key_count)
+                {
+                    uint64_t& down(state_.keys_down[event.code / 64]);
+                    update_bit(down, state_.keys_pressed[event.code / 64], state_.keys_released[event.code / 64],
+                               event.code % 64, event.type == input_event_type::key_down);
+                }
+                break;
+            case input_event_type::mouse_motion:
+                move_mouse(state_, event.x, event.y);
+                break;
+            case input_event_type::mouse_button_down:
+            case input_event_type::mouse_button_up:
+                move_mouse(state_, event.x, event.y);
+                if (event.code < input_format::mouse_button_count)
+                    update_bit(state_.mouse_down, state_.mouse_pressed, state_.mouse_released, event.code,
+                               event.type == input_event_type::mouse_button_down);
+                break;
+            case input_event_type::mouse_wheel:
+                state_.wheel_x += event.x;
+                state_.wheel_y += event.y;
+                break;
+            case input_event_type::gamepad_button_down:
+            case input_event_type::gamepad_button_up:
+                if (event.code < input_format::gamepad_button_count)
+                    update_bit(state_.gamepad_down, state_.gamepad_pressed, state_.gamepad_released, event.code,
+                               event.type == input_event_type::gamepad_button_down);
+                break;
+            case input_event_type::gamepad_axis:
+                if (event.code < input_format::gamepad_axis_count)
+                    state_.gamepad_axes[event.code] = clamp(event.x, -1.0f, 1.0f);
+                break;
+            case input_event_type::quit:
+                state_.quit = 1;
+                break;
+            }
+        }
+        return state_;
+    }
+
+    const input_snapshot& input_system::current() const
+    {
+        return state_;
+    }
+
+    size_t input_system::dropped() const
+    {
+        return dropped_.load(memory_order_relaxed);
+    }
+
+    bool translate_sdl_event(const SDL_Event& event, input_event& result)
+    {
+        switch (event.type)
+        {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            if (event.key.repeat)
+                return false;
+            result = {event.key.down ? input_event_type::key_down : input_event_type::key_up,
+                      uint32_t(event.key.scancode), 0, 0};
+            return true;
+        case SDL_EVENT_MOUSE_MOTION:
+            result = {input_event_type::mouse_motion, 0, event.motion.x, event.motion.y};
+            return true;
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            // SDL numbers the buttons from one
+            result = {event.button.down ? input_event_type::mouse_button_down : input_event_type::mouse_button_up,
+                      uint32_t(event.button.button) - 1, event.button.x, event.button.y};
+            return true;
+        case SDL_EVENT_MOUSE_WHEEL:
+        {
+            const float direction(event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? -1.0f : 1.0f);
+            result = {input_event_type::mouse_wheel, 0, direction * event.wheel.x, direction * event.wheel.y};
+            return true;
+        }
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+            result = {event.gbutton.down ? input_event_type::gamepad_button_down : input_event_type::gamepad_button_up,
+                      uint32_t(event.gbutton.button), 0, 0};
+            return true;
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            result = {input_event_type::gamepad_axis, uint32_t(event.gaxis.axis), float(event.gaxis.value) / 32767.0f, 0};
+            return true;
+        case SDL_EVENT_QUIT:
+            result = {input_event_type::quit, 0, 0, 0};
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    input_recorder::input_recorder(const string& path) : file_(path, ios::binary), path_(path), size_(0)
+    {
+        const uint32_t header[2]{input_format::version, uint32_t(sizeof(input_snapshot))};
+        file_.write(input_format::magic, sizeof(input_format::magic));
+        file_.write(reinterpret_cast<const char*>(header), sizeof(header));
+        if (!file_)
+            throw runtime_error("Cannot write input recording: " + path);
+    }
+
+    void input_recorder::write(const input_snapshot& snapshot)
+    {
+        file_.write(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+        if ((size_ + 1) % input_format::flush_interval == 0)
+            file_.flush();
+        if (!file_)
+            throw runtime_error("Cannot write input recording: " + path_);
+        ++size_;
+    }
+
+    size_t input_recorder::size() const
+    {
+        return size_;
+    }
+
+    input_replay::input_replay(const string& path) : next_(0)
+    {
+        ifstream file(path, ios::binary);
+        char magic[sizeof(input_format::magic)];
+        uint32_t header[2];
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!file || memcmp(magic, input_format::magic, sizeof(magic)) != 0)
+            throw runtime_error("Not an input recording: " + path);
+        if (header[0] != input_format::version || header[1] != sizeof(input_snapshot))
+            throw runtime_error("Unsupported input recording version: " + path);
+
+        input_snapshot snapshot;
+        while (file.read(reinterpret_cast<char*>(&snapshot), sizeof(snapshot)))
+            snapshots_.push_back(snapshot);
+        if (file.gcount() != 0)
+            throw runtime_error("Truncated input recording: " + path);
+    }
+
+    const input_snapshot* input_replay::next()
+    {
+        return next_ < snapshots_.size() ? &snapshots_[next_++] : nullptr;
+    }
+
+    size_t input_replay::size() const
+    {
+        return snapshots_.size();
+    }
+
+    bool input_replay::finished() const
+    {
+        return next_ == snapshots_.size();
+    }
+} // engine_lib
@@ -0,0 +1,228 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef INPUT_SYSTEM_HPP
+#define INPUT_SYSTEM_HPP
+#include "../../includes.hpp"
+#include "../../containers/ring_buffer/ring_buffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+union SDL_Event;
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Constants of the input state and of the input recording format.
+     *
+     * A recording is a header of the magic, the version and the snapshot size as two uint32_t,
+     * followed by the raw input_snapshot of every tick, in the byte order of the recording
+     * machine.
+     */
+    namespace input_format
+    {
+        constexpr size_t key_count = 512; /// Scancodes tracked, as many as SDL defines.
+        constexpr size_t mouse_button_count = 8; /// Mouse buttons tracked, left first.
+        constexpr size_t gamepad_button_count = 32; /// Gamepad buttons tracked.
+        constexpr size_t gamepad_axis_count = 6; /// Gamepad axes tracked.
+        constexpr char magic[8] = {'L', '3', 'D', 'I', 'N', 'P', 'U', 'T'};
+        constexpr uint32_t version = 1;
+        constexpr size_t flush_interval = 60; /// Snapshots a recorder buffers between flushes.
+    }
+
+    /**
+     * @brief Kind of an input_event.
+     */
+    enum class input_event_type : uint32_t
+    {
+        key_down, //!< code is the scancode.
+        key_up, //!< code is the scancode.
+        mouse_motion, //!< x and y are the new cursor position.
+        mouse_button_down, //!< code is the button, zero for the left one; x and y the cursor position.
+        mouse_button_up, //!< code is the button, zero for the left one; x and y the cursor position.
+        mouse_wheel, //!< x and y are the scroll amounts.
+        gamepad_button_down, //!< code is the button.
+        gamepad_button_up, //!< code is the button.
+        gamepad_axis, //!< code is the axis, x its value in [-1, 1].
+        quit //!< The user asked to close the application.
+    };
+
+    /**
+     * @brief One input event, independent of the platform layer.
+     */
+    struct input_event
+    {
+        input_event_type type; /// Kind of the event.
+        uint32_t code; /// Key, button or axis, see input_event_type.
+        float x; /// Position, scroll amount or axis value, see input_event_type.
+        float y; /// Position or scroll amount, see input_event_type.
+    };
+
+    /**
+     * @brief Input state of one simulation tick.
+     *
+     * Held keys and buttons are bitsets; pressed and released record the transitions of the
+     * tick, so a tap shorter than a tick is still seen. The layout has no padding, so a
+     * recording is byte-for-byte reproducible.
+     */
+    struct input_snapshot
+    {
+        uint64_t tick; /// Tick number, starting at one.
+        array<uint64_t, input_format::key_count / 64> keys_down; /// Held keys.
+        array<uint64_t, input_format::key_count / 64> keys_pressed; /// Keys that went down this tick.
+        array<uint64_t, input_format::key_count / 64> keys_released; /// Keys that went up this tick.
+        float dt; /// Duration of the tick in seconds.
+        float mouse_x; /// Cursor position.
+        float mouse_y;
+        float mouse_dx; /// Cursor movement during the tick.
+        float mouse_dy;
+        float wheel_x; /// Scrolling during the tick.
+        float wheel_y;
+        array<float, input_format::gamepad_axis_count> gamepad_axes; /// Axis values in [-1, 1].
+        uint32_t gamepad_down; /// Held gamepad buttons, one bit each.
+        uint32_t gamepad_pressed; /// Gamepad buttons that went down this tick.
+        uint32_t gamepad_released; /// Gamepad buttons that went up this tick.
+        uint32_t event_count; /// Events folded into this tick.
+        uint8_t mouse_down; /// Held mouse buttons, one bit each.
+        uint8_t mouse_pressed; /// Mouse buttons that went down this tick.
+        uint8_t mouse_released; /// Mouse buttons that went up this tick.
+        uint8_t quit; /// Nonzero if a quit event arrived this tick.
+
+        [[nodiscard]] bool key_down(uint32_t scancode) const;
+        [[nodiscard]] bool key_pressed(uint32_t scancode) const;
+        [[nodiscard]] bool key_released(uint32_t scancode) const;
+        [[nodiscard]] bool mouse_button_down(uint32_t button) const;
+        [[nodiscard]] bool mouse_button_pressed(uint32_t button) const;
+        [[nodiscard]] bool gamepad_button_down(uint32_t button) const;
+        [[nodiscard]] bool gamepad_button_pressed(uint32_t button) const;
+    };
+
+    /**
+     * @class input_system
+     * @brief Queues events from the platform thread and folds them into one snapshot per tick.
+     *
+     * push() is called by the thread receiving the platform events and tick() by the
+     * simulation, which reads the returned snapshot without any lock. The events travel
+     * through a lock-free ring_buffer; when it is full, further events are dropped and counted.
+     */
+    class input_system
+    {
+        ring_buffer<input_event> events_; /// Events not yet folded into a snapshot.
+        input_snapshot state_; /// Snapshot of the last tick.
+        atomic<size_t> dropped_; /// Events rejected by a full buffer.
+
+    public:
+        /**
+         * @brief Creates an input system with an idle snapshot.
+         *
+         * @param capacity Events that may be queued between two ticks.
+         * @throws invalid_argument If capacity is zero.
+         */
+        explicit input_system(size_t capacity = 1024);
+
+        /**
+         * @brief Queues an event. Platform thread only.
+         *
+         * @param event The event.
+         * @return False if the event was dropped because the buffer is full.
+         */
+        bool push(const input_event& event);
+
+        /**
+         * @brief Folds the queued events into the snapshot of a new tick. Simulation thread only.
+         *
+         * Codes outside the tracked ranges are ignored.
+         *
+         * @param dt Duration of the tick in seconds, stored in the snapshot.
+         * @return The snapshot, valid until the next tick().
+         */
+        const input_snapshot& tick(float dt);
+
+        [[nodiscard]] const input_snapshot& current() const;
+        [[nodiscard]] size_t dropped() const;
+    };
+
+    /**
+     * @brief Converts an SDL event into an input_event.
+     *
+     * Key repeats and events without an input_event counterpart are skipped.
+     *
+     * @param event The SDL event.
+     * @param result Receives the converted event.
+     * @return False if the event was skipped.
+     */
+    bool translate_sdl_event(const SDL_Event& event, input_event& result);
+
+    /**
+     * @class input_recorder
+     * @brief Writes the snapshot stream of a session to a file.
+     *
+     * Snapshots are buffered and flushed every input_format::flush_interval ticks and on
+     * destruction, so a crash loses at most the last second or so of a 60 Hz session.
+     */
+    class input_recorder
+    {
+        ofstream file_; /// The recording.
+        string path_; /// Path of the recording, for error messages.
+        size_t size_; /// Snapshots written.
+
+    public:
+        /**
+         * @brief Creates the file and writes the header.
+         *
+         * @param path Path of the recording.
+         * @throws runtime_error If the file cannot be written.
+         */
+        explicit input_recorder(const string& path);
+
+        /**
+         * @brief Appends a snapshot.
+         *
+         * @param snapshot The snapshot.
+         * @throws runtime_error If the file cannot be written.
+         */
+        void write(const input_snapshot& snapshot);
+
+        [[nodiscard]] size_t size() const;
+    };
+
+    /**
+     * @class input_replay
+     * @brief Plays a recorded snapshot stream back, tick by tick.
+     */
+    class input_replay
+    {
+        vector<input_snapshot> snapshots_; /// Every snapshot of the recording.
+        size_t next_; /// Next snapshot to play.
+
+    public:
+        /**
+         * @brief Reads a recording.
+         *
+         * @param path Path of the recording.
+         * @throws runtime_error If the file cannot be read or is not a recording of this version.
+         */
+        explicit input_replay(const string& path);
+
+        /**
+         * @brief Returns the next snapshot.
+         *
+         * @return The snapshot, or nullptr once the recording is over.
+         */
+        const input_snapshot* next();
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool finished() const;
+    };
+} // engine_lib
+
+#endif //INPUT_SYSTEM_HPP
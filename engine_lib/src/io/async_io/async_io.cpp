@@ -0,0 +1,673 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "async_io.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr intptr_t no_file(-1);
+
+        string error_text(ptrdiff_t code)
+        {
+#if defined(_WIN32)
+            return "system error " + to_string(code);
+#else
+            return strerror(int(code));
+#endif
+        }
+
+        // returns no_file and sets error on failure
+        intptr_t open_for_reading(const string& path, size_t& size, string& error)
+        {
+#if defined(_WIN32)
+            HANDLE file(CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr));
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                error = "Cannot open file: " + path;
+                return no_file;
+            }
+            LARGE_INTEGER length;
+            if (!GetFileSizeEx(file, &length))
+            {
+                CloseHandle(file);
+                error = "Cannot read the size of file: " + path;
+                return no_file;
+            }
+            size = size_t(length.QuadPart);
+            return intptr_t(file);
+#else
+            const int descriptor(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+            if (descriptor < 0)
+            {
+                error = "Cannot open file: " + path;
+                return no_file;
+            }
+            struct stat status{};
+            if (fstat(descriptor, &status) != 0)
+            {
+                ::close(descriptor);
+                error = "Cannot read the size of file: " + path;
+                return no_file;
+            }
+            size = size_t(status.st_size);
+            return descriptor;
+#endif
+        }
+
+        void close_file(intptr_t file)
+        {
+#if defined(_WIN32)
+            CloseHandle(HANDLE(file));
+#else
+            ::close(int(file));
+#endif
+        }
+
+        // reads until size bytes or the end of the file, returns the bytes read or a negated error code
+        ptrdiff_t read_at(intptr_t file, unsigned char* data, size_t size, uint64_t offset)
+        {
+            size_t done(0);
+            while (done < size)
+            {
+#if defined(_WIN32)
+                OVERLAPPED position{};
+                position.Offset = DWORD(offset + done);
+                position.OffsetHigh = DWORD((offset + done) >> 32);
+                DWORD read(0);
+                const DWORD request(DWORD(min<size_t>(size - done, 1u << 30)));
+                if (!ReadFile(HANDLE(file), data + done, request, &read, &position))
+                {
+                    const DWORD code(GetLastError());
+                    if (code == ERROR_HANDLE_EOF)
+                        break;
+                    return -ptrdiff_t(code);
+                }
+#else
+                const ssize_t read(::pread(int(file), data + done, size - done, off_t(offset + done)));
+                if (read < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return -ptrdiff_t(errno);
+                }
+#endif
+                if (read == 0)
+                    break;
+                done += size_t(read);
+            }
+            return ptrdiff_t(done);
+        }
+    }
+
+    bandwidth_limiter::bandwidth_limiter(size_t bytes_per_second, size_t burst)
+        : rate_(double(bytes_per_second)),
+          capacity_(burst != 0 ? double(burst) : max(1.0, double(bytes_per_second) / 10)),
+          tokens_(capacity_),
+          last_(chrono::steady_clock::now())
+    {
+    }
+
+    size_t bandwidth_limiter::bytes_per_second() const
+    {
+        return size_t(rate_);
+    }
+
+    bool bandwidth_limiter::unlimited() const
+    {
+        return rate_ == 0;
+    }
+
+    chrono::nanoseconds bandwidth_limiter::try_acquire(size_t bytes, chrono::steady_clock::time_point now)
+    {
+        if (unlimited())
+            return chrono::nanoseconds(0);
+
+        if (now > last_)
+        {
+            tokens_ = min(capacity_, tokens_ + rate_ * chrono::duration<double>(now - last_).count());
+            last_ = now;
+        }
+        // oversized transfers wait for a full bucket and leave a debt behind
+        const double needed(min(double(bytes), capacity_));
+        if (tokens_ >= needed)
+        {
+            tokens_ -= double(bytes);
+            return chrono::nanoseconds(0);
+        }
+        return chrono::nanoseconds(int64_t(ceil((needed - tokens_) / rate_ * 1e9)));
+    }
+
+    struct async_io::request
+    {
+        uint64_t id;
+        io_priority priority;
+        string path;
+        size_t offset;
+        size_t size;
+        io_callback callback;
+        intptr_t file = no_file;
+        bool opening = false;
+        bool opened = false;
+        bool cancelled = false;
+        bool finished = false;
+        vector<unsigned char> data;
+        size_t issued = 0; /// Bytes handed to the backend.
+        size_t outstanding = 0; /// Chunks in flight.
+        string error;
+
+        // nothing left to issue
+        [[nodiscard]] bool drained() const
+        {
+            return cancelled || !error.empty() || (opened && issued == size);
+        }
+    };
+
+    struct async_io::chunk
+    {
+        shared_ptr<request> owner;
+        size_t position; /// Offset of the chunk in the request data.
+        size_t size;
+#if defined(__linux__)
+        iovec buffer{}; /// Destination of the read, set when the chunk is issued.
+#endif
+    };
+
+#if defined(__linux__)
+    /*
+     * A minimal io_uring driver on the raw system calls: one thread fills the submission
+     * queue, another one drains the completion queue, which the kernel allows without locking.
+     */
+    struct async_io::ring
+    {
+        int descriptor = -1;
+        void* sq_map = MAP_FAILED;
+        size_t sq_map_size = 0;
+        void* cq_map = MAP_FAILED;
+        size_t cq_map_size = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t sqes_size = 0;
+        unsigned* sq_tail = nullptr;
+        unsigned* sq_mask = nullptr;
+        unsigned* sq_array = nullptr;
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned* cq_mask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+
+        explicit ring(unsigned entries)
+        {
+            io_uring_params params{};
+            descriptor = int(syscall(__NR_io_uring_setup, entries, &params));
+            if (descriptor < 0)
+                throw runtime_error(string("io_uring is unavailable: ") + strerror(errno));
+
+            sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_map((params.features & IORING_FEAT_SINGLE_MMAP) != 0);
+            if (single_map)
+                sq_map_size = cq_map_size = max(sq_map_size, cq_map_size);
+
+            sq_map = mmap(nullptr, sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor,
+                          IORING_OFF_SQ_RING);
+            cq_map = single_map
+                         ? sq_map
+                         : mmap(nullptr, cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor,
+                                IORING_OFF_CQ_RING);
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_SQES));
+            if (sq_map == MAP_FAILED || cq_map == MAP_FAILED || sqes == MAP_FAILED)
+            {
+                release();
+                throw runtime_error("Cannot map the io_uring queues");
+            }
+
+            auto* sq(static_cast<unsigned char*>(sq_map));
+            auto* cq(static_cast<unsigned char*>(cq_map));
+            sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        }
+
+        ring(const ring& other) = delete;
+        ring& operator=(const ring& other) = delete;
+
+        ~ring()
+        {
+            release();
+        }
+
+        void release()
+        {
+            if (sqes != MAP_FAILED)
+                munmap(sqes, sqes_size);
+            if (cq_map != MAP_FAILED && cq_map != sq_map)
+                munmap(cq_map, cq_map_size);
+            if (sq_map != MAP_FAILED)
+                munmap(sq_map, sq_map_size);
+            if (descriptor >= 0)
+                ::close(descriptor);
+        }
+
+        // callers keep at most sq_entries submissions in flight, so the queue never overflows
+        void submit(const io_uring_sqe& entry)
+        {
+            const unsigned tail(*sq_tail);
+            const unsigned index(tail & *sq_mask);
+            sqes[index] = entry;
+            sq_array[index] = index;
+            __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+            while (syscall(__NR_io_uring_enter, descriptor, 1u, 0u, 0u, nullptr, 0) < 0)
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    throw runtime_error(string("io_uring submission failed: ") + strerror(errno));
+        }
+
+        io_uring_cqe wait()
+        {
+            for (;;)
+            {
+                const unsigned head(*cq_head);
+                if (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE))
+                {
+                    const io_uring_cqe entry(cqes[head & *cq_mask]);
+                    __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+                    return entry;
+                }
+                syscall(__NR_io_uring_enter, descriptor, 0u, 1u, unsigned(IORING_ENTER_GETEVENTS), nullptr, 0);
+            }
+        }
+    };
+#else
+    struct async_io::ring
+    {
+        explicit ring(unsigned)
+        {
+            throw runtime_error("io_uring is only available on Linux");
+        }
+    };
+#endif
+
+    bool async_io::later_first::operator()(const shared_ptr<request>& a, const shared_ptr<request>& b) const
+    {
+        if (a->priority != b->priority)
+            return a->priority > b->priority;
+        return a->id > b->id;
+    }
+
+    async_io::async_io(thread_pool& callbacks, const async_io_options& options)
+        : callbacks_(callbacks),
+          options_(options),
+          limiter_(options.bytes_per_second),
+          next_id_(1),
+          in_flight_(0),
+          running_callbacks_(0),
+          paused_(false),
+          stopping_(false)
+    {
+        if (options_.queue_depth == 0 || options_.chunk_size == 0)
+            throw invalid_argument("Queue depth and chunk size must be positive");
+
+        if (options_.backend != io_backend::pread)
+        {
+            try
+            {
+                // one extra entry for the shutdown message of the reaper
+                ring_ = make_unique<ring>(unsigned(options_.queue_depth + 1));
+                options_.backend = io_backend::io_uring;
+            }
+            catch (const runtime_error&)
+            {
+                if (options_.backend == io_backend::io_uring)
+                    throw;
+                options_.backend = io_backend::pread;
+            }
+        }
+        if (options_.backend == io_backend::pread)
+            io_threads_ = make_unique<thread_pool>(options_.io_threads);
+
+        submitter_ = thread([this] { submit_loop(); });
+        if (ring_)
+            reaper_ = thread([this] { reap_loop(); });
+    }
+
+    async_io::~async_io()
+    {
+        {
+            unique_lock<mutex> lock(mutex_);
+            stopping_ = true;
+            vector<shared_ptr<request>> unfinished;
+            for (const auto& entry : active_)
+                unfinished.push_back(entry.second);
+            for (const auto& target : unfinished)
+            {
+                target->cancelled = true;
+                finish_if_done(target);
+            }
+            wake_.notify_all();
+            idle_.wait(lock, [this] { return active_.empty() && running_callbacks_ == 0; });
+        }
+        submitter_.join();
+        if (reaper_.joinable())
+            reaper_.join();
+        io_threads_.reset();
+    }
+
+    io_backend async_io::backend() const
+    {
+        return options_.backend;
+    }
+
+    uint64_t async_io::read(const string& path, size_t offset, size_t size, io_priority priority, io_callback callback)
+    {
+        if (!callback)
+            throw invalid_argument("An I/O request needs a callback");
+
+        auto target(make_shared<request>());
+        target->priority = priority;
+        target->path = path;
+        target->offset = offset;
+        target->size = size;
+        target->callback = move(callback);
+        {
+            lock_guard<mutex> lock(mutex_);
+            target->id = next_id_++;
+            active_.emplace(target->id, target);
+            queue_.push(target);
+        }
+        wake_.notify_one();
+        return target->id;
+    }
+
+    uint64_t async_io::read(const string& path, io_priority priority, io_callback callback)
+    {
+        return read(path, 0, string::npos, priority, move(callback));
+    }
+
+    bool async_io::cancel(uint64_t request)
+    {
+        lock_guard<mutex> lock(mutex_);
+        const auto found(active_.find(request));
+        if (found == active_.end())
+            return false;
+        const shared_ptr<async_io::request> target(found->second);
+        target->cancelled = true;
+        finish_if_done(target);
+        wake_.notify_one();
+        return true;
+    }
+
+    void async_io::pause()
+    {
+        lock_guard<mutex> lock(mutex_);
+        paused_ = true;
+    }
+
+    void async_io::resume()
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            paused_ = false;
+        }
+        wake_.notify_one();
+    }
+
+    void async_io::set_bandwidth(size_t bytes_per_second)
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            limiter_ = bandwidth_limiter(bytes_per_second);
+        }
+        wake_.notify_one();
+    }
+
+    size_t async_io::pending() const
+    {
+        lock_guard<mutex> lock(mutex_);
+        return active_.size();
+    }
+
+    void async_io::wait_idle()
+    {
+        unique_lock<mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return active_.empty() && running_callbacks_ == 0; });
+    }
+
+    void async_io::submit_loop()
+    {
+        unique_lock<mutex> lock(mutex_);
+        for (;;)
+        {
+            if (!retries_.empty())
+            {
+                vector<chunk*> pieces(move(retries_));
+                retries_.clear();
+                lock.unlock();
+                for (chunk* piece : pieces)
+                    issue(piece);
+                lock.lock();
+                continue;
+            }
+            if (stopping_ && in_flight_ == 0)
+                break;
+
+            while (!queue_.empty() && queue_.top()->drained())
+                queue_.pop();
+            if (stopping_ || paused_ || queue_.empty() || in_flight_ >= options_.queue_depth)
+            {
+                wake_.wait(lock);
+                continue;
+            }
+
+            const shared_ptr<request> target(queue_.top());
+            if (!target->opened)
+            {
+                // opening may block on the file system, so the frame thread must not wait for the lock meanwhile
+                target->opening = true;
+                lock.unlock();
+                size_t file_size(0);
+                string error;
+                const intptr_t file(open_for_reading(target->path, file_size, error));
+                if (file != no_file && target->size == string::npos)
+                {
+                    if (target->offset > file_size)
+                        error = "Offset beyond the end of file: " + target->path;
+                    else
+                        target->size = file_size - target->offset;
+                }
+                if (error.empty())
+                    target->data.resize(target->size);
+                lock.lock();
+
+                target->opening = false;
+                target->opened = true;
+                target->file = file;
+                target->error = error;
+                finish_if_done(target);
+                continue;
+            }
+
+            const size_t size(min(options_.chunk_size, target->size - target->issued));
+            const chrono::nanoseconds delay(limiter_.try_acquire(size, chrono::steady_clock::now()));
+            if (delay.count() > 0)
+            {
+                wake_.wait_for(lock, delay);
+                continue;
+            }
+
+            auto* piece(new chunk{target, target->issued, size});
+            target->issued += size;
+            ++target->outstanding;
+            ++in_flight_;
+            if (target->issued == target->size)
+                queue_.pop();
+            lock.unlock();
+            issue(piece);
+            lock.lock();
+        }
+        lock.unlock();
+
+#if defined(__linux__)
+        if (ring_)
+        {
+            // user data zero stops the reaper, every other completion has arrived already
+            io_uring_sqe stop{};
+            stop.opcode = IORING_OP_NOP;
+            ring_->submit(stop);
+        }
+#endif
+    }
+
+    void async_io::reap_loop()
+    {
+#if defined(__linux__)
+        for (;;)
+        {
+            const io_uring_cqe entry(ring_->wait());
+            if (entry.user_data == 0)
+                return;
+            complete(reinterpret_cast<chunk*>(entry.user_data), entry.res);
+        }
+#endif
+    }
+
+    void async_io::issue(chunk* piece)
+    {
+#if defined(__linux__)
+        request& target(*piece->owner);
+        if (ring_)
+        {
+            piece->buffer.iov_base = target.data.data() + piece->position;
+            piece->buffer.iov_len = piece->size;
+            io_uring_sqe entry{};
+            entry.opcode = IORING_OP_READV;
+            entry.fd = int(target.file);
+            entry.addr = uint64_t(uintptr_t(&piece->buffer));
+            entry.len = 1;
+            entry.off = uint64_t(target.offset + piece->position);
+            entry.user_data = uint64_t(uintptr_t(piece));
+            try
+            {
+                ring_->submit(entry);
+            }
+            catch (const runtime_error&)
+            {
+                complete(piece, -ptrdiff_t(errno));
+            }
+            return;
+        }
+#endif
+        io_threads_->submit([this, piece]
+        {
+            request& owner(*piece->owner);
+            complete(piece, read_at(owner.file, owner.data.data() + piece->position, piece->size,
+                                    uint64_t(owner.offset + piece->position)));
+        });
+    }
+
+    void async_io::complete(chunk* piece, ptrdiff_t result)
+    {
+        // everything, notifications included, happens under the lock, so the destructor cannot
+        // release the members while a completing thread still uses them
+        lock_guard<mutex> lock(mutex_);
+        request& target(*piece->owner);
+        if (ring_ && result > 0 && size_t(result) < piece->size && !target.cancelled && target.error.empty())
+        {
+            // io_uring may stop short of the requested size, the rest goes out again
+            piece->position += size_t(result);
+            piece->size -= size_t(result);
+            retries_.push_back(piece);
+            wake_.notify_one();
+            return;
+        }
+        if (result < 0 && target.error.empty())
+            target.error = "Cannot read file " + target.path + ": " + error_text(-result);
+        else if (result >= 0 && size_t(result) < piece->size && target.error.empty())
+            target.error = "Unexpected end of file: " + target.path;
+
+        --target.outstanding;
+        --in_flight_;
+        finish_if_done(piece->owner);
+        delete piece;
+        wake_.notify_one();
+    }
+
+    void async_io::finish_if_done(const shared_ptr<request>& target)
+    {
+        if (target->finished || target->opening || target->outstanding > 0 || !target->drained())
+            return;
+
+        target->finished = true;
+        if (target->file != no_file)
+        {
+            close_file(target->file);
+            target->file = no_file;
+        }
+        active_.erase(target->id);
+
+        io_result result{target->id, io_status::completed, {}, target->error};
+        if (target->cancelled)
+            result.status = io_status::cancelled;
+        else if (!target->error.empty())
+            result.status = io_status::failed;
+        else
+            result.data = move(target->data);
+
+        // queued while the lock is held, so callbacks start in completion order
+        auto run = [this, callback = move(target->callback), result = move(result)]() mutable
+        {
+            try
+            {
+                callback(move(result));
+            }
+            catch (...)
+            {
+                // a throwing callback must not take the bookkeeping down with it
+            }
+            lock_guard<mutex> lock(mutex_);
+            --running_callbacks_;
+            idle_.notify_all();
+        };
+        try
+        {
+            callbacks_.submit(move(run));
+            ++running_callbacks_;
+        }
+        catch (const runtime_error&)
+        {
+            // the callback pool is shutting down, nobody is left to notify
+        }
+        if (active_.empty() && running_callbacks_ == 0)
+            idle_.notify_all();
+    }
+} // engine_lib
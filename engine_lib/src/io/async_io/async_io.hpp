@@ -0,0 +1,259 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef ASYNC_IO_HPP
+#define ASYNC_IO_HPP
+#include "../../includes.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Scheduling class of a read. Lower values are served first.
+     */
+    enum class io_priority
+    {
+        critical, //!< Needed for the current frame.
+        high, //!< Needed within the next frames.
+        normal, //!< Regular streaming.
+        low, //!< Speculative prefetching.
+    };
+
+    /**
+     * @brief How a read ended.
+     */
+    enum class io_status
+    {
+        completed, //!< Every requested byte was read.
+        failed, //!< The file could not be opened or read, see io_result::error.
+        cancelled //!< cancel() was called before the read completed.
+    };
+
+    /**
+     * @brief Mechanism used to read files.
+     */
+    enum class io_backend
+    {
+        automatic, //!< io_uring where the kernel allows it, pread otherwise.
+        io_uring, //!< Linux io_uring, reads are submitted to the kernel without blocking a thread each.
+        pread //!< Blocking positional reads on a small set of I/O threads.
+    };
+
+    /**
+     * @brief Outcome of a read, handed to its callback.
+     */
+    struct io_result
+    {
+        uint64_t request; /// Identifier returned by async_io::read().
+        io_status status; /// How the read ended.
+        vector<unsigned char> data; /// Bytes read, empty unless completed.
+        string error; /// Reason of a failure.
+    };
+
+    /**
+     * @brief Receives the result of a read. Runs on the callback thread pool.
+     */
+    using io_callback = function<void(io_result result)>;
+
+    /**
+     * @class bandwidth_limiter
+     * @brief Token bucket limiting the number of bytes per second.
+     *
+     * Tokens refill continuously at the configured rate up to the burst size. A rate of zero
+     * disables limiting.
+     */
+    class bandwidth_limiter
+    {
+        double rate_; /// Bytes per second, zero for unlimited.
+        double capacity_; /// Largest number of stored tokens.
+        double tokens_; /// Currently stored tokens.
+        chrono::steady_clock::time_point last_; /// Time of the last refill.
+
+    public:
+        /**
+         * @brief Creates a full bucket.
+         *
+         * @param bytes_per_second Refill rate. Zero disables limiting.
+         * @param burst Bucket size in bytes. Zero picks a tenth of a second worth of bytes.
+         */
+        explicit bandwidth_limiter(size_t bytes_per_second = 0, size_t burst = 0);
+
+        [[nodiscard]] size_t bytes_per_second() const;
+        [[nodiscard]] bool unlimited() const;
+
+        /**
+         * @brief Takes tokens for a transfer if enough are stored.
+         *
+         * Transfers larger than the bucket are allowed once the bucket is full, so any size
+         * eventually passes.
+         *
+         * @param bytes Size of the transfer.
+         * @param now Current time.
+         * @return Zero if the tokens were taken, otherwise how long to wait before retrying.
+         */
+        chrono::nanoseconds try_acquire(size_t bytes, chrono::steady_clock::time_point now);
+    };
+
+    /**
+     * @brief Settings of an async_io instance.
+     */
+    struct async_io_options
+    {
+        io_backend backend = io_backend::automatic; /// Requested backend.
+        size_t queue_depth = 32; /// Largest number of chunks in flight at once.
+        size_t chunk_size = 1 << 20; /// Reads are split into chunks of at most this many bytes.
+        size_t io_threads = 4; /// Threads of the pread backend.
+        size_t bytes_per_second = 0; /// Bandwidth limit, zero for unlimited.
+    };
+
+    /**
+     * @class async_io
+     * @brief Asynchronous file reads with priorities, cancellation and a bandwidth limit.
+     *
+     * read() only queues the request and returns, so it is safe to call from the frame
+     * thread. A dedicated submission thread opens the files and issues the reads in chunks,
+     * always taking the next chunk from the most urgent request, so a large low priority
+     * read never holds back a small critical one by more than one chunk. Chunks go to the
+     * kernel through io_uring or to pread threads, and every finished request is delivered
+     * to its callback on the callback thread pool, never on the thread that called read().
+     *
+     * @throws runtime_error If io_uring is requested explicitly but unavailable.
+     */
+    class async_io
+    {
+        struct request;
+        struct chunk;
+        struct ring;
+        struct later_first
+        {
+            bool operator()(const shared_ptr<request>& a, const shared_ptr<request>& b) const;
+        };
+
+        thread_pool& callbacks_; /// Runs the completion callbacks.
+        async_io_options options_; /// Settings, backend resolved.
+        unique_ptr<ring> ring_; /// io_uring instance, null for the pread backend.
+        unique_ptr<thread_pool> io_threads_; /// pread workers, null for the io_uring backend.
+
+        mutable mutex mutex_; /// Guards every member below.
+        condition_variable wake_; /// Wakes the submission thread.
+        condition_variable idle_; /// Signalled when the last request finishes.
+        priority_queue<shared_ptr<request>, vector<shared_ptr<request>>, later_first> queue_; /// Requests with unissued chunks.
+        unordered_map<uint64_t, shared_ptr<request>> active_; /// Unfinished requests by identifier.
+        vector<chunk*> retries_; /// io_uring chunks with a short read, to be resubmitted.
+        bandwidth_limiter limiter_; /// Throttles the issued chunks.
+        uint64_t next_id_; /// Identifier of the next request.
+        size_t in_flight_; /// Chunks issued and not yet completed.
+        size_t running_callbacks_; /// Callbacks submitted and not yet returned.
+        bool paused_; /// Set by pause().
+        bool stopping_; /// Set once the destructor starts.
+
+        thread submitter_; /// Issues the queued chunks.
+        thread reaper_; /// Collects io_uring completions.
+
+        void submit_loop();
+        void reap_loop();
+        void issue(chunk* piece);
+        void complete(chunk* piece, ptrdiff_t result);
+        void finish_if_done(const shared_ptr<request>& target);
+
+    public:
+        /**
+         * @brief Starts the submission thread and the chosen backend.
+         *
+         * @param callbacks Pool running the completion callbacks.
+         * @param options Backend, queue depth, chunk size and bandwidth settings.
+         */
+        explicit async_io(thread_pool& callbacks = thread_pool::global(), const async_io_options& options = {});
+
+        async_io(const async_io& other) = delete;
+        async_io& operator=(const async_io& other) = delete;
+
+        /**
+         * @brief Cancels the queued requests, waits for the reads in flight and their callbacks.
+         */
+        ~async_io();
+
+        /**
+         * @brief Returns the backend in use.
+         *
+         * @return io_backend::io_uring or io_backend::pread.
+         */
+        [[nodiscard]] io_backend backend() const;
+
+        /**
+         * @brief Queues a read of a byte range of a file.
+         *
+         * @param path Path of the file.
+         * @param offset First byte to read.
+         * @param size Number of bytes to read, string::npos for the rest of the file.
+         * @param priority Scheduling class, requests of one class are served in FIFO order.
+         * @param callback Receives the result on the callback pool.
+         * @return Identifier of the request, never zero.
+         * @throws invalid_argument If callback is empty.
+         */
+        uint64_t read(const string& path, size_t offset, size_t size, io_priority priority, io_callback callback);
+
+        /**
+         * @brief Queues a read of a whole file.
+         *
+         * @param path Path of the file.
+         * @param priority Scheduling class.
+         * @param callback Receives the result on the callback pool.
+         * @return Identifier of the request.
+         */
+        uint64_t read(const string& path, io_priority priority, io_callback callback);
+
+        /**
+         * @brief Cancels a request. Its callback receives io_status::cancelled.
+         *
+         * A request that is still queued is dropped at once. For one with chunks in flight
+         * the remaining chunks are not issued and the data read is discarded.
+         *
+         * @param request Identifier returned by read().
+         * @return False if the request already finished or was unknown.
+         */
+        bool cancel(uint64_t request);
+
+        /**
+         * @brief Stops issuing new chunks. Chunks in flight still complete.
+         */
+        void pause();
+
+        /**
+         * @brief Resumes issuing chunks after pause().
+         */
+        void resume();
+
+        /**
+         * @brief Changes the bandwidth limit.
+         *
+         * @param bytes_per_second New limit, zero for unlimited.
+         */
+        void set_bandwidth(size_t bytes_per_second);
+
+        /**
+         * @brief Returns the number of unfinished requests.
+         *
+         * @return Requests queued or in flight.
+         */
+        [[nodiscard]] size_t pending() const;
+
+        /**
+         * @brief Blocks until every request finished and its callback returned.
+         *
+         * Must not be called from a callback.
+         */
+        void wait_idle();
+    };
+} // engine_lib
+
+#endif //ASYNC_IO_HPP
@@ -0,0 +1,136 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "checksum.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr uint64_t prime1 = 11400714785074694791ull;
+        constexpr uint64_t prime2 = 14029467366897019727ull;
+        constexpr uint64_t prime3 = 1609587929392839161ull;
+        constexpr uint64_t prime4 = 9650029242287828579ull;
+        constexpr uint64_t prime5 = 2870177450012600261ull;
+
+        uint64_t rotate_left(uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        // the format is little-endian, which every supported target is
+        uint64_t read64(const unsigned char* data)
+        {
+            uint64_t value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        uint32_t read32(const unsigned char* data)
+        {
+            uint32_t value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        uint64_t lane_round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * prime2;
+            return rotate_left(accumulator, 31) * prime1;
+        }
+
+        uint64_t merge_round(uint64_t hash, uint64_t lane)
+        {
+            hash ^= lane_round(0, lane);
+            return hash * prime1 + prime4;
+        }
+
+        void consume(uint64_t* lanes, const unsigned char* data)
+        {
+            for (size_t i(0); i < 4; ++i)
+                lanes[i] = lane_round(lanes[i], read64(data + 8 * i));
+        }
+    }
+
+    checksum64::checksum64(uint64_t seed)
+        : lanes_{seed + prime1 + prime2, seed + prime2, seed, seed - prime1},
+          buffer_(),
+          buffered_(0),
+          length_(0),
+          seed_(seed)
+    {
+    }
+
+    void checksum64::update(const void* data, size_t size)
+    {
+        const unsigned char* bytes(static_cast<const unsigned char*>(data));
+        length_ += size;
+
+        if (buffered_ > 0)
+        {
+            const size_t taken(min(size, sizeof(buffer_) - buffered_));
+            memcpy(buffer_ + buffered_, bytes, taken);
+            buffered_ += taken;
+            bytes += taken;
+            size -= taken;
+            if (buffered_ < sizeof(buffer_))
+                return;
+            consume(lanes_, buffer_);
+            buffered_ = 0;
+        }
+
+        uint64_t lanes[4] = {lanes_[0], lanes_[1], lanes_[2], lanes_[3]};
+        for (; size >= 32; bytes += 32, size -= 32)
+            consume(lanes, bytes);
+        memcpy(lanes_, lanes, sizeof(lanes));
+
+        memcpy(buffer_, bytes, size);
+        buffered_ = size;
+    }
+
+    uint64_t checksum64::digest() const
+    {
+        uint64_t hash;
+        if (length_ >= 32)
+        {
+            hash = rotate_left(lanes_[0], 1) + rotate_left(lanes_[1], 7) +
+                rotate_left(lanes_[2], 12) + rotate_left(lanes_[3], 18);
+            for (uint64_t lane : lanes_)
+                hash = merge_round(hash, lane);
+        }
+        else
+            hash = seed_ + prime5;
+        hash += length_;
+
+        const unsigned char* tail(buffer_);
+        size_t size(buffered_);
+        for (; size >= 8; tail += 8, size -= 8)
+            hash = rotate_left(hash ^ lane_round(0, read64(tail)), 27) * prime1 + prime4;
+        if (size >= 4)
+        {
+            hash = rotate_left(hash ^ uint64_t(read32(tail)) * prime1, 23) * prime2 + prime3;
+            tail += 4;
+            size -= 4;
+        }
+        for (; size > 0; ++tail, --size)
+            hash = rotate_left(hash ^ uint64_t(*tail) * prime5, 11) * prime1;
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    uint64_t compute_checksum64(const void* data, size_t size, uint64_t seed)
+    {
+        checksum64 checksum(seed);
+        checksum.update(data, size);
+        return checksum.digest();
+    }
+} // engine_lib
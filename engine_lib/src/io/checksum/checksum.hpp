@@ -0,0 +1,67 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef CHECKSUM_HPP
+#define CHECKSUM_HPP
+#include "../../includes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class checksum64
+     * @brief Incremental 64-bit XXH64 hash for verifying stored data.
+     *
+     * XXH64 consumes 32 bytes per step in four independent lanes and runs close to
+     * memory bandwidth, so checking gigabytes of mapped geometry stays cheap. The digest
+     * only depends on the bytes, not on how they were split across update() calls.
+     */
+    class checksum64
+    {
+        uint64_t lanes_[4]; /// Accumulators of the four lanes.
+        unsigned char buffer_[32]; /// Bytes of an incomplete step.
+        size_t buffered_; /// Number of bytes in buffer_.
+        uint64_t length_; /// Total number of bytes hashed.
+        uint64_t seed_; /// Seed the hash was started with.
+
+    public:
+        /**
+         * @brief Starts a new hash.
+         *
+         * @param seed Seed of the hash.
+         */
+        explicit checksum64(uint64_t seed = 0);
+
+        /**
+         * @brief Hashes more bytes.
+         *
+         * @param data First byte.
+         * @param size Number of bytes.
+         */
+        void update(const void* data, size_t size);
+
+        /**
+         * @brief Returns the hash of all bytes passed so far. Hashing may continue afterwards.
+         *
+         * @return The 64-bit hash.
+         */
+        [[nodiscard]] uint64_t digest() const;
+    };
+
+    /**
+     * @brief Computes the XXH64 hash of a buffer.
+     *
+     * @param data First byte.
+     * @param size Number of bytes.
+     * @param seed Seed of the hash.
+     * @return The 64-bit hash.
+     */
+    uint64_t compute_checksum64(const void* data, size_t size, uint64_t seed = 0);
+} // engine_lib
+
+#endif //CHECKSUM_HPP
@@ -0,0 +1,337 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "hot_reload.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace engine_lib
+{
+    namespace
+    {
+        // absolute and without . or .. parts, so inotify names and watched paths compare equal
+        string normalized(const string& path)
+        {
+            return filesystem::absolute(filesystem::path(path)).lexically_normal().string();
+        }
+
+        // modification time and size, or -1 for a file that cannot be read
+        array<int64_t, 2> stamp_of(const string& path)
+        {
+            error_code error;
+            const auto time(filesystem::last_write_time(path, error));
+            if (error)
+                return {-1, -1};
+            const auto size(filesystem::file_size(path, error));
+            if (error)
+                return {-1, -1};
+            return {int64_t(time.time_since_epoch().count()), int64_t(size)};
+        }
+    }
+
+#if defined(__linux__)
+    /*
+     * One inotify instance watching the directories of the files, and an eventfd that wakes
+     * the watcher thread when the reloader is destroyed.
+     */
+    struct hot_reloader::monitor
+    {
+        int descriptor = -1;
+        int wake = -1;
+        unordered_map<int, string> directories; /// Directory of every watch descriptor.
+        unordered_map<string, int> watches; /// Watch descriptor of every directory.
+
+        monitor()
+        {
+            descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (descriptor < 0)
+                throw runtime_error(string("inotify is unavailable: ") + strerror(errno));
+            wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (wake < 0)
+            {
+                ::close(descriptor);
+                throw runtime_error(string("Cannot create an eventfd: ") + strerror(errno));
+            }
+        }
+
+        monitor(const monitor& other) = delete;
+        monitor& operator=(const monitor& other) = delete;
+
+        ~monitor()
+        {
+            ::close(wake);
+            ::close(descriptor);
+        }
+
+        void watch(const string& directory)
+        {
+            if (watches.count(directory) != 0)
+                return;
+            // writes finish with a close, saves through a temporary file with a rename
+            const int watch(inotify_add_watch(descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO));
+            if (watch < 0)
+                throw runtime_error("Cannot watch directory " + directory + ": " + strerror(errno));
+            watches.emplace(directory, watch);
+            directories.emplace(watch, directory);
+        }
+    };
+#else
+    struct hot_reloader::monitor
+    {
+        monitor()
+        {
+            throw runtime_error("inotify is unavailable on this platform");
+        }
+
+        void watch(const string&)
+        {
+        }
+    };
+#endif
+
+    hot_reloader::hot_reloader(const hot_reload_options& options)
+        : options_(options), reloads_(0), stopping_(false)
+    {
+        if (options_.settle.count() < 0 || options_.poll_interval.count() <= 0)
+            throw invalid_argument("Hot reload intervals out of range");
+        if (options_.backend != watch_backend::polling)
+        {
+            try
+            {
+                monitor_ = make_unique<monitor>();
+                options_.backend = watch_backend::inotify;
+            }
+            catch (const runtime_error&)
+            {
+                if (options_.backend == watch_backend::inotify)
+                    throw;
+                options_.backend = watch_backend::polling;
+            }
+        }
+        watcher_ = thread([this] { watch_loop(); });
+    }
+
+    hot_reloader::~hot_reloader()
+    {
+        {
+            lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+#if defined(__linux__)
+        if (monitor_)
+        {
+            const uint64_t one(1);
+            static_cast<void>(::write(monitor_->wake, &one, sizeof(one)));
+        }
+#endif
+        watcher_.join();
+    }
+
+    watch_backend hot_reloader::backend() const
+    {
+        return options_.backend;
+    }
+
+    shared_ptr<detail::reload_slot> hot_reloader::add(const string& path,
+                                                       function<shared_ptr<const void>(const string&)> load)
+    {
+        auto slot(make_shared<detail::reload_slot>());
+        slot->path = normalized(path);
+        slot->load = move(load);
+        // registered before the first load, so a change during it is not missed
+        {
+            lock_guard lock(mutex_);
+            if (monitor_)
+                monitor_->watch(filesystem::path(slot->path).parent_path().string());
+            else if (stamps_.count(slot->path) == 0)
+                stamps_.emplace(slot->path, stamp_of(slot->path));
+            slots_[slot->path].push_back(slot);
+        }
+        try
+        {
+            slot->current = slot->load(slot->path);
+        }
+        catch (...)
+        {
+            lock_guard lock(mutex_);
+            auto& slots(slots_[slot->path]);
+            slots.erase(find(slots.begin(), slots.end(), slot));
+            if (slots.empty())
+            {
+                slots_.erase(slot->path);
+                stamps_.erase(slot->path);
+            }
+            throw;
+        }
+        return slot;
+    }
+
+    void hot_reloader::watch_loop()
+    {
+        using clock = chrono::steady_clock;
+        unordered_map<string, clock::time_point> changed; // last change of every file not yet re-read
+        clock::time_point next_scan(clock::now() + options_.poll_interval);
+        while (!stopping_)
+        {
+            // sleep until the next scan or the first file to settle
+            clock::time_point deadline(monitor_ ? clock::now() + chrono::seconds(1) : next_scan);
+            for (const auto& [path, time] : changed)
+                deadline = min(deadline, time + options_.settle);
+            const auto timeout(max(chrono::duration_cast<chrono::milliseconds>(deadline - clock::now()),
+                                   chrono::milliseconds(0)));
+
+#if defined(__linux__)
+            if (monitor_)
+            {
+                pollfd descriptors[2]{{monitor_->descriptor, POLLIN, 0}, {monitor_->wake, POLLIN, 0}};
+                // rounded up, so a settling file is not polled for again and again with a zero timeout
+                if (::poll(descriptors, 2, int(timeout.count()) + 1) > 0 && (descriptors[0].revents & POLLIN) != 0)
+                {
+                    alignas(inotify_event) char buffer[4096];
+                    ssize_t size;
+                    while ((size = ::read(monitor_->descriptor, buffer, sizeof(buffer))) > 0)
+                    {
+                        const auto now(clock::now());
+                        lock_guard lock(mutex_);
+                        for (ssize_t offset(0); offset < size;)
+                        {
+                            const auto* event(reinterpret_cast<const inotify_event*>(buffer + offset));
+                            offset += ssize_t(sizeof(inotify_event) + event->len);
+                            if ((event->mask & IN_Q_OVERFLOW) != 0)
+                            {
+                                // events were lost, every file may have changed
+                                for (const auto& [path, slots] : slots_)
+                                    changed[path] = now;
+                                continue;
+                            }
+                            const auto directory(monitor_->directories.find(event->wd));
+                            if (event->len == 0 || directory == monitor_->directories.end())
+                                continue;
+                            const string path((filesystem::path(directory->second) / event->name).string());
+                            if (slots_.count(path) != 0)
+                                changed[path] = now;
+                        }
+                    }
+                }
+            }
+            else
+#endif
+            {
+                unique_lock lock(mutex_);
+                wake_.wait_for(lock, timeout, [this] { return stopping_.load(); });
+            }
+            if (stopping_)
+                break;
+
+            if (!monitor_ && clock::now() >= next_scan)
+            {
+                vector<pair<string, array<int64_t, 2>>> files;
+                {
+                    lock_guard lock(mutex_);
+                    files.assign(stamps_.begin(), stamps_.end());
+                }
+                const auto now(clock::now());
+                for (auto& [path, stamp] : files)
+                {
+                    const auto current(stamp_of(path));
+                    if (current == stamp)
+                        continue;
+                    changed[path] = now;
+                    lock_guard lock(mutex_);
+                    stamps_[path] = current;
+                }
+                next_scan = clock::now() + options_.poll_interval;
+            }
+
+            const auto now(clock::now());
+            for (auto entry(changed.begin()); entry != changed.end() && !stopping_;)
+                if (now - entry->second >= options_.settle)
+                {
+                    reload(entry->first);
+                    entry = changed.erase(entry);
+                }
+                else
+                    ++entry;
+        }
+    }
+
+    void hot_reloader::reload(const string& path)
+    {
+        vector<shared_ptr<detail::reload_slot>> targets;
+        {
+            lock_guard lock(mutex_);
+            const auto found(slots_.find(path));
+            if (found == slots_.end())
+                return;
+            targets = found->second;
+        }
+        for (const auto& slot : targets)
+        {
+            // the loader runs unlocked, apply() and watch() go on meanwhile
+            try
+            {
+                auto version(slot->load(path));
+                lock_guard lock(mutex_);
+                const auto queued(find_if(pending_.begin(), pending_.end(),
+                                          [&](const auto& entry) { return entry.first == slot; }));
+                if (queued != pending_.end())
+                    queued->second = move(version);
+                else
+                    pending_.emplace_back(slot, move(version));
+                ++reloads_;
+            }
+            catch (const exception& error)
+            {
+                lock_guard lock(mutex_);
+                errors_.push_back(path + ": " + error.what());
+            }
+        }
+    }
+
+    size_t hot_reloader::apply()
+    {
+        vector<pair<shared_ptr<detail::reload_slot>, shared_ptr<const void>>> ready;
+        {
+            lock_guard lock(mutex_);
+            ready.swap(pending_);
+        }
+        for (auto& [slot, version] : ready)
+        {
+            slot->current = move(version);
+            ++slot->version;
+        }
+        return ready.size();
+    }
+
+    vector<string> hot_reloader::take_errors()
+    {
+        lock_guard lock(mutex_);
+        vector<string> result;
+        result.swap(errors_);
+        return result;
+    }
+
+    size_t hot_reloader::pending() const
+    {
+        lock_guard lock(mutex_);
+        return pending_.size();
+    }
+
+    size_t hot_reloader::reloads() const
+    {
+        lock_guard lock(mutex_);
+        return reloads_;
+    }
+} // engine_lib
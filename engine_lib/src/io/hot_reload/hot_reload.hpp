@@ -0,0 +1,212 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef HOT_RELOAD_HPP
+#define HOT_RELOAD_HPP
+#include "../../includes.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Mechanism used to notice changed files.
+     */
+    enum class watch_backend
+    {
+        automatic, //!< inotify where the kernel offers it, polling otherwise.
+        inotify, //!< Linux inotify on the directories of the watched files.
+        polling //!< Periodic comparison of the modification time and size of every watched file.
+    };
+
+    /**
+     * @brief Settings of a hot_reloader.
+     */
+    struct hot_reload_options
+    {
+        watch_backend backend = watch_backend::automatic; /// Requested backend.
+        chrono::milliseconds settle{50}; /// Quiet time after the last change of a file before it is re-read.
+        chrono::milliseconds poll_interval{250}; /// Time between two scans of the polling backend.
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief A watched file and the live version of the asset loaded from it.
+         */
+        struct reload_slot
+        {
+            string path; /// Absolute, normalized path of the file.
+            function<shared_ptr<const void>(const string&)> load; /// Reads the file, type erased.
+            shared_ptr<const void> current; /// Live version, replaced by hot_reloader::apply().
+            uint64_t version = 0; /// Number of reloads applied.
+        };
+    }
+
+    /**
+     * @class hot_asset
+     * @brief Handle of an asset kept up to date by a hot_reloader.
+     *
+     * The handle reads the live version, which only hot_reloader::apply() replaces. Between
+     * two apply() calls every read returns the same object, so code running during a frame
+     * sees one consistent version; pin() keeps a version alive past the next apply().
+     */
+    template <class T>
+    class hot_asset
+    {
+        shared_ptr<detail::reload_slot> slot_; /// The watched file.
+
+    public:
+        hot_asset() = default;
+        explicit hot_asset(shared_ptr<detail::reload_slot> slot);
+
+        /**
+         * @brief Returns the live version.
+         *
+         * @return The asset.
+         * @throws logic_error If the handle is empty.
+         */
+        [[nodiscard]] const T& get() const;
+
+        /**
+         * @brief Shares the live version, which stays valid after later reloads.
+         *
+         * @return The asset.
+         * @throws logic_error If the handle is empty.
+         */
+        [[nodiscard]] shared_ptr<const T> pin() const;
+
+        [[nodiscard]] const T& operator*() const;
+        [[nodiscard]] const T* operator->() const;
+        [[nodiscard]] uint64_t version() const;
+        [[nodiscard]] const string& path() const;
+        [[nodiscard]] bool empty() const;
+    };
+
+    /**
+     * @class hot_reloader
+     * @brief Re-reads changed scene, asset and configuration files on a background thread.
+     *
+     * Every watched file has its own loader, and a change only re-runs the loaders of that
+     * file. The watcher thread waits until a file stayed unchanged for the settle time, so
+     * an editor writing in several steps costs one reload, then loads the new version and
+     * queues it. apply(), called by the frame thread between two frames, makes all queued
+     * versions live at once; a version that failed to load is dropped and reported by
+     * take_errors(), and the previous one stays live.
+     *
+     * The inotify backend watches the directories of the files, so saves that write a new
+     * file and rename it over the old one are seen as well. Assets mapping their file, such
+     * as scene_file, must be replaced that way rather than rewritten in place.
+     *
+     * @throws runtime_error If inotify is requested explicitly but unavailable.
+     */
+    class hot_reloader
+    {
+        struct monitor;
+
+        hot_reload_options options_; /// Settings, backend resolved.
+        unique_ptr<monitor> monitor_; /// inotify instance, null for the polling backend.
+
+        mutable mutex mutex_; /// Guards every member below.
+        condition_variable wake_; /// Wakes the watcher thread of the polling backend.
+        unordered_map<string, vector<shared_ptr<detail::reload_slot>>> slots_; /// Watched files by path.
+        unordered_map<string, array<int64_t, 2>> stamps_; /// Modification time and size of every file, for polling.
+        vector<pair<shared_ptr<detail::reload_slot>, shared_ptr<const void>>> pending_; /// Loaded versions awaiting apply().
+        vector<string> errors_; /// Failed reloads since the last take_errors().
+        size_t reloads_; /// Versions loaded by the watcher thread.
+
+        atomic<bool> stopping_; /// Set once the destructor starts.
+        thread watcher_; /// Waits for changes and runs the loaders.
+
+        shared_ptr<detail::reload_slot> add(const string& path, function<shared_ptr<const void>(const string&)> load);
+        void watch_loop();
+        void reload(const string& path);
+
+    public:
+        /**
+         * @brief Starts the watcher thread and the chosen backend.
+         *
+         * @param options Backend and timing settings.
+         * @throws invalid_argument If the settle time is negative or the poll interval not positive.
+         */
+        explicit hot_reloader(const hot_reload_options& options = {});
+
+        hot_reloader(const hot_reloader& other) = delete;
+        hot_reloader& operator=(const hot_reloader& other) = delete;
+
+        /**
+         * @brief Stops the watcher thread; versions not yet applied are dropped.
+         */
+        ~hot_reloader();
+
+        /**
+         * @brief Returns the backend in use.
+         *
+         * @return watch_backend::inotify or watch_backend::polling.
+         */
+        [[nodiscard]] watch_backend backend() const;
+
+        /**
+         * @brief Loads a file on the calling thread and watches it for changes.
+         *
+         * The same file may be watched by several handles with different loaders.
+         *
+         * @param path Path of the file; its directory must exist.
+         * @param load Reads the file at the given path. Runs on the watcher thread for reloads.
+         * @return Handle of the asset.
+         * @throws invalid_argument If load is empty.
+         * @throws runtime_error If the directory of the file cannot be watched.
+         * Exceptions of the first load are passed on.
+         */
+        template <class T>
+        hot_asset<T> watch(const string& path, function<T(const string&)> load);
+
+        /**
+         * @brief Makes every version loaded since the last call live, all at once.
+         *
+         * Call it from the frame thread between two frames, while nothing reads the assets.
+         *
+         * @return Number of assets replaced.
+         */
+        size_t apply();
+
+        /**
+         * @brief Returns the reload failures since the last call.
+         *
+         * @return One message per failure, naming the file.
+         */
+        vector<string> take_errors();
+
+        /**
+         * @brief Returns the number of versions awaiting apply().
+         *
+         * @return Loaded versions not yet live.
+         */
+        [[nodiscard]] size_t pending() const;
+
+        /**
+         * @brief Returns the number of versions loaded by the watcher thread so far.
+         *
+         * @return Successful reloads, applied or not.
+         */
+        [[nodiscard]] size_t reloads() const;
+    };
+} // engine_lib
+
+#endif //HOT_RELOAD_HPP
+#include "hot_reload.inl"
@@ -0,0 +1,72 @@
+#ifndef HOT_RELOAD_INL
+#define HOT_RELOAD_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    hot_asset<T>::hot_asset(shared_ptr<detail::reload_slot> slot) : slot_(move(slot))
+    {
+    }
+
+    template <class T>
+    const T& hot_asset<T>::get() const
+    {
+        if (!slot_)
+            throw logic_error("Empty hot asset handle");
+        return *static_cast<const T*>(slot_->current.get());
+    }
+
+    template <class T>
+    shared_ptr<const T> hot_asset<T>::pin() const
+    {
+        if (!slot_)
+            throw logic_error("Empty hot asset handle");
+        return static_pointer_cast<const T>(slot_->current);
+    }
+
+    template <class T>
+    const T& hot_asset<T>::operator*() const
+    {
+        return get();
+    }
+
+    template <class T>
+    const T* hot_asset<T>::operator->() const
+    {
+        return &get();
+    }
+
+    template <class T>
+    uint64_t hot_asset<T>::version() const
+    {
+        return slot_ ? slot_->version : 0;
+    }
+
+    template <class T>
+    const string& hot_asset<T>::path() const
+    {
+        static const string none;
+        return slot_ ? slot_->path : none;
+    }
+
+    template <class T>
+    bool hot_asset<T>::empty() const
+    {
+        return !slot_;
+    }
+
+    template <class T>
+    hot_asset<T> hot_reloader::watch(const string& path, function<T(const string&)> load)
+    {
+        if (!load)
+            throw invalid_argument("A watched file needs a loader");
+        return hot_asset<T>(add(path, [load = move(load)](const string& file) -> shared_ptr<const void>
+        {
+            return make_shared<const T>(load(file));
+        }));
+    }
+} // engine_lib
+
+#endif //HOT_RELOAD_INL
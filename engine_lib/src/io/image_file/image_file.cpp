@@ -0,0 +1,171 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "image_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace engine_lib
+{
+    namespace
+    {
+        void check_size(size_t width, size_t height, size_t size)
+        {
+            if (width == 0 || height == 0 || size != width * height * 3)
+                throw invalid_argument("Image data does not match its dimensions");
+        }
+
+        uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+        {
+            static const array<uint32_t, 256> table = []
+            {
+                array<uint32_t, 256> entries{};
+                for (uint32_t i(0); i < 256; ++i)
+                {
+                    uint32_t value(i);
+                    for (int bit(0); bit < 8; ++bit)
+                        value = (value & 1) != 0 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                    entries[i] = value;
+                }
+                return entries;
+            }();
+            crc = ~crc;
+            for (size_t i(0); i < size; ++i)
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        void append_big_endian(vector<uint8_t>& out, uint32_t value)
+        {
+            for (int shift(24); shift >= 0; shift -= 8)
+                out.push_back(uint8_t(value >> shift));
+        }
+
+        void append_chunk(vector<uint8_t>& out, const char* type, const vector<uint8_t>& payload)
+        {
+            append_big_endian(out, uint32_t(payload.size()));
+            const size_t start(out.size());
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), payload.begin(), payload.end());
+            append_big_endian(out, crc32(out.data() + start, out.size() - start));
+        }
+
+        void write_file(const string& path, const void* data, size_t size)
+        {
+            ofstream file(path, ios::binary);
+            file.write(static_cast<const char*>(data), streamsize(size));
+            if (!file)
+                throw runtime_error("Cannot write file: " + path);
+        }
+    }
+
+    void write_png(const string& path, size_t width, size_t height, const vector<uint8_t>& rgb)
+    {
+        check_size(width, height, rgb.size());
+
+        vector<uint8_t> header;
+        append_big_endian(header, uint32_t(width));
+        append_big_endian(header, uint32_t(height));
+        header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bit RGB, deflate, no filter, no interlace
+
+        // every row starts with filter type 0, then the zlib stream stores it in 64 KiB blocks
+        const size_t row(width * 3);
+        vector<uint8_t> raw;
+        raw.reserve(height * (row + 1));
+        for (size_t y(0); y < height; ++y)
+        {
+            raw.push_back(0);
+            raw.insert(raw.end(), rgb.begin() + ptrdiff_t(y * row), rgb.begin() + ptrdiff_t((y + 1) * row));
+        }
+
+        vector<uint8_t> compressed{0x78, 0x01};
+        compressed.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+        uint32_t a(1), b(0);
+        for (size_t first(0); first < raw.size(); first += 65535)
+        {
+            const size_t size(min<size_t>(65535, raw.size() - first));
+            compressed.push_back(first + size == raw.size() ? 1 : 0);
+            compressed.insert(compressed.end(), {uint8_t(size), uint8_t(size >> 8), uint8_t(~size), uint8_t(~size >> 8)});
+            compressed.insert(compressed.end(), raw.begin() + ptrdiff_t(first), raw.begin() + ptrdiff_t(first + size));
+            for (size_t i(first); i < first + size; ++i)
+            {
+                a = (a + raw[i]) % 65521;
+                b = (b + a) % 65521;
+            }
+        }
+        append_big_endian(compressed, (b << 16) | a);
+
+        vector<uint8_t> file{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        append_chunk(file, "IHDR", header);
+        append_chunk(file, "IDAT", compressed);
+        append_chunk(file, "IEND", {});
+        write_file(path, file.data(), file.size());
+    }
+
+    void write_pfm(const string& path, size_t width, size_t height, const vector<float>& rgb)
+    {
+        check_size(width, height, rgb.size());
+
+        // a negative scale marks little endian data, rows are stored from the bottom up
+        const uint16_t probe(1);
+        uint8_t first_byte;
+        memcpy(&first_byte, &probe, 1);
+        const string header("PF\n" + to_string(width) + " " + to_string(height) + "\n" +
+                            (first_byte == 1 ? "-1.0" : "1.0") + "\n");
+
+        vector<char> file(header.begin(), header.end());
+        const size_t row(width * 3 * sizeof(float));
+        file.resize(header.size() + height * row);
+        for (size_t y(0); y < height; ++y)
+            memcpy(file.data() + header.size() + (height - 1 - y) * row, rgb.data() + y * width * 3, row);
+        write_file(path, file.data(), file.size());
+    }
+
+    vector<float> read_pfm(const string& path, size_t& width, size_t& height)
+    {
+        ifstream file(path, ios::binary);
+        string magic;
+        double scale(0);
+        file >> magic >> width >> height >> scale;
+        if (!file || magic != "PF" || width == 0 || height == 0 || scale == 0)
+            throw runtime_error("Not an RGB PFM file: " + path);
+        file.get();
+
+        vector<float> rgb(width * height * 3);
+        const size_t row(width * 3);
+        for (size_t y(0); y < height; ++y)
+            file.read(reinterpret_cast<char*>(rgb.data() + (height - 1 - y) * row), streamsize(row * sizeof(float)));
+        if (!file)
+            throw runtime_error("Truncated PFM file: " + path);
+
+        const uint16_t probe(1);
+        uint8_t first_byte;
+        memcpy(&first_byte, &probe, 1);
+        if ((scale < 0) != (first_byte == 1))
+            for (float& value : rgb)
+            {
+                uint8_t bytes[4];
+                memcpy(bytes, &value, 4);
+                reverse(bytes, bytes + 4);
+                memcpy(&value, bytes, 4);
+            }
+        return rgb;
+    }
+
+    vector<uint8_t> linear_to_srgb8(const vector<float>& rgb, float exposure)
+    {
+        vector<uint8_t> result(rgb.size());
+        for (size_t i(0); i < rgb.size(); ++i)
+        {
+            const float linear(clamp(rgb[i] * exposure, 0.0f, 1.0f));
+            const float encoded(linear <= 0.0031308f ? linear * 12.92f : 1.055f * pow(linear, 1 / 2.4f) - 0.055f);
+            result[i] = uint8_t(lround(encoded * 255.0f));
+        }
+        return result;
+    }
+} // engine_lib
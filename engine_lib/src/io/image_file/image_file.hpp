@@ -0,0 +1,66 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef IMAGE_FILE_HPP
+#define IMAGE_FILE_HPP
+#include "../../includes.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Writes an 8 bit RGB image as PNG.
+     *
+     * The pixel data is stored in uncompressed deflate blocks, so no compression library is
+     * needed; every PNG reader accepts the result.
+     *
+     * @param path Path of the file.
+     * @param width Width in pixels.
+     * @param height Height in pixels.
+     * @param rgb width * height * 3 bytes, rows from top to bottom.
+     * @throws invalid_argument If rgb has the wrong size.
+     * @throws runtime_error If the file cannot be written.
+     */
+    void write_png(const string& path, size_t width, size_t height, const vector<uint8_t>& rgb);
+
+    /**
+     * @brief Writes a linear floating point RGB image as PFM (portable float map).
+     *
+     * @param path Path of the file.
+     * @param width Width in pixels.
+     * @param height Height in pixels.
+     * @param rgb width * height * 3 floats, rows from top to bottom.
+     * @throws invalid_argument If rgb has the wrong size.
+     * @throws runtime_error If the file cannot be written.
+     */
+    void write_pfm(const string& path, size_t width, size_t height, const vector<float>& rgb);
+
+    /**
+     * @brief Reads an RGB PFM file, either byte order.
+     *
+     * @param path Path of the file.
+     * @param width Receives the width in pixels.
+     * @param height Receives the height in pixels.
+     * @return width * height * 3 floats, rows from top to bottom.
+     * @throws runtime_error If the file cannot be read or is not an RGB PFM.
+     */
+    vector<float> read_pfm(const string& path, size_t& width, size_t& height);
+
+    /**
+     * @brief Converts linear RGB to 8 bit sRGB, clamping to [0, 1] after the exposure scale.
+     *
+     * @param rgb Linear values.
+     * @param exposure Factor applied before the conversion.
+     * @return One byte per input value.
+     */
+    vector<uint8_t> linear_to_srgb8(const vector<float>& rgb, float exposure = 1.0f);
+} // engine_lib
+
+#endif //IMAGE_FILE_HPP
@@ -0,0 +1,172 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine_lib
+{
+    namespace
+    {
+#if !defined(_WIN32)
+        // madvise needs a page aligned start
+        pair<uintptr_t, size_t> page_range(const unsigned char* data, size_t file_size, size_t offset, size_t size)
+        {
+            if (offset >= file_size)
+                return {0, 0};
+            size = min(size, file_size - offset);
+            const uintptr_t page(uintptr_t(sysconf(_SC_PAGESIZE)));
+            const uintptr_t first(uintptr_t(data + offset) & ~(page - 1));
+            return {first, size_t(uintptr_t(data + offset) + size - first)};
+        }
+#endif
+    }
+
+    mapped_file::mapped_file()
+        : data_(nullptr),
+          size_(0)
+    {
+    }
+
+    mapped_file::mapped_file(const string& path)
+        : mapped_file()
+    {
+#if defined(_WIN32)
+        HANDLE file(CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (file == INVALID_HANDLE_VALUE)
+            throw runtime_error("Cannot open file: " + path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            throw runtime_error("Cannot read the size of file: " + path);
+        }
+        size_ = size_t(size.QuadPart);
+        if (size_ > 0)
+        {
+            HANDLE mapping(CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr));
+            if (mapping != nullptr)
+            {
+                data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#else
+        const int descriptor(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (descriptor < 0)
+            throw runtime_error("Cannot open file: " + path);
+        struct stat status{};
+        if (fstat(descriptor, &status) != 0)
+        {
+            ::close(descriptor);
+            throw runtime_error("Cannot read the size of file: " + path);
+        }
+        size_ = size_t(status.st_size);
+        if (size_ > 0)
+        {
+            void* address(mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0));
+            if (address != MAP_FAILED)
+                data_ = static_cast<const unsigned char*>(address);
+        }
+        ::close(descriptor);
+#endif
+        if (size_ > 0 && data_ == nullptr)
+            throw runtime_error("Cannot map file: " + path);
+    }
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept
+        : data_(exchange(other.data_, nullptr)),
+          size_(exchange(other.size_, 0))
+    {
+    }
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            data_ = exchange(other.data_, nullptr);
+            size_ = exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    mapped_file::~mapped_file()
+    {
+        close();
+    }
+
+    void mapped_file::close()
+    {
+        if (data_ != nullptr)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const unsigned char* mapped_file::data() const
+    {
+        return data_;
+    }
+
+    size_t mapped_file::size() const
+    {
+        return size_;
+    }
+
+    void mapped_file::advise(access_pattern pattern, size_t offset, size_t size) const
+    {
+#if !defined(_WIN32)
+        const auto range(page_range(data_, size_, offset, size));
+        if (range.second == 0)
+            return;
+        int advice(MADV_NORMAL);
+        if (pattern == access_pattern::sequential)
+            advice = MADV_SEQUENTIAL;
+        else if (pattern == access_pattern::random)
+            advice = MADV_RANDOM;
+        madvise(reinterpret_cast<void*>(range.first), range.second, advice);
+#else
+        (void)pattern;
+        (void)offset;
+        (void)size;
+#endif
+    }
+
+    void mapped_file::prefetch(size_t offset, size_t size) const
+    {
+#if defined(_WIN32)
+        if (offset >= size_)
+            return;
+        WIN32_MEMORY_RANGE_ENTRY range{const_cast<unsigned char*>(data_ + offset), min(size, size_ - offset)};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        const auto range(page_range(data_, size_, offset, size));
+        if (range.second > 0)
+            madvise(reinterpret_cast<void*>(range.first), range.second, MADV_WILLNEED);
+#endif
+    }
+} // engine_lib
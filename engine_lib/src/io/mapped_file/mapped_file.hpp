@@ -0,0 +1,92 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+#include "../../includes.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Expected order of accesses to a mapped range, passed to the kernel as a paging hint.
+     */
+    enum class access_pattern
+    {
+        normal, //!< Default read-ahead.
+        sequential, //!< Aggressive read-ahead, pages may be dropped soon after use.
+        random //!< No read-ahead.
+    };
+
+    /**
+     * @class mapped_file
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * Pages are loaded by the kernel on first access, so opening is constant time
+     * regardless of the file size and untouched parts of the file are never read.
+     * Uses mmap on POSIX systems and file mappings on Windows.
+     *
+     * @throws runtime_error If the file cannot be opened or mapped.
+     */
+    class mapped_file
+    {
+        const unsigned char* data_; /// First byte of the mapping, null for closed or empty files.
+        size_t size_; /// Size of the file in bytes.
+
+    public:
+        /**
+         * @brief Default constructor. Creates a closed mapping.
+         */
+        mapped_file();
+
+        /**
+         * @brief Maps a file for reading.
+         *
+         * @param path Path of the file.
+         */
+        explicit mapped_file(const string& path);
+
+        mapped_file(const mapped_file& other) = delete;
+        mapped_file& operator=(const mapped_file& other) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~mapped_file();
+
+        /**
+         * @brief Unmaps the file. Pointers into the mapping become invalid.
+         */
+        void close();
+
+        [[nodiscard]] const unsigned char* data() const;
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief Tells the kernel how a range will be accessed. Has no effect where unsupported.
+         *
+         * @param pattern Expected access pattern.
+         * @param offset First byte of the range.
+         * @param size Size of the range, clamped to the end of the file.
+         */
+        void advise(access_pattern pattern, size_t offset = 0, size_t size = string::npos) const;
+
+        /**
+         * @brief Starts reading a range in the background, so later accesses do not fault.
+         *
+         * @param offset First byte of the range.
+         * @param size Size of the range, clamped to the end of the file.
+         */
+        void prefetch(size_t offset, size_t size) const;
+    };
+} // engine_lib
+
+#endif //MAPPED_FILE_HPP
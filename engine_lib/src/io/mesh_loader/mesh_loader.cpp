@@ -0,0 +1,1062 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_loader.hpp"
+#include "../mapped_file/mapped_file.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // bytes of text parsed by one task, chunks end at line boundaries
+        constexpr size_t text_chunk = size_t(1) << 20;
+        // binary vertex records decoded by one task
+        constexpr size_t record_chunk = 65536;
+        // chunks per pool thread parsed before stream_points() hands a window to the sink
+        constexpr size_t window_chunks = 4;
+
+        constexpr uint32_t missing = ~uint32_t(0);
+
+        struct text_range
+        {
+            const char* first;
+            const char* last;
+        };
+
+        vector<text_range> split_lines(const char* first, const char* last)
+        {
+            vector<text_range> chunks;
+            while (first != last)
+            {
+                const char* end(size_t(last - first) > text_chunk ? first + text_chunk : last);
+                if (end != last)
+                {
+                    const void* newline(memchr(end, '\n', size_t(last - end)));
+                    end = newline != nullptr ? static_cast<const char*>(newline) + 1 : last;
+                }
+                chunks.push_back({first, end});
+                first = end;
+            }
+            return chunks;
+        }
+
+        size_t count_lines(const text_range& range)
+        {
+            size_t lines(size_t(count(range.first, range.last, '\n')));
+            if (range.first != range.last && range.last[-1] != '\n')
+                ++lines;
+            return lines;
+        }
+
+        string extension_of(const string& path)
+        {
+            const size_t dot(path.find_last_of('.'));
+            string extension(dot == string::npos ? string() : path.substr(dot + 1));
+            for (char& c : extension)
+                c = char(tolower((unsigned char)c));
+            return extension;
+        }
+
+        class text_cursor
+        {
+            const char* position_; /// Next character.
+            const char* end_; /// End of the parsed range.
+            size_t line_; /// 1-based line number of position_, for error messages.
+            const char* format_; /// Name of the format, for error messages.
+
+        public:
+            text_cursor(const text_range& range, size_t line, const char* format)
+                : position_(range.first),
+                  end_(range.last),
+                  line_(line),
+                  format_(format)
+            {
+            }
+
+            [[noreturn]] void fail() const
+            {
+                throw runtime_error(string("Malformed ") + format_ + " at line " + to_string(line_));
+            }
+
+            [[nodiscard]] bool at_end() const
+            {
+                return position_ == end_;
+            }
+
+            [[nodiscard]] const char* position() const
+            {
+                return position_;
+            }
+
+            void skip_spaces()
+            {
+                while (position_ != end_ && (*position_ == ' ' || *position_ == '\t' || *position_ == '\r'))
+                    ++position_;
+            }
+
+            bool at_line_end()
+            {
+                skip_spaces();
+                return position_ == end_ || *position_ == '\n' || *position_ == '#';
+            }
+
+            void next_line()
+            {
+                const void* newline(memchr(position_, '\n', size_t(end_ - position_)));
+                position_ = newline != nullptr ? static_cast<const char*>(newline) + 1 : end_;
+                ++line_;
+            }
+
+            string_view word()
+            {
+                skip_spaces();
+                const char* first(position_);
+                while (position_ != end_ && *position_ != ' ' && *position_ != '\t' && *position_ != '\n' &&
+                    *position_ != '\r')
+                    ++position_;
+                return string_view(first, size_t(position_ - first));
+            }
+
+            template <class T>
+            T read_number()
+            {
+                skip_spaces();
+                T value(0);
+                const auto result(from_chars(position_, end_, value));
+                if (result.ec != errc())
+                    fail();
+                position_ = result.ptr;
+                return value;
+            }
+
+            bool consume(char expected)
+            {
+                if (position_ != end_ && *position_ == expected)
+                {
+                    ++position_;
+                    return true;
+                }
+                return false;
+            }
+        };
+
+        /*
+         * OBJ
+         */
+
+        struct obj_counts
+        {
+            size_t lines;
+            size_t positions;
+            size_t uvs;
+            size_t normals;
+            size_t corners;
+            size_t triangles;
+
+            obj_counts& operator+=(const obj_counts& other)
+            {
+                lines += other.lines;
+                positions += other.positions;
+                uvs += other.uvs;
+                normals += other.normals;
+                corners += other.corners;
+                triangles += other.triangles;
+                return *this;
+            }
+        };
+
+        obj_counts count_obj(const text_range& range)
+        {
+            text_cursor cursor(range, 1, "OBJ");
+            obj_counts counts{};
+            while (!cursor.at_end())
+            {
+                const string_view keyword(cursor.word());
+                if (keyword == "v")
+                    ++counts.positions;
+                else if (keyword == "vt")
+                    ++counts.uvs;
+                else if (keyword == "vn")
+                    ++counts.normals;
+                else if (keyword == "f")
+                {
+                    size_t corners(0);
+                    for (; !cursor.at_line_end(); cursor.word())
+                        ++corners;
+                    counts.corners += corners;
+                    counts.triangles += corners >= 3 ? corners - 2 : 0;
+                }
+                cursor.next_line();
+                ++counts.lines;
+            }
+            return counts;
+        }
+
+        /*
+         * Destination of one chunk: element k of a kind goes to pointer[k - base], where the
+         * base is the count of that kind before the chunk. Null pointers skip the kind.
+         */
+        struct obj_output
+        {
+            point<float, 3>* positions;
+            point<float, 2>* uvs;
+            point<float, 3>* normals;
+            array<uint32_t, 3>* corners; // position, uv and normal index of every face corner
+            array<uint32_t, 3>* triangles; // three corner numbers per triangle
+        };
+
+        // 1-based or negative OBJ index against the count elements defined so far, made 0-based
+        uint32_t read_obj_index(text_cursor& cursor, size_t count)
+        {
+            const long long value(cursor.read_number<long long>());
+            if (value == 0)
+                cursor.fail();
+            const long long resolved(value > 0 ? value - 1 : (long long)(count) + value);
+            if (resolved < 0 || resolved >= (long long)(count))
+                cursor.fail();
+            return uint32_t(resolved);
+        }
+
+        void parse_obj(const text_range& range, const obj_counts& base, const obj_output& output)
+        {
+            text_cursor cursor(range, base.lines + 1, "OBJ");
+            obj_counts at(base);
+            while (!cursor.at_end())
+            {
+                const string_view keyword(cursor.word());
+                if (keyword == "v")
+                {
+                    const float x(cursor.read_number<float>());
+                    const float y(cursor.read_number<float>());
+                    const float z(cursor.read_number<float>());
+                    if (output.positions != nullptr)
+                        output.positions[at.positions - base.positions] = point<float, 3>({x, y, z});
+                    ++at.positions;
+                }
+                else if (keyword == "vt" && output.uvs != nullptr)
+                {
+                    const float u(cursor.read_number<float>());
+                    const float v(cursor.at_line_end() ? 0.0f : cursor.read_number<float>());
+                    output.uvs[at.uvs++ - base.uvs] = point<float, 2>({u, v});
+                }
+                else if (keyword == "vn" && output.normals != nullptr)
+                {
+                    const float x(cursor.read_number<float>());
+                    const float y(cursor.read_number<float>());
+                    const float z(cursor.read_number<float>());
+                    output.normals[at.normals++ - base.normals] = point<float, 3>({x, y, z});
+                }
+                else if (keyword == "f" && output.corners != nullptr)
+                {
+                    const size_t first(at.corners);
+                    while (!cursor.at_line_end())
+                    {
+                        array<uint32_t, 3> corner({read_obj_index(cursor, at.positions), missing, missing});
+                        if (cursor.consume('/'))
+                        {
+                            if (!cursor.consume('/'))
+                            {
+                                corner[1] = read_obj_index(cursor, at.uvs);
+                                if (cursor.consume('/'))
+                                    corner[2] = read_obj_index(cursor, at.normals);
+                            }
+                            else
+                                corner[2] = read_obj_index(cursor, at.normals);
+                        }
+                        output.corners[at.corners++ - base.corners] = corner;
+                    }
+                    if (at.corners - first < 3)
+                        cursor.fail();
+                    for (size_t i(first + 1); i + 1 < at.corners; ++i)
+                        output.triangles[at.triangles++ - base.triangles] =
+                            array<uint32_t, 3>({uint32_t(first), uint32_t(i), uint32_t(i + 1)});
+                }
+                else if (keyword == "vt")
+                    ++at.uvs;
+                else if (keyword == "vn")
+                    ++at.normals;
+                cursor.next_line();
+                ++at.lines;
+            }
+        }
+
+        // exclusive prefix sums of the chunk counts, the last entry holds the totals
+        vector<obj_counts> obj_offsets(const vector<text_range>& chunks, thread_pool& pool)
+        {
+            vector<obj_counts> offsets(chunks.size() + 1, obj_counts{});
+            pool.parallel_for(0, chunks.size(), 1, [&](size_t first, size_t last)
+            {
+                for (size_t i(first); i < last; ++i)
+                    offsets[i + 1] = count_obj(chunks[i]);
+            });
+            for (size_t i(0); i < chunks.size(); ++i)
+                offsets[i + 1] += offsets[i];
+            return offsets;
+        }
+
+        struct corner_hash
+        {
+            size_t operator()(const array<uint32_t, 3>& key) const
+            {
+                uint64_t hash(key[0] * 0x9E3779B97F4A7C15ull);
+                hash ^= (key[1] + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+                hash ^= (key[2] + 0x85EBCA77C2B2AE63ull) * 0x165667B19E3779F9ull;
+                return size_t(hash ^ (hash >> 29));
+            }
+        };
+
+        /*
+         * PLY
+         */
+
+        enum class ply_format
+        {
+            ascii,
+            binary_little_endian,
+            binary_big_endian
+        };
+
+        enum class ply_type
+        {
+            int8,
+            uint8,
+            int16,
+            uint16,
+            int32,
+            uint32,
+            float32,
+            float64
+        };
+
+        struct ply_property
+        {
+            string name;
+            ply_type type; // item type for lists
+            bool is_list;
+            ply_type count_type;
+        };
+
+        struct ply_element
+        {
+            string name;
+            size_t count;
+            vector<ply_property> properties;
+        };
+
+        struct ply_header
+        {
+            ply_format format;
+            vector<ply_element> elements;
+            size_t body_offset;
+        };
+
+        // property slots read from vertex records
+        enum ply_slot
+        {
+            slot_x,
+            slot_y,
+            slot_z,
+            slot_nx,
+            slot_ny,
+            slot_nz,
+            slot_u,
+            slot_v,
+            slot_count
+        };
+
+        struct ply_vertex_layout
+        {
+            array<int, slot_count> property; // property index per slot, -1 if absent
+            vector<int> slot; // slot per property, -1 if the property is skipped
+            vector<size_t> offsets; // byte offset of every property in a binary record
+            size_t record_size;
+        };
+
+        size_t type_size(ply_type type)
+        {
+            switch (type)
+            {
+            case ply_type::int8:
+            case ply_type::uint8:
+                return 1;
+            case ply_type::int16:
+            case ply_type::uint16:
+                return 2;
+            case ply_type::int32:
+            case ply_type::uint32:
+            case ply_type::float32:
+                return 4;
+            case ply_type::float64:
+                return 8;
+            }
+            return 0;
+        }
+
+        ply_type parse_ply_type(string_view name)
+        {
+            if (name == "char" || name == "int8")
+                return ply_type::int8;
+            if (name == "uchar" || name == "uint8")
+                return ply_type::uint8;
+            if (name == "short" || name == "int16")
+                return ply_type::int16;
+            if (name == "ushort" || name == "uint16")
+                return ply_type::uint16;
+            if (name == "int" || name == "int32")
+                return ply_type::int32;
+            if (name == "uint" || name == "uint32")
+                return ply_type::uint32;
+            if (name == "float" || name == "float32")
+                return ply_type::float32;
+            if (name == "double" || name == "float64")
+                return ply_type::float64;
+            throw runtime_error("Unsupported PLY property type: " + string(name));
+        }
+
+        template <class T>
+        T load_scalar(const unsigned char* data, bool swap)
+        {
+            unsigned char bytes[sizeof(T)];
+            memcpy(bytes, data, sizeof(T));
+            if (swap)
+                reverse(bytes, bytes + sizeof(T));
+            T value;
+            memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+
+        double decode(const unsigned char* data, ply_type type, bool swap)
+        {
+            switch (type)
+            {
+            case ply_type::int8:
+                return load_scalar<int8_t>(data, swap);
+            case ply_type::uint8:
+                return load_scalar<uint8_t>(data, swap);
+            case ply_type::int16:
+                return load_scalar<int16_t>(data, swap);
+            case ply_type::uint16:
+                return load_scalar<uint16_t>(data, swap);
+            case ply_type::int32:
+                return load_scalar<int32_t>(data, swap);
+            case ply_type::uint32:
+                return load_scalar<uint32_t>(data, swap);
+            case ply_type::float32:
+                return load_scalar<float>(data, swap);
+            case ply_type::float64:
+                return load_scalar<double>(data, swap);
+            }
+            return 0.0;
+        }
+
+        ply_header read_ply_header(const mapped_file& file)
+        {
+            const char* text(reinterpret_cast<const char*>(file.data()));
+            text_cursor cursor({text, text + file.size()}, 1, "PLY");
+            if (cursor.word() != "ply")
+                cursor.fail();
+            cursor.next_line();
+
+            ply_header header{ply_format::ascii, {}, 0};
+            bool has_format(false);
+            for (;;)
+            {
+                if (cursor.at_end())
+                    cursor.fail();
+                const string_view keyword(cursor.word());
+                if (keyword == "format")
+                {
+                    const string_view format(cursor.word());
+                    if (format == "ascii")
+                        header.format = ply_format::ascii;
+                    else if (format == "binary_little_endian")
+                        header.format = ply_format::binary_little_endian;
+                    else if (format == "binary_big_endian")
+                        header.format = ply_format::binary_big_endian;
+                    else
+                        cursor.fail();
+                    has_format = true;
+                }
+                else if (keyword == "element")
+                {
+                    const string name(cursor.word());
+                    header.elements.push_back({name, cursor.read_number<size_t>(), {}});
+                }
+                else if (keyword == "property")
+                {
+                    if (header.elements.empty())
+                        cursor.fail();
+                    const string_view type(cursor.word());
+                    ply_property property{string(), ply_type::float32, type == "list", ply_type::uint8};
+                    if (property.is_list)
+                    {
+                        property.count_type = parse_ply_type(cursor.word());
+                        property.type = parse_ply_type(cursor.word());
+                    }
+                    else
+                        property.type = parse_ply_type(type);
+                    property.name = string(cursor.word());
+                    header.elements.back().properties.push_back(property);
+                }
+                else if (keyword == "end_header")
+                {
+                    cursor.next_line();
+                    break;
+                }
+                else if (keyword != "comment" && keyword != "obj_info" && !keyword.empty())
+                    cursor.fail();
+                cursor.next_line();
+            }
+            if (!has_format)
+                throw runtime_error("PLY header has no format line");
+            header.body_offset = size_t(cursor.position() - text);
+            return header;
+        }
+
+        ply_vertex_layout vertex_layout_of(const ply_element& element)
+        {
+            // property names accepted for every slot
+            static const vector<string_view> names[slot_count] = {
+                {"x"}, {"y"}, {"z"}, {"nx"}, {"ny"}, {"nz"},
+                {"u", "s", "texture_u"}, {"v", "t", "texture_v"}
+            };
+            ply_vertex_layout layout{};
+            layout.property.fill(-1);
+            layout.record_size = 0;
+            for (size_t p(0); p < element.properties.size(); ++p)
+            {
+                const ply_property& property(element.properties[p]);
+                if (property.is_list)
+                    throw runtime_error("PLY vertex list properties are not supported");
+                layout.offsets.push_back(layout.record_size);
+                layout.record_size += type_size(property.type);
+                layout.slot.push_back(-1);
+                for (size_t slot(0); slot < slot_count; ++slot)
+                    for (string_view name : names[slot])
+                        if (property.name == name)
+                        {
+                            layout.property[slot] = int(p);
+                            layout.slot[p] = int(slot);
+                        }
+            }
+            if (layout.property[slot_x] < 0 || layout.property[slot_y] < 0 || layout.property[slot_z] < 0)
+                throw runtime_error("PLY vertices have no x, y and z properties");
+            return layout;
+        }
+
+        vertex make_vertex(const array<float, slot_count>& values)
+        {
+            return {point<float, 3>({values[slot_x], values[slot_y], values[slot_z]}),
+                    point<float, 3>({values[slot_nx], values[slot_ny], values[slot_nz]}),
+                    point<float, 2>({values[slot_u], values[slot_v]})};
+        }
+
+        array<float, slot_count> decode_vertex(const ply_vertex_layout& layout, const vector<ply_property>& properties,
+                                               const unsigned char* record, bool swap)
+        {
+            array<float, slot_count> values{};
+            for (size_t slot(0); slot < slot_count; ++slot)
+            {
+                const int p(layout.property[slot]);
+                if (p >= 0)
+                    values[slot] = float(decode(record + layout.offsets[p], properties[p].type, swap));
+            }
+            return values;
+        }
+
+        point<float, 3> decode_position(const ply_vertex_layout& layout, const vector<ply_property>& properties,
+                                        const unsigned char* record, bool swap)
+        {
+            array<float, 3> position;
+            for (size_t slot(slot_x); slot <= slot_z; ++slot)
+            {
+                const size_t p(size_t(layout.property[slot]));
+                const unsigned char* data(record + layout.offsets[p]);
+                // the common case, read without going through double
+                if (properties[p].type == ply_type::float32 && !swap)
+                    memcpy(&position[slot], data, sizeof(float));
+                else
+                    position[slot] = float(decode(data, properties[p].type, swap));
+            }
+            return point<float, 3>(position);
+        }
+
+        array<float, slot_count> parse_vertex(text_cursor& cursor, const ply_vertex_layout& layout)
+        {
+            array<float, slot_count> values{};
+            for (int slot : layout.slot)
+            {
+                const float value(cursor.read_number<float>());
+                if (slot >= 0)
+                    values[size_t(slot)] = value;
+            }
+            return values;
+        }
+
+        // fans the polygon into triangles, checking the indices against the vertex count
+        void append_polygon(const uint32_t* polygon, size_t size, size_t vertex_count, vector<uint32_t>& indices)
+        {
+            if (size < 3)
+                throw runtime_error("PLY face has fewer than three vertices");
+            for (size_t i(0); i < size; ++i)
+                if (polygon[i] >= vertex_count)
+                    throw runtime_error("PLY face references a missing vertex");
+            for (size_t i(1); i + 1 < size; ++i)
+                indices.insert(indices.end(), {polygon[0], polygon[i], polygon[i + 1]});
+        }
+
+        bool is_index_list(const ply_property& property)
+        {
+            return property.is_list && (property.name == "vertex_indices" || property.name == "vertex_index");
+        }
+
+        /*
+         * Binary body: vertex records are fixed size and decoded in parallel, faces and
+         * unknown elements with lists are walked sequentially.
+         */
+        struct ply_binary_body
+        {
+            const unsigned char* vertices;
+            size_t vertex_count;
+            vector<uint32_t> indices;
+        };
+
+        ply_binary_body read_binary_body(const mapped_file& file, const ply_header& header, bool read_faces)
+        {
+            const bool swap(header.format == ply_format::binary_big_endian);
+            const unsigned char* position(file.data() + header.body_offset);
+            const unsigned char* end(file.data() + file.size());
+            ply_binary_body body{nullptr, 0, {}};
+            vector<uint32_t> polygon;
+
+            auto require([&](size_t bytes)
+            {
+                if (size_t(end - position) < bytes)
+                    throw runtime_error("PLY body is truncated");
+            });
+
+            for (const ply_element& element : header.elements)
+            {
+                const bool all_scalar(none_of(element.properties.begin(), element.properties.end(),
+                                              [](const ply_property& p) { return p.is_list; }));
+                if (element.name == "vertex")
+                {
+                    const ply_vertex_layout layout(vertex_layout_of(element));
+                    if (layout.record_size != 0 && element.count > size_t(end - position) / layout.record_size)
+                        throw runtime_error("PLY body is truncated");
+                    body.vertices = position;
+                    body.vertex_count = element.count;
+                    position += element.count * layout.record_size;
+                    continue;
+                }
+                if (all_scalar)
+                {
+                    size_t record(0);
+                    for (const ply_property& property : element.properties)
+                        record += type_size(property.type);
+                    if (record != 0 && element.count > size_t(end - position) / record)
+                        throw runtime_error("PLY body is truncated");
+                    position += element.count * record;
+                    continue;
+                }
+                // only the vertices are needed when streaming, nothing after them is walked
+                if (!read_faces && body.vertices != nullptr)
+                    break;
+                for (size_t i(0); i < element.count; ++i)
+                    for (const ply_property& property : element.properties)
+                    {
+                        const size_t item(type_size(property.type));
+                        if (!property.is_list)
+                        {
+                            require(item);
+                            position += item;
+                            continue;
+                        }
+                        require(type_size(property.count_type));
+                        const size_t size(size_t(decode(position, property.count_type, swap)));
+                        position += type_size(property.count_type);
+                        require(size * item);
+                        if (element.name == "face" && is_index_list(property))
+                        {
+                            polygon.resize(size);
+                            for (size_t k(0); k < size; ++k)
+                                polygon[k] = uint32_t(decode(position + k * item, property.type, swap));
+                            append_polygon(polygon.data(), size, body.vertex_count, body.indices);
+                        }
+                        position += size * item;
+                    }
+            }
+            return body;
+        }
+
+        // line ranges of the elements of an ASCII body, one record per line
+        vector<size_t> element_first_lines(const ply_header& header)
+        {
+            vector<size_t> first_lines(header.elements.size() + 1, 0);
+            for (size_t e(0); e < header.elements.size(); ++e)
+                first_lines[e + 1] = first_lines[e] + header.elements[e].count;
+            return first_lines;
+        }
+
+        size_t element_index(const ply_header& header, const string& name)
+        {
+            for (size_t e(0); e < header.elements.size(); ++e)
+                if (header.elements[e].name == name)
+                    return e;
+            return header.elements.size();
+        }
+
+        vector<size_t> chunk_first_lines(const vector<text_range>& chunks, size_t first_line, thread_pool& pool)
+        {
+            vector<size_t> lines(chunks.size() + 1, 0);
+            pool.parallel_for(0, chunks.size(), 1, [&](size_t first, size_t last)
+            {
+                for (size_t i(first); i < last; ++i)
+                    lines[i + 1] = count_lines(chunks[i]);
+            });
+            lines[0] = first_line;
+            for (size_t i(0); i < chunks.size(); ++i)
+                lines[i + 1] += lines[i];
+            return lines;
+        }
+
+        /*
+         * Calls line(cursor, body_line) for every line of the chunk, where body_line counts
+         * the lines after end_header from 0. Parsing errors report file line numbers.
+         */
+        template <class F>
+        void for_each_line(const text_range& chunk, size_t body_line, size_t header_lines, F&& line)
+        {
+            text_cursor cursor(chunk, header_lines + body_line + 1, "PLY");
+            for (; !cursor.at_end(); ++body_line)
+            {
+                line(cursor, body_line);
+                cursor.next_line();
+            }
+        }
+
+        size_t header_line_count(const mapped_file& file, const ply_header& header)
+        {
+            const char* text(reinterpret_cast<const char*>(file.data()));
+            return size_t(count(text, text + header.body_offset, '\n'));
+        }
+
+        mesh load_ascii_ply(const mapped_file& file, const ply_header& header, thread_pool& pool)
+        {
+            const char* text(reinterpret_cast<const char*>(file.data()));
+            const vector<text_range> chunks(split_lines(text + header.body_offset, text + file.size()));
+            const vector<size_t> lines(chunk_first_lines(chunks, 0, pool));
+            const vector<size_t> element_lines(element_first_lines(header));
+            const size_t header_lines(header_line_count(file, header));
+
+            const size_t vertex_element(element_index(header, "vertex"));
+            const size_t face_element(element_index(header, "face"));
+            if (vertex_element == header.elements.size())
+                throw runtime_error("PLY file has no vertex element");
+            if (lines.back() < element_lines.back())
+                throw runtime_error("PLY body is truncated");
+
+            const ply_element& vertices_element(header.elements[vertex_element]);
+            const ply_vertex_layout layout(vertex_layout_of(vertices_element));
+            const size_t first_vertex(element_lines[vertex_element]);
+            vector<vertex> vertices(vertices_element.count);
+            vector<vector<uint32_t>> chunk_indices(chunks.size());
+
+            pool.parallel_for(0, chunks.size(), 1, [&](size_t first, size_t last)
+            {
+                vector<uint32_t> polygon;
+                for (size_t c(first); c < last; ++c)
+                    for_each_line(chunks[c], lines[c], header_lines, [&](text_cursor& cursor, size_t line)
+                    {
+                        if (line >= first_vertex && line < first_vertex + vertices.size())
+                            vertices[line - first_vertex] = make_vertex(parse_vertex(cursor, layout));
+                        else if (face_element < header.elements.size() && line >= element_lines[face_element] &&
+                            line < element_lines[face_element + 1])
+                        {
+                            polygon.clear();
+                            for (const ply_property& property : header.elements[face_element].properties)
+                            {
+                                if (!property.is_list)
+                                {
+                                    cursor.read_number<double>();
+                                    continue;
+                                }
+                                const size_t size(cursor.read_number<size_t>());
+                                for (size_t k(0); k < size; ++k)
+                                {
+                                    const uint32_t index(cursor.read_number<uint32_t>());
+                                    if (is_index_list(property))
+                                        polygon.push_back(index);
+                                }
+                            }
+                            append_polygon(polygon.data(), polygon.size(), vertices.size(), chunk_indices[c]);
+                        }
+                    });
+            });
+
+            size_t total(0);
+            for (const auto& indices : chunk_indices)
+                total += indices.size();
+            vector<uint32_t> indices;
+            indices.reserve(total);
+            for (const auto& chunk : chunk_indices)
+                indices.insert(indices.end(), chunk.begin(), chunk.end());
+
+            mesh result(move(vertices), move(indices));
+            if (layout.property[slot_nx] < 0 && result.triangle_count() > 0)
+                result.generate_normals(pool);
+            return result;
+        }
+
+        mesh load_binary_ply(const mapped_file& file, const ply_header& header, thread_pool& pool)
+        {
+            const size_t vertex_element(element_index(header, "vertex"));
+            if (vertex_element == header.elements.size())
+                throw runtime_error("PLY file has no vertex element");
+            const ply_element& element(header.elements[vertex_element]);
+            const ply_vertex_layout layout(vertex_layout_of(element));
+            ply_binary_body body(read_binary_body(file, header, true));
+            const bool swap(header.format == ply_format::binary_big_endian);
+
+            vector<vertex> vertices(body.vertex_count);
+            pool.parallel_for(0, vertices.size(), record_chunk, [&](size_t first, size_t last)
+            {
+                for (size_t i(first); i < last; ++i)
+                    vertices[i] = make_vertex(decode_vertex(layout, element.properties,
+                                                            body.vertices + i * layout.record_size, swap));
+            });
+
+            mesh result(move(vertices), move(body.indices));
+            if (layout.property[slot_nx] < 0 && result.triangle_count() > 0)
+                result.generate_normals(pool);
+            return result;
+        }
+
+        /*
+         * Streaming
+         */
+
+        void stream_obj_points(const mapped_file& file, const point_sink& sink, thread_pool& pool)
+        {
+            const char* text(reinterpret_cast<const char*>(file.data()));
+            const vector<text_range> chunks(split_lines(text, text + file.size()));
+            const size_t window(window_chunks * max<size_t>(1, pool.size()));
+            vector<point<float, 3>> buffer;
+            size_t line(0);
+            for (size_t begin(0); begin < chunks.size(); begin += window)
+            {
+                const size_t end(min(chunks.size(), begin + window));
+                vector<obj_counts> offsets(end - begin + 1, obj_counts{});
+                pool.parallel_for(begin, end, 1, [&](size_t first, size_t last)
+                {
+                    for (size_t i(first); i < last; ++i)
+                        offsets[i - begin + 1] = count_obj(chunks[i]);
+                });
+                offsets[0].lines = line;
+                for (size_t i(0); i + 1 < offsets.size(); ++i)
+                    offsets[i + 1] += offsets[i];
+                line = offsets.back().lines;
+
+                buffer.resize(offsets.back().positions);
+                pool.parallel_for(begin, end, 1, [&](size_t first, size_t last)
+                {
+                    for (size_t i(first); i < last; ++i)
+                    {
+                        const obj_counts& base(offsets[i - begin]);
+                        parse_obj(chunks[i], base, {buffer.data() + base.positions, nullptr, nullptr, nullptr, nullptr});
+                    }
+                });
+                if (!buffer.empty())
+                    sink(buffer.data(), buffer.size());
+            }
+        }
+
+        void stream_ply_points(const mapped_file& file, const point_sink& sink, thread_pool& pool)
+        {
+            const ply_header header(read_ply_header(file));
+            const size_t vertex_element(element_index(header, "vertex"));
+            if (vertex_element == header.elements.size())
+                throw runtime_error("PLY file has no vertex element");
+            const ply_element& element(header.elements[vertex_element]);
+            const ply_vertex_layout layout(vertex_layout_of(element));
+            vector<point<float, 3>> buffer;
+
+            if (header.format != ply_format::ascii)
+            {
+                const ply_binary_body body(read_binary_body(file, header, false));
+                const bool swap(header.format == ply_format::binary_big_endian);
+                const size_t window(window_chunks * max<size_t>(1, pool.size()) * record_chunk);
+                for (size_t begin(0); begin < body.vertex_count; begin += window)
+                {
+                    buffer.resize(min(body.vertex_count - begin, window));
+                    pool.parallel_for(0, buffer.size(), record_chunk, [&](size_t first, size_t last)
+                    {
+                        for (size_t i(first); i < last; ++i)
+                            buffer[i] = decode_position(layout, element.properties,
+                                                        body.vertices + (begin + i) * layout.record_size, swap);
+                    });
+                    sink(buffer.data(), buffer.size());
+                }
+                return;
+            }
+
+            const char* text(reinterpret_cast<const char*>(file.data()));
+            const vector<text_range> chunks(split_lines(text + header.body_offset, text + file.size()));
+            const vector<size_t> element_lines(element_first_lines(header));
+            const size_t header_lines(header_line_count(file, header));
+            const size_t first_vertex(element_lines[vertex_element]), last_vertex(element_lines[vertex_element + 1]);
+            const size_t window(window_chunks * max<size_t>(1, pool.size()));
+            size_t line(0);
+            for (size_t begin(0); begin < chunks.size() && line < last_vertex; begin += window)
+            {
+                const size_t end(min(chunks.size(), begin + window));
+                const vector<text_range> slice(chunks.begin() + begin, chunks.begin() + end);
+                const vector<size_t> lines(chunk_first_lines(slice, line, pool));
+                line = lines.back();
+
+                const size_t window_first(clamp(lines.front(), first_vertex, last_vertex));
+                buffer.resize(clamp(lines.back(), first_vertex, last_vertex) - window_first);
+                pool.parallel_for(0, slice.size(), 1, [&](size_t first, size_t last)
+                {
+                    for (size_t c(first); c < last; ++c)
+                        for_each_line(slice[c], lines[c], header_lines, [&](text_cursor& cursor, size_t index)
+                        {
+                            if (index >= first_vertex && index < last_vertex)
+                            {
+                                const auto values(parse_vertex(cursor, layout));
+                                buffer[index - window_first] = point<float, 3>({values[slot_x], values[slot_y],
+                                                                                values[slot_z]});
+                            }
+                        });
+                });
+                if (!buffer.empty())
+                    sink(buffer.data(), buffer.size());
+            }
+            if (line < last_vertex)
+                throw runtime_error("PLY body is truncated");
+        }
+    }
+
+    mesh load_obj(const string& path, thread_pool& pool)
+    {
+        const mapped_file file(path);
+        file.advise(access_pattern::sequential);
+        const char* text(reinterpret_cast<const char*>(file.data()));
+        const vector<text_range> chunks(split_lines(text, text + file.size()));
+        const vector<obj_counts> offsets(obj_offsets(chunks, pool));
+        const obj_counts& total(offsets.back());
+
+        vector<point<float, 3>> positions(total.positions);
+        vector<point<float, 2>> uvs(total.uvs);
+        vector<point<float, 3>> normals(total.normals);
+        vector<array<uint32_t, 3>> corners(total.corners);
+        vector<array<uint32_t, 3>> triangles(total.triangles);
+        pool.parallel_for(0, chunks.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; ++i)
+            {
+                const obj_counts& base(offsets[i]);
+                parse_obj(chunks[i], base, {positions.data() + base.positions, uvs.data() + base.uvs,
+                                            normals.data() + base.normals, corners.data() + base.corners,
+                                            triangles.data() + base.triangles});
+            }
+        });
+
+        // corners that only reference positions map to the position itself, the rest is deduplicated
+        const bool positions_only(all_of(corners.begin(), corners.end(), [](const array<uint32_t, 3>& corner)
+        {
+            return corner[1] == missing && corner[2] == missing;
+        }));
+        vector<vertex> vertices;
+        vector<uint32_t> corner_vertex(corners.size());
+        if (positions_only)
+        {
+            vertices.resize(positions.size());
+            pool.parallel_for(0, positions.size(), record_chunk, [&](size_t first, size_t last)
+            {
+                for (size_t i(first); i < last; ++i)
+                    vertices[i] = {positions[i], point<float, 3>(), point<float, 2>()};
+            });
+            for (size_t c(0); c < corners.size(); ++c)
+                corner_vertex[c] = corners[c][0];
+        }
+        else
+        {
+            unordered_map<array<uint32_t, 3>, uint32_t, corner_hash> unique;
+            unique.reserve(corners.size());
+            for (size_t c(0); c < corners.size(); ++c)
+            {
+                const array<uint32_t, 3>& corner(corners[c]);
+                const auto found(unique.try_emplace(corner, uint32_t(vertices.size())));
+                if (found.second)
+                    vertices.push_back({positions[corner[0]],
+                                        corner[2] == missing ? point<float, 3>() : normals[corner[2]],
+                                        corner[1] == missing ? point<float, 2>() : uvs[corner[1]]});
+                corner_vertex[c] = found.first->second;
+            }
+        }
+
+        vector<uint32_t> indices(triangles.size() * 3);
+        pool.parallel_for(0, triangles.size(), record_chunk, [&](size_t first, size_t last)
+        {
+            for (size_t t(first); t < last; ++t)
+                for (size_t k(0); k < 3; ++k)
+                    indices[3 * t + k] = corner_vertex[triangles[t][k]];
+        });
+
+        mesh result(move(vertices), move(indices));
+        if (normals.empty() && result.triangle_count() > 0)
+            result.generate_normals(pool);
+        return result;
+    }
+
+    mesh load_ply(const string& path, thread_pool& pool)
+    {
+        const mapped_file file(path);
+        file.advise(access_pattern::sequential);
+        const ply_header header(read_ply_header(file));
+        if (header.format == ply_format::ascii)
+            return load_ascii_ply(file, header, pool);
+        return load_binary_ply(file, header, pool);
+    }
+
+    mesh load_mesh(const string& path, thread_pool& pool)
+    {
+        const string extension(extension_of(path));
+        if (extension == "obj")
+            return load_obj(path, pool);
+        if (extension == "ply")
+            return load_ply(path, pool);
+        throw invalid_argument("Unsupported mesh format: " + path);
+    }
+
+    void stream_points(const string& path, const point_sink& sink, thread_pool& pool)
+    {
+        const string extension(extension_of(path));
+        if (extension != "obj" && extension != "ply")
+            throw invalid_argument("Unsupported mesh format: " + path);
+        const mapped_file file(path);
+        file.advise(access_pattern::sequential);
+        if (extension == "obj")
+            stream_obj_points(file, sink, pool);
+        else
+            stream_ply_points(file, sink, pool);
+    }
+
+    vector<point<float, 3>> load_point_cloud(const string& path, thread_pool& pool)
+    {
+        vector<point<float, 3>> positions;
+        stream_points(path, [&](const point<float, 3>* data, size_t count)
+        {
+            positions.insert(positions.end(), data, data + count);
+        }, pool);
+        return positions;
+    }
+} // engine_lib
@@ -0,0 +1,97 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef MESH_LOADER_HPP
+#define MESH_LOADER_HPP
+#include "../../includes.hpp"
+#include "../../geometry/mesh/mesh.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Receives consecutive runs of positions in file order.
+     *
+     * The pointer is only valid during the call.
+     */
+    using point_sink = function<void(const point<float, 3>* positions, size_t count)>;
+
+    /**
+     * @brief Loads a Wavefront OBJ file into an interleaved mesh.
+     *
+     * The mapped file is split into chunks at line boundaries. A first parallel pass counts
+     * the records of every chunk, a second one parses them with from_chars straight into
+     * the final buffers at the offsets given by the counts, so no intermediate strings or
+     * per-chunk copies are made.
+     *
+     * Reads v, vt, vn and f records; polygons are triangulated as fans and negative
+     * (relative) indices are supported. Every distinct position/uv/normal combination
+     * becomes one vertex. Normals are generated if the file has none.
+     *
+     * @param path Path of the file.
+     * @param pool Pool parsing the chunks.
+     * @return The loaded mesh.
+     * @throws runtime_error If the file cannot be read or is malformed.
+     */
+    mesh load_obj(const string& path, thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Loads a PLY file (ASCII or binary, either byte order) into an interleaved mesh.
+     *
+     * Vertex properties x, y, z, nx, ny, nz and u, v (or s, t) are read, any other property
+     * is skipped. Faces come from the vertex_indices list of the face element and are
+     * triangulated as fans. Vertex records are decoded in parallel; normals are generated
+     * if the file has faces but no normals.
+     *
+     * @param path Path of the file.
+     * @param pool Pool decoding the vertices.
+     * @return The loaded mesh.
+     * @throws runtime_error If the file cannot be read, is malformed or uses an unsupported layout.
+     */
+    mesh load_ply(const string& path, thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Loads an OBJ or PLY file, chosen by the file extension.
+     *
+     * @param path Path of the file.
+     * @param pool Pool parsing the file.
+     * @return The loaded mesh.
+     * @throws invalid_argument If the extension is neither .obj nor .ply.
+     * @throws runtime_error If the file cannot be read or is malformed.
+     */
+    mesh load_mesh(const string& path, thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Streams the vertex positions of an OBJ or PLY file into a sink.
+     *
+     * The file is processed in windows of a few chunks per thread: each window is parsed
+     * in parallel into one reused buffer and handed to the sink before the next window
+     * starts, so memory stays bounded whatever the file size. Faces and other attributes
+     * are ignored.
+     *
+     * @param path Path of the file, .obj or .ply.
+     * @param sink Receives the positions in file order.
+     * @param pool Pool parsing the chunks.
+     * @throws invalid_argument If the extension is neither .obj nor .ply.
+     * @throws runtime_error If the file cannot be read or is malformed.
+     */
+    void stream_points(const string& path, const point_sink& sink, thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Loads the vertex positions of an OBJ or PLY file.
+     *
+     * @param path Path of the file, .obj or .ply.
+     * @param pool Pool parsing the chunks.
+     * @return The positions in file order.
+     * @see stream_points
+     */
+    vector<point<float, 3>> load_point_cloud(const string& path, thread_pool& pool = thread_pool::global());
+} // engine_lib
+
+#endif //MESH_LOADER_HPP
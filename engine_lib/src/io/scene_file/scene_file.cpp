@@ -0,0 +1,270 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "scene_file.hpp"
+#include "../checksum/checksum.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // vertex records converted per write call
+        constexpr size_t write_chunk = 4096;
+
+        static_assert(sizeof(point<float, 3>) == sizeof(scene_vertex::position) &&
+                      sizeof(point<float, 2>) == sizeof(scene_vertex::uv),
+                      "mesh views alias the float arrays of the records as points");
+
+        void pad_to(ofstream& out, uint64_t alignment)
+        {
+            static const char zeros[scene_format::block_alignment] = {};
+            const uint64_t position(uint64_t(out.tellp()));
+            const uint64_t padding((alignment - position % alignment) % alignment);
+            out.write(zeros, streamsize(padding));
+        }
+
+        scene_block write_block(ofstream& out, scene_block_kind kind, uint32_t element_size, uint64_t count,
+                                const void* data)
+        {
+            pad_to(out, scene_format::block_alignment);
+            scene_block block{kind, element_size, uint64_t(out.tellp()), count, 0};
+            const size_t bytes(size_t(count) * element_size);
+            out.write(static_cast<const char*>(data), streamsize(bytes));
+            block.checksum = compute_checksum64(data, bytes);
+            return block;
+        }
+
+        template <size_t N>
+        void copy_coordinates(const point<float, N>& source, float (&destination)[N])
+        {
+            const array<float, N> coordinates(source.get_coordinates());
+            copy(coordinates.begin(), coordinates.end(), destination);
+        }
+
+        template <size_t N>
+        point<float, N> to_point(const float (&source)[N])
+        {
+            array<float, N> coordinates{};
+            copy(source, source + N, coordinates.begin());
+            return point<float, N>(coordinates);
+        }
+
+        scene_block write_vertices(ofstream& out, const mesh& source)
+        {
+            // records are assembled from the mesh attributes a chunk at a time
+            pad_to(out, scene_format::block_alignment);
+            scene_block block{scene_block_kind::vertices, sizeof(scene_vertex), uint64_t(out.tellp()),
+                              source.vertex_count(), 0};
+            const auto positions(source.positions());
+            const auto normals(source.normals());
+            const auto uvs(source.uvs());
+            vector<scene_vertex> chunk;
+            checksum64 checksum;
+            for (size_t first(0); first < source.vertex_count(); first += write_chunk)
+            {
+                const size_t last(min(source.vertex_count(), first + write_chunk));
+                chunk.resize(last - first);
+                for (size_t i(first); i < last; ++i)
+                {
+                    scene_vertex& record(chunk[i - first]);
+                    copy_coordinates(positions[i], record.position);
+                    copy_coordinates(normals[i], record.normal);
+                    copy_coordinates(uvs[i], record.uv);
+                }
+                const size_t bytes(chunk.size() * sizeof(scene_vertex));
+                out.write(reinterpret_cast<const char*>(chunk.data()), streamsize(bytes));
+                checksum.update(chunk.data(), bytes);
+            }
+            block.checksum = checksum.digest();
+            return block;
+        }
+
+        size_t element_size_of(scene_block_kind kind)
+        {
+            switch (kind)
+            {
+            case scene_block_kind::vertices:
+                return sizeof(scene_vertex);
+            case scene_block_kind::indices:
+                return sizeof(uint32_t);
+            }
+            return 0;
+        }
+    }
+
+    size_t mesh_view::triangle_count() const
+    {
+        return index_count / 3;
+    }
+
+    strided_view<const point<float, 3>> mesh_view::positions() const
+    {
+        return strided_view<const point<float, 3>>(reinterpret_cast<const point<float, 3>*>(vertices->position),
+                                                   sizeof(scene_vertex), vertex_count);
+    }
+
+    strided_view<const point<float, 3>> mesh_view::normals() const
+    {
+        return strided_view<const point<float, 3>>(reinterpret_cast<const point<float, 3>*>(vertices->normal),
+                                                   sizeof(scene_vertex), vertex_count);
+    }
+
+    strided_view<const point<float, 2>> mesh_view::uvs() const
+    {
+        return strided_view<const point<float, 2>>(reinterpret_cast<const point<float, 2>*>(vertices->uv),
+                                                   sizeof(scene_vertex), vertex_count);
+    }
+
+    mesh mesh_view::to_mesh() const
+    {
+        vector<vertex> records(vertex_count);
+        for (size_t i(0); i < vertex_count; ++i)
+            records[i] = {to_point(vertices[i].position), to_point(vertices[i].normal), to_point(vertices[i].uv)};
+        return mesh(move(records), vector<uint32_t>(indices, indices + index_count));
+    }
+
+    scene_file::scene_file(const string& path, scene_verification verification, thread_pool& pool)
+        : file_(path),
+          blocks_(nullptr),
+          block_count_(0),
+          verification_(verification)
+    {
+        const size_t size(file_.size());
+        if (size < sizeof(scene_file_header))
+            throw runtime_error("Not a scene file: " + path);
+        scene_file_header header{};
+        memcpy(&header, file_.data(), sizeof(header));
+        if (memcmp(header.magic, scene_format::magic, sizeof(header.magic)) != 0)
+            throw runtime_error("Not a scene file: " + path);
+        if (header.byte_order != scene_format::byte_order_mark)
+            throw runtime_error("Scene file has a different byte order: " + path);
+        if (header.version != scene_format::version)
+            throw runtime_error("Unsupported scene file version " + to_string(header.version) + ": " + path);
+
+        if (header.block_table_offset > size || header.block_table_offset % alignof(scene_block) != 0 ||
+            header.block_count > (size - header.block_table_offset) / sizeof(scene_block))
+            throw runtime_error("Scene block table is out of bounds: " + path);
+        const unsigned char* table(file_.data() + header.block_table_offset);
+        const size_t table_size(size_t(header.block_count) * sizeof(scene_block));
+        if (compute_checksum64(table, table_size) != header.block_table_checksum)
+            throw runtime_error("Scene block table is corrupted: " + path);
+        blocks_ = reinterpret_cast<const scene_block*>(table);
+        block_count_ = size_t(header.block_count);
+
+        if (block_count_ % 2 != 0)
+            throw runtime_error("Scene file has an incomplete mesh: " + path);
+        for (size_t i(0); i < block_count_; ++i)
+        {
+            const scene_block& block(blocks_[i]);
+            const scene_block_kind expected(i % 2 == 0 ? scene_block_kind::vertices : scene_block_kind::indices);
+            if (block.kind != expected || block.element_size != element_size_of(expected))
+                throw runtime_error("Scene file was written with a different vertex layout: " + path);
+            if (block.offset > size || block.offset % scene_format::block_alignment != 0 ||
+                block.count > (size - block.offset) / block.element_size)
+                throw runtime_error("Scene block is out of bounds: " + path);
+        }
+
+        verified_ = make_unique<atomic<bool>[]>(block_count_);
+        for (size_t i(0); i < block_count_; ++i)
+            verified_[i].store(false, memory_order_relaxed);
+        if (verification_ == scene_verification::eager)
+            verify(pool);
+    }
+
+    void scene_file::verify_block(size_t index) const
+    {
+        if (verified_[index].load(memory_order_acquire))
+            return;
+        const scene_block& block(blocks_[index]);
+        const unsigned char* data(file_.data() + block.offset);
+        if (compute_checksum64(data, size_t(block.count) * block.element_size) != block.checksum)
+            throw runtime_error("Scene block " + to_string(index) + " is corrupted");
+
+        if (block.kind == scene_block_kind::indices)
+        {
+            // indices are used in place, so an index past the vertices would read outside the mesh
+            const uint64_t vertices(blocks_[index - 1].count);
+            const uint32_t* indices(reinterpret_cast<const uint32_t*>(data));
+            uint32_t largest(0);
+            for (size_t i(0); i < block.count; ++i)
+                largest = max(largest, indices[i]);
+            if (block.count % 3 != 0 || (block.count > 0 && largest >= vertices))
+                throw runtime_error("Scene block " + to_string(index) + " has invalid indices");
+        }
+        verified_[index].store(true, memory_order_release);
+    }
+
+    size_t scene_file::mesh_count() const
+    {
+        return block_count_ / 2;
+    }
+
+    mesh_view scene_file::get_mesh(size_t index) const
+    {
+        if (index >= mesh_count())
+            throw out_of_range("Mesh index out of range");
+        const scene_block& vertices(blocks_[2 * index]);
+        const scene_block& indices(blocks_[2 * index + 1]);
+        file_.prefetch(size_t(vertices.offset), size_t(vertices.count) * vertices.element_size);
+        file_.prefetch(size_t(indices.offset), size_t(indices.count) * indices.element_size);
+        if (verification_ == scene_verification::lazy)
+        {
+            verify_block(2 * index);
+            verify_block(2 * index + 1);
+        }
+        return {reinterpret_cast<const scene_vertex*>(file_.data() + vertices.offset), size_t(vertices.count),
+                reinterpret_cast<const uint32_t*>(file_.data() + indices.offset), size_t(indices.count)};
+    }
+
+    void scene_file::verify(thread_pool& pool) const
+    {
+        pool.parallel_for(0, block_count_, 1, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; ++i)
+                verify_block(i);
+        });
+    }
+
+    const mapped_file& scene_file::file() const
+    {
+        return file_;
+    }
+
+    void write_scene(const string& path, const vector<mesh>& meshes)
+    {
+        ofstream out(path, ios::binary | ios::trunc);
+        if (!out)
+            throw runtime_error("Cannot create file: " + path);
+
+        scene_file_header header{};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        vector<scene_block> blocks;
+        blocks.reserve(meshes.size() * 2);
+        for (const mesh& source : meshes)
+        {
+            blocks.push_back(write_vertices(out, source));
+            blocks.push_back(write_block(out, scene_block_kind::indices, sizeof(uint32_t),
+                                         source.indices().size(), source.indices().data()));
+        }
+
+        pad_to(out, alignof(scene_block));
+        memcpy(header.magic, scene_format::magic, sizeof(header.magic));
+        header.version = scene_format::version;
+        header.byte_order = scene_format::byte_order_mark;
+        header.block_count = blocks.size();
+        header.block_table_offset = uint64_t(out.tellp());
+        header.block_table_checksum = compute_checksum64(blocks.data(), blocks.size() * sizeof(scene_block));
+        out.write(reinterpret_cast<const char*>(blocks.data()), streamsize(blocks.size() * sizeof(scene_block)));
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.flush();
+        if (!out)
+            throw runtime_error("Cannot write file: " + path);
+    }
+} // engine_lib
@@ -0,0 +1,202 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef SCENE_FILE_HPP
+#define SCENE_FILE_HPP
+#include "../../includes.hpp"
+#include "../mapped_file/mapped_file.hpp"
+#include "../../geometry/mesh/mesh.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Constants of the binary scene format.
+     *
+     * A scene file is a header, a sequence of data blocks and a block table at the end.
+     * Every block starts on a 4 KiB boundary and holds a packed array of fixed records,
+     * so a mapped block is used in place. Meshes are stored as a vertex block of
+     * scene_vertex records followed by an index block of uint32_t. All integers and
+     * floats are little-endian.
+     */
+    namespace scene_format
+    {
+        constexpr char magic[8] = {'L', '3', 'D', 'S', 'C', 'E', 'N', 'E'};
+        constexpr uint32_t version = 2;
+        constexpr uint32_t byte_order_mark = 0x01020304u;
+        constexpr uint64_t block_alignment = 4096;
+    }
+
+    /**
+     * @brief Content type of a scene block.
+     */
+    enum class scene_block_kind : uint32_t
+    {
+        vertices = 1, //!< scene_vertex records.
+        indices = 2 //!< Triangle indices, uint32_t.
+    };
+
+    /**
+     * @brief Fixed header at offset 0 of a scene file.
+     */
+    struct scene_file_header
+    {
+        char magic[8]; //!< scene_format::magic.
+        uint32_t version; //!< scene_format::version.
+        uint32_t byte_order; //!< scene_format::byte_order_mark as written by the producer.
+        uint64_t block_count; //!< Number of entries in the block table.
+        uint64_t block_table_offset; //!< File offset of the block table.
+        uint64_t block_table_checksum; //!< XXH64 of the block table.
+    };
+
+    /**
+     * @brief Block table entry.
+     */
+    struct scene_block
+    {
+        scene_block_kind kind; //!< Content of the block.
+        uint32_t element_size; //!< Size of one element, checked against the engine types.
+        uint64_t offset; //!< File offset of the first element.
+        uint64_t count; //!< Number of elements.
+        uint64_t checksum; //!< XXH64 of the count * element_size bytes.
+    };
+
+    /**
+     * @brief Vertex record of a vertex block.
+     *
+     * The on-disk layout is fixed by this record, not by the engine's vertex type.
+     */
+    struct scene_vertex
+    {
+        float position[3]; //!< Position in model space.
+        float normal[3]; //!< Unit normal, zero if the mesh has none.
+        float uv[2]; //!< Texture coordinates.
+    };
+
+    static_assert(sizeof(scene_file_header) == 40 && sizeof(scene_block) == 32 && sizeof(scene_vertex) == 32,
+                  "scene format records must not change");
+
+    /**
+     * @brief When a scene_file compares the block checksums.
+     */
+    enum class scene_verification
+    {
+        lazy, //!< The blocks of a mesh are verified the first time get_mesh() returns it, reading all of them.
+        eager, //!< Every block is verified when the file is opened.
+        none //!< Blocks are only verified by an explicit verify() call, nothing is read before use.
+    };
+
+    /**
+     * @brief Zero-copy view of a mesh stored in a mapped scene file.
+     *
+     * The pointers address the mapping and stay valid while the scene_file is open.
+     */
+    struct mesh_view
+    {
+        const scene_vertex* vertices; //!< Vertex records.
+        size_t vertex_count; //!< Number of vertex records.
+        const uint32_t* indices; //!< Three indices per triangle.
+        size_t index_count; //!< Number of indices.
+
+        [[nodiscard]] size_t triangle_count() const;
+        [[nodiscard]] strided_view<const point<float, 3>> positions() const;
+        [[nodiscard]] strided_view<const point<float, 3>> normals() const;
+        [[nodiscard]] strided_view<const point<float, 2>> uvs() const;
+
+        /**
+         * @brief Copies the view into an owning mesh.
+         *
+         * @return An interleaved mesh with the same vertices and triangles.
+         */
+        [[nodiscard]] mesh to_mesh() const;
+    };
+
+    /**
+     * @class scene_file
+     * @brief Memory-mapped reader of the binary scene format.
+     *
+     * Opening maps the file and validates the header and the block table only, so it
+     * takes the same time for any file size. Vertex and index data are paged in by the
+     * kernel when a mesh is first touched; get_mesh() starts that read-ahead.
+     *
+     * By default the block checksums are not compared, since that reads every page of a
+     * block. Verification is opt-in: scene_verification::lazy or ::eager, or verify().
+     *
+     * @throws runtime_error If the file cannot be mapped, is not a scene file of a supported
+     * version or layout, or a checksum does not match.
+     */
+    class scene_file
+    {
+        mapped_file file_; /// The mapped file.
+        const scene_block* blocks_; /// Block table inside the mapping.
+        size_t block_count_; /// Number of blocks.
+        scene_verification verification_; /// Checksum policy.
+        unique_ptr<atomic<bool>[]> verified_; /// Per block, true once its checksum matched.
+
+        void verify_block(size_t index) const;
+
+    public:
+        /**
+         * @brief Maps and validates a scene file.
+         *
+         * @param path Path of the file.
+         * @param verification When to compare the block checksums, never by default.
+         * @param pool Pool verifying the blocks for scene_verification::eager.
+         */
+        explicit scene_file(const string& path, scene_verification verification = scene_verification::none,
+                            thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Returns the number of meshes.
+         *
+         * @return Number of meshes.
+         */
+        [[nodiscard]] size_t mesh_count() const;
+
+        /**
+         * @brief Returns a view of a stored mesh.
+         *
+         * @param index Mesh index.
+         * @return The view over the mapped data.
+         * @throws out_of_range If the index is not below mesh_count().
+         */
+        [[nodiscard]] mesh_view get_mesh(size_t index) const;
+
+        /**
+         * @brief Verifies the checksums of every block not yet verified, in parallel.
+         *
+         * @param pool Pool executing the verification.
+         */
+        void verify(thread_pool& pool = thread_pool::global()) const;
+
+        /**
+         * @brief Returns the underlying mapping.
+         *
+         * @return The mapped file.
+         */
+        [[nodiscard]] const mapped_file& file() const;
+    };
+
+    /**
+     * @brief Writes meshes in the binary scene format.
+     *
+     * Vertices are written in the interleaved layout whatever the layout of the mesh.
+     * Tangents are not stored.
+     *
+     * @param path Path of the file, replaced if it exists.
+     * @param meshes Meshes to store, in order.
+     * @throws runtime_error If the file cannot be written.
+     */
+    void write_scene(const string& path, const vector<mesh>& meshes);
+} // engine_lib
+
+#endif //SCENE_FILE_HPP
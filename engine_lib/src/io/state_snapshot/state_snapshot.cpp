@@ -0,0 +1,246 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "state_snapshot.hpp"
+
+#include <algorithm>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // word i of a buffer, zero padded past its end
+        uint64_t word_at(const vector<unsigned char>& source, size_t i)
+        {
+            uint64_t word(0);
+            if (8 * i + 8 <= source.size())
+                memcpy(&word, source.data() + 8 * i, 8);
+            else if (8 * i < source.size())
+                memcpy(&word, source.data() + 8 * i, source.size() - 8 * i);
+            return word;
+        }
+    }
+
+    snapshot_writer::snapshot_writer(vector<unsigned char>& target) : target_(target)
+    {
+        target_.clear();
+    }
+
+    void snapshot_writer::write_bytes(const void* data, size_t size)
+    {
+        const auto* bytes(static_cast<const unsigned char*>(data));
+        target_.insert(target_.end(), bytes, bytes + size);
+    }
+
+    void snapshot_writer::write(const string& value)
+    {
+        write(uint64_t(value.size()));
+        write_bytes(value.data(), value.size());
+    }
+
+    size_t snapshot_writer::size() const
+    {
+        return target_.size();
+    }
+
+    snapshot_reader::snapshot_reader(const unsigned char* data, size_t size) : data_(data), size_(size), offset_(0)
+    {
+    }
+
+    snapshot_reader::snapshot_reader(const vector<unsigned char>& source)
+        : snapshot_reader(source.data(), source.size())
+    {
+    }
+
+    void snapshot_reader::read_bytes(void* data, size_t size)
+    {
+        if (size > size_ - offset_)
+            throw out_of_range("Snapshot ends before the value");
+        if (size != 0)
+            memcpy(data, data_ + offset_, size);
+        offset_ += size;
+    }
+
+    void snapshot_reader::read(string& value)
+    {
+        const auto size(get<uint64_t>());
+        if (size > remaining())
+            throw out_of_range("Snapshot ends inside a string");
+        value.assign(reinterpret_cast<const char*>(data_ + offset_), size_t(size));
+        offset_ += size_t(size);
+    }
+
+    size_t snapshot_reader::remaining() const
+    {
+        return size_ - offset_;
+    }
+
+    void delta_encode(const vector<unsigned char>& previous, const vector<unsigned char>& current,
+                      vector<unsigned char>& delta)
+    {
+        // the size, then (unchanged words, changed words, XOR of every changed word) runs;
+        // a run pair costs 8 bytes and covers at least one word, which bounds the output
+        const size_t words((current.size() + 7) / 8);
+        delta.resize(8 + 16 * words + 8);
+        unsigned char* out(delta.data());
+        const uint64_t size(current.size());
+        memcpy(out, &size, 8);
+        out += 8;
+
+        // below this word both buffers are whole, so the scans load words directly
+        const size_t whole(min(current.size(), previous.size()) / 8);
+        const unsigned char* a(previous.data());
+        const unsigned char* b(current.data());
+        const auto changed([&](size_t i)
+        {
+            if (i >= whole)
+                return word_at(previous, i) ^ word_at(current, i);
+            uint64_t x, y;
+            memcpy(&x, a + 8 * i, 8);
+            memcpy(&y, b + 8 * i, 8);
+            return x ^ y;
+        });
+
+        size_t i(0);
+        while (i < words)
+        {
+            // skip unchanged words four at a time while the buffers are whole
+            const size_t run_start(i);
+            while (i + 4 <= whole && i - run_start + 4 <= UINT32_MAX && memcmp(a + 8 * i, b + 8 * i, 32) == 0)
+                i += 4;
+            while (i < words && i - run_start < UINT32_MAX && changed(i) == 0)
+                ++i;
+            const auto unchanged(uint32_t(i - run_start));
+            memcpy(out, &unchanged, 4);
+
+            unsigned char* count_at(out + 4);
+            out += 8;
+            const size_t literal_start(i);
+            while (i < words && i - literal_start < UINT32_MAX)
+            {
+                const uint64_t word(changed(i));
+                if (word == 0)
+                    break;
+                memcpy(out, &word, 8);
+                out += 8;
+                ++i;
+            }
+            const auto literals(uint32_t(i - literal_start));
+            memcpy(count_at, &literals, 4);
+        }
+        delta.resize(size_t(out - delta.data()));
+    }
+
+    void delta_decode(const vector<unsigned char>& previous, const vector<unsigned char>& delta,
+                      vector<unsigned char>& current)
+    {
+        snapshot_reader reader(delta);
+        try
+        {
+            const auto size(reader.get<uint64_t>());
+            const size_t words((size_t(size) + 7) / 8);
+            // decoded in whole words, the padding is cut off at the end
+            current.resize(words * 8);
+            size_t i(0);
+            while (i < words)
+            {
+                const auto unchanged(reader.get<uint32_t>());
+                if (unchanged > words - i)
+                    throw runtime_error("Malformed snapshot delta");
+                for (const size_t end(i + unchanged); i < end; ++i)
+                {
+                    const uint64_t word(word_at(previous, i));
+                    memcpy(current.data() + 8 * i, &word, 8);
+                }
+                const auto changed(reader.get<uint32_t>());
+                if (changed > words - i)
+                    throw runtime_error("Malformed snapshot delta");
+                for (const size_t end(i + changed); i < end; ++i)
+                {
+                    const uint64_t word(word_at(previous, i) ^ reader.get<uint64_t>());
+                    memcpy(current.data() + 8 * i, &word, 8);
+                }
+                if (unchanged == 0 && changed == 0)
+                    throw runtime_error("Malformed snapshot delta");
+            }
+            current.resize(size_t(size));
+        }
+        catch (const out_of_range&)
+        {
+            throw runtime_error("Truncated snapshot delta");
+        }
+    }
+
+    snapshot_ring::snapshot_ring(size_t capacity)
+        : buffers_(capacity), ticks_(capacity, 0), used_(capacity, false), next_(0)
+    {
+        if (capacity == 0)
+            throw invalid_argument("A snapshot ring needs at least one slot");
+    }
+
+    vector<unsigned char>& snapshot_ring::store(uint64_t tick)
+    {
+        if (!empty() && tick <= newest_tick())
+            throw invalid_argument("Snapshot ticks must increase");
+        const size_t slot(next_);
+        next_ = (next_ + 1) % buffers_.size();
+        ticks_[slot] = tick;
+        used_[slot] = true;
+        buffers_[slot].clear();
+        return buffers_[slot];
+    }
+
+    const vector<unsigned char>* snapshot_ring::find(uint64_t tick) const
+    {
+        for (size_t slot(0); slot < buffers_.size(); ++slot)
+            if (used_[slot] && ticks_[slot] == tick)
+                return &buffers_[slot];
+        return nullptr;
+    }
+
+    const vector<unsigned char>& snapshot_ring::rollback(uint64_t tick)
+    {
+        const vector<unsigned char>* kept(find(tick));
+        if (kept == nullptr)
+            throw out_of_range("Snapshot of tick " + to_string(tick) + " is not kept");
+        // newer slots precede next_, so walking back from it releases them newest first
+        while (newest_tick() != tick)
+        {
+            next_ = (next_ + buffers_.size() - 1) % buffers_.size();
+            used_[next_] = false;
+        }
+        return *kept;
+    }
+
+    size_t snapshot_ring::size() const
+    {
+        return size_t(count(used_.begin(), used_.end(), true));
+    }
+
+    size_t snapshot_ring::capacity() const
+    {
+        return buffers_.size();
+    }
+
+    bool snapshot_ring::empty() const
+    {
+        return !used_[(next_ + buffers_.size() - 1) % buffers_.size()];
+    }
+
+    uint64_t snapshot_ring::newest_tick() const
+    {
+        return empty() ? 0 : ticks_[(next_ + buffers_.size() - 1) % buffers_.size()];
+    }
+
+    uint64_t snapshot_ring::oldest_tick() const
+    {
+        for (size_t k(0); k < buffers_.size(); ++k)
+        {
+            const size_t slot((next_ + k) % buffers_.size());
+            if (used_[slot])
+                return ticks_[slot];
+        }
+        return 0;
+    }
+} // engine_lib
@@ -0,0 +1,256 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef STATE_SNAPSHOT_HPP
+#define STATE_SNAPSHOT_HPP
+#include "../../includes.hpp"
+#include "../../math/direction/direction.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../math/point/point.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class snapshot_writer
+     * @brief Appends simulation state to a byte buffer.
+     *
+     * Trivially copyable values and arrays of them are copied with memcpy; the math types and
+     * containers are written through their coordinates, elements or sizes. The format is the
+     * memory layout of the writing machine, meant for rollback, lockstep peers and crash
+     * repro on the same build, not for long-term storage.
+     */
+    class snapshot_writer
+    {
+        vector<unsigned char>& target_; /// Buffer receiving the state.
+
+    public:
+        /**
+         * @brief Starts writing into a buffer, clearing it but keeping its capacity.
+         *
+         * @param target Buffer receiving the state, must outlive the writer.
+         */
+        explicit snapshot_writer(vector<unsigned char>& target);
+
+        /**
+         * @brief Appends raw bytes.
+         *
+         * @param data First byte.
+         * @param size Number of bytes.
+         */
+        void write_bytes(const void* data, size_t size);
+
+        /**
+         * @brief Appends a trivially copyable value.
+         *
+         * @param value The value.
+         */
+        template <class T>
+        void write(const T& value);
+
+        template <class T, size_t N>
+        void write(const point<T, N>& value);
+
+        template <class T, size_t N>
+        void write(const direction<T, N>& value);
+
+        template <class T, size_t R, size_t C>
+        void write(const matrix<T, R, C>& value);
+
+        /**
+         * @brief Appends the size and the elements of a vector, with one memcpy if they are trivially copyable.
+         *
+         * @param values The vector.
+         */
+        template <class T, class A>
+        void write(const vector<T, A>& values);
+
+        void write(const string& value);
+
+        /**
+         * @brief Appends a run of trivially copyable values without its size.
+         *
+         * @param values First value.
+         * @param count Number of values.
+         */
+        template <class T>
+        void write_span(const T* values, size_t count);
+
+        [[nodiscard]] size_t size() const;
+    };
+
+    /**
+     * @class snapshot_reader
+     * @brief Reads state written by a snapshot_writer, in the same order.
+     */
+    class snapshot_reader
+    {
+        const unsigned char* data_; /// First byte of the snapshot.
+        size_t size_; /// Size of the snapshot.
+        size_t offset_; /// Next byte to read.
+
+    public:
+        /**
+         * @brief Starts reading a snapshot.
+         *
+         * @param data First byte, must outlive the reader.
+         * @param size Size in bytes.
+         */
+        snapshot_reader(const unsigned char* data, size_t size);
+
+        /**
+         * @brief Starts reading a snapshot held in a buffer.
+         *
+         * @param source The buffer, must outlive the reader.
+         */
+        explicit snapshot_reader(const vector<unsigned char>& source);
+
+        /**
+         * @brief Copies the next bytes.
+         *
+         * @param data Receives the bytes.
+         * @param size Number of bytes.
+         * @throws out_of_range If the snapshot ends first.
+         */
+        void read_bytes(void* data, size_t size);
+
+        /**
+         * @brief Reads a trivially copyable value.
+         *
+         * @param value Receives the value.
+         * @throws out_of_range If the snapshot ends first.
+         */
+        template <class T>
+        void read(T& value);
+
+        template <class T, size_t N>
+        void read(point<T, N>& value);
+
+        template <class T, size_t N>
+        void read(direction<T, N>& value);
+
+        template <class T, size_t R, size_t C>
+        void read(matrix<T, R, C>& value);
+
+        template <class T, class A>
+        void read(vector<T, A>& values);
+
+        void read(string& value);
+
+        /**
+         * @brief Reads a run of trivially copyable values written by write_span().
+         *
+         * @param values Receives the values.
+         * @param count Number of values.
+         * @throws out_of_range If the snapshot ends first.
+         */
+        template <class T>
+        void read_span(T* values, size_t count);
+
+        /**
+         * @brief Reads a value of any type read() supports.
+         *
+         * @return The value.
+         * @throws out_of_range If the snapshot ends first.
+         */
+        template <class T>
+        T get();
+
+        [[nodiscard]] size_t remaining() const;
+    };
+
+    /**
+     * @brief Encodes a snapshot as its difference to the previous one.
+     *
+     * The snapshots are XORed 64 bits at a time and the result is stored as alternating runs
+     * of unchanged and changed words, so state that barely moves between ticks compresses to
+     * a few bytes. Snapshots of different size are compared as if the shorter one were padded
+     * with zeros.
+     *
+     * @param previous Snapshot the receiver already has.
+     * @param current Snapshot to encode.
+     * @param delta Receives the encoding; its capacity is reused.
+     */
+    void delta_encode(const vector<unsigned char>& previous, const vector<unsigned char>& current,
+                      vector<unsigned char>& delta);
+
+    /**
+     * @brief Rebuilds a snapshot from the previous one and a delta_encode() result.
+     *
+     * @param previous Snapshot the delta was encoded against.
+     * @param delta The encoding.
+     * @param current Receives the snapshot; its capacity is reused.
+     * @throws runtime_error If the delta is malformed.
+     */
+    void delta_decode(const vector<unsigned char>& previous, const vector<unsigned char>& delta,
+                      vector<unsigned char>& current);
+
+    /**
+     * @class snapshot_ring
+     * @brief The most recent snapshots by tick, for rolling the simulation back.
+     *
+     * The ring keeps a fixed number of buffers and overwrites the oldest; a buffer keeps its
+     * capacity when reused, so a running simulation stops allocating once the ring is warm.
+     */
+    class snapshot_ring
+    {
+        vector<vector<unsigned char>> buffers_; /// Snapshot of every slot.
+        vector<uint64_t> ticks_; /// Tick of every slot.
+        vector<bool> used_; /// Slots holding a snapshot.
+        size_t next_; /// Slot the next snapshot goes to.
+
+    public:
+        /**
+         * @brief Creates an empty ring.
+         *
+         * @param capacity Number of snapshots kept.
+         * @throws invalid_argument If capacity is zero.
+         */
+        explicit snapshot_ring(size_t capacity);
+
+        /**
+         * @brief Takes the slot of a new snapshot, dropping the oldest one if the ring is full.
+         *
+         * @param tick Tick of the snapshot; ticks must increase.
+         * @return The empty buffer to write the snapshot into.
+         * @throws invalid_argument If the tick does not follow the newest snapshot.
+         */
+        vector<unsigned char>& store(uint64_t tick);
+
+        /**
+         * @brief Finds the snapshot of a tick.
+         *
+         * @param tick The tick.
+         * @return The snapshot, or nullptr if it is not kept.
+         */
+        [[nodiscard]] const vector<unsigned char>* find(uint64_t tick) const;
+
+        /**
+         * @brief Discards every snapshot newer than a tick, so the simulation can replay from it.
+         *
+         * @param tick The tick to return to; it must be kept.
+         * @return Its snapshot.
+         * @throws out_of_range If the tick is not kept.
+         */
+        const vector<unsigned char>& rollback(uint64_t tick);
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t capacity() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] uint64_t newest_tick() const;
+        [[nodiscard]] uint64_t oldest_tick() const;
+    };
+} // engine_lib
+
+#endif //STATE_SNAPSHOT_HPP
+#include "state_snapshot.inl"
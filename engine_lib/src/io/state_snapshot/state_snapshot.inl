@@ -0,0 +1,120 @@
+#ifndef STATE_SNAPSHOT_INL
+#define STATE_SNAPSHOT_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    void snapshot_writer::write(const T& value)
+    {
+        static_assert(is_trivially_copyable_v<T>,
+                      "Only trivially copyable values are written raw; pass matrix subclasses as their matrix base");
+        write_bytes(&value, sizeof(T));
+    }
+
+    template <class T, size_t N>
+    void snapshot_writer::write(const point<T, N>& value)
+    {
+        write(value.get_coordinates());
+    }
+
+    template <class T, size_t N>
+    void snapshot_writer::write(const direction<T, N>& value)
+    {
+        write(value.get_coordinates());
+    }
+
+    template <class T, size_t R, size_t C>
+    void snapshot_writer::write(const matrix<T, R, C>& value)
+    {
+        array<T, R * C> elements;
+        for (size_t r(0); r < R; ++r)
+            for (size_t c(0); c < C; ++c)
+                elements[r * C + c] = value(r, c);
+        write(elements);
+    }
+
+    template <class T, class A>
+    void snapshot_writer::write(const vector<T, A>& values)
+    {
+        write(uint64_t(values.size()));
+        if constexpr (is_trivially_copyable_v<T> && !is_same_v<T, bool>)
+            write_span(values.data(), values.size());
+        else
+            for (const T& value : values)
+                write(value);
+    }
+
+    template <class T>
+    void snapshot_writer::write_span(const T* values, size_t count)
+    {
+        static_assert(is_trivially_copyable_v<T>, "Spans are written raw and must be trivially copyable");
+        write_bytes(values, count * sizeof(T));
+    }
+
+    template <class T>
+    void snapshot_reader::read(T& value)
+    {
+        static_assert(is_trivially_copyable_v<T>,
+                      "Only trivially copyable values are read raw; pass matrix subclasses as their matrix base");
+        read_bytes(&value, sizeof(T));
+    }
+
+    template <class T, size_t N>
+    void snapshot_reader::read(point<T, N>& value)
+    {
+        value = point<T, N>(get<array<T, N>>());
+    }
+
+    template <class T, size_t N>
+    void snapshot_reader::read(direction<T, N>& value)
+    {
+        value = direction<T, N>(get<array<T, N>>());
+    }
+
+    template <class T, size_t R, size_t C>
+    void snapshot_reader::read(matrix<T, R, C>& value)
+    {
+        const auto elements(get<array<T, R * C>>());
+        for (size_t r(0); r < R; ++r)
+            for (size_t c(0); c < C; ++c)
+                value(r, c) = elements[r * C + c];
+    }
+
+    template <class T, class A>
+    void snapshot_reader::read(vector<T, A>& values)
+    {
+        const auto count(get<uint64_t>());
+        if constexpr (is_trivially_copyable_v<T> && !is_same_v<T, bool>)
+        {
+            if (count > remaining() / sizeof(T))
+                throw out_of_range("Snapshot ends inside a vector");
+            values.resize(size_t(count));
+            read_span(values.data(), values.size());
+        }
+        else
+        {
+            values.clear();
+            for (uint64_t i(0); i < count; ++i)
+                values.push_back(get<T>());
+        }
+    }
+
+    template <class T>
+    void snapshot_reader::read_span(T* values, size_t count)
+    {
+        static_assert(is_trivially_copyable_v<T>, "Spans are read raw and must be trivially copyable");
+        read_bytes(values, count * sizeof(T));
+    }
+
+    template <class T>
+    T snapshot_reader::get()
+    {
+        T value{};
+        read(value);
+        return value;
+    }
+} // engine_lib
+
+#endif //STATE_SNAPSHOT_INL
@@ -6,7 +6,9 @@
 #define DIRECTION_HPP
 #include "../../includes.hpp"
 #include <array>
+#include <cmath>
 #include "../point/point.hpp"
+#include "../predicates/predicates.hpp"
 
 namespace engine_lib
 {
@@ -29,14 +31,14 @@ namespace engine_lib
         /**
          * @brief Default constructor for the direction class.
          */
-        direction<T, N>();
+        direction();
 
         /**
          * @brief Constructs a direction from a single point.
          *
          * @param direction_point The point representing the direction.
          */
-        explicit direction<T, N>(const point<T, N>& direction_point);
+        explicit direction(const point<T, N>& direction_point);
 
         /**
          * @brief Constructs a direction from two points.
@@ -44,14 +46,14 @@ namespace engine_lib
          * @param a The starting point.
          * @param b The ending point.
          */
-        explicit direction<T, N>(const point<T, N>& a, const point<T, N>& b);
+        explicit direction(const point<T, N>& a, const point<T, N>& b);
 
         /**
          * @brief Constructs a direction from an array of direction coordinates.
          *
          * @param direction_coordinates The array representing the direction coordinates.
          */
-        explicit direction<T, N>(const array<T, N>& direction_coordinates);
+        explicit direction(const array<T, N>& direction_coordinates);
 
         /**
          * @brief Constructs a direction from two arrays of coordinates.
@@ -59,14 +61,14 @@ namespace engine_lib
          * @param a The array representing the starting point coordinates.
          * @param b The array representing the ending point coordinates.
          */
-        explicit direction<T, N>(const array<T, N>& a, const array<T, N>& b);
+        explicit direction(const array<T, N>& a, const array<T, N>& b);
 
         /**
          * @brief Copy constructor for the direction class.
          *
          * @param other The direction to copy from.
          */
-        direction<T, N>(const direction<T, N>& other);
+        direction(const direction<T, N>& other) = default;
         /**
          * @brief Retrieves the beginning point of the direction.
          *
@@ -174,6 +176,15 @@ namespace engine_lib
          */
         bool orthogonal(const direction<T, N>& other) const;
 
+        /**
+         * @brief Checks if this direction is orthogonal to another direction up to a tolerance.
+         *
+         * @param other The other direction.
+         * @param epsilon Largest accepted cosine of the angle between the directions.
+         * @return True if the directions are orthogonal within the tolerance, false otherwise.
+         */
+        bool orthogonal(const direction<T, N>& other, T epsilon) const;
+
         /**
          * @brief Checks if this direction is colinear with another direction.
          *
@@ -182,6 +193,16 @@ namespace engine_lib
          */
         bool colinear(const direction<T, N>& other) const;
 
+        /**
+         * @brief Checks if this direction is colinear with another direction up to a tolerance.
+         *
+         * @param other The other direction.
+         * @param epsilon Largest accepted sine of the angle between the directions.
+         * @return True if the directions are colinear within the tolerance, false otherwise.
+         * @throws invalid_argument If either direction is zero.
+         */
+        bool colinear(const direction<T, N>& other, T epsilon) const;
+
         /**
          * @brief Checks if this direction is complanar with two other directions.
          *
@@ -190,6 +211,16 @@ namespace engine_lib
          * @return True if the directions are complanar, false otherwise.
          */
         bool complanar(const direction<T, N>& b, const direction<T, N>& c) const;
+
+        /**
+         * @brief Checks if this direction is complanar with two other directions up to a tolerance.
+         *
+         * @param b The second direction.
+         * @param c The third direction.
+         * @param epsilon Largest accepted mixed product of the three directions scaled to unit length.
+         * @return True if the directions are complanar within the tolerance, false otherwise.
+         */
+        bool complanar(const direction<T, N>& b, const direction<T, N>& c, T epsilon) const;
     };
 }
 #endif //DIRECTION_HPP
@@ -7,7 +7,9 @@ namespace engine_lib
 
     template <class T, size_t N>
     direction<T, N>::direction()
-        : point<T, N>()
+        : point<T, N>(),
+          beginning_(),
+          end_()
     {
     }
 
@@ -22,8 +24,8 @@ namespace engine_lib
     template <class T, size_t N>
     direction<T, N>::direction(const point<T, N>& a, const point<T, N>& b)
         : point<T, N>(b - a),
-          beginning_(a),
-          end_(b)
+          beginning_(a.get_coordinates()),
+          end_(b.get_coordinates())
     {
     }
 
@@ -39,14 +41,6 @@ namespace engine_lib
     {
     }
 
-    template <class T, size_t N>
-    direction<T, N>::direction(const direction<T, N>& other)
-        : point<T, N>(other.coordinates_),
-          beginning_(other.beginning_),
-          end_(other.end_)
-    {
-    }
-
     template <class T, size_t N>
     array<T, N> direction<T, N>::get_beginning() const
     {
@@ -96,9 +90,9 @@ namespace engine_lib
     {
         static_assert(N == 3, "Cross product only defined for 3D vectors");
         return direction<T, N>({
-            this->coordinate(1) * other[2] - this->coordinate(2) * other[1],
-            this->coordinate(2) * other[0] - this->coordinate(0) * other[2],
-            this->coordinate(0) * other[1] - this->coordinate(1) * other[0]
+            this->coordinate(1) * other.coordinate(2) - this->coordinate(2) * other.coordinate(1),
+            this->coordinate(2) * other.coordinate(0) - this->coordinate(0) * other.coordinate(2),
+            this->coordinate(0) * other.coordinate(1) - this->coordinate(1) * other.coordinate(0)
         });
     }
 
@@ -127,8 +121,8 @@ namespace engine_lib
     template <class T, size_t N>
     bool direction<T, N>::equal(const direction<T, N>& other) const
     {
-        for (int i = 0; i < N; ++i)
-            if (this->coordinate[i] != other[i])
+        for (size_t i = 0; i < N; ++i)
+            if (this->coordinate(i) != other.coordinate(i))
                 return false;
         return true;
     }
@@ -137,7 +131,25 @@ namespace engine_lib
     template <class T, size_t N>
     bool direction<T, N>::orthogonal(const direction<T, N>& other) const
     {
-        return dot_product(other) == 0;
+        if constexpr (is_same_v<T, float> || is_same_v<T, double>)
+        {
+            array<double, N> a, b;
+            for (size_t i = 0; i < N; ++i)
+            {
+                a[i] = this->coordinate(i);
+                b[i] = other.coordinate(i);
+            }
+            return dot_product_sign(a.data(), b.data(), N) == 0;
+        }
+        else
+            return dot_product(other) == 0;
+    }
+
+    template <class T, size_t N>
+    bool direction<T, N>::orthogonal(const direction<T, N>& other, T epsilon) const
+    {
+        const T dot(dot_product(other));
+        return dot * dot <= epsilon * epsilon * dot_product(*this) * other.dot_product(other);
     }
 
     template <class T, size_t N>
@@ -145,14 +157,67 @@ namespace engine_lib
     {
         if (zero_direction() || other.zero_direction())
             throw std::invalid_argument("Cannot calculate colinearity with zero-direction");
-        T division(this->coordinate(0) / other.coordinate(0));
-        for (int i = 1; i < N; ++i)
+        // every 2x2 minor of the two coordinate rows vanishes, which unlike coordinate ratios
+        // holds for zero coordinates too
+        for (size_t i = 0; i < N; ++i)
+            for (size_t j = i + 1; j < N; ++j)
+            {
+                if constexpr (is_same_v<T, float> || is_same_v<T, double>)
+                {
+                    if (orient2d({double(this->coordinate(i)), double(this->coordinate(j))},
+                                 {double(other.coordinate(i)), double(other.coordinate(j))}, {0, 0}) != 0)
+                        return false;
+                }
+                else if (this->coordinate(i) * other.coordinate(j) != this->coordinate(j) * other.coordinate(i))
+                    return false;
+            }
+        return true;
+    }
+
+    template <class T, size_t N>
+    bool direction<T, N>::colinear(const direction<T, N>& other, T epsilon) const
+    {
+        if (zero_direction() || other.zero_direction())
+            throw std::invalid_argument("Cannot calculate colinearity with zero-direction");
+        // the minors square-sum to |a|^2 |b|^2 sin^2 of the angle between the directions
+        T minors(0);
+        for (size_t i = 0; i < N; ++i)
+            for (size_t j = i + 1; j < N; ++j)
+            {
+                const T minor(this->coordinate(i) * other.coordinate(j) - this->coordinate(j) * other.coordinate(i));
+                minors += minor * minor;
+            }
+        return minors <= epsilon * epsilon * dot_product(*this) * other.dot_product(other);
+    }
+
+
+    template <class T, size_t N>
+    bool direction<T, N>::complanar(const direction<T, N>& b, const direction<T, N>& c) const
+    {
+        if constexpr ((is_same_v<T, float> || is_same_v<T, double>) && N == 3)
         {
-            T division2 = this->coordinate(i) / other.coordinate(i);
-            if (division != division2)
-                return false;
+            const auto to_double([](const direction<T, N>& d)
+            {
+                return array<double, 3>{double(d.coordinate(0)), double(d.coordinate(1)), double(d.coordinate(2))};
+            });
+            return orient3d(to_double(*this), to_double(b), to_double(c), {0, 0, 0}) == 0;
         }
-        return true;
+        else
+            return mixed_product(b, c) == T(0);
+    }
+
+    template <class T, size_t N>
+    bool direction<T, N>::complanar(const direction<T, N>& b, const direction<T, N>& c, T epsilon) const
+    {
+        const T mixed(mixed_product(b, c));
+        return mixed * mixed <= epsilon * epsilon * dot_product(*this) * b.dot_product(b) * c.dot_product(c);
+    }
+
+
+    template <class T, size_t N>
+    T direction<T, N>::mixed_product(const direction<T, N>& b, const direction<T, N>& c) const
+    {
+        return dot_product(b.cross_product(c));
     }
 
 
@@ -0,0 +1,278 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef DYNAMIC_MATRIX_HPP
+#define DYNAMIC_MATRIX_HPP
+#include "../../includes.hpp"
+#include "../matrix/matrix.hpp"
+#include "../simd/float_pack.hpp"
+#include "../../containers/aligned_allocator/aligned_allocator.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <stdexcept>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+    * @brief Heap allocated matrix whose size is chosen at runtime.
+    *
+    * Elements are stored row-major. Every row starts on a cache line boundary, so the
+    * distance between two rows (the stride) may be larger than the number of columns.
+    * Multiplication uses the cache-blocked, multithreaded gemm() kernel.
+    *
+    * @tparam T Type of elements in the matrix.
+    */
+    template <class T>
+    class dynamic_matrix
+    {
+    private:
+        size_t rows_; /// Number of rows.
+        size_t columns_; /// Number of columns.
+        size_t stride_; /// Distance in elements between the starts of two rows.
+        aligned_vector<T> data_; /// Row-major elements including the row padding.
+
+        static size_t padded_columns(size_t columns);
+
+    public:
+        /**
+         * @brief Default constructor. Creates an empty 0x0 matrix.
+         */
+        dynamic_matrix();
+
+        /**
+         * @brief Creates a rows x columns matrix filled with zeros.
+         *
+         * @param rows Number of rows.
+         * @param columns Number of columns.
+         */
+        dynamic_matrix(size_t rows, size_t columns);
+
+        /**
+         * @brief Creates a rows x columns matrix filled with the given value.
+         *
+         * @param rows Number of rows.
+         * @param columns Number of columns.
+         * @param value Value of every element.
+         */
+        dynamic_matrix(size_t rows, size_t columns, T value);
+
+        /**
+         * @brief Copies a fixed-size matrix.
+         *
+         * @tparam N Number of rows in the fixed-size matrix.
+         * @tparam M Number of columns in the fixed-size matrix.
+         * @param other Matrix to be copied.
+         */
+        template <size_t N, size_t M>
+        explicit dynamic_matrix(const matrix<T, N, M>& other);
+
+        /**
+         * @brief Returns the number of rows in the matrix.
+         *
+         * @return Number of rows.
+         */
+        [[nodiscard]] size_t rows() const;
+
+        /**
+         * @brief Returns the number of columns in the matrix.
+         *
+         * @return Number of columns.
+         */
+        [[nodiscard]] size_t columns() const;
+
+        /**
+         * @brief Returns the distance in elements between the starts of two consecutive rows.
+         *
+         * @return Row stride.
+         */
+        [[nodiscard]] size_t stride() const;
+
+        /**
+         * @brief Returns a pointer to the first element of the given row.
+         *
+         * The row is not checked, the pointer is aligned to a cache line.
+         *
+         * @param row Row index.
+         * @return Pointer to the row.
+         */
+        T* row_data(size_t row);
+
+        /**
+         * @brief Returns a pointer to the first element of the given row (const version).
+         *
+         * @param row Row index.
+         * @return Pointer to the row.
+         */
+        const T* row_data(size_t row) const;
+
+        /**
+         * @brief Access the element at the given row and column.
+         *
+         * @param row Row index.
+         * @param column Column index.
+         * @return Reference to the element at the specified position.
+         */
+        T& operator()(size_t row, size_t column);
+
+        /**
+         * @brief Access the element at the given row and column (const version).
+         *
+         * @param row Row index.
+         * @param column Column index.
+         * @return Const reference to the element at the specified position.
+         */
+        const T& operator()(size_t row, size_t column) const;
+
+        /**
+         * @brief Copies the matrix into a fixed-size matrix.
+         *
+         * @tparam N Number of rows, must equal rows().
+         * @tparam M Number of columns, must equal columns().
+         * @return The fixed-size copy.
+         * @throws invalid_argument If the dimensions differ.
+         */
+        template <size_t N, size_t M>
+        matrix<T, N, M> to_matrix() const;
+
+        /**
+         * @brief Sets every element to the given value.
+         *
+         * @param value Value of every element.
+         */
+        void fill(T value);
+
+        /**
+         * @brief Multiply the matrix by a scalar value.
+         *
+         * @param value Scalar value.
+         * @return New matrix resulting from the multiplication.
+         */
+        dynamic_matrix<T> operator*(T value) const;
+
+        /**
+         * @brief Multiply the matrix by a scalar value (in-place).
+         *
+         * @param value Scalar value.
+         * @return Reference to the modified matrix.
+         */
+        dynamic_matrix<T>& operator*=(T value);
+
+        /**
+         * @brief Divide the matrix by a scalar value.
+         *
+         * @param value Scalar value.
+         * @return New matrix resulting from the division.
+         * @throws invalid_argument If the value is zero.
+         */
+        dynamic_matrix<T> operator/(T value) const;
+
+        /**
+         * @brief Divide the matrix by a scalar value (in-place).
+         *
+         * @param value Scalar value.
+         * @return Reference to the modified matrix.
+         * @throws invalid_argument If the value is zero.
+         */
+        dynamic_matrix<T>& operator/=(T value);
+
+        /**
+         * @brief Multiply the matrix by another matrix using the shared thread pool.
+         *
+         * @param other Matrix to multiply with.
+         * @return New matrix resulting from the multiplication.
+         * @throws invalid_argument If columns() differs from other.rows().
+         */
+        dynamic_matrix<T> operator*(const dynamic_matrix<T>& other) const;
+
+        /**
+         * @brief Add another matrix to the current matrix.
+         *
+         * @param other Matrix to add.
+         * @return New matrix resulting from the addition.
+         * @throws invalid_argument If the dimensions differ.
+         */
+        dynamic_matrix<T> operator+(const dynamic_matrix<T>& other) const;
+
+        /**
+         * @brief Add another matrix to the current matrix (in-place).
+         *
+         * @param other Matrix to add.
+         * @return Reference to the modified matrix.
+         * @throws invalid_argument If the dimensions differ.
+         */
+        dynamic_matrix<T>& operator+=(const dynamic_matrix<T>& other);
+
+        /**
+         * @brief Subtract another matrix from the current matrix.
+         *
+         * @param other Matrix to subtract.
+         * @return New matrix resulting from the subtraction.
+         * @throws invalid_argument If the dimensions differ.
+         */
+        dynamic_matrix<T> operator-(const dynamic_matrix<T>& other) const;
+
+        /**
+         * @brief Subtract another matrix from the current matrix (in-place).
+         *
+         * @param other Matrix to subtract.
+         * @return Reference to the modified matrix.
+         * @throws invalid_argument If the dimensions differ.
+         */
+        dynamic_matrix<T>& operator-=(const dynamic_matrix<T>& other);
+
+        /**
+         * @brief Returns the transposed matrix.
+         *
+         * @return New matrix with rows and columns swapped.
+         */
+        dynamic_matrix<T> transposed_matrix() const;
+
+        /**
+         * @brief Calculate the trace of the matrix.
+         *
+         * @return Sum of the main diagonal elements.
+         */
+        T trace() const;
+
+        /**
+         * @brief Checks if the matrix is square.
+         *
+         * @return True if rows() equals columns().
+         */
+        [[nodiscard]] bool is_square_matrix() const;
+
+        /**
+         * @brief Returns the size x size identity matrix.
+         *
+         * @param size Number of rows and columns.
+         * @return Identity matrix.
+         */
+        static dynamic_matrix<T> identity_matrix(size_t size);
+    };
+
+    /**
+     * @brief Computes c = a * b with a cache-blocked kernel spread over the pool's workers.
+     *
+     * The operands are split into kc x nc panels of b and mc x kc blocks of a which are
+     * packed into contiguous buffers sized for the L2 and L1 caches. A register-blocked
+     * micro kernel multiplies the packed slivers; for float it runs on float_pack lanes.
+     * The row blocks of a are distributed across the pool.
+     *
+     * @tparam T Type of elements in the matrices.
+     * @param a Left operand.
+     * @param b Right operand.
+     * @param c Result, resized to a.rows() x b.columns().
+     * @param pool Pool executing the row blocks.
+     * @throws invalid_argument If a.columns() differs from b.rows().
+     */
+    template <class T>
+    void gemm(const dynamic_matrix<T>& a, const dynamic_matrix<T>& b, dynamic_matrix<T>& c,
+              thread_pool& pool = thread_pool::global());
+} // engine_lib
+
+#endif //DYNAMIC_MATRIX_HPP
+#include "dynamic_matrix.inl"
+#include "gemm.inl"
@@ -0,0 +1,250 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+#ifndef DYNAMIC_MATRIX_INL
+#define DYNAMIC_MATRIX_INL
+
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    size_t dynamic_matrix<T>::padded_columns(size_t columns)
+    {
+        if (cache_line_size % sizeof(T) != 0)
+            return columns;
+        const size_t per_line(cache_line_size / sizeof(T));
+        return (columns + per_line - 1) / per_line * per_line;
+    }
+
+    template <class T>
+    dynamic_matrix<T>::dynamic_matrix()
+        : rows_(0),
+          columns_(0),
+          stride_(0)
+    {
+    }
+
+    template <class T>
+    dynamic_matrix<T>::dynamic_matrix(size_t rows, size_t columns)
+        : dynamic_matrix(rows, columns, T(0))
+    {
+    }
+
+    template <class T>
+    dynamic_matrix<T>::dynamic_matrix(size_t rows, size_t columns, T value)
+        : rows_(rows),
+          columns_(columns),
+          stride_(padded_columns(columns)),
+          data_(rows * padded_columns(columns), T(0))
+    {
+        if (value != T(0))
+            fill(value);
+    }
+
+    template <class T>
+    template <size_t N, size_t M>
+    dynamic_matrix<T>::dynamic_matrix(const matrix<T, N, M>& other)
+        : dynamic_matrix(N, M)
+    {
+        for (size_t i(0); i < N; ++i)
+            for (size_t j(0); j < M; ++j)
+                row_data(i)[j] = other(i, j);
+    }
+
+    template <class T>
+    size_t dynamic_matrix<T>::rows() const
+    {
+        return rows_;
+    }
+
+    template <class T>
+    size_t dynamic_matrix<T>::columns() const
+    {
+        return columns_;
+    }
+
+    template <class T>
+    size_t dynamic_matrix<T>::stride() const
+    {
+        return stride_;
+    }
+
+    template <class T>
+    T* dynamic_matrix<T>::row_data(size_t row)
+    {
+        return data_.data() + row * stride_;
+    }
+
+    template <class T>
+    const T* dynamic_matrix<T>::row_data(size_t row) const
+    {
+        return data_.data() + row * stride_;
+    }
+
+    template <class T>
+    T& dynamic_matrix<T>::operator()(size_t row, size_t column)
+    {
+        if (row >= rows_)
+            throw std::out_of_range("Invalid row index");
+        if (column >= columns_)
+            throw std::out_of_range("Invalid column index");
+        return data_[row * stride_ + column];
+    }
+
+    template <class T>
+    const T& dynamic_matrix<T>::operator()(size_t row, size_t column) const
+    {
+        if (row >= rows_)
+            throw std::out_of_range("Invalid row index");
+        if (column >= columns_)
+            throw std::out_of_range("Invalid column index");
+        return data_[row * stride_ + column];
+    }
+
+    template <class T>
+    template <size_t N, size_t M>
+    matrix<T, N, M> dynamic_matrix<T>::to_matrix() const
+    {
+        if (rows_ != N || columns_ != M)
+            throw invalid_argument("Matrices dimensions mismatch");
+
+        matrix<T, N, M> result;
+        for (size_t i(0); i < N; ++i)
+            for (size_t j(0); j < M; ++j)
+                result(i, j) = row_data(i)[j];
+        return result;
+    }
+
+    template <class T>
+    void dynamic_matrix<T>::fill(T value)
+    {
+        for (size_t i(0); i < rows_; ++i)
+        {
+            T* row(row_data(i));
+            for (size_t j(0); j < columns_; ++j)
+                row[j] = value;
+        }
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::operator*(T value) const
+    {
+        dynamic_matrix<T> result(*this);
+        result *= value;
+        return result;
+    }
+
+    template <class T>
+    dynamic_matrix<T>& dynamic_matrix<T>::operator*=(T value)
+    {
+        // padding stays zero, so the whole buffer can be scaled at once
+        for (T& element : data_)
+            element *= value;
+        return *this;
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::operator/(T value) const
+    {
+        if (value == T(0))
+            throw invalid_argument("Division by zero");
+        dynamic_matrix<T> result(*this);
+        result /= value;
+        return result;
+    }
+
+    template <class T>
+    dynamic_matrix<T>& dynamic_matrix<T>::operator/=(T value)
+    {
+        if (value == T(0))
+            throw invalid_argument("Division by zero");
+        for (T& element : data_)
+            element /= value;
+        return *this;
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::operator*(const dynamic_matrix<T>& other) const
+    {
+        dynamic_matrix<T> result;
+        gemm(*this, other, result);
+        return result;
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::operator+(const dynamic_matrix<T>& other) const
+    {
+        dynamic_matrix<T> result(*this);
+        result += other;
+        return result;
+    }
+
+    template <class T>
+    dynamic_matrix<T>& dynamic_matrix<T>::operator+=(const dynamic_matrix<T>& other)
+    {
+        if (rows_ != other.rows_ || columns_ != other.columns_)
+            throw invalid_argument("Matrices dimensions mismatch");
+        for (size_t i(0); i < data_.size(); ++i)
+            data_[i] += other.data_[i];
+        return *this;
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::operator-(const dynamic_matrix<T>& other) const
+    {
+        dynamic_matrix<T> result(*this);
+        result -= other;
+        return result;
+    }
+
+    template <class T>
+    dynamic_matrix<T>& dynamic_matrix<T>::operator-=(const dynamic_matrix<T>& other)
+    {
+        if (rows_ != other.rows_ || columns_ != other.columns_)
+            throw invalid_argument("Matrices dimensions mismatch");
+        for (size_t i(0); i < data_.size(); ++i)
+            data_[i] -= other.data_[i];
+        return *this;
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::transposed_matrix() const
+    {
+        // walk in square tiles so both sides stay in cache
+        constexpr size_t tile(32);
+        dynamic_matrix<T> result(columns_, rows_);
+        for (size_t i0(0); i0 < rows_; i0 += tile)
+            for (size_t j0(0); j0 < columns_; j0 += tile)
+                for (size_t i(i0); i < min(i0 + tile, rows_); ++i)
+                    for (size_t j(j0); j < min(j0 + tile, columns_); ++j)
+                        result.row_data(j)[i] = row_data(i)[j];
+        return result;
+    }
+
+    template <class T>
+    T dynamic_matrix<T>::trace() const
+    {
+        T sum(0);
+        for (size_t i(0); i < min(rows_, columns_); ++i)
+            sum += row_data(i)[i];
+        return sum;
+    }
+
+    template <class T>
+    bool dynamic_matrix<T>::is_square_matrix() const
+    {
+        return rows_ == columns_;
+    }
+
+    template <class T>
+    dynamic_matrix<T> dynamic_matrix<T>::identity_matrix(size_t size)
+    {
+        dynamic_matrix<T> identity(size, size);
+        for (size_t i(0); i < size; ++i)
+            identity.row_data(i)[i] = T(1);
+        return identity;
+    }
+} // engine_lib
+#endif
@@ -0,0 +1,176 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+#ifndef GEMM_INL
+#define GEMM_INL
+
+
+namespace engine_lib
+{
+    using namespace std;
+
+    namespace detail
+    {
+        /*
+         * Blocking parameters. mr x nr is the register tile of the micro kernel,
+         * an mc x kc block of a is sized for L2 and a kc x nr sliver of b for L1.
+         */
+        template <class T>
+        struct gemm_traits
+        {
+            static constexpr size_t mr = 4;
+            static constexpr size_t nr = 4;
+            static constexpr size_t mc = 64;
+            static constexpr size_t kc = 256;
+            static constexpr size_t nc = 2048;
+        };
+
+        template <>
+        struct gemm_traits<float>
+        {
+            static constexpr size_t mr = 6;
+            static constexpr size_t nr = 2 * native_float_width;
+            static constexpr size_t mc = 72;
+            static constexpr size_t kc = 256;
+            static constexpr size_t nc = 3072;
+        };
+
+        // copies rows [row, row + m) x columns [depth, depth + k) of a into mr-row slivers
+        template <class T>
+        void gemm_pack_a(const dynamic_matrix<T>& a, size_t row, size_t m, size_t depth, size_t k, T* packed)
+        {
+            constexpr size_t mr(gemm_traits<T>::mr);
+            for (size_t i0(0); i0 < m; i0 += mr)
+                for (size_t p(0); p < k; ++p)
+                    for (size_t i(0); i < mr; ++i)
+                        *packed++ = i0 + i < m ? a.row_data(row + i0 + i)[depth + p] : T(0);
+        }
+
+        // copies rows [depth, depth + k) x columns [column, column + n) of b into nr-column slivers
+        template <class T>
+        void gemm_pack_b(const dynamic_matrix<T>& b, size_t depth, size_t k, size_t column, size_t n, T* packed)
+        {
+            constexpr size_t nr(gemm_traits<T>::nr);
+            for (size_t j0(0); j0 < n; j0 += nr)
+                for (size_t p(0); p < k; ++p)
+                {
+                    const T* source(b.row_data(depth + p) + column + j0);
+                    for (size_t j(0); j < nr; ++j)
+                        *packed++ = j0 + j < n ? source[j] : T(0);
+                }
+        }
+
+        // c[0..m) x [0..n) += packed a sliver * packed b sliver
+        template <class T>
+        void gemm_micro_kernel(size_t k, const T* a, const T* b, T* c, size_t ldc, size_t m, size_t n)
+        {
+            constexpr size_t mr(gemm_traits<T>::mr),
+                             nr(gemm_traits<T>::nr);
+            T accumulator[mr][nr] = {};
+            for (size_t p(0); p < k; ++p, a += mr, b += nr)
+                for (size_t i(0); i < mr; ++i)
+                    for (size_t j(0); j < nr; ++j)
+                        accumulator[i][j] += a[i] * b[j];
+
+            for (size_t i(0); i < m; ++i)
+                for (size_t j(0); j < n; ++j)
+                    c[i * ldc + j] += accumulator[i][j];
+        }
+
+        inline void gemm_micro_kernel(size_t k, const float* a, const float* b, float* c, size_t ldc,
+                                      size_t m, size_t n)
+        {
+            constexpr size_t mr(gemm_traits<float>::mr),
+                             nr(gemm_traits<float>::nr),
+                             w(native_float_width);
+            native_float_pack accumulator[mr][2];
+            for (size_t p(0); p < k; ++p, a += mr, b += nr)
+            {
+                const native_float_pack b0(native_float_pack::load(b)),
+                                        b1(native_float_pack::load(b + w));
+                for (size_t i(0); i < mr; ++i)
+                {
+                    const native_float_pack a_i(a[i]);
+                    accumulator[i][0] = mul_add(a_i, b0, accumulator[i][0]);
+                    accumulator[i][1] = mul_add(a_i, b1, accumulator[i][1]);
+                }
+            }
+
+            if (m == mr && n == nr)
+            {
+                for (size_t i(0); i < mr; ++i, c += ldc)
+                {
+                    (native_float_pack::load_unaligned(c) + accumulator[i][0]).store_unaligned(c);
+                    (native_float_pack::load_unaligned(c + w) + accumulator[i][1]).store_unaligned(c + w);
+                }
+                return;
+            }
+
+            // edge tile, spill the registers and add only the valid part
+            alignas(cache_line_size) float tile[nr];
+            for (size_t i(0); i < m; ++i, c += ldc)
+            {
+                accumulator[i][0].store(tile);
+                accumulator[i][1].store(tile + w);
+                for (size_t j(0); j < n; ++j)
+                    c[j] += tile[j];
+            }
+        }
+    } // detail
+
+    template <class T>
+    void gemm(const dynamic_matrix<T>& a, const dynamic_matrix<T>& b, dynamic_matrix<T>& c, thread_pool& pool)
+    {
+        if (a.columns() != b.rows())
+            throw invalid_argument("Matrices dimensions mismatch");
+        if (&c == &a || &c == &b)
+            throw invalid_argument("Result matrix must not alias an operand");
+
+        using traits = detail::gemm_traits<T>;
+        const size_t m(a.rows()),
+                     n(b.columns()),
+                     k(a.columns());
+
+        if (c.rows() != m || c.columns() != n)
+            c = dynamic_matrix<T>(m, n);
+        else
+            c.fill(T(0));
+        if (m == 0 || n == 0 || k == 0)
+            return;
+
+        aligned_vector<T> packed_b((min(n, traits::nc) + traits::nr - 1) / traits::nr * traits::nr * traits::kc);
+        const size_t row_blocks((m + traits::mc - 1) / traits::mc);
+
+        for (size_t jc(0); jc < n; jc += traits::nc)
+        {
+            const size_t nc(min(traits::nc, n - jc));
+            for (size_t pc(0); pc < k; pc += traits::kc)
+            {
+                const size_t kc(min(traits::kc, k - pc));
+                detail::gemm_pack_b(b, pc, kc, jc, nc, packed_b.data());
+
+                pool.parallel_for(0, row_blocks, 1, [&](size_t first, size_t last)
+                {
+                    aligned_vector<T> packed_a(traits::mc * kc);
+                    for (size_t block(first); block < last; ++block)
+                    {
+                        const size_t ic(block * traits::mc),
+                                     mc(min(traits::mc, m - ic));
+                        detail::gemm_pack_a(a, ic, mc, pc, kc, packed_a.data());
+
+                        for (size_t jr(0); jr < nc; jr += traits::nr)
+                            for (size_t ir(0); ir < mc; ir += traits::mr)
+                                detail::gemm_micro_kernel(kc,
+                                                          packed_a.data() + ir * kc,
+                                                          packed_b.data() + jr * kc,
+                                                          c.row_data(ic + ir) + jc + jr,
+                                                          c.stride(),
+                                                          min(traits::mr, mc - ir),
+                                                          min(traits::nr, nc - jr));
+                    }
+                });
+            }
+        }
+    }
+} // engine_lib
+#endif
@@ -0,0 +1,182 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef FIXED_HPP
+#define FIXED_HPP
+#include "../../includes.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class fixed
+     * @brief A signed fixed-point number with I integer bits (sign included) and F fraction bits.
+     *
+     * All arithmetic is done on integers, so results are bit-identical on every platform,
+     * which makes the type suitable for lockstep simulation. Multiplication rounds to the
+     * nearest representable value, division truncates toward zero and overflow wraps.
+     *
+     * Integers convert implicitly, so the type works wherever the math templates write
+     * T(0) or compare against 0. Floating-point values must be converted explicitly.
+     *
+     * @tparam I Number of integer bits including the sign.
+     * @tparam F Number of fraction bits.
+     *
+     * @throws invalid_argument On division by zero or the square root of a negative value.
+     */
+    template <size_t I, size_t F>
+    class fixed
+    {
+        static_assert(I + F <= 32, "fixed supports at most 32 bits of storage");
+        static_assert(I > 1 && F > 0, "fixed needs a sign bit, an integer bit and fraction bits");
+
+    public:
+        using storage_type = int32_t;
+        using wide_type = int64_t;
+
+        static constexpr size_t integer_bits = I;
+        static constexpr size_t fraction_bits = F;
+        static constexpr storage_type one = storage_type(1) << F;
+
+    private:
+        storage_type raw_; /// The value multiplied by 2^F.
+
+    public:
+        /**
+         * @brief Default constructor. Initializes the value with zero.
+         */
+        constexpr fixed();
+
+        /**
+         * @brief Converts an integer.
+         *
+         * @param value The integer value.
+         */
+        constexpr fixed(int value);
+
+        /**
+         * @brief Converts a float, rounding to the nearest representable value.
+         *
+         * @param value The float value.
+         */
+        explicit fixed(float value);
+
+        /**
+         * @brief Converts a double, rounding to the nearest representable value.
+         *
+         * @param value The double value.
+         */
+        explicit fixed(double value);
+
+        /**
+         * @brief Creates a value from its raw representation.
+         *
+         * @param raw The value multiplied by 2^F.
+         * @return The fixed-point value.
+         */
+        static constexpr fixed from_raw(storage_type raw);
+
+        /**
+         * @brief Returns the raw representation.
+         *
+         * @return The value multiplied by 2^F.
+         */
+        [[nodiscard]] constexpr storage_type raw() const;
+
+        explicit operator float() const;
+        explicit operator double() const;
+
+        /**
+         * @brief Converts to int, truncating toward zero.
+         */
+        explicit constexpr operator int() const;
+
+        constexpr fixed operator-() const;
+        fixed& operator+=(fixed other);
+        fixed& operator-=(fixed other);
+        fixed& operator*=(fixed other);
+        fixed& operator/=(fixed other);
+
+        friend constexpr fixed operator+(fixed a, fixed b) { return from_raw(storage_type(uint32_t(a.raw_) + uint32_t(b.raw_))); }
+        friend constexpr fixed operator-(fixed a, fixed b) { return from_raw(storage_type(uint32_t(a.raw_) - uint32_t(b.raw_))); }
+
+        friend constexpr fixed operator*(fixed a, fixed b)
+        {
+            const wide_type product(wide_type(a.raw_) * wide_type(b.raw_));
+            return from_raw(storage_type((product + (wide_type(1) << (F - 1))) >> F));
+        }
+
+        friend fixed operator/(fixed a, fixed b)
+        {
+            if (b.raw_ == 0)
+                throw invalid_argument("Division by zero");
+            return from_raw(storage_type(wide_type(uint64_t(wide_type(a.raw_)) << F) / b.raw_));
+        }
+
+        friend constexpr bool operator==(fixed a, fixed b) { return a.raw_ == b.raw_; }
+        friend constexpr bool operator!=(fixed a, fixed b) { return a.raw_ != b.raw_; }
+        friend constexpr bool operator<(fixed a, fixed b) { return a.raw_ < b.raw_; }
+        friend constexpr bool operator<=(fixed a, fixed b) { return a.raw_ <= b.raw_; }
+        friend constexpr bool operator>(fixed a, fixed b) { return a.raw_ > b.raw_; }
+        friend constexpr bool operator>=(fixed a, fixed b) { return a.raw_ >= b.raw_; }
+
+        /**
+         * @brief Absolute value.
+         */
+        friend constexpr fixed abs(fixed value) { return value.raw_ < 0 ? -value : value; }
+
+        /**
+         * @brief Square root computed bit by bit on integers, rounded to the nearest fraction bit.
+         *
+         * @throws invalid_argument If the value is negative.
+         */
+        friend fixed sqrt(fixed value) { return value.square_root(); }
+
+    private:
+        fixed square_root() const;
+    };
+
+    /**
+     * @brief 16.16 fixed-point number, range [-32768, 32768) with a resolution of 2^-16.
+     */
+    using fixed16_16 = fixed<16, 16>;
+} // engine_lib
+
+namespace std
+{
+    /**
+     * @brief Limits of engine_lib::fixed, shaped after the integer specializations.
+     */
+    template <size_t I, size_t F>
+    class numeric_limits<engine_lib::fixed<I, F>>
+    {
+        using type = engine_lib::fixed<I, F>;
+        using storage = typename type::storage_type;
+
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = true;
+        static constexpr bool has_infinity = false;
+        static constexpr bool has_quiet_NaN = false;
+        static constexpr bool is_modulo = true;
+        static constexpr int digits = int(I + F) - 1;
+        static constexpr int radix = 2;
+
+        static constexpr type min() noexcept { return type::from_raw(numeric_limits<storage>::min()); }
+        static constexpr type lowest() noexcept { return type::from_raw(numeric_limits<storage>::min()); }
+        static constexpr type max() noexcept { return type::from_raw(numeric_limits<storage>::max()); }
+        static constexpr type epsilon() noexcept { return type::from_raw(1); }
+        static constexpr type round_error() noexcept { return type::from_raw(type::one / 2); }
+    };
+} // std
+
+#endif //FIXED_HPP
+#include "fixed.inl"
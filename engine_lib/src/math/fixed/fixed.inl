@@ -0,0 +1,126 @@
+#ifndef FIXED_INL
+#define FIXED_INL
+
+#include <cmath>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <size_t I, size_t F>
+    constexpr fixed<I, F>::fixed()
+        : raw_(0)
+    {
+    }
+
+    template <size_t I, size_t F>
+    constexpr fixed<I, F>::fixed(int value)
+        : raw_(storage_type(uint32_t(value) << F))
+    {
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>::fixed(float value)
+        : fixed(double(value))
+    {
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>::fixed(double value)
+        : raw_(storage_type(llround(value * double(one))))
+    {
+    }
+
+    template <size_t I, size_t F>
+    constexpr fixed<I, F> fixed<I, F>::from_raw(storage_type raw)
+    {
+        fixed result;
+        result.raw_ = raw;
+        return result;
+    }
+
+    template <size_t I, size_t F>
+    constexpr typename fixed<I, F>::storage_type fixed<I, F>::raw() const
+    {
+        return raw_;
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>::operator float() const
+    {
+        return float(raw_) / float(one);
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>::operator double() const
+    {
+        return double(raw_) / double(one);
+    }
+
+    template <size_t I, size_t F>
+    constexpr fixed<I, F>::operator int() const
+    {
+        return int(raw_ / one);
+    }
+
+    template <size_t I, size_t F>
+    constexpr fixed<I, F> fixed<I, F>::operator-() const
+    {
+        return from_raw(storage_type(0u - uint32_t(raw_)));
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>& fixed<I, F>::operator+=(fixed other)
+    {
+        return *this = *this + other;
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>& fixed<I, F>::operator-=(fixed other)
+    {
+        return *this = *this - other;
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>& fixed<I, F>::operator*=(fixed other)
+    {
+        return *this = *this * other;
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F>& fixed<I, F>::operator/=(fixed other)
+    {
+        return *this = *this / other;
+    }
+
+    template <size_t I, size_t F>
+    fixed<I, F> fixed<I, F>::square_root() const
+    {
+        if (raw_ < 0)
+            throw invalid_argument("Square root of a negative value");
+
+        // sqrt(raw / 2^F) * 2^F == sqrt(raw * 2^F)
+        uint64_t remainder(uint64_t(raw_) << F),
+                 result(0),
+                 bit(uint64_t(1) << 62);
+        while (bit > remainder)
+            bit >>= 2;
+        while (bit != 0)
+        {
+            if (remainder >= result + bit)
+            {
+                remainder -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+                result >>= 1;
+            bit >>= 2;
+        }
+        // remainder == n - result^2, round up past (result + 0.5)^2
+        if (remainder > result)
+            ++result;
+        return from_raw(storage_type(result));
+    }
+} // engine_lib
+
+#endif
@@ -0,0 +1,38 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "half.hpp"
+
+namespace engine_lib
+{
+    static_assert(sizeof(half) == 2, "half must stay a two byte storage type");
+
+    void convert(const half* source, float* destination, size_t count)
+    {
+        size_t i(0);
+#if defined(__F16C__)
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+            _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(packed));
+        }
+#endif
+        for (; i < count; ++i)
+            destination[i] = float(source[i]);
+    }
+
+    void convert(const float* source, half* destination, size_t count)
+    {
+        size_t i(0);
+#if defined(__F16C__)
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed(_mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+        }
+#endif
+        for (; i < count; ++i)
+            destination[i] = half(source[i]);
+    }
+} // engine_lib
@@ -0,0 +1,178 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef HALF_HPP
+#define HALF_HPP
+#include "../../includes.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class half
+     * @brief IEEE 754 binary16 floating-point number.
+     *
+     * half is a storage format: it halves the memory of float point clouds and vertex
+     * streams. Arithmetic is performed in float and rounded back to half after every
+     * operation (round to nearest even), which matches GPU half precision behaviour.
+     *
+     * Integers convert implicitly, so the type works wherever the math templates write
+     * T(0) or compare against 0. float and double must be converted explicitly.
+     */
+    class half
+    {
+        uint16_t bits_; /// Sign, 5 exponent bits and 10 mantissa bits.
+
+    public:
+        /**
+         * @brief Default constructor. Initializes the value with +0.
+         */
+        half();
+
+        /**
+         * @brief Converts an integer, rounding to the nearest representable value.
+         *
+         * @param value The integer value.
+         */
+        half(int value);
+
+        /**
+         * @brief Converts a float, rounding to the nearest even representable value.
+         *
+         * Values beyond 65504 become infinity, NaN stays NaN.
+         *
+         * @param value The float value.
+         */
+        explicit half(float value);
+
+        /**
+         * @brief Converts a double through float.
+         *
+         * @param value The double value.
+         */
+        explicit half(double value);
+
+        /**
+         * @brief Creates a value from its bit pattern.
+         *
+         * @param bits The binary16 bit pattern.
+         * @return The half value.
+         */
+        static half from_bits(uint16_t bits);
+
+        /**
+         * @brief Returns the bit pattern.
+         *
+         * @return The binary16 bit pattern.
+         */
+        [[nodiscard]] uint16_t bits() const;
+
+        explicit operator float() const;
+        explicit operator double() const;
+        explicit operator int() const;
+
+        half operator-() const;
+        half& operator+=(half other);
+        half& operator-=(half other);
+        half& operator*=(half other);
+        half& operator/=(half other);
+
+        friend half operator+(half a, half b) { return half(float(a) + float(b)); }
+        friend half operator-(half a, half b) { return half(float(a) - float(b)); }
+        friend half operator*(half a, half b) { return half(float(a) * float(b)); }
+        friend half operator/(half a, half b) { return half(float(a) / float(b)); }
+
+        friend bool operator==(half a, half b) { return float(a) == float(b); }
+        friend bool operator!=(half a, half b) { return float(a) != float(b); }
+        friend bool operator<(half a, half b) { return float(a) < float(b); }
+        friend bool operator<=(half a, half b) { return float(a) <= float(b); }
+        friend bool operator>(half a, half b) { return float(a) > float(b); }
+        friend bool operator>=(half a, half b) { return float(a) >= float(b); }
+
+        friend half abs(half value) { return from_bits(uint16_t(value.bits_ & 0x7FFFu)); }
+        friend half sqrt(half value) { return half(std::sqrt(float(value))); }
+        friend bool isnan(half value) { return (value.bits_ & 0x7FFFu) > 0x7C00u; }
+        friend bool isinf(half value) { return (value.bits_ & 0x7FFFu) == 0x7C00u; }
+    };
+
+    /**
+     * @brief Converts a float bit pattern to the nearest binary16 bit pattern.
+     *
+     * @param value The float value.
+     * @return The binary16 bit pattern.
+     */
+    uint16_t float_to_half_bits(float value);
+
+    /**
+     * @brief Converts a binary16 bit pattern to float, exactly.
+     *
+     * @param bits The binary16 bit pattern.
+     * @return The float value.
+     */
+    float half_bits_to_float(uint16_t bits);
+
+    /**
+     * @brief Converts an array of halves to floats, eight at a time where F16C is available.
+     *
+     * @param source Halves to convert.
+     * @param destination Receives count floats.
+     * @param count Number of values.
+     */
+    void convert(const half* source, float* destination, size_t count);
+
+    /**
+     * @brief Converts an array of floats to halves, eight at a time where F16C is available.
+     *
+     * @param source Floats to convert.
+     * @param destination Receives count halves.
+     * @param count Number of values.
+     */
+    void convert(const float* source, half* destination, size_t count);
+} // engine_lib
+
+namespace std
+{
+    /**
+     * @brief Limits of engine_lib::half, the binary16 counterpart of numeric_limits<float>.
+     */
+    template <>
+    class numeric_limits<engine_lib::half>
+    {
+        using type = engine_lib::half;
+
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = false;
+        static constexpr bool has_infinity = true;
+        static constexpr bool has_quiet_NaN = true;
+        static constexpr int digits = 11;
+        static constexpr int radix = 2;
+        static constexpr int min_exponent = -13;
+        static constexpr int max_exponent = 16;
+
+        static type min() noexcept { return type::from_bits(0x0400u); }
+        static type lowest() noexcept { return type::from_bits(0xFBFFu); }
+        static type max() noexcept { return type::from_bits(0x7BFFu); }
+        static type epsilon() noexcept { return type::from_bits(0x1400u); }
+        static type round_error() noexcept { return type::from_bits(0x3800u); }
+        static type infinity() noexcept { return type::from_bits(0x7C00u); }
+        static type quiet_NaN() noexcept { return type::from_bits(0x7E00u); }
+        static type denorm_min() noexcept { return type::from_bits(0x0001u); }
+    };
+} // std
+
+#endif //HALF_HPP
+#include "half.inl"
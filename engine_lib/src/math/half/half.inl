@@ -0,0 +1,142 @@
+#ifndef HALF_INL
+#define HALF_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    inline uint16_t float_to_half_bits(float value)
+    {
+        // round to nearest even on the float bit pattern, after F. Giesen's float_to_half_fast3_rtne
+        constexpr uint32_t float_infinity(255u << 23),
+                           half_overflow((127u + 16u) << 23),
+                           denormal_magic(((127u - 15u) + (23u - 10u) + 1u) << 23);
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign(bits & 0x80000000u);
+        bits ^= sign;
+
+        uint16_t result;
+        if (bits >= half_overflow)
+            result = bits > float_infinity ? 0x7E00u : 0x7C00u;
+        else if (bits < (113u << 23))
+        {
+            // below the smallest normal half, let the FPU round the mantissa into place
+            float magnitude, magic;
+            memcpy(&magnitude, &bits, sizeof(bits));
+            memcpy(&magic, &denormal_magic, sizeof(magic));
+            magnitude += magic;
+            memcpy(&bits, &magnitude, sizeof(bits));
+            result = uint16_t(bits - denormal_magic);
+        }
+        else
+        {
+            const uint32_t odd_mantissa((bits >> 13) & 1u);
+            bits += (uint32_t(15 - 127) << 23) + 0xFFFu;
+            bits += odd_mantissa;
+            result = uint16_t(bits >> 13);
+        }
+        return uint16_t(result | (sign >> 16));
+    }
+
+    inline float half_bits_to_float(uint16_t bits)
+    {
+        constexpr uint32_t shifted_exponent(0x7C00u << 13);
+        uint32_t result((uint32_t(bits) & 0x7FFFu) << 13);
+        const uint32_t exponent(result & shifted_exponent);
+        result += uint32_t(127 - 15) << 23;
+
+        if (exponent == shifted_exponent)
+            result += uint32_t(128 - 16) << 23;
+        else if (exponent == 0)
+        {
+            // denormal, renormalize through the FPU
+            constexpr uint32_t magic_bits(113u << 23);
+            float magic, value;
+            result += 1u << 23;
+            memcpy(&value, &result, sizeof(value));
+            memcpy(&magic, &magic_bits, sizeof(magic));
+            value -= magic;
+            memcpy(&result, &value, sizeof(result));
+        }
+        result |= (uint32_t(bits) & 0x8000u) << 16;
+
+        float value;
+        memcpy(&value, &result, sizeof(value));
+        return value;
+    }
+
+    inline half::half()
+        : bits_(0)
+    {
+    }
+
+    inline half::half(int value)
+        : bits_(float_to_half_bits(float(value)))
+    {
+    }
+
+    inline half::half(float value)
+        : bits_(float_to_half_bits(value))
+    {
+    }
+
+    inline half::half(double value)
+        : bits_(float_to_half_bits(float(value)))
+    {
+    }
+
+    inline half half::from_bits(uint16_t bits)
+    {
+        half result;
+        result.bits_ = bits;
+        return result;
+    }
+
+    inline uint16_t half::bits() const
+    {
+        return bits_;
+    }
+
+    inline half::operator float() const
+    {
+        return half_bits_to_float(bits_);
+    }
+
+    inline half::operator double() const
+    {
+        return double(half_bits_to_float(bits_));
+    }
+
+    inline half::operator int() const
+    {
+        return int(half_bits_to_float(bits_));
+    }
+
+    inline half half::operator-() const
+    {
+        return from_bits(uint16_t(bits_ ^ 0x8000u));
+    }
+
+    inline half& half::operator+=(half other)
+    {
+        return *this = *this + other;
+    }
+
+    inline half& half::operator-=(half other)
+    {
+        return *this = *this - other;
+    }
+
+    inline half& half::operator*=(half other)
+    {
+        return *this = *this * other;
+    }
+
+    inline half& half::operator/=(half other)
+    {
+        return *this = *this / other;
+    }
+} // engine_lib
+
+#endif
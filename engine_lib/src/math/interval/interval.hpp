@@ -0,0 +1,89 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef INTERVAL_HPP
+#define INTERVAL_HPP
+#include "../../includes.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class interval
+     * @brief A closed range of floating-point values certainly containing an exact result.
+     *
+     * Every operation rounds its bounds outward by one unit in the last place, which covers
+     * the half unit of round-to-nearest, so the exact result of the same operations on the
+     * exact inputs always lies inside. Sign tests are certain only when the interval excludes
+     * zero; predicates use that as a cheap filter before exact arithmetic.
+     *
+     * @tparam T float or double.
+     */
+    template <class T>
+    class interval
+    {
+        T lower_; /// Smallest value the result may have.
+        T upper_; /// Largest value the result may have.
+
+        static interval widened(T lower, T upper);
+
+    public:
+        /**
+         * @brief Creates the interval holding exactly zero.
+         */
+        interval();
+
+        /**
+         * @brief Creates the interval holding exactly one value.
+         *
+         * @param value The value.
+         */
+        interval(T value);
+
+        /**
+         * @brief Creates an interval from its bounds.
+         *
+         * @param lower Smallest value.
+         * @param upper Largest value.
+         * @throws invalid_argument If lower is above upper.
+         */
+        interval(T lower, T upper);
+
+        interval operator+(const interval& other) const;
+        interval operator-(const interval& other) const;
+        interval operator*(const interval& other) const;
+        interval operator-() const;
+        interval& operator+=(const interval& other);
+        interval& operator-=(const interval& other);
+        interval& operator*=(const interval& other);
+
+        /**
+         * @brief Divides by an interval excluding zero.
+         *
+         * @param other The divisor.
+         * @return The quotient.
+         * @throws domain_error If the divisor contains zero.
+         */
+        interval operator/(const interval& other) const;
+
+        /**
+         * @brief Returns the sign of every value in the interval.
+         *
+         * @return 1 or -1 if the interval lies above or below zero, 0 if it contains zero and the sign is unknown.
+         */
+        [[nodiscard]] int certain_sign() const;
+
+        [[nodiscard]] bool contains(T value) const;
+        [[nodiscard]] T lower() const;
+        [[nodiscard]] T upper() const;
+        [[nodiscard]] T width() const;
+    };
+} // engine_lib
+
+#endif //INTERVAL_HPP
+#include "interval.inl"
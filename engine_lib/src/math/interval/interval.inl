@@ -0,0 +1,124 @@
+#ifndef INTERVAL_INL
+#define INTERVAL_INL
+
+#include <algorithm>
+#include <limits>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    interval<T> interval<T>::widened(T lower, T upper)
+    {
+        interval result;
+        result.lower_ = nextafter(lower, -numeric_limits<T>::infinity());
+        result.upper_ = nextafter(upper, numeric_limits<T>::infinity());
+        return result;
+    }
+
+    template <class T>
+    interval<T>::interval() : lower_(0), upper_(0)
+    {
+    }
+
+    template <class T>
+    interval<T>::interval(T value) : lower_(value), upper_(value)
+    {
+    }
+
+    template <class T>
+    interval<T>::interval(T lower, T upper) : lower_(lower), upper_(upper)
+    {
+        if (lower > upper)
+            throw invalid_argument("Interval bounds are reversed");
+    }
+
+    template <class T>
+    interval<T> interval<T>::operator+(const interval& other) const
+    {
+        return widened(lower_ + other.lower_, upper_ + other.upper_);
+    }
+
+    template <class T>
+    interval<T> interval<T>::operator-(const interval& other) const
+    {
+        return widened(lower_ - other.upper_, upper_ - other.lower_);
+    }
+
+    template <class T>
+    interval<T> interval<T>::operator*(const interval& other) const
+    {
+        const T a(lower_ * other.lower_), b(lower_ * other.upper_), c(upper_ * other.lower_), d(upper_ * other.upper_);
+        return widened(min(min(a, b), min(c, d)), max(max(a, b), max(c, d)));
+    }
+
+    template <class T>
+    interval<T> interval<T>::operator-() const
+    {
+        return interval(-upper_, -lower_);
+    }
+
+    template <class T>
+    interval<T>& interval<T>::operator+=(const interval& other)
+    {
+        return *this = *this + other;
+    }
+
+    template <class T>
+    interval<T>& interval<T>::operator-=(const interval& other)
+    {
+        return *this = *this - other;
+    }
+
+    template <class T>
+    interval<T>& interval<T>::operator*=(const interval& other)
+    {
+        return *this = *this * other;
+    }
+
+    template <class T>
+    interval<T> interval<T>::operator/(const interval& other) const
+    {
+        if (other.contains(0))
+            throw domain_error("Interval division by an interval containing zero");
+        const T a(lower_ / other.lower_), b(lower_ / other.upper_), c(upper_ / other.lower_), d(upper_ / other.upper_);
+        return widened(min(min(a, b), min(c, d)), max(max(a, b), max(c, d)));
+    }
+
+    template <class T>
+    int interval<T>::certain_sign() const
+    {
+        if (lower_ > 0)
+            return 1;
+        if (upper_ < 0)
+            return -1;
+        return 0;
+    }
+
+    template <class T>
+    bool interval<T>::contains(T value) const
+    {
+        return lower_ <= value && value <= upper_;
+    }
+
+    template <class T>
+    T interval<T>::lower() const
+    {
+        return lower_;
+    }
+
+    template <class T>
+    T interval<T>::upper() const
+    {
+        return upper_;
+    }
+
+    template <class T>
+    T interval<T>::width() const
+    {
+        return upper_ - lower_;
+    }
+} // engine_lib
+
+#endif //INTERVAL_INL
@@ -8,6 +8,9 @@
 #include "../point/point.hpp"
 #include "../direction/direction.hpp"
 
+#include <cmath>
+#include <stdexcept>
+
 namespace engine_lib
 {
     using namespace std;
@@ -32,28 +35,28 @@ namespace engine_lib
         /**
          * @brief Default constructor. Initializes the matrix with zeros.
          */
-        matrix<T, N, M>();
+        matrix();
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param data Array of arrays representing the matrix elements.
          */
-        explicit matrix<T, N, M>(const array<array<T, M>, N>& data);
+        explicit matrix(const array<array<T, M>, N>& data);
 
         /**
          * @brief Explicit constructor that initializes the matrix with the given array of points.
          *
          * @param data Array of points representing the matrix elements.
          */
-        explicit matrix<T, N, M>(const array<point<T, M>, N>& data);
+        explicit matrix(const array<point<T, M>, N>& data);
 
         /**
          * @brief Explicit constructor that initializes the matrix with the given array of directions.
          *
          * @param data Array of directions representing the matrix elements.
          */
-        explicit matrix<T, N, M>(const array<direction<T, M>, N>& data);
+        explicit matrix(const array<direction<T, M>, N>& data);
 
 
         /**
@@ -61,7 +64,15 @@ namespace engine_lib
          *
          * @param other Matrix to be copied.
          */
-        matrix<T, N, M>(const matrix<T, N, M>& other);
+        matrix(const matrix<T, N, M>& other);
+
+        /**
+         * @brief Copy assignment operator.
+         *
+         * @param other Matrix to be copied.
+         * @return Reference to this matrix.
+         */
+        matrix<T, N, M>& operator=(const matrix<T, N, M>& other) = default;
 
         /**
          * @brief Returns the number of rows in the matrix.
@@ -352,6 +363,14 @@ namespace engine_lib
          */
         [[nodiscard]] bool is_diagonal_matrix() const;
 
+        /**
+         * @brief Check if the matrix is a diagonal matrix up to a tolerance.
+         *
+         * @param epsilon Largest accepted magnitude of an off-diagonal element; diagonal elements must exceed it.
+         * @return True if the matrix is diagonal within the tolerance, false otherwise.
+         */
+        [[nodiscard]] bool is_diagonal_matrix(T epsilon) const;
+
         /**
          * @brief Check if the matrix is an identity matrix.
          *
@@ -359,6 +378,14 @@ namespace engine_lib
          */
         [[nodiscard]] bool is_identity_matrix() const;
 
+        /**
+         * @brief Check if the matrix is an identity matrix up to a tolerance.
+         *
+         * @param epsilon Largest accepted difference of an element from the identity.
+         * @return True if the matrix is an identity matrix within the tolerance, false otherwise.
+         */
+        [[nodiscard]] bool is_identity_matrix(T epsilon) const;
+
         /**
          * @brief Check if the matrix is an upper triangular matrix.
          *
@@ -405,28 +432,36 @@ namespace engine_lib
         /**
          * @brief Default constructor. Initializes the matrix with zeros.
          */
-        matrix1x1<T>();
+        matrix1x1();
 
         /**
          * @brief Copy constructor.
          *
          * @param other Matrix to be copied.
          */
-        matrix1x1<T>(const matrix1x1<T>& other);
+        matrix1x1(const matrix1x1<T>& other);
+
+        /**
+         * @brief Copy assignment operator.
+         *
+         * @param other Matrix to be copied.
+         * @return Reference to this matrix.
+         */
+        matrix1x1<T>& operator=(const matrix1x1<T>& other) = default;
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param data Array of arrays representing the matrix elements.
          */
-        explicit matrix1x1<T>(const array<array<T, 1>, 1>& data);
+        explicit matrix1x1(const array<array<T, 1>, 1>& data);
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param other Matrix to be copied.
          */
-        explicit matrix1x1<T>(const matrix<T, 1, 1>& other);
+        explicit matrix1x1(const matrix<T, 1, 1>& other);
 
         /**
          * @brief Calculate the determinant of the matrix.
@@ -448,28 +483,36 @@ namespace engine_lib
         /**
          * @brief Default constructor. Initializes the matrix with zeros.
          */
-        matrix2x2<T>();
+        matrix2x2();
 
         /**
          * @brief Copy constructor.
          *
          * @param other Matrix to be copied.
          */
-        matrix2x2<T>(const matrix2x2<T>& other);
+        matrix2x2(const matrix2x2<T>& other);
+
+        /**
+         * @brief Copy assignment operator.
+         *
+         * @param other Matrix to be copied.
+         * @return Reference to this matrix.
+         */
+        matrix2x2<T>& operator=(const matrix2x2<T>& other) = default;
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param data Array of arrays representing the matrix elements.
          */
-        explicit matrix2x2<T>(const array<array<T, 2>, 2>& data);
+        explicit matrix2x2(const array<array<T, 2>, 2>& data);
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param other Matrix to be copied.
          */
-        explicit matrix2x2<T>(const matrix<T, 2, 2>& other);
+        explicit matrix2x2(const matrix<T, 2, 2>& other);
 
         /**
          * @brief Calculate the determinant of the matrix.
@@ -491,28 +534,36 @@ namespace engine_lib
         /**
          * @brief Default constructor. Initializes the matrix with zeros.
          */
-        matrix3x3<T>();
+        matrix3x3();
 
         /**
          * @brief Copy constructor.
          *
          * @param other Matrix to be copied.
          */
-        matrix3x3<T>(const matrix3x3<T>& other);
+        matrix3x3(const matrix3x3<T>& other);
+
+        /**
+         * @brief Copy assignment operator.
+         *
+         * @param other Matrix to be copied.
+         * @return Reference to this matrix.
+         */
+        matrix3x3<T>& operator=(const matrix3x3<T>& other) = default;
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param data Array of arrays representing the matrix elements.
          */
-        explicit matrix3x3<T>(const array<array<T, 3>, 3>& data);
+        explicit matrix3x3(const array<array<T, 3>, 3>& data);
 
         /**
          * @brief Constructor that initializes the matrix with the given data.
          *
          * @param other Matrix to be copied.
          */
-        explicit matrix3x3<T>(const matrix<T, 3, 3>& other);
+        explicit matrix3x3(const matrix<T, 3, 3>& other);
 
         /**
          * @brief Calculate the determinant of the matrix.
@@ -24,23 +24,15 @@ namespace engine_lib
     template <class T, size_t N, size_t M>
     matrix<T, N, M>::matrix(const array<point<T, M>, N>& data)
     {
-        for (int i(0); i < N; ++i)
-            static_assert(data[i].size() == M, "All rows must have the same size");
-
-        for (int i(0); i < N; ++i)
-            for (int j(0); j < M; ++j)
-                this->table_[i] = data[i].get_coordinates();
+        for (size_t i(0); i < N; ++i)
+            this->table_[i] = data[i].get_coordinates();
     }
 
     template <class T, size_t N, size_t M>
     matrix<T, N, M>::matrix(const array<direction<T, M>, N>& data)
     {
-        for (int i(0); i < N; ++i)
-            static_assert(data[i].size() == M, "All rows must have the same size");
-
-        for (int i(0); i < N; ++i)
-            for (int j(0); j < M; ++j)
-                this->table_[i] = data[i].get_coordinates();
+        for (size_t i(0); i < N; ++i)
+            this->table_[i] = data[i].get_coordinates();
     }
 
 
@@ -128,7 +120,7 @@ namespace engine_lib
         matrix<T, N, M> result;
         for (size_t i(0); i < N; ++i)
             for (size_t j(0); j < M; ++j)
-                result[i][j] = table_[i][j] * value;
+                result.table_[i][j] = table_[i][j] * value;
         return result;
     }
 
@@ -149,7 +141,7 @@ namespace engine_lib
         matrix<T, N, M> result;
         for (size_t i(0); i < N; ++i)
             for (size_t j(0); j < M; ++j)
-                result[i][j] = table_[i][j] / value;
+                result.table_[i][j] = table_[i][j] / value;
         return result;
     }
 
@@ -172,12 +164,16 @@ namespace engine_lib
         if (M != G)
             throw invalid_argument("Matrices dimensions mismatch");
 
-        matrix<T, N, H> result({{}});
+        matrix<T, N, H> result;
 
-        for (int i(0); i < N; ++i)
-            for (int j(0); j < H; ++j)
-                for (int k(0); k < M; ++k)
-                    result[i][j] += table_[i][k] * other[k][j];
+        for (size_t i(0); i < N; ++i)
+            for (size_t j(0); j < H; ++j)
+            {
+                T sum(0);
+                for (size_t k(0); k < M; ++k)
+                    sum += table_[i][k] * other(k, j);
+                result(i, j) = sum;
+            }
         return result;
     }
 
@@ -187,7 +183,7 @@ namespace engine_lib
         matrix<T, N, M> result;
         for (size_t i(0); i < N; ++i)
             for (size_t j(0); j < M; ++j)
-                result[i][j] = table_[i][j] + other[i][j];
+                result.table_[i][j] = table_[i][j] + other.table_[i][j];
         return result;
     }
 
@@ -196,7 +192,7 @@ namespace engine_lib
     {
         for (size_t i(0); i < N; ++i)
             for (size_t j(0); j < M; ++j)
-                table_[i][j] += other[i][j];
+                table_[i][j] += other.table_[i][j];
         return *this;
     }
 
@@ -206,7 +202,7 @@ namespace engine_lib
         matrix<T, N, M> result;
         for (size_t i(0); i < N; ++i)
             for (size_t j(0); j < M; ++j)
-                result[i][j] = table_[i][j] - other[i][j];
+                result.table_[i][j] = table_[i][j] - other.table_[i][j];
         return result;
     }
 
@@ -215,7 +211,7 @@ namespace engine_lib
     {
         for (size_t i(0); i < N; ++i)
             for (size_t j(0); j < M; ++j)
-                table_[i][j] -= other[i][j];
+                table_[i][j] -= other.table_[i][j];
         return *this;
     }
 
@@ -225,7 +221,7 @@ namespace engine_lib
         matrix<T, M, N> result;
         for (size_t i(0); i < M; ++i)
             for (size_t j(0); j < N; ++j)
-                result[i][j] = table_[j][i];
+                result(i, j) = table_[j][i];
         return result;
     }
 
@@ -312,9 +308,9 @@ namespace engine_lib
             throw out_of_range("Column index out of range");
 
         T m(minor(row, column));
-        size_t p(row + 1 + column + 1);
 
-        return m * pow(T(-1), T(p));
+        // (-1)^(row + column) without pow, so integer and fixed-point T work too
+        return (row + column) % 2 == 0 ? m : -m;
     }
 
     template <class T, size_t N, size_t M>
@@ -347,12 +343,39 @@ namespace engine_lib
     template <class T, size_t N, size_t M>
     T matrix<T, N, M>::determinant() const
     {
-        static_assert(N == M, "Matrix must be square for determinant calculation");
-        auto U(U_decomposition());
-        T determinant(1);
-        for (int i(0); i < N; ++i)
-            determinant *= U(i, i);
-        return determinant;
+        // determinant is virtual and gets instantiated for every matrix,
+        // so non-square sizes are rejected at runtime instead of by static_assert
+        if constexpr (N != M)
+            throw invalid_argument("Matrix must be square for determinant calculation");
+        else
+        {
+            // elimination with partial pivoting, a zero leading element must not
+            // turn the product of the diagonal into 0 * inf
+            auto U(*this);
+            T determinant(1);
+            for (size_t i(0); i < N; ++i)
+            {
+                size_t pivot(i);
+                for (size_t j(i + 1); j < N; ++j)
+                    if (abs(U.table_[j][i]) > abs(U.table_[pivot][i]))
+                        pivot = j;
+                if (U.table_[pivot][i] == T(0))
+                    return T(0);
+                if (pivot != i)
+                {
+                    swap(U.table_[pivot], U.table_[i]);
+                    determinant = -determinant;
+                }
+                for (size_t j(i + 1); j < N; ++j)
+                {
+                    T factor(U.table_[j][i] / U.table_[i][i]);
+                    for (size_t k(i); k < N; ++k)
+                        U.table_[j][k] -= U.table_[i][k] * factor;
+                }
+                determinant *= U.table_[i][i];
+            }
+            return determinant;
+        }
     }
 
 
@@ -493,6 +516,37 @@ namespace engine_lib
         return true;
     }
 
+    template <class T, size_t N, size_t M>
+    bool matrix<T, N, M>::is_diagonal_matrix(T epsilon) const
+    {
+        if (!is_square_matrix())
+            return false;
+        for (size_t i(0); i < N; ++i)
+            for (size_t j(0); j < N; ++j)
+            {
+                const T value(table_[i][j]);
+                const bool negligible(-epsilon <= value && value <= epsilon);
+                if (negligible != (i != j))
+                    return false;
+            }
+        return true;
+    }
+
+    template <class T, size_t N, size_t M>
+    bool matrix<T, N, M>::is_identity_matrix(T epsilon) const
+    {
+        if (!is_square_matrix())
+            return false;
+        for (size_t i(0); i < N; ++i)
+            for (size_t j(0); j < N; ++j)
+            {
+                const T difference(table_[i][j] - T(i == j ? 1 : 0));
+                if (difference < -epsilon || difference > epsilon)
+                    return false;
+            }
+        return true;
+    }
+
     template <class T, size_t N, size_t M>
     bool matrix<T, N, M>::is_upper_triangular_matrix() const
     {
@@ -6,6 +6,7 @@
 #define POINT_HPP
 #include "../../includes.hpp"
 #include <array>
+#include <stdexcept>
 
 namespace engine_lib
 {
@@ -42,6 +43,7 @@ namespace engine_lib
     template <class T, size_t N>
     class point
     {
+    protected:
         /**
          * @param coordinates_ array of coordinates for the point.
          */
@@ -53,7 +55,7 @@ namespace engine_lib
          *
          * This constructor initializes a point with an empty array of coordinates.
          */
-        point<T, N>();
+        point();
 
 
         /**
@@ -64,7 +66,7 @@ namespace engine_lib
          * @param coordinates The array of coordinates to initialize the point with.
          */
 
-        explicit point<T, N>(const array<T, N>& coordinates);
+        explicit point(const array<T, N>& coordinates);
 
 
         /**
@@ -74,7 +76,7 @@ namespace engine_lib
          *
          * @param other The point whose coordinates will be copied.
          */
-        point<T, N>(const point<T, N>& other);
+        point(const point<T, N>& other) = default;
 
 
         /**
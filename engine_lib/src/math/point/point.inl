@@ -18,12 +18,6 @@ namespace engine_lib
     }
 
 
-    template <class T, size_t N>
-    point<T, N>::point(const point<T, N>& other)
-        : coordinates_(other.coordinates_)
-    {
-    }
-
     template <class T, size_t N>
     array<T, N> point<T, N>::get_coordinates() const
     {
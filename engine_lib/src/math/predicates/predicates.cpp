@@ -0,0 +1,323 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "predicates.hpp"
+#include "../interval/interval.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // a sum of doubles ordered by increasing magnitude whose nonzero components do not
+        // overlap; the largest component carries the sign of the exact value
+        using expansion = vector<double>;
+
+        // epsilon is half an ulp of one, the bound of one round-to-nearest operation
+        constexpr double epsilon(0x1p-53);
+        constexpr double splitter(0x1p27 + 1);
+        constexpr double orient2d_bound((3 + 16 * epsilon) * epsilon);
+        constexpr double orient3d_bound((7 + 56 * epsilon) * epsilon);
+        constexpr double incircle_bound((10 + 96 * epsilon) * epsilon);
+        constexpr double insphere_bound((16 + 224 * epsilon) * epsilon);
+
+        // x + y == a + b exactly, x being the rounded sum
+        void two_sum(double a, double b, double& x, double& y)
+        {
+            x = a + b;
+            const double b_virtual(x - a);
+            const double a_virtual(x - b_virtual);
+            y = (a - a_virtual) + (b - b_virtual);
+        }
+
+        // two_sum for |a| >= |b|
+        void fast_two_sum(double a, double b, double& x, double& y)
+        {
+            x = a + b;
+            y = b - (x - a);
+        }
+
+        // Dekker's split of a into two halves of 26 significant bits
+        void split(double a, double& high, double& low)
+        {
+            const double c(splitter * a);
+            high = c - (c - a);
+            low = a - high;
+        }
+
+        // x + y == a * b exactly, x being the rounded product
+        void two_product(double a, double b, double& x, double& y)
+        {
+            x = a * b;
+            double a_high, a_low, b_high, b_low;
+            split(a, a_high, a_low);
+            split(b, b_high, b_low);
+            const double error(((x - a_high * b_high) - a_low * b_high) - a_high * b_low);
+            y = a_low * b_low - error;
+        }
+
+        expansion product_of(double a, double b)
+        {
+            double x, y;
+            two_product(a, b, x, y);
+            expansion result;
+            if (y != 0)
+                result.push_back(y);
+            if (x != 0)
+                result.push_back(x);
+            return result;
+        }
+
+        // Shewchuk's grow-expansion applied to every component of f
+        expansion sum(const expansion& e, const expansion& f)
+        {
+            expansion result(e);
+            expansion grown;
+            for (const double component : f)
+            {
+                grown.clear();
+                double q(component);
+                for (const double term : result)
+                {
+                    double h;
+                    two_sum(q, term, q, h);
+                    if (h != 0)
+                        grown.push_back(h);
+                }
+                if (q != 0)
+                    grown.push_back(q);
+                result.swap(grown);
+            }
+            return result;
+        }
+
+        expansion scale(const expansion& e, double b)
+        {
+            expansion result;
+            if (e.empty() || b == 0)
+                return result;
+            double q, h;
+            two_product(e[0], b, q, h);
+            if (h != 0)
+                result.push_back(h);
+            for (size_t i(1); i < e.size(); ++i)
+            {
+                double high, low, partial;
+                two_product(e[i], b, high, low);
+                two_sum(q, low, partial, h);
+                if (h != 0)
+                    result.push_back(h);
+                fast_two_sum(high, partial, q, h);
+                if (h != 0)
+                    result.push_back(h);
+            }
+            if (q != 0)
+                result.push_back(q);
+            return result;
+        }
+
+        expansion product(const expansion& e, const expansion& f)
+        {
+            expansion result;
+            for (const double component : f)
+                result = sum(result, scale(e, component));
+            return result;
+        }
+
+        expansion negated(expansion e)
+        {
+            for (double& component : e)
+                component = -component;
+            return e;
+        }
+
+        double estimate(const expansion& e)
+        {
+            double value(0);
+            for (const double component : e)
+                value += component;
+            return value;
+        }
+
+        // cofactor expansion along the rows from row down, over the given columns
+        expansion determinant(const vector<vector<expansion>>& table, size_t row, const vector<size_t>& columns)
+        {
+            if (columns.size() == 1)
+                return table[row][columns[0]];
+            expansion result;
+            vector<size_t> minor_columns(columns.size() - 1);
+            for (size_t k(0); k < columns.size(); ++k)
+            {
+                for (size_t j(0), m(0); j < columns.size(); ++j)
+                    if (j != k)
+                        minor_columns[m++] = columns[j];
+                const expansion term(product(table[row][columns[k]], determinant(table, row + 1, minor_columns)));
+                result = sum(result, k % 2 == 0 ? term : negated(term));
+            }
+            return result;
+        }
+
+        double exact_determinant(const vector<vector<expansion>>& table)
+        {
+            vector<size_t> columns(table.size());
+            for (size_t j(0); j < columns.size(); ++j)
+                columns[j] = j;
+            return estimate(determinant(table, 0, columns));
+        }
+
+        // the determinants below are taken over the homogeneous rows (coordinates, 1), which
+        // equal the translated determinants of the filters without rounding the translation
+        expansion exact(double value)
+        {
+            return value == 0 ? expansion() : expansion{value};
+        }
+    }
+
+    double orient2d(const array<double, 2>& a, const array<double, 2>& b, const array<double, 2>& c)
+    {
+        const double left((a[0] - c[0]) * (b[1] - c[1]));
+        const double right((a[1] - c[1]) * (b[0] - c[0]));
+        const double det(left - right);
+        // the rounding cannot flip the sign when the two products differ in sign or one is zero
+        double det_sum;
+        if (left > 0)
+        {
+            if (right <= 0)
+                return det;
+            det_sum = left + right;
+        }
+        else if (left < 0)
+        {
+            if (right >= 0)
+                return det;
+            det_sum = -left - right;
+        }
+        else
+            return det;
+        const double bound(orient2d_bound * det_sum);
+        if (det >= bound || -det >= bound)
+            return det;
+
+        vector<vector<expansion>> table;
+        for (const auto& p : {a, b, c})
+            table.push_back({exact(p[0]), exact(p[1]), exact(1)});
+        return exact_determinant(table);
+    }
+
+    double orient3d(const array<double, 3>& a, const array<double, 3>& b, const array<double, 3>& c,
+                    const array<double, 3>& d)
+    {
+        const double adx(a[0] - d[0]), ady(a[1] - d[1]), adz(a[2] - d[2]);
+        const double bdx(b[0] - d[0]), bdy(b[1] - d[1]), bdz(b[2] - d[2]);
+        const double cdx(c[0] - d[0]), cdy(c[1] - d[1]), cdz(c[2] - d[2]);
+        const double bdxcdy(bdx * cdy), cdxbdy(cdx * bdy);
+        const double cdxady(cdx * ady), adxcdy(adx * cdy);
+        const double adxbdy(adx * bdy), bdxady(bdx * ady);
+        const double det(adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady));
+        const double permanent((fabs(bdxcdy) + fabs(cdxbdy)) * fabs(adz) + (fabs(cdxady) + fabs(adxcdy)) * fabs(bdz)
+                               + (fabs(adxbdy) + fabs(bdxady)) * fabs(cdz));
+        const double bound(orient3d_bound * permanent);
+        if (det > bound || -det > bound)
+            return det;
+
+        if (d == a || d == b || d == c)
+            return 0;
+        vector<vector<expansion>> table;
+        for (const auto& p : {a, b, c, d})
+            table.push_back({exact(p[0]), exact(p[1]), exact(p[2]), exact(1)});
+        return exact_determinant(table);
+    }
+
+    double incircle(const array<double, 2>& a, const array<double, 2>& b, const array<double, 2>& c,
+                    const array<double, 2>& d)
+    {
+        const double adx(a[0] - d[0]), ady(a[1] - d[1]);
+        const double bdx(b[0] - d[0]), bdy(b[1] - d[1]);
+        const double cdx(c[0] - d[0]), cdy(c[1] - d[1]);
+        const double bdxcdy(bdx * cdy), cdxbdy(cdx * bdy);
+        const double cdxady(cdx * ady), adxcdy(adx * cdy);
+        const double adxbdy(adx * bdy), bdxady(bdx * ady);
+        const double a_lift(adx * adx + ady * ady);
+        const double b_lift(bdx * bdx + bdy * bdy);
+        const double c_lift(cdx * cdx + cdy * cdy);
+        const double det(a_lift * (bdxcdy - cdxbdy) + b_lift * (cdxady - adxcdy) + c_lift * (adxbdy - bdxady));
+        const double permanent((fabs(bdxcdy) + fabs(cdxbdy)) * a_lift + (fabs(cdxady) + fabs(adxcdy)) * b_lift
+                               + (fabs(adxbdy) + fabs(bdxady)) * c_lift);
+        const double bound(incircle_bound * permanent);
+        if (det > bound || -det > bound)
+            return det;
+
+        // a repeated point lies on the circle, which the merges of a triangulation ask often
+        if (d == a || d == b || d == c)
+            return 0;
+        // lifting to x^2 + y^2 instead of the translated squares is a column operation away
+        vector<vector<expansion>> table;
+        for (const auto& p : {a, b, c, d})
+            table.push_back({exact(p[0]), exact(p[1]), sum(product_of(p[0], p[0]), product_of(p[1], p[1])), exact(1)});
+        return exact_determinant(table);
+    }
+
+    double insphere(const array<double, 3>& a, const array<double, 3>& b, const array<double, 3>& c,
+                    const array<double, 3>& d, const array<double, 3>& e)
+    {
+        const double aex(a[0] - e[0]), aey(a[1] - e[1]), aez(a[2] - e[2]);
+        const double bex(b[0] - e[0]), bey(b[1] - e[1]), bez(b[2] - e[2]);
+        const double cex(c[0] - e[0]), cey(c[1] - e[1]), cez(c[2] - e[2]);
+        const double dex(d[0] - e[0]), dey(d[1] - e[1]), dez(d[2] - e[2]);
+        const double aexbey(aex * bey), bexaey(bex * aey), bexcey(bex * cey), cexbey(cex * bey);
+        const double cexdey(cex * dey), dexcey(dex * cey), dexaey(dex * aey), aexdey(aex * dey);
+        const double aexcey(aex * cey), cexaey(cex * aey), bexdey(bex * dey), dexbey(dex * bey);
+        const double ab(aexbey - bexaey), bc(bexcey - cexbey), cd(cexdey - dexcey);
+        const double da(dexaey - aexdey), ac(aexcey - cexaey), bd(bexdey - dexbey);
+        const double abc(aez * bc - bez * ac + cez * ab), bcd(bez * cd - cez * bd + dez * bc);
+        const double cda(cez * da + dez * ac + aez * cd), dab(dez * ab + aez * bd + bez * da);
+        const double a_lift(aex * aex + aey * aey + aez * aez), b_lift(bex * bex + bey * bey + bez * bez);
+        const double c_lift(cex * cex + cey * cey + cez * cez), d_lift(dex * dex + dey * dey + dez * dez);
+        const double det((d_lift * abc - c_lift * dab) + (b_lift * cda - a_lift * bcd));
+
+        const double aez_plus(fabs(aez)), bez_plus(fabs(bez)), cez_plus(fabs(cez)), dez_plus(fabs(dez));
+        const double aexbey_plus(fabs(aexbey)), bexaey_plus(fabs(bexaey)), bexcey_plus(fabs(bexcey));
+        const double cexbey_plus(fabs(cexbey)), cexdey_plus(fabs(cexdey)), dexcey_plus(fabs(dexcey));
+        const double dexaey_plus(fabs(dexaey)), aexdey_plus(fabs(aexdey)), aexcey_plus(fabs(aexcey));
+        const double cexaey_plus(fabs(cexaey)), bexdey_plus(fabs(bexdey)), dexbey_plus(fabs(dexbey));
+        const double permanent(
+            ((cexdey_plus + dexcey_plus) * bez_plus + (dexbey_plus + bexdey_plus) * cez_plus
+             + (bexcey_plus + cexbey_plus) * dez_plus) * a_lift
+            + ((dexaey_plus + aexdey_plus) * cez_plus + (aexcey_plus + cexaey_plus) * dez_plus
+               + (cexdey_plus + dexcey_plus) * aez_plus) * b_lift
+            + ((aexbey_plus + bexaey_plus) * dez_plus + (bexdey_plus + dexbey_plus) * aez_plus
+               + (dexaey_plus + aexdey_plus) * bez_plus) * c_lift
+            + ((bexcey_plus + cexbey_plus) * aez_plus + (cexaey_plus + aexcey_plus) * bez_plus
+               + (aexbey_plus + bexaey_plus) * cez_plus) * d_lift);
+        const double bound(insphere_bound * permanent);
+        if (det > bound || -det > bound)
+            return det;
+
+        if (e == a || e == b || e == c || e == d)
+            return 0;
+        vector<vector<expansion>> table;
+        for (const auto& p : {a, b, c, d, e})
+            table.push_back({exact(p[0]), exact(p[1]), exact(p[2]),
+                             sum(sum(product_of(p[0], p[0]), product_of(p[1], p[1])), product_of(p[2], p[2])),
+                             exact(1)});
+        return exact_determinant(table);
+    }
+
+    int dot_product_sign(const double* a, const double* b, size_t count)
+    {
+        interval<double> filter;
+        for (size_t i(0); i < count; ++i)
+            filter += interval<double>(a[i]) * interval<double>(b[i]);
+        if (const int sign(filter.certain_sign()); sign != 0)
+            return sign;
+
+        expansion total;
+        for (size_t i(0); i < count; ++i)
+            total = sum(total, product_of(a[i], b[i]));
+        const double value(estimate(total));
+        return value > 0 ? 1 : value < 0 ? -1 : 0;
+    }
+} // engine_lib
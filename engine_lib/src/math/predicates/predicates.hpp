@@ -0,0 +1,82 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef PREDICATES_HPP
+#define PREDICATES_HPP
+#include "../../includes.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Returns the orientation of three points in the plane, with an exact sign.
+     *
+     * The determinant is evaluated in floating point first and returned when it is larger
+     * than its worst-case rounding error; only near-degenerate inputs fall through to exact
+     * expansion arithmetic, so the common case costs a few multiplications.
+     *
+     * @param a First point.
+     * @param b Second point.
+     * @param c Third point.
+     * @return A positive value if a, b, c are counterclockwise, a negative value if clockwise, zero if collinear.
+     */
+    double orient2d(const array<double, 2>& a, const array<double, 2>& b, const array<double, 2>& c);
+
+    /**
+     * @brief Returns the orientation of a point relative to a plane, with an exact sign.
+     *
+     * @param a First point of the plane.
+     * @param b Second point of the plane.
+     * @param c Third point of the plane.
+     * @param d The tested point.
+     * @return A positive value if d lies below the plane, where a, b, c appear counterclockwise
+     * from above, a negative value if above, zero if the four points are coplanar.
+     */
+    double orient3d(const array<double, 3>& a, const array<double, 3>& b, const array<double, 3>& c,
+                    const array<double, 3>& d);
+
+    /**
+     * @brief Tests a point against the circle through three points, with an exact sign.
+     *
+     * @param a First point of the circle.
+     * @param b Second point of the circle.
+     * @param c Third point of the circle; a, b, c must be counterclockwise.
+     * @param d The tested point.
+     * @return A positive value if d lies inside the circle, a negative value if outside, zero if on it.
+     */
+    double incircle(const array<double, 2>& a, const array<double, 2>& b, const array<double, 2>& c,
+                    const array<double, 2>& d);
+
+    /**
+     * @brief Tests a point against the sphere through four points, with an exact sign.
+     *
+     * @param a First point of the sphere.
+     * @param b Second point of the sphere.
+     * @param c Third point of the sphere.
+     * @param d Fourth point of the sphere; orient3d(a, b, c, d) must be positive.
+     * @param e The tested point.
+     * @return A positive value if e lies inside the sphere, a negative value if outside, zero if on it.
+     */
+    double insphere(const array<double, 3>& a, const array<double, 3>& b, const array<double, 3>& c,
+                    const array<double, 3>& d, const array<double, 3>& e);
+
+    /**
+     * @brief Returns the exact sign of a dot product.
+     *
+     * The product is bounded with interval arithmetic first and summed exactly only if the
+     * interval contains zero.
+     *
+     * @param a First vector.
+     * @param b Second vector.
+     * @param count Number of coordinates.
+     * @return 1, -1 or 0.
+     */
+    int dot_product_sign(const double* a, const double* b, size_t count);
+} // engine_lib
+
+#endif //PREDICATES_HPP
@@ -0,0 +1,74 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef QUADRIC_HPP
+#define QUADRIC_HPP
+#include "../../includes.hpp"
+#include "../matrix/matrix.hpp"
+#include "../point/point.hpp"
+
+#include <cmath>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class quadric
+     * @brief Error quadric of Garland and Heckbert: a symmetric 4x4 matrix measuring squared distances to planes.
+     *
+     * A plane (a, b, c, d) with unit normal contributes p p^T, so v^T Q v with v = (x, y, z, 1)
+     * is its squared distance to the point; quadrics of several planes add up to the sum of
+     * squared distances. Every operation keeps the matrix symmetric.
+     *
+     * @tparam T Floating point element type; double keeps large sums accurate.
+     */
+    template <class T>
+    class quadric
+    {
+        matrix<T, 4, 4> matrix_; /// The symmetric matrix.
+
+    public:
+        /**
+         * @brief Creates the zero quadric, measuring no error anywhere.
+         */
+        quadric();
+
+        /**
+         * @brief Creates the quadric of a plane a x + b y + c z + d = 0.
+         *
+         * @param a First component of the unit normal.
+         * @param b Second component of the unit normal.
+         * @param c Third component of the unit normal.
+         * @param d Offset of the plane.
+         * @param weight Scale of the error, for example the area of the face the plane comes from.
+         * @return The quadric.
+         */
+        static quadric<T> from_plane(T a, T b, T c, T d, T weight = 1);
+
+        quadric<T> operator+(const quadric<T>& other) const;
+        quadric<T>& operator+=(const quadric<T>& other);
+
+        /**
+         * @brief Evaluates v^T Q v.
+         *
+         * @param position The point.
+         * @return The weighted sum of squared distances to the planes.
+         */
+        T error(const point<T, 3>& position) const;
+
+        /**
+         * @brief Finds the point of least error by solving the upper 3x3 system.
+         *
+         * @param position Receives the point.
+         * @return False if the system is singular, as for planes that are all parallel or meet in a line.
+         */
+        bool minimum(point<T, 3>& position) const;
+
+        [[nodiscard]] const matrix<T, 4, 4>& get_matrix() const;
+    };
+} // engine_lib
+
+#endif //QUADRIC_HPP
+#include "quadric.inl"
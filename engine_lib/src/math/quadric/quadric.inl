@@ -0,0 +1,89 @@
+#ifndef QUADRIC_INL
+#define QUADRIC_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    quadric<T>::quadric() : matrix_()
+    {
+    }
+
+    template <class T>
+    quadric<T> quadric<T>::from_plane(T a, T b, T c, T d, T weight)
+    {
+        const T plane[4]{a, b, c, d};
+        quadric<T> result;
+        for (size_t row(0); row < 4; ++row)
+            for (size_t column(0); column < 4; ++column)
+                result.matrix_(row, column) = weight * plane[row] * plane[column];
+        return result;
+    }
+
+    template <class T>
+    quadric<T> quadric<T>::operator+(const quadric<T>& other) const
+    {
+        quadric<T> result(*this);
+        result += other;
+        return result;
+    }
+
+    template <class T>
+    quadric<T>& quadric<T>::operator+=(const quadric<T>& other)
+    {
+        matrix_ += other.matrix_;
+        return *this;
+    }
+
+    template <class T>
+    T quadric<T>::error(const point<T, 3>& position) const
+    {
+        const array<T, 3>& p(position.get_coordinates());
+        const T v[4]{p[0], p[1], p[2], 1};
+        T sum(0);
+        for (size_t r(0); r < 4; ++r)
+        {
+            T row(0);
+            for (size_t c(0); c < 4; ++c)
+                row += matrix_(r, c) * v[c];
+            sum += v[r] * row;
+        }
+        return sum;
+    }
+
+    template <class T>
+    bool quadric<T>::minimum(point<T, 3>& position) const
+    {
+        // A x = -b with A the upper 3x3 block and b the last column, by Cramer's rule
+        matrix3x3<T> system;
+        for (size_t r(0); r < 3; ++r)
+            for (size_t c(0); c < 3; ++c)
+                system(r, c) = matrix_(r, c);
+        const T determinant(system.determinant());
+        // relative to the scale of the block, so the test does not depend on units or weights
+        T scale(0);
+        for (size_t i(0); i < 3; ++i)
+            scale = max(scale, abs(matrix_(i, i)));
+        if (scale == 0 || abs(determinant) <= T(1e-10) * scale * scale * scale)
+            return false;
+        array<T, 3> solution{};
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            matrix3x3<T> replaced(system);
+            for (size_t r(0); r < 3; ++r)
+                replaced(r, axis) = -matrix_(r, 3);
+            solution[axis] = replaced.determinant() / determinant;
+        }
+        position = point<T, 3>(solution);
+        return true;
+    }
+
+    template <class T>
+    const matrix<T, 4, 4>& quadric<T>::get_matrix() const
+    {
+        return matrix_;
+    }
+} // engine_lib
+
+#endif //QUADRIC_INL
@@ -0,0 +1,143 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef RAY_HPP
+#define RAY_HPP
+#include "../../includes.hpp"
+#include "../direction/direction.hpp"
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class ray
+     * @brief A half-line: an origin and a direction, with the reciprocal direction cached for slab tests.
+     *
+     * The direction is not normalized, so the distances reported by the intersection routines
+     * are in units of its length.
+     *
+     * @tparam T Floating point type.
+     * @tparam N Number of dimensions.
+     */
+    template <class T, size_t N>
+    class ray
+    {
+        static_assert(is_floating_point_v<T>, "ray needs a floating point type");
+
+        point<T, N> origin_; /// Start of the ray.
+        array<T, N> direction_; /// Direction, not normalized.
+        array<T, N> inverse_direction_; /// 1 / direction_ per axis, infinite for zero components.
+
+    public:
+        /**
+         * @brief Default constructor. Creates a ray from the origin along the x axis.
+         */
+        ray();
+
+        /**
+         * @brief Creates a ray from an origin and a direction.
+         *
+         * @param origin Start of the ray.
+         * @param ray_direction Direction of the ray.
+         * @throws invalid_argument If the direction is zero.
+         */
+        ray(const point<T, N>& origin, const array<T, N>& ray_direction);
+
+        /**
+         * @brief Creates a ray starting at the beginning of a direction and passing through its end.
+         *
+         * @param segment Direction with a beginning and an end.
+         * @throws invalid_argument If the direction is zero.
+         */
+        explicit ray(const direction<T, N>& segment);
+
+        [[nodiscard]] const point<T, N>& get_origin() const;
+        [[nodiscard]] const array<T, N>& get_direction() const;
+        [[nodiscard]] const array<T, N>& get_inverse_direction() const;
+
+        /**
+         * @brief Returns the point at a distance along the ray.
+         *
+         * @param distance Distance in units of the direction length.
+         * @return origin + distance * direction.
+         */
+        point<T, N> at(T distance) const;
+    };
+
+    /**
+     * @brief Hit of a ray with a triangle.
+     */
+    template <class T>
+    struct triangle_hit
+    {
+        T distance; /// Distance along the ray.
+        T u; /// Barycentric weight of the second vertex.
+        T v; /// Barycentric weight of the third vertex.
+    };
+
+    /**
+     * @brief Intersects a ray with a triangle (Moller-Trumbore). Both sides are hit.
+     *
+     * @param r The ray.
+     * @param a First vertex.
+     * @param b Second vertex.
+     * @param c Third vertex.
+     * @param max_distance Hits farther than this are ignored.
+     * @return The hit, or nothing if the ray misses or the triangle is degenerate.
+     */
+    template <class T>
+    optional<triangle_hit<T>> intersect_triangle(const ray<T, 3>& r, const point<T, 3>& a, const point<T, 3>& b,
+                                                 const point<T, 3>& c,
+                                                 T max_distance = numeric_limits<T>::infinity());
+
+    /**
+     * @brief Intersects a ray with an axis aligned box (slab test).
+     *
+     * @param r The ray.
+     * @param lower Corner with the smallest coordinates.
+     * @param upper Corner with the largest coordinates.
+     * @param max_distance Boxes entered farther than this are ignored.
+     * @return Distance at which the ray enters the box, zero if it starts inside.
+     */
+    template <class T, size_t N>
+    optional<T> intersect_box(const ray<T, N>& r, const point<T, N>& lower, const point<T, N>& upper,
+                              T max_distance = numeric_limits<T>::infinity());
+
+    /**
+     * @brief Intersects a ray with a sphere.
+     *
+     * @param r The ray.
+     * @param center Center of the sphere.
+     * @param radius Radius of the sphere.
+     * @param max_distance Hits farther than this are ignored.
+     * @return Distance of the first surface point in front of the origin, the exit point if the
+     *         ray starts inside.
+     */
+    template <class T, size_t N>
+    optional<T> intersect_sphere(const ray<T, N>& r, const point<T, N>& center, T radius,
+                                 T max_distance = numeric_limits<T>::infinity());
+
+    /**
+     * @brief Intersects a ray with a plane. Both sides are hit.
+     *
+     * @param r The ray.
+     * @param on_plane Any point of the plane.
+     * @param normal Normal of the plane, not necessarily normalized.
+     * @param max_distance Hits farther than this are ignored.
+     * @return Distance of the hit, or nothing if the ray is parallel to or points away from the plane.
+     */
+    template <class T, size_t N>
+    optional<T> intersect_plane(const ray<T, N>& r, const point<T, N>& on_plane, const array<T, N>& normal,
+                                T max_distance = numeric_limits<T>::infinity());
+} // engine_lib
+
+#endif //RAY_HPP
+#include "ray.inl"
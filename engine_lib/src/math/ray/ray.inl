@@ -0,0 +1,163 @@
+#ifndef RAY_INL
+#define RAY_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T, size_t N>
+    ray<T, N>::ray()
+        : origin_(),
+          direction_(),
+          inverse_direction_()
+    {
+        direction_[0] = T(1);
+        for (size_t i(0); i < N; ++i)
+            inverse_direction_[i] = T(1) / direction_[i];
+    }
+
+    template <class T, size_t N>
+    ray<T, N>::ray(const point<T, N>& origin, const array<T, N>& ray_direction)
+        : origin_(origin),
+          direction_(ray_direction),
+          inverse_direction_()
+    {
+        bool zero(true);
+        for (size_t i(0); i < N; ++i)
+        {
+            zero = zero && direction_[i] == T(0);
+            inverse_direction_[i] = T(1) / direction_[i];
+        }
+        if (zero)
+            throw invalid_argument("A ray needs a non-zero direction");
+    }
+
+    template <class T, size_t N>
+    ray<T, N>::ray(const direction<T, N>& segment)
+        : ray(point<T, N>(segment.get_beginning()), segment.get_coordinates())
+    {
+    }
+
+    template <class T, size_t N>
+    const point<T, N>& ray<T, N>::get_origin() const
+    {
+        return origin_;
+    }
+
+    template <class T, size_t N>
+    const array<T, N>& ray<T, N>::get_direction() const
+    {
+        return direction_;
+    }
+
+    template <class T, size_t N>
+    const array<T, N>& ray<T, N>::get_inverse_direction() const
+    {
+        return inverse_direction_;
+    }
+
+    template <class T, size_t N>
+    point<T, N> ray<T, N>::at(T distance) const
+    {
+        point<T, N> result(origin_);
+        for (size_t i(0); i < N; ++i)
+            result[i] += distance * direction_[i];
+        return result;
+    }
+
+    template <class T>
+    optional<triangle_hit<T>> intersect_triangle(const ray<T, 3>& r, const point<T, 3>& a, const point<T, 3>& b,
+                                                 const point<T, 3>& c, T max_distance)
+    {
+        const array<T, 3>& d(r.get_direction());
+        const array<T, 3> e1{b.coordinate(0) - a.coordinate(0), b.coordinate(1) - a.coordinate(1),
+                             b.coordinate(2) - a.coordinate(2)};
+        const array<T, 3> e2{c.coordinate(0) - a.coordinate(0), c.coordinate(1) - a.coordinate(1),
+                             c.coordinate(2) - a.coordinate(2)};
+
+        const array<T, 3> p{d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0]};
+        const T determinant(e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2]);
+        if (determinant == T(0))
+            return nullopt;
+        const T inverse(T(1) / determinant);
+
+        const array<T, 3> s{r.get_origin().coordinate(0) - a.coordinate(0),
+                            r.get_origin().coordinate(1) - a.coordinate(1),
+                            r.get_origin().coordinate(2) - a.coordinate(2)};
+        const T u((s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse);
+        if (u < T(0) || u > T(1))
+            return nullopt;
+
+        const array<T, 3> q{s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+        const T v((d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inverse);
+        if (v < T(0) || u + v > T(1))
+            return nullopt;
+
+        const T distance((e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverse);
+        if (distance <= T(0) || distance > max_distance)
+            return nullopt;
+        return triangle_hit<T>{distance, u, v};
+    }
+
+    template <class T, size_t N>
+    optional<T> intersect_box(const ray<T, N>& r, const point<T, N>& lower, const point<T, N>& upper, T max_distance)
+    {
+        T enter(-numeric_limits<T>::infinity()), leave(numeric_limits<T>::infinity());
+        for (size_t i(0); i < N; ++i)
+        {
+            const T origin(r.get_origin().coordinate(i)), inverse(r.get_inverse_direction()[i]);
+            const T t1((lower.coordinate(i) - origin) * inverse);
+            const T t2((upper.coordinate(i) - origin) * inverse);
+            enter = max(enter, min(t1, t2));
+            leave = min(leave, max(t1, t2));
+        }
+        if (enter > leave || leave < T(0) || enter > max_distance)
+            return nullopt;
+        return max(enter, T(0));
+    }
+
+    template <class T, size_t N>
+    optional<T> intersect_sphere(const ray<T, N>& r, const point<T, N>& center, T radius, T max_distance)
+    {
+        const array<T, N>& d(r.get_direction());
+        T a(0), b(0), c(-radius * radius);
+        for (size_t i(0); i < N; ++i)
+        {
+            const T offset(r.get_origin().coordinate(i) - center.coordinate(i));
+            a += d[i] * d[i];
+            b += offset * d[i];
+            c += offset * offset;
+        }
+        // a t^2 + 2 b t + c = 0
+        const T discriminant(b * b - a * c);
+        if (discriminant < T(0))
+            return nullopt;
+        const T root(sqrt(discriminant));
+        T distance((-b - root) / a);
+        if (distance <= T(0))
+            distance = (-b + root) / a;
+        if (distance <= T(0) || distance > max_distance)
+            return nullopt;
+        return distance;
+    }
+
+    template <class T, size_t N>
+    optional<T> intersect_plane(const ray<T, N>& r, const point<T, N>& on_plane, const array<T, N>& normal,
+                                T max_distance)
+    {
+        T denominator(0), numerator(0);
+        for (size_t i(0); i < N; ++i)
+        {
+            denominator += normal[i] * r.get_direction()[i];
+            numerator += normal[i] * (on_plane.coordinate(i) - r.get_origin().coordinate(i));
+        }
+        if (denominator == T(0))
+            return nullopt;
+        const T distance(numerator / denominator);
+        if (distance <= T(0) || distance > max_distance)
+            return nullopt;
+        return distance;
+    }
+} // engine_lib
+
+#endif //RAY_INL
@@ -0,0 +1,120 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef RAY_PACKET_HPP
+#define RAY_PACKET_HPP
+#include "../../includes.hpp"
+#include "../simd/float_pack.hpp"
+#include "ray.hpp"
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class ray_packet
+     * @brief W rays stored as structure of arrays, one float_pack per coordinate.
+     *
+     * The packet intersection routines test all W rays against one primitive at once. They
+     * return the hit distances as a pack with infinity in the lanes that miss, so the closest
+     * hit over several primitives is a running min() and a lane hit anything where its
+     * distance is below infinity.
+     *
+     * @tparam W Number of rays, 4 (SSE) and 8 (AVX) map onto native registers.
+     */
+    template <size_t W>
+    class ray_packet
+    {
+        array<float_pack<W>, 3> origin_; /// Origin coordinates, lane i belongs to ray i.
+        array<float_pack<W>, 3> direction_; /// Direction coordinates.
+        array<float_pack<W>, 3> inverse_direction_; /// Reciprocal direction coordinates.
+
+    public:
+        static constexpr size_t width = W;
+
+        /**
+         * @brief Default constructor. Every ray starts at the origin and points along the x axis.
+         */
+        ray_packet();
+
+        /**
+         * @brief Transposes W rays into a packet.
+         *
+         * @param rays Pointer to W consecutive rays.
+         */
+        explicit ray_packet(const ray<float, 3>* rays);
+
+        /**
+         * @brief Loads W rays from structure of arrays storage.
+         *
+         * @param origin Pointers to the x, y and z origin coordinates of the first ray.
+         * @param ray_direction Pointers to the x, y and z direction coordinates of the first ray.
+         * @return The packet.
+         */
+        static ray_packet load(const array<const float*, 3>& origin, const array<const float*, 3>& ray_direction);
+
+        [[nodiscard]] const array<float_pack<W>, 3>& get_origin() const;
+        [[nodiscard]] const array<float_pack<W>, 3>& get_direction() const;
+        [[nodiscard]] const array<float_pack<W>, 3>& get_inverse_direction() const;
+    };
+
+    /**
+     * @brief Intersects W rays with one triangle (Moller-Trumbore). Both sides are hit.
+     *
+     * @param rays The packet.
+     * @param a First vertex.
+     * @param b Second vertex.
+     * @param c Third vertex.
+     * @param max_distance Per lane limit, hits farther away are ignored.
+     * @param u If given, receives the barycentric weight of b in the lanes that hit.
+     * @param v If given, receives the barycentric weight of c in the lanes that hit.
+     * @return Hit distances, infinity where a ray misses.
+     */
+    template <size_t W>
+    float_pack<W> intersect_triangle(const ray_packet<W>& rays, const point<float, 3>& a, const point<float, 3>& b,
+                                     const point<float, 3>& c, const float_pack<W>& max_distance,
+                                     float_pack<W>* u = nullptr, float_pack<W>* v = nullptr);
+
+    /**
+     * @brief Intersects W rays with one axis aligned box (slab test).
+     *
+     * @param rays The packet.
+     * @param lower Corner with the smallest coordinates.
+     * @param upper Corner with the largest coordinates.
+     * @param max_distance Per lane limit, boxes entered farther away are ignored.
+     * @return Entry distances, zero for rays starting inside, infinity where a ray misses.
+     */
+    template <size_t W>
+    float_pack<W> intersect_box(const ray_packet<W>& rays, const point<float, 3>& lower, const point<float, 3>& upper,
+                                const float_pack<W>& max_distance);
+
+    /**
+     * @brief Intersects W rays with one sphere.
+     *
+     * @param rays The packet.
+     * @param center Center of the sphere.
+     * @param radius Radius of the sphere.
+     * @param max_distance Per lane limit, hits farther away are ignored.
+     * @return Hit distances, infinity where a ray misses.
+     */
+    template <size_t W>
+    float_pack<W> intersect_sphere(const ray_packet<W>& rays, const point<float, 3>& center, float radius,
+                                   const float_pack<W>& max_distance);
+
+    /**
+     * @brief Intersects W rays with one plane. Both sides are hit.
+     *
+     * @param rays The packet.
+     * @param on_plane Any point of the plane.
+     * @param normal Normal of the plane, not necessarily normalized.
+     * @param max_distance Per lane limit, hits farther away are ignored.
+     * @return Hit distances, infinity where a ray misses.
+     */
+    template <size_t W>
+    float_pack<W> intersect_plane(const ray_packet<W>& rays, const point<float, 3>& on_plane,
+                                  const array<float, 3>& normal, const float_pack<W>& max_distance);
+} // engine_lib
+
+#endif //RAY_PACKET_HPP
+#include "ray_packet.inl"
@@ -0,0 +1,185 @@
+#ifndef RAY_PACKET_INL
+#define RAY_PACKET_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    namespace detail
+    {
+        template <size_t W>
+        float_pack<W> dot(const array<float_pack<W>, 3>& a, const array<float_pack<W>, 3>& b)
+        {
+            return mul_add(a[0], b[0], mul_add(a[1], b[1], a[2] * b[2]));
+        }
+
+        template <size_t W>
+        array<float_pack<W>, 3> cross(const array<float_pack<W>, 3>& a, const array<float_pack<W>, 3>& b)
+        {
+            return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+        }
+
+        template <size_t W>
+        array<float_pack<W>, 3> broadcast(const point<float, 3>& p)
+        {
+            return {float_pack<W>(p.coordinate(0)), float_pack<W>(p.coordinate(1)), float_pack<W>(p.coordinate(2))};
+        }
+
+        template <size_t W>
+        float_pack<W> infinite_pack()
+        {
+            return float_pack<W>(numeric_limits<float>::infinity());
+        }
+    }
+
+    template <size_t W>
+    ray_packet<W>::ray_packet()
+        : origin_(),
+          direction_{float_pack<W>(1.0f), float_pack<W>(), float_pack<W>()},
+          inverse_direction_{float_pack<W>(1.0f), detail::infinite_pack<W>(), detail::infinite_pack<W>()}
+    {
+    }
+
+    template <size_t W>
+    ray_packet<W>::ray_packet(const ray<float, 3>* rays)
+    {
+        alignas(W * sizeof(float)) float lanes[9][W];
+        for (size_t i(0); i < W; ++i)
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                lanes[axis][i] = rays[i].get_origin().coordinate(axis);
+                lanes[3 + axis][i] = rays[i].get_direction()[axis];
+                lanes[6 + axis][i] = rays[i].get_inverse_direction()[axis];
+            }
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            origin_[axis] = float_pack<W>::load(lanes[axis]);
+            direction_[axis] = float_pack<W>::load(lanes[3 + axis]);
+            inverse_direction_[axis] = float_pack<W>::load(lanes[6 + axis]);
+        }
+    }
+
+    template <size_t W>
+    ray_packet<W> ray_packet<W>::load(const array<const float*, 3>& origin, const array<const float*, 3>& ray_direction)
+    {
+        ray_packet packet;
+        const float_pack<W> one(1.0f);
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            packet.origin_[axis] = float_pack<W>::load_unaligned(origin[axis]);
+            packet.direction_[axis] = float_pack<W>::load_unaligned(ray_direction[axis]);
+            packet.inverse_direction_[axis] = one / packet.direction_[axis];
+        }
+        return packet;
+    }
+
+    template <size_t W>
+    const array<float_pack<W>, 3>& ray_packet<W>::get_origin() const
+    {
+        return origin_;
+    }
+
+    template <size_t W>
+    const array<float_pack<W>, 3>& ray_packet<W>::get_direction() const
+    {
+        return direction_;
+    }
+
+    template <size_t W>
+    const array<float_pack<W>, 3>& ray_packet<W>::get_inverse_direction() const
+    {
+        return inverse_direction_;
+    }
+
+    // lanes with NaNs (degenerate triangles, parallel rays) fail every comparison and count as misses
+
+    template <size_t W>
+    float_pack<W> intersect_triangle(const ray_packet<W>& rays, const point<float, 3>& a, const point<float, 3>& b,
+                                     const point<float, 3>& c, const float_pack<W>& max_distance,
+                                     float_pack<W>* u, float_pack<W>* v)
+    {
+        const float_pack<W> zero, one(1.0f);
+        const array<float_pack<W>, 3> vertex(detail::broadcast<W>(a));
+        const array<float_pack<W>, 3> e1{float_pack<W>(b.coordinate(0) - a.coordinate(0)),
+                                         float_pack<W>(b.coordinate(1) - a.coordinate(1)),
+                                         float_pack<W>(b.coordinate(2) - a.coordinate(2))};
+        const array<float_pack<W>, 3> e2{float_pack<W>(c.coordinate(0) - a.coordinate(0)),
+                                         float_pack<W>(c.coordinate(1) - a.coordinate(1)),
+                                         float_pack<W>(c.coordinate(2) - a.coordinate(2))};
+
+        const array<float_pack<W>, 3> p(detail::cross(rays.get_direction(), e2));
+        const float_pack<W> inverse(one / detail::dot(e1, p));
+        const array<float_pack<W>, 3> s{rays.get_origin()[0] - vertex[0], rays.get_origin()[1] - vertex[1],
+                                        rays.get_origin()[2] - vertex[2]};
+        const float_pack<W> hit_u(detail::dot(s, p) * inverse);
+        const array<float_pack<W>, 3> q(detail::cross(s, e1));
+        const float_pack<W> hit_v(detail::dot(rays.get_direction(), q) * inverse);
+        const float_pack<W> distance(detail::dot(e2, q) * inverse);
+
+        const float_pack<W> hit((hit_u >= zero) & (hit_v >= zero) & (hit_u + hit_v <= one) & (distance > zero) &
+                                (distance <= max_distance));
+        if (u != nullptr)
+            *u = hit_u;
+        if (v != nullptr)
+            *v = hit_v;
+        return select(hit, distance, detail::infinite_pack<W>());
+    }
+
+    template <size_t W>
+    float_pack<W> intersect_box(const ray_packet<W>& rays, const point<float, 3>& lower, const point<float, 3>& upper,
+                                const float_pack<W>& max_distance)
+    {
+        float_pack<W> enter(-detail::infinite_pack<W>()), leave(detail::infinite_pack<W>());
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            const float_pack<W> t1((float_pack<W>(lower.coordinate(axis)) - rays.get_origin()[axis]) *
+                                   rays.get_inverse_direction()[axis]);
+            const float_pack<W> t2((float_pack<W>(upper.coordinate(axis)) - rays.get_origin()[axis]) *
+                                   rays.get_inverse_direction()[axis]);
+            enter = max(enter, min(t1, t2));
+            leave = min(leave, max(t1, t2));
+        }
+        const float_pack<W> zero;
+        const float_pack<W> hit((enter <= leave) & (leave >= zero) & (enter <= max_distance));
+        return select(hit, max(enter, zero), detail::infinite_pack<W>());
+    }
+
+    template <size_t W>
+    float_pack<W> intersect_sphere(const ray_packet<W>& rays, const point<float, 3>& center, float radius,
+                                   const float_pack<W>& max_distance)
+    {
+        const array<float_pack<W>, 3> middle(detail::broadcast<W>(center));
+        const array<float_pack<W>, 3> offset{rays.get_origin()[0] - middle[0], rays.get_origin()[1] - middle[1],
+                                             rays.get_origin()[2] - middle[2]};
+        const float_pack<W> a(detail::dot(rays.get_direction(), rays.get_direction()));
+        const float_pack<W> b(detail::dot(offset, rays.get_direction()));
+        const float_pack<W> c(detail::dot(offset, offset) - float_pack<W>(radius * radius));
+
+        // a t^2 + 2 b t + c = 0, the far root where the near one lies behind the origin
+        const float_pack<W> zero;
+        const float_pack<W> discriminant(b * b - a * c);
+        const float_pack<W> root(sqrt(max(discriminant, zero)));
+        const float_pack<W> inverse(float_pack<W>(1.0f) / a);
+        const float_pack<W> near_root((-b - root) * inverse);
+        const float_pack<W> far_root((-b + root) * inverse);
+        const float_pack<W> distance(select(near_root > zero, near_root, far_root));
+
+        const float_pack<W> hit((discriminant >= zero) & (distance > zero) & (distance <= max_distance));
+        return select(hit, distance, detail::infinite_pack<W>());
+    }
+
+    template <size_t W>
+    float_pack<W> intersect_plane(const ray_packet<W>& rays, const point<float, 3>& on_plane,
+                                  const array<float, 3>& normal, const float_pack<W>& max_distance)
+    {
+        const array<float_pack<W>, 3> n{float_pack<W>(normal[0]), float_pack<W>(normal[1]), float_pack<W>(normal[2])};
+        const float_pack<W> offset(normal[0] * on_plane.coordinate(0) + normal[1] * on_plane.coordinate(1) +
+                                   normal[2] * on_plane.coordinate(2));
+        const float_pack<W> distance((offset - detail::dot(n, rays.get_origin())) / detail::dot(n, rays.get_direction()));
+
+        const float_pack<W> hit((distance > float_pack<W>()) & (distance <= max_distance));
+        return select(hit, distance, detail::infinite_pack<W>());
+    }
+} // engine_lib
+
+#endif //RAY_PACKET_INL
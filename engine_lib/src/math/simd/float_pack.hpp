@@ -0,0 +1,207 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef FLOAT_PACK_HPP
+#define FLOAT_PACK_HPP
+#include "../../includes.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EL_SIMD_SSE 1
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define EL_SIMD_AVX 1
+#endif
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class float_pack
+     * @brief A fixed number of floats processed with one instruction where the target allows it.
+     *
+     * The generic template stores the lanes in an array and relies on the compiler to
+     * vectorize the per-lane loops. float_pack<4> maps onto SSE and float_pack<8> onto AVX
+     * when the target supports them.
+     *
+     * Comparisons return masks: packs whose lanes have all bits set where the condition holds.
+     *
+     * @tparam W Number of lanes.
+     */
+    template <size_t W>
+    class float_pack
+    {
+        alignas(W * sizeof(float)) array<float, W> lanes_;
+
+    public:
+        static constexpr size_t width = W;
+
+        /**
+         * @brief Creates a pack with all lanes set to zero.
+         */
+        float_pack();
+
+        /**
+         * @brief Creates a pack with all lanes set to the given value.
+         *
+         * @param value The value to broadcast.
+         */
+        explicit float_pack(float value);
+
+        /**
+         * @brief Loads W floats from memory aligned to W * sizeof(float).
+         *
+         * @param source Pointer to the first float.
+         * @return The loaded pack.
+         */
+        static float_pack load(const float* source);
+
+        /**
+         * @brief Loads W floats from memory without alignment requirements.
+         *
+         * @param source Pointer to the first float.
+         * @return The loaded pack.
+         */
+        static float_pack load_unaligned(const float* source);
+
+        /**
+         * @brief Stores the lanes to memory aligned to W * sizeof(float).
+         *
+         * @param destination Pointer to the first float.
+         */
+        void store(float* destination) const;
+
+        /**
+         * @brief Stores the lanes to memory without alignment requirements.
+         *
+         * @param destination Pointer to the first float.
+         */
+        void store_unaligned(float* destination) const;
+
+        /**
+         * @brief Reads a single lane.
+         *
+         * @param lane Lane index, must be less than W.
+         * @return The lane value.
+         */
+        float operator[](size_t lane) const;
+
+        /**
+         * @brief Returns one bit per lane, set where the lane's sign bit is set.
+         *
+         * @return Bit mask with lane i in bit i.
+         */
+        [[nodiscard]] unsigned mask_bits() const;
+
+        /**
+         * @brief Adds all lanes together.
+         *
+         * @return Sum of the lanes.
+         */
+        float horizontal_sum() const;
+
+        float_pack operator+(const float_pack& other) const;
+        float_pack operator-(const float_pack& other) const;
+        float_pack operator*(const float_pack& other) const;
+        float_pack operator/(const float_pack& other) const;
+        float_pack operator-() const;
+        float_pack& operator+=(const float_pack& other);
+        float_pack& operator-=(const float_pack& other);
+        float_pack& operator*=(const float_pack& other);
+        float_pack& operator/=(const float_pack& other);
+
+        float_pack operator<(const float_pack& other) const;
+        float_pack operator<=(const float_pack& other) const;
+        float_pack operator>(const float_pack& other) const;
+        float_pack operator>=(const float_pack& other) const;
+        float_pack operator==(const float_pack& other) const;
+        float_pack operator&(const float_pack& other) const;
+        float_pack operator|(const float_pack& other) const;
+
+        /**
+         * @brief Computes a * b + c.
+         *
+         * The generic template rounds the product before the addition. The SSE and AVX packs
+         * use a fused multiply-add when the target has FMA.
+         */
+        friend float_pack mul_add(const float_pack& a, const float_pack& b, const float_pack& c)
+        {
+            float_pack result;
+            for (size_t i(0); i < W; ++i)
+                result.lanes_[i] = a.lanes_[i] * b.lanes_[i] + c.lanes_[i];
+            return result;
+        }
+
+        /**
+         * @brief Picks lanes of a where mask is set and lanes of b elsewhere.
+         */
+        friend float_pack select(const float_pack& mask, const float_pack& a, const float_pack& b)
+        {
+            float_pack result;
+            for (size_t i(0); i < W; ++i)
+            {
+                uint32_t bits;
+                memcpy(&bits, &mask.lanes_[i], sizeof(bits));
+                result.lanes_[i] = bits ? a.lanes_[i] : b.lanes_[i];
+            }
+            return result;
+        }
+
+        friend float_pack min(const float_pack& a, const float_pack& b)
+        {
+            float_pack result;
+            for (size_t i(0); i < W; ++i)
+                result.lanes_[i] = a.lanes_[i] < b.lanes_[i] ? a.lanes_[i] : b.lanes_[i];
+            return result;
+        }
+
+        friend float_pack max(const float_pack& a, const float_pack& b)
+        {
+            float_pack result;
+            for (size_t i(0); i < W; ++i)
+                result.lanes_[i] = a.lanes_[i] > b.lanes_[i] ? a.lanes_[i] : b.lanes_[i];
+            return result;
+        }
+
+        friend float_pack sqrt(const float_pack& a)
+        {
+            float_pack result;
+            for (size_t i(0); i < W; ++i)
+                result.lanes_[i] = std::sqrt(a.lanes_[i]);
+            return result;
+        }
+
+        friend float_pack abs(const float_pack& a)
+        {
+            float_pack result;
+            for (size_t i(0); i < W; ++i)
+                result.lanes_[i] = std::fabs(a.lanes_[i]);
+            return result;
+        }
+    };
+
+    /**
+     * @brief Widest float_pack the compilation target executes natively.
+     */
+#if defined(EL_SIMD_AVX)
+    constexpr size_t native_float_width = 8;
+#else
+    constexpr size_t native_float_width = 4;
+#endif
+
+    /**
+     * @brief Alias for the natively supported float_pack.
+     */
+    using native_float_pack = float_pack<native_float_width>;
+} // engine_lib
+
+#endif //FLOAT_PACK_HPP
+#include "float_pack.inl"
@@ -0,0 +1,333 @@
+#ifndef FLOAT_PACK_INL
+#define FLOAT_PACK_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    namespace detail
+    {
+        inline float lane_mask(bool condition)
+        {
+            const uint32_t bits(condition ? 0xFFFFFFFFu : 0u);
+            float result;
+            memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        inline uint32_t lane_bits(float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    } // detail
+
+    template <size_t W>
+    float_pack<W>::float_pack()
+        : lanes_()
+    {
+    }
+
+    template <size_t W>
+    float_pack<W>::float_pack(float value)
+    {
+        lanes_.fill(value);
+    }
+
+    template <size_t W>
+    float_pack<W> float_pack<W>::load(const float* source)
+    {
+        return load_unaligned(source);
+    }
+
+    template <size_t W>
+    float_pack<W> float_pack<W>::load_unaligned(const float* source)
+    {
+        float_pack result;
+        memcpy(result.lanes_.data(), source, W * sizeof(float));
+        return result;
+    }
+
+    template <size_t W>
+    void float_pack<W>::store(float* destination) const
+    {
+        store_unaligned(destination);
+    }
+
+    template <size_t W>
+    void float_pack<W>::store_unaligned(float* destination) const
+    {
+        memcpy(destination, lanes_.data(), W * sizeof(float));
+    }
+
+    template <size_t W>
+    float float_pack<W>::operator[](size_t lane) const
+    {
+        return lanes_[lane];
+    }
+
+    template <size_t W>
+    unsigned float_pack<W>::mask_bits() const
+    {
+        unsigned result(0);
+        for (size_t i(0); i < W; ++i)
+            result |= (detail::lane_bits(lanes_[i]) >> 31) << i;
+        return result;
+    }
+
+    template <size_t W>
+    float float_pack<W>::horizontal_sum() const
+    {
+        float sum(0);
+        for (float value : lanes_)
+            sum += value;
+        return sum;
+    }
+
+#define EL_FLOAT_PACK_LANEWISE(op)                                                  \
+    template <size_t W>                                                             \
+    float_pack<W> float_pack<W>::operator op(const float_pack<W>& other) const      \
+    {                                                                               \
+        float_pack<W> result;                                                       \
+        for (size_t i(0); i < W; ++i)                                               \
+            result.lanes_[i] = lanes_[i] op other.lanes_[i];                        \
+        return result;                                                              \
+    }                                                                               \
+    template <size_t W>                                                             \
+    float_pack<W>& float_pack<W>::operator op##=(const float_pack<W>& other)        \
+    {                                                                               \
+        for (size_t i(0); i < W; ++i)                                               \
+            lanes_[i] op##= other.lanes_[i];                                        \
+        return *this;                                                               \
+    }
+
+    EL_FLOAT_PACK_LANEWISE(+)
+    EL_FLOAT_PACK_LANEWISE(-)
+    EL_FLOAT_PACK_LANEWISE(*)
+    EL_FLOAT_PACK_LANEWISE(/)
+#undef EL_FLOAT_PACK_LANEWISE
+
+#define EL_FLOAT_PACK_COMPARE(op)                                                   \
+    template <size_t W>                                                             \
+    float_pack<W> float_pack<W>::operator op(const float_pack<W>& other) const      \
+    {                                                                               \
+        float_pack<W> result;                                                       \
+        for (size_t i(0); i < W; ++i)                                               \
+            result.lanes_[i] = detail::lane_mask(lanes_[i] op other.lanes_[i]);     \
+        return result;                                                              \
+    }
+
+    EL_FLOAT_PACK_COMPARE(<)
+    EL_FLOAT_PACK_COMPARE(<=)
+    EL_FLOAT_PACK_COMPARE(>)
+    EL_FLOAT_PACK_COMPARE(>=)
+    EL_FLOAT_PACK_COMPARE(==)
+#undef EL_FLOAT_PACK_COMPARE
+
+    template <size_t W>
+    float_pack<W> float_pack<W>::operator-() const
+    {
+        float_pack<W> result;
+        for (size_t i(0); i < W; ++i)
+            result.lanes_[i] = -lanes_[i];
+        return result;
+    }
+
+    template <size_t W>
+    float_pack<W> float_pack<W>::operator&(const float_pack<W>& other) const
+    {
+        float_pack<W> result;
+        for (size_t i(0); i < W; ++i)
+        {
+            const uint32_t bits(detail::lane_bits(lanes_[i]) & detail::lane_bits(other.lanes_[i]));
+            memcpy(&result.lanes_[i], &bits, sizeof(bits));
+        }
+        return result;
+    }
+
+    template <size_t W>
+    float_pack<W> float_pack<W>::operator|(const float_pack<W>& other) const
+    {
+        float_pack<W> result;
+        for (size_t i(0); i < W; ++i)
+        {
+            const uint32_t bits(detail::lane_bits(lanes_[i]) | detail::lane_bits(other.lanes_[i]));
+            memcpy(&result.lanes_[i], &bits, sizeof(bits));
+        }
+        return result;
+    }
+
+#if defined(EL_SIMD_SSE)
+    /**
+     * @brief SSE implementation of a four lane pack.
+     */
+    template <>
+    class float_pack<4>
+    {
+        __m128 lanes_;
+
+        explicit float_pack(__m128 lanes) : lanes_(lanes)
+        {
+        }
+
+    public:
+        static constexpr size_t width = 4;
+
+        float_pack() : lanes_(_mm_setzero_ps())
+        {
+        }
+
+        explicit float_pack(float value) : lanes_(_mm_set1_ps(value))
+        {
+        }
+
+        static float_pack load(const float* source) { return float_pack(_mm_load_ps(source)); }
+        static float_pack load_unaligned(const float* source) { return float_pack(_mm_loadu_ps(source)); }
+        void store(float* destination) const { _mm_store_ps(destination, lanes_); }
+        void store_unaligned(float* destination) const { _mm_storeu_ps(destination, lanes_); }
+
+        float operator[](size_t lane) const
+        {
+            alignas(16) float values[4];
+            _mm_store_ps(values, lanes_);
+            return values[lane];
+        }
+
+        [[nodiscard]] unsigned mask_bits() const { return unsigned(_mm_movemask_ps(lanes_)); }
+
+        float horizontal_sum() const
+        {
+            __m128 shuffled(_mm_shuffle_ps(lanes_, lanes_, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m128 sums(_mm_add_ps(lanes_, shuffled));
+            shuffled = _mm_movehl_ps(shuffled, sums);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+        }
+
+        float_pack operator+(const float_pack& other) const { return float_pack(_mm_add_ps(lanes_, other.lanes_)); }
+        float_pack operator-(const float_pack& other) const { return float_pack(_mm_sub_ps(lanes_, other.lanes_)); }
+        float_pack operator*(const float_pack& other) const { return float_pack(_mm_mul_ps(lanes_, other.lanes_)); }
+        float_pack operator/(const float_pack& other) const { return float_pack(_mm_div_ps(lanes_, other.lanes_)); }
+        float_pack operator-() const { return float_pack(_mm_xor_ps(lanes_, _mm_set1_ps(-0.0f))); }
+        float_pack& operator+=(const float_pack& other) { return *this = *this + other; }
+        float_pack& operator-=(const float_pack& other) { return *this = *this - other; }
+        float_pack& operator*=(const float_pack& other) { return *this = *this * other; }
+        float_pack& operator/=(const float_pack& other) { return *this = *this / other; }
+
+        float_pack operator<(const float_pack& other) const { return float_pack(_mm_cmplt_ps(lanes_, other.lanes_)); }
+        float_pack operator<=(const float_pack& other) const { return float_pack(_mm_cmple_ps(lanes_, other.lanes_)); }
+        float_pack operator>(const float_pack& other) const { return float_pack(_mm_cmpgt_ps(lanes_, other.lanes_)); }
+        float_pack operator>=(const float_pack& other) const { return float_pack(_mm_cmpge_ps(lanes_, other.lanes_)); }
+        float_pack operator==(const float_pack& other) const { return float_pack(_mm_cmpeq_ps(lanes_, other.lanes_)); }
+        float_pack operator&(const float_pack& other) const { return float_pack(_mm_and_ps(lanes_, other.lanes_)); }
+        float_pack operator|(const float_pack& other) const { return float_pack(_mm_or_ps(lanes_, other.lanes_)); }
+
+        friend float_pack mul_add(const float_pack& a, const float_pack& b, const float_pack& c)
+        {
+#if defined(__FMA__)
+            return float_pack(_mm_fmadd_ps(a.lanes_, b.lanes_, c.lanes_));
+#else
+            return float_pack(_mm_add_ps(_mm_mul_ps(a.lanes_, b.lanes_), c.lanes_));
+#endif
+        }
+
+        friend float_pack select(const float_pack& mask, const float_pack& a, const float_pack& b)
+        {
+            return float_pack(_mm_or_ps(_mm_and_ps(mask.lanes_, a.lanes_), _mm_andnot_ps(mask.lanes_, b.lanes_)));
+        }
+
+        friend float_pack min(const float_pack& a, const float_pack& b) { return float_pack(_mm_min_ps(a.lanes_, b.lanes_)); }
+        friend float_pack max(const float_pack& a, const float_pack& b) { return float_pack(_mm_max_ps(a.lanes_, b.lanes_)); }
+        friend float_pack sqrt(const float_pack& a) { return float_pack(_mm_sqrt_ps(a.lanes_)); }
+        friend float_pack abs(const float_pack& a) { return float_pack(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.lanes_)); }
+    };
+#endif
+
+#if defined(EL_SIMD_AVX)
+    /**
+     * @brief AVX implementation of an eight lane pack.
+     */
+    template <>
+    class float_pack<8>
+    {
+        __m256 lanes_;
+
+        explicit float_pack(__m256 lanes) : lanes_(lanes)
+        {
+        }
+
+    public:
+        static constexpr size_t width = 8;
+
+        float_pack() : lanes_(_mm256_setzero_ps())
+        {
+        }
+
+        explicit float_pack(float value) : lanes_(_mm256_set1_ps(value))
+        {
+        }
+
+        static float_pack load(const float* source) { return float_pack(_mm256_load_ps(source)); }
+        static float_pack load_unaligned(const float* source) { return float_pack(_mm256_loadu_ps(source)); }
+        void store(float* destination) const { _mm256_store_ps(destination, lanes_); }
+        void store_unaligned(float* destination) const { _mm256_storeu_ps(destination, lanes_); }
+
+        float operator[](size_t lane) const
+        {
+            alignas(32) float values[8];
+            _mm256_store_ps(values, lanes_);
+            return values[lane];
+        }
+
+        [[nodiscard]] unsigned mask_bits() const { return unsigned(_mm256_movemask_ps(lanes_)); }
+
+        float horizontal_sum() const
+        {
+            __m128 sums(_mm_add_ps(_mm256_castps256_ps128(lanes_), _mm256_extractf128_ps(lanes_, 1)));
+            __m128 shuffled(_mm_shuffle_ps(sums, sums, _MM_SHUFFLE(2, 3, 0, 1)));
+            sums = _mm_add_ps(sums, shuffled);
+            shuffled = _mm_movehl_ps(shuffled, sums);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+        }
+
+        float_pack operator+(const float_pack& other) const { return float_pack(_mm256_add_ps(lanes_, other.lanes_)); }
+        float_pack operator-(const float_pack& other) const { return float_pack(_mm256_sub_ps(lanes_, other.lanes_)); }
+        float_pack operator*(const float_pack& other) const { return float_pack(_mm256_mul_ps(lanes_, other.lanes_)); }
+        float_pack operator/(const float_pack& other) const { return float_pack(_mm256_div_ps(lanes_, other.lanes_)); }
+        float_pack operator-() const { return float_pack(_mm256_xor_ps(lanes_, _mm256_set1_ps(-0.0f))); }
+        float_pack& operator+=(const float_pack& other) { return *this = *this + other; }
+        float_pack& operator-=(const float_pack& other) { return *this = *this - other; }
+        float_pack& operator*=(const float_pack& other) { return *this = *this * other; }
+        float_pack& operator/=(const float_pack& other) { return *this = *this / other; }
+
+        float_pack operator<(const float_pack& other) const { return float_pack(_mm256_cmp_ps(lanes_, other.lanes_, _CMP_LT_OQ)); }
+        float_pack operator<=(const float_pack& other) const { return float_pack(_mm256_cmp_ps(lanes_, other.lanes_, _CMP_LE_OQ)); }
+        float_pack operator>(const float_pack& other) const { return float_pack(_mm256_cmp_ps(lanes_, other.lanes_, _CMP_GT_OQ)); }
+        float_pack operator>=(const float_pack& other) const { return float_pack(_mm256_cmp_ps(lanes_, other.lanes_, _CMP_GE_OQ)); }
+        float_pack operator==(const float_pack& other) const { return float_pack(_mm256_cmp_ps(lanes_, other.lanes_, _CMP_EQ_OQ)); }
+        float_pack operator&(const float_pack& other) const { return float_pack(_mm256_and_ps(lanes_, other.lanes_)); }
+        float_pack operator|(const float_pack& other) const { return float_pack(_mm256_or_ps(lanes_, other.lanes_)); }
+
+        friend float_pack mul_add(const float_pack& a, const float_pack& b, const float_pack& c)
+        {
+#if defined(__FMA__)
+            return float_pack(_mm256_fmadd_ps(a.lanes_, b.lanes_, c.lanes_));
+#else
+            return float_pack(_mm256_add_ps(_mm256_mul_ps(a.lanes_, b.lanes_), c.lanes_));
+#endif
+        }
+
+        friend float_pack select(const float_pack& mask, const float_pack& a, const float_pack& b)
+        {
+            return float_pack(_mm256_blendv_ps(b.lanes_, a.lanes_, mask.lanes_));
+        }
+
+        friend float_pack min(const float_pack& a, const float_pack& b) { return float_pack(_mm256_min_ps(a.lanes_, b.lanes_)); }
+        friend float_pack max(const float_pack& a, const float_pack& b) { return float_pack(_mm256_max_ps(a.lanes_, b.lanes_)); }
+        friend float_pack sqrt(const float_pack& a) { return float_pack(_mm256_sqrt_ps(a.lanes_)); }
+        friend float_pack abs(const float_pack& a) { return float_pack(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.lanes_)); }
+    };
+#endif
+} // engine_lib
+
+#endif
@@ -0,0 +1,91 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef SOLVERS_HPP
+#define SOLVERS_HPP
+#include "../../includes.hpp"
+#include "../sparse_matrix/sparse_matrix.hpp"
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Outcome of an iterative solve.
+     */
+    struct solver_result
+    {
+        size_t iterations; //!< Number of iterations performed.
+        double residual; //!< Final relative residual |b - Ax| / |b|.
+        bool converged; //!< True if the residual dropped below the tolerance.
+    };
+
+    /**
+     * @brief Solves A x = b with the conjugate gradient method.
+     *
+     * A must be symmetric positive definite. x holds the initial guess and receives the
+     * solution. Matrix-vector products and reductions run on the pool; reductions are
+     * summed in a fixed order, so the result does not depend on the number of threads.
+     *
+     * @param a System matrix.
+     * @param b Right-hand side.
+     * @param x Initial guess, resized to a.rows() if its size differs, and the solution.
+     * @param max_iterations Iteration limit.
+     * @param tolerance Relative residual at which the solve stops.
+     * @param pool Pool executing the kernels.
+     * @return Iteration count and final residual.
+     * @throws invalid_argument If the matrix is not square or b has the wrong size.
+     */
+    template <class T>
+    solver_result conjugate_gradient(const csr_matrix<T>& a, const vector<T>& b, vector<T>& x,
+                                     size_t max_iterations, T tolerance,
+                                     thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Solves A x = b with the conjugate gradient method for point-valued unknowns.
+     *
+     * @see conjugate_gradient(const csr_matrix<T>&, const vector<T>&, vector<T>&, size_t, T, thread_pool&)
+     */
+    template <class T, size_t B>
+    solver_result conjugate_gradient(const bsr_matrix<T, B>& a, const vector<point<T, B>>& b,
+                                     vector<point<T, B>>& x, size_t max_iterations, T tolerance,
+                                     thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Solves A x = b with multicolor Gauss-Seidel sweeps.
+     *
+     * Rows are greedily colored so that no two rows of one color reference each other;
+     * the rows of a color are then relaxed in parallel. This requires a structurally
+     * symmetric matrix with a non-zero diagonal and converges for diagonally dominant or
+     * symmetric positive definite systems.
+     *
+     * @param a System matrix.
+     * @param b Right-hand side.
+     * @param x Initial guess, resized to a.rows() if its size differs, and the solution.
+     * @param max_iterations Sweep limit.
+     * @param tolerance Relative residual at which the solve stops.
+     * @param pool Pool executing the sweeps.
+     * @return Sweep count and final residual.
+     * @throws invalid_argument If the matrix is not square, b has the wrong size or a diagonal entry is zero.
+     */
+    template <class T>
+    solver_result gauss_seidel(const csr_matrix<T>& a, const vector<T>& b, vector<T>& x,
+                               size_t max_iterations, T tolerance,
+                               thread_pool& pool = thread_pool::global());
+
+    /**
+     * @brief Solves A x = b with multicolor block Gauss-Seidel sweeps for point-valued unknowns.
+     *
+     * Every sweep solves the B x B diagonal block of a row directly.
+     *
+     * @see gauss_seidel(const csr_matrix<T>&, const vector<T>&, vector<T>&, size_t, T, thread_pool&)
+     */
+    template <class T, size_t B>
+    solver_result gauss_seidel(const bsr_matrix<T, B>& a, const vector<point<T, B>>& b,
+                               vector<point<T, B>>& x, size_t max_iterations, T tolerance,
+                               thread_pool& pool = thread_pool::global());
+} // engine_lib
+
+#endif //SOLVERS_HPP
+#include "solvers.inl"
@@ -0,0 +1,364 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+#ifndef SOLVERS_INL
+#define SOLVERS_INL
+
+#include <cmath>
+
+
+namespace engine_lib
+{
+    using namespace std;
+
+    namespace detail
+    {
+        // vector entries handed to one task by the reductions, fixed so sums are reproducible
+        constexpr size_t solver_grain = 4096;
+
+        template <class V>
+        struct scalar_of
+        {
+            using type = V;
+        };
+
+        template <class T, size_t B>
+        struct scalar_of<point<T, B>>
+        {
+            using type = T;
+        };
+
+        template <class T>
+        T element_dot(T a, T b)
+        {
+            return a * b;
+        }
+
+        template <class T, size_t B>
+        T element_dot(const point<T, B>& a, const point<T, B>& b)
+        {
+            T sum(0);
+            for (size_t i(0); i < B; ++i)
+                sum += a.coordinate(i) * b.coordinate(i);
+            return sum;
+        }
+
+        // sums the per-chunk partials in chunk order
+        template <class S, class F>
+        S parallel_sum(size_t count, thread_pool& pool, F&& partial)
+        {
+            vector<S> partials((count + solver_grain - 1) / solver_grain, S(0));
+            pool.parallel_for(0, count, solver_grain, [&](size_t first, size_t last)
+            {
+                partials[first / solver_grain] = partial(first, last);
+            });
+            S sum(0);
+            for (S value : partials)
+                sum += value;
+            return sum;
+        }
+
+        template <class V>
+        typename scalar_of<V>::type parallel_dot(const vector<V>& a, const vector<V>& b, thread_pool& pool)
+        {
+            using S = typename scalar_of<V>::type;
+            return parallel_sum<S>(a.size(), pool, [&](size_t first, size_t last)
+            {
+                S sum(0);
+                for (size_t i(first); i < last; ++i)
+                    sum += element_dot(a[i], b[i]);
+                return sum;
+            });
+        }
+
+        template <class V, class Matrix>
+        typename scalar_of<V>::type relative_residual(const Matrix& a, const vector<V>& b, const vector<V>& x,
+                                                      vector<V>& scratch, typename scalar_of<V>::type b_norm,
+                                                      thread_pool& pool)
+        {
+            using S = typename scalar_of<V>::type;
+            a.multiply(x, scratch, pool);
+            S r_norm(sqrt(parallel_sum<S>(b.size(), pool, [&](size_t first, size_t last)
+            {
+                S sum(0);
+                for (size_t i(first); i < last; ++i)
+                {
+                    V r(b[i] - scratch[i]);
+                    sum += element_dot(r, r);
+                }
+                return sum;
+            })));
+            return r_norm / b_norm;
+        }
+
+        template <class Matrix, class V>
+        solver_result conjugate_gradient(const Matrix& a, const vector<V>& b, vector<V>& x,
+                                         size_t max_iterations, typename scalar_of<V>::type tolerance,
+                                         thread_pool& pool)
+        {
+            using S = typename scalar_of<V>::type;
+            const size_t n(b.size());
+            x.resize(n);
+
+            const S b_norm(sqrt(parallel_dot(b, b, pool)));
+            if (b_norm == S(0))
+            {
+                fill(x.begin(), x.end(), V());
+                return {0, 0.0, true};
+            }
+
+            vector<V> r(n), p(n), q(n);
+            a.multiply(x, q, pool);
+            for (size_t i(0); i < n; ++i)
+                r[i] = b[i] - q[i];
+            p = r;
+            S rr(parallel_dot(r, r, pool));
+
+            size_t iteration(0);
+            S residual(sqrt(rr) / b_norm);
+            while (iteration < max_iterations && !(residual <= tolerance))
+            {
+                a.multiply(p, q, pool);
+                const S pq(parallel_dot(p, q, pool));
+                if (pq == S(0))
+                    break;
+                const S alpha(rr / pq);
+
+                // x and r are updated in the same pass that measures the new residual
+                const S rr_next(parallel_sum<S>(n, pool, [&](size_t first, size_t last)
+                {
+                    S sum(0);
+                    for (size_t i(first); i < last; ++i)
+                    {
+                        x[i] += p[i] * alpha;
+                        r[i] -= q[i] * alpha;
+                        sum += element_dot(r[i], r[i]);
+                    }
+                    return sum;
+                }));
+
+                const S beta(rr_next / rr);
+                rr = rr_next;
+                pool.parallel_for(0, n, solver_grain, [&](size_t first, size_t last)
+                {
+                    for (size_t i(first); i < last; ++i)
+                        p[i] = r[i] + p[i] * beta;
+                });
+                ++iteration;
+                residual = sqrt(rr) / b_norm;
+            }
+            return {iteration, double(residual), residual <= tolerance};
+        }
+
+        /*
+         * Greedy coloring of a structurally symmetric pattern: a row gets the smallest
+         * color not used by any of its off-diagonal columns. Returns the rows per color.
+         */
+        inline vector<vector<uint32_t>> color_rows(const vector<size_t>& offsets, const vector<uint32_t>& indices)
+        {
+            const size_t rows(offsets.size() - 1);
+            vector<uint32_t> colors(rows, numeric_limits<uint32_t>::max());
+            vector<size_t> used_by;
+            vector<vector<uint32_t>> groups;
+            for (size_t i(0); i < rows; ++i)
+            {
+                for (size_t k(offsets[i]); k < offsets[i + 1]; ++k)
+                {
+                    const uint32_t color(colors[indices[k]]);
+                    if (color != numeric_limits<uint32_t>::max())
+                        used_by[color] = i;
+                }
+                uint32_t color(0);
+                while (color < used_by.size() && used_by[color] == i)
+                    ++color;
+                if (color == used_by.size())
+                {
+                    used_by.push_back(rows);
+                    groups.emplace_back();
+                }
+                colors[i] = color;
+                groups[color].push_back(uint32_t(i));
+            }
+            return groups;
+        }
+
+        // solves the dense B x B system block * result = rhs with partial pivoting
+        template <class T, size_t B>
+        array<T, B> solve_block(const T* block, array<T, B> rhs)
+        {
+            array<array<T, B>, B> a;
+            for (size_t r(0); r < B; ++r)
+                for (size_t c(0); c < B; ++c)
+                    a[r][c] = block[r * B + c];
+
+            for (size_t column(0); column < B; ++column)
+            {
+                size_t pivot(column);
+                for (size_t r(column + 1); r < B; ++r)
+                    if (abs(a[r][column]) > abs(a[pivot][column]))
+                        pivot = r;
+                if (a[pivot][column] == T(0))
+                    throw invalid_argument("Diagonal block is singular");
+                swap(a[pivot], a[column]);
+                swap(rhs[pivot], rhs[column]);
+
+                for (size_t r(column + 1); r < B; ++r)
+                {
+                    const T factor(a[r][column] / a[column][column]);
+                    for (size_t c(column); c < B; ++c)
+                        a[r][c] -= a[column][c] * factor;
+                    rhs[r] -= rhs[column] * factor;
+                }
+            }
+            array<T, B> result{};
+            for (size_t r(B); r-- > 0;)
+            {
+                T sum(rhs[r]);
+                for (size_t c(r + 1); c < B; ++c)
+                    sum -= a[r][c] * result[c];
+                result[r] = sum / a[r][r];
+            }
+            return result;
+        }
+    } // detail
+
+    template <class T>
+    solver_result conjugate_gradient(const csr_matrix<T>& a, const vector<T>& b, vector<T>& x,
+                                     size_t max_iterations, T tolerance, thread_pool& pool)
+    {
+        if (a.rows() != a.columns())
+            throw invalid_argument("Matrix must be square");
+        if (b.size() != a.rows())
+            throw invalid_argument("Vector size does not match the number of rows");
+        return detail::conjugate_gradient(a, b, x, max_iterations, tolerance, pool);
+    }
+
+    template <class T, size_t B>
+    solver_result conjugate_gradient(const bsr_matrix<T, B>& a, const vector<point<T, B>>& b,
+                                     vector<point<T, B>>& x, size_t max_iterations, T tolerance,
+                                     thread_pool& pool)
+    {
+        if (a.block_rows() != a.block_columns())
+            throw invalid_argument("Matrix must be square");
+        if (b.size() != a.block_rows())
+            throw invalid_argument("Vector size does not match the number of rows");
+        return detail::conjugate_gradient(a, b, x, max_iterations, tolerance, pool);
+    }
+
+    template <class T>
+    solver_result gauss_seidel(const csr_matrix<T>& a, const vector<T>& b, vector<T>& x,
+                               size_t max_iterations, T tolerance, thread_pool& pool)
+    {
+        if (a.rows() != a.columns())
+            throw invalid_argument("Matrix must be square");
+        if (b.size() != a.rows())
+            throw invalid_argument("Vector size does not match the number of rows");
+
+        const size_t n(b.size());
+        x.resize(n);
+        const auto& offsets(a.row_offsets());
+        const auto& indices(a.column_indices());
+        const auto& values(a.values());
+        const auto diagonal(a.main_diagonal());
+        for (const T& value : diagonal)
+            if (value == T(0))
+                throw invalid_argument("Matrix has a zero on the main diagonal");
+
+        const auto groups(detail::color_rows(offsets, indices));
+        const T b_norm(sqrt(detail::parallel_dot(b, b, pool)));
+        if (b_norm == T(0))
+        {
+            fill(x.begin(), x.end(), T(0));
+            return {0, 0.0, true};
+        }
+
+        vector<T> scratch;
+        size_t iteration(0);
+        T residual(detail::relative_residual(a, b, x, scratch, b_norm, pool));
+        while (iteration < max_iterations && !(residual <= tolerance))
+        {
+            for (const auto& rows : groups)
+                pool.parallel_for(0, rows.size(), detail::sparse_row_grain, [&](size_t first, size_t last)
+                {
+                    for (size_t r(first); r < last; ++r)
+                    {
+                        const size_t i(rows[r]);
+                        T sum(b[i]);
+                        for (size_t k(offsets[i]); k < offsets[i + 1]; ++k)
+                            if (indices[k] != i)
+                                sum -= values[k] * x[indices[k]];
+                        x[i] = sum / diagonal[i];
+                    }
+                });
+            ++iteration;
+            residual = detail::relative_residual(a, b, x, scratch, b_norm, pool);
+        }
+        return {iteration, double(residual), residual <= tolerance};
+    }
+
+    template <class T, size_t B>
+    solver_result gauss_seidel(const bsr_matrix<T, B>& a, const vector<point<T, B>>& b,
+                               vector<point<T, B>>& x, size_t max_iterations, T tolerance,
+                               thread_pool& pool)
+    {
+        if (a.block_rows() != a.block_columns())
+            throw invalid_argument("Matrix must be square");
+        if (b.size() != a.block_rows())
+            throw invalid_argument("Vector size does not match the number of rows");
+
+        const size_t n(b.size());
+        x.resize(n);
+        const auto& offsets(a.row_offsets());
+        const auto& indices(a.column_indices());
+
+        vector<size_t> diagonal(n);
+        for (size_t i(0); i < n; ++i)
+        {
+            auto first(indices.begin() + offsets[i]),
+                 last(indices.begin() + offsets[i + 1]);
+            auto found(lower_bound(first, last, uint32_t(i)));
+            if (found == last || *found != i)
+                throw invalid_argument("Matrix has a zero on the main diagonal");
+            diagonal[i] = found - indices.begin();
+        }
+
+        const auto groups(detail::color_rows(offsets, indices));
+        const T b_norm(sqrt(detail::parallel_dot(b, b, pool)));
+        if (b_norm == T(0))
+        {
+            fill(x.begin(), x.end(), point<T, B>());
+            return {0, 0.0, true};
+        }
+
+        vector<point<T, B>> scratch;
+        size_t iteration(0);
+        T residual(detail::relative_residual(a, b, x, scratch, b_norm, pool));
+        while (iteration < max_iterations && !(residual <= tolerance))
+        {
+            for (const auto& rows : groups)
+                pool.parallel_for(0, rows.size(), detail::sparse_row_grain / B, [&](size_t first, size_t last)
+                {
+                    for (size_t r(first); r < last; ++r)
+                    {
+                        const size_t i(rows[r]);
+                        array<T, B> sum(b[i].get_coordinates());
+                        for (size_t k(offsets[i]); k < offsets[i + 1]; ++k)
+                        {
+                            if (indices[k] == i)
+                                continue;
+                            const T* block(a.block_data(k));
+                            const array<T, B> source(x[indices[k]].get_coordinates());
+                            for (size_t row(0); row < B; ++row)
+                                for (size_t column(0); column < B; ++column)
+                                    sum[row] -= block[row * B + column] * source[column];
+                        }
+                        x[i] = point<T, B>(detail::solve_block<T, B>(a.block_data(diagonal[i]), sum));
+                    }
+                });
+            ++iteration;
+            residual = detail::relative_residual(a, b, x, scratch, b_norm, pool);
+        }
+        return {iteration, double(residual), residual <= tolerance};
+    }
+} // engine_lib
+#endif
@@ -0,0 +1,216 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef SPARSE_MATRIX_HPP
+#define SPARSE_MATRIX_HPP
+#include "../../includes.hpp"
+#include "../point/point.hpp"
+#include "../matrix/matrix.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief A single (row, column, value) entry used to assemble sparse matrices.
+     *
+     * @tparam V Type of the stored value, a scalar for csr_matrix or a block for bsr_matrix.
+     */
+    template <class V>
+    struct sparse_entry
+    {
+        size_t row; //!< Row index.
+        size_t column; //!< Column index.
+        V value; //!< Value, entries with the same position are summed.
+    };
+
+    /**
+    * @brief Sparse matrix in compressed sparse row (CSR) format.
+    *
+    * Row i owns the entries [row_offsets()[i], row_offsets()[i + 1]) of column_indices() and
+    * values(). Columns inside a row are sorted. The matrix is immutable after assembly,
+    * which keeps multiply() free of synchronization.
+    *
+    * @tparam T Type of elements in the matrix.
+    */
+    template <class T>
+    class csr_matrix
+    {
+    private:
+        size_t rows_; /// Number of rows.
+        size_t columns_; /// Number of columns.
+        vector<size_t> row_offsets_; /// rows_ + 1 offsets into column_indices_ and values_.
+        vector<uint32_t> column_indices_; /// Column of every stored value.
+        vector<T> values_; /// Stored values.
+
+    public:
+        /**
+         * @brief Default constructor. Creates an empty 0x0 matrix.
+         */
+        csr_matrix();
+
+        /**
+         * @brief Assembles a matrix from unordered entries, summing duplicates.
+         *
+         * @param rows Number of rows.
+         * @param columns Number of columns.
+         * @param entries Entries of the matrix.
+         * @throws out_of_range If an entry lies outside the matrix.
+         */
+        csr_matrix(size_t rows, size_t columns, const vector<sparse_entry<T>>& entries);
+
+        /**
+         * @brief Returns the number of rows in the matrix.
+         *
+         * @return Number of rows.
+         */
+        [[nodiscard]] size_t rows() const;
+
+        /**
+         * @brief Returns the number of columns in the matrix.
+         *
+         * @return Number of columns.
+         */
+        [[nodiscard]] size_t columns() const;
+
+        /**
+         * @brief Returns the number of stored values.
+         *
+         * @return Number of stored values.
+         */
+        [[nodiscard]] size_t non_zeros() const;
+
+        const vector<size_t>& row_offsets() const;
+        const vector<uint32_t>& column_indices() const;
+        const vector<T>& values() const;
+
+        /**
+         * @brief Reads the element at the given row and column.
+         *
+         * @param row Row index.
+         * @param column Column index.
+         * @return The stored value or zero.
+         */
+        T operator()(size_t row, size_t column) const;
+
+        /**
+         * @brief Returns the main diagonal.
+         *
+         * @return One value per row, zero where nothing is stored.
+         */
+        vector<T> main_diagonal() const;
+
+        /**
+         * @brief Computes y = A * x with the rows spread over the pool.
+         *
+         * @param x Vector of columns() values.
+         * @param y Result, resized to rows() values. Must not alias x.
+         * @param pool Pool executing the row ranges.
+         * @throws invalid_argument If x has the wrong size.
+         */
+        void multiply(const vector<T>& x, vector<T>& y, thread_pool& pool = thread_pool::global()) const;
+
+        /**
+         * @brief Multiply the matrix by a vector.
+         *
+         * @param x Vector of columns() values.
+         * @return New vector resulting from the multiplication.
+         */
+        vector<T> operator*(const vector<T>& x) const;
+    };
+
+    /**
+    * @brief Sparse matrix of B x B blocks in block compressed sparse row (BSR) format.
+    *
+    * The layout matches csr_matrix with every value replaced by a dense row-major block.
+    * It multiplies vectors of point<T, B>, the natural shape of per-particle 3D unknowns,
+    * and loads each block once for B * B multiply-adds.
+    *
+    * @tparam T Type of elements in the matrix.
+    * @tparam B Number of rows and columns in a block.
+    */
+    template <class T, size_t B>
+    class bsr_matrix
+    {
+    private:
+        size_t block_rows_; /// Number of block rows.
+        size_t block_columns_; /// Number of block columns.
+        vector<size_t> row_offsets_; /// block_rows_ + 1 offsets into column_indices_.
+        vector<uint32_t> column_indices_; /// Block column of every stored block.
+        vector<T> values_; /// B * B row-major values per stored block.
+
+    public:
+        /**
+         * @brief Default constructor. Creates an empty matrix.
+         */
+        bsr_matrix();
+
+        /**
+         * @brief Assembles a matrix from unordered block entries, summing duplicates.
+         *
+         * @param block_rows Number of block rows.
+         * @param block_columns Number of block columns.
+         * @param entries Block entries, positions are given in blocks.
+         * @throws out_of_range If an entry lies outside the matrix.
+         */
+        bsr_matrix(size_t block_rows, size_t block_columns, const vector<sparse_entry<matrix<T, B, B>>>& entries);
+
+        [[nodiscard]] size_t block_rows() const;
+        [[nodiscard]] size_t block_columns() const;
+
+        /**
+         * @brief Returns the number of stored blocks.
+         *
+         * @return Number of stored blocks.
+         */
+        [[nodiscard]] size_t non_zero_blocks() const;
+
+        const vector<size_t>& row_offsets() const;
+        const vector<uint32_t>& column_indices() const;
+
+        /**
+         * @brief Returns the values of a stored block.
+         *
+         * @param index Index of the block in column_indices().
+         * @return Pointer to B * B row-major values.
+         */
+        const T* block_data(size_t index) const;
+
+        /**
+         * @brief Reads the block at the given block row and column.
+         *
+         * @param block_row Block row index.
+         * @param block_column Block column index.
+         * @return The stored block or a zero matrix.
+         */
+        matrix<T, B, B> block(size_t block_row, size_t block_column) const;
+
+        /**
+         * @brief Computes y = A * x with the block rows spread over the pool.
+         *
+         * @param x Vector of block_columns() points.
+         * @param y Result, resized to block_rows() points. Must not alias x.
+         * @param pool Pool executing the row ranges.
+         * @throws invalid_argument If x has the wrong size.
+         */
+        void multiply(const vector<point<T, B>>& x, vector<point<T, B>>& y,
+                      thread_pool& pool = thread_pool::global()) const;
+
+        /**
+         * @brief Multiply the matrix by a vector of points.
+         *
+         * @param x Vector of block_columns() points.
+         * @return New vector resulting from the multiplication.
+         */
+        vector<point<T, B>> operator*(const vector<point<T, B>>& x) const;
+    };
+} // engine_lib
+
+#endif //SPARSE_MATRIX_HPP
+#include "sparse_matrix.inl"
@@ -0,0 +1,313 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+#ifndef SPARSE_MATRIX_INL
+#define SPARSE_MATRIX_INL
+
+#include <algorithm>
+#include <limits>
+
+
+namespace engine_lib
+{
+    using namespace std;
+
+    namespace detail
+    {
+        // rows handed to one task by the parallel sparse kernels
+        constexpr size_t sparse_row_grain = 2048;
+
+        /*
+         * Orders entries by (row, column): a counting sort by row followed by a sort
+         * of every row's columns. Fills offsets with the per-row start of the order.
+         */
+        template <class V>
+        vector<size_t> sparse_entry_order(size_t rows, size_t columns, const vector<sparse_entry<V>>& entries,
+                                          vector<size_t>& offsets)
+        {
+            if (columns > numeric_limits<uint32_t>::max())
+                throw out_of_range("Too many columns for a sparse matrix");
+
+            offsets.assign(rows + 1, 0);
+            for (const auto& entry : entries)
+            {
+                if (entry.row >= rows)
+                    throw out_of_range("Row index out of range");
+                if (entry.column >= columns)
+                    throw out_of_range("Column index out of range");
+                ++offsets[entry.row + 1];
+            }
+            for (size_t i(0); i < rows; ++i)
+                offsets[i + 1] += offsets[i];
+
+            vector<size_t> order(entries.size());
+            vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i(0); i < entries.size(); ++i)
+                order[cursor[entries[i].row]++] = i;
+
+            for (size_t i(0); i < rows; ++i)
+                sort(order.begin() + offsets[i], order.begin() + offsets[i + 1],
+                     [&entries](size_t a, size_t b) { return entries[a].column < entries[b].column; });
+            return order;
+        }
+    } // detail
+
+    template <class T>
+    csr_matrix<T>::csr_matrix()
+        : rows_(0),
+          columns_(0),
+          row_offsets_(1, 0)
+    {
+    }
+
+    template <class T>
+    csr_matrix<T>::csr_matrix(size_t rows, size_t columns, const vector<sparse_entry<T>>& entries)
+        : rows_(rows),
+          columns_(columns),
+          row_offsets_(rows + 1, 0)
+    {
+        vector<size_t> offsets;
+        auto order(detail::sparse_entry_order(rows, columns, entries, offsets));
+
+        column_indices_.reserve(entries.size());
+        values_.reserve(entries.size());
+        for (size_t i(0); i < rows; ++i)
+        {
+            for (size_t k(offsets[i]); k < offsets[i + 1]; ++k)
+            {
+                const auto& entry(entries[order[k]]);
+                if (column_indices_.size() > row_offsets_[i] && column_indices_.back() == entry.column)
+                    values_.back() += entry.value;
+                else
+                {
+                    column_indices_.push_back(uint32_t(entry.column));
+                    values_.push_back(entry.value);
+                }
+            }
+            row_offsets_[i + 1] = column_indices_.size();
+        }
+    }
+
+    template <class T>
+    size_t csr_matrix<T>::rows() const
+    {
+        return rows_;
+    }
+
+    template <class T>
+    size_t csr_matrix<T>::columns() const
+    {
+        return columns_;
+    }
+
+    template <class T>
+    size_t csr_matrix<T>::non_zeros() const
+    {
+        return values_.size();
+    }
+
+    template <class T>
+    const vector<size_t>& csr_matrix<T>::row_offsets() const
+    {
+        return row_offsets_;
+    }
+
+    template <class T>
+    const vector<uint32_t>& csr_matrix<T>::column_indices() const
+    {
+        return column_indices_;
+    }
+
+    template <class T>
+    const vector<T>& csr_matrix<T>::values() const
+    {
+        return values_;
+    }
+
+    template <class T>
+    T csr_matrix<T>::operator()(size_t row, size_t column) const
+    {
+        if (row >= rows_)
+            throw out_of_range("Invalid row index");
+        if (column >= columns_)
+            throw out_of_range("Invalid column index");
+
+        auto first(column_indices_.begin() + row_offsets_[row]),
+             last(column_indices_.begin() + row_offsets_[row + 1]);
+        auto found(lower_bound(first, last, uint32_t(column)));
+        if (found == last || *found != column)
+            return T(0);
+        return values_[found - column_indices_.begin()];
+    }
+
+    template <class T>
+    vector<T> csr_matrix<T>::main_diagonal() const
+    {
+        vector<T> result(rows_, T(0));
+        for (size_t i(0); i < min(rows_, columns_); ++i)
+            result[i] = (*this)(i, i);
+        return result;
+    }
+
+    template <class T>
+    void csr_matrix<T>::multiply(const vector<T>& x, vector<T>& y, thread_pool& pool) const
+    {
+        if (x.size() != columns_)
+            throw invalid_argument("Vector size does not match the number of columns");
+        y.resize(rows_);
+
+        pool.parallel_for(0, rows_, detail::sparse_row_grain, [&](size_t first, size_t last)
+        {
+            const size_t* offsets(row_offsets_.data());
+            const uint32_t* indices(column_indices_.data());
+            const T* values(values_.data());
+            const T* source(x.data());
+            for (size_t i(first); i < last; ++i)
+            {
+                T sum(0);
+                for (size_t k(offsets[i]); k < offsets[i + 1]; ++k)
+                    sum += values[k] * source[indices[k]];
+                y[i] = sum;
+            }
+        });
+    }
+
+    template <class T>
+    vector<T> csr_matrix<T>::operator*(const vector<T>& x) const
+    {
+        vector<T> result;
+        multiply(x, result);
+        return result;
+    }
+
+    template <class T, size_t B>
+    bsr_matrix<T, B>::bsr_matrix()
+        : block_rows_(0),
+          block_columns_(0),
+          row_offsets_(1, 0)
+    {
+    }
+
+    template <class T, size_t B>
+    bsr_matrix<T, B>::bsr_matrix(size_t block_rows, size_t block_columns,
+                                 const vector<sparse_entry<matrix<T, B, B>>>& entries)
+        : block_rows_(block_rows),
+          block_columns_(block_columns),
+          row_offsets_(block_rows + 1, 0)
+    {
+        vector<size_t> offsets;
+        auto order(detail::sparse_entry_order(block_rows, block_columns, entries, offsets));
+
+        column_indices_.reserve(entries.size());
+        values_.reserve(entries.size() * B * B);
+        for (size_t i(0); i < block_rows; ++i)
+        {
+            for (size_t k(offsets[i]); k < offsets[i + 1]; ++k)
+            {
+                const auto& entry(entries[order[k]]);
+                if (column_indices_.size() == row_offsets_[i] || column_indices_.back() != entry.column)
+                {
+                    column_indices_.push_back(uint32_t(entry.column));
+                    values_.resize(values_.size() + B * B, T(0));
+                }
+                T* block(values_.data() + values_.size() - B * B);
+                for (size_t r(0); r < B; ++r)
+                    for (size_t c(0); c < B; ++c)
+                        block[r * B + c] += entry.value(r, c);
+            }
+            row_offsets_[i + 1] = column_indices_.size();
+        }
+    }
+
+    template <class T, size_t B>
+    size_t bsr_matrix<T, B>::block_rows() const
+    {
+        return block_rows_;
+    }
+
+    template <class T, size_t B>
+    size_t bsr_matrix<T, B>::block_columns() const
+    {
+        return block_columns_;
+    }
+
+    template <class T, size_t B>
+    size_t bsr_matrix<T, B>::non_zero_blocks() const
+    {
+        return column_indices_.size();
+    }
+
+    template <class T, size_t B>
+    const vector<size_t>& bsr_matrix<T, B>::row_offsets() const
+    {
+        return row_offsets_;
+    }
+
+    template <class T, size_t B>
+    const vector<uint32_t>& bsr_matrix<T, B>::column_indices() const
+    {
+        return column_indices_;
+    }
+
+    template <class T, size_t B>
+    const T* bsr_matrix<T, B>::block_data(size_t index) const
+    {
+        return values_.data() + index * B * B;
+    }
+
+    template <class T, size_t B>
+    matrix<T, B, B> bsr_matrix<T, B>::block(size_t block_row, size_t block_column) const
+    {
+        if (block_row >= block_rows_)
+            throw out_of_range("Invalid row index");
+        if (block_column >= block_columns_)
+            throw out_of_range("Invalid column index");
+
+        matrix<T, B, B> result;
+        auto first(column_indices_.begin() + row_offsets_[block_row]),
+             last(column_indices_.begin() + row_offsets_[block_row + 1]);
+        auto found(lower_bound(first, last, uint32_t(block_column)));
+        if (found == last || *found != block_column)
+            return result;
+
+        const T* values(block_data(found - column_indices_.begin()));
+        for (size_t r(0); r < B; ++r)
+            for (size_t c(0); c < B; ++c)
+                result(r, c) = values[r * B + c];
+        return result;
+    }
+
+    template <class T, size_t B>
+    void bsr_matrix<T, B>::multiply(const vector<point<T, B>>& x, vector<point<T, B>>& y, thread_pool& pool) const
+    {
+        if (x.size() != block_columns_)
+            throw invalid_argument("Vector size does not match the number of columns");
+        y.resize(block_rows_);
+
+        pool.parallel_for(0, block_rows_, detail::sparse_row_grain / B, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; ++i)
+            {
+                array<T, B> sum{};
+                for (size_t k(row_offsets_[i]); k < row_offsets_[i + 1]; ++k)
+                {
+                    const T* values(block_data(k));
+                    const array<T, B> source(x[column_indices_[k]].get_coordinates());
+                    for (size_t r(0); r < B; ++r)
+                        for (size_t c(0); c < B; ++c)
+                            sum[r] += values[r * B + c] * source[c];
+                }
+                y[i] = point<T, B>(sum);
+            }
+        });
+    }
+
+    template <class T, size_t B>
+    vector<point<T, B>> bsr_matrix<T, B>::operator*(const vector<point<T, B>>& x) const
+    {
+        vector<point<T, B>> result;
+        multiply(x, result);
+        return result;
+    }
+} // engine_lib
+#endif
@@ -0,0 +1,54 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef VECTOR3_HPP
+#define VECTOR3_HPP
+#include "../../includes.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /*
+     * Arithmetic on plain three-component arrays, for the inner loops of the geometry,
+     * physics and rendering kernels. point and direction carry more state than those
+     * loops need, so the kernels unpack get_coordinates() once and work on the arrays.
+     */
+
+    template <class T>
+    array<T, 3> add(const array<T, 3>& a, const array<T, 3>& b);
+
+    template <class T>
+    array<T, 3> subtract(const array<T, 3>& a, const array<T, 3>& b);
+
+    /**
+     * @brief Multiplies every component by a factor, converted to the component type.
+     */
+    template <class T>
+    array<T, 3> scale(const array<T, 3>& a, typename array<T, 3>::value_type factor);
+
+    /**
+     * @brief Multiplies two vectors component by component.
+     */
+    template <class T>
+    array<T, 3> multiply(const array<T, 3>& a, const array<T, 3>& b);
+
+    template <class T>
+    T dot(const array<T, 3>& a, const array<T, 3>& b);
+
+    template <class T>
+    array<T, 3> cross(const array<T, 3>& a, const array<T, 3>& b);
+
+    /**
+     * @brief Returns the unit vector of the same direction, or the zero vector for a zero vector.
+     */
+    template <class T>
+    array<T, 3> normalized(const array<T, 3>& a);
+} // engine_lib
+
+#endif //VECTOR3_HPP
+#include "vector3.inl"
@@ -0,0 +1,54 @@
+#ifndef VECTOR3_INL
+#define VECTOR3_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    array<T, 3> add(const array<T, 3>& a, const array<T, 3>& b)
+    {
+        return {a[0] + b[0], a[1] + b[1], a[2] + b[2]};
+    }
+
+    template <class T>
+    array<T, 3> subtract(const array<T, 3>& a, const array<T, 3>& b)
+    {
+        return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+    }
+
+    template <class T>
+    array<T, 3> scale(const array<T, 3>& a, typename array<T, 3>::value_type factor)
+    {
+        return {a[0] * factor, a[1] * factor, a[2] * factor};
+    }
+
+    template <class T>
+    array<T, 3> multiply(const array<T, 3>& a, const array<T, 3>& b)
+    {
+        return {a[0] * b[0], a[1] * b[1], a[2] * b[2]};
+    }
+
+    template <class T>
+    T dot(const array<T, 3>& a, const array<T, 3>& b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    template <class T>
+    array<T, 3> cross(const array<T, 3>& a, const array<T, 3>& b)
+    {
+        return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    }
+
+    template <class T>
+    array<T, 3> normalized(const array<T, 3>& a)
+    {
+        const T length(sqrt(dot(a, a)));
+        if (length == T(0))
+            return {T(0), T(0), T(0)};
+        return {a[0] / length, a[1] / length, a[2] / length};
+    }
+} // engine_lib
+
+#endif //VECTOR3_INL
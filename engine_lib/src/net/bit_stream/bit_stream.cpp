@@ -0,0 +1,200 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "bit_stream.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr float half_sqrt2(0.70710678f);
+
+        uint64_t low_mask(unsigned bits)
+        {
+            return (uint64_t(1) << bits) - 1;
+        }
+
+        void check_width(unsigned count, unsigned largest)
+        {
+            if (count > largest)
+                throw invalid_argument("Bit width above " + to_string(largest));
+        }
+
+        void check_range(float minimum, float maximum, unsigned bits)
+        {
+            if (bits == 0 || bits > 32)
+                throw invalid_argument("Quantization needs 1 to 32 bits");
+            if (!(maximum > minimum))
+                throw invalid_argument("Quantization range is empty");
+        }
+    }
+
+    bit_writer::bit_writer(vector<unsigned char>& target) : target_(target), bits_(0)
+    {
+        target_.clear();
+    }
+
+    void bit_writer::write_bits(uint32_t value, unsigned count)
+    {
+        check_width(count, 32);
+        target_.resize((bits_ + count + 7) / 8);
+        // the value shifted into its first byte spans at most five bytes
+        uint64_t shifted((uint64_t(value) & low_mask(count)) << (bits_ % 8));
+        for (size_t byte(bits_ / 8); shifted != 0; ++byte, shifted >>= 8)
+            target_[byte] |= static_cast<unsigned char>(shifted);
+        bits_ += count;
+    }
+
+    void bit_writer::write_signed(int32_t value, unsigned count)
+    {
+        if (count == 0)
+            throw invalid_argument("A signed value needs at least one bit");
+        write_bits(uint32_t(value), count);
+    }
+
+    void bit_writer::write_bool(bool value)
+    {
+        write_bits(value ? 1 : 0, 1);
+    }
+
+    void bit_writer::rewind(size_t bit_count)
+    {
+        if (bit_count > bits_)
+            throw out_of_range("Cannot rewind past the end of the stream");
+        bits_ = bit_count;
+        target_.resize((bits_ + 7) / 8);
+        if (bits_ % 8 != 0)
+            target_.back() &= static_cast<unsigned char>(low_mask(bits_ % 8));
+    }
+
+    size_t bit_writer::bit_count() const
+    {
+        return bits_;
+    }
+
+    size_t bit_writer::size() const
+    {
+        return target_.size();
+    }
+
+    bit_reader::bit_reader(const unsigned char* data, size_t size) : data_(data), size_(size), bits_(0)
+    {
+    }
+
+    uint32_t bit_reader::read_bits(unsigned count)
+    {
+        check_width(count, 32);
+        if (count > remaining_bits())
+            throw out_of_range("Bit stream ends before the value");
+        const size_t first(bits_ / 8);
+        const unsigned shift(unsigned(bits_ % 8));
+        uint64_t gathered(0);
+        for (size_t k(0), bytes((shift + count + 7) / 8); k < bytes; ++k)
+            gathered |= uint64_t(data_[first + k]) << (8 * k);
+        bits_ += count;
+        return uint32_t((gathered >> shift) & low_mask(count));
+    }
+
+    int32_t bit_reader::read_signed(unsigned count)
+    {
+        if (count == 0)
+            throw invalid_argument("A signed value needs at least one bit");
+        const uint32_t value(read_bits(count));
+        // sign extend from bit count - 1
+        const uint32_t sign(uint32_t(1) << (count - 1));
+        return int32_t(int64_t(value ^ sign) - int64_t(sign));
+    }
+
+    bool bit_reader::read_bool()
+    {
+        return read_bits(1) != 0;
+    }
+
+    size_t bit_reader::remaining_bits() const
+    {
+        return size_ * 8 - bits_;
+    }
+
+    uint32_t quantize(float value, float minimum, float maximum, unsigned bits)
+    {
+        check_range(minimum, maximum, bits);
+        const double steps(double(low_mask(bits)));
+        const double t((double(clamp(value, minimum, maximum)) - minimum) / (double(maximum) - minimum));
+        return uint32_t(llround(t * steps));
+    }
+
+    float dequantize(uint32_t value, float minimum, float maximum, unsigned bits)
+    {
+        check_range(minimum, maximum, bits);
+        const double steps(double(low_mask(bits)));
+        return float(minimum + (double(maximum) - minimum) * (double(min<uint64_t>(value, low_mask(bits))) / steps));
+    }
+
+    array<uint32_t, 3> quantize_position(const point<float, 3>& position, const position_quantization& quantization)
+    {
+        array<uint32_t, 3> quantized{};
+        for (size_t axis(0); axis < 3; ++axis)
+            quantized[axis] = quantize(position.get_coordinates()[axis], quantization.minimum[axis],
+                                       quantization.maximum[axis], quantization.bits);
+        return quantized;
+    }
+
+    point<float, 3> dequantize_position(const array<uint32_t, 3>& position, const position_quantization& quantization)
+    {
+        array<float, 3> coordinates{};
+        for (size_t axis(0); axis < 3; ++axis)
+            coordinates[axis] = dequantize(position[axis], quantization.minimum[axis], quantization.maximum[axis],
+                                           quantization.bits);
+        return point<float, 3>(coordinates);
+    }
+
+    uint32_t quantize_rotation(const array<float, 4>& rotation, unsigned bits)
+    {
+        if (bits == 0 || bits > 10)
+            throw invalid_argument("Rotation components need 1 to 10 bits");
+        size_t largest(0);
+        for (size_t i(1); i < 4; ++i)
+            if (fabs(rotation[i]) > fabs(rotation[largest]))
+                largest = i;
+        // q and -q are the same rotation, so the dropped component is made positive
+        const float sign(rotation[largest] < 0 ? -1.0f : 1.0f);
+        uint32_t encoded(static_cast<uint32_t>(largest));
+        unsigned shift(2);
+        for (size_t i(0); i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+            encoded |= quantize(sign * rotation[i], -half_sqrt2, half_sqrt2, bits) << shift;
+            shift += bits;
+        }
+        return encoded;
+    }
+
+    array<float, 4> dequantize_rotation(uint32_t rotation, unsigned bits)
+    {
+        if (bits == 0 || bits > 10)
+            throw invalid_argument("Rotation components need 1 to 10 bits");
+        const size_t largest(rotation & 3);
+        array<float, 4> decoded{};
+        float squares(0);
+        unsigned shift(2);
+        for (size_t i(0); i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+            decoded[i] = dequantize(uint32_t((rotation >> shift) & low_mask(bits)), -half_sqrt2, half_sqrt2, bits);
+            squares += decoded[i] * decoded[i];
+            shift += bits;
+        }
+        decoded[largest] = sqrt(max(0.0f, 1.0f - squares));
+        // renormalize so rounding never leaves a visibly scaled quaternion
+        const float length(sqrt(squares + decoded[largest] * decoded[largest]));
+        for (float& component : decoded)
+            component /= length;
+        return decoded;
+    }
+} // engine_lib
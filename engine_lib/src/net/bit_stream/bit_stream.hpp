@@ -0,0 +1,191 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef BIT_STREAM_HPP
+#define BIT_STREAM_HPP
+#include "../../includes.hpp"
+#include "../../math/point/point.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class bit_writer
+     * @brief Packs values of any bit width into a byte buffer, least significant bit first.
+     */
+    class bit_writer
+    {
+        vector<unsigned char>& target_; /// Buffer receiving the bits.
+        size_t bits_; /// Bits written.
+
+    public:
+        /**
+         * @brief Starts writing into a buffer, clearing it but keeping its capacity.
+         *
+         * @param target Buffer receiving the bits, must outlive the writer.
+         */
+        explicit bit_writer(vector<unsigned char>& target);
+
+        /**
+         * @brief Appends the low bits of a value.
+         *
+         * @param value The value, bits above count are ignored.
+         * @param count Number of bits, at most 32.
+         * @throws invalid_argument If count is above 32.
+         */
+        void write_bits(uint32_t value, unsigned count);
+
+        /**
+         * @brief Appends a signed value in two's complement.
+         *
+         * @param value The value, it must fit in count bits.
+         * @param count Number of bits, 1 to 32.
+         * @throws invalid_argument If count is zero or above 32.
+         */
+        void write_signed(int32_t value, unsigned count);
+
+        void write_bool(bool value);
+
+        /**
+         * @brief Drops everything written after a bit position, to undo a value that did not fit.
+         *
+         * @param bit_count Bits to keep.
+         * @throws out_of_range If more bits are kept than were written.
+         */
+        void rewind(size_t bit_count);
+
+        [[nodiscard]] size_t bit_count() const;
+        [[nodiscard]] size_t size() const;
+    };
+
+    /**
+     * @class bit_reader
+     * @brief Reads values written by a bit_writer, in the same order.
+     */
+    class bit_reader
+    {
+        const unsigned char* data_; /// First byte of the stream.
+        size_t size_; /// Size of the stream in bytes.
+        size_t bits_; /// Bits read.
+
+    public:
+        /**
+         * @brief Starts reading a stream.
+         *
+         * @param data First byte, must outlive the reader.
+         * @param size Size in bytes.
+         */
+        bit_reader(const unsigned char* data, size_t size);
+
+        /**
+         * @brief Reads an unsigned value.
+         *
+         * @param count Number of bits, at most 32.
+         * @return The value.
+         * @throws invalid_argument If count is above 32.
+         * @throws out_of_range If the stream ends first.
+         */
+        uint32_t read_bits(unsigned count);
+
+        /**
+         * @brief Reads a signed value written by write_signed().
+         *
+         * @param count Number of bits, 1 to 32.
+         * @return The value.
+         * @throws invalid_argument If count is zero or above 32.
+         * @throws out_of_range If the stream ends first.
+         */
+        int32_t read_signed(unsigned count);
+
+        bool read_bool();
+
+        [[nodiscard]] size_t remaining_bits() const;
+    };
+
+    /**
+     * @brief Maps a float of a range onto an unsigned integer of a bit width, rounding to the nearest step.
+     *
+     * @param value The value, clamped to the range.
+     * @param minimum Smallest value of the range.
+     * @param maximum Largest value of the range.
+     * @param bits Bit width, 1 to 32.
+     * @return The quantized value.
+     * @throws invalid_argument If bits is zero or above 32, or the range is empty.
+     */
+    uint32_t quantize(float value, float minimum, float maximum, unsigned bits);
+
+    /**
+     * @brief Inverse of quantize().
+     *
+     * @param value The quantized value.
+     * @param minimum Smallest value of the range.
+     * @param maximum Largest value of the range.
+     * @param bits Bit width, 1 to 32.
+     * @return The value.
+     * @throws invalid_argument If bits is zero or above 32, or the range is empty.
+     */
+    float dequantize(uint32_t value, float minimum, float maximum, unsigned bits);
+
+    /**
+     * @brief Box and precision of quantized positions.
+     */
+    struct position_quantization
+    {
+        array<float, 3> minimum{-1024, -1024, -1024}; /// Smallest corner of the world.
+        array<float, 3> maximum{1024, 1024, 1024}; /// Largest corner of the world.
+        unsigned bits = 20; /// Bits per axis; 20 bits over 2 km are 2 mm steps.
+    };
+
+    /**
+     * @brief Quantizes a position per axis.
+     *
+     * @param position The position, clamped to the box.
+     * @param quantization Box and precision.
+     * @return Quantized coordinates.
+     * @throws invalid_argument If the quantization is invalid.
+     */
+    array<uint32_t, 3> quantize_position(const point<float, 3>& position, const position_quantization& quantization);
+
+    /**
+     * @brief Inverse of quantize_position().
+     *
+     * @param position Quantized coordinates.
+     * @param quantization Box and precision.
+     * @return The position.
+     * @throws invalid_argument If the quantization is invalid.
+     */
+    point<float, 3> dequantize_position(const array<uint32_t, 3>& position, const position_quantization& quantization);
+
+    /**
+     * @brief Quantizes a unit quaternion with the smallest three encoding.
+     *
+     * The largest component is dropped and rebuilt from the unit length, its sign folded into
+     * the others, so 2 bits name it and the other three lie in [-1/sqrt(2), 1/sqrt(2)].
+     *
+     * @param rotation Unit quaternion (w, x, y, z).
+     * @param bits Bits per kept component, 1 to 10, so the result fits 32 bits.
+     * @return The 2 + 3 * bits wide encoding.
+     * @throws invalid_argument If bits is zero or above 10.
+     */
+    uint32_t quantize_rotation(const array<float, 4>& rotation, unsigned bits);
+
+    /**
+     * @brief Inverse of quantize_rotation().
+     *
+     * @param rotation The encoding.
+     * @param bits Bits per kept component, 1 to 10.
+     * @return Unit quaternion (w, x, y, z).
+     * @throws invalid_argument If bits is zero or above 10.
+     */
+    array<float, 4> dequantize_rotation(uint32_t rotation, unsigned bits);
+} // engine_lib
+
+#endif //BIT_STREAM_HPP
@@ -0,0 +1,484 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "replication.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr unsigned sequence_bits(32);
+        constexpr unsigned id_width_bits(5);
+        constexpr unsigned age_bits(5);
+        constexpr unsigned delta_class_bits(2);
+        constexpr unsigned small_delta_bits(8);
+        constexpr unsigned medium_delta_bits(14);
+        // sequence and id width, one record flag and the end marker
+        constexpr size_t smallest_packet((sequence_bits + id_width_bits + 2 + 7) / 8);
+
+        static_assert(replication_history <= (1u << age_bits), "Baseline ages must fit their field");
+
+        void validate(const replication_settings& settings)
+        {
+            const position_quantization& positions(settings.positions);
+            if (positions.bits == 0 || positions.bits > 32)
+                throw invalid_argument("Positions need 1 to 32 bits per axis");
+            for (size_t axis(0); axis < 3; ++axis)
+                if (!(positions.maximum[axis] > positions.minimum[axis]))
+                    throw invalid_argument("The position box is empty");
+            if (settings.rotation_bits == 0 || settings.rotation_bits > 10)
+                throw invalid_argument("Rotations need 1 to 10 bits per component");
+            if (settings.bytes_per_tick < smallest_packet)
+                throw invalid_argument("The packet size limit cannot hold a packet header");
+            if (!(settings.relevance_radius > 0))
+                throw invalid_argument("The relevance radius must be positive");
+        }
+
+        quantized_state quantize_state(const replicated_state& state, const replication_settings& settings)
+        {
+            quantized_state quantized;
+            quantized.position = quantize_position(state.position, settings.positions);
+            quantized.rotation = quantize_rotation(state.orientation, settings.rotation_bits);
+            return quantized;
+        }
+
+        replicated_state dequantize_state(const quantized_state& state, const replication_settings& settings)
+        {
+            replicated_state dequantized;
+            dequantized.position = dequantize_position(state.position, settings.positions);
+            dequantized.orientation = dequantize_rotation(state.rotation, settings.rotation_bits);
+            return dequantized;
+        }
+
+        // bits of the largest id of a table
+        unsigned id_width(size_t count)
+        {
+            unsigned bits(1);
+            while ((size_t(1) << bits) < count)
+                ++bits;
+            return bits;
+        }
+
+        bool fits_signed(int64_t value, unsigned bits)
+        {
+            return value >= -(int64_t(1) << (bits - 1)) && value < (int64_t(1) << (bits - 1));
+        }
+
+        // one coordinate as a size class and a delta, or absolute if the delta is large
+        void write_axis(bit_writer& out, uint32_t baseline, uint32_t value, unsigned bits)
+        {
+            const int64_t delta(int64_t(value) - int64_t(baseline));
+            if (delta == 0)
+                out.write_bits(0, delta_class_bits);
+            else if (fits_signed(delta, small_delta_bits))
+            {
+                out.write_bits(1, delta_class_bits);
+                out.write_signed(int32_t(delta), small_delta_bits);
+            }
+            else if (fits_signed(delta, medium_delta_bits))
+            {
+                out.write_bits(2, delta_class_bits);
+                out.write_signed(int32_t(delta), medium_delta_bits);
+            }
+            else
+            {
+                out.write_bits(3, delta_class_bits);
+                out.write_bits(value, bits);
+            }
+        }
+
+        uint32_t read_axis(bit_reader& in, uint32_t baseline, unsigned bits)
+        {
+            int64_t value(baseline);
+            switch (in.read_bits(delta_class_bits))
+            {
+            case 0:
+                break;
+            case 1:
+                value += in.read_signed(small_delta_bits);
+                break;
+            case 2:
+                value += in.read_signed(medium_delta_bits);
+                break;
+            default:
+                return in.read_bits(bits);
+            }
+            if (value < 0 || value > int64_t((uint64_t(1) << bits) - 1))
+                throw runtime_error("Malformed replication packet: coordinate out of range");
+            return uint32_t(value);
+        }
+
+        // the full state, or changed flags and deltas if the receiver holds a baseline
+        void write_state(bit_writer& out, const quantized_state* baseline, const quantized_state& state,
+                         const replication_settings& settings)
+        {
+            const unsigned position_bits(settings.positions.bits);
+            const unsigned rotation_bits(2 + 3 * settings.rotation_bits);
+            if (baseline == nullptr)
+            {
+                for (const uint32_t coordinate : state.position)
+                    out.write_bits(coordinate, position_bits);
+                out.write_bits(state.rotation, rotation_bits);
+                return;
+            }
+            const bool moved(state.position != baseline->position);
+            out.write_bool(moved);
+            if (moved)
+                for (size_t axis(0); axis < 3; ++axis)
+                    write_axis(out, baseline->position[axis], state.position[axis], position_bits);
+            const bool turned(state.rotation != baseline->rotation);
+            out.write_bool(turned);
+            if (turned)
+                out.write_bits(state.rotation, rotation_bits);
+        }
+
+        quantized_state read_state(bit_reader& in, const quantized_state* baseline, const replication_settings& settings)
+        {
+            const unsigned position_bits(settings.positions.bits);
+            const unsigned rotation_bits(2 + 3 * settings.rotation_bits);
+            quantized_state state;
+            if (baseline == nullptr)
+            {
+                for (uint32_t& coordinate : state.position)
+                    coordinate = in.read_bits(position_bits);
+                state.rotation = in.read_bits(rotation_bits);
+                return state;
+            }
+            state = *baseline;
+            if (in.read_bool())
+                for (size_t axis(0); axis < 3; ++axis)
+                    state.position[axis] = read_axis(in, baseline->position[axis], position_bits);
+            if (in.read_bool())
+                state.rotation = in.read_bits(rotation_bits);
+            return state;
+        }
+    }
+
+    bool quantized_state::operator==(const quantized_state& other) const
+    {
+        return position == other.position && rotation == other.rotation;
+    }
+
+    bool quantized_state::operator!=(const quantized_state& other) const
+    {
+        return !(*this == other);
+    }
+
+    replication_server::replication_server(const replication_settings& settings) : settings_(settings), sequence_(1)
+    {
+        validate(settings_);
+    }
+
+    uint32_t replication_server::add(const replicated_state& state, float priority)
+    {
+        uint32_t id;
+        if (!free_ids_.empty())
+        {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        else
+        {
+            if (entities_.size() >= max_replicated_entities)
+                throw runtime_error("Too many replicated entities");
+            id = uint32_t(entities_.size());
+            entities_.push_back({});
+        }
+        entity_slot& entity(entities_[id]);
+        entity.state = quantize_state(state, settings_);
+        entity.priority = priority;
+        // baselines of the previous user of the id no longer apply
+        ++entity.generation;
+        entity.alive = true;
+        entity.position = state.position;
+        return id;
+    }
+
+    void replication_server::set(uint32_t id, const replicated_state& state)
+    {
+        if (id >= entities_.size() || !entities_[id].alive)
+            throw out_of_range("Replicated entity " + to_string(id) + " does not exist");
+        entities_[id].state = quantize_state(state, settings_);
+        entities_[id].position = state.position;
+    }
+
+    void replication_server::remove(uint32_t id)
+    {
+        if (id >= entities_.size() || !entities_[id].alive)
+            throw out_of_range("Replicated entity " + to_string(id) + " does not exist");
+        entities_[id].alive = false;
+        free_ids_.push_back(id);
+    }
+
+    size_t replication_server::add_client()
+    {
+        clients_.emplace_back();
+        return clients_.size() - 1;
+    }
+
+    void replication_server::set_focus(size_t client, const point<float, 3>& focus)
+    {
+        clients_.at(client).focus = focus;
+        clients_.at(client).focused = true;
+    }
+
+    void replication_server::advance()
+    {
+        ++sequence_;
+    }
+
+    size_t replication_server::write_packet(size_t client_index, vector<unsigned char>& packet)
+    {
+        client_state& client(clients_.at(client_index));
+        sent_packet& sent(client.sent[sequence_ % replication_history]);
+        if (sent.sequence == sequence_)
+            throw logic_error("A client gets one packet per tick; call advance() first");
+        client.baselines.resize(entities_.size());
+        client.accumulators.resize(entities_.size(), 0);
+
+        // entities the client holds an outdated state of, and removals it has not confirmed
+        client.candidates.clear();
+        const float inverse_radius(1 / (settings_.relevance_radius * settings_.relevance_radius));
+        for (uint32_t id(0); id < entities_.size(); ++id)
+        {
+            const entity_slot& entity(entities_[id]);
+            const acknowledged_state& baseline(client.baselines[id]);
+            float& accumulator(client.accumulators[id]);
+            if (!entity.alive)
+            {
+                if (baseline.present)
+                {
+                    accumulator = numeric_limits<float>::max();
+                    client.candidates.push_back(id);
+                }
+                continue;
+            }
+            if (baseline.present && baseline.generation == entity.generation && baseline.state == entity.state)
+            {
+                accumulator = 0;
+                continue;
+            }
+            float weight(entity.priority);
+            if (client.focused)
+            {
+                float distance(0);
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    const float d(entity.position.get_coordinates()[axis] - client.focus.get_coordinates()[axis]);
+                    distance += d * d;
+                }
+                weight /= 1 + distance * inverse_radius;
+            }
+            accumulator += weight;
+            client.candidates.push_back(id);
+        }
+        sort(client.candidates.begin(), client.candidates.end(), [&](uint32_t a, uint32_t b)
+        {
+            const float first(client.accumulators[a]), second(client.accumulators[b]);
+            return first > second || (first == second && a < b);
+        });
+
+        sent.sequence = sequence_;
+        sent.acknowledged = false;
+        sent.records.clear();
+        bit_writer out(packet);
+        out.write_bits(sequence_, sequence_bits);
+        const unsigned id_bits(id_width(entities_.size()));
+        out.write_bits(id_bits - 1, id_width_bits);
+        // leaves room for the end marker
+        const size_t budget(settings_.bytes_per_tick * 8 - 1);
+        for (const uint32_t id : client.candidates)
+        {
+            const entity_slot& entity(entities_[id]);
+            const acknowledged_state& baseline(client.baselines[id]);
+            const size_t start(out.bit_count());
+            out.write_bool(true);
+            out.write_bits(id, id_bits);
+            out.write_bool(!entity.alive);
+            if (entity.alive)
+            {
+                const uint32_t age(sequence_ - baseline.sequence);
+                const bool delta(baseline.present && baseline.generation == entity.generation &&
+                                 age < replication_history);
+                out.write_bits(delta ? age : 0, age_bits);
+                write_state(out, delta ? &baseline.state : nullptr, entity.state, settings_);
+            }
+            if (out.bit_count() > budget)
+            {
+                out.rewind(start);
+                break;
+            }
+            sent.records.push_back({id, entity.generation, !entity.alive, entity.state});
+            client.accumulators[id] = 0;
+        }
+        out.write_bool(false);
+        return sent.records.size();
+    }
+
+    void replication_server::acknowledge(client_state& client, uint32_t sequence)
+    {
+        sent_packet& sent(client.sent[sequence % replication_history]);
+        if (sequence == 0 || sent.sequence != sequence || sent.acknowledged)
+            return;
+        sent.acknowledged = true;
+        // acknowledgements may arrive out of order, the newest packet of an entity wins
+        for (const sent_record& record : sent.records)
+        {
+            acknowledged_state& baseline(client.baselines[record.id]);
+            if (sequence <= baseline.sequence)
+                continue;
+            baseline.state = record.state;
+            baseline.sequence = sequence;
+            baseline.generation = record.generation;
+            baseline.present = !record.removed;
+        }
+    }
+
+    void replication_server::receive_ack(size_t client_index, const unsigned char* data, size_t size)
+    {
+        client_state& client(clients_.at(client_index));
+        bit_reader in(data, size);
+        uint32_t newest, earlier;
+        try
+        {
+            newest = in.read_bits(sequence_bits);
+            earlier = in.read_bits(replication_history);
+        }
+        catch (const out_of_range&)
+        {
+            throw runtime_error("Truncated replication acknowledgement");
+        }
+        acknowledge(client, newest);
+        for (uint32_t k(0); k < replication_history; ++k)
+            if ((earlier >> k & 1) != 0 && newest > k + 1)
+                acknowledge(client, newest - k - 1);
+    }
+
+    size_t replication_server::size() const
+    {
+        return entities_.size() - free_ids_.size();
+    }
+
+    size_t replication_server::client_count() const
+    {
+        return clients_.size();
+    }
+
+    uint32_t replication_server::sequence() const
+    {
+        return sequence_;
+    }
+
+    const replication_settings& replication_server::settings() const
+    {
+        return settings_;
+    }
+
+    replication_client::replication_client(const replication_settings& settings) : settings_(settings), newest_(0)
+    {
+        validate(settings_);
+    }
+
+    bool replication_client::receive(const unsigned char* data, size_t size)
+    {
+        bit_reader in(data, size);
+        uint32_t sequence;
+        try
+        {
+            sequence = in.read_bits(sequence_bits);
+            if (sequence == 0)
+                throw runtime_error("Malformed replication packet: zero sequence");
+            // a duplicate, or so late that its slot holds a newer packet
+            if (received_[sequence % replication_history].sequence >= sequence)
+                return false;
+            const unsigned id_bits(in.read_bits(id_width_bits) + 1);
+            if ((uint64_t(1) << id_bits) > 2 * uint64_t(max_replicated_entities))
+                throw runtime_error("Malformed replication packet: id width");
+
+            decoded_.clear();
+            while (in.read_bool())
+            {
+                received_record record{};
+                record.id = in.read_bits(id_bits);
+                record.removed = in.read_bool();
+                if (!record.removed)
+                {
+                    const uint32_t age(in.read_bits(age_bits));
+                    const quantized_state* baseline(nullptr);
+                    if (age != 0)
+                    {
+                        const received_packet& base(received_[(sequence - age) % replication_history]);
+                        // the baseline was overwritten by newer packets, this one is too late to use
+                        if (age >= sequence || base.sequence != sequence - age)
+                            return false;
+                        const auto found(lower_bound(base.records.begin(), base.records.end(), record.id,
+                                                     [](const received_record& r, uint32_t id) { return r.id < id; }));
+                        if (found == base.records.end() || found->id != record.id || found->removed)
+                            throw runtime_error("Malformed replication packet: entity missing from its baseline");
+                        baseline = &found->state;
+                    }
+                    record.state = read_state(in, baseline, settings_);
+                }
+                decoded_.push_back(record);
+            }
+        }
+        catch (const out_of_range&)
+        {
+            throw runtime_error("Truncated replication packet");
+        }
+
+        sort(decoded_.begin(), decoded_.end(),
+             [](const received_record& a, const received_record& b) { return a.id < b.id; });
+        for (size_t i(1); i < decoded_.size(); ++i)
+            if (decoded_[i].id == decoded_[i - 1].id)
+                throw runtime_error("Malformed replication packet: entity written twice");
+
+        for (const received_record& record : decoded_)
+        {
+            if (record.id >= replicas_.size())
+                replicas_.resize(size_t(record.id) + 1);
+            replica& target(replicas_[record.id]);
+            // a late packet does not roll back newer state
+            if (sequence <= target.sequence)
+                continue;
+            target.sequence = sequence;
+            target.present = !record.removed;
+            if (!record.removed)
+                target.state = dequantize_state(record.state, settings_);
+        }
+        received_packet& slot(received_[sequence % replication_history]);
+        slot.sequence = sequence;
+        slot.records.swap(decoded_);
+        newest_ = max(newest_, sequence);
+        return true;
+    }
+
+    void replication_client::write_ack(vector<unsigned char>& packet) const
+    {
+        uint32_t earlier(0);
+        for (uint32_t k(0); k < replication_history; ++k)
+        {
+            const uint32_t sequence(newest_ - k - 1);
+            if (newest_ > k + 1 && received_[sequence % replication_history].sequence == sequence)
+                earlier |= uint32_t(1) << k;
+        }
+        bit_writer out(packet);
+        out.write_bits(newest_, sequence_bits);
+        out.write_bits(earlier, replication_history);
+    }
+
+    const vector<replica>& replication_client::replicas() const
+    {
+        return replicas_;
+    }
+
+    uint32_t replication_client::newest_sequence() const
+    {
+        return newest_;
+    }
+} // engine_lib
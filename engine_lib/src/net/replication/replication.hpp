@@ -0,0 +1,278 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef REPLICATION_HPP
+#define REPLICATION_HPP
+#include "../../includes.hpp"
+#include "../../math/point/point.hpp"
+#include "../bit_stream/bit_stream.hpp"
+#include "../udp_socket/udp_socket.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /// Packets remembered on both ends, so also the oldest baseline a delta may refer to.
+    constexpr uint32_t replication_history = 32;
+
+    /// Most entity ids a replication_server hands out.
+    constexpr uint32_t max_replicated_entities = 1 << 20;
+
+    /**
+     * @brief Encoding and scheduling settings, identical on the server and its clients.
+     */
+    struct replication_settings
+    {
+        position_quantization positions; /// Box and precision of positions.
+        unsigned rotation_bits = 10; /// Bits per smallest three component, 1 to 10.
+        size_t bytes_per_tick = udp_socket::safe_payload; /// Packet size limit, the bandwidth of a client per tick.
+        float relevance_radius = 64; /// Distance from a client's focus at which entity priority halves.
+    };
+
+    /**
+     * @brief Replicated state of one entity.
+     */
+    struct replicated_state
+    {
+        point<float, 3> position; /// Position.
+        array<float, 4> orientation{1, 0, 0, 0}; /// Unit quaternion (w, x, y, z).
+    };
+
+    /**
+     * @brief Client-side copy of an entity.
+     */
+    struct replica
+    {
+        replicated_state state; /// State as last received, quantized.
+        uint32_t sequence = 0; /// Packet the state came in.
+        bool present = false; /// Whether the entity exists.
+    };
+
+    /**
+     * @brief Quantized replicated_state, the unit deltas are taken in.
+     */
+    struct quantized_state
+    {
+        array<uint32_t, 3> position{}; /// Quantized coordinates.
+        uint32_t rotation = 0; /// Smallest three encoding.
+
+        bool operator==(const quantized_state& other) const;
+        bool operator!=(const quantized_state& other) const;
+    };
+
+    /**
+     * @class replication_server
+     * @brief Sends entity state to many clients, each packet delta compressed against what that client acknowledged.
+     *
+     * Every client has its own baseline per entity: the last state of it the client confirmed
+     * receiving. Entities whose quantized state matches the baseline cost nothing; the others
+     * are written as small per-axis deltas against the baseline, or in full when the client
+     * has none. A priority accumulator per client and entity grows every tick an entity waits,
+     * scaled by its priority and closeness to the client's focus, and the fullest accumulators
+     * are written first until the packet reaches the byte budget, so distant or unimportant
+     * entities still update, only less often.
+     *
+     * write_packet() only touches the state of its own client, so the packets of different
+     * clients can be written in parallel between calls that change entities.
+     */
+    class replication_server
+    {
+        struct entity_slot
+        {
+            quantized_state state; /// Current state.
+            float priority; /// Priority weight.
+            uint32_t generation; /// Incremented when the id is reused.
+            bool alive; /// Whether the id is in use.
+            point<float, 3> position; /// Unquantized position, for relevance.
+        };
+        struct acknowledged_state
+        {
+            quantized_state state; /// State the client confirmed.
+            uint32_t sequence = 0; /// Packet it came in, zero for none.
+            uint32_t generation = 0; /// Generation of the entity it belongs to.
+            bool present = false; /// Whether the client holds the entity.
+        };
+        struct sent_record
+        {
+            uint32_t id; /// Entity.
+            uint32_t generation; /// Generation of the entity.
+            bool removed; /// Whether the record removes the entity.
+            quantized_state state; /// State sent.
+        };
+        struct sent_packet
+        {
+            uint32_t sequence = 0; /// Sequence of the packet, zero for none.
+            bool acknowledged = false; /// Whether its acknowledgement was processed.
+            vector<sent_record> records; /// Entities it carried.
+        };
+        struct client_state
+        {
+            vector<acknowledged_state> baselines; /// Baseline per entity.
+            vector<float> accumulators; /// Priority accumulator per entity.
+            array<sent_packet, replication_history> sent; /// Recent packets by sequence.
+            point<float, 3> focus; /// Point of view, for relevance.
+            bool focused = false; /// Whether a focus was set.
+            vector<uint32_t> candidates; /// Scratch list of entities to send.
+        };
+
+        replication_settings settings_; /// Settings.
+        vector<entity_slot> entities_; /// Entities by id.
+        vector<uint32_t> free_ids_; /// Removed ids, reused last in first out.
+        vector<client_state> clients_; /// Clients.
+        uint32_t sequence_; /// Sequence of the next packets.
+
+        void acknowledge(client_state& client, uint32_t sequence);
+
+    public:
+        /**
+         * @brief Creates a server without entities or clients.
+         *
+         * @param settings Settings, shared with the clients.
+         * @throws invalid_argument If the settings are invalid.
+         */
+        explicit replication_server(const replication_settings& settings = {});
+
+        /**
+         * @brief Adds an entity.
+         *
+         * @param state Initial state.
+         * @param priority Priority weight; an entity of weight 2 is sent twice as often as one of weight 1.
+         * @return Id of the entity, the smallest free one.
+         * @throws runtime_error If max_replicated_entities are in use.
+         */
+        uint32_t add(const replicated_state& state, float priority = 1);
+
+        /**
+         * @brief Updates an entity.
+         *
+         * @param id The entity.
+         * @param state New state.
+         * @throws out_of_range If the entity does not exist.
+         */
+        void set(uint32_t id, const replicated_state& state);
+
+        /**
+         * @brief Removes an entity; clients holding it are told before anything else.
+         *
+         * @param id The entity.
+         * @throws out_of_range If the entity does not exist.
+         */
+        void remove(uint32_t id);
+
+        /**
+         * @brief Adds a client that holds nothing yet.
+         *
+         * @return Index of the client.
+         */
+        size_t add_client();
+
+        /**
+         * @brief Sets the point of view of a client; entities close to it get priority.
+         *
+         * @param client The client.
+         * @param focus Point of view.
+         * @throws out_of_range If the client does not exist.
+         */
+        void set_focus(size_t client, const point<float, 3>& focus);
+
+        /**
+         * @brief Starts the next tick; packets written afterwards get a new sequence.
+         */
+        void advance();
+
+        /**
+         * @brief Writes the packet of a client for the current tick.
+         *
+         * @param client The client.
+         * @param packet Receives the packet, at most bytes_per_tick long.
+         * @return Number of entities written.
+         * @throws out_of_range If the client does not exist.
+         */
+        size_t write_packet(size_t client, vector<unsigned char>& packet);
+
+        /**
+         * @brief Processes an acknowledgement written by replication_client::write_ack().
+         *
+         * @param client The client that sent it.
+         * @param data First byte of the acknowledgement.
+         * @param size Its size.
+         * @throws out_of_range If the client does not exist.
+         * @throws runtime_error If the acknowledgement is malformed.
+         */
+        void receive_ack(size_t client, const unsigned char* data, size_t size);
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t client_count() const;
+        [[nodiscard]] uint32_t sequence() const;
+        [[nodiscard]] const replication_settings& settings() const;
+    };
+
+    /**
+     * @class replication_client
+     * @brief Rebuilds the entities of a replication_server from its packets.
+     *
+     * Packets may arrive late, twice or not at all: the client keeps the last
+     * replication_history packets to resolve delta baselines, ignores anything older than the
+     * state it holds, and acknowledges every packet it stored.
+     */
+    class replication_client
+    {
+        struct received_record
+        {
+            uint32_t id; /// Entity.
+            bool removed; /// Whether the record removes the entity.
+            quantized_state state; /// State received.
+        };
+        struct received_packet
+        {
+            uint32_t sequence = 0; /// Sequence of the packet, zero for none.
+            vector<received_record> records; /// Entities it carried, sorted by id.
+        };
+
+        replication_settings settings_; /// Settings, shared with the server.
+        array<received_packet, replication_history> received_; /// Recent packets by sequence.
+        vector<received_record> decoded_; /// Scratch records of the packet being read.
+        vector<replica> replicas_; /// Entities by id.
+        uint32_t newest_; /// Newest sequence received.
+
+    public:
+        /**
+         * @brief Creates a client holding no entities.
+         *
+         * @param settings Settings, shared with the server.
+         * @throws invalid_argument If the settings are invalid.
+         */
+        explicit replication_client(const replication_settings& settings = {});
+
+        /**
+         * @brief Applies a packet written by replication_server::write_packet().
+         *
+         * A malformed packet changes nothing.
+         *
+         * @param data First byte of the packet.
+         * @param size Its size.
+         * @return False if the packet was a duplicate or too old to use.
+         * @throws runtime_error If the packet is malformed or its baseline is unknown.
+         */
+        bool receive(const unsigned char* data, size_t size);
+
+        /**
+         * @brief Writes the acknowledgement of the newest packet and the ones before it.
+         *
+         * @param packet Receives the acknowledgement.
+         */
+        void write_ack(vector<unsigned char>& packet) const;
+
+        [[nodiscard]] const vector<replica>& replicas() const;
+        [[nodiscard]] uint32_t newest_sequence() const;
+    };
+} // engine_lib
+
+#endif //REPLICATION_HPP
@@ -0,0 +1,235 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "udp_socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace engine_lib
+{
+    namespace
+    {
+        constexpr intptr_t no_socket(-1);
+        constexpr size_t largest_datagram(65536);
+
+        int last_error()
+        {
+#if defined(_WIN32)
+            return WSAGetLastError();
+#else
+            return errno;
+#endif
+        }
+
+        bool would_block(int code)
+        {
+#if defined(_WIN32)
+            return code == WSAEWOULDBLOCK;
+#else
+            return code == EAGAIN || code == EWOULDBLOCK || code == ENOBUFS;
+#endif
+        }
+
+        // the ICMP port unreachable of an earlier datagram, reported on a later call
+        bool refused(int code)
+        {
+#if defined(_WIN32)
+            return code == WSAECONNRESET;
+#else
+            return code == ECONNREFUSED;
+#endif
+        }
+
+        string error_text(int code)
+        {
+#if defined(_WIN32)
+            return "socket error " + to_string(code);
+#else
+            return strerror(code);
+#endif
+        }
+
+        void close_socket(intptr_t handle)
+        {
+#if defined(_WIN32)
+            closesocket(SOCKET(handle));
+#else
+            ::close(int(handle));
+#endif
+        }
+
+        sockaddr_in native_address(const udp_address& address)
+        {
+            sockaddr_in native{};
+            native.sin_family = AF_INET;
+            native.sin_addr.s_addr = htonl(address.host);
+            native.sin_port = htons(address.port);
+            return native;
+        }
+
+#if defined(_WIN32)
+        // WSAStartup is reference counted; one call for the life of the process is enough
+        void start_winsock()
+        {
+            static const bool started([]
+            {
+                WSADATA data;
+                return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+            }());
+            if (!started)
+                throw runtime_error("Cannot start Winsock");
+        }
+#endif
+    }
+
+    bool udp_address::operator==(const udp_address& other) const
+    {
+        return host == other.host && port == other.port;
+    }
+
+    bool udp_address::operator!=(const udp_address& other) const
+    {
+        return !(*this == other);
+    }
+
+    udp_socket::udp_socket(uint16_t port, size_t buffer_size) : handle_(no_socket)
+    {
+#if defined(_WIN32)
+        start_winsock();
+        const SOCKET native(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+        if (native == INVALID_SOCKET)
+            throw runtime_error("Cannot open a UDP socket: " + error_text(last_error()));
+        handle_ = intptr_t(native);
+        u_long non_blocking(1);
+        const bool configured(ioctlsocket(native, FIONBIO, &non_blocking) == 0);
+#else
+        const int native(socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP));
+        if (native < 0)
+            throw runtime_error("Cannot open a UDP socket: " + error_text(last_error()));
+        handle_ = native;
+        const bool configured(fcntl(native, F_SETFL, fcntl(native, F_GETFL) | O_NONBLOCK) == 0);
+#endif
+        if (!configured)
+        {
+            const int code(last_error());
+            close_socket(handle_);
+            throw runtime_error("Cannot make a UDP socket non-blocking: " + error_text(code));
+        }
+        if (buffer_size != 0)
+        {
+            const int bytes(static_cast<int>(buffer_size));
+            setsockopt(native, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bytes), sizeof(bytes));
+            setsockopt(native, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&bytes), sizeof(bytes));
+        }
+
+        udp_address requested;
+        requested.port = port;
+        sockaddr_in bound(native_address(requested));
+        socklen_t length(sizeof(bound));
+        if (bind(native, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound)) != 0 ||
+            getsockname(native, reinterpret_cast<sockaddr*>(&bound), &length) != 0)
+        {
+            const int code(last_error());
+            close_socket(handle_);
+            throw runtime_error("Cannot bind a UDP socket to port " + to_string(port) + ": " + error_text(code));
+        }
+        local_.host = ntohl(bound.sin_addr.s_addr);
+        local_.port = ntohs(bound.sin_port);
+    }
+
+    udp_socket::udp_socket(udp_socket&& other) noexcept
+        : handle_(exchange(other.handle_, no_socket)), local_(other.local_)
+    {
+    }
+
+    udp_socket& udp_socket::operator=(udp_socket&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_ != no_socket)
+                close_socket(handle_);
+            handle_ = exchange(other.handle_, no_socket);
+            local_ = other.local_;
+        }
+        return *this;
+    }
+
+    udp_socket::~udp_socket()
+    {
+        if (handle_ != no_socket)
+            close_socket(handle_);
+    }
+
+    bool udp_socket::send(const udp_address& to, const unsigned char* data, size_t size)
+    {
+        const sockaddr_in target(native_address(to));
+#if defined(_WIN32)
+        const int sent(sendto(SOCKET(handle_), reinterpret_cast<const char*>(data), int(size), 0,
+                              reinterpret_cast<const sockaddr*>(&target), sizeof(target)));
+#else
+        const ssize_t sent(sendto(int(handle_), data, size, 0, reinterpret_cast<const sockaddr*>(&target),
+                                  sizeof(target)));
+#endif
+        if (sent >= 0)
+            return true;
+        const int code(last_error());
+        if (would_block(code) || refused(code))
+            return false;
+        throw runtime_error("Cannot send a datagram: " + error_text(code));
+    }
+
+    bool udp_socket::receive(vector<unsigned char>& packet, udp_address& from)
+    {
+        packet.resize(largest_datagram);
+        sockaddr_in sender{};
+        socklen_t length(sizeof(sender));
+        while (true)
+        {
+#if defined(_WIN32)
+            const int received(recvfrom(SOCKET(handle_), reinterpret_cast<char*>(packet.data()), int(packet.size()),
+                                        0, reinterpret_cast<sockaddr*>(&sender), &length));
+#else
+            const ssize_t received(recvfrom(int(handle_), packet.data(), packet.size(), 0,
+                                            reinterpret_cast<sockaddr*>(&sender), &length));
+#endif
+            if (received >= 0)
+            {
+                packet.resize(size_t(received));
+                from.host = ntohl(sender.sin_addr.s_addr);
+                from.port = ntohs(sender.sin_port);
+                return true;
+            }
+            const int code(last_error());
+            if (code == EINTR || refused(code))
+                continue;
+            if (would_block(code))
+            {
+                packet.clear();
+                return false;
+            }
+            throw runtime_error("Cannot receive a datagram: " + error_text(code));
+        }
+    }
+
+    const udp_address& udp_socket::local_address() const
+    {
+        return local_;
+    }
+} // engine_lib
@@ -0,0 +1,86 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef UDP_SOCKET_HPP
+#define UDP_SOCKET_HPP
+#include "../../includes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief IPv4 address and port, both in host byte order.
+     */
+    struct udp_address
+    {
+        uint32_t host = 0x7F000001; /// Address, 127.0.0.1 by default.
+        uint16_t port = 0; /// Port.
+
+        bool operator==(const udp_address& other) const;
+        bool operator!=(const udp_address& other) const;
+    };
+
+    /**
+     * @class udp_socket
+     * @brief Non-blocking IPv4 datagram socket bound to the loopback interface.
+     *
+     * Sending and receiving never wait: a full send buffer drops the datagram and an empty
+     * receive queue reports nothing, which is what a game loop polling once per tick wants.
+     */
+    class udp_socket
+    {
+        intptr_t handle_; /// Native socket, -1 once moved from.
+        udp_address local_; /// Bound address.
+
+    public:
+        /// Largest payload of one datagram that is not fragmented on a typical 1500 byte MTU.
+        static constexpr size_t safe_payload = 1200;
+
+        /**
+         * @brief Opens a socket bound to 127.0.0.1.
+         *
+         * @param port Port to bind, zero lets the system pick a free one.
+         * @param buffer_size Send and receive buffer size in bytes, zero keeps the system default.
+         * @throws runtime_error If the socket cannot be opened or bound.
+         */
+        explicit udp_socket(uint16_t port = 0, size_t buffer_size = 0);
+
+        udp_socket(const udp_socket&) = delete;
+        udp_socket& operator=(const udp_socket&) = delete;
+        udp_socket(udp_socket&& other) noexcept;
+        udp_socket& operator=(udp_socket&& other) noexcept;
+        ~udp_socket();
+
+        /**
+         * @brief Sends one datagram.
+         *
+         * @param to Receiver.
+         * @param data First byte of the payload.
+         * @param size Payload size.
+         * @return False if the datagram was dropped because the send buffer is full.
+         * @throws runtime_error On any other error.
+         */
+        bool send(const udp_address& to, const unsigned char* data, size_t size);
+
+        /**
+         * @brief Takes the next pending datagram.
+         *
+         * @param packet Receives the payload, resized to it.
+         * @param from Receives the sender.
+         * @return False if no datagram is pending.
+         * @throws runtime_error On any other error.
+         */
+        bool receive(vector<unsigned char>& packet, udp_address& from);
+
+        [[nodiscard]] const udp_address& local_address() const;
+    };
+} // engine_lib
+
+#endif //UDP_SOCKET_HPP
@@ -0,0 +1,364 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "particle_system.hpp"
+
+#include "../../math/simd/float_pack.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine_lib
+{
+    namespace
+    {
+        // a multiple of every pack width, and small enough for the eight arrays to stay in L2
+        constexpr size_t chunk_size(4096);
+
+        size_t padded(size_t count)
+        {
+            return (count + native_float_width - 1) / native_float_width * native_float_width;
+        }
+
+        // slides the live prefix of every chunk down to the end of the previous one
+        template <class Move>
+        size_t join_chunks(const vector<size_t>& chunk_sizes, Move&& move_range)
+        {
+            size_t cursor(0);
+            for (size_t chunk(0); chunk < chunk_sizes.size(); ++chunk)
+            {
+                const size_t first(chunk * chunk_size);
+                if (cursor != first && chunk_sizes[chunk] > 0)
+                    move_range(first, cursor, chunk_sizes[chunk]);
+                cursor += chunk_sizes[chunk];
+            }
+            return cursor;
+        }
+    }
+
+    particle_system::particle_system(size_t capacity, particle_forces forces, uint64_t seed)
+        : capacity_(capacity),
+          size_(0),
+          age_(padded(capacity)),
+          lifetime_(padded(capacity)),
+          forces_(move(forces)),
+          random_state_(seed)
+    {
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            position_[axis].resize(padded(capacity));
+            velocity_[axis].resize(padded(capacity));
+        }
+    }
+
+    float particle_system::next_random()
+    {
+        // splitmix64, mapped to [0, 1)
+        uint64_t value(random_state_ += 0x9E3779B97F4A7C15ull);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        value ^= value >> 31;
+        return float(value >> 40) * (1.0f / float(1u << 24));
+    }
+
+    array<float, 3> particle_system::random_in_ball(float radius)
+    {
+        if (radius <= 0)
+            return {0, 0, 0};
+        for (;;)
+        {
+            const array<float, 3> candidate{2 * next_random() - 1, 2 * next_random() - 1, 2 * next_random() - 1};
+            if (candidate[0] * candidate[0] + candidate[1] * candidate[1] + candidate[2] * candidate[2] <= 1)
+                return {candidate[0] * radius, candidate[1] * radius, candidate[2] * radius};
+        }
+    }
+
+    size_t particle_system::add_emitter(const particle_emitter& source)
+    {
+        emitters_.push_back(source);
+        emission_debt_.push_back(0);
+        return emitters_.size() - 1;
+    }
+
+    particle_emitter& particle_system::get_emitter(size_t index)
+    {
+        return emitters_.at(index);
+    }
+
+    void particle_system::set_forces(particle_forces forces)
+    {
+        forces_ = move(forces);
+    }
+
+    bool particle_system::emit(const point<float, 3>& position, const direction<float, 3>& velocity, float lifetime)
+    {
+        if (size_ == capacity_)
+            return false;
+        const array<float, 3> v(velocity.get_coordinates());
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            position_[axis][size_] = position.coordinate(axis);
+            velocity_[axis][size_] = v[axis];
+        }
+        age_[size_] = 0;
+        lifetime_[size_] = lifetime;
+        ++size_;
+        return true;
+    }
+
+    void particle_system::update(float dt, thread_pool& pool)
+    {
+        using pack = native_float_pack;
+        const pack step(dt), damping(max(0.0f, 1.0f - forces_.drag * dt)), softening(forces_.softening);
+        const array<float, 3> gravity(forces_.gravity.get_coordinates());
+        const array<pack, 3> gravity_step{pack(gravity[0] * dt), pack(gravity[1] * dt), pack(gravity[2] * dt)};
+        vector<array<pack, 4>> attractors;
+        for (const particle_attractor& attractor : forces_.attractors)
+            attractors.push_back({pack(attractor.position.coordinate(0)), pack(attractor.position.coordinate(1)),
+                                  pack(attractor.position.coordinate(2)), pack(attractor.strength * dt)});
+
+        // integrate every chunk, then pack its live particles to the front of the chunk
+        chunk_sizes_.assign((size_ + chunk_size - 1) / chunk_size, 0);
+        pool.parallel_for(0, size_, chunk_size, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; i += pack::width)
+            {
+                array<pack, 3> p, v;
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    p[axis] = pack::load(&position_[axis][i]);
+                    v[axis] = pack::load(&velocity_[axis][i]) * damping + gravity_step[axis];
+                }
+                for (const array<pack, 4>& attractor : attractors)
+                {
+                    const array<pack, 3> d{attractor[0] - p[0], attractor[1] - p[1], attractor[2] - p[2]};
+                    const pack r2(d[0] * d[0] + d[1] * d[1] + d[2] * d[2] + softening);
+                    const pack pull(attractor[3] / (r2 * sqrt(r2)));
+                    for (size_t axis(0); axis < 3; ++axis)
+                        v[axis] = mul_add(d[axis], pull, v[axis]);
+                }
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    v[axis].store(&velocity_[axis][i]);
+                    mul_add(v[axis], step, p[axis]).store(&position_[axis][i]);
+                }
+                (pack::load(&age_[i]) + step).store(&age_[i]);
+            }
+
+            size_t alive(first);
+            for (size_t i(first); i < last; ++i)
+            {
+                if (!(age_[i] < lifetime_[i]))
+                    continue;
+                if (alive != i)
+                {
+                    for (size_t axis(0); axis < 3; ++axis)
+                    {
+                        position_[axis][alive] = position_[axis][i];
+                        velocity_[axis][alive] = velocity_[axis][i];
+                    }
+                    age_[alive] = age_[i];
+                    lifetime_[alive] = lifetime_[i];
+                }
+                ++alive;
+            }
+            chunk_sizes_[first / chunk_size] = alive - first;
+        });
+
+        size_ = join_chunks(chunk_sizes_, [&](size_t from, size_t to, size_t count)
+        {
+            for (aligned_vector<float>* values : {&position_[0], &position_[1], &position_[2], &velocity_[0], &velocity_[1],
+                                                  &velocity_[2], &age_, &lifetime_})
+                memmove(values->data() + to, values->data() + from, count * sizeof(float));
+        });
+
+        for (size_t e(0); e < emitters_.size(); ++e)
+        {
+            const particle_emitter& source(emitters_[e]);
+            emission_debt_[e] += source.rate * dt;
+            const array<float, 3> velocity(source.velocity.get_coordinates());
+            for (; emission_debt_[e] >= 1 && size_ < capacity_; emission_debt_[e] -= 1)
+            {
+                const array<float, 3> offset(random_in_ball(source.position_spread));
+                const array<float, 3> jitter(random_in_ball(source.velocity_spread));
+                array<float, 3> position;
+                for (size_t axis(0); axis < 3; ++axis)
+                    position[axis] = source.position.coordinate(axis) + offset[axis];
+                emit(point<float, 3>(position),
+                     direction<float, 3>(array<float, 3>{velocity[0] + jitter[0], velocity[1] + jitter[1],
+                                                         velocity[2] + jitter[2]}),
+                     source.lifetime + source.lifetime_spread * (2 * next_random() - 1));
+            }
+            // a full pool drops the backlog instead of bursting when space frees up
+            emission_debt_[e] = min(emission_debt_[e], 1.0f);
+        }
+    }
+
+    void particle_system::project(const matrix<float, 4, 4>& view_projection, float width, float height,
+                                  vector<array<float, 2>>& screen, thread_pool& pool) const
+    {
+        using pack = native_float_pack;
+        const matrix<float, 4, 4>& m(view_projection);
+        array<array<pack, 4>, 4> rows;
+        for (size_t r(0); r < 4; ++r)
+            for (size_t c(0); c < 4; ++c)
+                rows[r][c] = pack(m(r, c));
+        const pack half_width(0.5f * width), half_height(0.5f * height), zero(0.0f), one(1.0f);
+
+        screen.resize(padded(size_));
+        vector<size_t> chunk_sizes((size_ + chunk_size - 1) / chunk_size, 0);
+        pool.parallel_for(0, size_, chunk_size, [&](size_t first, size_t last)
+        {
+            size_t visible(first);
+            alignas(64) array<float, pack::width> xs, ys;
+            for (size_t i(first); i < last; i += pack::width)
+            {
+                const pack x(pack::load(&position_[0][i])), y(pack::load(&position_[1][i])),
+                           z(pack::load(&position_[2][i]));
+                array<pack, 4> clip;
+                for (size_t r(0); r < 4; ++r)
+                    clip[r] = mul_add(rows[r][0], x, mul_add(rows[r][1], y, mul_add(rows[r][2], z, rows[r][3])));
+
+                // inside the frustum: w > 0 and |x|, |y|, |z| <= w
+                const pack inside((clip[3] > zero) & (abs(clip[0]) <= clip[3]) & (abs(clip[1]) <= clip[3]) &
+                                  (abs(clip[2]) <= clip[3]));
+                const pack inverse_w(one / select(inside, clip[3], one));
+                mul_add(clip[0] * inverse_w, half_width, half_width).store(xs.data());
+                (half_height - clip[1] * inverse_w * half_height).store(ys.data());
+
+                const unsigned mask(inside.mask_bits());
+                for (size_t lane(0); lane < pack::width && i + lane < last; ++lane)
+                    if ((mask >> lane) & 1u)
+                        screen[visible++] = {xs[lane], ys[lane]};
+            }
+            chunk_sizes[first / chunk_size] = visible - first;
+        });
+
+        const size_t visible(join_chunks(chunk_sizes, [&](size_t from, size_t to, size_t count)
+        {
+            memmove(screen.data() + to, screen.data() + from, count * sizeof(array<float, 2>));
+        }));
+        screen.resize(visible);
+    }
+
+    void particle_system::save(snapshot_writer& out) const
+    {
+        out.write(uint64_t(capacity_));
+        out.write(uint64_t(size_));
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            out.write_span(position_[axis].data(), size_);
+            out.write_span(velocity_[axis].data(), size_);
+        }
+        out.write_span(age_.data(), size_);
+        out.write_span(lifetime_.data(), size_);
+
+        out.write(uint64_t(emitters_.size()));
+        for (const particle_emitter& source : emitters_)
+        {
+            out.write(source.position);
+            out.write(source.position_spread);
+            out.write(source.velocity);
+            out.write(source.velocity_spread);
+            out.write(source.rate);
+            out.write(source.lifetime);
+            out.write(source.lifetime_spread);
+        }
+        out.write(emission_debt_);
+
+        out.write(forces_.gravity);
+        out.write(forces_.drag);
+        out.write(forces_.softening);
+        out.write(uint64_t(forces_.attractors.size()));
+        for (const particle_attractor& attractor : forces_.attractors)
+        {
+            out.write(attractor.position);
+            out.write(attractor.strength);
+        }
+        out.write(random_state_);
+    }
+
+    void particle_system::load(snapshot_reader& in)
+    {
+        const auto capacity(size_t(in.get<uint64_t>()));
+        const auto size(size_t(in.get<uint64_t>()));
+        if (size > capacity)
+            throw runtime_error("Particle snapshot holds more particles than its capacity");
+        if (capacity != capacity_)
+        {
+            capacity_ = capacity;
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                position_[axis].resize(padded(capacity));
+                velocity_[axis].resize(padded(capacity));
+            }
+            age_.resize(padded(capacity));
+            lifetime_.resize(padded(capacity));
+        }
+        size_ = size;
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            in.read_span(position_[axis].data(), size_);
+            in.read_span(velocity_[axis].data(), size_);
+        }
+        in.read_span(age_.data(), size_);
+        in.read_span(lifetime_.data(), size_);
+
+        emitters_.resize(size_t(in.get<uint64_t>()));
+        for (particle_emitter& source : emitters_)
+        {
+            in.read(source.position);
+            in.read(source.position_spread);
+            in.read(source.velocity);
+            in.read(source.velocity_spread);
+            in.read(source.rate);
+            in.read(source.lifetime);
+            in.read(source.lifetime_spread);
+        }
+        in.read(emission_debt_);
+
+        in.read(forces_.gravity);
+        in.read(forces_.drag);
+        in.read(forces_.softening);
+        forces_.attractors.resize(size_t(in.get<uint64_t>()));
+        for (particle_attractor& attractor : forces_.attractors)
+        {
+            in.read(attractor.position);
+            in.read(attractor.strength);
+        }
+        in.read(random_state_);
+    }
+
+    size_t particle_system::size() const
+    {
+        return size_;
+    }
+
+    size_t particle_system::capacity() const
+    {
+        return capacity_;
+    }
+
+    const float* particle_system::positions(size_t axis) const
+    {
+        return position_.at(axis).data();
+    }
+
+    const float* particle_system::velocities(size_t axis) const
+    {
+        return velocity_.at(axis).data();
+    }
+
+    const float* particle_system::ages() const
+    {
+        return age_.data();
+    }
+
+    const float* particle_system::lifetimes() const
+    {
+        return lifetime_.data();
+    }
+} // engine_lib
@@ -0,0 +1,172 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+#include "../../includes.hpp"
+#include "../../containers/aligned_allocator/aligned_allocator.hpp"
+#include "../../io/state_snapshot/state_snapshot.hpp"
+#include "../../math/direction/direction.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Continuous source of particles.
+     */
+    struct particle_emitter
+    {
+        point<float, 3> position; /// Where particles appear.
+        float position_spread = 0; /// Radius of the ball particles appear in.
+        direction<float, 3> velocity; /// Mean initial velocity.
+        float velocity_spread = 0; /// Radius of the ball of random velocity added.
+        float rate = 0; /// Particles per second.
+        float lifetime = 1; /// Mean lifetime in seconds.
+        float lifetime_spread = 0; /// Largest deviation from the mean lifetime.
+    };
+
+    /**
+     * @brief Point that pulls particles with inverse square falloff.
+     */
+    struct particle_attractor
+    {
+        point<float, 3> position; /// Center of the pull.
+        float strength = 0; /// Acceleration at unit distance, negative to repel.
+    };
+
+    /**
+     * @brief Forces acting on every particle.
+     */
+    struct particle_forces
+    {
+        direction<float, 3> gravity{array<float, 3>{0, -9.81f, 0}}; /// Constant acceleration.
+        float drag = 0; /// Velocity lost per second, as a fraction.
+        float softening = 0.01f; /// Added to squared attractor distances to bound the pull.
+        vector<particle_attractor> attractors; /// Point attractors.
+    };
+
+    /**
+     * @class particle_system
+     * @brief Fixed-capacity particle pool stored as structure of arrays.
+     *
+     * update() integrates the forces with native float packs, chunk by chunk on the thread
+     * pool, and removes expired particles by sliding the live ones together, so the pool never
+     * reallocates. The order of the live particles is kept, and the emitters draw from a
+     * seeded generator, so a run is reproducible for any thread count.
+     */
+    class particle_system
+    {
+        size_t capacity_; /// Most particles alive at once.
+        size_t size_; /// Particles alive.
+        array<aligned_vector<float>, 3> position_; /// Position per axis.
+        array<aligned_vector<float>, 3> velocity_; /// Velocity per axis.
+        aligned_vector<float> age_; /// Seconds since emission.
+        aligned_vector<float> lifetime_; /// Seconds until expiry.
+        vector<size_t> chunk_sizes_; /// Live particles per chunk after the last update.
+        vector<particle_emitter> emitters_; /// Emitters.
+        vector<float> emission_debt_; /// Fractional particles owed by every emitter.
+        particle_forces forces_; /// Forces.
+        uint64_t random_state_; /// State of the emission generator.
+
+        float next_random();
+        array<float, 3> random_in_ball(float radius);
+
+    public:
+        /**
+         * @brief Creates an empty system.
+         *
+         * @param capacity Most particles alive at once.
+         * @param forces Forces acting on the particles.
+         * @param seed Seed of the emission generator.
+         */
+        explicit particle_system(size_t capacity, particle_forces forces = {}, uint64_t seed = 0);
+
+        /**
+         * @brief Adds an emitter.
+         *
+         * @param source The emitter.
+         * @return Index of the emitter.
+         */
+        size_t add_emitter(const particle_emitter& source);
+
+        /**
+         * @brief Gives access to an emitter, to move it or change its rate.
+         *
+         * @param index Index of the emitter.
+         * @return The emitter.
+         * @throws out_of_range If the emitter does not exist.
+         */
+        particle_emitter& get_emitter(size_t index);
+
+        /**
+         * @brief Replaces the forces.
+         *
+         * @param forces The forces.
+         */
+        void set_forces(particle_forces forces);
+
+        /**
+         * @brief Adds a single particle.
+         *
+         * @param position Initial position.
+         * @param velocity Initial velocity.
+         * @param lifetime Seconds until expiry.
+         * @return False if the system is full.
+         */
+        bool emit(const point<float, 3>& position, const direction<float, 3>& velocity, float lifetime);
+
+        /**
+         * @brief Advances every particle, removes the expired ones, then runs the emitters.
+         *
+         * @param dt Time step in seconds.
+         * @param pool Pool integrating the chunks.
+         */
+        void update(float dt, thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Projects the particles to pixel coordinates, dropping those outside the view.
+         *
+         * @param view_projection Transformation of column vectors from world to clip space.
+         * @param width Viewport width in pixels.
+         * @param height Viewport height in pixels.
+         * @param screen Receives (x, y) per visible particle, y pointing down.
+         * @param pool Pool projecting the chunks.
+         */
+        void project(const matrix<float, 4, 4>& view_projection, float width, float height,
+                     vector<array<float, 2>>& screen, thread_pool& pool = thread_pool::global()) const;
+
+        /**
+         * @brief Writes the whole state to a snapshot: live particles, emitters, forces and generator.
+         *
+         * @param out The snapshot.
+         */
+        void save(snapshot_writer& out) const;
+
+        /**
+         * @brief Restores a state written by save(), capacity included.
+         *
+         * @param in The snapshot.
+         * @throws out_of_range If the snapshot ends early.
+         * @throws runtime_error If the snapshot holds more particles than its capacity.
+         */
+        void load(snapshot_reader& in);
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t capacity() const;
+        [[nodiscard]] const float* positions(size_t axis) const;
+        [[nodiscard]] const float* velocities(size_t axis) const;
+        [[nodiscard]] const float* ages() const;
+        [[nodiscard]] const float* lifetimes() const;
+    };
+} // engine_lib
+
+#endif //PARTICLE_SYSTEM_HPP
@@ -0,0 +1,474 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "rigid_body.hpp"
+
+#include "../../math/simd/float_pack.hpp"
+#include "../../math/vector3/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace engine_lib
+{
+    namespace
+    {
+        using vec3 = array<float, 3>;
+
+        constexpr size_t integration_grain(4096);
+
+        vec3 multiply(const array<float, 9>& m, const vec3& v)
+        {
+            return {m[0] * v[0] + m[1] * v[1] + m[2] * v[2], m[3] * v[0] + m[4] * v[1] + m[5] * v[2],
+                    m[6] * v[0] + m[7] * v[1] + m[8] * v[2]};
+        }
+
+        uint32_t find_root(vector<uint32_t>& parent, uint32_t body)
+        {
+            while (parent[body] != body)
+            {
+                parent[body] = parent[parent[body]];
+                body = parent[body];
+            }
+            return body;
+        }
+    }
+
+    rigid_body solid_sphere(const point<float, 3>& center, float radius, float mass)
+    {
+        rigid_body body;
+        body.position = center;
+        body.mass = mass;
+        body.radius = radius;
+        const float moment(0.4f * mass * radius * radius);
+        body.inertia = matrix3x3<float>(array<array<float, 3>, 3>{{{moment, 0, 0}, {0, moment, 0}, {0, 0, moment}}});
+        return body;
+    }
+
+    rigid_body_world::rigid_body_world(const physics_settings& settings)
+        : settings_(settings),
+          body_count_(0),
+          broadphase_(1.0f),
+          max_radius_(0)
+    {
+    }
+
+    size_t rigid_body_world::add_body(const rigid_body& body)
+    {
+        if (!(body.mass >= 0) || !(body.radius >= 0))
+            throw invalid_argument("Mass and radius must not be negative");
+
+        array<float, 9> inverse_inertia{};
+        if (body.mass > 0)
+        {
+            if (!(body.inertia.determinant() > 0))
+                throw invalid_argument("Inertia tensor of a dynamic body must be invertible");
+            const matrix<float, 3, 3> inverse(body.inertia.inverted_matrix());
+            for (size_t row(0); row < 3; ++row)
+                for (size_t column(0); column < 3; ++column)
+                    inverse_inertia[3 * row + column] = inverse(row, column);
+        }
+
+        // grow by whole packs; the padding bodies are static, at rest and never collide
+        if (body_count_ == inverse_mass_.size())
+        {
+            const size_t padded(body_count_ + native_float_width);
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                position_[axis].resize(padded, 0);
+                velocity_[axis].resize(padded, 0);
+                angular_velocity_[axis].resize(padded, 0);
+            }
+            orientation_[0].resize(padded, 1);
+            for (size_t component(1); component < 4; ++component)
+                orientation_[component].resize(padded, 0);
+            inverse_mass_.resize(padded, 0);
+            radius_.resize(padded, 0);
+        }
+
+        const size_t index(body_count_++);
+        const array<float, 3> velocity(body.velocity.get_coordinates());
+        const array<float, 3> angular_velocity(body.angular_velocity.get_coordinates());
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            position_[axis][index] = body.position.coordinate(axis);
+            velocity_[axis][index] = velocity[axis];
+            angular_velocity_[axis][index] = angular_velocity[axis];
+        }
+        const float length(sqrt(body.orientation[0] * body.orientation[0] + body.orientation[1] * body.orientation[1] +
+                                body.orientation[2] * body.orientation[2] + body.orientation[3] * body.orientation[3]));
+        for (size_t component(0); component < 4; ++component)
+            orientation_[component][index] = length > 0 ? body.orientation[component] / length : component == 0;
+        inverse_mass_[index] = body.mass > 0 ? 1 / body.mass : 0;
+        radius_[index] = body.radius;
+        inertia_.push_back(body.inertia);
+        inverse_inertia_.push_back(inverse_inertia);
+        world_inverse_inertia_.push_back(inverse_inertia);
+        max_radius_ = max(max_radius_, body.radius);
+        return index;
+    }
+
+    void rigid_body_world::add_plane(const point<float, 3>& on_plane, const array<float, 3>& normal)
+    {
+        const float length(sqrt(dot(normal, normal)));
+        if (!(length > 0))
+            throw invalid_argument("Plane normal must not be zero");
+        const vec3 unit(scale(normal, 1 / length));
+        planes_.push_back({unit, dot(unit, on_plane.get_coordinates())});
+    }
+
+    rigid_body rigid_body_world::get_body(size_t index) const
+    {
+        if (index >= body_count_)
+            throw out_of_range("Body index out of range");
+
+        rigid_body body;
+        body.position = point<float, 3>(array<float, 3>{position_[0][index], position_[1][index], position_[2][index]});
+        body.orientation = {orientation_[0][index], orientation_[1][index], orientation_[2][index], orientation_[3][index]};
+        body.velocity = direction<float, 3>(array<float, 3>{velocity_[0][index], velocity_[1][index], velocity_[2][index]});
+        body.angular_velocity = direction<float, 3>(
+            array<float, 3>{angular_velocity_[0][index], angular_velocity_[1][index], angular_velocity_[2][index]});
+        body.mass = inverse_mass_[index] > 0 ? 1 / inverse_mass_[index] : 0;
+        body.inertia = inertia_[index];
+        body.radius = radius_[index];
+        return body;
+    }
+
+    void rigid_body_world::set_velocity(size_t index, const direction<float, 3>& velocity,
+                                        const direction<float, 3>& angular_velocity)
+    {
+        if (index >= body_count_)
+            throw out_of_range("Body index out of range");
+        const array<float, 3> linear(velocity.get_coordinates()), angular(angular_velocity.get_coordinates());
+        for (size_t axis(0); axis < 3; ++axis)
+        {
+            velocity_[axis][index] = linear[axis];
+            angular_velocity_[axis][index] = angular[axis];
+        }
+    }
+
+    void rigid_body_world::integrate_velocities(float dt, thread_pool& pool)
+    {
+        using pack = native_float_pack;
+        const pack zero(0.0f);
+        const array<pack, 3> gravity_step{pack(settings_.gravity[0] * dt), pack(settings_.gravity[1] * dt),
+                                          pack(settings_.gravity[2] * dt)};
+        pool.parallel_for(0, inverse_mass_.size(), integration_grain, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; i += pack::width)
+            {
+                const pack dynamic(pack::load(&inverse_mass_[i]) > zero);
+                for (size_t axis(0); axis < 3; ++axis)
+                    (pack::load(&velocity_[axis][i]) + select(dynamic, gravity_step[axis], zero)).store(&velocity_[axis][i]);
+            }
+        });
+    }
+
+    void rigid_body_world::integrate_positions(float dt, thread_pool& pool)
+    {
+        using pack = native_float_pack;
+        const pack step(dt), half_step(0.5f * dt);
+        pool.parallel_for(0, inverse_mass_.size(), integration_grain, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; i += pack::width)
+            {
+                array<pack, 3> w;
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    w[axis] = pack::load(&angular_velocity_[axis][i]);
+                    mul_add(pack::load(&velocity_[axis][i]), step, pack::load(&position_[axis][i]))
+                        .store(&position_[axis][i]);
+                }
+
+                // q += dt / 2 * (0, w) * q, then back onto the unit sphere
+                const pack qw(pack::load(&orientation_[0][i])), qx(pack::load(&orientation_[1][i])),
+                           qy(pack::load(&orientation_[2][i])), qz(pack::load(&orientation_[3][i]));
+                const array<pack, 4> q{
+                    qw - half_step * (w[0] * qx + w[1] * qy + w[2] * qz),
+                    qx + half_step * (qw * w[0] + w[1] * qz - w[2] * qy),
+                    qy + half_step * (qw * w[1] + w[2] * qx - w[0] * qz),
+                    qz + half_step * (qw * w[2] + w[0] * qy - w[1] * qx)};
+                const pack inverse_length(pack(1.0f) / sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]));
+                for (size_t component(0); component < 4; ++component)
+                    (q[component] * inverse_length).store(&orientation_[component][i]);
+            }
+        });
+    }
+
+    void rigid_body_world::find_contacts(float dt, thread_pool& pool)
+    {
+        // impulses of the last step seed the solver where the same bodies still touch;
+        // plane contacts count planes down from no_body, so every plane keeps its own impulses
+        auto key_of = [](const contact& touching)
+        {
+            return uint64_t(touching.a) << 32 | (touching.b == no_body ? no_body - touching.plane : touching.b);
+        };
+        unordered_map<uint64_t, const contact*> previous;
+        previous.reserve(contacts_.size());
+        for (const contact& touching : contacts_)
+            previous.emplace(key_of(touching), &touching);
+        vector<contact> last_step(move(contacts_));
+        contacts_.clear();
+        const float bias_rate(settings_.baumgarte / dt);
+        auto position_of = [&](uint32_t body)
+        {
+            return vec3{position_[0][body], position_[1][body], position_[2][body]};
+        };
+        auto add_contact = [&](uint32_t a, uint32_t b, uint32_t plane, const vec3& normal, const vec3& offset_a,
+                               const vec3& offset_b, float penetration)
+        {
+            // orthonormal basis of Duff et al. around the normal
+            const float sign(copysign(1.0f, normal[2]));
+            const float p(-1.0f / (sign + normal[2]));
+            const float q(normal[0] * normal[1] * p);
+            contact touching{};
+            touching.a = a;
+            touching.b = b;
+            touching.plane = plane;
+            touching.axes = {normal, vec3{1.0f + sign * normal[0] * normal[0] * p, sign * q, -sign * normal[0]},
+                             vec3{q, sign + normal[1] * normal[1] * p, -normal[1]}};
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                touching.arms_a[axis] = cross(offset_a, touching.axes[axis]);
+                touching.arms_b[axis] = cross(offset_b, touching.axes[axis]);
+            }
+            touching.bias = bias_rate * max(penetration - settings_.penetration_slop, 0.0f);
+            contacts_.push_back(touching);
+        };
+
+        if (max_radius_ > 0)
+        {
+            if (broadphase_.cell_size() != 2 * max_radius_)
+                broadphase_ = spatial_hash(2 * max_radius_);
+            vector<point<float, 3>> centers(body_count_);
+            for (size_t i(0); i < body_count_; ++i)
+                centers[i] = point<float, 3>(position_of(uint32_t(i)));
+            broadphase_.build(centers, pool);
+
+            for (const auto& [a, b] : broadphase_.find_pairs(2 * max_radius_, pool))
+            {
+                if (inverse_mass_[a] == 0 && inverse_mass_[b] == 0)
+                    continue;
+                const vec3 between(subtract(position_of(b), position_of(a)));
+                const float distance_squared(dot(between, between));
+                const float reach(radius_[a] + radius_[b]);
+                if (distance_squared >= reach * reach)
+                    continue;
+                const float distance(sqrt(distance_squared));
+                const vec3 normal(distance > 0 ? scale(between, 1 / distance) : vec3{0, 1, 0});
+                add_contact(a, b, 0, normal, scale(normal, radius_[a]), scale(normal, -radius_[b]), reach - distance);
+            }
+        }
+
+        for (uint32_t body(0); body < body_count_; ++body)
+        {
+            if (inverse_mass_[body] == 0)
+                continue;
+            for (size_t index(0); index < planes_.size(); ++index)
+            {
+                const plane& half_space(planes_[index]);
+                const float distance(dot(half_space.normal, position_of(body)) - half_space.offset);
+                if (distance >= radius_[body])
+                    continue;
+                add_contact(body, no_body, uint32_t(index), scale(half_space.normal, -1),
+                            scale(half_space.normal, -radius_[body]), vec3{}, radius_[body] - distance);
+            }
+        }
+
+        for (contact& touching : contacts_)
+        {
+            const auto found(previous.find(key_of(touching)));
+            if (found == previous.end())
+                continue;
+            touching.impulses = found->second->impulses;
+        }
+    }
+
+    void rigid_body_world::build_islands()
+    {
+        // union the dynamic bodies that touch; static bodies and planes do not join islands
+        vector<uint32_t> parent(body_count_);
+        iota(parent.begin(), parent.end(), 0);
+        for (const contact& touching : contacts_)
+            if (touching.b != no_body && inverse_mass_[touching.a] > 0 && inverse_mass_[touching.b] > 0)
+                parent[find_root(parent, touching.a)] = find_root(parent, touching.b);
+
+        // number the islands in order of first contact, then group the contacts stably
+        vector<uint32_t> island_of_root(body_count_, no_body);
+        vector<uint32_t> island_of_contact(contacts_.size());
+        uint32_t islands(0);
+        for (size_t c(0); c < contacts_.size(); ++c)
+        {
+            const contact& touching(contacts_[c]);
+            const uint32_t body(inverse_mass_[touching.a] > 0 ? touching.a : touching.b);
+            uint32_t& island(island_of_root[find_root(parent, body)]);
+            if (island == no_body)
+                island = islands++;
+            island_of_contact[c] = island;
+        }
+
+        island_start_.assign(islands + 1, 0);
+        for (uint32_t island : island_of_contact)
+            ++island_start_[island + 1];
+        partial_sum(island_start_.begin(), island_start_.end(), island_start_.begin());
+        vector<uint32_t> cursor(island_start_.begin(), island_start_.end() - 1);
+        vector<contact> grouped(contacts_.size());
+        for (size_t c(0); c < contacts_.size(); ++c)
+            grouped[cursor[island_of_contact[c]]++] = contacts_[c];
+        contacts_ = move(grouped);
+    }
+
+    void rigid_body_world::solve_island(size_t island)
+    {
+        // velocity of b relative to a at the contact point, along one axis
+        auto axis_velocity = [&](const contact& touching, size_t axis)
+        {
+            float speed(0);
+            for (size_t k(0); k < 3; ++k)
+            {
+                speed -= velocity_[k][touching.a] * touching.axes[axis][k] +
+                    angular_velocity_[k][touching.a] * touching.arms_a[axis][k];
+                if (touching.b != no_body)
+                    speed += velocity_[k][touching.b] * touching.axes[axis][k] +
+                        angular_velocity_[k][touching.b] * touching.arms_b[axis][k];
+            }
+            return speed;
+        };
+        // static bodies touch several islands at once, so their velocities are only ever read
+        auto apply = [&](const contact& touching, size_t axis, float impulse)
+        {
+            const bool dynamic_a(inverse_mass_[touching.a] > 0);
+            const bool dynamic_b(touching.b != no_body && inverse_mass_[touching.b] > 0);
+            const float linear_a(impulse * inverse_mass_[touching.a]);
+            const float linear_b(dynamic_b ? impulse * inverse_mass_[touching.b] : 0);
+            for (size_t k(0); k < 3; ++k)
+            {
+                if (dynamic_a)
+                {
+                    velocity_[k][touching.a] -= linear_a * touching.axes[axis][k];
+                    angular_velocity_[k][touching.a] -= impulse * touching.spins_a[axis][k];
+                }
+                if (dynamic_b)
+                {
+                    velocity_[k][touching.b] += linear_b * touching.axes[axis][k];
+                    angular_velocity_[k][touching.b] += impulse * touching.spins_b[axis][k];
+                }
+            }
+        };
+
+        const uint32_t first(island_start_[island]), last(island_start_[island + 1]);
+        for (uint32_t c(first); c < last; ++c)
+        {
+            contact& touching(contacts_[c]);
+            const bool dynamic_b(touching.b != no_body && inverse_mass_[touching.b] > 0);
+            const float inverse_mass(inverse_mass_[touching.a] + (dynamic_b ? inverse_mass_[touching.b] : 0));
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                touching.spins_a[axis] = inverse_mass_[touching.a] > 0
+                                             ? multiply(world_inverse_inertia_[touching.a], touching.arms_a[axis])
+                                             : vec3{};
+                touching.spins_b[axis] = dynamic_b ? multiply(world_inverse_inertia_[touching.b], touching.arms_b[axis])
+                                                   : vec3{};
+                const float k(inverse_mass + dot(touching.arms_a[axis], touching.spins_a[axis]) +
+                              dot(touching.arms_b[axis], touching.spins_b[axis]));
+                touching.masses[axis] = k > 0 ? 1 / k : 0;
+            }
+
+            // bounce only off clear approaches, so resting contacts do not jitter
+            const float approach(axis_velocity(touching, 0));
+            if (approach < -1.0f)
+                touching.bias = max(touching.bias, -settings_.restitution * approach);
+
+            for (size_t axis(0); axis < 3; ++axis)
+                apply(touching, axis, touching.impulses[axis]);
+        }
+
+        for (size_t iteration(0); iteration < settings_.solver_iterations; ++iteration)
+            for (uint32_t c(first); c < last; ++c)
+            {
+                contact& touching(contacts_[c]);
+
+                // normal impulses push only; friction is bounded by the normal impulse
+                const float normal_impulse(max(touching.impulses[0] + touching.masses[0] *
+                                                   (touching.bias - axis_velocity(touching, 0)), 0.0f));
+                apply(touching, 0, normal_impulse - touching.impulses[0]);
+                touching.impulses[0] = normal_impulse;
+
+                const float limit(settings_.friction * normal_impulse);
+                for (size_t axis(1); axis < 3; ++axis)
+                {
+                    const float tangent_impulse(clamp(touching.impulses[axis] -
+                                                      touching.masses[axis] * axis_velocity(touching, axis),
+                                                      -limit, limit));
+                    apply(touching, axis, tangent_impulse - touching.impulses[axis]);
+                    touching.impulses[axis] = tangent_impulse;
+                }
+            }
+    }
+
+    void rigid_body_world::step(float dt, thread_pool& pool)
+    {
+        if (!(dt > 0))
+            return;
+
+        find_contacts(dt, pool);
+        build_islands();
+
+        // R * I^-1 * R^T from the orientation quaternion
+        pool.parallel_for(0, body_count_, integration_grain, [&](size_t first, size_t last)
+        {
+            for (size_t i(first); i < last; ++i)
+            {
+                if (inverse_mass_[i] == 0)
+                    continue;
+                const float w(orientation_[0][i]), x(orientation_[1][i]), y(orientation_[2][i]), z(orientation_[3][i]);
+                const array<float, 9> rotation{1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+                                               2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+                                               2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)};
+                const array<float, 9>& body(inverse_inertia_[i]);
+                array<float, 9>& world(world_inverse_inertia_[i]);
+                for (size_t row(0); row < 3; ++row)
+                    for (size_t column(0); column < 3; ++column)
+                    {
+                        float sum(0);
+                        for (size_t j(0); j < 3; ++j)
+                            for (size_t k(0); k < 3; ++k)
+                                sum += rotation[3 * row + j] * body[3 * j + k] * rotation[3 * column + k];
+                        world[3 * row + column] = sum;
+                    }
+            }
+        });
+
+        integrate_velocities(dt, pool);
+        pool.parallel_for(0, island_count(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t island(first); island < last; ++island)
+                solve_island(island);
+        });
+        integrate_positions(dt, pool);
+    }
+
+    size_t rigid_body_world::body_count() const
+    {
+        return body_count_;
+    }
+
+    size_t rigid_body_world::contact_count() const
+    {
+        return contacts_.size();
+    }
+
+    size_t rigid_body_world::island_count() const
+    {
+        return island_start_.empty() ? 0 : island_start_.size() - 1;
+    }
+
+    const physics_settings& rigid_body_world::settings() const
+    {
+        return settings_;
+    }
+} // engine_lib
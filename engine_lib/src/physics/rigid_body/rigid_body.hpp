@@ -0,0 +1,177 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef RIGID_BODY_HPP
+#define RIGID_BODY_HPP
+#include "../../includes.hpp"
+#include "../../containers/aligned_allocator/aligned_allocator.hpp"
+#include "../../geometry/spatial_hash/spatial_hash.hpp"
+#include "../../math/direction/direction.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief State and mass properties of one rigid body, colliding as a sphere.
+     */
+    struct rigid_body
+    {
+        point<float, 3> position; /// Center of mass in world space.
+        array<float, 4> orientation{1, 0, 0, 0}; /// Unit quaternion (w, x, y, z), body to world.
+        direction<float, 3> velocity; /// Linear velocity.
+        direction<float, 3> angular_velocity; /// Angular velocity in world space.
+        float mass = 0; /// Mass, zero for static bodies.
+        matrix3x3<float> inertia; /// Inertia tensor in body space, ignored for static bodies.
+        float radius = 0; /// Radius of the collision sphere.
+    };
+
+    /**
+     * @brief Creates a solid sphere body at rest.
+     *
+     * @param center Center of the sphere.
+     * @param radius Radius of the sphere.
+     * @param mass Mass, zero for a static sphere.
+     * @return The body, with the inertia tensor 2/5 m r^2 I.
+     */
+    rigid_body solid_sphere(const point<float, 3>& center, float radius, float mass);
+
+    /**
+     * @brief Global parameters of a rigid_body_world.
+     */
+    struct physics_settings
+    {
+        array<float, 3> gravity{0, -9.81f, 0}; /// Acceleration of every dynamic body.
+        size_t solver_iterations = 8; /// Sequential impulse sweeps per step.
+        float friction = 0.5f; /// Coulomb friction coefficient of every contact.
+        float restitution = 0; /// Bounciness of every contact, 0 to 1.
+        float baumgarte = 0.2f; /// Fraction of the penetration corrected per step.
+        float penetration_slop = 0.005f; /// Penetration left uncorrected to keep contacts stable.
+    };
+
+    /**
+     * @class rigid_body_world
+     * @brief Rigid bodies stepped with semi-implicit Euler and a sequential impulse solver.
+     *
+     * The body state is stored as structure of arrays, padded to the SIMD width, and both
+     * integration passes run on native float packs. Contacts come from a spatial_hash
+     * broadphase and a list of static planes. Bodies touching through contacts form islands;
+     * the islands are independent, so they are solved in parallel on the thread pool and the
+     * result does not depend on the thread count.
+     */
+    class rigid_body_world
+    {
+        struct plane
+        {
+            array<float, 3> normal;
+            float offset;
+        };
+        struct contact
+        {
+            uint32_t a; /// First body.
+            uint32_t b; /// Second body, or no_body against a plane.
+            uint32_t plane; /// Index of the plane against a plane, zero otherwise.
+            array<array<float, 3>, 3> axes; /// Unit normal from a to b, then the two friction directions.
+            array<array<float, 3>, 3> arms_a; /// Contact point relative to a, crossed with every axis.
+            array<array<float, 3>, 3> arms_b; /// Contact point relative to b, crossed with every axis.
+            array<array<float, 3>, 3> spins_a; /// Inverse world inertia of a times arms_a.
+            array<array<float, 3>, 3> spins_b; /// Inverse world inertia of b times arms_b.
+            array<float, 3> masses; /// Inverse effective mass along every axis.
+            array<float, 3> impulses; /// Accumulated impulse along every axis.
+            float bias; /// Target separating velocity along the normal.
+        };
+
+        static constexpr uint32_t no_body = UINT32_MAX;
+
+        physics_settings settings_; /// Global parameters.
+        size_t body_count_; /// Bodies stored; the arrays are padded beyond it with static bodies.
+        array<aligned_vector<float>, 3> position_; /// Position per axis.
+        array<aligned_vector<float>, 3> velocity_; /// Linear velocity per axis.
+        array<aligned_vector<float>, 3> angular_velocity_; /// Angular velocity per axis.
+        array<aligned_vector<float>, 4> orientation_; /// Quaternion components w, x, y, z.
+        aligned_vector<float> inverse_mass_; /// 1 / mass, zero for static bodies.
+        aligned_vector<float> radius_; /// Collision sphere radius.
+        vector<matrix3x3<float>> inertia_; /// Body space inertia as given.
+        vector<array<float, 9>> inverse_inertia_; /// Inverse body space inertia, row major.
+        vector<array<float, 9>> world_inverse_inertia_; /// Inverse world space inertia of this step.
+        vector<plane> planes_; /// Static half-spaces.
+        vector<contact> contacts_; /// Contacts of the last step, grouped by island.
+        vector<uint32_t> island_start_; /// First contact of every island, plus the total at the end.
+        spatial_hash broadphase_; /// Grid over the body centers.
+        float max_radius_; /// Largest collision radius.
+
+        void integrate_velocities(float dt, thread_pool& pool);
+        void integrate_positions(float dt, thread_pool& pool);
+        void find_contacts(float dt, thread_pool& pool);
+        void build_islands();
+        void solve_island(size_t island);
+
+    public:
+        /**
+         * @brief Creates an empty world.
+         *
+         * @param settings Global parameters.
+         */
+        explicit rigid_body_world(const physics_settings& settings = {});
+
+        /**
+         * @brief Adds a body.
+         *
+         * @param body The body; dynamic bodies need a positive definite inertia tensor.
+         * @return Index of the body.
+         * @throws invalid_argument If the mass or radius is negative, or the inertia is singular.
+         */
+        size_t add_body(const rigid_body& body);
+
+        /**
+         * @brief Adds a static plane; bodies stay on the side the normal points to.
+         *
+         * @param on_plane Any point of the plane.
+         * @param normal Normal of the plane, any length.
+         * @throws invalid_argument If the normal is zero.
+         */
+        void add_plane(const point<float, 3>& on_plane, const array<float, 3>& normal);
+
+        /**
+         * @brief Reads the current state of a body.
+         *
+         * @param index Index of the body.
+         * @return The body.
+         * @throws out_of_range If the body does not exist.
+         */
+        [[nodiscard]] rigid_body get_body(size_t index) const;
+
+        /**
+         * @brief Sets the velocities of a body.
+         *
+         * @param index Index of the body.
+         * @param velocity Linear velocity.
+         * @param angular_velocity Angular velocity in world space.
+         * @throws out_of_range If the body does not exist.
+         */
+        void set_velocity(size_t index, const direction<float, 3>& velocity, const direction<float, 3>& angular_velocity);
+
+        /**
+         * @brief Advances the simulation.
+         *
+         * @param dt Time step in seconds.
+         * @param pool Pool running the integration and the islands.
+         */
+        void step(float dt, thread_pool& pool = thread_pool::global());
+
+        [[nodiscard]] size_t body_count() const;
+        [[nodiscard]] size_t contact_count() const;
+        [[nodiscard]] size_t island_count() const;
+        [[nodiscard]] const physics_settings& settings() const;
+    };
+} // engine_lib
+
+#endif //RIGID_BODY_HPP
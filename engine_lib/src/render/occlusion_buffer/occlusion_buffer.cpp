@@ -0,0 +1,307 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "occlusion_buffer.hpp"
+#include "../../math/simd/float_pack.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace engine_lib
+{
+    namespace
+    {
+        using clip_vertex = array<float, 4>;
+
+        // pyramid levels inside a tile, the last one has a texel per tile
+        constexpr size_t tile_levels = 5;
+        static_assert(size_t(1) << tile_levels == occlusion_tile, "The pyramid ends at one texel per tile");
+
+        // smallest clip w kept, so no vertex projects from behind the eye
+        constexpr float minimum_w = 1e-5f;
+
+        clip_vertex transform(const matrix<float, 4, 4>& m, const array<float, 3>& p)
+        {
+            clip_vertex result{};
+            for (size_t r(0); r < 4; ++r)
+                result[r] = m(r, 0) * p[0] + m(r, 1) * p[1] + m(r, 2) * p[2] + m(r, 3);
+            return result;
+        }
+
+        // distances of a vertex to the two clip planes, kept where not negative
+        float near_distance(const clip_vertex& v)
+        {
+            return v[2] + v[3];
+        }
+
+        float eye_distance(const clip_vertex& v)
+        {
+            return v[3] - minimum_w;
+        }
+
+        // Sutherland-Hodgman against one plane; a triangle clipped by two planes has at most five corners
+        size_t clip_polygon(const clip_vertex* input, size_t count, float (*distance)(const clip_vertex&),
+                            clip_vertex* output)
+        {
+            size_t result(0);
+            for (size_t i(0); i < count; ++i)
+            {
+                const clip_vertex& a(input[i]);
+                const clip_vertex& b(input[(i + 1) % count]);
+                const float da(distance(a)), db(distance(b));
+                if (da >= 0)
+                    output[result++] = a;
+                if ((da >= 0) != (db >= 0))
+                {
+                    const float t(da / (da - db));
+                    clip_vertex crossing{};
+                    for (size_t k(0); k < 4; ++k)
+                        crossing[k] = a[k] + t * (b[k] - a[k]);
+                    output[result++] = crossing;
+                }
+            }
+            return result;
+        }
+    }
+
+    occlusion_buffer::occlusion_buffer(size_t width, size_t height) : width_(width), height_(height)
+    {
+        if (width == 0 || height == 0 || width % occlusion_tile != 0 || height % occlusion_tile != 0)
+            throw invalid_argument("Occlusion buffer sizes must be positive multiples of " + to_string(occlusion_tile));
+        tiles_x_ = width / occlusion_tile;
+        bins_.resize(tiles_x_ * (height / occlusion_tile));
+        for (size_t level(0); level <= tile_levels; ++level)
+            levels_.emplace_back((width >> level) * (height >> level));
+        clear();
+    }
+
+    void occlusion_buffer::clear()
+    {
+        for (aligned_vector<float>& level : levels_)
+            fill(level.begin(), level.end(), numeric_limits<float>::max());
+        triangles_.clear();
+        for (vector<uint32_t>& bin : bins_)
+            bin.clear();
+    }
+
+    void occlusion_buffer::add_occluder(const mesh& occluder, const matrix<float, 4, 4>& model_view_projection)
+    {
+        const strided_view<const point<float, 3>> positions(occluder.positions());
+        vector<clip_vertex> clip(occluder.vertex_count());
+        for (size_t v(0); v < clip.size(); ++v)
+            clip[v] = transform(model_view_projection, positions[v].get_coordinates());
+
+        const vector<uint32_t>& indices(occluder.indices());
+        for (size_t i(0); i + 2 < indices.size(); i += 3)
+        {
+            const array<clip_vertex, 3> corners{clip[indices[i]], clip[indices[i + 1]], clip[indices[i + 2]]};
+            bool inside(true);
+            for (const clip_vertex& corner : corners)
+                inside = inside && near_distance(corner) >= 0 && eye_distance(corner) >= 0;
+            if (inside)
+            {
+                add_triangle(corners);
+                continue;
+            }
+            clip_vertex near_clipped[4], clipped[5];
+            const size_t near_count(clip_polygon(corners.data(), 3, near_distance, near_clipped));
+            const size_t count(clip_polygon(near_clipped, near_count, eye_distance, clipped));
+            for (size_t k(1); k + 1 < count; ++k)
+                add_triangle({clipped[0], clipped[k], clipped[k + 1]});
+        }
+    }
+
+    void occlusion_buffer::add_triangle(const array<array<float, 4>, 3>& clip)
+    {
+        // screen position in pixels, y down, and normalized device depth
+        array<float, 3> x{}, y{}, z{};
+        for (size_t k(0); k < 3; ++k)
+        {
+            const float inverse_w(1 / clip[k][3]);
+            x[k] = (clip[k][0] * inverse_w * 0.5f + 0.5f) * float(width_);
+            y[k] = (0.5f - clip[k][1] * inverse_w * 0.5f) * float(height_);
+            z[k] = clip[k][2] * inverse_w;
+        }
+        float area((x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]));
+        if (area < 0)
+        {
+            swap(x[1], x[2]);
+            swap(y[1], y[2]);
+            swap(z[1], z[2]);
+            area = -area;
+        }
+        if (!(area > 1e-12f))
+            return;
+
+        // pixels whose center lies in the bounding box
+        const auto first_x(int(max(0.0f, ceil(min({x[0], x[1], x[2]}) - 0.5f))));
+        const auto first_y(int(max(0.0f, ceil(min({y[0], y[1], y[2]}) - 0.5f))));
+        const auto last_x(int(min(float(width_ - 1), floor(max({x[0], x[1], x[2]}) - 0.5f))));
+        const auto last_y(int(min(float(height_ - 1), floor(max({y[0], y[1], y[2]}) - 0.5f))));
+        if (first_x > last_x || first_y > last_y)
+            return;
+
+        occluder_triangle triangle{};
+        for (size_t k(0); k < 3; ++k)
+        {
+            const size_t next((k + 1) % 3);
+            triangle.edge_x[k] = y[k] - y[next];
+            triangle.edge_y[k] = x[next] - x[k];
+            triangle.edge_c[k] = -(triangle.edge_x[k] * x[k] + triangle.edge_y[k] * y[k]);
+        }
+        triangle.depth_x = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+        triangle.depth_y = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+        triangle.depth = z[0] - triangle.depth_x * x[0] - triangle.depth_y * y[0];
+        triangle.bounds = {first_x, first_y, last_x, last_y};
+
+        const auto index(uint32_t(triangles_.size()));
+        triangles_.push_back(triangle);
+        for (size_t ty(size_t(first_y) / occlusion_tile); ty <= size_t(last_y) / occlusion_tile; ++ty)
+            for (size_t tx(size_t(first_x) / occlusion_tile); tx <= size_t(last_x) / occlusion_tile; ++tx)
+                bins_[ty * tiles_x_ + tx].push_back(index);
+    }
+
+    void occlusion_buffer::rasterize_tile(size_t tile)
+    {
+        using pack = native_float_pack;
+        constexpr size_t lanes(pack::width);
+        static_assert(occlusion_tile % lanes == 0, "Pack rows must not cross tiles");
+        alignas(64) static const float lane_offsets[8]{0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+        const pack offsets(pack::load_unaligned(lane_offsets));
+        const pack zero(0.0f);
+
+        const int tile_x(int(tile % tiles_x_ * occlusion_tile)), tile_y(int(tile / tiles_x_ * occlusion_tile));
+        float* depth(levels_[0].data());
+        for (const uint32_t index : bins_[tile])
+        {
+            const occluder_triangle& triangle(triangles_[index]);
+            const int first_x(max(triangle.bounds[0], tile_x));
+            const int first_y(max(triangle.bounds[1], tile_y));
+            const int last_x(min(triangle.bounds[2], tile_x + int(occlusion_tile) - 1));
+            const int last_y(min(triangle.bounds[3], tile_y + int(occlusion_tile) - 1));
+            const pack edge_x0(triangle.edge_x[0]), edge_x1(triangle.edge_x[1]), edge_x2(triangle.edge_x[2]);
+            const pack depth_x(triangle.depth_x);
+            const pack column_low(static_cast<float>(first_x)), column_high(static_cast<float>(last_x + 1));
+
+            for (int row(first_y); row <= last_y; ++row)
+            {
+                const float center_y(float(row) + 0.5f);
+                const pack edge_c0(triangle.edge_y[0] * center_y + triangle.edge_c[0]);
+                const pack edge_c1(triangle.edge_y[1] * center_y + triangle.edge_c[1]);
+                const pack edge_c2(triangle.edge_y[2] * center_y + triangle.edge_c[2]);
+                const pack depth_c(triangle.depth_y * center_y + triangle.depth);
+                float* line(depth + size_t(row) * width_);
+                // whole packs from an aligned column; lanes outside the triangle's columns are masked off
+                for (int column(first_x & ~int(lanes - 1)); column <= last_x; column += int(lanes))
+                {
+                    const pack center_x(pack(float(column)) + offsets);
+                    const pack inside((mul_add(edge_x0, center_x, edge_c0) >= zero) &
+                                      (mul_add(edge_x1, center_x, edge_c1) >= zero) &
+                                      (mul_add(edge_x2, center_x, edge_c2) >= zero) &
+                                      (center_x > column_low) & (center_x < column_high));
+                    const pack z(mul_add(depth_x, center_x, depth_c));
+                    const pack old(pack::load(line + column));
+                    select(inside & (z < old), z, old).store(line + column);
+                }
+            }
+        }
+
+        // every texel holds the farthest of the four below it
+        for (size_t level(1); level <= tile_levels; ++level)
+        {
+            const size_t size(occlusion_tile >> level), stride(width_ >> level), below_stride(width_ >> (level - 1));
+            const size_t left(size_t(tile_x) >> level), top(size_t(tile_y) >> level);
+            const float* below(levels_[level - 1].data());
+            float* texels(levels_[level].data());
+            for (size_t row(top); row < top + size; ++row)
+                for (size_t column(left); column < left + size; ++column)
+                {
+                    const float* source(below + 2 * row * below_stride + 2 * column);
+                    texels[row * stride + column] = max(max(source[0], source[1]),
+                                                        max(source[below_stride], source[below_stride + 1]));
+                }
+        }
+    }
+
+    void occlusion_buffer::render(thread_pool& pool)
+    {
+        pool.parallel_for(0, bins_.size(), 1, [this](size_t first, size_t last)
+        {
+            for (size_t tile(first); tile < last; ++tile)
+                rasterize_tile(tile);
+        });
+    }
+
+    bool occlusion_buffer::occluded(const point<float, 3>& low, const point<float, 3>& high,
+                                    const matrix<float, 4, 4>& model_view_projection) const
+    {
+        const array<float, 3> a(low.get_coordinates()), b(high.get_coordinates());
+        float min_x(numeric_limits<float>::max()), min_y(min_x), nearest(min_x);
+        float max_x(-min_x), max_y(-min_x);
+        for (size_t corner(0); corner < 8; ++corner)
+        {
+            const clip_vertex clip(transform(model_view_projection, {corner & 1 ? b[0] : a[0], corner & 2 ? b[1] : a[1],
+                                                                     corner & 4 ? b[2] : a[2]}));
+            if (near_distance(clip) < 0 || eye_distance(clip) < 0)
+                return false;
+            const float inverse_w(1 / clip[3]);
+            const float x((clip[0] * inverse_w * 0.5f + 0.5f) * float(width_));
+            const float y((0.5f - clip[1] * inverse_w * 0.5f) * float(height_));
+            min_x = min(min_x, x);
+            max_x = max(max_x, x);
+            min_y = min(min_y, y);
+            max_y = max(max_y, y);
+            nearest = min(nearest, clip[2] * inverse_w);
+        }
+        if (max_x <= 0 || max_y <= 0 || min_x >= float(width_) || min_y >= float(height_))
+            return false;
+
+        // every pixel the rectangle touches, partially covered ones included
+        const auto first_x(size_t(max(0.0f, floor(min_x))));
+        const auto first_y(size_t(max(0.0f, floor(min_y))));
+        const auto last_x(size_t(min(float(width_ - 1), ceil(max_x) - 1)));
+        const auto last_y(size_t(min(float(height_ - 1), ceil(max_y) - 1)));
+
+        // the level where the rectangle spans at most three texels each way
+        size_t level(0);
+        while (level < tile_levels && max(last_x - first_x, last_y - first_y) >> level >= 2)
+            ++level;
+        const float* texels(levels_[level].data());
+        const size_t stride(width_ >> level);
+        for (size_t row(first_y >> level); row <= last_y >> level; ++row)
+            for (size_t column(first_x >> level); column <= last_x >> level; ++column)
+                if (!(texels[row * stride + column] < nearest))
+                    return false;
+        return true;
+    }
+
+    float occlusion_buffer::depth(size_t x, size_t y, size_t level) const
+    {
+        const aligned_vector<float>& texels(levels_.at(level));
+        if (x >= width_ >> level || y >= height_ >> level)
+            throw out_of_range("Texel outside the occlusion buffer level");
+        return texels[y * (width_ >> level) + x];
+    }
+
+    size_t occlusion_buffer::width() const
+    {
+        return width_;
+    }
+
+    size_t occlusion_buffer::height() const
+    {
+        return height_;
+    }
+
+    size_t occlusion_buffer::level_count() const
+    {
+        return levels_.size();
+    }
+
+    size_t occlusion_buffer::triangle_count() const
+    {
+        return triangles_.size();
+    }
+} // engine_lib
@@ -0,0 +1,135 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef OCCLUSION_BUFFER_HPP
+#define OCCLUSION_BUFFER_HPP
+#include "../../includes.hpp"
+#include "../../containers/aligned_allocator/aligned_allocator.hpp"
+#include "../../geometry/mesh/mesh.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../math/point/point.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Side of the square tiles the occlusion buffer is rasterized by, in pixels.
+     */
+    constexpr size_t occlusion_tile = 32;
+
+    /**
+     * @class occlusion_buffer
+     * @brief Low resolution software depth buffer for culling objects hidden behind occluders.
+     *
+     * Each frame, before the main render, the large opaque meshes of the scene are added as
+     * occluders and rendered, then the bounding boxes of the other objects are tested against
+     * the result. Occluder triangles are clipped against the near plane, set up and binned to
+     * tiles on the calling thread; render() rasterizes the tiles in parallel, several pixels at a
+     * time with native_float_pack, and builds a hierarchical Z pyramid within every tile whose
+     * texels hold the farthest depth below them. A box test reads a few texels of the level
+     * matching its screen size.
+     *
+     * Depth is the normalized device z, so any projection mapping z/w monotonically to distance
+     * works, OpenGL and Direct3D conventions alike. Pixels are covered when their center is,
+     * as in GPU rasterization; an object visible only through the uncovered part of an edge
+     * pixel may be culled.
+     */
+    class occlusion_buffer
+    {
+        struct occluder_triangle
+        {
+            array<float, 3> edge_x; /// x coefficient of the three edge functions.
+            array<float, 3> edge_y; /// y coefficient of the three edge functions.
+            array<float, 3> edge_c; /// Constant of the three edge functions, inside where all are not negative.
+            float depth; /// Depth at pixel (0, 0).
+            float depth_x; /// Depth change per pixel along x.
+            float depth_y; /// Depth change per pixel along y.
+            array<int, 4> bounds; /// Covered pixel rows and columns: first x, first y, last x, last y.
+        };
+
+        size_t width_; /// Width in pixels.
+        size_t height_; /// Height in pixels.
+        size_t tiles_x_; /// Tiles per row.
+        vector<aligned_vector<float>> levels_; /// Depth pyramid, level 0 at full resolution.
+        vector<occluder_triangle> triangles_; /// Occluder triangles of the frame.
+        vector<vector<uint32_t>> bins_; /// Triangles overlapping every tile.
+
+        void add_triangle(const array<array<float, 4>, 3>& clip);
+        void rasterize_tile(size_t tile);
+
+    public:
+        /**
+         * @brief Creates a cleared buffer.
+         *
+         * @param width Width in pixels, a multiple of occlusion_tile.
+         * @param height Height in pixels, a multiple of occlusion_tile.
+         * @throws invalid_argument If a size is zero or not a multiple of occlusion_tile.
+         */
+        occlusion_buffer(size_t width = 256, size_t height = 128);
+
+        /**
+         * @brief Drops the occluders and resets every pixel to infinitely far.
+         */
+        void clear();
+
+        /**
+         * @brief Adds the triangles of a mesh as occluders.
+         *
+         * Both windings occlude. Triangles are clipped against the plane z = -w, which lies at or
+         * in front of the near plane of OpenGL and Direct3D style projections.
+         *
+         * @param occluder The mesh, opaque and closed or at least without holes.
+         * @param model_view_projection Model to clip space transformation.
+         */
+        void add_occluder(const mesh& occluder, const matrix<float, 4, 4>& model_view_projection);
+
+        /**
+         * @brief Rasterizes the occluders added since clear(), tile by tile in parallel.
+         *
+         * @param pool Pool rasterizing the tiles.
+         */
+        void render(thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Tests whether a box is certainly hidden behind the rendered occluders.
+         *
+         * The box is projected to its screen rectangle and nearest depth, which is compared
+         * against the farthest occluder depth over the rectangle. Boxes crossing the plane
+         * z = -w or lying outside the viewport are never reported occluded; frustum culling
+         * handles the latter.
+         *
+         * @param low Smallest corner of the box in model space.
+         * @param high Largest corner of the box in model space.
+         * @param model_view_projection Model to clip space transformation.
+         * @return True if every pixel the box covers lies behind an occluder.
+         */
+        [[nodiscard]] bool occluded(const point<float, 3>& low, const point<float, 3>& high,
+                                    const matrix<float, 4, 4>& model_view_projection) const;
+
+        /**
+         * @brief Reads a depth texel.
+         *
+         * @param x Column of the texel.
+         * @param y Row of the texel, 0 at the top.
+         * @param level Pyramid level, 0 at full resolution; a texel of level k covers 2^k pixels squared.
+         * @return Farthest depth of the pixels below the texel, the largest float where nothing is drawn.
+         * @throws out_of_range If the level or texel does not exist.
+         */
+        [[nodiscard]] float depth(size_t x, size_t y, size_t level = 0) const;
+
+        [[nodiscard]] size_t width() const;
+        [[nodiscard]] size_t height() const;
+        [[nodiscard]] size_t level_count() const;
+        [[nodiscard]] size_t triangle_count() const;
+    };
+} // engine_lib
+
+#endif //OCCLUSION_BUFFER_HPP
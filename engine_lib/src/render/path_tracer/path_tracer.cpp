@@ -0,0 +1,398 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "path_tracer.hpp"
+#include "../../math/vector3/vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace engine_lib
+{
+    namespace
+    {
+        using vec3 = array<float, 3>;
+
+        constexpr float pi(3.14159265358979f);
+
+        uint64_t mix(uint64_t value)
+        {
+            value += 0x9E3779B97F4A7C15ull;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        // splitmix64 sequence, one per pixel sample
+        struct random_sequence
+        {
+            uint64_t state;
+
+            float next()
+            {
+                state += 0x9E3779B97F4A7C15ull;
+                return float(mix(state) >> 40) * (1.0f / float(1u << 24));
+            }
+        };
+
+        // cosine weighted direction around a unit normal (orthonormal basis of Duff et al.)
+        vec3 sample_hemisphere(const vec3& normal, random_sequence& random)
+        {
+            const float sign(copysign(1.0f, normal[2]));
+            const float a(-1.0f / (sign + normal[2]));
+            const float b(normal[0] * normal[1] * a);
+            const vec3 tangent{1.0f + sign * normal[0] * normal[0] * a, sign * b, -sign * normal[0]};
+            const vec3 bitangent{b, sign + normal[1] * normal[1] * a, -normal[1]};
+
+            const float angle(2 * pi * random.next());
+            const float radius_squared(random.next());
+            const float radius(sqrt(radius_squared));
+            return add(add(scale(tangent, cos(angle) * radius), scale(bitangent, sin(angle) * radius)),
+                       scale(normal, sqrt(max(0.0f, 1 - radius_squared))));
+        }
+    }
+
+    path_tracing_scene::path_tracing_scene()
+        : sky_{0, 0, 0},
+          built_(false)
+    {
+    }
+
+    uint32_t path_tracing_scene::add_material(const material& surface)
+    {
+        materials_.push_back(surface);
+        return uint32_t(materials_.size() - 1);
+    }
+
+    void path_tracing_scene::add_mesh(const mesh& source, uint32_t material_index)
+    {
+        if (material_index >= materials_.size())
+            throw out_of_range("Material index out of range");
+
+        const auto positions(source.positions());
+        const auto normals(source.normals());
+        const vector<uint32_t>& indices(source.indices());
+        positions_.reserve(positions_.size() + indices.size());
+        for (uint32_t index : indices)
+        {
+            positions_.push_back(positions[index]);
+            normals_.push_back(normalized(normals[index].get_coordinates()));
+        }
+        triangle_materials_.insert(triangle_materials_.end(), indices.size() / 3, material_index);
+        built_ = false;
+    }
+
+    void path_tracing_scene::add_sphere(const point<float, 3>& center, float radius, uint32_t material_index)
+    {
+        if (material_index >= materials_.size())
+            throw out_of_range("Material index out of range");
+        spheres_.push_back({center, radius, material_index});
+        built_ = false;
+    }
+
+    void path_tracing_scene::set_sky(const array<float, 3>& radiance)
+    {
+        sky_ = radiance;
+    }
+
+    const array<float, 3>& path_tracing_scene::sky() const
+    {
+        return sky_;
+    }
+
+    const material& path_tracing_scene::get_material(uint32_t index) const
+    {
+        return materials_.at(index);
+    }
+
+    size_t path_tracing_scene::triangle_count() const
+    {
+        return triangle_materials_.size();
+    }
+
+    void path_tracing_scene::build()
+    {
+        const size_t triangles(triangle_count());
+        vector<array<float, 3>> centroids(triangles);
+        vector<uint32_t> order(triangles);
+        for (size_t t(0); t < triangles; ++t)
+        {
+            for (size_t axis(0); axis < 3; ++axis)
+                centroids[t][axis] = (positions_[3 * t].coordinate(axis) + positions_[3 * t + 1].coordinate(axis) +
+                                      positions_[3 * t + 2].coordinate(axis)) / 3;
+            order[t] = uint32_t(t);
+        }
+
+        nodes_.clear();
+        if (triangles > 0)
+            build_node(order, centroids, 0, uint32_t(triangles));
+
+        // store the triangles in leaf order, so every leaf is one contiguous range
+        vector<point<float, 3>> positions(positions_.size());
+        vector<array<float, 3>> normals(normals_.size());
+        vector<uint32_t> materials(triangles);
+        for (size_t t(0); t < triangles; ++t)
+        {
+            for (size_t corner(0); corner < 3; ++corner)
+            {
+                positions[3 * t + corner] = positions_[3 * order[t] + corner];
+                normals[3 * t + corner] = normals_[3 * order[t] + corner];
+            }
+            materials[t] = triangle_materials_[order[t]];
+        }
+        positions_ = move(positions);
+        normals_ = move(normals);
+        triangle_materials_ = move(materials);
+        built_ = true;
+    }
+
+    void path_tracing_scene::build_node(vector<uint32_t>& order, const vector<array<float, 3>>& centroids,
+                                        uint32_t first, uint32_t count)
+    {
+        const size_t index(nodes_.size());
+        nodes_.push_back({});
+
+        const float infinity(numeric_limits<float>::infinity());
+        vec3 lower{infinity, infinity, infinity}, upper{-infinity, -infinity, -infinity};
+        vec3 centroid_lower(lower), centroid_upper(upper);
+        for (uint32_t i(first); i < first + count; ++i)
+        {
+            for (size_t corner(0); corner < 3; ++corner)
+                for (size_t axis(0); axis < 3; ++axis)
+                {
+                    lower[axis] = min(lower[axis], positions_[3 * order[i] + corner].coordinate(axis));
+                    upper[axis] = max(upper[axis], positions_[3 * order[i] + corner].coordinate(axis));
+                }
+            for (size_t axis(0); axis < 3; ++axis)
+            {
+                centroid_lower[axis] = min(centroid_lower[axis], centroids[order[i]][axis]);
+                centroid_upper[axis] = max(centroid_upper[axis], centroids[order[i]][axis]);
+            }
+        }
+        nodes_[index].lower = point<float, 3>(lower);
+        nodes_[index].upper = point<float, 3>(upper);
+
+        const vec3 extent(subtract(centroid_upper, centroid_lower));
+        const size_t axis(extent[0] >= extent[1] && extent[0] >= extent[2] ? 0 : extent[1] >= extent[2] ? 1 : 2);
+        if (count <= 4 || extent[axis] <= 0)
+        {
+            nodes_[index].first = first;
+            nodes_[index].count = count;
+            return;
+        }
+
+        const uint32_t half(count / 2);
+        nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                    [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+        build_node(order, centroids, first, half);
+        nodes_[index].first = uint32_t(nodes_.size());
+        nodes_[index].count = 0;
+        build_node(order, centroids, first + half, count - half);
+    }
+
+    optional<surface_hit> path_tracing_scene::intersect(const ray<float, 3>& r, float max_distance) const
+    {
+        if (!built_)
+            throw logic_error("path_tracing_scene::build() must be called before tracing");
+
+        float closest(max_distance);
+        size_t hit_triangle(numeric_limits<size_t>::max()), hit_sphere(numeric_limits<size_t>::max());
+        float hit_u(0), hit_v(0);
+
+        if (!nodes_.empty() && intersect_box(r, nodes_[0].lower, nodes_[0].upper, closest))
+        {
+            uint32_t stack[64];
+            size_t depth(0);
+            stack[depth++] = 0;
+            while (depth > 0)
+            {
+                const node& current(nodes_[stack[--depth]]);
+                if (current.count > 0)
+                {
+                    for (uint32_t t(current.first); t < current.first + current.count; ++t)
+                        if (const auto hit = intersect_triangle(r, positions_[3 * t], positions_[3 * t + 1],
+                                                                positions_[3 * t + 2], closest))
+                        {
+                            closest = hit->distance;
+                            hit_triangle = t;
+                            hit_u = hit->u;
+                            hit_v = hit->v;
+                        }
+                    continue;
+                }
+
+                // visit the nearer child first, so the farther one is often culled by the closer hit
+                const uint32_t left(uint32_t(&current - nodes_.data()) + 1), right(current.first);
+                const auto left_hit(intersect_box(r, nodes_[left].lower, nodes_[left].upper, closest));
+                const auto right_hit(intersect_box(r, nodes_[right].lower, nodes_[right].upper, closest));
+                if (left_hit && right_hit)
+                {
+                    const bool left_first(*left_hit <= *right_hit);
+                    stack[depth++] = left_first ? right : left;
+                    stack[depth++] = left_first ? left : right;
+                }
+                else if (left_hit)
+                    stack[depth++] = left;
+                else if (right_hit)
+                    stack[depth++] = right;
+            }
+        }
+
+        for (size_t s(0); s < spheres_.size(); ++s)
+            if (const auto hit = intersect_sphere(r, spheres_[s].center, spheres_[s].radius, closest))
+            {
+                closest = *hit;
+                hit_sphere = s;
+            }
+
+        if (hit_triangle == numeric_limits<size_t>::max() && hit_sphere == numeric_limits<size_t>::max())
+            return nullopt;
+
+        surface_hit result{};
+        result.distance = closest;
+        result.position = r.at(closest);
+        if (hit_sphere != numeric_limits<size_t>::max())
+        {
+            const sphere& target(spheres_[hit_sphere]);
+            result.geometric_normal = normalized(subtract(result.position.get_coordinates(), target.center.get_coordinates()));
+            result.normal = result.geometric_normal;
+            result.material_index = target.material_index;
+        }
+        else
+        {
+            const size_t t(hit_triangle);
+            const vec3 a(positions_[3 * t].get_coordinates());
+            result.geometric_normal = normalized(cross(subtract(positions_[3 * t + 1].get_coordinates(), a),
+                                                      subtract(positions_[3 * t + 2].get_coordinates(), a)));
+            result.normal = normalized(add(add(scale(normals_[3 * t], 1 - hit_u - hit_v),
+                                              scale(normals_[3 * t + 1], hit_u)), scale(normals_[3 * t + 2], hit_v)));
+            if (dot(result.normal, result.normal) == 0)
+                result.normal = result.geometric_normal;
+            result.material_index = triangle_materials_[t];
+        }
+
+        // both normals face the incoming ray
+        if (dot(result.geometric_normal, r.get_direction()) > 0)
+            result.geometric_normal = scale(result.geometric_normal, -1);
+        if (dot(result.normal, result.geometric_normal) < 0)
+            result.normal = scale(result.normal, -1);
+        return result;
+    }
+
+    path_tracer::path_tracer(const path_tracing_scene& scene, const camera& view, const path_tracer_settings& settings)
+        : scene_(scene),
+          settings_(settings),
+          eye_(view.position.get_coordinates()),
+          accumulated_(settings.width * settings.height * 3),
+          samples_(0),
+          render_time_(0)
+    {
+        if (settings_.width == 0 || settings_.height == 0 || settings_.tile_size == 0)
+            throw invalid_argument("Image and tile sizes must be positive");
+
+        const vec3 forward(normalized(subtract(view.target.get_coordinates(), eye_)));
+        const vec3 right(normalized(cross(forward, view.up)));
+        const vec3 up(cross(right, forward));
+        const float half_height(tan(view.vertical_fov * pi / 360));
+        const float half_width(half_height * float(settings_.width) / float(settings_.height));
+        corner_ = add(subtract(forward, scale(right, half_width)), scale(up, half_height));
+        right_ = scale(right, 2 * half_width);
+        down_ = scale(up, -2 * half_height);
+    }
+
+    array<float, 3> path_tracer::trace(ray<float, 3> r, uint64_t stream) const
+    {
+        random_sequence random{stream};
+        vec3 radiance{0, 0, 0}, throughput{1, 1, 1};
+        for (size_t bounce(0);; ++bounce)
+        {
+            const optional<surface_hit> hit(scene_.intersect(r));
+            if (!hit)
+                return add(radiance, multiply(throughput, scene_.sky()));
+
+            const material& surface(scene_.get_material(hit->material_index));
+            radiance = add(radiance, multiply(throughput, surface.emission));
+            if (bounce == settings_.max_bounces)
+                return radiance;
+
+            // Lambertian BRDF over cosine weighted sampling leaves the albedo as the path weight
+            throughput = multiply(throughput, surface.albedo);
+            if (bounce >= 3)
+            {
+                const float survival(clamp(max({throughput[0], throughput[1], throughput[2]}), 0.05f, 1.0f));
+                if (random.next() >= survival)
+                    return radiance;
+                throughput = scale(throughput, 1 / survival);
+            }
+
+            const vec3 position(hit->position.get_coordinates());
+            const float offset(1e-4f * max({1.0f, fabs(position[0]), fabs(position[1]), fabs(position[2])}));
+            r = ray<float, 3>(point<float, 3>(add(position, scale(hit->geometric_normal, offset))),
+                              sample_hemisphere(hit->normal, random));
+        }
+    }
+
+    void path_tracer::render_pass(thread_pool& pool)
+    {
+        const auto start(chrono::steady_clock::now());
+        const size_t width(settings_.width), height(settings_.height), tile(settings_.tile_size);
+        const size_t columns((width + tile - 1) / tile), rows((height + tile - 1) / tile);
+        const uint64_t pass_seed(mix(settings_.seed ^ mix(uint64_t(samples_))));
+
+        pool.parallel_for(0, columns * rows, 1, [&](size_t first, size_t last)
+        {
+            for (size_t t(first); t < last; ++t)
+            {
+                const size_t x0((t % columns) * tile), y0((t / columns) * tile);
+                for (size_t y(y0); y < min(height, y0 + tile); ++y)
+                    for (size_t x(x0); x < min(width, x0 + tile); ++x)
+                    {
+                        const size_t pixel(y * width + x);
+                        random_sequence random{mix(pass_seed ^ mix(uint64_t(pixel)))};
+                        const float u((float(x) + random.next()) / float(width));
+                        const float v((float(y) + random.next()) / float(height));
+                        const vec3 through(add(corner_, add(scale(right_, u), scale(down_, v))));
+                        const vec3 sample(trace(ray<float, 3>(point<float, 3>(eye_), through), random.state));
+                        for (size_t channel(0); channel < 3; ++channel)
+                            accumulated_[3 * pixel + channel] += sample[channel];
+                    }
+            }
+        });
+        ++samples_;
+        render_time_ += chrono::steady_clock::now() - start;
+    }
+
+    void path_tracer::reset()
+    {
+        fill(accumulated_.begin(), accumulated_.end(), 0.0f);
+        samples_ = 0;
+        render_time_ = chrono::duration<double>(0);
+    }
+
+    size_t path_tracer::samples() const
+    {
+        return samples_;
+    }
+
+    const path_tracer_settings& path_tracer::settings() const
+    {
+        return settings_;
+    }
+
+    vector<float> path_tracer::image() const
+    {
+        vector<float> result(accumulated_.size());
+        if (samples_ > 0)
+            for (size_t i(0); i < result.size(); ++i)
+                result[i] = accumulated_[i] / float(samples_);
+        return result;
+    }
+
+    double path_tracer::samples_per_second() const
+    {
+        const double pixel_samples(double(samples_) * double(settings_.width * settings_.height));
+        return render_time_.count() > 0 ? pixel_samples / render_time_.count() : 0;
+    }
+} // engine_lib
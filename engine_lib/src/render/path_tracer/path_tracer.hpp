@@ -0,0 +1,229 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef PATH_TRACER_HPP
+#define PATH_TRACER_HPP
+#include "../../includes.hpp"
+#include "../../geometry/mesh/mesh.hpp"
+#include "../../math/ray/ray.hpp"
+#include "../../threading/thread_pool/thread_pool.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Lambertian surface, optionally emitting light.
+     */
+    struct material
+    {
+        array<float, 3> albedo; /// Diffuse reflectance per channel, in [0, 1].
+        array<float, 3> emission; /// Emitted radiance per channel.
+    };
+
+    /**
+     * @brief Closest surface hit by a ray in a path_tracing_scene.
+     */
+    struct surface_hit
+    {
+        float distance; /// Distance along the ray.
+        point<float, 3> position; /// Hit point.
+        array<float, 3> normal; /// Unit shading normal, facing the incoming ray.
+        array<float, 3> geometric_normal; /// Unit normal of the primitive, facing the incoming ray.
+        uint32_t material_index; /// Index of the material.
+    };
+
+    /**
+     * @class path_tracing_scene
+     * @brief Triangles and spheres with materials, and a bounding volume hierarchy over the triangles.
+     *
+     * Add the geometry, then call build() once before tracing.
+     */
+    class path_tracing_scene
+    {
+        struct node
+        {
+            point<float, 3> lower; /// Bounds of the node.
+            point<float, 3> upper;
+            uint32_t first; /// First triangle of a leaf, or the right child of an inner node.
+            uint32_t count; /// Triangles of a leaf, zero for inner nodes.
+        };
+        struct sphere
+        {
+            point<float, 3> center;
+            float radius;
+            uint32_t material_index;
+        };
+
+        vector<material> materials_; /// Materials by index.
+        vector<point<float, 3>> positions_; /// Triangle corners, three per triangle.
+        vector<array<float, 3>> normals_; /// Shading normals of the corners.
+        vector<uint32_t> triangle_materials_; /// Material of every triangle.
+        vector<sphere> spheres_; /// Spheres, tested without hierarchy.
+        vector<node> nodes_; /// Hierarchy, root first; the left child follows its parent.
+        array<float, 3> sky_; /// Radiance of rays leaving the scene.
+        bool built_; /// Set by build(), cleared by every change.
+
+        void build_node(vector<uint32_t>& order, const vector<array<float, 3>>& centroids, uint32_t first,
+                        uint32_t count);
+
+    public:
+        /**
+         * @brief Creates an empty scene with a black sky.
+         */
+        path_tracing_scene();
+
+        /**
+         * @brief Adds a material.
+         *
+         * @param surface The material.
+         * @return Its index.
+         */
+        uint32_t add_material(const material& surface);
+
+        /**
+         * @brief Adds the triangles of a mesh, copying positions and normals.
+         *
+         * @param source The mesh.
+         * @param material_index Material of every triangle.
+         * @throws out_of_range If the material does not exist.
+         */
+        void add_mesh(const mesh& source, uint32_t material_index);
+
+        /**
+         * @brief Adds a sphere.
+         *
+         * @param center Center of the sphere.
+         * @param radius Radius of the sphere.
+         * @param material_index Material of the sphere.
+         * @throws out_of_range If the material does not exist.
+         */
+        void add_sphere(const point<float, 3>& center, float radius, uint32_t material_index);
+
+        /**
+         * @brief Sets the radiance of rays that leave the scene.
+         *
+         * @param radiance Radiance per channel.
+         */
+        void set_sky(const array<float, 3>& radiance);
+
+        [[nodiscard]] const array<float, 3>& sky() const;
+        [[nodiscard]] const material& get_material(uint32_t index) const;
+        [[nodiscard]] size_t triangle_count() const;
+
+        /**
+         * @brief Builds the hierarchy over the triangles (median splits along the widest axis).
+         */
+        void build();
+
+        /**
+         * @brief Finds the closest surface along a ray.
+         *
+         * @param r The ray.
+         * @param max_distance Surfaces farther away are ignored.
+         * @return The hit, or nothing if the ray leaves the scene.
+         * @throws logic_error If build() was not called after the last change.
+         */
+        [[nodiscard]] optional<surface_hit> intersect(const ray<float, 3>& r,
+                                                      float max_distance = numeric_limits<float>::infinity()) const;
+    };
+
+    /**
+     * @brief Pinhole camera.
+     */
+    struct camera
+    {
+        point<float, 3> position; /// Eye position.
+        point<float, 3> target; /// Point looked at.
+        array<float, 3> up; /// Approximate up direction.
+        float vertical_fov; /// Vertical field of view in degrees.
+    };
+
+    /**
+     * @brief Image size and sampling settings of a path_tracer.
+     */
+    struct path_tracer_settings
+    {
+        size_t width = 640; /// Image width in pixels.
+        size_t height = 480; /// Image height in pixels.
+        size_t max_bounces = 8; /// Longest path, in surface interactions.
+        size_t tile_size = 16; /// Side of the square tiles the workers claim.
+        uint64_t seed = 0; /// Seed of every random sequence.
+    };
+
+    /**
+     * @class path_tracer
+     * @brief Progressive unidirectional path tracer for reference images.
+     *
+     * Every render_pass() adds one sample to every pixel. The image is split into tiles which
+     * the workers of a thread pool claim one at a time, so the load balances itself across
+     * cores. The random sequence of a sample depends only on the seed, the pixel and the
+     * sample index, so the image is identical for any thread count and scheduling order.
+     *
+     * Surfaces are Lambertian with cosine weighted sampling; paths end at the sky, at the
+     * bounce limit or by Russian roulette after three bounces.
+     */
+    class path_tracer
+    {
+        const path_tracing_scene& scene_; /// Scene, must outlive the tracer.
+        path_tracer_settings settings_; /// Image size and sampling settings.
+        array<float, 3> eye_; /// Camera position.
+        array<float, 3> corner_; /// Direction through the top left image corner.
+        array<float, 3> right_; /// Step across the whole image width.
+        array<float, 3> down_; /// Step across the whole image height.
+        vector<float> accumulated_; /// Sum of the samples, RGB per pixel.
+        size_t samples_; /// Samples per pixel accumulated.
+        chrono::duration<double> render_time_; /// Time spent in render_pass().
+
+        array<float, 3> trace(ray<float, 3> r, uint64_t stream) const;
+
+    public:
+        /**
+         * @brief Creates a tracer with an empty image.
+         *
+         * @param scene Built scene, must outlive the tracer.
+         * @param view Camera.
+         * @param settings Image size and sampling settings.
+         * @throws invalid_argument If the image or tile size is zero.
+         */
+        path_tracer(const path_tracing_scene& scene, const camera& view, const path_tracer_settings& settings = {});
+
+        /**
+         * @brief Adds one sample to every pixel, tile by tile on the pool.
+         *
+         * @param pool Pool rendering the tiles.
+         */
+        void render_pass(thread_pool& pool = thread_pool::global());
+
+        /**
+         * @brief Clears the accumulated samples.
+         */
+        void reset();
+
+        [[nodiscard]] size_t samples() const;
+        [[nodiscard]] const path_tracer_settings& settings() const;
+
+        /**
+         * @brief Returns the current estimate of the image.
+         *
+         * @return Linear RGB, width * height * 3 floats, rows from top to bottom.
+         */
+        [[nodiscard]] vector<float> image() const;
+
+        /**
+         * @brief Returns the rendering throughput so far.
+         *
+         * @return Pixel samples per second of render_pass() time.
+         */
+        [[nodiscard]] double samples_per_second() const;
+    };
+} // engine_lib
+
+#endif //PATH_TRACER_HPP
@@ -0,0 +1,185 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "render_queue.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace engine_lib
+{
+    uint64_t make_render_key(uint8_t layer, uint16_t pipeline, uint16_t texture, uint32_t depth)
+    {
+        if (depth >= 1u << 24)
+            throw out_of_range("Render key depth exceeds 24 bits");
+        return uint64_t(layer) << 56 | uint64_t(pipeline) << 40 | uint64_t(texture) << 24 | depth;
+    }
+
+    uint32_t quantize_depth(float depth, bool back_to_front)
+    {
+        const float clamped(isnan(depth) ? 0.0f : clamp(depth, 0.0f, 1.0f));
+        const auto quantized(uint32_t(lround(double(clamped) * double((1u << 24) - 1))));
+        return back_to_front ? (1u << 24) - 1 - quantized : quantized;
+    }
+
+    size_t command_buffer::reserve_data(size_t size, size_t alignment)
+    {
+        const size_t offset((data_.size() + alignment - 1) & ~(alignment - 1));
+        data_.resize(offset + size);
+        return offset;
+    }
+
+    void command_buffer::clear()
+    {
+        commands_.clear();
+        data_.clear();
+    }
+
+    const vector<render_command>& command_buffer::commands() const
+    {
+        return commands_;
+    }
+
+    size_t command_buffer::data_size() const
+    {
+        return data_.size();
+    }
+
+    render_frame::render_frame(size_t buffer_count)
+    {
+        if (buffer_count == 0)
+            throw invalid_argument("A render frame needs at least one command buffer");
+        buffers_.resize(buffer_count);
+    }
+
+    command_buffer& render_frame::buffer(size_t index)
+    {
+        return buffers_.at(index);
+    }
+
+    size_t render_frame::buffer_count() const
+    {
+        return buffers_.size();
+    }
+
+    size_t render_frame::command_count() const
+    {
+        size_t count(0);
+        for (const command_buffer& source : buffers_)
+            count += source.commands().size();
+        return count;
+    }
+
+    void render_frame::sort()
+    {
+        order_.clear();
+        order_.reserve(command_count());
+        for (size_t b(0); b < buffers_.size(); ++b)
+        {
+            const vector<render_command>& commands(buffers_[b].commands());
+            for (size_t i(0); i < commands.size(); ++i)
+                order_.push_back({commands[i].key, uint32_t(b), uint32_t(i)});
+        }
+
+        // the entries are generated in (buffer, index) order, so a stable sort on the key alone
+        // is deterministic; frames are usually recorded nearly sorted, which stable_sort likes
+        stable_sort(order_.begin(), order_.end(), [](const entry& a, const entry& b) { return a.key < b.key; });
+    }
+
+    size_t render_frame::state_changes(uint64_t state_mask) const
+    {
+        size_t changes(0);
+        for (size_t i(0); i < order_.size(); ++i)
+            if (i == 0 || ((order_[i].key ^ order_[i - 1].key) & state_mask) != 0)
+                ++changes;
+        return changes;
+    }
+
+    void render_frame::clear()
+    {
+        for (command_buffer& source : buffers_)
+            source.clear();
+        order_.clear();
+    }
+
+    render_queue::render_queue(size_t buffer_count)
+        : frames_{render_frame(buffer_count), render_frame(buffer_count)}, record_slot_(0), render_slot_(0),
+          recording_(false), rendering_(false), closed_(false)
+    {
+        for (atomic<uint32_t>& state : states_)
+            state.store(slot_free, memory_order_relaxed);
+    }
+
+    render_frame* render_queue::begin_recording()
+    {
+        if (recording_)
+            throw logic_error("The previous frame was not submitted");
+        while (states_[record_slot_].load(memory_order_acquire) != slot_free)
+        {
+            if (closed_.load(memory_order_acquire))
+                return nullptr;
+            this_thread::yield();
+        }
+        if (closed_.load(memory_order_acquire))
+            return nullptr;
+        recording_ = true;
+        render_frame& frame(frames_[record_slot_]);
+        frame.clear();
+        return &frame;
+    }
+
+    void render_queue::submit()
+    {
+        if (!recording_)
+            throw logic_error("No frame is being recorded");
+        frames_[record_slot_].sort();
+        recording_ = false;
+        states_[record_slot_].store(slot_ready, memory_order_release);
+        record_slot_ ^= 1;
+    }
+
+    render_frame* render_queue::try_acquire()
+    {
+        if (rendering_)
+            throw logic_error("The previous frame was not released");
+        if (states_[render_slot_].load(memory_order_acquire) != slot_ready)
+            return nullptr;
+        rendering_ = true;
+        return &frames_[render_slot_];
+    }
+
+    render_frame* render_queue::acquire()
+    {
+        while (true)
+        {
+            // checked before the slot, so a frame submitted just before close() is still drained
+            const bool was_closed(closed_.load(memory_order_acquire));
+            if (render_frame* frame = try_acquire())
+                return frame;
+            if (was_closed)
+                return nullptr;
+            this_thread::yield();
+        }
+    }
+
+    void render_queue::release()
+    {
+        if (!rendering_)
+            throw logic_error("No frame is acquired");
+        rendering_ = false;
+        states_[render_slot_].store(slot_free, memory_order_release);
+        render_slot_ ^= 1;
+    }
+
+    void render_queue::close()
+    {
+        closed_.store(true, memory_order_release);
+    }
+
+    bool render_queue::closed() const
+    {
+        return closed_.load(memory_order_acquire);
+    }
+} // engine_lib
@@ -0,0 +1,280 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+#include "../../includes.hpp"
+#include "../../containers/aligned_allocator/aligned_allocator.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Bits of a render key that select GPU state: the pipeline and the texture.
+     *
+     * The key is laid out, from the most significant bit, as layer (8 bits), pipeline
+     * (16 bits), texture (16 bits) and depth (24 bits). Sorting by key draws the layers in
+     * order and, within a layer, groups every command sharing a pipeline and then a texture,
+     * so state only changes where these bits change.
+     */
+    constexpr uint64_t render_key_state_mask = 0x00FFFFFFFF000000ull;
+
+    /**
+     * @brief Builds a sort key.
+     *
+     * @param layer Pass or layer, lower layers are drawn first.
+     * @param pipeline Shader and blend state.
+     * @param texture Bound texture.
+     * @param depth Quantized depth, see quantize_depth().
+     * @return The key.
+     * @throws out_of_range If depth does not fit into 24 bits.
+     */
+    uint64_t make_render_key(uint8_t layer, uint16_t pipeline, uint16_t texture, uint32_t depth);
+
+    /**
+     * @brief Quantizes a depth in [0, 1] to the 24 bits of a render key, clamping outside values.
+     *
+     * @param depth Normalized depth, zero at the near plane.
+     * @param back_to_front Inverts the order for translucent commands.
+     * @return The quantized depth.
+     */
+    uint32_t quantize_depth(float depth, bool back_to_front = false);
+
+    /**
+     * @brief Header of a recorded command.
+     */
+    struct render_command
+    {
+        uint64_t key; /// Sort key.
+        uint32_t type; /// Command type, defined by the renderer.
+        uint32_t size; /// Size of the payload in bytes.
+        size_t offset; /// Offset of the payload in the buffer data.
+    };
+
+    /**
+     * @class command_buffer
+     * @brief Linear buffer of commands with trivially copyable payloads, recorded by one thread.
+     *
+     * Recording only appends to two vectors whose capacity is kept by clear(), so a buffer
+     * reused frame after frame stops allocating once it has seen its largest frame.
+     */
+    class command_buffer
+    {
+        vector<render_command> commands_; /// Command headers in recording order.
+        aligned_vector<unsigned char> data_; /// Payloads and appended arrays.
+
+        size_t reserve_data(size_t size, size_t alignment);
+
+    public:
+        /**
+         * @brief Records a command.
+         *
+         * @tparam T Trivially copyable payload type.
+         * @param key Sort key.
+         * @param type Command type.
+         * @param payload Payload, copied into the buffer.
+         */
+        template <class T>
+        void record(uint64_t key, uint32_t type, const T& payload);
+
+        /**
+         * @brief Copies an array into the buffer, for payloads that refer to variable sized data.
+         *
+         * @tparam T Trivially copyable element type.
+         * @param items First element.
+         * @param count Number of elements.
+         * @return Offset of the copy, for data().
+         */
+        template <class T>
+        size_t append(const T* items, size_t count);
+
+        /**
+         * @brief Returns the payload of a command recorded into this buffer.
+         *
+         * @tparam T Payload type the command was recorded with.
+         * @param command The command.
+         * @return The payload, valid until the next change of the buffer.
+         */
+        template <class T>
+        [[nodiscard]] const T& payload(const render_command& command) const;
+
+        /**
+         * @brief Returns an array copied by append().
+         *
+         * @tparam T Element type the array was appended with.
+         * @param offset Offset returned by append().
+         * @return First element, valid until the next change of the buffer.
+         */
+        template <class T>
+        [[nodiscard]] const T* data(size_t offset) const;
+
+        /**
+         * @brief Removes every command, keeping the capacity.
+         */
+        void clear();
+
+        [[nodiscard]] const vector<render_command>& commands() const;
+        [[nodiscard]] size_t data_size() const;
+    };
+
+    /**
+     * @class render_frame
+     * @brief Commands of one frame: one command_buffer per recording thread, merged by key.
+     */
+    class render_frame
+    {
+        struct entry
+        {
+            uint64_t key; /// Sort key of the command.
+            uint32_t buffer; /// Buffer holding the command.
+            uint32_t index; /// Index of the command in its buffer.
+        };
+
+        vector<command_buffer> buffers_; /// One buffer per recording thread.
+        vector<entry> order_; /// Every command in key order, filled by sort().
+
+    public:
+        /**
+         * @brief Creates a frame with empty buffers.
+         *
+         * @param buffer_count Number of buffers, one per thread that records in parallel.
+         * @throws invalid_argument If buffer_count is zero.
+         */
+        explicit render_frame(size_t buffer_count = 1);
+
+        /**
+         * @brief Returns a buffer. Different threads may record into different buffers at once.
+         *
+         * @param index Index of the buffer.
+         * @return The buffer.
+         * @throws out_of_range If the buffer does not exist.
+         */
+        command_buffer& buffer(size_t index);
+
+        [[nodiscard]] size_t buffer_count() const;
+        [[nodiscard]] size_t command_count() const;
+
+        /**
+         * @brief Merges the buffers into key order.
+         *
+         * Commands with equal keys keep the order of their buffers and, within a buffer, the
+         * recording order, so the result does not depend on thread timing.
+         */
+        void sort();
+
+        /**
+         * @brief Calls visit(buffer, command) for every command in the order of the last sort().
+         *
+         * @param visit Callable taking (const command_buffer&, const render_command&).
+         */
+        template <class F>
+        void execute(F&& visit) const;
+
+        /**
+         * @brief Counts the state changes executing the sorted frame costs.
+         *
+         * @param state_mask Key bits that select state.
+         * @return Number of commands whose state bits differ from the previous command's,
+         * the first command included.
+         */
+        [[nodiscard]] size_t state_changes(uint64_t state_mask = render_key_state_mask) const;
+
+        /**
+         * @brief Clears every buffer and the order.
+         */
+        void clear();
+    };
+
+    /**
+     * @class render_queue
+     * @brief Two render_frames handed between one simulation and one render thread.
+     *
+     * The simulation thread records frame N + 1 while the render thread executes frame N. The
+     * handoff is a two slot single-producer single-consumer ring driven by one atomic state per
+     * slot, so neither side ever takes a lock; a side that runs ahead yields until the other
+     * releases a slot.
+     */
+    class render_queue
+    {
+        static constexpr uint32_t slot_free = 0; /// The simulation thread may record the frame.
+        static constexpr uint32_t slot_ready = 1; /// The render thread may execute the frame.
+
+        array<render_frame, 2> frames_; /// The two frames.
+        array<atomic<uint32_t>, 2> states_; /// slot_free or slot_ready, per frame.
+        size_t record_slot_; /// Next slot to record, simulation thread only.
+        size_t render_slot_; /// Next slot to render, render thread only.
+        bool recording_; /// Set between begin_recording() and submit().
+        bool rendering_; /// Set between acquire() and release().
+        atomic<bool> closed_; /// Set by close().
+
+    public:
+        /**
+         * @brief Creates a queue with two empty frames.
+         *
+         * @param buffer_count Buffers per frame, one per thread that records in parallel.
+         * @throws invalid_argument If buffer_count is zero.
+         */
+        explicit render_queue(size_t buffer_count = 1);
+
+        render_queue(const render_queue& other) = delete;
+        render_queue& operator=(const render_queue& other) = delete;
+
+        /**
+         * @brief Waits until a frame is free, clears it and hands it to the simulation thread.
+         *
+         * @return The frame to record, or nullptr once the queue is closed.
+         * @throws logic_error If the previous frame was not submitted.
+         */
+        render_frame* begin_recording();
+
+        /**
+         * @brief Sorts the recorded frame and publishes it to the render thread.
+         *
+         * @throws logic_error If no frame is being recorded.
+         */
+        void submit();
+
+        /**
+         * @brief Takes the oldest submitted frame if there is one.
+         *
+         * @return The frame to execute, or nullptr if none is ready.
+         * @throws logic_error If the previous frame was not released.
+         */
+        render_frame* try_acquire();
+
+        /**
+         * @brief Waits for the oldest submitted frame.
+         *
+         * @return The frame to execute, or nullptr once the queue is closed and drained.
+         * @throws logic_error If the previous frame was not released.
+         */
+        render_frame* acquire();
+
+        /**
+         * @brief Returns the executed frame to the simulation thread.
+         *
+         * @throws logic_error If no frame is acquired.
+         */
+        void release();
+
+        /**
+         * @brief Wakes both threads; begin_recording() returns nullptr from now on.
+         */
+        void close();
+
+        [[nodiscard]] bool closed() const;
+    };
+} // engine_lib
+
+#endif //RENDER_QUEUE_HPP
+#include "render_queue.inl"
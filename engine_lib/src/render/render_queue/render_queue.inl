@@ -0,0 +1,50 @@
+#ifndef RENDER_QUEUE_INL
+#define RENDER_QUEUE_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class T>
+    void command_buffer::record(uint64_t key, uint32_t type, const T& payload)
+    {
+        static_assert(is_trivially_copyable_v<T>, "Command payloads must be trivially copyable");
+        const size_t offset(reserve_data(sizeof(T), alignof(T)));
+        memcpy(data_.data() + offset, &payload, sizeof(T));
+        commands_.push_back({key, type, uint32_t(sizeof(T)), offset});
+    }
+
+    template <class T>
+    size_t command_buffer::append(const T* items, size_t count)
+    {
+        static_assert(is_trivially_copyable_v<T>, "Command data must be trivially copyable");
+        const size_t offset(reserve_data(count * sizeof(T), alignof(T)));
+        if (count != 0)
+            memcpy(data_.data() + offset, items, count * sizeof(T));
+        return offset;
+    }
+
+    template <class T>
+    const T& command_buffer::payload(const render_command& command) const
+    {
+        return *reinterpret_cast<const T*>(data_.data() + command.offset);
+    }
+
+    template <class T>
+    const T* command_buffer::data(size_t offset) const
+    {
+        return reinterpret_cast<const T*>(data_.data() + offset);
+    }
+
+    template <class F>
+    void render_frame::execute(F&& visit) const
+    {
+        for (const entry& e : order_)
+        {
+            const command_buffer& source(buffers_[e.buffer]);
+            visit(source, source.commands()[e.index]);
+        }
+    }
+} // engine_lib
+
+#endif //RENDER_QUEUE_INL
@@ -0,0 +1,148 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "sprite_batch.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace engine_lib
+{
+    static_assert(sizeof(sprite_vertex) == sizeof(SDL_Vertex), "sprite_vertex must match SDL_Vertex");
+    static_assert(offsetof(sprite_vertex, color) == offsetof(SDL_Vertex, color), "sprite_vertex must match SDL_Vertex");
+    static_assert(offsetof(sprite_vertex, uv) == offsetof(SDL_Vertex, tex_coord), "sprite_vertex must match SDL_Vertex");
+
+    sprite_batch::sprite_batch(size_t max_batch_quads) : max_batch_quads_(max_batch_quads), built_(true)
+    {
+        if (max_batch_quads == 0)
+            throw invalid_argument("A sprite batch needs room for at least one quad");
+    }
+
+    void sprite_batch::draw(uint32_t texture, const point<float, 2>& position, const array<float, 2>& size,
+                            float rotation, const array<float, 2>& pivot, const array<float, 4>& uv,
+                            const array<float, 4>& color, uint16_t layer)
+    {
+        const float c(cos(rotation)), s(sin(rotation));
+        const float x(position.coordinate(0)), y(position.coordinate(1));
+        array<sprite_vertex, 4>& quad(quads_.emplace_back());
+        // corners clockwise on screen from the top left, so the triangles are 0 1 2 and 2 3 0
+        const array<array<float, 2>, 4> corners{{{0, 0}, {1, 0}, {1, 1}, {0, 1}}};
+        for (size_t i(0); i < 4; ++i)
+        {
+            const float dx((corners[i][0] - pivot[0]) * size[0]);
+            const float dy((corners[i][1] - pivot[1]) * size[1]);
+            quad[i] = {{x + c * dx - s * dy, y + s * dx + c * dy}, color,
+                       {uv[corners[i][0] == 0 ? 0 : 2], uv[corners[i][1] == 0 ? 1 : 3]}};
+        }
+        order_.push_back({uint64_t(layer) << 32 | texture, uint32_t(quads_.size() - 1)});
+        built_ = false;
+    }
+
+    void sprite_batch::draw(uint32_t texture, const matrix<float, 3, 3>& transform, const array<float, 4>& uv,
+                            const array<float, 4>& color, uint16_t layer)
+    {
+        array<sprite_vertex, 4>& quad(quads_.emplace_back());
+        const array<array<float, 2>, 4> corners{{{0, 0}, {1, 0}, {1, 1}, {0, 1}}};
+        for (size_t i(0); i < 4; ++i)
+        {
+            const float u(corners[i][0]), v(corners[i][1]);
+            quad[i] = {{transform(0, 0) * u + transform(0, 1) * v + transform(0, 2),
+                        transform(1, 0) * u + transform(1, 1) * v + transform(1, 2)},
+                       color, {uv[u == 0 ? 0 : 2], uv[v == 0 ? 1 : 3]}};
+        }
+        order_.push_back({uint64_t(layer) << 32 | texture, uint32_t(quads_.size() - 1)});
+        built_ = false;
+    }
+
+    void sprite_batch::build()
+    {
+        // stable LSD radix sort over the 48 key bits, 16 at a time; the entries start in
+        // submission order, so equal layer and texture keep it, and passes over a digit that
+        // every key shares (usually the layer and the high texture bits) are skipped
+        scratch_.resize(order_.size());
+        vector<size_t> counts(size_t(1) << 16);
+        for (int shift(0); shift < 48; shift += 16)
+        {
+            fill(counts.begin(), counts.end(), 0);
+            for (const sort_entry& e : order_)
+                ++counts[(e.key >> shift) & 0xFFFF];
+            if (order_.empty() || counts[(order_[0].key >> shift) & 0xFFFF] == order_.size())
+                continue;
+            size_t offset(0);
+            for (size_t& count : counts)
+                offset += exchange(count, offset);
+            for (const sort_entry& e : order_)
+                scratch_[counts[(e.key >> shift) & 0xFFFF]++] = e;
+            order_.swap(scratch_);
+        }
+
+        vertices_.clear();
+        vertices_.reserve(quads_.size() * 4);
+        batches_.clear();
+        size_t longest(0);
+        for (size_t i(0); i < order_.size(); ++i)
+        {
+            vertices_.insert(vertices_.end(), quads_[order_[i].quad].begin(), quads_[order_[i].quad].end());
+            if (batches_.empty() || order_[i].key != order_[i - 1].key || batches_.back().quad_count == max_batch_quads_)
+                batches_.push_back({uint32_t(order_[i].key), 4 * i, 0});
+            longest = max(longest, ++batches_.back().quad_count);
+        }
+
+        for (size_t quad(indices_.size() / 6); quad < longest; ++quad)
+        {
+            const int first(int(4 * quad));
+            indices_.insert(indices_.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+        }
+        built_ = true;
+    }
+
+    size_t sprite_batch::submit(SDL_Renderer* renderer, const vector<SDL_Texture*>& textures)
+    {
+        if (!built_)
+            build();
+        for (const sprite_batch_range& batch : batches_)
+            if (batch.texture >= textures.size())
+                throw out_of_range("Sprite texture index out of range: " + to_string(batch.texture));
+        for (const sprite_batch_range& batch : batches_)
+            if (!SDL_RenderGeometry(renderer, textures[batch.texture],
+                                    reinterpret_cast<const SDL_Vertex*>(vertices_.data() + batch.first_vertex),
+                                    int(4 * batch.quad_count), indices_.data(), int(6 * batch.quad_count)))
+                throw runtime_error(string("Cannot draw sprites: ") + SDL_GetError());
+        return batches_.size();
+    }
+
+    void sprite_batch::clear()
+    {
+        quads_.clear();
+        order_.clear();
+        vertices_.clear();
+        batches_.clear();
+        built_ = true;
+    }
+
+    size_t sprite_batch::size() const
+    {
+        return quads_.size();
+    }
+
+    const vector<sprite_vertex>& sprite_batch::vertices() const
+    {
+        return vertices_;
+    }
+
+    const vector<int>& sprite_batch::indices() const
+    {
+        return indices_;
+    }
+
+    const vector<sprite_batch_range>& sprite_batch::batches() const
+    {
+        return batches_;
+    }
+} // engine_lib
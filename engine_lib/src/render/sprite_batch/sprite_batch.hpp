@@ -0,0 +1,134 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef SPRITE_BATCH_HPP
+#define SPRITE_BATCH_HPP
+#include "../../includes.hpp"
+#include "../../math/matrix/matrix.hpp"
+#include "../../math/point/point.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @brief Vertex of a sprite, laid out like SDL_Vertex so batches go to SDL without conversion.
+     */
+    struct sprite_vertex
+    {
+        array<float, 2> position; /// Position in pixels.
+        array<float, 4> color; /// RGBA color multiplied with the texture.
+        array<float, 2> uv; /// Texture coordinate.
+    };
+
+    /**
+     * @brief Quads sharing a texture, drawn by one SDL_RenderGeometry call.
+     */
+    struct sprite_batch_range
+    {
+        uint32_t texture; /// Texture index, see sprite_batch::submit().
+        size_t first_vertex; /// First vertex of the batch.
+        size_t quad_count; /// Number of quads.
+    };
+
+    /**
+     * @class sprite_batch
+     * @brief Collects textured quads and draws them with a few SDL_RenderGeometry calls.
+     *
+     * Sprites are drawn layer by layer, lower layers first. Within a layer the quads are
+     * regrouped by texture, so sprites of one layer must not rely on overlapping each other in
+     * submission order; sprites with equal layer and texture keep that order. Every quad uses
+     * the same six indices relative to its batch, so one shared index array serves all batches.
+     */
+    class sprite_batch
+    {
+        struct sort_entry
+        {
+            uint64_t key; /// Layer in the high half, texture in the low half.
+            uint32_t quad; /// Quad in submission order.
+        };
+
+        vector<array<sprite_vertex, 4>> quads_; /// Quads in submission order.
+        vector<sort_entry> order_; /// Sort key of every quad.
+        vector<sort_entry> scratch_; /// Second buffer of the radix sort.
+        vector<sprite_vertex> vertices_; /// Quads in draw order, filled by build().
+        vector<int> indices_; /// Two triangles per quad, relative to the batch.
+        vector<sprite_batch_range> batches_; /// Batches in draw order, filled by build().
+        size_t max_batch_quads_; /// Longest batch, longer runs of one texture are split.
+        bool built_; /// Set by build(), cleared by every change.
+
+    public:
+        /**
+         * @brief Creates an empty batch.
+         *
+         * @param max_batch_quads Largest number of quads per SDL_RenderGeometry call.
+         * @throws invalid_argument If max_batch_quads is zero.
+         */
+        explicit sprite_batch(size_t max_batch_quads = 1 << 16);
+
+        /**
+         * @brief Adds an axis aligned or rotated sprite.
+         *
+         * @param texture Texture index.
+         * @param position Pixel position of the pivot.
+         * @param size Width and height in pixels.
+         * @param rotation Rotation around the pivot in radians, clockwise on screen.
+         * @param pivot Pivot inside the sprite, (0, 0) top left, (1, 1) bottom right.
+         * @param uv Texture rectangle as (u0, v0, u1, v1).
+         * @param color RGBA color multiplied with the texture.
+         * @param layer Drawing layer, lower layers are drawn first.
+         */
+        void draw(uint32_t texture, const point<float, 2>& position, const array<float, 2>& size, float rotation = 0,
+                  const array<float, 2>& pivot = {0.5f, 0.5f}, const array<float, 4>& uv = {0, 0, 1, 1},
+                  const array<float, 4>& color = {1, 1, 1, 1}, uint16_t layer = 0);
+
+        /**
+         * @brief Adds a sprite placed by an affine transform of the unit square.
+         *
+         * @param texture Texture index.
+         * @param transform Maps the unit square (0, 0)-(1, 1) to pixels; the last row is ignored.
+         * @param uv Texture rectangle as (u0, v0, u1, v1).
+         * @param color RGBA color multiplied with the texture.
+         * @param layer Drawing layer, lower layers are drawn first.
+         */
+        void draw(uint32_t texture, const matrix<float, 3, 3>& transform, const array<float, 4>& uv = {0, 0, 1, 1},
+                  const array<float, 4>& color = {1, 1, 1, 1}, uint16_t layer = 0);
+
+        /**
+         * @brief Sorts the quads by layer and texture and builds the vertex array and batches.
+         */
+        void build();
+
+        /**
+         * @brief Draws the batches, calling build() first if needed.
+         *
+         * @param renderer Renderer to draw with.
+         * @param textures Texture of every index; a null entry draws the color alone.
+         * @return Number of SDL_RenderGeometry calls.
+         * @throws out_of_range If a sprite uses an index past the end of textures.
+         * @throws runtime_error If SDL fails to draw.
+         */
+        size_t submit(SDL_Renderer* renderer, const vector<SDL_Texture*>& textures);
+
+        /**
+         * @brief Removes every sprite, keeping the capacity.
+         */
+        void clear();
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] const vector<sprite_vertex>& vertices() const;
+        [[nodiscard]] const vector<int>& indices() const;
+        [[nodiscard]] const vector<sprite_batch_range>& batches() const;
+    };
+} // engine_lib
+
+#endif //SPRITE_BATCH_HPP
@@ -0,0 +1,69 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "thread_pool.hpp"
+
+namespace engine_lib
+{
+    thread_pool::thread_pool(size_t threads)
+        : stopping_(false)
+    {
+        if (threads == 0)
+            threads = max(1u, thread::hardware_concurrency());
+
+        workers_.reserve(threads);
+        for (size_t i(0); i < threads; ++i)
+            workers_.emplace_back([this] { worker_loop(); });
+    }
+
+    thread_pool::thread_pool(no_workers_t)
+        : stopping_(false)
+    {
+    }
+
+    thread_pool::~thread_pool()
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    size_t thread_pool::size() const
+    {
+        return workers_.size();
+    }
+
+    void thread_pool::worker_loop()
+    {
+        for (;;)
+        {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                    return;
+                task = move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    thread_pool& thread_pool::global()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    thread_pool& thread_pool::serial()
+    {
+        static thread_pool pool{no_workers_t{}};
+        return pool;
+    }
+} // engine_lib
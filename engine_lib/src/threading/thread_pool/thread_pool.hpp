@@ -0,0 +1,115 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+#include "../../includes.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace engine_lib
+{
+    using namespace std;
+
+    /**
+     * @class thread_pool
+     * @brief A fixed set of worker threads executing submitted tasks.
+     *
+     * Tasks are executed in FIFO order. parallel_for() splits an index range into
+     * chunks which are claimed by the workers and by the calling thread itself,
+     * so nested parallel_for() calls made from inside a task never deadlock.
+     */
+    class thread_pool
+    {
+        vector<thread> workers_; /// Worker threads.
+        queue<function<void()>> tasks_; /// Pending tasks.
+        mutex mutex_; /// Guards tasks_ and stopping_.
+        condition_variable condition_; /// Signalled when a task arrives or the pool stops.
+        bool stopping_; /// Set once the destructor starts.
+
+        struct no_workers_t {};
+
+        explicit thread_pool(no_workers_t);
+
+        void worker_loop();
+
+    public:
+        /**
+         * @brief Starts the given number of worker threads.
+         *
+         * The workers are helpers: parallel_for() also runs chunks on the calling thread,
+         * so a pool of n workers spreads a range over n + 1 threads.
+         *
+         * @param threads Number of helper threads. Zero selects hardware_concurrency().
+         */
+        explicit thread_pool(size_t threads = 0);
+
+        thread_pool(const thread_pool& other) = delete;
+        thread_pool& operator=(const thread_pool& other) = delete;
+
+        /**
+         * @brief Finishes the queued tasks and joins the workers.
+         */
+        ~thread_pool();
+
+        /**
+         * @brief Returns the number of worker threads.
+         *
+         * @return Number of worker threads.
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief Queues a task for execution on a worker thread.
+         *
+         * A pool without workers runs the task on the calling thread before returning.
+         *
+         * @param task Callable without arguments.
+         * @return A future holding the task result or its exception.
+         */
+        template <class F>
+        future<invoke_result_t<decay_t<F>>> submit(F&& task);
+
+        /**
+         * @brief Calls body(chunk_begin, chunk_end) for consecutive chunks covering [begin, end).
+         *
+         * The calling thread takes part in the work and returns once every chunk is done.
+         * The first exception thrown by body is rethrown here.
+         *
+         * @param begin First index of the range.
+         * @param end One past the last index of the range.
+         * @param grain Maximum number of indices per chunk. Zero picks one chunk per thread.
+         * @param body Callable taking (size_t chunk_begin, size_t chunk_end).
+         */
+        template <class F>
+        void parallel_for(size_t begin, size_t end, size_t grain, F&& body);
+
+        /**
+         * @brief Returns the process-wide pool sized to the hardware concurrency.
+         *
+         * @return Reference to the shared pool.
+         */
+        static thread_pool& global();
+
+        /**
+         * @brief Returns the process-wide pool without workers, running everything on the caller.
+         *
+         * @return Reference to the serial pool.
+         */
+        static thread_pool& serial();
+    };
+} // engine_lib
+
+#endif //THREAD_POOL_HPP
+#include "thread_pool.inl"
@@ -0,0 +1,103 @@
+#ifndef THREAD_POOL_INL
+#define THREAD_POOL_INL
+
+namespace engine_lib
+{
+    using namespace std;
+
+    template <class F>
+    future<invoke_result_t<decay_t<F>>> thread_pool::submit(F&& task)
+    {
+        using result_type = invoke_result_t<decay_t<F>>;
+        auto packaged(make_shared<packaged_task<result_type()>>(forward<F>(task)));
+        future<result_type> result(packaged->get_future());
+        if (workers_.empty())
+        {
+            (*packaged)();
+            return result;
+        }
+        {
+            lock_guard<mutex> lock(mutex_);
+            if (stopping_)
+                throw runtime_error("Cannot submit to a stopping thread pool");
+            tasks_.emplace([packaged] { (*packaged)(); });
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+    template <class F>
+    void thread_pool::parallel_for(size_t begin, size_t end, size_t grain, F&& body)
+    {
+        if (begin >= end)
+            return;
+
+        const size_t count(end - begin);
+        if (grain == 0)
+            grain = (count + workers_.size()) / (workers_.size() + 1);
+        if (grain == 0)
+            grain = 1;
+        const size_t chunks((count + grain - 1) / grain);
+
+        if (chunks == 1 || workers_.empty())
+        {
+            for (size_t first(begin); first < end; first += grain)
+                body(first, min(first + grain, end));
+            return;
+        }
+
+        // shared between the caller and the helpers, helpers may outlive the call
+        struct job
+        {
+            atomic<size_t> next{0};
+            atomic<size_t> done{0};
+            mutex mutex_;
+            condition_variable finished;
+            exception_ptr error;
+        };
+        auto state(make_shared<job>());
+
+        auto run = [state, begin, end, grain, chunks, &body]
+        {
+            for (size_t chunk(state->next++); chunk < chunks; chunk = state->next++)
+            {
+                const size_t first(begin + chunk * grain);
+                try
+                {
+                    body(first, min(first + grain, end));
+                }
+                catch (...)
+                {
+                    lock_guard<mutex> lock(state->mutex_);
+                    if (!state->error)
+                        state->error = current_exception();
+                }
+                if (++state->done == chunks)
+                {
+                    lock_guard<mutex> lock(state->mutex_);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        const size_t helpers(min(workers_.size(), chunks - 1));
+        {
+            lock_guard<mutex> lock(mutex_);
+            for (size_t i(0); i < helpers; ++i)
+                tasks_.emplace(run);
+        }
+        if (helpers == 1)
+            condition_.notify_one();
+        else
+            condition_.notify_all();
+
+        run();
+
+        unique_lock<mutex> lock(state->mutex_);
+        state->finished.wait(lock, [&state, chunks] { return state->done.load() == chunks; });
+        if (state->error)
+            rethrow_exception(state->error);
+    }
+} // engine_lib
+
+#endif
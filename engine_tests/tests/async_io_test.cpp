@@ -0,0 +1,144 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "async_io/async_io.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    std::string temporary_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("engine_tests_" + name)).string();
+    }
+
+    // bytes 0, 1, ..., 250, 0, 1, ... so every offset is recognizable
+    std::vector<unsigned char> pattern(size_t size)
+    {
+        std::vector<unsigned char> data(size);
+        for (size_t i = 0; i < size; ++i)
+            data[i] = static_cast<unsigned char>(i % 251);
+        return data;
+    }
+
+    std::string write_pattern(const std::string& name, size_t size)
+    {
+        const std::string path(temporary_path(name));
+        const std::vector<unsigned char> data(pattern(size));
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()),
+                                                   std::streamsize(data.size()));
+        return path;
+    }
+}
+
+TEST(async_io_test, reads_match_the_file_on_every_backend)
+{
+    using namespace el;
+    const std::string path(write_pattern("async.bin", 3 * 65536 + 123));
+    const std::vector<unsigned char> expected(pattern(3 * 65536 + 123));
+
+    for (io_backend backend : {io_backend::pread, io_backend::automatic})
+    {
+        thread_pool callbacks(2);
+        async_io_options options;
+        options.backend = backend;
+        options.chunk_size = 65536;
+        async_io io(callbacks, options);
+        EXPECT_NE(io.backend(), io_backend::automatic);
+
+        std::mutex mutex;
+        std::vector<io_result> results(3);
+        io.read(path, io_priority::normal, [&](io_result result)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results[0] = std::move(result);
+        });
+        io.read(path, 65530, 20, io_priority::high, [&](io_result result)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results[1] = std::move(result);
+        });
+        io.read(temporary_path("missing.bin"), io_priority::low, [&](io_result result)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results[2] = std::move(result);
+        });
+        io.wait_idle();
+        EXPECT_EQ(io.pending(), 0);
+
+        EXPECT_EQ(results[0].status, io_status::completed);
+        EXPECT_EQ(results[0].data, expected);
+        EXPECT_EQ(results[1].status, io_status::completed);
+        EXPECT_EQ(results[1].data, std::vector<unsigned char>(expected.begin() + 65530, expected.begin() + 65550));
+        EXPECT_EQ(results[2].status, io_status::failed);
+        EXPECT_FALSE(results[2].error.empty());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(async_io_test, priorities_and_cancellation)
+{
+    using namespace el;
+    const std::string path(write_pattern("async_order.bin", 4096));
+
+    // one chunk in flight and one callback thread make the completion order the issue order
+    thread_pool callbacks(1);
+    async_io_options options;
+    options.queue_depth = 1;
+    async_io io(callbacks, options);
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name)
+    {
+        return [&, name](io_result result)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name + (result.status == io_status::cancelled ? " cancelled" : ""));
+        };
+    };
+
+    io.pause();
+    io.read(path, io_priority::low, record("low"));
+    const uint64_t dropped(io.read(path, io_priority::high, record("dropped")));
+    io.read(path, io_priority::normal, record("normal 1"));
+    io.read(path, io_priority::critical, record("critical"));
+    io.read(path, io_priority::normal, record("normal 2"));
+    EXPECT_EQ(io.pending(), 5);
+    EXPECT_TRUE(io.cancel(dropped));
+    EXPECT_FALSE(io.cancel(dropped));
+    EXPECT_FALSE(io.cancel(12345));
+    io.resume();
+    io.wait_idle();
+
+    EXPECT_EQ(order, std::vector<std::string>({"dropped cancelled", "critical", "normal 1", "normal 2", "low"}));
+    EXPECT_THROW(io.read(path, io_priority::low, io_callback()), std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST(async_io_test, bandwidth_limiter)
+{
+    using namespace el;
+    using namespace std::chrono;
+    const steady_clock::time_point start(steady_clock::now() + seconds(1));
+    auto in_milliseconds = [](nanoseconds wait) { return duration<double, std::milli>(wait).count(); };
+
+    bandwidth_limiter unlimited;
+    EXPECT_TRUE(unlimited.unlimited());
+    EXPECT_EQ(unlimited.try_acquire(1 << 30, start).count(), 0);
+
+    // 1000 bytes per second, bucket of 100 bytes
+    bandwidth_limiter limiter(1000, 100);
+    EXPECT_EQ(limiter.try_acquire(60, start).count(), 0);
+    EXPECT_EQ(limiter.try_acquire(40, start).count(), 0);
+    EXPECT_NEAR(in_milliseconds(limiter.try_acquire(50, start)), 50, 1e-3);
+    EXPECT_EQ(limiter.try_acquire(50, start + milliseconds(50)).count(), 0);
+
+    // larger than the bucket: waits for a full bucket, then leaves a debt of 400 bytes
+    EXPECT_NEAR(in_milliseconds(limiter.try_acquire(500, start + milliseconds(50))), 100, 1e-3);
+    EXPECT_EQ(limiter.try_acquire(500, start + milliseconds(150)).count(), 0);
+    EXPECT_NEAR(in_milliseconds(limiter.try_acquire(10, start + milliseconds(150))), 410, 1e-3);
+}
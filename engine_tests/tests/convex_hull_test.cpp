@@ -0,0 +1,100 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "convex_hull/convex_hull.hpp"
+#include "predicates/predicates.hpp"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <set>
+
+namespace
+{
+    std::vector<std::array<double, 3>> ball(size_t count, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> coordinate(-1, 1);
+        std::vector<std::array<double, 3>> points;
+        while (points.size() < count)
+        {
+            const std::array<double, 3> p{coordinate(random), coordinate(random), coordinate(random)};
+            if (p[0] * p[0] + p[1] * p[1] + p[2] * p[2] <= 1)
+                points.push_back(p);
+        }
+        return points;
+    }
+
+    // every stride-th point on or below every face, and every edge shared by exactly two faces in
+    // opposite directions
+    void expect_closed_convex(const std::vector<std::array<double, 3>>& points,
+                              const std::vector<std::array<uint32_t, 3>>& hull, size_t stride = 1)
+    {
+        std::map<std::pair<uint32_t, uint32_t>, int> edges;
+        std::set<uint32_t> corners;
+        for (const auto& face : hull)
+            for (size_t i = 0; i < 3; ++i)
+            {
+                ++edges[{face[i], face[(i + 1) % 3]}];
+                corners.insert(face[i]);
+            }
+        for (const auto& [edge, count] : edges)
+        {
+            EXPECT_EQ(count, 1);
+            EXPECT_EQ(edges.count({edge.second, edge.first}), 1u);
+        }
+        // a closed triangulated sphere
+        EXPECT_EQ(hull.size(), 2 * corners.size() - 4);
+        for (const auto& face : hull)
+            for (size_t i = 0; i < points.size(); i += stride)
+                ASSERT_GE(el::orient3d(points[face[0]], points[face[1]], points[face[2]], points[i]), 0);
+    }
+}
+
+TEST(convex_hull_test, hull_of_a_box_filled_with_points)
+{
+    using namespace el;
+    auto points(ball(2000, 1));
+    for (int corner = 0; corner < 8; ++corner)
+        points.push_back({corner & 1 ? 2.0 : -2.0, corner & 2 ? 2.0 : -2.0, corner & 4 ? 2.0 : -2.0});
+    const auto hull(convex_hull(points));
+    EXPECT_EQ(hull.size(), 12u);
+    for (const auto& face : hull)
+        for (const uint32_t corner : face)
+            EXPECT_GE(corner, 2000u);
+    expect_closed_convex(points, hull);
+}
+
+TEST(convex_hull_test, coplanar_points_on_the_surface_stay_closed)
+{
+    using namespace el;
+    // a grid on every side of a cube puts many points on each hull plane
+    std::vector<point<float, 3>> points;
+    for (int x = 0; x <= 8; ++x)
+        for (int y = 0; y <= 8; ++y)
+            for (int z = 0; z <= 8; ++z)
+                if (x % 8 == 0 || y % 8 == 0 || z % 8 == 0)
+                    points.emplace_back(array<float, 3>({x * 0.1f, y * 0.1f, z * 0.1f}));
+    const auto hull(convex_hull(points));
+    std::vector<std::array<double, 3>> converted;
+    for (const auto& p : points)
+        converted.push_back({p.coordinate(0), p.coordinate(1), p.coordinate(2)});
+    expect_closed_convex(converted, hull);
+    std::set<uint32_t> corners;
+    for (const auto& face : hull)
+        corners.insert(face.begin(), face.end());
+    EXPECT_EQ(corners.size(), 8u);
+
+    const std::vector<std::array<double, 3>> flat{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0.5, 0.5, 0}};
+    EXPECT_THROW(static_cast<void>(convex_hull(flat)), std::invalid_argument);
+}
+
+TEST(convex_hull_test, chunked_hull_is_closed_and_convex)
+{
+    using namespace el;
+    // enough points to be cut into chunks
+    const auto points(ball(100000, 2));
+    const auto hull(convex_hull(points));
+    expect_closed_convex(points, hull, 17);
+}
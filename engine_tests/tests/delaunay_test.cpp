@@ -0,0 +1,149 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "convex_hull/convex_hull.hpp"
+#include "delaunay/delaunay.hpp"
+#include "predicates/predicates.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+
+namespace
+{
+    // every interior edge is locally Delaunay, which makes the whole triangulation Delaunay
+    void expect_delaunay(const std::vector<std::array<double, 2>>& points,
+                         const std::vector<std::array<uint32_t, 3>>& triangles)
+    {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> opposite;
+        for (const auto& t : triangles)
+        {
+            ASSERT_GT(el::orient2d(points[t[0]], points[t[1]], points[t[2]]), 0);
+            for (size_t i = 0; i < 3; ++i)
+                ASSERT_TRUE(opposite.emplace(std::make_pair(t[i], t[(i + 1) % 3]), t[(i + 2) % 3]).second);
+        }
+        for (const auto& t : triangles)
+            for (size_t i = 0; i < 3; ++i)
+            {
+                if (const auto other(opposite.find({t[(i + 1) % 3], t[i]})); other != opposite.end())
+                {
+                    ASSERT_LE(el::incircle(points[t[0]], points[t[1]], points[t[2]], points[other->second]), 0);
+                }
+            }
+    }
+
+    // as above with faces, and the tetrahedra filling the convex hull
+    void expect_delaunay(const std::vector<std::array<double, 3>>& points,
+                         const std::vector<std::array<uint32_t, 4>>& tetrahedra)
+    {
+        std::map<std::array<uint32_t, 3>, std::pair<size_t, uint32_t>> faces;
+        double volume = 0;
+        for (size_t c = 0; c < tetrahedra.size(); ++c)
+        {
+            const auto& t(tetrahedra[c]);
+            const double orientation(el::orient3d(points[t[0]], points[t[1]], points[t[2]], points[t[3]]));
+            ASSERT_GT(orientation, 0);
+            volume += orientation / 6;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                std::array<uint32_t, 3> face;
+                for (size_t j = 0, k = 0; j < 4; ++j)
+                    if (j != i)
+                        face[k++] = t[j];
+                std::sort(face.begin(), face.end());
+                const auto [other, inserted] = faces.emplace(face, std::make_pair(c, t[i]));
+                if (!inserted)
+                {
+                    const auto& u(tetrahedra[other->second.first]);
+                    ASSERT_LE(el::insphere(points[t[0]], points[t[1]], points[t[2]], points[t[3]],
+                                           points[other->second.second]), 0);
+                    ASSERT_LE(el::insphere(points[u[0]], points[u[1]], points[u[2]], points[u[3]], points[t[i]]), 0);
+                }
+            }
+        }
+        double hull_volume = 0;
+        for (const auto& f : el::convex_hull(points))
+            hull_volume += el::orient3d(points[f[0]], points[f[1]], points[f[2]], {0, 0, 0}) / 6;
+        EXPECT_NEAR(volume, hull_volume, 1e-9 * hull_volume);
+    }
+}
+
+TEST(delaunay_test, random_points_in_the_plane)
+{
+    using namespace el;
+    std::mt19937 random(3);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    // enough points for several runs merged in parallel
+    std::vector<std::array<double, 2>> points(20000);
+    for (auto& p : points)
+        p = {coordinate(random), coordinate(random)};
+    const auto triangles(delaunay_triangulation(points));
+    expect_delaunay(points, triangles);
+
+    // 2n - 2 - h triangles for n points with h on the hull, which own the edges without a twin
+    std::map<std::pair<uint32_t, uint32_t>, int> edges;
+    for (const auto& t : triangles)
+        for (size_t i = 0; i < 3; ++i)
+            edges[{std::min(t[i], t[(i + 1) % 3]), std::max(t[i], t[(i + 1) % 3])}]++;
+    const auto hull_edges(std::count_if(edges.begin(), edges.end(), [](const auto& e) { return e.second == 1; }));
+    EXPECT_EQ(triangles.size(), 2 * points.size() - 2 - size_t(hull_edges));
+}
+
+TEST(delaunay_test, grid_repeats_and_collinear_points_in_the_plane)
+{
+    using namespace el;
+    // every grid square is cocircular, and every point is repeated
+    std::vector<point<float, 2>> grid;
+    for (int y = 0; y < 40; ++y)
+        for (int x = 0; x < 40; ++x)
+            grid.emplace_back(array<float, 2>({x * 0.1f, y * 0.1f}));
+    grid.insert(grid.end(), grid.begin(), grid.end());
+    const auto triangles(delaunay_triangulation(grid));
+    EXPECT_EQ(triangles.size(), 2u * 39 * 39);
+    std::vector<std::array<double, 2>> converted;
+    for (const auto& p : grid)
+        converted.push_back({p.coordinate(0), p.coordinate(1)});
+    expect_delaunay(converted, triangles);
+    for (const auto& t : triangles)
+        for (const uint32_t v : t)
+            EXPECT_LT(v, 1600u);
+
+    const std::vector<std::array<double, 2>> line{{0, 0}, {1, 1}, {0.25, 0.25}, {3, 3}};
+    EXPECT_TRUE(delaunay_triangulation(line).empty());
+}
+
+TEST(delaunay_test, random_points_in_space)
+{
+    using namespace el;
+    std::mt19937 random(4);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    std::vector<std::array<double, 3>> points(3000);
+    for (auto& p : points)
+        p = {coordinate(random), coordinate(random), coordinate(random)};
+    const auto tetrahedra(delaunay_tetrahedralization(points));
+    expect_delaunay(points, tetrahedra);
+}
+
+TEST(delaunay_test, grid_and_coplanar_points_in_space)
+{
+    using namespace el;
+    // cubes of eight cospherical points, some of them repeated
+    std::vector<std::array<double, 3>> grid;
+    for (int z = 0; z < 6; ++z)
+        for (int y = 0; y < 6; ++y)
+            for (int x = 0; x < 6; ++x)
+                grid.push_back({x * 0.5, y * 0.5, z * 0.5});
+    grid.insert(grid.end(), grid.begin(), grid.begin() + 50);
+    const auto tetrahedra(delaunay_tetrahedralization(grid));
+    expect_delaunay(grid, tetrahedra);
+    for (const auto& t : tetrahedra)
+        for (const uint32_t v : t)
+            EXPECT_LT(v, 216u);
+
+    const std::vector<point<double, 3>> flat{point<double, 3>({0, 0, 1}), point<double, 3>({1, 0, 1}),
+                                             point<double, 3>({0, 1, 1}), point<double, 3>({1, 1, 1})};
+    EXPECT_TRUE(delaunay_tetrahedralization(flat).empty());
+}
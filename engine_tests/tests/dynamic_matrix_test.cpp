@@ -0,0 +1,88 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "dynamic_matrix/dynamic_matrix.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+    template <class T>
+    el::dynamic_matrix<T> sequence_matrix(size_t rows, size_t columns, int seed)
+    {
+        el::dynamic_matrix<T> result(rows, columns);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < columns; ++j)
+                result(i, j) = T(int((i * 7 + j * 3 + seed) % 11) - 5);
+        return result;
+    }
+
+    template <class T>
+    el::dynamic_matrix<T> naive_product(const el::dynamic_matrix<T>& a, const el::dynamic_matrix<T>& b)
+    {
+        el::dynamic_matrix<T> result(a.rows(), b.columns());
+        for (size_t i = 0; i < a.rows(); ++i)
+            for (size_t j = 0; j < b.columns(); ++j)
+                for (size_t k = 0; k < a.columns(); ++k)
+                    result(i, j) += a(i, k) * b(k, j);
+        return result;
+    }
+}
+
+TEST(dynamic_matrix_test, rows_are_aligned)
+{
+    using namespace el;
+    dynamic_matrix<float> m(3, 5);
+    EXPECT_EQ(m.rows(), 3);
+    EXPECT_EQ(m.columns(), 5);
+    EXPECT_GE(m.stride(), 5);
+    for (size_t i = 0; i < m.rows(); ++i)
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(m.row_data(i)) % cache_line_size, 0u);
+    EXPECT_THROW(m(3, 0), std::out_of_range);
+}
+
+TEST(dynamic_matrix_test, gemm_matches_naive_product_on_edge_sizes)
+{
+    using namespace el;
+    thread_pool threaded(3);
+    for (thread_pool* pool : {&threaded, &thread_pool::serial()})
+        for (size_t size : {1, 7, 37, 100, 300})
+        {
+            auto a(sequence_matrix<float>(size, size + 3, 1));
+            auto b(sequence_matrix<float>(size + 3, size + 1, 2));
+            dynamic_matrix<float> c;
+            gemm(a, b, c, *pool);
+            auto expected(naive_product(a, b));
+            ASSERT_EQ(c.rows(), expected.rows());
+            ASSERT_EQ(c.columns(), expected.columns());
+            for (size_t i = 0; i < c.rows(); ++i)
+                for (size_t j = 0; j < c.columns(); ++j)
+                    EXPECT_EQ(c(i, j), expected(i, j));
+        }
+}
+
+TEST(dynamic_matrix_test, gemm_generic_type)
+{
+    using namespace el;
+    auto a(sequence_matrix<double>(41, 19, 3));
+    auto b(sequence_matrix<double>(19, 23, 4));
+    auto c(a * b);
+    auto expected(naive_product(a, b));
+    for (size_t i = 0; i < c.rows(); ++i)
+        for (size_t j = 0; j < c.columns(); ++j)
+            EXPECT_EQ(c(i, j), expected(i, j));
+    EXPECT_THROW(b * b, std::invalid_argument);
+}
+
+TEST(dynamic_matrix_test, fixed_matrix_round_trip)
+{
+    using namespace el;
+    matrix<int, 2, 3> fixed(array<array<int, 3>, 2>({{{1, 2, 3}, {4, 5, 6}}}));
+    dynamic_matrix<int> dynamic(fixed);
+    EXPECT_EQ(dynamic(1, 2), 6);
+
+    auto back(dynamic.transposed_matrix().to_matrix<3, 2>());
+    EXPECT_EQ(back(2, 1), 6);
+    EXPECT_EQ(back(0, 1), 4);
+    EXPECT_THROW((dynamic.to_matrix<3, 3>()), std::invalid_argument);
+}
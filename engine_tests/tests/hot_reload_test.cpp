@@ -0,0 +1,158 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "hot_reload/hot_reload.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    std::string temporary_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("engine_tests_" + name)).string();
+    }
+
+    void write_text(const std::string& path, const std::string& text)
+    {
+        std::ofstream(path) << text;
+    }
+
+    // a config file holding one number; counts the loads
+    struct number_loader
+    {
+        std::shared_ptr<std::atomic<int>> loads = std::make_shared<std::atomic<int>>(0);
+
+        int operator()(const std::string& path) const
+        {
+            ++*loads;
+            int value;
+            if (!(std::ifstream(path) >> value))
+                throw std::runtime_error("not a number");
+            return value;
+        }
+    };
+
+    // polls until the reloader queued count versions or a few seconds passed
+    bool wait_pending(const el::hot_reloader& reloader, size_t count)
+    {
+        for (int i = 0; i < 500 && reloader.pending() < count; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return reloader.pending() >= count;
+    }
+
+    el::hot_reload_options fast(el::watch_backend backend)
+    {
+        el::hot_reload_options options;
+        options.backend = backend;
+        options.settle = std::chrono::milliseconds(20);
+        options.poll_interval = std::chrono::milliseconds(20);
+        return options;
+    }
+}
+
+TEST(hot_reload_test, reloads_only_changed_files_on_every_backend)
+{
+    using namespace el;
+
+    for (const watch_backend backend : {watch_backend::automatic, watch_backend::polling})
+    {
+        const std::string scene(temporary_path("hot_scene.txt")), config(temporary_path("hot_config.txt"));
+        write_text(scene, "1");
+        write_text(config, "10");
+        hot_reloader reloader(fast(backend));
+        const number_loader scene_loader, config_loader;
+        const auto scene_value(reloader.watch<int>(scene, scene_loader));
+        const auto config_value(reloader.watch<int>(config, config_loader));
+        EXPECT_EQ(*scene_value, 1);
+        EXPECT_EQ(*config_value, 10);
+        EXPECT_EQ(scene_value.version(), 0u);
+
+        write_text(scene, "22");
+        ASSERT_TRUE(wait_pending(reloader, 1));
+        // the new version waits for the frame boundary
+        EXPECT_EQ(*scene_value, 1);
+        const auto previous(scene_value.pin());
+        EXPECT_EQ(reloader.apply(), 1u);
+        EXPECT_EQ(*scene_value, 22);
+        EXPECT_EQ(scene_value.version(), 1u);
+        EXPECT_EQ(*previous, 1);
+        EXPECT_EQ(reloader.apply(), 0u);
+        EXPECT_EQ(*config_loader.loads, 1);
+        EXPECT_EQ(config_value.version(), 0u);
+        EXPECT_EQ(reloader.reloads(), 1u);
+        std::filesystem::remove(scene);
+        std::filesystem::remove(config);
+    }
+}
+
+TEST(hot_reload_test, reloads_of_one_frame_apply_together)
+{
+    using namespace el;
+
+    const std::string first(temporary_path("hot_first.txt")), second(temporary_path("hot_second.txt"));
+    write_text(first, "1");
+    write_text(second, "2");
+    hot_reloader reloader(fast(watch_backend::automatic));
+    const auto a(reloader.watch<int>(first, number_loader()));
+    const auto b(reloader.watch<int>(second, number_loader()));
+    // the same file may feed several assets
+    const auto text(reloader.watch<std::string>(first, [](const std::string& path)
+    {
+        std::string content;
+        std::ifstream(path) >> content;
+        return content;
+    }));
+
+    // a save through a temporary file renamed over the watched one
+    write_text(first + ".tmp", "3");
+    std::filesystem::rename(first + ".tmp", first);
+    write_text(second, "4");
+    ASSERT_TRUE(wait_pending(reloader, 3));
+    EXPECT_EQ(*a + *b, 3);
+    EXPECT_EQ(reloader.apply(), 3u);
+    EXPECT_EQ(*a, 3);
+    EXPECT_EQ(*b, 4);
+    EXPECT_EQ(*text, "3");
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST(hot_reload_test, failed_reloads_keep_the_live_version)
+{
+    using namespace el;
+
+    const std::string path(temporary_path("hot_broken.txt"));
+    write_text(path, "5");
+    hot_reloader reloader(fast(watch_backend::automatic));
+    const auto value(reloader.watch<int>(path, number_loader()));
+
+    write_text(path, "five");
+    for (int i = 0; i < 500 && reloader.take_errors().empty(); ++i)
+    {
+        ASSERT_LT(i, 499);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(reloader.apply(), 0u);
+    EXPECT_EQ(*value, 5);
+
+    write_text(path, "6");
+    ASSERT_TRUE(wait_pending(reloader, 1));
+    reloader.apply();
+    EXPECT_EQ(*value, 6);
+    std::filesystem::remove(path);
+
+    // the first load runs on the caller and its failure leaves nothing watched
+    write_text(path, "x");
+    EXPECT_THROW(static_cast<void>(reloader.watch<int>(path, number_loader())), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(reloader.watch<int>(path, nullptr)), std::invalid_argument);
+    std::filesystem::remove(path);
+
+    hot_reload_options options;
+    options.poll_interval = std::chrono::milliseconds(0);
+    EXPECT_THROW(hot_reloader{options}, std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(hot_asset<int>().get()), std::logic_error);
+}
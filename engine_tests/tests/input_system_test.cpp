@@ -0,0 +1,162 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "input_system/input_system.hpp"
+#include "gtest/gtest.h"
+
+#include <SDL3/SDL.h>
+
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+namespace
+{
+    std::string temporary_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("engine_tests_" + name)).string();
+    }
+}
+
+TEST(input_system_test, ring_buffer_hands_elements_between_threads)
+{
+    using namespace el;
+    EXPECT_THROW(ring_buffer<int>(0), std::invalid_argument);
+
+    ring_buffer<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(ring.try_push(i));
+    EXPECT_FALSE(ring.try_push(4));
+    int value = -1;
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_push(4));
+    EXPECT_EQ(ring.size(), 4u);
+    for (int i = 1; i <= 4; ++i)
+    {
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+
+    // every element arrives once and in order, however the threads interleave
+    constexpr int count = 200000;
+    ring_buffer<int> shared(64);
+    std::thread producer([&]
+    {
+        for (int i = 0; i < count; ++i)
+            while (!shared.try_push(i))
+                std::this_thread::yield();
+    });
+    int expected = 0;
+    while (expected < count)
+        if (shared.try_pop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+            std::this_thread::yield();
+    producer.join();
+}
+
+TEST(input_system_test, snapshots_keep_state_and_transitions)
+{
+    using namespace el;
+    input_system input(8);
+
+    // a tap within one tick is pressed and released but never held
+    input.push({input_event_type::key_down, 44, 0, 0});
+    input.push({input_event_type::key_up, 44, 0, 0});
+    input.push({input_event_type::key_down, 4, 0, 0});
+    input.push({input_event_type::mouse_motion, 0, 10, 20});
+    input.push({input_event_type::mouse_button_down, 0, 12, 20});
+    input.push({input_event_type::mouse_wheel, 0, 0, 2});
+    input.push({input_event_type::gamepad_axis, 1, 2.0f, 0});
+    input.push({input_event_type::key_down, 9999, 0, 0});
+    EXPECT_FALSE(input.push({input_event_type::quit, 0, 0, 0}));
+    EXPECT_EQ(input.dropped(), 1u);
+
+    const input_snapshot& first(input.tick(0.016f));
+    EXPECT_EQ(first.tick, 1u);
+    EXPECT_EQ(first.event_count, 8u);
+    EXPECT_TRUE(first.key_pressed(44));
+    EXPECT_TRUE(first.key_released(44));
+    EXPECT_FALSE(first.key_down(44));
+    EXPECT_TRUE(first.key_down(4));
+    EXPECT_TRUE(first.key_pressed(4));
+    EXPECT_FALSE(first.key_down(9999));
+    EXPECT_TRUE(first.mouse_button_pressed(0));
+    EXPECT_EQ(first.mouse_x, 12.0f);
+    EXPECT_EQ(first.mouse_dx, 12.0f);
+    EXPECT_EQ(first.wheel_y, 2.0f);
+    EXPECT_EQ(first.gamepad_axes[1], 1.0f);
+    EXPECT_EQ(first.quit, 0);
+
+    // held state carries over, transitions and deltas do not
+    input.push({input_event_type::key_down, 4, 0, 0});
+    input.push({input_event_type::gamepad_button_down, 3, 0, 0});
+    const input_snapshot& second(input.tick(0.02f));
+    EXPECT_EQ(second.tick, 2u);
+    EXPECT_EQ(second.dt, 0.02f);
+    EXPECT_TRUE(second.key_down(4));
+    EXPECT_FALSE(second.key_pressed(4));
+    EXPECT_TRUE(second.mouse_button_down(0));
+    EXPECT_FALSE(second.mouse_button_pressed(0));
+    EXPECT_EQ(second.mouse_dx, 0.0f);
+    EXPECT_EQ(second.wheel_y, 0.0f);
+    EXPECT_TRUE(second.gamepad_button_pressed(3));
+    EXPECT_TRUE(second.gamepad_button_down(3));
+
+    SDL_Event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+    event.button.button = SDL_BUTTON_LEFT;
+    event.button.down = true;
+    event.button.x = 5;
+    input_event translated;
+    ASSERT_TRUE(translate_sdl_event(event, translated));
+    EXPECT_EQ(translated.type, input_event_type::mouse_button_down);
+    EXPECT_EQ(translated.code, 0u);
+    EXPECT_EQ(translated.x, 5.0f);
+    event.type = SDL_EVENT_KEY_DOWN;
+    event.key.repeat = true;
+    EXPECT_FALSE(translate_sdl_event(event, translated));
+}
+
+TEST(input_system_test, recordings_replay_every_snapshot)
+{
+    using namespace el;
+    const std::string path(temporary_path("input.rec"));
+    input_system input;
+    std::vector<input_snapshot> recorded;
+    {
+        input_recorder recorder(path);
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            input.push({i % 2 == 0 ? input_event_type::key_down : input_event_type::key_up, i % 7, 0, 0});
+            input.push({input_event_type::mouse_motion, 0, float(i), float(2 * i)});
+            recorded.push_back(input.tick(1.0f / 60));
+            recorder.write(recorded.back());
+        }
+        EXPECT_EQ(recorder.size(), 100u);
+    }
+
+    input_replay replay(path);
+    EXPECT_EQ(replay.size(), 100u);
+    for (const input_snapshot& expected : recorded)
+    {
+        const input_snapshot* played(replay.next());
+        ASSERT_NE(played, nullptr);
+        EXPECT_EQ(std::memcmp(played, &expected, sizeof(expected)), 0);
+    }
+    EXPECT_TRUE(replay.finished());
+    EXPECT_EQ(replay.next(), nullptr);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(input_replay{path}, std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(input_replay{path}, std::runtime_error);
+}
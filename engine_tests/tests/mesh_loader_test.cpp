@@ -0,0 +1,193 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_loader/mesh_loader.hpp"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    std::string temporary_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("engine_tests_" + name)).string();
+    }
+
+    void write_text(const std::string& path, const std::string& text)
+    {
+        std::ofstream(path, std::ios::binary) << text;
+    }
+
+    // a tetrahedron as PLY: four vertices with normals and uvs, four triangle faces
+    const float tetrahedron[4][8] = {
+        {0, 0, 0, 0, 0, -1, 0.0f, 0.0f},
+        {1, 0, 0, 0, 0, -1, 1.0f, 0.0f},
+        {0, 1, 0, 0, 0, -1, 0.0f, 1.0f},
+        {0, 0, 1, 1, 1, 1, 0.5f, 0.5f}
+    };
+    const uint32_t tetrahedron_faces[4][3] = {{0, 2, 1}, {0, 1, 3}, {0, 3, 2}, {1, 2, 3}};
+
+    std::string ply_header(const char* format)
+    {
+        return std::string("ply\nformat ") + format + " 1.0\ncomment test\n"
+            "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+            "property float nx\nproperty float ny\nproperty float nz\nproperty float s\nproperty float t\n"
+            "property uchar red\n"
+            "element face 4\nproperty list uchar int vertex_indices\nend_header\n";
+    }
+
+    template <class T>
+    void append_binary(std::string& out, T value, bool big_endian)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (big_endian)
+            std::reverse(bytes, bytes + sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    std::string tetrahedron_ply(const char* format)
+    {
+        std::string text(ply_header(format));
+        const bool ascii(std::strcmp(format, "ascii") == 0);
+        const bool big_endian(std::strcmp(format, "binary_big_endian") == 0);
+        for (const auto& vertex : tetrahedron)
+        {
+            for (float value : vertex)
+                if (ascii)
+                    text += std::to_string(value) + " ";
+                else
+                    append_binary(text, value, big_endian);
+            if (ascii)
+                text += "255\n";
+            else
+                append_binary(text, uint8_t(255), big_endian);
+        }
+        for (const auto& face : tetrahedron_faces)
+        {
+            if (ascii)
+                text += "3 " + std::to_string(face[0]) + " " + std::to_string(face[1]) + " " +
+                    std::to_string(face[2]) + "\n";
+            else
+            {
+                append_binary(text, uint8_t(3), big_endian);
+                for (uint32_t index : face)
+                    append_binary(text, int32_t(index), big_endian);
+            }
+        }
+        return text;
+    }
+
+    // side x side grid of positions, two triangles per quad, written without uvs or normals
+    std::string grid_obj(size_t side)
+    {
+        std::string text;
+        for (size_t y = 0; y <= side; ++y)
+            for (size_t x = 0; x <= side; ++x)
+                text += "v " + std::to_string(x) + " " + std::to_string(y) + " " + std::to_string(x * y % 7) + "\n";
+        for (size_t y = 0; y < side; ++y)
+            for (size_t x = 0; x < side; ++x)
+            {
+                const size_t i(y * (side + 1) + x + 1), row(side + 1);
+                text += "f " + std::to_string(i) + " " + std::to_string(i + 1) + " " + std::to_string(i + row + 1) +
+                    " " + std::to_string(i + row) + "\n";
+            }
+        return text;
+    }
+}
+
+TEST(mesh_loader_test, obj_relative_indices_and_normals)
+{
+    using namespace el;
+    const std::string path(temporary_path("relative.obj"));
+    write_text(path, "v 0 0 0\nv 1 0 0\nv 1 1 0\nvn 0 0 -1\n"
+                     "g part\nusemtl none\n"
+                     "f -3//-1 -2//-1 -1//-1\n");
+    mesh m(load_obj(path));
+    EXPECT_EQ(m.vertex_count(), 3);
+    EXPECT_EQ(m.indices(), std::vector<uint32_t>({0, 1, 2}));
+    EXPECT_FLOAT_EQ(m.normals()[1].coordinate(2), -1.0f);
+
+    write_text(path, "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 x\n");
+    try
+    {
+        load_obj(path);
+        FAIL() << "malformed face accepted";
+    }
+    catch (const std::runtime_error& error)
+    {
+        EXPECT_NE(std::string(error.what()).find("line 4"), std::string::npos);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(mesh_loader_test, chunked_obj_keeps_the_file_order)
+{
+    using namespace el;
+    const std::string path(temporary_path("grid.obj"));
+    // about 2.5 MB, several chunks
+    write_text(path, grid_obj(250));
+    mesh m(load_obj(path));
+    ASSERT_EQ(m.vertex_count(), 251 * 251);
+    ASSERT_EQ(m.triangle_count(), 2 * 250 * 250);
+    for (size_t i = 0; i < m.vertex_count(); i += 97)
+    {
+        const size_t x(i % 251), y(i / 251);
+        EXPECT_EQ(m.positions()[i].get_coordinates(), (std::array<float, 3>{float(x), float(y), float(x * y % 7)}));
+    }
+    // the last quad, fanned from its first corner
+    const std::vector<uint32_t> last(m.indices().end() - 6, m.indices().end());
+    const uint32_t corner(249 * 251 + 249);
+    EXPECT_EQ(last, (std::vector<uint32_t>{corner, corner + 1, corner + 252, corner, corner + 252, corner + 251}));
+
+    size_t calls(0), points(0);
+    stream_points(path, [&](const point<float, 3>* data, size_t count)
+    {
+        EXPECT_EQ(data[0].get_coordinates(), m.positions()[points].get_coordinates());
+        ++calls;
+        points += count;
+    });
+    EXPECT_EQ(points, m.vertex_count());
+    EXPECT_GT(calls, 0);
+    std::filesystem::remove(path);
+}
+
+TEST(mesh_loader_test, ply_formats_agree)
+{
+    using namespace el;
+    for (const char* format : {"ascii", "binary_little_endian", "binary_big_endian"})
+    {
+        const std::string path(temporary_path(std::string("tetrahedron_") + format + ".ply"));
+        write_text(path, tetrahedron_ply(format));
+        mesh m(load_mesh(path));
+        ASSERT_EQ(m.vertex_count(), 4) << format;
+        ASSERT_EQ(m.triangle_count(), 4) << format;
+        EXPECT_EQ(m.indices()[3], 0) << format;
+        EXPECT_EQ(m.indices()[5], 3) << format;
+        EXPECT_FLOAT_EQ(m.positions()[3].coordinate(2), 1.0f) << format;
+        EXPECT_FLOAT_EQ(m.normals()[0].coordinate(2), -1.0f) << format;
+        EXPECT_FLOAT_EQ(m.uvs()[3].coordinate(1), 0.5f) << format;
+
+        const auto cloud(load_point_cloud(path));
+        ASSERT_EQ(cloud.size(), 4) << format;
+        EXPECT_FLOAT_EQ(cloud[1].coordinate(0), 1.0f) << format;
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(mesh_loader_test, malformed_ply_is_rejected)
+{
+    using namespace el;
+    const std::string path(temporary_path("broken.ply"));
+    std::string text(tetrahedron_ply("binary_little_endian"));
+    write_text(path, text.substr(0, text.size() - 5));
+    EXPECT_THROW(load_ply(path), std::runtime_error);
+
+    write_text(path, "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\nend_header\n0 0\n");
+    EXPECT_THROW(load_ply(path), std::runtime_error);
+    EXPECT_THROW(load_mesh(temporary_path("mesh.stl")), std::invalid_argument);
+    std::filesystem::remove(path);
+}
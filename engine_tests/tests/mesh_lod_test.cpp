@@ -0,0 +1,187 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh_lod/mesh_lod.hpp"
+#include "quadric/quadric.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    // unit sphere from a latitude/longitude grid, vertices shared along the seam
+    el::mesh sphere(size_t rings, size_t segments)
+    {
+        el::mesh result(el::vertex_layout::interleaved);
+        result.add_vertex(el::point<float, 3>({0.0f, 0.0f, 1.0f}), el::direction<float, 3>(), el::point<float, 2>());
+        for (size_t r = 1; r < rings; ++r)
+            for (size_t s = 0; s < segments; ++s)
+            {
+                const double theta(M_PI * double(r) / double(rings)), phi(2 * M_PI * double(s) / double(segments));
+                result.add_vertex(el::point<float, 3>({float(std::sin(theta) * std::cos(phi)),
+                                                       float(std::sin(theta) * std::sin(phi)), float(std::cos(theta))}),
+                                  el::direction<float, 3>(), el::point<float, 2>());
+            }
+        const auto bottom(uint32_t(result.vertex_count()));
+        result.add_vertex(el::point<float, 3>({0.0f, 0.0f, -1.0f}), el::direction<float, 3>(), el::point<float, 2>());
+        const auto at([&](size_t r, size_t s) { return uint32_t(1 + (r - 1) * segments + s % segments); });
+        for (size_t s = 0; s < segments; ++s)
+        {
+            result.add_triangle(0, at(1, s), at(1, s + 1));
+            result.add_triangle(at(rings - 1, s), bottom, at(rings - 1, s + 1));
+            for (size_t r = 1; r + 1 < rings; ++r)
+            {
+                result.add_triangle(at(r, s), at(r + 1, s), at(r + 1, s + 1));
+                result.add_triangle(at(r, s), at(r + 1, s + 1), at(r, s + 1));
+            }
+        }
+        return result;
+    }
+
+    // side x side quads of the unit square in the z = 0 plane
+    el::mesh plane(size_t side)
+    {
+        el::mesh result(el::vertex_layout::interleaved);
+        for (size_t y = 0; y <= side; ++y)
+            for (size_t x = 0; x <= side; ++x)
+                result.add_vertex(el::point<float, 3>({float(x) / side, float(y) / side, 0.0f}),
+                                  el::direction<float, 3>(), el::point<float, 2>());
+        for (size_t y = 0; y < side; ++y)
+            for (size_t x = 0; x < side; ++x)
+            {
+                const uint32_t i(uint32_t(y * (side + 1) + x)), row(uint32_t(side + 1));
+                result.add_triangle(i, i + 1, i + row + 1);
+                result.add_triangle(i, i + row + 1, i + row);
+            }
+        return result;
+    }
+
+    // perspective camera at distance on the z axis looking at the origin, vertical field of view of 90 degrees
+    el::matrix<float, 4, 4> camera(float distance)
+    {
+        el::matrix<float, 4, 4> result;
+        const float near(0.1f), far(1000.0f);
+        result(0, 0) = 1;
+        result(1, 1) = 1;
+        result(2, 2) = -(far + near) / (far - near);
+        result(2, 3) = -2 * far * near / (far - near) + (far + near) / (far - near) * distance;
+        result(3, 2) = -1;
+        result(3, 3) = distance;
+        return result;
+    }
+}
+
+TEST(mesh_lod_test, quadric_error_and_minimum)
+{
+    using namespace el;
+    // squared distance to the plane z = 2, scaled by the weight
+    const quadric<double> floor(quadric<double>::from_plane(0, 0, 1, -2, 3));
+    EXPECT_NEAR(floor.error(point<double, 3>({5.0, -1.0, 4.0})), 12.0, 1e-12);
+    EXPECT_NEAR(floor.error(point<double, 3>({5.0, -1.0, 2.0})), 0.0, 1e-12);
+
+    point<double, 3> corner;
+    EXPECT_FALSE(floor.minimum(corner));
+    const quadric<double> planes(floor + quadric<double>::from_plane(1, 0, 0, -1) +
+                                 quadric<double>::from_plane(0, 1, 0, 4));
+    ASSERT_TRUE(planes.minimum(corner));
+    EXPECT_NEAR(corner.get_coordinates()[0], 1.0, 1e-9);
+    EXPECT_NEAR(corner.get_coordinates()[1], -4.0, 1e-9);
+    EXPECT_NEAR(corner.get_coordinates()[2], 2.0, 1e-9);
+    EXPECT_NEAR(planes.error(corner), 0.0, 1e-9);
+}
+
+TEST(mesh_lod_test, simplification_reaches_target_near_surface)
+{
+    using namespace el;
+    const mesh source(sphere(64, 128));
+    lod_settings settings;
+    settings.cluster_triangles = 1024;
+    thread_pool pool(4);
+    const lod_level level(simplify_mesh(source, source.triangle_count() / 8, settings, pool));
+    EXPECT_LE(level.geometry.triangle_count(), source.triangle_count() / 8 + 64);
+    EXPECT_LT(level.geometry.vertex_count(), source.vertex_count() / 4);
+    EXPECT_GT(level.error, 0.0f);
+    EXPECT_LT(level.error, 0.05f);
+    // collapses only move vertices along the surface they approximate
+    const auto positions(level.geometry.positions());
+    for (size_t v = 0; v < level.geometry.vertex_count(); ++v)
+    {
+        const auto& p(positions[v].get_coordinates());
+        EXPECT_NEAR(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]), 1.0, 0.05);
+    }
+    for (const uint32_t index : level.geometry.indices())
+        ASSERT_LT(index, level.geometry.vertex_count());
+}
+
+TEST(mesh_lod_test, planes_keep_their_border)
+{
+    using namespace el;
+    const mesh source(plane(48));
+    lod_settings settings;
+    settings.cluster_triangles = 512;
+    const lod_level a(simplify_mesh(source, 64, settings));
+    EXPECT_LE(a.geometry.triangle_count(), 64u);
+    EXPECT_NEAR(a.error, 0.0f, 1e-4f);
+
+    // a flat square stays flat and keeps its outline and area
+    float area(0);
+    const auto positions(a.geometry.positions());
+    const auto& indices(a.geometry.indices());
+    for (size_t v = 0; v < a.geometry.vertex_count(); ++v)
+    {
+        const auto& p(positions[v].get_coordinates());
+        EXPECT_NEAR(p[2], 0.0f, 1e-6f);
+        EXPECT_GE(p[0], -1e-5f);
+        EXPECT_LE(p[0], 1 + 1e-5f);
+    }
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        const auto& p0(positions[indices[i]].get_coordinates());
+        const auto& p1(positions[indices[i + 1]].get_coordinates());
+        const auto& p2(positions[indices[i + 2]].get_coordinates());
+        area += ((p1[0] - p0[0]) * (p2[1] - p0[1]) - (p1[1] - p0[1]) * (p2[0] - p0[0])) / 2;
+    }
+    EXPECT_NEAR(area, 1.0f, 1e-4f);
+}
+
+TEST(mesh_lod_test, chain_selects_coarser_levels_far_away)
+{
+    using namespace el;
+    const mesh source(sphere(48, 96));
+    lod_settings settings;
+    settings.cluster_triangles = 1024;
+    thread_pool pool(2);
+    const lod_chain chain(source, settings, pool);
+    ASSERT_EQ(chain.size(), 5u);
+    EXPECT_EQ(chain.level(0).geometry.triangle_count(), source.triangle_count());
+    for (size_t i = 1; i < chain.size(); ++i)
+    {
+        EXPECT_LT(chain.level(i).geometry.triangle_count(), chain.level(i - 1).geometry.triangle_count());
+        EXPECT_GE(chain.level(i).error, chain.level(i - 1).error);
+    }
+    EXPECT_NEAR(chain.radius(), 1.0f, 1e-4f);
+
+    // the projected error falls with distance, so farther cameras pick coarser levels
+    EXPECT_GT(chain.projected_error(2, camera(5), 1080), chain.projected_error(2, camera(50), 1080));
+    EXPECT_EQ(chain.select(camera(1.2f), 1080), 0u);
+    EXPECT_LT(chain.select(camera(5), 1080), chain.select(camera(500), 1080));
+    EXPECT_EQ(chain.select(camera(100000), 1080), chain.size() - 1);
+    // a camera inside the bounding sphere always gets the source
+    EXPECT_EQ(chain.projected_error(1, camera(0.5f), 1080), std::numeric_limits<float>::infinity());
+    EXPECT_THROW(static_cast<void>(chain.projected_error(chain.size(), camera(5), 1080)), std::out_of_range);
+}
+
+TEST(mesh_lod_test, invalid_settings)
+{
+    using namespace el;
+    const mesh source(plane(4));
+    lod_settings settings;
+    settings.cluster_triangles = 0;
+    EXPECT_THROW(simplify_mesh(source, 4, settings), std::invalid_argument);
+    settings.cluster_triangles = 64;
+    settings.ratios = {0.5f, 0.5f};
+    EXPECT_THROW(lod_chain(source, settings), std::invalid_argument);
+    settings.ratios = {1.5f};
+    EXPECT_THROW(lod_chain(source, settings), std::invalid_argument);
+}
@@ -0,0 +1,167 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "mesh/mesh.hpp"
+#include "vector3/vector3.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    // side x side quads in the z = 0 plane, uv = position / side, triangles in shuffled order
+    el::mesh grid(size_t side, el::vertex_layout layout, bool shuffled = false)
+    {
+        el::mesh result(layout);
+        for (size_t y = 0; y <= side; ++y)
+            for (size_t x = 0; x <= side; ++x)
+                result.add_vertex(el::point<float, 3>({float(x), float(y), 0.0f}), el::direction<float, 3>(),
+                                  el::point<float, 2>({float(x) / side, float(y) / side}));
+
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (size_t y = 0; y < side; ++y)
+            for (size_t x = 0; x < side; ++x)
+            {
+                const uint32_t i(uint32_t(y * (side + 1) + x)), row(uint32_t(side + 1));
+                triangles.push_back({i, i + 1, i + row + 1});
+                triangles.push_back({i, i + row + 1, i + row});
+            }
+        if (shuffled)
+            std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+        for (const auto& t : triangles)
+            result.add_triangle(t[0], t[1], t[2]);
+        return result;
+    }
+
+    std::vector<std::array<uint32_t, 3>> sorted_triangles(const std::vector<uint32_t>& indices)
+    {
+        std::vector<std::array<uint32_t, 3>> result;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            // rotate the smallest index first, keeping the winding
+            std::array<uint32_t, 3> t({indices[i], indices[i + 1], indices[i + 2]});
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            result.push_back(t);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST(mesh_test, strided_view_over_both_layouts)
+{
+    using namespace el;
+    struct record
+    {
+        int a;
+        float b;
+    };
+    std::vector<record> records({{1, 1.5f}, {2, 2.5f}, {3, 3.5f}});
+    auto bs(strided_view<float>::of_member(records.data(), records.size(), &record::b));
+    EXPECT_EQ(bs.size(), 3);
+    EXPECT_FALSE(bs.contiguous());
+    bs[1] = 7.0f;
+    EXPECT_FLOAT_EQ(records[1].b, 7.0f);
+
+    std::vector<float> packed({1.5f, 7.0f, 3.5f});
+    strided_view<const float> view(packed);
+    EXPECT_TRUE(view.contiguous());
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), bs.begin(), bs.end()));
+    EXPECT_EQ(bs.end() - bs.begin(), 3);
+}
+
+TEST(mesh_test, layouts_expose_the_same_attributes)
+{
+    using namespace el;
+    mesh interleaved(grid(3, vertex_layout::interleaved));
+    mesh separate(grid(3, vertex_layout::separate));
+    ASSERT_EQ(interleaved.vertex_count(), 16);
+    ASSERT_EQ(separate.triangle_count(), 18);
+    EXPECT_EQ(interleaved.positions().stride(), sizeof(vertex));
+    EXPECT_TRUE(separate.positions().contiguous());
+
+    for (size_t i = 0; i < interleaved.vertex_count(); ++i)
+    {
+        EXPECT_EQ(interleaved.positions()[i].get_coordinates(), separate.positions()[i].get_coordinates());
+        EXPECT_EQ(interleaved.uvs()[i].get_coordinates(), separate.uvs()[i].get_coordinates());
+    }
+
+    separate.convert_layout(vertex_layout::interleaved);
+    EXPECT_EQ(separate.layout(), vertex_layout::interleaved);
+    EXPECT_EQ(separate.get_vertex(5).uv.get_coordinates(), interleaved.get_vertex(5).uv.get_coordinates());
+    EXPECT_THROW(separate.add_triangle(0, 1, 16), std::out_of_range);
+    EXPECT_THROW((void)separate.get_vertex(16), std::out_of_range);
+}
+
+TEST(mesh_test, generated_normals_and_tangents_of_a_plane)
+{
+    using namespace el;
+    for (auto layout : {vertex_layout::interleaved, vertex_layout::separate})
+    {
+        mesh m(grid(8, layout, true));
+        m.generate_normals();
+        m.generate_tangents();
+        ASSERT_EQ(m.tangents().size(), m.vertex_count());
+        for (size_t i = 0; i < m.vertex_count(); ++i)
+        {
+            EXPECT_NEAR(m.normals()[i].coordinate(2), 1.0f, 1e-6f);
+            EXPECT_NEAR(m.tangents()[i].coordinate(0), 1.0f, 1e-6f);
+            EXPECT_FLOAT_EQ(m.tangents()[i].coordinate(3), 1.0f);
+        }
+    }
+}
+
+TEST(mesh_test, vertex_cache_optimization)
+{
+    using namespace el;
+    mesh m(grid(64, vertex_layout::interleaved, true));
+    const auto before(sorted_triangles(m.indices()));
+    const float shuffled_ratio(average_cache_miss_ratio(m.indices(), m.vertex_count()));
+
+    m.optimize_vertex_cache();
+    const float optimized_ratio(average_cache_miss_ratio(m.indices(), m.vertex_count()));
+    EXPECT_EQ(sorted_triangles(m.indices()), before);
+    EXPECT_GT(shuffled_ratio, 2.0f);
+    EXPECT_LT(optimized_ratio, 0.8f);
+    EXPECT_THROW(m.optimize_vertex_cache(3), std::invalid_argument);
+}
+
+TEST(mesh_test, transform_moves_points_and_rotates_normals)
+{
+    using namespace el;
+    mesh m(grid(2, vertex_layout::separate));
+    m.generate_normals();
+    m.generate_tangents();
+
+    // rotation by 90 degrees around x, scale 2 along y, then translation
+    matrix<float, 4, 4> t(array<array<float, 4>, 4>({{{1, 0, 0, 5}, {0, 0, -1, 0}, {0, 2, 0, 1}, {0, 0, 0, 1}}}));
+    m.transform(t);
+    const auto p(m.positions()[4].get_coordinates());
+    EXPECT_FLOAT_EQ(p[0], 6.0f);
+    EXPECT_FLOAT_EQ(p[1], 0.0f);
+    EXPECT_FLOAT_EQ(p[2], 3.0f);
+    EXPECT_NEAR(m.normals()[4].coordinate(1), -1.0f, 1e-6f);
+    EXPECT_NEAR(m.tangents()[4].coordinate(0), 1.0f, 1e-6f);
+}
+
+TEST(mesh_test, mirror_transform_keeps_the_bitangent)
+{
+    using namespace el;
+    mesh m(grid(2, vertex_layout::interleaved));
+    m.generate_normals();
+    m.generate_tangents();
+
+    // mirror along x: the uv v direction, and so the bitangent, stays +y
+    matrix<float, 4, 4> t(array<array<float, 4>, 4>({{{-1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}}));
+    m.transform(t);
+    const std::array<float, 3> n(m.normals()[4].get_coordinates());
+    const std::array<float, 4> tangent(m.tangents()[4].get_coordinates());
+    const auto bitangent(scale(cross(n, {tangent[0], tangent[1], tangent[2]}), tangent[3]));
+    EXPECT_NEAR(n[2], 1.0f, 1e-6f);
+    EXPECT_NEAR(tangent[0], -1.0f, 1e-6f);
+    EXPECT_NEAR(bitangent[0], 0.0f, 1e-6f);
+    EXPECT_NEAR(bitangent[1], 1.0f, 1e-6f);
+    EXPECT_NEAR(bitangent[2], 0.0f, 1e-6f);
+}
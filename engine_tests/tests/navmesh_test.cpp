@@ -0,0 +1,242 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "navmesh/navmesh.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+
+namespace
+{
+    // unit quads on the y = 0 plane for every cell the filter keeps; every quad has vertices
+    // of its own, so the navmesh has to weld them to connect the quads
+    el::mesh floor_grid(size_t side, const std::function<bool(size_t, size_t)>& keep)
+    {
+        el::mesh result(el::vertex_layout::interleaved);
+        for (size_t z = 0; z < side; ++z)
+            for (size_t x = 0; x < side; ++x)
+            {
+                if (!keep(x, z))
+                    continue;
+                const auto first(uint32_t(result.vertex_count()));
+                for (const auto& corner : {std::array<size_t, 2>{0, 0}, {0, 1}, {1, 0}, {1, 1}})
+                    result.add_vertex(el::point<float, 3>({float(x + corner[0]), 0.0f, float(z + corner[1])}),
+                                      el::direction<float, 3>(), el::point<float, 2>());
+                result.add_triangle(first, first + 1, first + 2);
+                result.add_triangle(first + 2, first + 1, first + 3);
+            }
+        return result;
+    }
+
+    el::point<float, 3> at(float x, float z)
+    {
+        return el::point<float, 3>({x, 0.0f, z});
+    }
+
+    // true if every sample along the polyline lies on the mesh
+    bool stays_on_mesh(const el::navmesh& mesh, const std::vector<el::point<float, 3>>& waypoints)
+    {
+        for (size_t i = 1; i < waypoints.size(); ++i)
+            for (int s = 0; s <= 64; ++s)
+            {
+                const float t(float(s) / 64);
+                const auto a(waypoints[i - 1].get_coordinates()), b(waypoints[i].get_coordinates());
+                const float x(a[0] + (b[0] - a[0]) * t), z(a[2] + (b[2] - a[2]) * t);
+                if (mesh.locate(at(x, z)) == el::navmesh::no_triangle)
+                    return false;
+            }
+        return true;
+    }
+
+    float length(const std::vector<el::point<float, 3>>& waypoints)
+    {
+        float total(0);
+        for (size_t i = 1; i < waypoints.size(); ++i)
+        {
+            const auto a(waypoints[i - 1].get_coordinates()), b(waypoints[i].get_coordinates());
+            total += std::hypot(b[0] - a[0], b[1] - a[1], b[2] - a[2]);
+        }
+        return total;
+    }
+}
+
+TEST(navmesh_test, builds_walkable_triangles)
+{
+    using namespace el;
+
+    auto level(floor_grid(4, [](size_t, size_t) { return true; }));
+    // a vertical wall is too steep and a downward facing triangle is a ceiling
+    const auto first(uint32_t(level.vertex_count()));
+    for (const auto& p : {std::array<float, 3>{0, 0, 0}, {4, 0, 0}, {0, 3, 0}, {0, 1, 1}, {1, 1, 1}, {0, 1, 2}})
+        level.add_vertex(point<float, 3>(p), direction<float, 3>(), point<float, 2>());
+    level.add_triangle(first, first + 1, first + 2);
+    level.add_triangle(first + 3, first + 4, first + 5);
+
+    const navmesh mesh(level);
+    EXPECT_EQ(mesh.triangle_count(), 32u);
+    size_t shared(0);
+    for (size_t t = 0; t < mesh.triangle_count(); ++t)
+        for (const uint32_t n : mesh.neighbors(t))
+            if (n != navmesh::no_triangle)
+            {
+                ++shared;
+                const auto& back(mesh.neighbors(n));
+                EXPECT_NE(std::find(back.begin(), back.end(), uint32_t(t)), back.end());
+            }
+    // 16 diagonals and 24 edges between quads, counted from both sides
+    EXPECT_EQ(shared, 2u * (16 + 24));
+
+    const uint32_t t(mesh.locate(at(2.2f, 1.1f)));
+    ASSERT_NE(t, navmesh::no_triangle);
+    for (const uint32_t v : mesh.triangle(t))
+    {
+        EXPECT_GE(mesh.vertex(v)[0], 2.0f);
+        EXPECT_LE(mesh.vertex(v)[2], 2.0f);
+    }
+    EXPECT_EQ(mesh.locate(at(5.0f, 1.0f)), navmesh::no_triangle);
+
+    navmesh_settings settings;
+    settings.max_slope = 90;
+    EXPECT_THROW(navmesh(level, settings), std::invalid_argument);
+    const auto ceiling(floor_grid(0, [](size_t, size_t) { return true; }));
+    EXPECT_THROW(navmesh{ceiling}, std::invalid_argument);
+}
+
+TEST(navmesh_test, regions_cover_connected_triangles)
+{
+    using namespace el;
+
+    const navmesh_settings settings{45, 1e-3f, 16};
+    const navmesh mesh(floor_grid(16, [](size_t, size_t) { return true; }), settings);
+    std::vector<size_t> sizes(mesh.region_count(), 0);
+    for (size_t t = 0; t < mesh.triangle_count(); ++t)
+        ++sizes.at(mesh.region(t));
+    for (size_t r = 0; r < mesh.region_count(); ++r)
+    {
+        EXPECT_GE(sizes[r], 1u);
+        EXPECT_LE(sizes[r], 16u);
+        const auto [first, last] = mesh.region_links(r);
+        EXPECT_NE(first, last);
+        for (const uint32_t* link = first; link != last; ++link)
+        {
+            const auto [back_first, back_last] = mesh.region_links(*link);
+            EXPECT_NE(std::find(back_first, back_last, uint32_t(r)), back_last);
+        }
+    }
+}
+
+TEST(navmesh_test, path_goes_around_a_wall)
+{
+    using namespace el;
+
+    // a wall of holes at x = 10 leaves a gap at z >= 15
+    const navmesh_settings settings{45, 1e-3f, 8};
+    const navmesh mesh(floor_grid(20, [](size_t x, size_t z) { return x != 10 || z >= 15; }), settings);
+    path_planner planner(mesh);
+    path_result result;
+    ASSERT_TRUE(planner.find_path({at(5.5f, 2.5f), at(15.5f, 2.5f)}, result));
+    ASSERT_GE(result.waypoints.size(), 4u);
+    EXPECT_EQ(result.waypoints.front().get_coordinates(), at(5.5f, 2.5f).get_coordinates());
+    EXPECT_EQ(result.waypoints.back().get_coordinates(), at(15.5f, 2.5f).get_coordinates());
+    EXPECT_TRUE(stays_on_mesh(mesh, result.waypoints));
+
+    // the shortest path touches the corners of the gap
+    const float shortest(2 * std::hypot(4.5f, 12.5f) + 1);
+    EXPECT_GE(length(result.waypoints), shortest - 1e-3f);
+    EXPECT_LE(length(result.waypoints), shortest * 1.15f);
+    bool corner(false);
+    for (const auto& waypoint : result.waypoints)
+        corner |= waypoint.get_coordinates() == at(10, 15).get_coordinates();
+    EXPECT_TRUE(corner);
+
+    // in the open the path is close to straight
+    ASSERT_TRUE(planner.find_path({at(1.2f, 17.3f), at(18.6f, 16.1f)}, result));
+    EXPECT_TRUE(stays_on_mesh(mesh, result.waypoints));
+    EXPECT_LE(length(result.waypoints), std::hypot(17.4f, 1.2f) * 1.05f);
+    ASSERT_TRUE(planner.find_path({at(3.2f, 16.2f), at(3.8f, 16.4f)}, result));
+    EXPECT_EQ(result.waypoints.size(), 2u);
+}
+
+TEST(navmesh_test, cheaper_parents_update_the_estimate)
+{
+    using namespace el;
+
+    // the triangles left of the hole are first reached through edges facing away from the goal;
+    // once a cheaper parent enters them through another edge their estimate has to follow
+    const navmesh mesh(floor_grid(5, [](size_t x, size_t z) { return x != 1 || z != 1; }));
+    path_planner planner(mesh);
+    path_result result;
+    ASSERT_TRUE(planner.find_path({at(2.5f, 4.5f), at(0.5f, 0.5f)}, result));
+    EXPECT_TRUE(stays_on_mesh(mesh, result.waypoints));
+    // around the corner at (1, 2) rather than the one at (2, 1)
+    const float shortest(std::hypot(1.5f, 2.5f) + std::hypot(0.5f, 1.5f));
+    EXPECT_GE(length(result.waypoints), shortest - 1e-3f);
+    EXPECT_LE(length(result.waypoints), shortest * 1.05f);
+}
+
+TEST(navmesh_test, unreachable_goals_are_not_found)
+{
+    using namespace el;
+
+    // a full wall splits the floor in two
+    const navmesh mesh(floor_grid(12, [](size_t x, size_t) { return x != 6; }));
+    path_planner planner(mesh);
+    path_result result;
+    EXPECT_FALSE(planner.find_path({at(1.5f, 1.5f), at(10.5f, 1.5f)}, result));
+    EXPECT_TRUE(result.waypoints.empty());
+    EXPECT_FALSE(planner.find_path({at(1.5f, 1.5f), at(6.5f, 1.5f)}, result));
+    EXPECT_FALSE(planner.find_path({at(-1.0f, 1.5f), at(1.5f, 1.5f)}, result));
+    EXPECT_TRUE(planner.find_path({at(1.5f, 1.5f), at(4.5f, 10.5f)}, result));
+    // the failed chain is cached as well
+    EXPECT_FALSE(planner.find_path({at(1.5f, 1.5f), at(10.5f, 1.5f)}, result));
+    EXPECT_GE(planner.cache_hits(), 1u);
+}
+
+TEST(navmesh_test, batches_match_single_requests)
+{
+    using namespace el;
+
+    const auto keep([](size_t x, size_t z) { return (x % 8 != 4 || z % 8 == 0) && (x + 3 * z) % 11 != 0; });
+    const navmesh mesh(floor_grid(40, keep), navmesh_settings{45, 1e-3f, 32});
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> coordinate(0.0f, 40.0f);
+    std::vector<path_request> requests(500);
+    for (auto& request : requests)
+        request = {at(coordinate(random), coordinate(random)), at(coordinate(random), coordinate(random))};
+    // repeats reuse the cached chains
+    requests.insert(requests.end(), requests.begin(), requests.begin() + 100);
+
+    path_planner single(mesh);
+    std::vector<path_result> expected(requests.size());
+    size_t found(0);
+    for (size_t i = 0; i < requests.size(); ++i)
+        found += single.find_path(requests[i], expected[i]);
+    EXPECT_GT(found, requests.size() / 4);
+    size_t repeats(0);
+    for (size_t i = 500; i < requests.size(); ++i)
+        repeats += mesh.locate(requests[i].start) != navmesh::no_triangle
+            && mesh.locate(requests[i].goal) != navmesh::no_triangle;
+    EXPECT_GE(single.cache_hits(), repeats);
+
+    // an empty cache, filled during the second batch
+    thread_pool four(4);
+    path_planner planner(mesh);
+    std::vector<path_result> results;
+    planner.find_paths(requests, results, four);
+    const size_t first_hits(planner.cache_hits());
+    planner.find_paths(requests, results, four);
+    EXPECT_EQ(planner.cache_hits() - first_hits, planner.cache_misses());
+    ASSERT_EQ(results.size(), requests.size());
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        ASSERT_EQ(results[i].found, expected[i].found);
+        ASSERT_EQ(results[i].waypoints.size(), expected[i].waypoints.size());
+        for (size_t k = 0; k < results[i].waypoints.size(); ++k)
+            ASSERT_EQ(results[i].waypoints[k].get_coordinates(), expected[i].waypoints[k].get_coordinates());
+        EXPECT_TRUE(!results[i].found || stays_on_mesh(mesh, results[i].waypoints));
+    }
+}
@@ -0,0 +1,134 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "occlusion_buffer/occlusion_buffer.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+    // OpenGL style perspective from the origin down -z, 90 degrees vertically, for a 2:1 viewport
+    el::matrix<float, 4, 4> perspective(float near = 0.1f, float far = 100.0f)
+    {
+        el::matrix<float, 4, 4> result;
+        result(0, 0) = 0.5f;
+        result(1, 1) = 1;
+        result(2, 2) = -(far + near) / (far - near);
+        result(2, 3) = -2 * far * near / (far - near);
+        result(3, 2) = -1;
+        return result;
+    }
+
+    // axis aligned rectangle from (x0, y0) to (x1, y1) at depth z, or along y = z for a floor
+    el::mesh quad(float x0, float y0, float x1, float y1, float z, bool floor = false)
+    {
+        el::mesh result;
+        const auto corner([&](float x, float y)
+        {
+            return floor ? el::point<float, 3>({x, z, y}) : el::point<float, 3>({x, y, z});
+        });
+        result.add_vertex(corner(x0, y0), el::direction<float, 3>(), el::point<float, 2>());
+        result.add_vertex(corner(x1, y0), el::direction<float, 3>(), el::point<float, 2>());
+        result.add_vertex(corner(x1, y1), el::direction<float, 3>(), el::point<float, 2>());
+        result.add_vertex(corner(x0, y1), el::direction<float, 3>(), el::point<float, 2>());
+        result.add_triangle(0, 1, 2);
+        result.add_triangle(0, 2, 3);
+        return result;
+    }
+
+    bool occluded(const el::occlusion_buffer& buffer, std::array<float, 3> low, std::array<float, 3> high)
+    {
+        return buffer.occluded(el::point<float, 3>(low), el::point<float, 3>(high), perspective());
+    }
+}
+
+TEST(occlusion_buffer_test, wall_hides_boxes_behind_it)
+{
+    using namespace el;
+    occlusion_buffer buffer(256, 128);
+    EXPECT_FALSE(occluded(buffer, {-1, -1, -30}, {1, 1, -28}));
+
+    buffer.add_occluder(quad(-5, -5, 5, 5, -10), perspective());
+    EXPECT_EQ(buffer.triangle_count(), 2u);
+    thread_pool pool(4);
+    buffer.render(pool);
+
+    EXPECT_TRUE(occluded(buffer, {-1, -1, -30}, {1, 1, -28}));
+    EXPECT_TRUE(occluded(buffer, {-9, -9, -20}, {9, 9, -19}));
+    // in front of the wall, around its edge, and larger than it
+    EXPECT_FALSE(occluded(buffer, {-1, -1, -6}, {1, 1, -5}));
+    EXPECT_FALSE(occluded(buffer, {-1, -1, -12}, {1, 1, -8}));
+    EXPECT_FALSE(occluded(buffer, {4, -1, -30}, {30, 1, -28}));
+    EXPECT_TRUE(occluded(buffer, {4, -1, -30}, {12, 1, -28}));
+    EXPECT_FALSE(occluded(buffer, {-30, -30, -30}, {30, 30, -28}));
+    // reaching behind the camera, and outside the viewport
+    EXPECT_FALSE(occluded(buffer, {-1, -1, -30}, {1, 1, 1}));
+    EXPECT_FALSE(occluded(buffer, {100, -1, -30}, {102, 1, -28}));
+
+    // the wall depth at the center, the untouched corner infinitely far
+    const float a(-(100.0f + 0.1f) / (100.0f - 0.1f)), b(-2 * 100.0f * 0.1f / (100.0f - 0.1f));
+    EXPECT_NEAR(buffer.depth(128, 64), (a * -10 + b) / 10, 1e-5f);
+    EXPECT_EQ(buffer.depth(0, 0), std::numeric_limits<float>::max());
+
+    buffer.clear();
+    EXPECT_EQ(buffer.triangle_count(), 0u);
+    EXPECT_FALSE(occluded(buffer, {-1, -1, -30}, {1, 1, -28}));
+}
+
+TEST(occlusion_buffer_test, pyramid_holds_the_farthest_depth)
+{
+    using namespace el;
+    occlusion_buffer buffer(128, 64);
+    // a slanted wall and a nearer square over part of it
+    mesh slanted(quad(-8, -8, 8, 8, -10));
+    buffer.add_occluder(slanted, perspective());
+    buffer.add_occluder(quad(-1, -1, 1, 1, -4), perspective());
+    buffer.render(thread_pool::global());
+
+    ASSERT_EQ(buffer.level_count(), 6u);
+    for (size_t level = 1; level < buffer.level_count(); ++level)
+        for (size_t y = 0; y < buffer.height() >> level; ++y)
+            for (size_t x = 0; x < buffer.width() >> level; ++x)
+            {
+                float farthest(-std::numeric_limits<float>::max());
+                for (size_t dy = 0; dy < 2; ++dy)
+                    for (size_t dx = 0; dx < 2; ++dx)
+                        farthest = std::max(farthest, buffer.depth(2 * x + dx, 2 * y + dy, level - 1));
+                ASSERT_EQ(buffer.depth(x, y, level), farthest);
+            }
+    EXPECT_LT(buffer.depth(64, 32), buffer.depth(64, 4));
+    EXPECT_THROW(static_cast<void>(buffer.depth(0, 0, 6)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(buffer.depth(64, 0, 1)), std::out_of_range);
+}
+
+TEST(occlusion_buffer_test, clipped_floor_and_thread_counts)
+{
+    using namespace el;
+    // a floor under the camera reaching behind it, crossing the near plane
+    const mesh floor(quad(-50, -50, 50, 50, -1, true));
+    occlusion_buffer one(256, 128), four(256, 128);
+    thread_pool single(1), pool(4);
+    one.add_occluder(floor, perspective());
+    four.add_occluder(floor, perspective());
+    EXPECT_GT(one.triangle_count(), 2u);
+    one.render(single);
+    four.render(pool);
+    for (size_t y = 0; y < one.height(); ++y)
+        for (size_t x = 0; x < one.width(); ++x)
+            ASSERT_EQ(one.depth(x, y), four.depth(x, y));
+
+    // the lower half of the screen sees the floor, the upper half the sky
+    EXPECT_LT(one.depth(128, 127), 1.0f);
+    EXPECT_EQ(one.depth(128, 10), std::numeric_limits<float>::max());
+    EXPECT_TRUE(occluded(one, {-1, -4, -12}, {1, -3, -10}));
+    EXPECT_FALSE(occluded(one, {-1, 0, -12}, {1, 1, -10}));
+}
+
+TEST(occlusion_buffer_test, invalid_sizes)
+{
+    using namespace el;
+    EXPECT_THROW(occlusion_buffer(0, 64), std::invalid_argument);
+    EXPECT_THROW(occlusion_buffer(100, 64), std::invalid_argument);
+    EXPECT_THROW(occlusion_buffer(64, 48), std::invalid_argument);
+    EXPECT_NO_THROW(occlusion_buffer(32, 32));
+}
@@ -0,0 +1,108 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "particle_system/particle_system.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    el::point<float, 3> at(float x, float y, float z)
+    {
+        return el::point<float, 3>(std::array<float, 3>{x, y, z});
+    }
+
+    el::direction<float, 3> along(float x, float y, float z)
+    {
+        return el::direction<float, 3>(std::array<float, 3>{x, y, z});
+    }
+}
+
+TEST(particle_system_test, integration_and_compaction)
+{
+    using namespace el;
+    particle_forces forces;
+    forces.gravity = along(0, -10, 0);
+    particle_system particles(20000, forces);
+    EXPECT_EQ(particles.capacity(), 20000);
+
+    // every third particle expires after one step, the rest keep their order
+    for (int i = 0; i < 10000; ++i)
+        ASSERT_TRUE(particles.emit(at(float(i), 0, 0), along(1, 0, 0), i % 3 == 0 ? 0.05f : 10.0f));
+    const float* x(particles.positions(0));
+    const float* dead_slot(x);
+    particles.update(0.1f);
+    ASSERT_EQ(particles.size(), 6666);
+    EXPECT_EQ(particles.positions(0), dead_slot);
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        const int original(int(i / 2 * 3 + i % 2 + 1));
+        ASSERT_NEAR(particles.positions(0)[i], float(original) + 0.1f, 1e-3f);
+        ASSERT_NEAR(particles.velocities(1)[i], -1, 1e-5f);
+        ASSERT_NEAR(particles.positions(1)[i], -0.1f, 1e-5f);
+        ASSERT_NEAR(particles.ages()[i], 0.1f, 1e-6f);
+    }
+
+    // a full pool refuses new particles
+    particle_system full(3);
+    for (int i = 0; i < 3; ++i)
+        EXPECT_TRUE(full.emit(at(0, 0, 0), along(0, 0, 0), 1));
+    EXPECT_FALSE(full.emit(at(0, 0, 0), along(0, 0, 0), 1));
+    EXPECT_THROW(full.get_emitter(0), std::out_of_range);
+}
+
+TEST(particle_system_test, emitters_and_forces)
+{
+    using namespace el;
+    particle_forces forces;
+    forces.gravity = along(0, 0, 0);
+    forces.attractors.push_back({at(0, 5, 0), 2});
+
+    particle_system particles(100000, forces, 7);
+    particle_emitter fountain;
+    fountain.position_spread = 0.5f;
+    fountain.velocity = along(0, 1, 0);
+    fountain.velocity_spread = 0.2f;
+    fountain.rate = 1000;
+    fountain.lifetime = 2;
+    fountain.lifetime_spread = 0.5f;
+    particles.add_emitter(fountain);
+    for (int i = 0; i < 100; ++i)
+        particles.update(1.0f / 50);
+
+    // the emitter ran for two seconds at 1000/s, the oldest particles are expiring
+    EXPECT_GT(particles.size(), 1400);
+    EXPECT_LT(particles.size(), 2000);
+    float mean_velocity(0);
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        EXPECT_LE(particles.ages()[i], particles.lifetimes()[i]);
+        EXPECT_LE(particles.lifetimes()[i], 2.5f);
+        mean_velocity += particles.velocities(1)[i];
+    }
+    // the attractor above speeds the particles up beyond their initial 1 m/s
+    EXPECT_GT(mean_velocity / float(particles.size()), 1.05f);
+}
+
+TEST(particle_system_test, projection)
+{
+    using namespace el;
+    particle_system particles(16);
+    particles.emit(at(0, 0, 0), along(0, 0, 0), 1);
+    particles.emit(at(1, 1, 0), along(0, 0, 0), 1);
+    particles.emit(at(5, 0, 0), along(0, 0, 0), 1);
+    particles.emit(at(-1, -1, 0), along(0, 0, 0), 1);
+
+    // orthographic view of [-1, 1] x [-1, 1]
+    matrix<float, 4, 4> identity;
+    for (size_t i = 0; i < 4; ++i)
+        identity(i, i) = 1;
+    std::vector<std::array<float, 2>> screen;
+    particles.project(identity, 200, 100, screen);
+    ASSERT_EQ(screen.size(), 3);
+    EXPECT_EQ(screen[0], (std::array<float, 2>{100, 50}));
+    EXPECT_EQ(screen[1], (std::array<float, 2>{200, 0}));
+    EXPECT_EQ(screen[2], (std::array<float, 2>{0, 100}));
+}
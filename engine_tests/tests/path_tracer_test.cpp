@@ -0,0 +1,148 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "path_tracer/path_tracer.hpp"
+#include "image_file/image_file.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    std::string temporary_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("engine_tests_" + name)).string();
+    }
+
+    // an open box of two triangles per wall lit by an emissive sphere, with a sphere on the floor
+    el::path_tracing_scene box_scene()
+    {
+        using namespace el;
+        path_tracing_scene scene;
+        const uint32_t white(scene.add_material({{0.8f, 0.8f, 0.8f}, {0, 0, 0}}));
+        const uint32_t red(scene.add_material({{0.8f, 0.1f, 0.1f}, {0, 0, 0}}));
+        const uint32_t light(scene.add_material({{0, 0, 0}, {8, 8, 8}}));
+
+        mesh walls;
+        auto quad = [&](std::array<float, 3> a, std::array<float, 3> b, std::array<float, 3> c, std::array<float, 3> d)
+        {
+            const uint32_t first(walls.add_vertex(point<float, 3>(a)));
+            walls.add_vertex(point<float, 3>(b));
+            walls.add_vertex(point<float, 3>(c));
+            walls.add_vertex(point<float, 3>(d));
+            walls.add_triangle(first, first + 1, first + 2);
+            walls.add_triangle(first, first + 2, first + 3);
+        };
+        quad({-1, -1, -1}, {1, -1, -1}, {1, -1, 1}, {-1, -1, 1});
+        quad({-1, 1, -1}, {-1, 1, 1}, {1, 1, 1}, {1, 1, -1});
+        quad({-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1});
+        quad({-1, -1, -1}, {-1, -1, 1}, {-1, 1, 1}, {-1, 1, -1});
+        walls.generate_normals();
+        scene.add_mesh(walls, white);
+        scene.add_sphere(point<float, 3>({0.4f, -0.6f, 0.2f}), 0.4f, red);
+        scene.add_sphere(point<float, 3>({0, 0.9f, 0}), 0.25f, light);
+        scene.build();
+        return scene;
+    }
+
+    const el::camera box_camera{el::point<float, 3>({0, 0, -3.5f}), el::point<float, 3>(), {0, 1, 0}, 45};
+}
+
+TEST(path_tracer_test, white_furnace)
+{
+    using namespace el;
+    // a white sphere under a uniform sky reflects exactly the sky radiance
+    path_tracing_scene scene;
+    scene.add_sphere(point<float, 3>(), 1, scene.add_material({{1, 1, 1}, {0, 0, 0}}));
+    scene.set_sky({0.5f, 1, 2});
+    scene.build();
+
+    path_tracer_settings settings;
+    settings.width = 24;
+    settings.height = 16;
+    path_tracer tracer(scene, {point<float, 3>({0, 0, -4}), point<float, 3>(), {0, 1, 0}, 40}, settings);
+    for (int pass = 0; pass < 4; ++pass)
+        tracer.render_pass();
+    EXPECT_EQ(tracer.samples(), 4);
+    const std::vector<float> image(tracer.image());
+    for (size_t i = 0; i < image.size(); i += 3)
+    {
+        EXPECT_NEAR(image[i], 0.5f, 1e-5f);
+        EXPECT_NEAR(image[i + 1], 1.0f, 1e-5f);
+        EXPECT_NEAR(image[i + 2], 2.0f, 1e-5f);
+    }
+    EXPECT_GT(tracer.samples_per_second(), 0);
+
+    path_tracing_scene unbuilt;
+    EXPECT_THROW((void)unbuilt.intersect(ray<float, 3>()), std::logic_error);
+}
+
+TEST(path_tracer_test, deterministic_for_any_thread_count)
+{
+    using namespace el;
+    const path_tracing_scene scene(box_scene());
+    path_tracer_settings settings;
+    settings.width = 40;
+    settings.height = 30;
+    settings.tile_size = 7;
+    settings.seed = 42;
+
+    thread_pool four(4);
+    path_tracer a(scene, box_camera, settings), b(scene, box_camera, settings);
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        a.render_pass(thread_pool::serial());
+        b.render_pass(four);
+    }
+    EXPECT_EQ(a.image(), b.image());
+
+    settings.seed = 43;
+    path_tracer c(scene, box_camera, settings);
+    for (int pass = 0; pass < 3; ++pass)
+        c.render_pass(four);
+    EXPECT_NE(a.image(), c.image());
+
+    // the lit box is neither black nor blown out, and red light bounces off the sphere
+    const std::vector<float> image(a.image());
+    double red(0), green(0);
+    for (size_t i = 0; i < image.size(); i += 3)
+    {
+        red += image[i];
+        green += image[i + 1];
+    }
+    EXPECT_GT(green / double(image.size() / 3), 0.05);
+    EXPECT_GT(red, green);
+
+    a.reset();
+    EXPECT_EQ(a.samples(), 0);
+}
+
+TEST(path_tracer_test, image_files)
+{
+    using namespace el;
+    const std::vector<float> rgb({0, 0.5f, 1, 2, -1, 0.25f, 0.001f, 0.18f, 1e6f, 3, 2, 1});
+    const std::string pfm(temporary_path("image.pfm")), png(temporary_path("image.png"));
+    write_pfm(pfm, 2, 2, rgb);
+    size_t width(0), height(0);
+    EXPECT_EQ(read_pfm(pfm, width, height), rgb);
+    EXPECT_EQ(width, 2);
+    EXPECT_EQ(height, 2);
+
+    const std::vector<uint8_t> bytes(linear_to_srgb8(rgb));
+    EXPECT_EQ(bytes[0], 0);
+    EXPECT_EQ(bytes[1], 188);
+    EXPECT_EQ(bytes[2], 255);
+    EXPECT_EQ(bytes[4], 0);
+    write_png(png, 2, 2, bytes);
+    std::ifstream file(png, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content.substr(1, 3), "PNG");
+    EXPECT_EQ(content.substr(12, 4), "IHDR");
+    EXPECT_EQ(content.substr(content.size() - 8, 4), "IEND");
+
+    EXPECT_THROW(write_png(png, 3, 2, bytes), std::invalid_argument);
+    std::filesystem::remove(pfm);
+    std::filesystem::remove(png);
+}
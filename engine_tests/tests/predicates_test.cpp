@@ -0,0 +1,131 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "direction/direction.hpp"
+#include "fixed/fixed.hpp"
+#include "interval/interval.hpp"
+#include "matrix/matrix.hpp"
+#include "predicates/predicates.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    int sign(double value)
+    {
+        return value > 0 ? 1 : value < 0 ? -1 : 0;
+    }
+
+    int sign(int64_t value)
+    {
+        return value > 0 ? 1 : value < 0 ? -1 : 0;
+    }
+}
+
+TEST(predicates_test, interval_contains_the_exact_result)
+{
+    using namespace el;
+    const interval<double> third(interval<double>(1) / interval<double>(3));
+    EXPECT_TRUE((third * interval<double>(3)).contains(1));
+    EXPECT_LT(third.lower(), third.upper());
+
+    interval<double> sum;
+    for (int i = 0; i < 10; ++i)
+        sum += interval<double>(0.1);
+    // ten times the double nearest to 0.1, which is slightly above 1
+    EXPECT_LE(sum.lower(), 1.0);
+    EXPECT_GT(sum.upper(), 1.0);
+    EXPECT_EQ(sum.certain_sign(), 1);
+    EXPECT_EQ((sum - interval<double>(1)).certain_sign(), 0);
+    EXPECT_EQ((-sum).certain_sign(), -1);
+
+    EXPECT_THROW(interval<double>(1, 0), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(sum / interval<double>(-1, 1)), std::domain_error);
+}
+
+TEST(predicates_test, orientation_signs_are_exact_near_degeneracy)
+{
+    using namespace el;
+    // points next to the line y = x, whose translated coordinates lose the offsets to rounding
+    const double unit(std::ldexp(1.0, -53));
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 16; ++j)
+        {
+            const double x(0.5 + i * unit), y(0.5 + j * unit);
+            // 12 * (y - x) for b and c on the line
+            EXPECT_EQ(sign(orient2d({x, y}, {12, 12}, {24, 24})), sign(int64_t(j - i))) << i << ' ' << j;
+            EXPECT_EQ(sign(orient2d({12, 12}, {24, 24}, {x, y})), sign(int64_t(j - i))) << i << ' ' << j;
+            // -144 * (z - x) for a, b, c on the plane z = x
+            const double z(0.5 + j * unit);
+            EXPECT_EQ(sign(orient3d({12, 0, 12}, {24, 0, 24}, {12, 12, 12}, {x, 0.5, z})), sign(int64_t(i - j)))
+                << i << ' ' << j;
+        }
+    EXPECT_EQ(orient2d({0.1, 0.1}, {0.3, 0.3}, {1e10, 1e10}), 0.0);
+    EXPECT_GT(orient2d({0, 0}, {1, 0}, {0, 1}), 0.0);
+    EXPECT_GT(orient3d({0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, -1}), 0.0);
+}
+
+TEST(predicates_test, incircle_sign_is_exact_next_to_the_circle)
+{
+    using namespace el;
+    // circle of radius 5 through (3, 4), tested at offsets of a few ulps from that point
+    const double ulp3(std::ldexp(1.0, -51)), ulp4(std::ldexp(1.0, -50));
+    for (int i = -8; i <= 8; ++i)
+        for (int j = -8; j <= 8; ++j)
+        {
+            // 25 - x^2 - y^2 scaled by 2^102
+            const int64_t outside((6 * i + 16 * j) * (int64_t(1) << 51) + i * i + 4 * j * j);
+            EXPECT_EQ(sign(incircle({5, 0}, {0, 5}, {-5, 0}, {3 + i * ulp3, 4 + j * ulp4})), -sign(outside))
+                << i << ' ' << j;
+        }
+    EXPECT_GT(incircle({5, 0}, {0, 5}, {-5, 0}, {0, 0}), 0.0);
+}
+
+TEST(predicates_test, direction_checks_are_exact_and_epsilon_aware)
+{
+    using namespace el;
+    using d3 = direction<double, 3>;
+    // the naive dot product rounds 1e16 + 1 back to 1e16 and returns zero
+    const d3 wide(array<double, 3>({1e16, 1, -1e16})), ones(array<double, 3>({1, 1, 1}));
+    EXPECT_EQ(wide.dot_product(ones), 0.0);
+    EXPECT_FALSE(wide.orthogonal(ones));
+    EXPECT_TRUE(wide.orthogonal(ones, 1e-9));
+    EXPECT_TRUE(d3(array<double, 3>({1, 0, 0})).orthogonal(d3(array<double, 3>({0, 3, 4}))));
+
+    // zero coordinates used to divide zero by zero
+    EXPECT_TRUE(d3(array<double, 3>({1, 0, 2})).colinear(d3(array<double, 3>({-2, 0, -4}))));
+    EXPECT_FALSE(d3(array<double, 3>({1, 0, 0})).colinear(d3(array<double, 3>({0, 1, 0}))));
+    EXPECT_FALSE(d3(array<double, 3>({1, 1e-12, 0})).colinear(d3(array<double, 3>({1, 0, 0}))));
+    EXPECT_TRUE(d3(array<double, 3>({1, 1e-12, 0})).colinear(d3(array<double, 3>({1, 0, 0})), 1e-9));
+    EXPECT_FALSE(d3(array<double, 3>({1, 1e-6, 0})).colinear(d3(array<double, 3>({1, 0, 0})), 1e-9));
+
+    const d3 a(array<double, 3>({1, 2, 3})), b(array<double, 3>({4, 5, 6}));
+    EXPECT_TRUE(a.complanar(b, d3(array<double, 3>({7, 8, 9}))));
+    const d3 lifted(array<double, 3>({7, 8, std::nextafter(9.0, 10.0)}));
+    EXPECT_FALSE(a.complanar(b, lifted));
+    EXPECT_TRUE(a.complanar(b, lifted, 1e-9));
+
+    using f = fixed16_16;
+    const direction<f, 3> x(array<f, 3>({f(1), f(0), f(2)})), y(array<f, 3>({f(2), f(0), f(4)}));
+    EXPECT_TRUE(x.colinear(y));
+    EXPECT_THROW(static_cast<void>(x.colinear(direction<f, 3>())), std::invalid_argument);
+}
+
+TEST(predicates_test, matrix_checks_accept_a_tolerance)
+{
+    using namespace el;
+    matrix<double, 3, 3> m(array<array<double, 3>, 3>({{{1, 1e-12, 0}, {0, 1 - 1e-12, 0}, {-1e-12, 0, 1}}}));
+    EXPECT_FALSE(m.is_identity_matrix());
+    EXPECT_TRUE(m.is_identity_matrix(1e-9));
+    EXPECT_FALSE(m.is_identity_matrix(1e-15));
+    EXPECT_TRUE(m.is_diagonal_matrix(1e-9));
+
+    matrix<double, 3, 3> thin(array<array<double, 3>, 3>({{{2, 0, 0}, {0, 1e-12, 0}, {0, 0, 3}}}));
+    EXPECT_TRUE(thin.is_diagonal_matrix());
+    EXPECT_FALSE(thin.is_diagonal_matrix(1e-9));
+    const matrix<double, 2, 3> wide;
+    EXPECT_FALSE(wide.is_identity_matrix(1.0));
+}
@@ -0,0 +1,136 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "ray/ray_packet.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+
+TEST(ray_test, scalar_intersections)
+{
+    using namespace el;
+    const ray<double, 3> r(direction<double, 3>(array<double, 3>{0, 0, -5}, array<double, 3>{0, 0, -3}));
+    EXPECT_DOUBLE_EQ(r.get_direction()[2], 2.0);
+    EXPECT_DOUBLE_EQ(r.at(1.5).coordinate(2), -2.0);
+    const array<double, 3> zero{0, 0, 0};
+    EXPECT_THROW((ray<double, 3>(point<double, 3>(), zero)), std::invalid_argument);
+
+    // triangle in the z = 0 plane, hit at (0.25, 0.25) after 2.5 direction lengths
+    const ray<double, 3> towards(point<double, 3>({0.25, 0.25, -5}), {0, 0, 2});
+    const auto hit(intersect_triangle(towards, point<double, 3>({0, 0, 0}), point<double, 3>({1, 0, 0}),
+                                      point<double, 3>({0, 1, 0})));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_DOUBLE_EQ(hit->distance, 2.5);
+    EXPECT_DOUBLE_EQ(hit->u, 0.25);
+    EXPECT_DOUBLE_EQ(hit->v, 0.25);
+    EXPECT_FALSE(intersect_triangle(towards, point<double, 3>({0, 0, 0}), point<double, 3>({1, 0, 0}),
+                                    point<double, 3>({0, 1, 0}), 2.0).has_value());
+    EXPECT_FALSE(intersect_triangle(towards, point<double, 3>({1, 1, 0}), point<double, 3>({2, 1, 0}),
+                                    point<double, 3>({1, 2, 0})).has_value());
+
+    // unit box around the origin: entered at z = -1, inside rays report zero
+    EXPECT_DOUBLE_EQ(*intersect_box(towards, point<double, 3>({-1, -1, -1}), point<double, 3>({1, 1, 1})), 2.0);
+    EXPECT_DOUBLE_EQ(*intersect_box(ray<double, 3>(point<double, 3>(), {1, 1, 0}), point<double, 3>({-1, -1, -1}),
+                                    point<double, 3>({1, 1, 1})), 0.0);
+    EXPECT_FALSE(intersect_box(towards, point<double, 3>({1, 1, 1}), point<double, 3>({2, 2, 2})).has_value());
+
+    // sphere of radius 1 at the origin, and the exit point from inside
+    EXPECT_NEAR(*intersect_sphere(towards, point<double, 3>(), 1.0), (5 - std::sqrt(1 - 0.125)) / 2, 1e-12);
+    EXPECT_DOUBLE_EQ(*intersect_sphere(ray<double, 3>(point<double, 3>(), {0, 2, 0}), point<double, 3>(), 1.0), 0.5);
+    EXPECT_FALSE(intersect_sphere(towards, point<double, 3>({3, 0, 0}), 1.0).has_value());
+
+    EXPECT_DOUBLE_EQ(*intersect_plane(towards, point<double, 3>({0, 0, 1}), {0, 0, 3}), 3.0);
+    EXPECT_FALSE(intersect_plane(towards, point<double, 3>({0, 0, -6}), {0, 0, 1}).has_value());
+    EXPECT_FALSE(intersect_plane(towards, point<double, 3>(), {1, 0, 0}).has_value());
+}
+
+namespace
+{
+    // random rays from a cube around the origin towards random points near it
+    std::vector<el::ray<float, 3>> random_rays(size_t count)
+    {
+        std::mt19937 random(11);
+        std::uniform_real_distribution<float> coordinate(-2.0f, 2.0f);
+        std::vector<el::ray<float, 3>> rays;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const el::point<float, 3> origin({coordinate(random), coordinate(random), coordinate(random) - 4});
+            const std::array<float, 3> target{coordinate(random) * 0.5f, coordinate(random) * 0.5f, coordinate(random)};
+            rays.emplace_back(origin, std::array<float, 3>{target[0] - origin.coordinate(0),
+                                                           target[1] - origin.coordinate(1),
+                                                           target[2] - origin.coordinate(2)});
+        }
+        return rays;
+    }
+
+    template <size_t W>
+    void expect_packets_match_scalar()
+    {
+        using namespace el;
+        const std::vector<ray<float, 3>> rays(random_rays(W * 64));
+        const point<float, 3> a({-1, -1, 0.2f}), b({1, -0.5f, 0}), c({0, 1, -0.3f});
+        const point<float, 3> lower({-0.5f, -0.5f, -0.5f}), upper({0.5f, 0.7f, 0.5f});
+        const float infinity(std::numeric_limits<float>::infinity());
+        const float_pack<W> unlimited(infinity);
+        size_t hits(0);
+
+        auto expect_lane = [&](float packed, const auto& scalar)
+        {
+            if (scalar.has_value())
+            {
+                ++hits;
+                EXPECT_NEAR(packed, float(*scalar), 1e-4f * std::max(1.0f, packed));
+            }
+            else
+                EXPECT_EQ(packed, infinity);
+        };
+
+        for (size_t first = 0; first < rays.size(); first += W)
+        {
+            const ray_packet<W> packet(&rays[first]);
+            float_pack<W> u, v;
+            const float_pack<W> triangles(intersect_triangle(packet, a, b, c, unlimited, &u, &v));
+            const float_pack<W> boxes(intersect_box(packet, lower, upper, unlimited));
+            const float_pack<W> spheres(intersect_sphere(packet, point<float, 3>({0.1f, 0, 0}), 0.8f, unlimited));
+            const float_pack<W> planes(intersect_plane(packet, a, {0.1f, 0.2f, 1}, unlimited));
+            for (size_t lane = 0; lane < W; ++lane)
+            {
+                const ray<float, 3>& r(rays[first + lane]);
+                const auto triangle(intersect_triangle(r, a, b, c));
+                if (triangle.has_value())
+                {
+                    EXPECT_NEAR(u[lane], triangle->u, 1e-4f);
+                    EXPECT_NEAR(v[lane], triangle->v, 1e-4f);
+                    expect_lane(triangles[lane], std::optional<float>(triangle->distance));
+                }
+                else
+                    expect_lane(triangles[lane], std::optional<float>());
+                expect_lane(boxes[lane], intersect_box(r, lower, upper));
+                expect_lane(spheres[lane], intersect_sphere(r, point<float, 3>({0.1f, 0, 0}), 0.8f));
+                expect_lane(planes[lane], intersect_plane(r, a, {0.1f, 0.2f, 1}));
+            }
+        }
+        EXPECT_GT(hits, W * 64);
+    }
+}
+
+TEST(ray_test, packets_match_scalar)
+{
+    expect_packets_match_scalar<4>();
+    expect_packets_match_scalar<8>();
+
+    using namespace el;
+    const ray<float, 3> rays[4] = {
+        ray<float, 3>(point<float, 3>({0, 0, -1}), {0, 0, 1}), ray<float, 3>(point<float, 3>({0, 0, -1}), {0, 0, 1}),
+        ray<float, 3>(point<float, 3>({5, 0, -1}), {0, 0, 1}), ray<float, 3>(point<float, 3>({0, 0, -1}), {0, 0, 1})
+    };
+    const float limits[4] = {10, 0.5f, 10, 10};
+    // lane 1 is cut off by its limit, lane 2 misses
+    const float_pack<4> distance(intersect_sphere(ray_packet<4>(rays), point<float, 3>(), 0.25f,
+                                                  float_pack<4>::load_unaligned(limits)));
+    EXPECT_FLOAT_EQ(distance[0], 0.75f);
+    EXPECT_EQ(distance[1], std::numeric_limits<float>::infinity());
+    EXPECT_EQ(distance[2], std::numeric_limits<float>::infinity());
+    EXPECT_FLOAT_EQ(distance[3], 0.75f);
+}
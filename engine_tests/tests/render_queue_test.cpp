@@ -0,0 +1,131 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "render_queue/render_queue.hpp"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct fill_command
+    {
+        float color[4];
+        size_t points;
+        size_t point_count;
+    };
+}
+
+TEST(render_queue_test, keys_group_state_and_keep_recording_order)
+{
+    using namespace el;
+    EXPECT_LT(make_render_key(0, 9, 9, 9), make_render_key(1, 0, 0, 0));
+    EXPECT_LT(make_render_key(1, 2, 9, 9), make_render_key(1, 3, 0, 0));
+    EXPECT_LT(quantize_depth(0.25f), quantize_depth(0.5f));
+    EXPECT_GT(quantize_depth(0.25f, true), quantize_depth(0.5f, true));
+    EXPECT_EQ(quantize_depth(2.0f), quantize_depth(1.0f));
+    EXPECT_THROW(make_render_key(0, 0, 0, 1u << 24), std::out_of_range);
+    EXPECT_THROW(render_frame(0), std::invalid_argument);
+
+    // two threads record interleaved pipelines, sorting leaves one change per pipeline and texture
+    render_frame frame(2);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        const float point[2]{float(i), 1.0f};
+        command_buffer& target(frame.buffer(i % 2));
+        const size_t points(target.append(point, 2));
+        target.record(make_render_key(1, uint16_t(i % 3), uint16_t(i % 2), quantize_depth(1.0f - i / 100.0f)), 7,
+                      fill_command{{float(i), 0, 0, 1}, points, 1});
+    }
+    frame.buffer(1).record(make_render_key(0, 5, 5, 0), 3, 42);
+    EXPECT_THROW(frame.buffer(2), std::out_of_range);
+    EXPECT_EQ(frame.command_count(), 101u);
+
+    frame.sort();
+    EXPECT_EQ(frame.state_changes(), 1u + 6u);
+
+    std::vector<float> order;
+    uint64_t previous = 0;
+    frame.execute([&](const command_buffer& source, const render_command& command)
+    {
+        EXPECT_GE(command.key, previous);
+        previous = command.key;
+        if (command.type == 3)
+        {
+            EXPECT_EQ(source.payload<int>(command), 42);
+            return;
+        }
+        const fill_command& payload(source.payload<fill_command>(command));
+        EXPECT_EQ(source.data<float>(payload.points)[0], payload.color[0]);
+        order.push_back(payload.color[0]);
+    });
+    ASSERT_EQ(order.size(), 100u);
+    EXPECT_EQ(order.front(), 96.0f); // pipeline 0, texture 0, nearest first
+
+    frame.clear();
+    frame.sort();
+    EXPECT_EQ(frame.command_count(), 0u);
+    EXPECT_EQ(frame.state_changes(), 0u);
+}
+
+TEST(render_queue_test, handoff_keeps_frames_in_order)
+{
+    using namespace el;
+    render_queue queue(1);
+    EXPECT_EQ(queue.try_acquire(), nullptr);
+    EXPECT_THROW(queue.submit(), std::logic_error);
+    EXPECT_THROW(queue.release(), std::logic_error);
+
+    // the simulation may run one frame ahead, never two
+    render_frame* first(queue.begin_recording());
+    ASSERT_NE(first, nullptr);
+    EXPECT_THROW(queue.begin_recording(), std::logic_error);
+    first->buffer(0).record(0, 0, 0);
+    queue.submit();
+    render_frame* second(queue.begin_recording());
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    second->buffer(0).record(0, 0, 1);
+    queue.submit();
+
+    render_frame* executed(queue.try_acquire());
+    ASSERT_EQ(executed, first);
+    EXPECT_THROW(queue.try_acquire(), std::logic_error);
+    queue.release();
+
+    constexpr int frames = 2000;
+    std::thread simulation([&]
+    {
+        for (int n = 2; n < frames; ++n)
+        {
+            render_frame* frame(queue.begin_recording());
+            ASSERT_NE(frame, nullptr);
+            frame->buffer(0).record(make_render_key(0, 0, 0, 1), 0, n);
+            frame->buffer(0).record(make_render_key(0, 0, 0, 0), 1, n);
+            queue.submit();
+        }
+        queue.close();
+        EXPECT_EQ(queue.begin_recording(), nullptr);
+    });
+
+    int expected = 1;
+    while (render_frame* frame = queue.acquire())
+    {
+        std::vector<int> types;
+        frame->execute([&](const command_buffer& source, const render_command& command)
+        {
+            EXPECT_EQ(source.payload<int>(command), expected);
+            types.push_back(int(command.type));
+        });
+        if (expected > 1)
+        {
+            EXPECT_EQ(types, (std::vector<int>{1, 0}));
+        }
+        ++expected;
+        queue.release();
+    }
+    simulation.join();
+    EXPECT_EQ(expected, frames);
+}
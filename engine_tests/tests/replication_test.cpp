@@ -0,0 +1,226 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "replication/replication.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    el::replicated_state state_at(float x, float y, float z, float angle = 0)
+    {
+        el::replicated_state state;
+        state.position = el::point<float, 3>(std::array<float, 3>{x, y, z});
+        state.orientation = {std::cos(angle / 2), 0, std::sin(angle / 2), 0};
+        return state;
+    }
+
+    float coordinate(const el::replica& replica, size_t axis)
+    {
+        return replica.state.position.get_coordinates()[axis];
+    }
+
+    // one tick: the server writes, the client applies and acknowledges
+    size_t exchange(el::replication_server& server, el::replication_client& client, std::vector<unsigned char>& packet,
+                    bool deliver = true)
+    {
+        server.advance();
+        server.write_packet(0, packet);
+        if (deliver)
+        {
+            client.receive(packet.data(), packet.size());
+            std::vector<unsigned char> ack;
+            client.write_ack(ack);
+            server.receive_ack(0, ack.data(), ack.size());
+        }
+        return packet.size();
+    }
+}
+
+TEST(replication_test, bit_streams_and_quantization)
+{
+    using namespace el;
+    std::vector<unsigned char> buffer;
+    bit_writer out(buffer);
+    out.write_bits(5, 3);
+    out.write_bool(true);
+    out.write_signed(-100, 8);
+    out.write_bits(0xDEADBEEF, 32);
+    const size_t kept(out.bit_count());
+    out.write_bits(0x7F, 7);
+    out.rewind(kept);
+    out.write_signed(3, 2);
+    EXPECT_EQ(out.bit_count(), 46);
+    EXPECT_EQ(buffer.size(), 6);
+    EXPECT_THROW(out.write_bits(0, 33), std::invalid_argument);
+    EXPECT_THROW(out.rewind(47), std::out_of_range);
+
+    bit_reader in(buffer.data(), buffer.size());
+    EXPECT_EQ(in.read_bits(3), 5u);
+    EXPECT_TRUE(in.read_bool());
+    EXPECT_EQ(in.read_signed(8), -100);
+    EXPECT_EQ(in.read_bits(32), 0xDEADBEEFu);
+    EXPECT_EQ(in.read_signed(2), -1);
+    EXPECT_EQ(in.remaining_bits(), 2);
+    EXPECT_THROW(in.read_bits(3), std::out_of_range);
+
+    // positions land within half a step, clamped to the box
+    position_quantization box;
+    box.bits = 16;
+    const float step(2048.0f / 65535);
+    const point<float, 3> position(std::array<float, 3>{12.345f, -1000.5f, 2000});
+    const point<float, 3> restored(dequantize_position(quantize_position(position, box), box));
+    EXPECT_NEAR(restored.get_coordinates()[0], 12.345f, step / 2 + 1e-4f);
+    EXPECT_NEAR(restored.get_coordinates()[1], -1000.5f, step / 2 + 1e-4f);
+    EXPECT_EQ(restored.get_coordinates()[2], 1024);
+    EXPECT_EQ(quantize(5, 0, 1, 32), 0xFFFFFFFFu);
+    EXPECT_THROW(quantize(0, 1, 1, 8), std::invalid_argument);
+
+    // smallest three rotations, q and -q encode alike
+    const std::array<float, 4> q{0.5f, -0.5f, 0.5f, 0.5f};
+    const std::array<float, 4> negated{-0.5f, 0.5f, -0.5f, -0.5f};
+    EXPECT_EQ(quantize_rotation(q, 10), quantize_rotation(negated, 10));
+    const float inverse_sqrt30(1 / std::sqrt(30.0f));
+    const std::array<float, 4> turn{1 * inverse_sqrt30, 2 * inverse_sqrt30, -3 * inverse_sqrt30, 4 * inverse_sqrt30};
+    const std::array<float, 4> decoded(dequantize_rotation(quantize_rotation(turn, 10), 10));
+    float dot(0);
+    for (size_t i = 0; i < 4; ++i)
+        dot += decoded[i] * turn[i];
+    EXPECT_GT(std::fabs(dot), 0.99999f);
+    EXPECT_THROW(quantize_rotation(turn, 11), std::invalid_argument);
+}
+
+TEST(replication_test, deltas_priorities_and_removal)
+{
+    using namespace el;
+    replication_server server;
+    replication_client client;
+    ASSERT_EQ(server.add_client(), 0);
+    for (int i = 0; i < 40; ++i)
+        server.add(state_at(float(i), 0, 0));
+    std::vector<unsigned char> packet;
+
+    // the first packet is full, the next one has nothing left to say
+    const size_t full(exchange(server, client, packet));
+    ASSERT_EQ(client.replicas().size(), 40);
+    EXPECT_NEAR(coordinate(client.replicas()[17], 0), 17, 1e-3f);
+    EXPECT_EQ(exchange(server, client, packet), 5);
+    EXPECT_THROW(server.write_packet(0, packet), std::logic_error);
+
+    // a small move is a delta against the acknowledged state, far cheaper than the full state
+    for (uint32_t i = 0; i < 40; ++i)
+        server.set(i, state_at(float(i) + 0.1f, 0, 0));
+    const size_t delta(exchange(server, client, packet));
+    EXPECT_LT(delta * 3, full);
+    EXPECT_NEAR(coordinate(client.replicas()[3], 0), 3.1f, 1e-3f);
+    for (uint32_t i = 0; i < 40; ++i)
+        server.set(i, state_at(float(i) + 0.1f, 0, 0, 0.5f));
+    EXPECT_LT(exchange(server, client, packet), full);
+    EXPECT_NEAR(client.replicas()[3].state.orientation[2], std::sin(0.25f), 1e-3f);
+
+    // lost packets are resent against the older baseline the client still has
+    for (uint32_t i = 0; i < 40; ++i)
+        server.set(i, state_at(float(i) + 0.2f, 1, 0));
+    exchange(server, client, packet, false);
+    exchange(server, client, packet, false);
+    exchange(server, client, packet);
+    EXPECT_NEAR(coordinate(client.replicas()[39], 1), 1, 1e-3f);
+
+    // a removal goes out first; the reused id arrives in full
+    server.remove(7);
+    EXPECT_THROW(server.set(7, state_at(0, 0, 0)), std::out_of_range);
+    exchange(server, client, packet);
+    EXPECT_FALSE(client.replicas()[7].present);
+    EXPECT_EQ(server.add(state_at(-5, 0, 0)), 7);
+    exchange(server, client, packet);
+    EXPECT_TRUE(client.replicas()[7].present);
+    EXPECT_NEAR(coordinate(client.replicas()[7], 0), -5, 1e-3f);
+
+    // under a tight budget the entities near the focus are refreshed first, the rest later
+    replication_settings tight;
+    tight.bytes_per_tick = 32;
+    tight.relevance_radius = 4;
+    replication_server limited(tight);
+    replication_client receiver(tight);
+    limited.add_client();
+    limited.set_focus(0, point<float, 3>(std::array<float, 3>{100, 0, 0}));
+    for (int i = 0; i < 101; ++i)
+        limited.add(state_at(float(i), 0, 0));
+    EXPECT_LE(exchange(limited, receiver, packet), 32);
+    EXPECT_TRUE(receiver.replicas().back().present);
+    EXPECT_FALSE(receiver.replicas().size() > 0 && receiver.replicas()[0].present);
+    for (int tick = 0; tick < 200; ++tick)
+        exchange(limited, receiver, packet);
+    ASSERT_EQ(receiver.replicas().size(), 101);
+    for (const replica& entity : receiver.replicas())
+        EXPECT_TRUE(entity.present);
+}
+
+TEST(replication_test, malformed_and_late_packets)
+{
+    using namespace el;
+    replication_server server;
+    replication_client client;
+    server.add_client();
+    const uint32_t id(server.add(state_at(1, 2, 3)));
+    std::vector<unsigned char> first, second;
+    server.advance();
+    server.write_packet(0, first);
+    ASSERT_TRUE(client.receive(first.data(), first.size()));
+    EXPECT_FALSE(client.receive(first.data(), first.size()));
+
+    // truncation changes nothing
+    server.set(id, state_at(4, 5, 6));
+    server.advance();
+    server.write_packet(0, second);
+    EXPECT_THROW(client.receive(second.data(), second.size() - 1), std::runtime_error);
+    EXPECT_NEAR(coordinate(client.replicas()[id], 0), 1, 1e-3f);
+    ASSERT_TRUE(client.receive(second.data(), second.size()));
+    EXPECT_NEAR(coordinate(client.replicas()[id], 0), 4, 1e-3f);
+
+    std::vector<unsigned char> ack;
+    client.write_ack(ack);
+    EXPECT_THROW(server.receive_ack(0, ack.data(), ack.size() - 1), std::runtime_error);
+    EXPECT_THROW(server.receive_ack(1, ack.data(), ack.size()), std::out_of_range);
+    server.receive_ack(0, ack.data(), ack.size());
+
+    // a delta against a baseline the client never stored is ignored rather than misapplied
+    server.set(id, state_at(7, 8, 9));
+    server.advance();
+    server.write_packet(0, second);
+    replication_client stranger;
+    EXPECT_FALSE(stranger.receive(second.data(), second.size()));
+
+    replication_settings invalid;
+    invalid.rotation_bits = 11;
+    EXPECT_THROW(replication_server{invalid}, std::invalid_argument);
+}
+
+TEST(replication_test, loopback_udp)
+{
+    using namespace el;
+    udp_socket server, client;
+    EXPECT_NE(server.local_address().port, 0);
+    EXPECT_NE(server.local_address(), client.local_address());
+
+    std::vector<unsigned char> packet;
+    udp_address from;
+    EXPECT_FALSE(server.receive(packet, from));
+    const unsigned char hello[] = {'h', 'e', 'l', 'l', 'o'};
+    ASSERT_TRUE(client.send(server.local_address(), hello, sizeof(hello)));
+    // loopback delivery is immediate but not synchronous
+    bool received(false);
+    for (int attempt = 0; attempt < 1000 && !received; ++attempt)
+        received = server.receive(packet, from);
+    ASSERT_TRUE(received);
+    EXPECT_EQ(packet.size(), 5);
+    EXPECT_EQ(packet[4], 'o');
+    EXPECT_EQ(from, client.local_address());
+
+    const uint16_t port(server.local_address().port);
+    udp_socket moved(std::move(server));
+    EXPECT_EQ(moved.local_address().port, port);
+    EXPECT_THROW(udp_socket(client.local_address().port), std::runtime_error);
+}
@@ -0,0 +1,157 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "rigid_body/rigid_body.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    el::point<float, 3> at(float x, float y, float z)
+    {
+        return el::point<float, 3>(std::array<float, 3>{x, y, z});
+    }
+
+    el::direction<float, 3> along(float x, float y, float z)
+    {
+        return el::direction<float, 3>(std::array<float, 3>{x, y, z});
+    }
+}
+
+TEST(rigid_body_test, integration)
+{
+    using namespace el;
+    rigid_body_world world;
+    // semi-implicit Euler: the velocity changes first, the position moves with the new velocity
+    const size_t falling(world.add_body(solid_sphere(at(0, 10, 0), 0.5f, 2)));
+    const size_t fixed(world.add_body(solid_sphere(at(5, 10, 0), 0.5f, 0)));
+    const size_t spinning(world.add_body(solid_sphere(at(-5, 10, 0), 0.5f, 1)));
+    world.set_velocity(spinning, along(0, 0, 0), along(0, 0, 1));
+    const float dt(0.01f), g(world.settings().gravity[1]);
+    for (int i = 1; i <= 100; ++i)
+        world.step(dt);
+
+    const rigid_body body(world.get_body(falling));
+    EXPECT_NEAR(body.velocity.get_coordinates()[1], 100 * dt * g, 1e-4f);
+    EXPECT_NEAR(body.position.coordinate(1), 10 + dt * dt * g * 100 * 101 / 2, 1e-3f);
+    EXPECT_FLOAT_EQ(body.mass, 2);
+    EXPECT_EQ(world.get_body(fixed).position.coordinate(1), 10);
+
+    // one radian per second about z for one second
+    const std::array<float, 4> q(world.get_body(spinning).orientation);
+    EXPECT_NEAR(q[0], std::cos(0.5f), 1e-3f);
+    EXPECT_NEAR(q[3], std::sin(0.5f), 1e-3f);
+    EXPECT_NEAR(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3], 1, 1e-6f);
+
+    EXPECT_THROW(world.add_body(solid_sphere(at(0, 0, 0), -1, 1)), std::invalid_argument);
+    rigid_body singular(solid_sphere(at(0, 0, 0), 1, 1));
+    singular.inertia = matrix3x3<float>();
+    EXPECT_THROW(world.add_body(singular), std::invalid_argument);
+    EXPECT_THROW(world.add_plane(at(0, 0, 0), {0, 0, 0}), std::invalid_argument);
+    EXPECT_THROW((void)world.get_body(3), std::out_of_range);
+}
+
+TEST(rigid_body_test, contacts)
+{
+    using namespace el;
+    physics_settings settings;
+    settings.gravity = {0, 0, 0};
+    settings.restitution = 1;
+    settings.friction = 0;
+
+    // equal masses swap velocities in an elastic head-on collision
+    rigid_body_world elastic(settings);
+    elastic.add_body(solid_sphere(at(-1, 0, 0), 0.5f, 1));
+    elastic.add_body(solid_sphere(at(1, 0, 0), 0.5f, 1));
+    elastic.set_velocity(0, along(3, 0, 0), along(0, 0, 0));
+    for (int i = 0; i < 60; ++i)
+        elastic.step(1.0f / 60);
+    EXPECT_NEAR(elastic.get_body(0).velocity.get_coordinates()[0], 0, 1e-3f);
+    EXPECT_NEAR(elastic.get_body(1).velocity.get_coordinates()[0], 3, 1e-3f);
+
+    // a sliding ball on a rough floor ends up rolling at 5/7 of its speed
+    rigid_body_world rough;
+    rough.add_plane(at(0, 0, 0), {0, 1, 0});
+    rough.add_body(solid_sphere(at(0, 0.5f, 0), 0.5f, 1));
+    rough.set_velocity(0, along(7, 0, 0), along(0, 0, 0));
+    for (int i = 0; i < 120; ++i)
+        rough.step(1.0f / 60);
+    const rigid_body ball(rough.get_body(0));
+    EXPECT_NEAR(ball.velocity.get_coordinates()[0], 5, 0.05f);
+    EXPECT_NEAR(ball.angular_velocity.get_coordinates()[2], -10, 0.1f);
+    EXPECT_NEAR(ball.position.coordinate(1), 0.5f, 0.01f);
+    EXPECT_EQ(rough.contact_count(), 1);
+}
+
+TEST(rigid_body_test, islands_are_deterministic)
+{
+    using namespace el;
+    // two rows of touching balls far apart rest as two islands
+    rigid_body_world rows;
+    rows.add_plane(at(0, 0, 0), {0, 1, 0});
+    for (float z : {-10.0f, 10.0f})
+        for (int i = 0; i < 5; ++i)
+            rows.add_body(solid_sphere(at(0.998f * float(i), 0.5f, z), 0.5f, 1));
+    for (int i = 0; i < 30; ++i)
+        rows.step(1.0f / 60);
+    EXPECT_EQ(rows.island_count(), 2);
+    EXPECT_EQ(rows.contact_count(), 18);
+
+    // two piles falling onto static posts scatter the same way on any number of threads
+    auto build = []
+    {
+        rigid_body_world world;
+        world.add_plane(at(0, 0, 0), {0, 1, 0});
+        for (float x : {-20.0f, 20.0f})
+        {
+            world.add_body(solid_sphere(at(x, 0.5f, 0), 0.5f, 0));
+            for (int i = 0; i < 12; ++i)
+                world.add_body(solid_sphere(at(x + 0.3f * float(i % 4) - 0.4f, 1.6f + 1.1f * float(i / 4), 0.1f * float(i % 3)),
+                                            0.5f, 1));
+        }
+        return world;
+    };
+
+    thread_pool four(4);
+    rigid_body_world a(build()), b(build());
+    for (int i = 0; i < 240; ++i)
+    {
+        a.step(1.0f / 60, thread_pool::serial());
+        b.step(1.0f / 60, four);
+    }
+    EXPECT_EQ(a.island_count(), b.island_count());
+    EXPECT_EQ(a.contact_count(), b.contact_count());
+    for (size_t i = 0; i < a.body_count(); ++i)
+    {
+        const rigid_body first(a.get_body(i)), second(b.get_body(i));
+        EXPECT_EQ(first.position.get_coordinates(), second.position.get_coordinates());
+        // everything has come to rest above the floor
+        EXPECT_GT(first.position.coordinate(1), 0.45f);
+        EXPECT_LT(std::abs(first.velocity.get_coordinates()[1]), 0.05f);
+    }
+}
+
+TEST(rigid_body_test, ball_rests_in_a_corner)
+{
+    using namespace el;
+    // gravity pushes a ball into the corner of a floor and a wall, one contact per plane
+    physics_settings settings;
+    settings.gravity = {-4, -9.81f, 0};
+    rigid_body_world corner(settings);
+    corner.add_plane(at(0, 0, 0), {0, 1, 0});
+    corner.add_plane(at(0, 0, 0), {1, 0, 0});
+    corner.add_body(solid_sphere(at(0.5f, 0.5f, 0), 0.5f, 1));
+    for (int i = 0; i < 120; ++i)
+        corner.step(1.0f / 60);
+    const rigid_body ball(corner.get_body(0));
+    EXPECT_EQ(corner.contact_count(), 2);
+    EXPECT_NEAR(ball.position.coordinate(0), 0.5f, 0.01f);
+    EXPECT_NEAR(ball.position.coordinate(1), 0.5f, 0.01f);
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        EXPECT_LT(std::abs(ball.velocity.get_coordinates()[axis]), 0.05f);
+        EXPECT_LT(std::abs(ball.angular_velocity.get_coordinates()[axis]), 0.05f);
+    }
+}
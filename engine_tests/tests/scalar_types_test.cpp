@@ -0,0 +1,95 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "fixed/fixed.hpp"
+#include "half/half.hpp"
+#include "matrix/matrix.hpp"
+#include "gtest/gtest.h"
+
+TEST(fixed_test, arithmetic_is_exact_on_representable_values)
+{
+    using namespace el;
+    fixed16_16 a(3), b(0.25), c(-1.5);
+    EXPECT_EQ((a + b).raw(), 0x34000);
+    EXPECT_EQ(double(a * c), -4.5);
+    EXPECT_EQ(double(a / b), 12.0);
+    EXPECT_EQ(double(c / a), -0.5);
+    EXPECT_EQ(int(fixed16_16(7.75)), 7);
+    EXPECT_TRUE(c < 0);
+    EXPECT_TRUE(abs(c) == fixed16_16(1.5));
+    EXPECT_THROW(a / fixed16_16(0), std::invalid_argument);
+}
+
+TEST(fixed_test, sqrt_rounds_to_nearest)
+{
+    using namespace el;
+    EXPECT_EQ(double(sqrt(fixed16_16(16))), 4.0);
+    EXPECT_EQ(double(sqrt(fixed16_16(0.25))), 0.5);
+    EXPECT_NEAR(double(sqrt(fixed16_16(2))), 1.41421356, 1.0 / 65536);
+    EXPECT_THROW(sqrt(fixed16_16(-1)), std::invalid_argument);
+}
+
+TEST(fixed_test, math_templates)
+{
+    using namespace el;
+    using f = fixed16_16;
+    direction<f, 3> d(array<f, 3>({f(3), f(0), f(4)}));
+    EXPECT_EQ(double(d.length()), 5.0);
+    EXPECT_NEAR(double(d.ort().length()), 1.0, 4.0 / 65536);
+
+    direction<f, 3> x(array<f, 3>({f(1), f(0), f(0)})), y(array<f, 3>({f(0), f(1), f(0)}));
+    EXPECT_TRUE(x.cross_product(y).equal(direction<f, 3>(array<f, 3>({f(0), f(0), f(1)}))));
+    EXPECT_TRUE(x.orthogonal(y));
+
+    matrix3x3<f> m(array<array<f, 3>, 3>({{{f(2), f(0), f(1)}, {f(1), f(3), f(2)}, {f(1), f(1), f(2)}}}));
+    EXPECT_EQ(double(m.determinant()), 6.0);
+    auto product(m * m.inverted_matrix());
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            EXPECT_NEAR(double(product(i, j)), i == j ? 1.0 : 0.0, 1e-4);
+}
+
+TEST(half_test, conversions_round_to_nearest_even)
+{
+    using namespace el;
+    EXPECT_EQ(half(1.0f).bits(), 0x3C00);
+    EXPECT_EQ(half(-2.0f).bits(), 0xC000);
+    EXPECT_EQ(half(65504.0f).bits(), 0x7BFF);
+    EXPECT_EQ(half(65520.0f).bits(), 0x7C00);
+    EXPECT_EQ(half(1.0f + 1.0f / 2048).bits(), 0x3C00);
+    EXPECT_EQ(half(1.0f + 3.0f / 2048).bits(), 0x3C02);
+    EXPECT_EQ(half(5.9604645e-8f).bits(), 0x0001);
+    EXPECT_EQ(float(half::from_bits(0x0001)), 5.9604645e-8f);
+    EXPECT_TRUE(isnan(half(std::numeric_limits<float>::quiet_NaN())));
+    EXPECT_TRUE(isinf(half(std::numeric_limits<float>::infinity())));
+
+    for (uint32_t bits = 0; bits < 0x7C00; ++bits)
+        ASSERT_EQ(half(float(half::from_bits(uint16_t(bits)))).bits(), bits);
+}
+
+TEST(half_test, bulk_convert_matches_scalar)
+{
+    using namespace el;
+    std::vector<float> source(37), back(37);
+    std::vector<half> packed(37);
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = float(i) * 0.37f - 5.0f;
+    convert(source.data(), packed.data(), source.size());
+    convert(packed.data(), back.data(), packed.size());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        EXPECT_EQ(packed[i].bits(), half(source[i]).bits());
+        EXPECT_EQ(back[i], float(half(source[i])));
+    }
+}
+
+TEST(half_test, math_templates)
+{
+    using namespace el;
+    direction<half, 3> d(array<half, 3>({half(3), half(0), half(4)}));
+    EXPECT_EQ(float(d.length()), 5.0f);
+    point<half, 2> p(array<half, 2>({half(1), half(2)}));
+    EXPECT_EQ(float((p * half(0.5f)).coordinate(1)), 1.0f);
+    EXPECT_THROW(p / half(0), std::invalid_argument);
+}
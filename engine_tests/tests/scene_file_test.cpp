@@ -0,0 +1,122 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "checksum/checksum.hpp"
+#include "mesh_loader/mesh_loader.hpp"
+#include "scene_file/scene_file.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    std::string temporary_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("engine_tests_" + name)).string();
+    }
+
+    void write_text(const std::string& path, const std::string& text)
+    {
+        std::ofstream(path, std::ios::binary) << text;
+    }
+
+    // a unit quad in the z = 0 plane with uvs, as two triangles sharing two vertices
+    const char* quad_obj =
+        "# quad\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "f 1/1 2/2 3/3 4/4\n";
+}
+
+TEST(scene_file_test, checksum_matches_xxh64)
+{
+    using namespace el;
+    EXPECT_EQ(compute_checksum64("", 0), 0xEF46DB3751D8E999ull);
+    EXPECT_EQ(compute_checksum64("a", 1), 0xD24EC4F1A98C6E5Bull);
+    EXPECT_EQ(compute_checksum64("abc", 3), 0x44BC2CF5AD770999ull);
+
+    std::vector<unsigned char> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<unsigned char>(i * 31 + 7);
+    checksum64 pieces;
+    for (size_t first = 0; first < data.size(); first += 13)
+        pieces.update(data.data() + first, std::min<size_t>(13, data.size() - first));
+    EXPECT_EQ(pieces.digest(), compute_checksum64(data.data(), data.size()));
+}
+
+TEST(scene_file_test, obj_faces_are_triangulated_and_deduplicated)
+{
+    using namespace el;
+    const std::string path(temporary_path("quad.obj"));
+    write_text(path, quad_obj);
+    mesh m(load_obj(path));
+    EXPECT_EQ(m.vertex_count(), 4);
+    EXPECT_EQ(m.triangle_count(), 2);
+    EXPECT_EQ(m.indices(), std::vector<uint32_t>({0, 1, 2, 0, 2, 3}));
+    EXPECT_FLOAT_EQ(m.uvs()[2].coordinate(1), 1.0f);
+    EXPECT_FLOAT_EQ(m.normals()[0].coordinate(2), 1.0f);
+
+    write_text(path, "v 0 0 0\nv 1 0 0\nf 1 2 3\n");
+    EXPECT_THROW(load_obj(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(scene_file_test, meshes_are_used_in_place)
+{
+    using namespace el;
+    const std::string obj(temporary_path("scene.obj")), scene(temporary_path("scene.l3ds"));
+    write_text(obj, quad_obj);
+    mesh quad(load_obj(obj));
+    mesh separate(load_obj(obj));
+    separate.convert_layout(vertex_layout::separate);
+    separate.add_vertex(point<float, 3>({5.0f, 6.0f, 7.0f}));
+    write_scene(scene, {quad, separate});
+
+    scene_file file(scene);
+    ASSERT_EQ(file.mesh_count(), 2);
+    const mesh_view view(file.get_mesh(1));
+    EXPECT_EQ(view.vertex_count, 5);
+    EXPECT_EQ(view.triangle_count(), 2);
+    EXPECT_FLOAT_EQ(view.positions()[4].coordinate(2), 7.0f);
+    EXPECT_FLOAT_EQ(view.uvs()[2].coordinate(0), 1.0f);
+    EXPECT_FLOAT_EQ(view.normals()[0].coordinate(2), 1.0f);
+
+    // the view points into the mapping, page aligned
+    const auto* begin(file.file().data());
+    EXPECT_GE(reinterpret_cast<const unsigned char*>(view.vertices), begin);
+    EXPECT_LT(reinterpret_cast<const unsigned char*>(view.indices), begin + file.file().size());
+    EXPECT_EQ((reinterpret_cast<const unsigned char*>(view.vertices) - begin) % scene_format::block_alignment, 0);
+
+    mesh copy(file.get_mesh(0).to_mesh());
+    EXPECT_EQ(copy.indices(), quad.indices());
+    EXPECT_EQ(copy.positions()[3].get_coordinates(), quad.positions()[3].get_coordinates());
+    std::filesystem::remove(obj);
+    std::filesystem::remove(scene);
+}
+
+TEST(scene_file_test, corruption_is_detected)
+{
+    using namespace el;
+    const std::string obj(temporary_path("corrupt.obj")), scene(temporary_path("corrupt.l3ds"));
+    write_text(obj, quad_obj);
+    write_scene(scene, {load_obj(obj)});
+    {
+        // flip one byte of the first vertex
+        std::fstream file(scene, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(std::streamoff(scene_format::block_alignment) + 4);
+        file.put('\x55');
+    }
+
+    scene_file unchecked(scene);
+    EXPECT_NO_THROW((void)unchecked.get_mesh(0));
+    EXPECT_THROW(unchecked.verify(), std::runtime_error);
+    scene_file lazy(scene, scene_verification::lazy);
+    EXPECT_THROW((void)lazy.get_mesh(0), std::runtime_error);
+    EXPECT_THROW(scene_file(scene, scene_verification::eager), std::runtime_error);
+
+    EXPECT_THROW(scene_file{obj}, std::runtime_error);
+    std::filesystem::remove(obj);
+    std::filesystem::remove(scene);
+}
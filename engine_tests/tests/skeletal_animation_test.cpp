@@ -0,0 +1,200 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "skeletal_animation/skeletal_animation.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    std::array<float, 4> about_z(float angle)
+    {
+        return {std::cos(angle / 2), 0.0f, 0.0f, std::sin(angle / 2)};
+    }
+
+    el::matrix<float, 4, 4> identity_matrix()
+    {
+        el::matrix<float, 4, 4> result;
+        for (size_t i = 0; i < 4; ++i)
+            result(i, i) = 1;
+        return result;
+    }
+
+    // a two bone arm along y: the root at the origin, the elbow one unit up, bent by angle
+    std::vector<el::joint_transform> arm_pose(float angle)
+    {
+        std::vector<el::joint_transform> pose(2);
+        pose[1].translation = {0, 1, 0};
+        pose[1].rotation = about_z(angle);
+        return pose;
+    }
+
+    el::skeleton arm()
+    {
+        el::matrix<float, 4, 4> elbow(identity_matrix());
+        elbow(1, 3) = -1;
+        return el::skeleton({-1, 0}, {identity_matrix(), elbow});
+    }
+}
+
+TEST(skeletal_animation_test, model_pose_follows_the_hierarchy)
+{
+    using namespace el;
+    joint_transform root;
+    root.translation = {1, 0, 0};
+    root.scale = {2, 2, 2};
+    joint_transform child;
+    child.translation = {0, 1, 0};
+    child.rotation = about_z(float(M_PI) / 2);
+    const skeleton rig({-1, 0}, {identity_matrix(), identity_matrix()});
+    std::array<matrix<float, 4, 4>, 2> model;
+    const std::array<joint_transform, 2> local{root, child};
+    rig.local_to_model(local.data(), model.data());
+
+    // the child's x axis turns into y, is scaled by the root and sits two units above it
+    EXPECT_NEAR(model[1](0, 3), 1, 1e-6f);
+    EXPECT_NEAR(model[1](1, 3), 2, 1e-6f);
+    EXPECT_NEAR(model[1](0, 0), 0, 1e-6f);
+    EXPECT_NEAR(model[1](1, 0), 2, 1e-6f);
+    EXPECT_EQ(rig.parent(1), 0);
+    EXPECT_THROW(skeleton({-1, 1}, {identity_matrix(), identity_matrix()}), std::invalid_argument);
+    EXPECT_THROW(skeleton({-1}, {identity_matrix(), identity_matrix()}), std::invalid_argument);
+}
+
+TEST(skeletal_animation_test, clip_compression_stays_within_tolerance)
+{
+    using namespace el;
+    // a still root, an elbow swinging and sliding, 4 seconds at 30 frames per second
+    std::vector<std::vector<joint_transform>> frames;
+    for (int f = 0; f <= 120; ++f)
+    {
+        std::vector<joint_transform> pose(arm_pose(std::sin(float(f) / 40)));
+        pose[1].translation[2] = 0.01f * float(f);
+        // the same rotations with flipped signs must not break interpolation
+        if (f % 2)
+            for (float& component : pose[1].rotation)
+                component = -component;
+        frames.push_back(pose);
+    }
+    clip_compression tolerances;
+    tolerances.translation_error = 1e-3f;
+    tolerances.rotation_error = 2e-3f;
+    const animation_clip clip(frames, 30, tolerances);
+    EXPECT_EQ(clip.joint_count(), 2u);
+    EXPECT_FLOAT_EQ(clip.duration(), 4.0f);
+    // the still tracks keep a single key, the linear slide two
+    EXPECT_LT(clip.key_count(), 40u);
+    EXPECT_LT(clip.compressed_size(), frames.size() * 2 * sizeof(joint_transform) / 4);
+
+    std::vector<joint_transform> pose(2);
+    for (int step = 0; step <= 240; ++step)
+    {
+        const float time(float(step) / 60);
+        clip.sample(time, pose.data());
+        const float angle(std::sin(time * 0.75f));
+        const std::array<float, 4> expected(about_z(angle));
+        float cosine(0);
+        for (size_t c = 0; c < 4; ++c)
+            cosine += pose[1].rotation[c] * expected[c];
+        // between frames the source itself is only known up to its own interpolation
+        EXPECT_LT(2 * std::acos(std::min(1.0f, std::fabs(cosine))), 4e-3f) << time;
+        EXPECT_NEAR(pose[1].translation[2], 0.3f * time, 1.5e-3f);
+        EXPECT_NEAR(pose[0].translation[0], 0, 1e-6f);
+        EXPECT_NEAR(pose[0].rotation[0], 1, 1e-6f);
+        EXPECT_NEAR(pose[1].scale[1], 1, 1e-6f);
+    }
+    // times outside the clip clamp to its ends
+    std::vector<joint_transform> end(2);
+    clip.sample(100, pose.data());
+    clip.sample(4, end.data());
+    EXPECT_EQ(pose[1].rotation, end[1].rotation);
+
+    EXPECT_THROW(animation_clip({}, 30), std::invalid_argument);
+    EXPECT_THROW(animation_clip({arm_pose(0), {joint_transform()}}, 30), std::invalid_argument);
+    EXPECT_THROW(animation_clip({arm_pose(0)}, 0), std::invalid_argument);
+}
+
+TEST(skeletal_animation_test, linear_blend_skinning)
+{
+    using namespace el;
+    const skeleton rig(arm());
+    std::vector<skin_vertex> vertices(3);
+    // above the elbow on the upper bone, at the elbow blended, and on the forearm
+    vertices[0] = {{0.5f, 0.5f, 0}, {1, 0, 0}, {0, 0, 0, 0}, {1, 0, 0, 0}};
+    vertices[1] = {{0, 1, 0}, {1, 0, 0}, {0, 1, 0, 0}, {0.5f, 0.5f, 0, 0}};
+    vertices[2] = {{0.5f, 2, 0}, {1, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}};
+
+    std::vector<matrix<float, 4, 4>> palette(2);
+    std::vector<skinned_vertex> skinned(3);
+    const std::vector<joint_transform> bind(arm_pose(0));
+    rig.skinning_palette(bind.data(), palette.data());
+    skin_vertices(vertices.data(), vertices.size(), palette.data(), 2, skinned.data());
+    for (size_t v = 0; v < 3; ++v)
+        for (size_t c = 0; c < 3; ++c)
+        {
+            EXPECT_NEAR(skinned[v].position[c], vertices[v].position[c], 1e-6f);
+            EXPECT_NEAR(skinned[v].normal[c], vertices[v].normal[c], 1e-6f);
+        }
+
+    // bending the elbow by 90 degrees swings the forearm to -x
+    const std::vector<joint_transform> bent(arm_pose(float(M_PI) / 2));
+    rig.skinning_palette(bent.data(), palette.data());
+    skin_vertices(vertices.data(), vertices.size(), palette.data(), 2, skinned.data());
+    EXPECT_NEAR(skinned[0].position[0], 0.5f, 1e-6f);
+    EXPECT_NEAR(skinned[2].position[0], -1, 1e-6f);
+    EXPECT_NEAR(skinned[2].position[1], 1.5f, 1e-6f);
+    EXPECT_NEAR(skinned[2].normal[0], 0, 1e-6f);
+    EXPECT_NEAR(skinned[2].normal[1], 1, 1e-6f);
+    // the blended normal is renormalized
+    EXPECT_NEAR(skinned[1].normal[0], std::sqrt(0.5f), 1e-6f);
+    EXPECT_NEAR(skinned[1].normal[1], std::sqrt(0.5f), 1e-6f);
+
+    vertices[2].joints[1] = 2;
+    EXPECT_THROW(skin_vertices(vertices.data(), vertices.size(), palette.data(), 2, skinned.data()),
+                 std::out_of_range);
+}
+
+TEST(skeletal_animation_test, crowd_matches_single_characters)
+{
+    using namespace el;
+    const skeleton rig(arm());
+    std::vector<std::vector<joint_transform>> frames;
+    for (int f = 0; f <= 60; ++f)
+        frames.push_back(arm_pose(float(f) / 40));
+    const animation_clip clip(frames, 30);
+    std::vector<skin_vertex> vertices;
+    for (int i = 0; i < 50; ++i)
+        vertices.push_back({{0.1f * float(i % 7), 0.05f * float(i), 0}, {0, 0, 1}, {0, 1, 0, 0},
+                            {1 - 0.02f * float(i), 0.02f * float(i), 0, 0}});
+    std::vector<float> times;
+    for (int c = 0; c < 37; ++c)
+        times.push_back(0.05f * float(c));
+
+    std::vector<matrix<float, 4, 4>> palettes;
+    std::vector<skinned_vertex> crowd;
+    animate_crowd(rig, clip, vertices, times, palettes, crowd);
+    ASSERT_EQ(crowd.size(), times.size() * vertices.size());
+
+    std::vector<joint_transform> pose(2);
+    std::vector<matrix<float, 4, 4>> palette(2);
+    std::vector<skinned_vertex> skinned(vertices.size());
+    for (size_t c = 0; c < times.size(); ++c)
+    {
+        clip.sample(times[c], pose.data());
+        rig.skinning_palette(pose.data(), palette.data());
+        skin_vertices(vertices.data(), vertices.size(), palette.data(), 2, skinned.data());
+        for (size_t v = 0; v < vertices.size(); ++v)
+        {
+            const skinned_vertex& a(crowd[c * vertices.size() + v]);
+            ASSERT_EQ(a.position, skinned[v].position);
+            ASSERT_EQ(a.normal, skinned[v].normal);
+        }
+    }
+
+    vertices[3].joints[2] = 9;
+    EXPECT_THROW(animate_crowd(rig, clip, vertices, times, palettes, crowd), std::out_of_range);
+    const skeleton single({-1}, {identity_matrix()});
+    EXPECT_THROW(animate_crowd(single, clip, vertices, times, palettes, crowd), std::invalid_argument);
+}
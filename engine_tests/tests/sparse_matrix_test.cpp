@@ -0,0 +1,109 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "solvers/solvers.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+    // 1D Laplacian with a stiffer diagonal, symmetric positive definite
+    el::csr_matrix<double> laplacian(size_t size)
+    {
+        std::vector<el::sparse_entry<double>> entries;
+        for (size_t i = 0; i < size; ++i)
+        {
+            entries.push_back({i, i, 3.0});
+            if (i > 0)
+                entries.push_back({i, i - 1, -1.0});
+            if (i + 1 < size)
+                entries.push_back({i, i + 1, -1.0});
+        }
+        return el::csr_matrix<double>(size, size, entries);
+    }
+}
+
+TEST(sparse_matrix_test, csr_assembly_sums_duplicates)
+{
+    using namespace el;
+    csr_matrix<int> m(2, 3, {{1, 2, 4}, {0, 1, 1}, {1, 2, 1}, {1, 0, 7}});
+    EXPECT_EQ(m.non_zeros(), 3);
+    EXPECT_EQ(m(1, 2), 5);
+    EXPECT_EQ(m(1, 0), 7);
+    EXPECT_EQ(m(0, 0), 0);
+
+    auto y(m * std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(y, std::vector<int>({2, 22}));
+    EXPECT_THROW(csr_matrix<int>(2, 2, {{2, 0, 1}}), std::out_of_range);
+}
+
+TEST(sparse_matrix_test, bsr_multiply_points)
+{
+    using namespace el;
+    matrix<float, 2, 2> block(array<array<float, 2>, 2>({{{1, 2}, {3, 4}}}));
+    bsr_matrix<float, 2> m(2, 2, {{0, 0, block}, {1, 1, block}, {0, 1, block}});
+    std::vector<point<float, 2>> x({point<float, 2>({1, 0}), point<float, 2>({0, 1})});
+    auto y(m * x);
+    EXPECT_FLOAT_EQ(y[0].coordinate(0), 3);
+    EXPECT_FLOAT_EQ(y[0].coordinate(1), 7);
+    EXPECT_FLOAT_EQ(y[1].coordinate(0), 2);
+    EXPECT_FLOAT_EQ(y[1].coordinate(1), 4);
+    EXPECT_FLOAT_EQ(m.block(0, 1)(1, 0), 3);
+    EXPECT_FLOAT_EQ(m.block(1, 0)(1, 0), 0);
+}
+
+TEST(sparse_matrix_test, conjugate_gradient_and_gauss_seidel_agree)
+{
+    using namespace el;
+    thread_pool pool(2);
+    auto a(laplacian(10000));
+    std::vector<double> expected(10000);
+    for (size_t i = 0; i < expected.size(); ++i)
+        expected[i] = std::sin(double(i) * 0.01);
+    auto b(a * expected);
+
+    std::vector<double> x;
+    auto cg(conjugate_gradient(a, b, x, 500, 1e-10, pool));
+    EXPECT_TRUE(cg.converged);
+    for (size_t i = 0; i < x.size(); i += 97)
+        EXPECT_NEAR(x[i], expected[i], 1e-8);
+
+    std::vector<double> y;
+    auto gs(gauss_seidel(a, b, y, 500, 1e-10, pool));
+    EXPECT_TRUE(gs.converged);
+    for (size_t i = 0; i < y.size(); i += 97)
+        EXPECT_NEAR(y[i], expected[i], 1e-8);
+}
+
+TEST(sparse_matrix_test, block_solvers_on_points)
+{
+    using namespace el;
+    const size_t size(500);
+    matrix<double, 3, 3> diagonal(array<array<double, 3>, 3>({{{6, 1, 0}, {1, 6, 1}, {0, 1, 6}}}));
+    matrix<double, 3, 3> coupling(array<array<double, 3>, 3>({{{-1, 0, 0}, {0, -1, 0}, {0, 0, -1}}}));
+    std::vector<sparse_entry<matrix<double, 3, 3>>> entries;
+    for (size_t i = 0; i < size; ++i)
+    {
+        entries.push_back({i, i, diagonal});
+        if (i > 0)
+            entries.push_back({i, i - 1, coupling});
+        if (i + 1 < size)
+            entries.push_back({i, i + 1, coupling});
+    }
+    bsr_matrix<double, 3> a(size, size, entries);
+
+    std::vector<point<double, 3>> expected(size);
+    for (size_t i = 0; i < size; ++i)
+        expected[i] = point<double, 3>({double(i % 7), 1.0, -double(i % 3)});
+    auto b(a * expected);
+
+    for (bool use_cg : {true, false})
+    {
+        std::vector<point<double, 3>> x;
+        auto result(use_cg ? conjugate_gradient(a, b, x, 1000, 1e-12) : gauss_seidel(a, b, x, 1000, 1e-12));
+        EXPECT_TRUE(result.converged);
+        for (size_t i = 0; i < size; i += 11)
+            for (size_t axis = 0; axis < 3; ++axis)
+                EXPECT_NEAR(x[i].coordinate(axis), expected[i].coordinate(axis), 1e-9);
+    }
+}
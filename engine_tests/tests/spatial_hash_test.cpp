@@ -0,0 +1,97 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "spatial_hash/spatial_hash.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    std::vector<el::point<float, 3>> random_points(size_t count, float extent, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> coordinate(-extent, extent);
+        std::vector<el::point<float, 3>> points;
+        for (size_t i = 0; i < count; ++i)
+            points.emplace_back(std::array<float, 3>{coordinate(random), coordinate(random), coordinate(random)});
+        return points;
+    }
+
+    float distance_squared(const el::point<float, 3>& a, const el::point<float, 3>& b)
+    {
+        float sum = 0;
+        for (size_t axis = 0; axis < 3; ++axis)
+            sum += (a.coordinate(axis) - b.coordinate(axis)) * (a.coordinate(axis) - b.coordinate(axis));
+        return sum;
+    }
+}
+
+TEST(spatial_hash_test, pairs_match_brute_force)
+{
+    using namespace el;
+    const std::vector<point<float, 3>> points(random_points(2000, 5, 1));
+    const float radius = 0.4f;
+    std::vector<std::pair<uint32_t, uint32_t>> expected;
+    for (uint32_t i = 0; i < points.size(); ++i)
+        for (uint32_t j = i + 1; j < points.size(); ++j)
+            if (distance_squared(points[i], points[j]) <= radius * radius)
+                expected.emplace_back(i, j);
+
+    // a tiny table forces many cells into the same bucket
+    for (size_t buckets : {size_t(0), size_t(7), size_t(100)})
+    {
+        spatial_hash grid(0.5f, buckets);
+        grid.build(points);
+        EXPECT_EQ(grid.size(), points.size());
+        std::vector<std::pair<uint32_t, uint32_t>> found(grid.find_pairs(radius));
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+    EXPECT_EQ(spatial_hash(1, 5).bucket_count(), 8);
+
+    spatial_hash grid(0.5f);
+    EXPECT_THROW((void)grid.find_pairs(0.6f), std::invalid_argument);
+    EXPECT_THROW(spatial_hash(0), std::invalid_argument);
+    grid.build({});
+    EXPECT_TRUE(grid.find_pairs(0.5f).empty());
+    EXPECT_TRUE(grid.query_radius(point<float, 3>(), 10).empty());
+    EXPECT_TRUE(grid.query_nearest(point<float, 3>(), 3).empty());
+}
+
+TEST(spatial_hash_test, radius_and_nearest_queries)
+{
+    using namespace el;
+    const std::vector<point<float, 3>> points(random_points(2000, 4, 2));
+    spatial_hash grid(0.7f, 64);
+    grid.build(points);
+
+    for (const point<float, 3>& center : random_points(20, 6, 3))
+    {
+        for (float radius : {0.0f, 0.5f, 1.9f, 20.0f})
+        {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < points.size(); ++i)
+                if (distance_squared(center, points[i]) <= radius * radius)
+                    expected.push_back(i);
+            std::vector<uint32_t> found(grid.query_radius(center, radius));
+            std::sort(found.begin(), found.end());
+            EXPECT_EQ(found, expected);
+        }
+
+        std::vector<std::pair<float, uint32_t>> by_distance;
+        for (uint32_t i = 0; i < points.size(); ++i)
+            by_distance.emplace_back(distance_squared(center, points[i]), i);
+        std::sort(by_distance.begin(), by_distance.end());
+        for (size_t k : {1, 10, 150})
+        {
+            const std::vector<uint32_t> nearest(grid.query_nearest(center, k));
+            ASSERT_EQ(nearest.size(), k);
+            for (size_t i = 0; i < k; ++i)
+                EXPECT_EQ(nearest[i], by_distance[i].second);
+        }
+    }
+    EXPECT_EQ(grid.query_nearest(points[0], 5000).size(), points.size());
+}
@@ -0,0 +1,101 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "sprite_batch/sprite_batch.hpp"
+#include "gtest/gtest.h"
+
+#include <SDL3/SDL.h>
+
+TEST(sprite_batch_test, batches_group_layers_and_textures)
+{
+    using namespace el;
+    EXPECT_THROW(sprite_batch(0), std::invalid_argument);
+
+    // three textures interleaved over two layers, the second layer drawn first in submission order
+    sprite_batch batch(4);
+    for (uint32_t i = 0; i < 12; ++i)
+        batch.draw(i % 3, point<float, 2>({float(i), 0}), {2, 2}, 0, {0, 0}, {0, 0, 1, 1}, {1, 1, 1, 1},
+                   uint16_t(i < 6 ? 1 : 0));
+    batch.build();
+    ASSERT_EQ(batch.size(), 12u);
+    ASSERT_EQ(batch.batches().size(), 6u);
+    for (size_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(batch.batches()[i].texture, i % 3);
+        EXPECT_EQ(batch.batches()[i].quad_count, 2u);
+        EXPECT_EQ(batch.batches()[i].first_vertex, 8 * i);
+    }
+    // layer 0, texture 0 holds sprites 6 and 9, in that order
+    EXPECT_EQ(batch.vertices()[0].position[0], 6.0f);
+    EXPECT_EQ(batch.vertices()[4].position[0], 9.0f);
+    EXPECT_EQ(batch.indices(), (std::vector<int>{0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4}));
+
+    // long runs of one texture are split at the batch limit
+    batch.clear();
+    for (int i = 0; i < 10; ++i)
+        batch.draw(0, point<float, 2>(), {1, 1});
+    batch.build();
+    ASSERT_EQ(batch.batches().size(), 3u);
+    EXPECT_EQ(batch.batches()[2].quad_count, 2u);
+
+    // a rotated sprite around its center and the same sprite placed by a transform
+    batch.clear();
+    batch.draw(0, point<float, 2>({10, 20}), {4, 2}, 1.57079633f, {0.5f, 0.5f}, {0.25f, 0.5f, 0.75f, 1});
+    matrix<float, 3, 3> transform;
+    transform(0, 1) = -2;
+    transform(1, 0) = 4;
+    transform(0, 2) = 11;
+    transform(1, 2) = 18;
+    transform(2, 2) = 1;
+    batch.draw(0, transform, {0.25f, 0.5f, 0.75f, 1});
+    batch.build();
+    for (size_t corner = 0; corner < 4; ++corner)
+    {
+        const sprite_vertex& rotated(batch.vertices()[corner]);
+        const sprite_vertex& placed(batch.vertices()[4 + corner]);
+        EXPECT_NEAR(rotated.position[0], placed.position[0], 1e-5f);
+        EXPECT_NEAR(rotated.position[1], placed.position[1], 1e-5f);
+        EXPECT_EQ(rotated.uv, placed.uv);
+    }
+    EXPECT_NEAR(batch.vertices()[0].position[0], 11.0f, 1e-5f);
+    EXPECT_NEAR(batch.vertices()[0].position[1], 18.0f, 1e-5f);
+    EXPECT_EQ(batch.vertices()[2].uv, (std::array<float, 2>{0.75f, 1}));
+}
+
+TEST(sprite_batch_test, draws_with_the_software_renderer)
+{
+    using namespace el;
+    SDL_Surface* target(SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32));
+    ASSERT_NE(target, nullptr);
+    SDL_Renderer* renderer(SDL_CreateSoftwareRenderer(target));
+    ASSERT_NE(renderer, nullptr);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    // a green square on a higher layer covers the middle of a red one submitted after it
+    sprite_batch batch;
+    batch.draw(0, point<float, 2>({32, 32}), {8, 8}, 0, {0.5f, 0.5f}, {0, 0, 1, 1}, {0, 1, 0, 1}, 1);
+    batch.draw(0, point<float, 2>({16, 16}), {32, 32}, 0, {0, 0}, {0, 0, 1, 1}, {1, 0, 0, 1});
+    EXPECT_EQ(batch.submit(renderer, {nullptr}), 2u);
+
+    SDL_Surface* pixels(SDL_RenderReadPixels(renderer, nullptr));
+    ASSERT_NE(pixels, nullptr);
+    const auto color = [&](int x, int y)
+    {
+        Uint8 r, g, b, a;
+        SDL_ReadSurfacePixel(pixels, x, y, &r, &g, &b, &a);
+        return std::array<int, 3>{r, g, b};
+    };
+    EXPECT_EQ(color(2, 2), (std::array<int, 3>{0, 0, 0}));
+    EXPECT_EQ(color(20, 20), (std::array<int, 3>{255, 0, 0}));
+    EXPECT_EQ(color(32, 32), (std::array<int, 3>{0, 255, 0}));
+    EXPECT_EQ(color(50, 50), (std::array<int, 3>{0, 0, 0}));
+
+    batch.draw(1, point<float, 2>(), {1, 1});
+    EXPECT_THROW(batch.submit(renderer, {nullptr}), std::out_of_range);
+
+    SDL_DestroySurface(pixels);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+}
@@ -0,0 +1,179 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+#include "state_snapshot/state_snapshot.hpp"
+#include "particle_system/particle_system.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+    el::point<float, 3> at(float x, float y, float z)
+    {
+        return el::point<float, 3>(std::array<float, 3>{x, y, z});
+    }
+
+    el::direction<float, 3> along(float x, float y, float z)
+    {
+        return el::direction<float, 3>(std::array<float, 3>{x, y, z});
+    }
+
+    el::particle_system fountain_system()
+    {
+        el::particle_forces forces;
+        forces.attractors.push_back({at(0, 3, 0), 1.5f});
+        el::particle_system particles(5000, forces, 11);
+        el::particle_emitter fountain;
+        fountain.position_spread = 0.25f;
+        fountain.velocity = along(0, 4, 0);
+        fountain.velocity_spread = 0.5f;
+        fountain.rate = 2000;
+        fountain.lifetime = 0.5f;
+        fountain.lifetime_spread = 0.2f;
+        particles.add_emitter(fountain);
+        return particles;
+    }
+
+    void expect_same(const el::particle_system& a, const el::particle_system& b)
+    {
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t axis = 0; axis < 3; ++axis)
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                ASSERT_EQ(a.positions(axis)[i], b.positions(axis)[i]);
+                ASSERT_EQ(a.velocities(axis)[i], b.velocities(axis)[i]);
+            }
+        for (size_t i = 0; i < a.size(); ++i)
+            ASSERT_EQ(a.ages()[i], b.ages()[i]);
+    }
+}
+
+TEST(state_snapshot_test, values_roundtrip)
+{
+    using namespace el;
+    matrix<double, 2, 3> transform;
+    for (size_t r = 0; r < 2; ++r)
+        for (size_t c = 0; c < 3; ++c)
+            transform(r, c) = double(r * 3 + c) + 0.5;
+    const std::vector<float> samples{1, 2.5f, -3};
+    const std::vector<std::string> names{"crate", "", "barrel"};
+
+    std::vector<unsigned char> buffer;
+    snapshot_writer out(buffer);
+    out.write(uint32_t(42));
+    out.write(at(1, 2, 3));
+    out.write(along(-1, 0, 1));
+    out.write(transform);
+    out.write(samples);
+    out.write(names);
+    EXPECT_EQ(out.size(), buffer.size());
+
+    snapshot_reader in(buffer);
+    EXPECT_EQ(in.get<uint32_t>(), 42u);
+    auto position(in.get<point<float, 3>>());
+    EXPECT_EQ(position[1], 2);
+    auto heading(in.get<direction<float, 3>>());
+    EXPECT_EQ(heading[0], -1);
+    const auto restored(in.get<matrix<double, 2, 3>>());
+    for (size_t r = 0; r < 2; ++r)
+        for (size_t c = 0; c < 3; ++c)
+            EXPECT_EQ(restored(r, c), transform(r, c));
+    EXPECT_EQ(in.get<std::vector<float>>(), samples);
+    EXPECT_EQ(in.get<std::vector<std::string>>(), names);
+    EXPECT_EQ(in.remaining(), 0);
+    EXPECT_THROW(in.get<uint8_t>(), std::out_of_range);
+
+    // a vector whose size runs past the end is rejected before allocating
+    std::vector<unsigned char> lying;
+    snapshot_writer liar(lying);
+    liar.write(uint64_t(1) << 40);
+    snapshot_reader truncated(lying);
+    EXPECT_THROW(truncated.get<std::vector<double>>(), std::out_of_range);
+}
+
+TEST(state_snapshot_test, delta_encoding)
+{
+    using namespace el;
+    std::vector<unsigned char> previous(4096), current, delta, decoded;
+    for (size_t i = 0; i < previous.size(); ++i)
+        previous[i] = static_cast<unsigned char>(i * 7);
+
+    // a few changed bytes compress to a few runs
+    current = previous;
+    current[100] ^= 1;
+    current[3000] ^= 0x80;
+    delta_encode(previous, current, delta);
+    EXPECT_LT(delta.size(), 64);
+    delta_decode(previous, delta, decoded);
+    EXPECT_EQ(decoded, current);
+
+    // identical, grown, shrunk and unaligned snapshots
+    for (const size_t size : {size_t(4096), size_t(5003), size_t(1001), size_t(0)})
+    {
+        current.assign(previous.begin(), previous.begin() + std::min(size, previous.size()));
+        current.resize(size, 9);
+        delta_encode(previous, current, delta);
+        delta_decode(previous, delta, decoded);
+        EXPECT_EQ(decoded, current);
+    }
+
+    // truncated and malformed deltas
+    current = previous;
+    current[8] = 1;
+    delta_encode(previous, current, delta);
+    std::vector<unsigned char> broken(delta.begin(), delta.end() - 1);
+    EXPECT_THROW(delta_decode(previous, broken, decoded), std::runtime_error);
+    broken = delta;
+    const uint32_t too_many = 1u << 20;
+    std::memcpy(broken.data() + 8, &too_many, 4);
+    EXPECT_THROW(delta_decode(previous, broken, decoded), std::runtime_error);
+}
+
+TEST(state_snapshot_test, ring_and_particle_rollback)
+{
+    using namespace el;
+    snapshot_ring ring(4);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_THROW(snapshot_ring(0), std::invalid_argument);
+
+    // run 10 ticks keeping the last 4 snapshots
+    particle_system particles(fountain_system());
+    for (uint64_t tick = 1; tick <= 10; ++tick)
+    {
+        particles.update(1.0f / 60);
+        snapshot_writer out(ring.store(tick));
+        particles.save(out);
+    }
+    EXPECT_EQ(ring.size(), 4);
+    EXPECT_EQ(ring.oldest_tick(), 7);
+    EXPECT_EQ(ring.newest_tick(), 10);
+    EXPECT_EQ(ring.find(6), nullptr);
+    EXPECT_THROW(ring.store(10), std::invalid_argument);
+    const particle_system continued(particles);
+
+    // rolling back to tick 8 and replaying matches the original run bit for bit
+    snapshot_reader in(ring.rollback(8));
+    particle_system replayed(1);
+    replayed.load(in);
+    EXPECT_EQ(in.remaining(), 0);
+    EXPECT_EQ(replayed.capacity(), 5000);
+    EXPECT_EQ(ring.newest_tick(), 8);
+    EXPECT_EQ(ring.size(), 2);
+    EXPECT_THROW(ring.rollback(9), std::out_of_range);
+    for (int tick = 9; tick <= 10; ++tick)
+        replayed.update(1.0f / 60);
+    expect_same(replayed, continued);
+
+    // both runs keep producing the same particles after the rollback
+    particles.update(1.0f / 60);
+    replayed.update(1.0f / 60);
+    expect_same(replayed, particles);
+
+    // a snapshot cut short leaves the load with an error
+    std::vector<unsigned char> snapshot;
+    snapshot_writer out(snapshot);
+    particles.save(out);
+    snapshot.resize(snapshot.size() / 2);
+    snapshot_reader half(snapshot);
+    EXPECT_THROW(replayed.load(half), std::out_of_range);
+}
@@ -0,0 +1,204 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+/*
+ * Runs a replication server and many bot clients in one process, talking over loopback UDP,
+ * and reports the bandwidth and CPU time every client costs.
+ *
+ *     replication_bots [--clients N] [--entities N] [--moving F] [--ticks N] [--loss F]
+ *
+ * A fraction of the entities circles around the world every tick while the rest stand still.
+ * Every bot focuses on a different point, so each one gets its own priorities. --loss drops
+ * that fraction of the datagrams in both directions. After the timed ticks the entities stop
+ * and the bots catch up, and the largest position error left on any bot is printed.
+ */
+
+#include "replication/replication.hpp"
+#include "udp_socket/udp_socket.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+    struct options
+    {
+        size_t clients = 1000;
+        size_t entities = 1000;
+        double moving = 0.25;
+        size_t ticks = 300;
+        double loss = 0;
+    };
+
+    bool parse(int argc, char* argv[], options& parsed)
+    {
+        for (int i(1); i < argc; ++i)
+        {
+            if (i + 1 == argc)
+                return false;
+            const char* value(argv[++i]);
+            if (std::strcmp(argv[i - 1], "--clients") == 0)
+                parsed.clients = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(argv[i - 1], "--entities") == 0)
+                parsed.entities = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(argv[i - 1], "--moving") == 0)
+                parsed.moving = std::strtod(value, nullptr);
+            else if (std::strcmp(argv[i - 1], "--ticks") == 0)
+                parsed.ticks = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(argv[i - 1], "--loss") == 0)
+                parsed.loss = std::strtod(value, nullptr);
+            else
+                return false;
+        }
+        return parsed.clients > 0 && parsed.moving >= 0 && parsed.moving <= 1 && parsed.loss >= 0 && parsed.loss < 1;
+    }
+
+    el::replicated_state circling(size_t index, double time)
+    {
+        // every entity circles its own center at walking speed, turning to face along the circle
+        const float center_x(float(index % 64) * 16 - 512), center_z(float(index / 64 % 64) * 16 - 512);
+        const double angle(time * 0.5 + double(index));
+        el::replicated_state state;
+        state.position = el::point<float, 3>(std::array<float, 3>{
+            center_x + 6 * float(std::cos(angle)), float(index % 7), center_z + 6 * float(std::sin(angle))});
+        state.orientation = {float(std::cos(angle / 2)), 0, float(std::sin(angle / 2)), 0};
+        return state;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    options settings;
+    if (!parse(argc, argv, settings))
+    {
+        std::fprintf(stderr, "usage: %s [--clients N] [--entities N] [--moving F] [--ticks N] [--loss F]\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        el::replication_server server;
+        for (size_t i(0); i < settings.entities; ++i)
+            server.add(circling(i, 0));
+        const auto moving(size_t(double(settings.entities) * settings.moving));
+
+        el::udp_socket server_socket(0, 1 << 22);
+        std::vector<el::udp_socket> bot_sockets;
+        std::vector<el::replication_client> bots;
+        std::unordered_map<uint16_t, size_t> bot_by_port;
+        for (size_t i(0); i < settings.clients; ++i)
+        {
+            bot_sockets.emplace_back();
+            bots.emplace_back(server.settings());
+            bot_by_port[bot_sockets.back().local_address().port] = server.add_client();
+            const float angle(float(i) * 2.399963f);
+            server.set_focus(i, el::point<float, 3>(std::array<float, 3>{
+                400 * std::cos(angle), 0, 400 * std::sin(angle)}));
+        }
+
+        std::mt19937 random(1);
+        std::bernoulli_distribution lost(settings.loss);
+        std::vector<unsigned char> packet, ack;
+        el::udp_address from;
+        size_t payload_bytes(0), records(0), datagrams(0), dropped(0);
+        double server_seconds(0), client_seconds(0);
+
+        // acknowledgements are drained every few bots so the server receive buffer never overflows
+        const auto drain_acks([&]
+        {
+            while (server_socket.receive(ack, from))
+            {
+                const auto bot(bot_by_port.find(from.port));
+                if (bot == bot_by_port.end())
+                    continue;
+                const auto start(std::chrono::steady_clock::now());
+                server.receive_ack(bot->second, ack.data(), ack.size());
+                server_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+        });
+
+        const auto run_tick([&](size_t tick, bool move, bool measure)
+        {
+            if (move)
+                for (size_t i(0); i < moving; ++i)
+                    server.set(uint32_t(i), circling(i, double(tick) / 60));
+            server.advance();
+            for (size_t i(0); i < bots.size(); ++i)
+            {
+                const auto start(std::chrono::steady_clock::now());
+                const size_t written(server.write_packet(i, packet));
+                if (measure)
+                {
+                    server_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    payload_bytes += packet.size();
+                    records += written;
+                    ++datagrams;
+                }
+                if (!lost(random) && !server_socket.send(bot_sockets[i].local_address(), packet.data(), packet.size()))
+                    ++dropped;
+            }
+            for (size_t i(0); i < bots.size(); ++i)
+            {
+                const auto start(std::chrono::steady_clock::now());
+                bool received(false);
+                while (bot_sockets[i].receive(packet, from))
+                    received |= bots[i].receive(packet.data(), packet.size());
+                if (received)
+                    bots[i].write_ack(ack);
+                if (measure)
+                    client_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (received && !lost(random) && !bot_sockets[i].send(server_socket.local_address(), ack.data(), ack.size()))
+                    ++dropped;
+                if (i % 64 == 63)
+                    drain_acks();
+            }
+            drain_acks();
+        });
+
+        const auto start(std::chrono::steady_clock::now());
+        for (size_t tick(1); tick <= settings.ticks; ++tick)
+            run_tick(tick, true, true);
+        const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+        for (size_t tick(0); tick < 2 * el::replication_history; ++tick)
+            run_tick(settings.ticks, false, false);
+
+        float largest_error(0);
+        for (const el::replication_client& bot : bots)
+            for (size_t i(0); i < settings.entities; ++i)
+            {
+                if (i >= bot.replicas().size() || !bot.replicas()[i].present)
+                {
+                    largest_error = INFINITY;
+                    continue;
+                }
+                const auto expected(circling(i, i < moving ? double(settings.ticks) / 60 : 0).position);
+                for (size_t axis(0); axis < 3; ++axis)
+                    largest_error = std::max(largest_error, std::fabs(bot.replicas()[i].state.position.get_coordinates()[axis] -
+                                                                      expected.get_coordinates()[axis]));
+            }
+
+        const double ticks(double(settings.ticks)), clients(double(settings.clients));
+        std::printf("%zu clients, %zu entities (%zu moving), %zu ticks in %.2f s\n", settings.clients,
+                    settings.entities, moving, settings.ticks, elapsed.count());
+        std::printf("bytes per tick:        %.0f total, %.1f per client\n", double(payload_bytes) / ticks,
+                    double(payload_bytes) / ticks / clients);
+        std::printf("entities per packet:   %.1f\n", double(records) / double(std::max<size_t>(datagrams, 1)));
+        std::printf("server CPU per client: %.2f us per tick\n", server_seconds / ticks / clients * 1e6);
+        std::printf("client CPU per tick:   %.2f us\n", client_seconds / ticks / clients * 1e6);
+        std::printf("datagrams dropped:     %zu by full socket buffers\n", dropped);
+        std::printf("largest error after catching up: %g\n", largest_error);
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "error: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
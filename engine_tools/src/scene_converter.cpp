@@ -0,0 +1,65 @@
+//
+// Created by maksymvarivodin on 10/19/26.
+//
+
+/*
+ * Converts OBJ and PLY files into one binary scene file that the engine maps in place.
+ *
+ *     scene_converter [--optimize] <output.l3ds> <input.obj|input.ply>...
+ *
+ * Every input becomes one mesh of the scene, in command line order. --optimize
+ * reorders the triangles of every mesh for the post-transform vertex cache.
+ */
+
+#include "mesh_loader/mesh_loader.hpp"
+#include "scene_file/scene_file.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+int main(int argc, char* argv[])
+{
+    bool optimize(false);
+    int first(1);
+    if (argc > 1 && std::strcmp(argv[1], "--optimize") == 0)
+    {
+        optimize = true;
+        ++first;
+    }
+    if (argc - first < 2)
+    {
+        std::fprintf(stderr, "usage: %s [--optimize] <output.l3ds> <input.obj|input.ply>...\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        const auto start(std::chrono::steady_clock::now());
+        std::vector<el::mesh> meshes;
+        for (int i(first + 1); i < argc; ++i)
+        {
+            meshes.push_back(el::load_mesh(argv[i]));
+            if (optimize)
+            {
+                const float before(el::average_cache_miss_ratio(meshes.back().indices(), meshes.back().vertex_count()));
+                meshes.back().optimize_vertex_cache();
+                const float after(el::average_cache_miss_ratio(meshes.back().indices(), meshes.back().vertex_count()));
+                std::printf("%s: ACMR %.3f -> %.3f\n", argv[i], before, after);
+            }
+            std::printf("%s: %zu vertices, %zu triangles\n", argv[i], meshes.back().vertex_count(),
+                        meshes.back().triangle_count());
+        }
+
+        el::write_scene(argv[first], meshes);
+        const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+        std::printf("wrote %s in %.2f s\n", argv[first], elapsed.count());
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "error: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}